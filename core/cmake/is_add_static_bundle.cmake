@@ -0,0 +1,223 @@
+# Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+#################################################
+# _is_bundle_use_static_core(<library> <core_target> <chain>)
+#
+# Replaces the shared core with <core_target> in the link libraries of <library>,
+# if it is a static library, and then in those of its dependencies. It fails if the
+# shared core is linked by a shared library, which cannot be changed.
+# <chain> is the path of dependencies that led to <library>, for the error message.
+function(_is_bundle_use_static_core library core_target chain)
+
+  set(shared_core_regex "^(is::core|is::is-core|is-core)$")
+
+  get_target_property(library_type ${library} TYPE)
+  get_target_property(imported ${library} IMPORTED)
+  set(properties INTERFACE_LINK_LIBRARIES)
+  if(NOT imported)
+    list(APPEND properties LINK_LIBRARIES)
+  endif()
+  set(replaced FALSE)
+
+  foreach(property ${properties})
+    get_target_property(items ${library} ${property})
+    if(NOT items)
+      continue()
+    endif()
+
+    set(replaced_items)
+    set(property_replaced FALSE)
+    foreach(item ${items})
+      # Static libraries list their private dependencies as $<LINK_ONLY:...>.
+      set(link_only FALSE)
+      set(dependency "${item}")
+      if(dependency MATCHES "^\\$<LINK_ONLY:(.*)>$")
+        set(link_only TRUE)
+        set(dependency "${CMAKE_MATCH_1}")
+      endif()
+
+      if(dependency MATCHES "${shared_core_regex}")
+        if(NOT library_type STREQUAL "STATIC_LIBRARY")
+          message(FATAL_ERROR
+            "is_add_static_bundle: the shared Integration Service Core is linked through "
+            "[${chain} -> ${dependency}]. Build [${library}] as a static library, so that it "
+            "links [${core_target}] instead.")
+        endif()
+
+        set(property_replaced TRUE)
+        set(dependency ${core_target})
+        if(link_only)
+          set(item "$<LINK_ONLY:${core_target}>")
+        else()
+          set(item ${core_target})
+        endif()
+      endif()
+      list(APPEND replaced_items "${item}")
+
+      if(TARGET "${dependency}")
+        get_property(visited GLOBAL PROPERTY _IS_BUNDLE_VISITED)
+        list(FIND visited "${dependency}" index)
+        if(index EQUAL -1)
+          set_property(GLOBAL APPEND PROPERTY _IS_BUNDLE_VISITED "${dependency}")
+          _is_bundle_use_static_core("${dependency}" ${core_target} "${chain} -> ${dependency}")
+        endif()
+      endif()
+    endforeach()
+
+    if(property_replaced)
+      set_target_properties(${library} PROPERTIES ${property} "${replaced_items}")
+      set(replaced TRUE)
+    endif()
+  endforeach()
+
+  if(replaced)
+    message(STATUS "is_add_static_bundle: [${library}] links [${core_target}] instead of the shared core")
+  endif()
+
+endfunction()
+
+#################################################
+# is_add_static_bundle(
+#   TARGET         <target>
+#   SYSTEM_HANDLES <system_handle_targets...>
+#   [TYPE_PLUGINS  <type_plugin_targets...>]
+#   [MAIN          <source>]
+#   [NO_IPO]
+# )
+#
+# Adds an integration-service executable with the given SystemHandles and type
+# plugins linked into it, along with the Integration Service Core. It requires
+# is-core-static, which is built when IS_BUILD_STATIC_CORE is ON.
+#
+# Linked SystemHandles register themselves before main() runs, so the bundle does
+# not look for their .mix files nor loads their libraries. Since the core and the
+# plugins end up in the same binary, the bundle is built with interprocedural
+# optimization if the compiler supports it, which lets it devirtualize the calls
+# to their publishers and subscribers. Only the code of the libraries compiled
+# for IPO takes part in it: build the SystemHandles with INTERPROCEDURAL_OPTIMIZATION
+# set to ON, as is-core-static is.
+#
+# A single Integration Service Core must be linked into the bundle: SystemHandles
+# linking the shared is-core would bring in its own instances of the SystemHandle
+# registry and the logger. Bundled SystemHandles are usually built against is::core,
+# so the shared core is replaced with is-core-static in the link libraries of every
+# static library linked into the bundle, along with its usage requirements, such as
+# IS_CORE_STATIC_DEFINE. If the shared core is still reached through some shared
+# library, the configuration fails: build that library statically and bundle it too.
+# Imported SystemHandles are already compiled, so on Windows they must have been
+# compiled with IS_CORE_STATIC_DEFINE, as is-core-static is.
+#
+# TARGET: The name of the executable.
+#
+# SYSTEM_HANDLES: The targets of the SystemHandle libraries to link. They must be
+# static libraries, for example built with BUILD_SHARED_LIBS set to OFF.
+#
+# TYPE_PLUGINS: Optional list of targets of static libraries generated by
+# is_mix_generator, which register the types of some middleware.
+#
+# MAIN: Optional source file with the main() function of the bundle, instead of
+# the one of the integration-service executable. Tests use it to run the bundled
+# SystemHandles.
+#
+# NO_IPO: Option. Do not build the bundle with interprocedural optimization.
+function(is_add_static_bundle)
+
+  include(CMakeParseArguments)
+  cmake_parse_arguments(
+    _ARG # prefix
+    "NO_IPO" # options
+    "TARGET;MAIN" # one-value arguments
+    "SYSTEM_HANDLES;TYPE_PLUGINS" # multi-value arguments
+    ${ARGN}
+  )
+
+  if(NOT _ARG_TARGET OR NOT _ARG_SYSTEM_HANDLES)
+    message(FATAL_ERROR "is_add_static_bundle: TARGET and SYSTEM_HANDLES are required")
+  endif()
+
+  if(TARGET is-core-static)
+    set(core_target is-core-static)
+  elseif(TARGET is::is-core-static)
+    set(core_target is::is-core-static)
+  else()
+    message(FATAL_ERROR
+      "is_add_static_bundle: is-core-static was not found. "
+      "Build the Integration Service Core with IS_BUILD_STATIC_CORE set to ON.")
+  endif()
+
+  set_property(GLOBAL PROPERTY _IS_BUNDLE_VISITED ${core_target})
+  foreach(library ${_ARG_SYSTEM_HANDLES} ${_ARG_TYPE_PLUGINS})
+    _is_bundle_use_static_core(${library} ${core_target} ${library})
+  endforeach()
+
+  # Lets the bundle honor INTERPROCEDURAL_OPTIMIZATION, which depends on the policy at its creation.
+  cmake_policy(PUSH)
+  if(POLICY CMP0069)
+    cmake_policy(SET CMP0069 NEW)
+  endif()
+
+  if(NOT _ARG_MAIN)
+    set(_ARG_MAIN ${IS_MAIN_SOURCE})
+  endif()
+
+  add_executable(${_ARG_TARGET} ${_ARG_MAIN})
+
+  set_target_properties(${_ARG_TARGET} PROPERTIES
+    CXX_STANDARD
+      17
+    CXX_STANDARD_REQUIRED
+      YES
+    )
+
+  # The registrations of the SystemHandles and types are never referenced,
+  # so their whole archives are linked to keep the linker from discarding them.
+  foreach(library ${core_target} ${_ARG_SYSTEM_HANDLES} ${_ARG_TYPE_PLUGINS})
+    get_target_property(library_type ${library} TYPE)
+    if(NOT library_type STREQUAL "STATIC_LIBRARY")
+      message(FATAL_ERROR
+        "is_add_static_bundle: [${library}] must be a static library to be bundled into [${_ARG_TARGET}]")
+    endif()
+
+    if(MSVC)
+      target_link_libraries(${_ARG_TARGET} PRIVATE "-WHOLEARCHIVE:$<TARGET_FILE:${library}>")
+    elseif(APPLE)
+      target_link_libraries(${_ARG_TARGET} PRIVATE "-Wl,-force_load,$<TARGET_FILE:${library}>")
+    else()
+      target_link_libraries(${_ARG_TARGET}
+        PRIVATE
+          -Wl,--whole-archive $<TARGET_FILE:${library}> -Wl,--no-whole-archive)
+    endif()
+
+    # Also links the target itself, for its usage requirements.
+    target_link_libraries(${_ARG_TARGET} PRIVATE ${library})
+  endforeach()
+
+  if(NOT _ARG_NO_IPO)
+    if(CMAKE_VERSION VERSION_LESS 3.9)
+      message(STATUS "is_add_static_bundle: CMake 3.9 is required to build [${_ARG_TARGET}] with IPO")
+    else()
+      include(CheckIPOSupported)
+      check_ipo_supported(RESULT ipo_supported OUTPUT ipo_output LANGUAGES CXX)
+      if(ipo_supported)
+        set_target_properties(${_ARG_TARGET} PROPERTIES INTERPROCEDURAL_OPTIMIZATION ON)
+      else()
+        message(STATUS "is_add_static_bundle: IPO is not supported, [${_ARG_TARGET}] is built without it")
+      endif()
+    endif()
+  endif()
+
+  cmake_policy(POP)
+
+endfunction()
@@ -20,11 +20,26 @@
 #define _IS_CORE_INTERNAL_CONFIG_HPP_
 
 #include <is/systemhandle/RegisterSystem.hpp>
+#include <is/core/runtime/ConversionPlan.hpp>
+#include <is/core/runtime/DispatchQueue.hpp>
+#include <is/core/runtime/LazySubscription.hpp>
+#include <is/core/runtime/Metrics.hpp>
+#include <is/core/runtime/PriorityDispatcher.hpp>
+#include <is/core/runtime/SampleAggregator.hpp>
 #include <is/core/runtime/Search.hpp>
+#include <is/core/runtime/TaskScheduler.hpp>
+#include <is/core/runtime/Tracer.hpp>
+#include <is/core/runtime/TrafficRecorder.hpp>
+#include <is/core/runtime/TypeTable.hpp>
 #include <is/core/runtime/MiddlewareInterfaceExtension.hpp>
 
 #include <yaml-cpp/yaml.h>
 
+#include <atomic>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -39,6 +54,42 @@ struct RequiredTypes;
 
 namespace internal {
 
+/**
+ * @struct ThreadConfig
+ * @brief Stores the settings of the thread that spins the SystemHandle of a middleware.
+ *
+ * @var ThreadConfig::cpu_affinity
+ *      @brief The CPUs the thread is pinned to. If empty, the thread is not pinned.
+ *
+ * @var ThreadConfig::sched_policy
+ *      @brief The scheduling policy of the thread: `other`, `batch`, `idle`, `fifo` or `rr`.
+ *             If empty, the policy of the process is kept.
+ *
+ * @var ThreadConfig::priority
+ *      @brief The scheduling priority of the thread, for the `fifo` and `rr` policies.
+ *
+ * @var ThreadConfig::poll_mode
+ *      @brief Whether `spin_once()` is called continuously, without waiting for the
+ *             wake-up callback of the SystemHandle, if it supports one.
+ */
+struct ThreadConfig
+{
+    std::vector<int> cpu_affinity;
+    std::string sched_policy;
+    int priority = 0;
+    bool poll_mode = false;
+
+    /**
+     * @brief Tells whether the SystemHandle needs a thread of its own,
+     *        instead of being served by the shared executor.
+     */
+    bool dedicated() const
+    {
+        return poll_mode || !cpu_affinity.empty() || !sched_policy.empty();
+    }
+
+};
+
 /**
  * @struct MiddlewareConfig
  * @brief Holds information relative to each middleware configuration.
@@ -51,12 +102,230 @@ namespace internal {
  *
  * @var MiddlewareConfig::config_node
  *      @brief YAML configuration associated with the specific middleware.
+ *
+ * @var MiddlewareConfig::thread
+ *      @brief Settings of the thread that spins the SystemHandle of the middleware.
+ *
+ * @var MiddlewareConfig::shared
+ *      @brief Whether the SystemHandle is shared with the other instances of the process
+ *             that configure the same middleware in the same way.
  */
 struct MiddlewareConfig
 {
     std::string type;
     std::vector<std::string> types_from;
     YAML::Node config_node;
+    ThreadConfig thread;
+    bool shared = false;
+};
+
+/**
+ * @struct DispatchConfig
+ * @brief Stores the asynchronous dispatching settings of a topic route.
+ *
+ * @var DispatchConfig::queue_depth
+ *      @brief Maximum number of messages queued for each destination of the route.
+ *             Zero means that messages are published synchronously, from the
+ *             subscription callback of the source middleware.
+ *
+ * @var DispatchConfig::policy
+ *      @brief What to do when a message arrives and a destination queue is full.
+ */
+struct DispatchConfig
+{
+    std::size_t queue_depth = 0;
+    DispatchQueue::Policy policy = DispatchQueue::Policy::DROP_OLDEST;
+};
+
+/**
+ * @struct RateConfig
+ * @brief Stores the rate limiting settings of the destinations of a topic route.
+ *
+ * @var RateConfig::max_rate
+ *      @brief Maximum number of messages per second published on each destination of the route.
+ *             Zero means that the rate is not limited.
+ *
+ * @var RateConfig::burst
+ *      @brief Maximum number of messages published at once on a destination after an idle period.
+ *
+ * @var RateConfig::latest_only
+ *      @brief Whether the latest message exceeding the rate is published as soon as the rate
+ *             allows it, instead of being discarded.
+ */
+struct RateConfig
+{
+    double max_rate = 0.0;
+    std::size_t burst = 1;
+    bool latest_only = false;
+};
+
+/**
+ * @struct AggregateConfig
+ * @brief Stores the sample aggregation settings of the destinations of a topic route.
+ *
+ * @var AggregateConfig::max_samples
+ *      @brief Maximum number of samples in each frame sent to the destinations of the route.
+ *             Zero means that samples are not aggregated.
+ *
+ * @var AggregateConfig::max_bytes
+ *      @brief Size of the encoded samples from which a frame is sent. Zero means no limit.
+ *
+ * @var AggregateConfig::max_delay
+ *      @brief Time, in seconds, after which a frame is sent even if it is not full.
+ *
+ * @var AggregateConfig::compression
+ *      @brief The compression applied to the payload of the frames.
+ */
+struct AggregateConfig
+{
+    std::size_t max_samples = 0;
+    std::size_t max_bytes = 65536;
+    double max_delay = 0.01;
+    SampleAggregator::Compression compression = SampleAggregator::Compression::NONE;
+};
+
+/**
+ * @struct DedupConfig
+ * @brief Stores the duplicate suppression settings of a topic route.
+ *
+ * @var DedupConfig::key
+ *      @brief Path of the field identifying each sample, such as `header.seq`.
+ *             If empty, samples are identified by their whole content.
+ *
+ * @var DedupConfig::window
+ *      @brief Time, in seconds, during which the copies of a sample are discarded.
+ *             Zero means that samples are not deduplicated.
+ *
+ * @var DedupConfig::capacity
+ *      @brief Maximum number of samples remembered at once.
+ */
+struct DedupConfig
+{
+    std::string key;
+    double window = 0.0;
+    std::size_t capacity = 4096;
+};
+
+/**
+ * @struct CallsConfig
+ * @brief Stores the settings of the pending calls of a service route.
+ *
+ * @var CallsConfig::timeout
+ *      @brief Time, in seconds, after which a call still waiting for its reply is abandoned,
+ *             and its client gets notified. Zero means that calls never time out.
+ *
+ * @var CallsConfig::max_in_flight
+ *      @brief Maximum number of calls waiting for their reply, for each client of the route.
+ *             New calls are rejected while the limit is reached. Zero means no limit.
+ */
+struct CallsConfig
+{
+    double timeout = 0.0;
+    std::size_t max_in_flight = 0;
+};
+
+/**
+ * @struct CoalesceConfig
+ * @brief Stores the request coalescing settings of an idempotent service.
+ *
+ * @var CoalesceConfig::enabled
+ *      @brief Whether identical requests waiting for the same reply are sent to the server once.
+ *
+ * @var CoalesceConfig::reply_ttl
+ *      @brief Time, in seconds, during which a reply is also given to identical requests.
+ *             Zero disables the reply cache.
+ *
+ * @var CoalesceConfig::max_waiters
+ *      @brief Number of clients that may wait for the reply of the same call, after which
+ *             identical requests are sent to the server again.
+ */
+struct CoalesceConfig
+{
+    bool enabled = false;
+    double reply_ttl = 0.0;
+    std::size_t max_waiters = 64;
+};
+
+/**
+ * @struct MetricsConfig
+ * @brief Stores the settings of the route metrics collected by *Integration Service*.
+ *
+ * @var MetricsConfig::dump_period
+ *      @brief Period, in seconds, at which the collected metrics are written to the log.
+ *             Zero disables the periodic dump.
+ *
+ * @var MetricsConfig::exporter_address
+ *      @brief Address where the *Prometheus* exporter listens for scrapes.
+ *             Only local scrapes are served by default.
+ *
+ * @var MetricsConfig::exporter_port
+ *      @brief Port where the *Prometheus* exporter listens for scrapes.
+ *             Zero disables the exporter.
+ */
+struct MetricsConfig
+{
+    double dump_period = 0.0;
+    std::string exporter_address = "127.0.0.1";
+    uint16_t exporter_port = 0;
+};
+
+/**
+ * @struct TracingConfig
+ * @brief Stores the settings of the per-message tracing of the topic routes.
+ *
+ * @var TracingConfig::sample_every
+ *      @brief One out of every `sample_every` received messages is traced.
+ *             Zero disables tracing.
+ *
+ * @var TracingConfig::format
+ *      @brief The format of the traces file, either `text` or `otlp`.
+ *
+ * @var TracingConfig::file
+ *      @brief The file where the traces are appended.
+ */
+struct TracingConfig
+{
+    std::size_t sample_every = 0;
+    std::string format = "text";
+    std::string file = "is_traces.log";
+};
+
+/**
+ * @struct RecordingConfig
+ * @brief Stores the settings of the recording of the routed traffic into a capture file.
+ *
+ * @var RecordingConfig::file
+ *      @brief The capture file. An empty path disables the recording.
+ *
+ * @var RecordingConfig::segment_size
+ *      @brief The number of bytes the capture file grows by, each time it is full.
+ */
+struct RecordingConfig
+{
+    std::string file;
+    std::size_t segment_size = 64 * 1024 * 1024;
+};
+
+/**
+ * @struct ShardConfig
+ * @brief Stores the share of the routes run by this process, when the `integration-service`
+ *        executable is started with `--shards` and supervises several worker processes.
+ *
+ * @var ShardConfig::index
+ *      @brief The index of the shard run by this process.
+ *
+ * @var ShardConfig::count
+ *      @brief The number of shards the routes are split into. One means that they are not split.
+ *
+ * @var ShardConfig::metrics_fd
+ *      @brief The file descriptor where the route metrics are reported to the supervisor,
+ *             or `-1` if they are not reported.
+ */
+struct ShardConfig
+{
+    std::size_t index = 0;
+    std::size_t count = 1;
+    int metrics_fd = -1;
 };
 
 /**
@@ -68,11 +337,32 @@ struct MiddlewareConfig
  *
  * @var TopicRoute::to
  *      @brief Destination middleware endpoint.
+ *
+ * @var TopicRoute::dispatch
+ *      @brief Asynchronous dispatching settings for the destinations.
+ *
+ * @var TopicRoute::rate
+ *      @brief Rate limiting settings for the destinations.
+ *
+ * @var TopicRoute::aggregate
+ *      @brief Settings of the frames the samples are aggregated into for the destinations.
+ *
+ * @var TopicRoute::deaggregate
+ *      @brief Whether the sources deliver the frames of an aggregated route of another
+ *             *Integration Service* instance, whose samples are routed one by one.
+ *
+ * @var TopicRoute::dedup
+ *      @brief Settings of the suppression of the copies of a sample received from several sources.
  */
 struct TopicRoute
 {
     std::set<std::string> from;
     std::set<std::string> to;
+    DispatchConfig dispatch;
+    RateConfig rate;
+    AggregateConfig aggregate;
+    bool deaggregate = false;
+    DedupConfig dedup;
 
     /**
      * @brief Helper method to retrieve at once *from* and *to* sets.
@@ -97,11 +387,15 @@ struct TopicRoute
  *
  * @var ServiceRoute::clients
  *      @brief Client endpoints.
+ *
+ * @var ServiceRoute::calls
+ *      @brief Settings of the calls pending for their reply.
  */
 struct ServiceRoute
 {
     std::set<std::string> clients;
     std::string server;
+    CallsConfig calls;
 
     /**
      * @brief Helper method to retrieve at once *server* and *clients* sets.
@@ -127,6 +421,10 @@ struct ServiceRoute
  * @var TopicInfo::type
  *      @brief The name of the type for the specific topic.
  *
+ * @var TopicInfo::project
+ *      @brief The members of the received messages copied into the members
+ *             of the remapped type, in order, or empty if it is not a projection.
+ *
  */
 struct TopicInfo
 {
@@ -145,6 +443,7 @@ struct TopicInfo
     std::string name;
     std::string type; //  AKA request_type for Services with both request and reply types.
     std::string reply_type; //  Only used for Services with reply_type.
+    std::vector<std::string> project; //  Only used for Topics remapped to a projected type.
 };
 
 /**
@@ -172,16 +471,54 @@ using ServiceInfo = TopicInfo;
  * @var TopicConfig::route
  *      @brief The route followed by the specific topic.
  *
+ * @var TopicConfig::route_name
+ *      @brief The name of the route in the `routes` section, or the topic name
+ *             if the route was defined inline.
+ *
  * @var TopicConfig::remap
  *      @brief A map with the remaps needed for the specific topic.
  *
  * @var TopicConfig::middleware_configs
  *      @brief A map with the YAML configuration for the specific topic.
+ *
+ * @var TopicConfig::filter
+ *      @brief The content filter expression of the topic, empty if every message is routed.
+ *
+ * @var TopicConfig::lazy
+ *      @brief Whether the topic is only subscribed while some remote endpoint listens to it.
+ *
+ * @var TopicConfig::priority
+ *      @brief The priority of the topic in the dispatchers of its destination middlewares,
+ *             or a negative value if the topic is not prioritized.
  */
 struct TopicConfig
 {
+    /**
+     * @brief Tells whether the topic needs each of its messages deserialized into
+     *        a DynamicData, so that its payloads can never be forwarded as they are.
+     *
+     *        Filters, rate limits, aggregation, deduplication, dispatch queues and priority
+     *        lanes read or hold the DynamicData, and lazy topics subscribe again through
+     *        `TopicSubscriberSystem::subscribe()`. Any new setting of that kind must be
+     *        added here.
+     *
+     * @returns `true` if some setting of the topic needs the DynamicData.
+     */
+    bool needs_decoded_data() const
+    {
+        return !filter.empty() || lazy || priority >= 0
+               || route.dispatch.queue_depth > 0
+               || route.rate.max_rate > 0.0
+               || route.aggregate.max_samples > 0 || route.deaggregate
+               || route.dedup.window > 0.0;
+    }
+
     std::string message_type;
     TopicRoute route;
+    std::string route_name;
+    std::string filter;
+    bool lazy = false;
+    int priority = -1;
 
     std::map<std::string, TopicInfo> remap; //  The "key" is the middleware alias.
 
@@ -201,23 +538,110 @@ struct TopicConfig
  * @var ServiceConfig::route
  *      @brief The route followed by the specific service.
  *
+ * @var ServiceConfig::route_name
+ *      @brief The name of the route in the `routes` section, or the service name
+ *             if the route was defined inline.
+ *
  * @var ServiceConfig::remap
  *      @brief A map with the remaps needed for the specific service.
  *
  * @var ServiceConfig::middleware_configs
  *      @brief A map with the YAML configuration for the specific service.
+ *
+ * @var ServiceConfig::coalesce
+ *      @brief The request coalescing settings of the service.
  */
 struct ServiceConfig
 {
     std::string request_type;
     std::string reply_type; //  Optional
     ServiceRoute route;
+    std::string route_name;
+    CoalesceConfig coalesce;
 
     std::map<std::string, ServiceInfo> remap; //  The "key" is the middleware alias.
 
     std::map<std::string, YAML::Node> middleware_configs;
 };
 
+/**
+ * @struct RouteResources
+ * @brief Keeps track of what was handed to the SystemHandles to bridge a topic or a service,
+ *        so that it can be taken down when the configuration is reloaded.
+ *
+ * @var RouteResources::subscriptions
+ *      @brief The subscription callbacks given to the source SystemHandles.
+ *
+ * @var RouteResources::raw_subscriptions
+ *      @brief The raw subscription callbacks given to the source SystemHandles.
+ *
+ * @var RouteResources::requests
+ *      @brief The request callbacks given to the client SystemHandles.
+ *
+ * @var RouteResources::unsubscribe
+ *      @brief Functions cancelling the subscriptions of the topic in its source SystemHandles.
+ *
+ * @var RouteResources::release
+ *      @brief Functions releasing what the route holds in the resources shared with other
+ *             routes, such as its lanes in the priority dispatchers.
+ *
+ * @var RouteResources::retired
+ *      @brief Flag checked by every callback of the route before doing anything. Once set,
+ *             the callbacks return right away, so that the route can be taken down while
+ *             the SystemHandles may still be calling them from their own threads.
+ */
+struct RouteResources
+{
+    std::vector<is::TopicSubscriberSystem::SubscriptionCallback*> subscriptions;
+    std::vector<is::TopicSubscriberSystem::RawSubscriptionCallback*> raw_subscriptions;
+    std::vector<is::ServiceClientSystem::RequestCallback*> requests;
+    std::vector<std::function<bool()> > unsubscribe;
+    std::vector<std::function<void()> > release;
+    std::shared_ptr<std::atomic_bool> retired = std::make_shared<std::atomic_bool>(false);
+};
+
+/**
+ * @brief The priority dispatchers of the destination middlewares, by middleware name.
+ *        They are kept by the *Integration Service* instance, so that the topics
+ *        configured by a reload share them with the ones already running.
+ */
+using PriorityDispatchers = std::map<std::string, std::shared_ptr<PriorityDispatcher> >;
+
+/**
+ * @struct RouteChanges
+ * @brief The topics and services that differ between two configurations.
+ *        Modified ones are both removed and added.
+ *
+ * @var RouteChanges::removed_topics
+ *      @brief The topics that must be taken down.
+ *
+ * @var RouteChanges::added_topics
+ *      @brief The topics that must be configured.
+ *
+ * @var RouteChanges::removed_services
+ *      @brief The services that must be taken down.
+ *
+ * @var RouteChanges::added_services
+ *      @brief The services that must be configured.
+ */
+struct RouteChanges
+{
+    std::set<std::string> removed_topics;
+    std::set<std::string> added_topics;
+    std::set<std::string> removed_services;
+    std::set<std::string> added_services;
+
+    /**
+     * @brief Tells whether there are no changes at all.
+     */
+    bool empty() const
+    {
+        return removed_topics.empty() && added_topics.empty()
+               && removed_services.empty() && added_services.empty();
+    }
+
+};
+
 /**
  * @class Config
  *        Internal representation of the configuration provided to the
@@ -234,6 +658,13 @@ public:
     using SubscriptionCallbacks =
             std::vector<std::unique_ptr<is::TopicSubscriberSystem::SubscriptionCallback> >;
 
+    /**
+     * @brief Signature for the container used to store the raw subscription callbacks for a certain
+     *        *Integration Service* instance.
+     */
+    using RawSubscriptionCallbacks =
+            std::vector<std::unique_ptr<is::TopicSubscriberSystem::RawSubscriptionCallback> >;
+
     /**
      * @brief Signature for the container used to store the service request callbacks for a certain
      *        *Integration Service* instance.
@@ -278,6 +709,9 @@ public:
      *             1.2. `paths`: includes paths containing IDL definitions that will
      *                  also be parsed and added to the types database.
      *
+     *             1.3. `cache`: directory where the parsed types of each IDL are stored,
+     *                  to restore them in later runs without parsing the IDL again.
+     *
      *          2. `systems`: Lists the middlewares involved in the communication,
      *             allowing to configure them. Custom aliases can be given to any system.
      *
@@ -363,6 +797,10 @@ public:
      *          If one of the middlewares listed is not properly configured,
      *          the whole process fails.
      *
+     *          Middlewares are loaded concurrently, each one as soon as the middlewares
+     *          listed in its `types-from` are ready. Cyclic `types-from` dependencies are
+     *          reported as an error.
+     *
      * @param[out] info_map Map between the middlewares and their SystemHandle
      *             instances information (handle pointer, topic publisher and subscriber
      *             and service client and provider systems, as well as its type registry).
@@ -407,11 +845,42 @@ public:
      * @param[in] subscription_callbacks Reference to the map used to store all of the active
      *            subscription callbacks for a certain SystemHandle instance.
      *
+     * @param[in] raw_subscription_callbacks Reference to the map used to store all of the active
+     *            raw subscription callbacks, used by the routes forwarding serialized payloads.
+     *
+     * @param[in] metrics Registry where the metrics of each configured topic route are kept.
+     *
+     * @param[in] tracer Tracer that samples the messages routed by the topics,
+     *            or `nullptr` if tracing is disabled.
+     *
+     * @param[in] recorder Recorder where the routed messages are appended,
+     *            or `nullptr` if recording is disabled.
+     *
+     * @param[out] resources If not `nullptr`, it gets the resources of each configured topic,
+     *             by topic name, so that they can be taken down later.
+     *
+     * @param[in] scheduler Runs the tasks that subscribe and unsubscribe the sources of
+     *            the `lazy` topics when their destinations are matched or unmatched,
+     *            and the ones releasing the messages kept aside by the rate limiters
+     *            in *latest only* mode. If empty, the former are run by the thread
+     *            reporting the match, and the latter are released by the next message.
+     *
+     * @param[in,out] dispatchers If not `nullptr`, the priority dispatchers of the destination
+     *                middlewares, where the ones created for the prioritized topics are added.
+     *                Otherwise, the dispatchers are only shared by the topics of this call.
+     *
      * @returns `true` if all the topics were successfully configured, `false` otherwise.
      */
     bool configure_topics(
             const is::internal::SystemHandleInfoMap& info_map,
-            SubscriptionCallbacks& subscription_callbacks) const;
+            SubscriptionCallbacks& subscription_callbacks,
+            RawSubscriptionCallbacks& raw_subscription_callbacks,
+            MetricsRegistry& metrics,
+            const std::shared_ptr<Tracer>& tracer = nullptr,
+            const std::shared_ptr<TrafficRecorder>& recorder = nullptr,
+            std::map<std::string, RouteResources>* resources = nullptr,
+            const TaskScheduler& scheduler = nullptr,
+            PriorityDispatchers* dispatchers = nullptr) const;
 
     /**
      * @brief Configures services, according to the specified route, type and remapping
@@ -447,11 +916,54 @@ public:
      * @param[in] request_callbacks Reference to the map used to store all of the active
      *            request callbacks for a certain SystemHandle instance.
      *
+     * @param[in] metrics Registry where the metrics of each configured service route are kept.
+     *
+     * @param[in] recorder Recorder where the routed requests are appended,
+     *            or `nullptr` if recording is disabled.
+     *
+     * @param[out] resources If not `nullptr`, it gets the resources of each configured service,
+     *             by service name, so that they can be taken down later.
+     *
      * @returns `true` if all the services were successfully configured, `false` otherwise.
      */
     bool configure_services(
             const is::internal::SystemHandleInfoMap& info_map,
-            RequestCallbacks& request_callbacks) const;
+            RequestCallbacks& request_callbacks,
+            MetricsRegistry& metrics,
+            const std::shared_ptr<TrafficRecorder>& recorder = nullptr,
+            std::map<std::string, RouteResources>* resources = nullptr) const;
+
+    /**
+     * @brief Computes the topics and services that must be taken down and configured
+     *        to go from a running configuration to this one.
+     *
+     * @details Only routes can be changed this way: the `systems` section must be equal, and
+     *          every type required by a middleware must already be known by its SystemHandle,
+     *          with the same definition. Otherwise, the instance must be restarted.
+     *
+     * @param[in] running The configuration being run.
+     *
+     * @param[in] info_map The SystemHandles loaded for the running configuration.
+     *
+     * @param[out] changes The topics and services that differ.
+     *
+     * @returns `true` if the changes can be applied without restarting, `false` otherwise.
+     */
+    bool changes_from(
+            const Config& running,
+            const is::internal::SystemHandleInfoMap& info_map,
+            RouteChanges& changes) const;
+
+    /**
+     * @brief Keeps only some of the configured topics and services.
+     *
+     * @param[in] topics The names of the topics to keep.
+     *
+     * @param[in] services The names of the services to keep.
+     */
+    void keep_routes(
+            const std::set<std::string>& topics,
+            const std::set<std::string>& services);
 
     /**
      * @brief Checks compatibility between the TopicInfo registered in the endpoints responsible
@@ -539,10 +1051,102 @@ public:
             const TypeRegistry& types,
             const std::string& path) const;
 
+    /**
+     * @brief Gets the route metrics settings given in the `metrics` section of the *YAML* file.
+     *
+     * @returns The metrics configuration.
+     */
+    const MetricsConfig& metrics_config() const
+    {
+        return _m_metrics_config;
+    }
+
+    /**
+     * @brief Gets the tracing settings given in the `tracing` section of the *YAML* file.
+     *
+     * @returns The tracing configuration.
+     */
+    const TracingConfig& tracing_config() const
+    {
+        return _m_tracing_config;
+    }
+
+    /**
+     * @brief Gets the recording settings given in the `recording` section of the *YAML* file.
+     *
+     * @returns The recording configuration.
+     */
+    const RecordingConfig& recording_config() const
+    {
+        return _m_recording_config;
+    }
+
+    /**
+     * @brief Keeps only a share of the configured topics and services, so that the routes
+     *        can be split among several processes.
+     *
+     * @details Topics, and then services, are dealt in name order, one to each shard in turn.
+     *          Every process still loads all the middlewares. The capture file, if any, gets
+     *          the shard index as suffix, so that the processes do not write to the same file.
+     *
+     * @param[in] index The index of the shard to keep, lower than `count`.
+     *
+     * @param[in] count The number of shards.
+     *
+     * @param[in] metrics_fd The file descriptor where the route metrics are reported
+     *            to the supervisor, or `-1`.
+     */
+    void select_shard(
+            std::size_t index,
+            std::size_t count,
+            int metrics_fd);
+
+    /**
+     * @brief Gets the share of the routes run by this process.
+     *
+     * @returns The shard configuration.
+     */
+    const ShardConfig& shard_config() const
+    {
+        return _m_shard_config;
+    }
+
+    /**
+     * @brief Gets the thread settings given in the `systems` section of the *YAML* file
+     *        for a middleware.
+     *
+     * @param[in] mw_name The name given to the middleware in the configuration.
+     *
+     * @returns The thread settings of the middleware, or the default ones if it does not exist.
+     */
+    const ThreadConfig& thread_config(
+            const std::string& mw_name) const;
+
     static utils::Logger logger;
 
 private:
 
+    /**
+     * @brief Loads and configures the SystemHandle of a single middleware.
+     *
+     * @param[in] mw_name The name given to the middleware in the configuration.
+     *
+     * @param[in] mw_config The configuration of the middleware.
+     *
+     * @param[in] dependencies The already loaded middlewares listed in its `types-from`.
+     *
+     * @param[in] type_mutex Mutex shared by all the middlewares of the same type,
+     *            held while their SystemHandle is created and configured.
+     *
+     * @returns The information of the loaded SystemHandle, which evaluates
+     *          to `false` if it could not be loaded or configured.
+     */
+    is::internal::SystemHandleInfo load_middleware(
+            const std::string& mw_name,
+            const MiddlewareConfig& mw_config,
+            const std::map<std::string, const is::internal::SystemHandleInfo*>& dependencies,
+            std::mutex& type_mutex) const;
+
     /**
      * Class members.
      */
@@ -561,7 +1165,26 @@ private:
 
     std::map<std::string, RequiredTypes> _m_required_types;
 
-    std::map<std::string, eprosima::xtypes::DynamicType::Ptr> _m_types;
+    TypeRegistry _m_types;
+
+    /**
+     * Keep the types of this configuration interned in the TypeTable.
+     */
+    std::vector<TypeTable::Lease> _m_type_leases;
+
+    MetricsConfig _m_metrics_config;
+
+    TracingConfig _m_tracing_config;
+
+    RecordingConfig _m_recording_config;
+
+    ShardConfig _m_shard_config;
+
+    /**
+     * Conversions between the types of the configured routes, shared by all the
+     * topics and services, in both the request and the reply directions.
+     */
+    std::shared_ptr<ConversionCache> _m_conversion_cache = std::make_shared<ConversionCache>();
 
 };
 
@@ -24,6 +24,7 @@
 #include <is/core/export.hpp>
 
 #include <is/core/Config.hpp>
+#include <is/core/runtime/Metrics.hpp>
 #include <is/core/runtime/Search.hpp>
 #include <is/core/runtime/MiddlewareInterfaceExtension.hpp>
 #include <is/systemhandle/SystemHandle.hpp>
@@ -284,6 +285,50 @@ public:
     const TypeRegistry* type_registry(
             const std::string& middleware_name);
 
+    /**
+     * @brief Takes a snapshot of the metrics collected for every configured route.
+     *
+     * @details Each topic route gets one entry per source and destination system pair,
+     *          and each service route gets one entry per client system.
+     *
+     * @returns The current values of the route metrics.
+     */
+    std::vector<RouteMetricsSnapshot> metrics() const;
+
+    /**
+     * @brief Gets the memory held by the type registry of every loaded middleware.
+     *
+     * @details The registries are measured once the middlewares are loaded,
+     *          as estimated by `MemoryUsage::of()`.
+     *
+     * @returns One entry per middleware.
+     */
+    std::vector<TypeRegistrySnapshot> type_registries() const;
+
+    /**
+     * @brief Applies a new configuration to the running instance, without restarting it.
+     *
+     * @details Only the topics and services that were added, removed or modified are
+     *          taken down or configured, while the SystemHandles keep running.
+     *          The `systems` section of the new configuration must be equal to the running one,
+     *          and its types must already be known by the SystemHandles; otherwise,
+     *          the new configuration is rejected and the instance keeps running as it was.
+     *
+     * @param[in] config_node Parsed representation of the new *YAML* configuration.
+     *
+     * @returns `true` if the new configuration was applied, `false` otherwise.
+     */
+    bool reload(
+            const YAML::Node& config_node);
+
+    /**
+     * @brief Reads the configuration file of the instance again, and applies it
+     *        as `reload(const YAML::Node&)` does.
+     *
+     * @returns `true` if the new configuration was applied, `false` otherwise.
+     */
+    bool reload();
+
 private:
 
     friend class Instance::Implementation;
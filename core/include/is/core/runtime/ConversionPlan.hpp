@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_CONVERSIONPLAN_HPP_
+#define _IS_CORE_RUNTIME_CONVERSIONPLAN_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class ConversionPlan
+ *        Precompiled set of steps that converts data from a source DynamicType
+ *        into a compatible, but not equal, target DynamicType.
+ *
+ *        The plan is computed once, when a route is configured, by walking both
+ *        type trees: equal subtrees become plain copies, primitive members get
+ *        their widening or sign conversion resolved, and string and sequence
+ *        bounds truncations, as well as dropped members, are decided beforehand.
+ *        Applying the plan on each message only follows these steps, instead of
+ *        walking and comparing both types again.
+ *
+ *        The types used to compile a plan must outlive it.
+ */
+class IS_CORE_API ConversionPlan
+{
+public:
+
+    /**
+     * @brief Compiles the conversion plan between two types.
+     *
+     * @param[in] source_type The type of the data that will be converted.
+     *
+     * @param[in] target_type The type of the resulting data.
+     *
+     * @returns A shared pointer to the compiled plan, or `nullptr` if the types
+     *          are not compatible or contain some kind that cannot be planned
+     *          (for example, unions or maps). In that case, the generic *xtypes*
+     *          conversion must be used instead.
+     */
+    static std::shared_ptr<const ConversionPlan> compile(
+            const xtypes::DynamicType& source_type,
+            const xtypes::DynamicType& target_type);
+
+    /**
+     * @brief Compiles a plan that only extracts some members of the source type, each of
+     *        them converted into the member of the target type at the same position.
+     *        Nested members are given by their dot separated path, such as `pose.position`.
+     *        Only the projected members are read from each message.
+     *
+     * @param[in] source_type The type of the data that will be converted.
+     *
+     * @param[in] target_type The type of the resulting data. It must be a structure with
+     *            as many members as projected members.
+     *
+     * @param[in] members The paths of the projected members of the source type.
+     *
+     * @param[out] error The reason why the plan could not be compiled, if so.
+     *
+     * @returns A shared pointer to the compiled plan, or `nullptr` if some member does not exist,
+     *          or cannot be converted into its target member.
+     */
+    static std::shared_ptr<const ConversionPlan> project(
+            const xtypes::DynamicType& source_type,
+            const xtypes::DynamicType& target_type,
+            const std::vector<std::string>& members,
+            std::string& error);
+
+    /**
+     * @brief Destructor.
+     */
+    ~ConversionPlan();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    ConversionPlan(
+            const ConversionPlan& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    ConversionPlan& operator = (
+            const ConversionPlan& other) = delete;
+
+    /**
+     * @brief Gets the type that this plan converts from.
+     *
+     * @returns A const reference to the source type.
+     */
+    const xtypes::DynamicType& source_type() const;
+
+    /**
+     * @brief Gets the type that this plan converts to.
+     *
+     * @returns A const reference to the target type.
+     */
+    const xtypes::DynamicType& target_type() const;
+
+    /**
+     * @brief Gets the consistency between the source and target types.
+     *
+     * @returns The xtypes::TypeConsistency as computed when compiling the plan.
+     */
+    xtypes::TypeConsistency consistency() const;
+
+    /**
+     * @brief Converts a message, producing new data of the target type.
+     *
+     * @param[in] from The data to be converted. Its type must be the source type of this plan.
+     *
+     * @returns The converted data.
+     */
+    xtypes::DynamicData convert(
+            const xtypes::ReadableDynamicDataRef& from) const;
+
+    /**
+     * @brief Converts a message into an already existing instance of the target type.
+     *
+     * @param[in] from The data to be converted. Its type must be the source type of this plan.
+     *
+     * @param[out] to The data where the conversion will be written.
+     *             Its type must be the target type of this plan.
+     */
+    void apply(
+            const xtypes::ReadableDynamicDataRef& from,
+            xtypes::DynamicData& to) const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the ConversionPlan class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of ConversionPlan.
+     *
+     *        Methods named equal to some ConversionPlan method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * @brief Constructor, only used by ConversionPlan::compile.
+     */
+    ConversionPlan(
+            std::unique_ptr<Implementation> pimpl);
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+/**
+ * @class ConversionCache
+ *        Keeps the compatibility between pairs of types, and the conversion plans
+ *        compiled for them, so that every route converting between the same source
+ *        and target types shares a single check and a single plan.
+ *
+ *        Types are identified by their address, so they must outlive the cache.
+ */
+class IS_CORE_API ConversionCache
+{
+public:
+
+    /**
+     * @brief Conversion between a source and a target type.
+     */
+    struct Entry
+    {
+        /**
+         * The consistency of the target type with respect to the source type.
+         */
+        xtypes::TypeConsistency consistency;
+
+        /**
+         * The compiled plan, or `nullptr` if the types are equal, not compatible
+         * or cannot be planned, in which case the generic *xtypes* conversion must be used.
+         */
+        std::shared_ptr<const ConversionPlan> plan;
+    };
+
+    /**
+     * @brief Gets the conversion between two types, computing it the first time
+     *        this pair of types is requested.
+     *
+     * @param[in] source_type The type of the data that will be converted.
+     *
+     * @param[in] target_type The type of the resulting data.
+     *
+     * @returns The conversion between both types.
+     */
+    Entry get(
+            const xtypes::DynamicType& source_type,
+            const xtypes::DynamicType& target_type);
+
+    /**
+     * @brief Gets the consistency of a type with respect to another one,
+     *        as given by `type.is_compatible(other)`, computing it the first time
+     *        this pair of types is requested.
+     *
+     * @param[in] type The type whose consistency is checked.
+     *
+     * @param[in] other The type it is checked against.
+     *
+     * @returns The consistency between both types.
+     */
+    xtypes::TypeConsistency consistency(
+            const xtypes::DynamicType& type,
+            const xtypes::DynamicType& other);
+
+    /**
+     * @brief Pair of types, given in the same order as the arguments of `consistency()`.
+     */
+    using Key = std::pair<const xtypes::DynamicType*, const xtypes::DynamicType*>;
+
+    /**
+     * @brief Computes the consistency of several pairs of types at once, spreading
+     *        the pairs not checked so far among a set of worker threads.
+     *        Later calls to `consistency()` for these pairs are plain lookups.
+     *
+     * @param[in] pairs The pairs of types to be checked. Repeated pairs are checked once.
+     *
+     * @param[in] max_threads The maximum number of worker threads to be used.
+     *            If zero, the hardware concurrency is used.
+     */
+    void precompute(
+            const std::vector<Key>& pairs,
+            std::size_t max_threads = 0);
+
+    /**
+     * @brief Gets the number of conversions held by the cache, that is, the distinct pairs
+     *        of types given to `get()` so far, including those that cannot be converted.
+     *        Pairs only checked through `consistency()` or `precompute()` are not counted.
+     */
+    std::size_t size() const;
+
+private:
+
+    struct KeyHash
+    {
+        std::size_t operator ()(
+                const Key& key) const
+        {
+            const std::size_t first = std::hash<const xtypes::DynamicType*>()(key.first);
+            return first ^ (std::hash<const xtypes::DynamicType*>()(key.second) + 0x9e3779b9
+                   + (first << 6) + (first >> 2));
+        }
+
+    };
+
+    mutable std::mutex _mutex;
+    std::unordered_map<Key, Entry, KeyHash> _entries;
+    std::unordered_map<Key, xtypes::TypeConsistency, KeyHash> _consistencies;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_CONVERSIONPLAN_HPP_
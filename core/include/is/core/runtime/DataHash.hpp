@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef _IS_CORE_RUNTIME_DATAHASH_HPP_
+#define _IS_CORE_RUNTIME_DATAHASH_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+
+#include <cstddef>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class DataHash
+ *        Hashes the contents of messages, to find identical ones quickly.
+ *
+ *        The hash covers the primitive values, strings and collection sizes of a message,
+ *        along with the kind of each of its nodes. Other kinds, such as the entries of maps,
+ *        only contribute with their kind, so equal hashes do not guarantee equal messages.
+ *        Type and member names are not hashed, so the messages of equivalent types coming
+ *        from different middlewares get the same hash.
+ */
+class IS_CORE_API DataHash
+{
+public:
+
+    /**
+     * @brief Hashes a message, or some field of it.
+     *
+     * @param[in] data The message or field.
+     *
+     * @returns The hash of its contents.
+     */
+    static std::size_t of(
+            const xtypes::ReadableDynamicDataRef& data);
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_DATAHASH_HPP_
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_DISPATCHQUEUE_HPP_
+#define _IS_CORE_RUNTIME_DISPATCHQUEUE_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class DispatchQueue
+ *        Bounded queue, served by its own worker thread, that decouples the
+ *        subscription callback of a route from one of its destinations.
+ *
+ *        Messages pushed into the queue are handed to the consumer function
+ *        from the worker thread, in the same order they were pushed. When the
+ *        queue is full, the configured DispatchQueue::Policy decides what happens.
+ */
+class IS_CORE_API DispatchQueue
+{
+public:
+
+    /**
+     * @brief Behaviour of a DispatchQueue when a message is pushed while it is full.
+     */
+    enum class Policy
+    {
+        DROP_OLDEST,    ///< The oldest queued message is discarded to make room for the new one.
+        DROP_NEWEST,    ///< The new message is discarded.
+        BLOCK           ///< The pushing thread waits until there is room for the new message.
+    };
+
+    /**
+     * @brief Outcome of pushing a message into a DispatchQueue.
+     */
+    enum class PushResult
+    {
+        QUEUED,         ///< The message was queued.
+        EVICTED,        ///< The message was queued, after discarding the oldest queued one to make room for it.
+        DROPPED         ///< The message was discarded.
+    };
+
+    /**
+     * @brief Signature of the function that consumes each dispatched message.
+     */
+    using Consumer = std::function<void (const std::shared_ptr<const xtypes::DynamicData>& message)>;
+
+    /**
+     * @brief Constructor. Starts the worker thread of the queue.
+     *
+     * @param[in] name Name used to identify this queue in the log messages.
+     *
+     * @param[in] depth Maximum number of messages that the queue can hold. Must be greater than zero.
+     *
+     * @param[in] policy What to do when a message is pushed while the queue is full.
+     *
+     * @param[in] consumer Function called from the worker thread for each dispatched message.
+     */
+    DispatchQueue(
+            const std::string& name,
+            std::size_t depth,
+            Policy policy,
+            Consumer consumer);
+
+    /**
+     * @brief Destructor. Stops the worker thread, discarding any message still queued.
+     */
+    ~DispatchQueue();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    DispatchQueue(
+            const DispatchQueue& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    DispatchQueue& operator = (
+            const DispatchQueue& other) = delete;
+
+    /**
+     * @brief Pushes a message into the queue, applying the queue policy if it is full.
+     *
+     * @param[in] message The message to be dispatched.
+     *
+     * @returns Whether the message was queued, and if the oldest queued one was discarded for it.
+     */
+    PushResult push(
+            std::shared_ptr<const xtypes::DynamicData> message);
+
+    /**
+     * @brief Gets the number of messages currently waiting in the queue.
+     *
+     * @returns The number of queued messages.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the memory held by the messages currently waiting in the queue.
+     *
+     * @returns The estimated size of the queued messages, in bytes, as given by `MemoryUsage::of()`.
+     */
+    std::size_t bytes() const;
+
+    /**
+     * @brief Gets the total number of messages dropped by this queue.
+     *
+     * @returns The number of dropped messages.
+     */
+    uint64_t dropped() const;
+
+    /**
+     * @brief Translates the name of a policy, as written in the *YAML* configuration,
+     *        into its DispatchQueue::Policy value.
+     *
+     * @param[in] name One of `drop_oldest`, `drop_newest` or `block`.
+     *
+     * @param[out] policy The resulting policy.
+     *
+     * @returns `true` if `name` is a valid policy name, `false` otherwise.
+     */
+    static bool parse_policy(
+            const std::string& name,
+            Policy& policy);
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the DispatchQueue class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of DispatchQueue.
+     *
+     *        Methods named equal to some DispatchQueue method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_DISPATCHQUEUE_HPP_
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_DYNAMICDATAPOOL_HPP_
+#define _IS_CORE_RUNTIME_DYNAMICDATAPOOL_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+
+#include <memory>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class DynamicDataPool
+ *        Pool of reusable xtypes::DynamicData instances of a single type, so that the
+ *        messages flowing through a route do not allocate and free a whole data tree each.
+ *
+ *        Instances are borrowed with `acquire()`, and go back to the pool on their own
+ *        when the last copy of the returned shared pointer is released, even from another
+ *        thread or after the pool has been destroyed; in the latter case, they are freed
+ *        along with the last of them. At most `capacity` idle instances are kept.
+ *
+ *        The control blocks of the returned shared pointers are kept too, so once the pool
+ *        holds as many idle instances as are borrowed at a time, neither borrowing nor
+ *        releasing an instance allocates memory. Both take a short lock of the pool:
+ *        borrowing takes it once, and releasing it twice.
+ *
+ *        A returned instance keeps the values of its previous use, so borrowers must write
+ *        every field of it. Since writing a sequence does not shrink it, instances of types holding
+ *        sequences, maps or unions are reset to their default value when they are returned.
+ *
+ *        SystemHandles can keep a pool for each subscription, and fill borrowed instances
+ *        from their middleware messages before handing them to the SubscriptionCallback.
+ */
+class IS_CORE_API DynamicDataPool
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] type The type of the pooled instances. It must outlive the pool
+     *            and every instance borrowed from it.
+     *
+     * @param[in] capacity Maximum number of idle instances kept by the pool.
+     *            They are created on demand.
+     */
+    DynamicDataPool(
+            const xtypes::DynamicType& type,
+            std::size_t capacity = 16);
+
+    /**
+     * @brief Destructor. Frees the idle instances.
+     */
+    ~DynamicDataPool();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    DynamicDataPool(
+            const DynamicDataPool& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    DynamicDataPool& operator = (
+            const DynamicDataPool& other) = delete;
+
+    /**
+     * @brief Borrows an instance from the pool, or creates a new one if there are no idle instances.
+     *
+     * @returns The borrowed instance, which is given back when it is released.
+     */
+    std::shared_ptr<xtypes::DynamicData> acquire();
+
+    /**
+     * @brief Gets the type of the pooled instances.
+     *
+     * @returns A reference to the type.
+     */
+    const xtypes::DynamicType& type() const;
+
+    /**
+     * @brief Gets the number of idle instances currently kept by the pool.
+     *
+     * @returns The number of idle instances.
+     */
+    std::size_t idle() const;
+
+    /**
+     * @brief Gets the number of instances created by the pool, since there were no idle ones.
+     *
+     * @returns The number of created instances.
+     */
+    uint64_t created() const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the DynamicDataPool class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of DynamicDataPool.
+     *
+     *        Methods named equal to some DynamicDataPool method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     *
+     * The implementation is shared with the borrowed instances,
+     * which give themselves back to it when they are released.
+     */
+
+    std::shared_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_DYNAMICDATAPOOL_HPP_
@@ -24,6 +24,7 @@
 
 
 #include <stdexcept>
+#include <string>
 
 // TODO jamoralp add Logger
 namespace eprosima {
@@ -41,6 +42,14 @@ class FieldToString
 {
 public:
 
+    /**
+     * @brief Signature of the functions that append the text of a field,
+     *        of some specific type, at the end of a buffer.
+     */
+    using Converter = void (*)(
+        const eprosima::xtypes::ReadableDynamicDataRef& field,
+        std::string& output);
+
     /**
      * @brief Constructor.
      *
@@ -83,6 +92,34 @@ public:
             eprosima::xtypes::ReadableDynamicDataRef field,
             const std::string& field_name) const;
 
+    /**
+     * @brief Appends the text of a field at the end of a buffer.
+     *        Numbers are formatted with `std::to_chars`, so that nothing is allocated
+     *        once the buffer is large enough, and errors are reported without exceptions.
+     *
+     * @param[in] field Reference to the Dynamic Data instance representing the field's values.
+     *
+     * @param[out] output The buffer where the text is appended.
+     *
+     * @returns `true` if the field was appended, `false` if its type cannot be converted
+     *          to a string, in which case `output` is left untouched.
+     */
+    bool append(
+            const eprosima::xtypes::ReadableDynamicDataRef& field,
+            std::string& output) const;
+
+    /**
+     * @brief Gets the function that appends fields of a given type, so that it can be
+     *        resolved once, for instance when a StringTemplate is bound to a type,
+     *        and then called for every field of that type.
+     *
+     * @param[in] type The type of the fields to be converted.
+     *
+     * @returns The converter, or `nullptr` if fields of that type cannot be converted to a string.
+     */
+    static Converter converter(
+            const eprosima::xtypes::DynamicType& type);
+
     /**
      * @brief Gets a const reference to the details attribute.
      *
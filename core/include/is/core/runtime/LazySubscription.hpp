@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_LAZYSUBSCRIPTION_HPP_
+#define _IS_CORE_RUNTIME_LAZYSUBSCRIPTION_HPP_
+
+#include <is/core/export.hpp>
+#include <is/core/runtime/TaskScheduler.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class LazySubscription
+ *        Keeps the subscriptions of a topic route only while some remote endpoint
+ *        is listening to any of its destinations.
+ *
+ *        Each destination publisher reports, through the callback given by `watch()`,
+ *        the number of remote endpoints matched with it. As soon as the first of them
+ *        appears, every source of the route is subscribed; once the last one leaves,
+ *        the sources are unsubscribed again. Sources that cannot be unsubscribed keep
+ *        their subscription, and `active()` tells their callbacks to discard the messages.
+ *
+ *        The match callbacks only record the transition. The sources are subscribed or
+ *        unsubscribed afterwards, outside of any lock, by a task handed to the scheduler
+ *        given to the constructor, such as the executor that spins the SystemHandles.
+ *        Without a scheduler, the transition is applied by the thread that reported the
+ *        match, once the route is no longer locked. Transitions are applied one at a time,
+ *        and each one brings the sources to the latest state of the route.
+ */
+class IS_CORE_API LazySubscription
+{
+public:
+
+    /**
+     * @brief Signature of the functions that subscribe and unsubscribe a source.
+     *        They return `true` on success.
+     */
+    using Action = std::function<bool ()>;
+
+    /**
+     * @brief Signature of the callback that reports the number of remote endpoints
+     *        matched with a destination.
+     */
+    using MatchCallback = std::function<void (std::size_t matched)>;
+
+    /**
+     * @brief Signature of the function that runs the tasks applying the transitions.
+     *        They are scheduled without any delay.
+     */
+    using Scheduler = TaskScheduler;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] name Name used to identify the route in the log messages.
+     *
+     * @param[in] scheduler Function that runs the tasks applying the transitions
+     *            reported by the match callbacks. If empty, they are run right away.
+     */
+    LazySubscription(
+            const std::string& name,
+            Scheduler scheduler = nullptr);
+
+    /**
+     * @brief Destructor. Sources still subscribed are left as they are.
+     */
+    ~LazySubscription();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    LazySubscription(
+            const LazySubscription& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    LazySubscription& operator = (
+            const LazySubscription& other) = delete;
+
+    /**
+     * @brief Adds a destination to the route, with no remote endpoints matched yet.
+     *
+     * @returns The callback that must be called whenever the number of remote endpoints
+     *          matched with the destination changes. It can be safely called after
+     *          this LazySubscription has been destroyed.
+     */
+    MatchCallback watch();
+
+    /**
+     * @brief Adds a source to the route. It is subscribed right away if some
+     *        destination is already being listened to.
+     *
+     * @param[in] source Name of the source middleware, used in the log messages.
+     *
+     * @param[in] subscribe Function that subscribes the source.
+     *
+     * @param[in] unsubscribe Function that unsubscribes the source. It may return
+     *            `false` if the source does not support it.
+     */
+    void add_source(
+            const std::string& source,
+            Action subscribe,
+            Action unsubscribe);
+
+    /**
+     * @brief Tells whether some destination of the route is being listened to.
+     *
+     * @returns `true` if the messages received by the sources must be routed, `false` otherwise.
+     */
+    bool active() const;
+
+    /**
+     * @brief Stops following the matched endpoints, and unsubscribes the sources that are
+     *        still subscribed, from the calling thread. Used when the route is taken down.
+     *
+     * @returns `true` if every source is unsubscribed, `false` otherwise.
+     */
+    bool cancel();
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the LazySubscription class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of LazySubscription.
+     *
+     *        Methods named equal to some LazySubscription method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::shared_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_LAZYSUBSCRIPTION_HPP_
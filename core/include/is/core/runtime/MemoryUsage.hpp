@@ -0,0 +1,73 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef _IS_CORE_RUNTIME_MEMORYUSAGE_HPP_
+#define _IS_CORE_RUNTIME_MEMORYUSAGE_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+#include <is/systemhandle/SystemHandle.hpp>
+
+#include <cstddef>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class MemoryUsage
+ *        Estimates the memory held by messages and by type registries, so that the
+ *        memory of an *Integration Service* instance can be accounted for.
+ *
+ *        The size of a message is the `memory_size()` of its type, which covers its
+ *        inline members, plus the heap storage of its strings, sequences and maps.
+ *        The size of a type registry adds up the type objects it refers to, their names
+ *        and the registry entries; types shared by several entries are counted once, and
+ *        primitive types, which are shared by the whole process, are not counted.
+ *        Allocator overheads are not taken into account, so both are lower bounds.
+ */
+class IS_CORE_API MemoryUsage
+{
+public:
+
+    /**
+     * @brief Estimates the memory held by a message.
+     *
+     * @param[in] data The message.
+     *
+     * @returns The estimated size of the message, in bytes.
+     */
+    static std::size_t of(
+            const xtypes::ReadableDynamicDataRef& data);
+
+    /**
+     * @brief Estimates the memory held by a type registry, such as the one of a SystemHandle.
+     *
+     * @param[in] types The type registry.
+     *
+     * @returns The estimated size of the registry and of its types, in bytes.
+     */
+    static std::size_t of(
+            const TypeRegistry& types);
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_MEMORYUSAGE_HPP_
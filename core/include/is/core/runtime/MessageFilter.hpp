@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_MESSAGEFILTER_HPP_
+#define _IS_CORE_RUNTIME_MESSAGEFILTER_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class MessageFilter
+ *        Boolean expression over the fields of a message, compiled once against
+ *        the message type, that tells whether a message must be routed or discarded.
+ *
+ *        Expressions combine the following conditions with `&&`, `||`, `!` and parentheses:
+ *
+ *        - `field <op> literal`, where `<op>` is one of `==`, `!=`, `<`, `<=`, `>` or `>=`.
+ *        - `field in [low, high]`, which holds if the field lies within both bounds, included.
+ *        - `field % N <op> literal`, to compare the remainder of an integer field.
+ *        - `sample(N)`, which holds for one out of every N evaluations.
+ *        - `field`, for boolean fields.
+ *
+ *        Fields are given as paths from the message root, such as `header.stamp.sec`
+ *        or `ranges[0]`, and must be numeric, boolean, enumerated or string fields.
+ *        Literals are numbers, `true`, `false`, or strings between single or double quotes.
+ *
+ *        For example: `sensor.temperature > 40.5 || (status == 'FAULT' && sample(10))`.
+ */
+class IS_CORE_API MessageFilter
+{
+public:
+
+    /**
+     * @brief Compiles a filter expression.
+     *
+     * @param[in] expression The filter expression.
+     *
+     * @param[in] type The type of the messages the filter will be evaluated on.
+     *            It must outlive the filter.
+     *
+     * @returns A shared pointer to the compiled filter, or `nullptr` if the expression
+     *          is not valid for the given type. The reason is written to the log.
+     */
+    static std::shared_ptr<const MessageFilter> compile(
+            const std::string& expression,
+            const xtypes::DynamicType& type);
+
+    /**
+     * @brief Destructor.
+     */
+    ~MessageFilter();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    MessageFilter(
+            const MessageFilter& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    MessageFilter& operator = (
+            const MessageFilter& other) = delete;
+
+    /**
+     * @brief Evaluates the filter on a message.
+     *
+     * @param[in] message The message. Its type must be the one the filter was compiled for.
+     *
+     * @returns `true` if the message must be routed, `false` if it must be discarded.
+     */
+    bool matches(
+            const xtypes::ReadableDynamicDataRef& message) const;
+
+    /**
+     * @brief Gets the expression this filter was compiled from.
+     */
+    const std::string& expression() const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the MessageFilter class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of MessageFilter.
+     *
+     *        Methods named equal to some MessageFilter method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * @brief Constructor, only used by MessageFilter::compile.
+     */
+    MessageFilter(
+            std::unique_ptr<Implementation> pimpl);
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_MESSAGEFILTER_HPP_
@@ -0,0 +1,411 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_METRICS_HPP_
+#define _IS_CORE_RUNTIME_METRICS_HPP_
+
+#include <is/core/export.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class LatencyHistogram
+ *        Lock-free histogram of durations.
+ *
+ *        Bucket `i` counts the durations lower than `2^i` microseconds that did not
+ *        fit in the previous bucket; the last bucket counts everything else.
+ */
+class IS_CORE_API LatencyHistogram
+{
+public:
+
+    /**
+     * @brief Number of buckets of the histogram.
+     */
+    static constexpr std::size_t BUCKETS = 26;
+
+    /**
+     * @struct Snapshot
+     * @brief Plain copy of the values of a LatencyHistogram at a given time.
+     */
+    struct IS_CORE_API Snapshot
+    {
+        std::array<uint64_t, BUCKETS> buckets{};
+        uint64_t count = 0;
+        uint64_t sum_ns = 0;
+        uint64_t max_ns = 0;
+
+        /**
+         * @brief Estimates a quantile of the recorded durations.
+         *
+         * @param[in] quantile The requested quantile, between 0 and 1.
+         *
+         * @returns The upper bound, in nanoseconds, of the bucket that contains the quantile,
+         *          or zero if nothing was recorded.
+         */
+        uint64_t quantile_ns(
+                double quantile) const;
+
+        /**
+         * @brief Gets the mean of the recorded durations.
+         *
+         * @returns The mean duration in nanoseconds, or zero if nothing was recorded.
+         */
+        uint64_t mean_ns() const;
+    };
+
+    /**
+     * @brief Constructor.
+     */
+    LatencyHistogram();
+
+    /**
+     * @brief Records a duration.
+     *
+     * @param[in] duration The duration to be recorded.
+     */
+    void record(
+            std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Takes a snapshot of the histogram.
+     *
+     * @returns The current values of the histogram.
+     */
+    Snapshot snapshot() const;
+
+    /**
+     * @brief Gets the upper bound of a bucket.
+     *
+     * @param[in] bucket The bucket index.
+     *
+     * @returns The exclusive upper bound, in nanoseconds, of the durations counted by `bucket`.
+     *          The last bucket has no upper bound, so `UINT64_MAX` is returned for it.
+     */
+    static uint64_t upper_bound_ns(
+            std::size_t bucket);
+
+private:
+
+    std::array<std::atomic<uint64_t>, BUCKETS> _buckets;
+    std::atomic<uint64_t> _count;
+    std::atomic<uint64_t> _sum_ns;
+    std::atomic<uint64_t> _max_ns;
+};
+
+/**
+ * @struct RouteMetricsSnapshot
+ * @brief Plain copy of the values of a RouteMetrics at a given time.
+ *        Each field has the same meaning as in RouteMetrics.
+ */
+struct IS_CORE_API RouteMetricsSnapshot
+{
+    std::string kind;
+    std::string name;
+    std::string route;
+    std::string source;
+    std::string destination;
+    uint64_t messages_in = 0;
+    uint64_t messages_out = 0;
+    uint64_t conversions = 0;
+    uint64_t drops = 0;
+    uint64_t failures = 0;
+    uint64_t queued_messages = 0;
+    uint64_t queued_bytes = 0;
+    uint64_t retained_bytes = 0;
+    uint64_t dynamic_publishers = 0;
+    uint64_t publisher_evictions = 0;
+    LatencyHistogram::Snapshot publish_time;
+    LatencyHistogram::Snapshot round_trip_time;
+};
+
+/**
+ * @class RouteMetrics
+ *        Lock-free counters of a single route leg: a topic being bridged from a
+ *        source system into a destination system, or a service being called from
+ *        a client system over a server system.
+ *
+ *        For topics, messages are the published samples; for services, they are
+ *        the requests, and the round-trip time measures the time elapsed until the
+ *        reply is given back to the client system.
+ */
+class IS_CORE_API RouteMetrics
+{
+public:
+
+    /**
+     * @brief Signature of the functions that fill in the memory held by a route leg.
+     *        They are given the snapshot being taken, and must add up their values
+     *        to its `queued_messages`, `queued_bytes` and `retained_bytes` fields.
+     *        Destinations with a dynamic topic name also add up the publishers they keep
+     *        to `dynamic_publishers`, and the ones they released to `publisher_evictions`.
+     */
+    using MemoryProbe = std::function<void (RouteMetricsSnapshot& snapshot)>;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] kind Either `topic` or `service`.
+     *
+     * @param[in] name The name of the topic or service.
+     *
+     * @param[in] route The name of the route followed by the topic or service.
+     *
+     * @param[in] source The system the messages come from.
+     *
+     * @param[in] destination The system the messages go to.
+     */
+    RouteMetrics(
+            const std::string& kind,
+            const std::string& name,
+            const std::string& route,
+            const std::string& source,
+            const std::string& destination);
+
+    /**
+     * @brief Counts a message received from the source system.
+     */
+    void received()
+    {
+        _messages_in.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Counts a message that required a type conversion.
+     */
+    void converted()
+    {
+        _conversions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Counts a message that was dropped before reaching the destination system,
+     *        or a service call that was rejected or abandoned before getting its reply.
+     */
+    void dropped()
+    {
+        _drops.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Counts a message handed to the destination system, or a service call once it completes.
+     *
+     * @param[in] success Whether the destination system accepted the message, or replied to the call.
+     *
+     * @param[in] duration Time spent by the destination system to accept the message, or to complete the call.
+     */
+    void sent(
+            bool success,
+            std::chrono::nanoseconds duration)
+    {
+        if (success)
+        {
+            _messages_out.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            _failures.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        _publish_time.record(duration);
+    }
+
+    /**
+     * @brief Records the round-trip time of a service call.
+     *
+     * @param[in] duration Time elapsed since the request was received until its reply was delivered.
+     */
+    void replied(
+            std::chrono::nanoseconds duration)
+    {
+        _round_trip_time.record(duration);
+    }
+
+    /**
+     * @brief Takes a snapshot of the metrics.
+     *
+     * @returns The current values of the metrics.
+     */
+    RouteMetricsSnapshot snapshot() const;
+
+    /**
+     * @brief Adds a function that measures some memory held by the route leg, such as
+     *        the messages waiting in its dispatch queue, every time a snapshot is taken.
+     *
+     * @param[in] probe The function to be called by `snapshot()`.
+     */
+    void add_memory_probe(
+            MemoryProbe probe);
+
+    /**
+     * @brief Gets whether the route leg belongs to a `topic` or to a `service`.
+     */
+    const std::string& kind() const
+    {
+        return _kind;
+    }
+
+    /**
+     * @brief Gets the name of the topic or service.
+     */
+    const std::string& name() const
+    {
+        return _name;
+    }
+
+    /**
+     * @brief Gets the system the messages go to.
+     */
+    const std::string& destination() const
+    {
+        return _destination;
+    }
+
+private:
+
+    const std::string _kind;
+    const std::string _name;
+    const std::string _route;
+    const std::string _source;
+    const std::string _destination;
+
+    std::atomic<uint64_t> _messages_in;
+    std::atomic<uint64_t> _messages_out;
+    std::atomic<uint64_t> _conversions;
+    std::atomic<uint64_t> _drops;
+    std::atomic<uint64_t> _failures;
+    LatencyHistogram _publish_time;
+    LatencyHistogram _round_trip_time;
+
+    mutable std::mutex _probes_mutex;
+    std::vector<MemoryProbe> _probes;
+};
+
+/**
+ * @struct TypeRegistrySnapshot
+ * @brief Memory held by the type registry of a system.
+ */
+struct IS_CORE_API TypeRegistrySnapshot
+{
+    std::string system;
+    std::size_t types = 0;
+    uint64_t bytes = 0;
+};
+
+/**
+ * @class MetricsRegistry
+ *        Holds the RouteMetrics of every route leg configured in an *Integration Service* instance.
+ *
+ *        Registering new route legs takes a lock, but updating their metrics does not.
+ */
+class IS_CORE_API MetricsRegistry
+{
+public:
+
+    /**
+     * @brief Registers a new route leg.
+     *
+     * @param[in] kind Either `topic` or `service`.
+     *
+     * @param[in] name The name of the topic or service.
+     *
+     * @param[in] route The name of the route followed by the topic or service.
+     *
+     * @param[in] source The system the messages come from.
+     *
+     * @param[in] destination The system the messages go to.
+     *
+     * @returns The metrics of the route leg, to be updated by the routing code.
+     */
+    std::shared_ptr<RouteMetrics> add(
+            const std::string& kind,
+            const std::string& name,
+            const std::string& route,
+            const std::string& source,
+            const std::string& destination);
+
+    /**
+     * @brief Unregisters all the route legs of a topic or service.
+     *
+     * @param[in] kind Either `topic` or `service`.
+     *
+     * @param[in] name The name of the topic or service.
+     */
+    void remove(
+            const std::string& kind,
+            const std::string& name);
+
+    /**
+     * @brief Takes a snapshot of all the registered route legs.
+     *
+     * @returns The current values of the metrics, in registration order.
+     */
+    std::vector<RouteMetricsSnapshot> snapshot() const;
+
+    /**
+     * @brief Sets the memory held by the type registry of a system,
+     *        replacing any value previously set for the same system.
+     *
+     * @param[in] system The name of the system.
+     *
+     * @param[in] types The number of types in the registry.
+     *
+     * @param[in] bytes The estimated size of the registry, as given by `MemoryUsage::of()`.
+     */
+    void set_type_registry(
+            const std::string& system,
+            std::size_t types,
+            uint64_t bytes);
+
+    /**
+     * @brief Gets the memory held by the type registries of every system.
+     *
+     * @returns The values set by `set_type_registry()`, in registration order.
+     */
+    std::vector<TypeRegistrySnapshot> type_registries() const;
+
+    /**
+     * @brief Formats the current values of the metrics as a human readable table.
+     *
+     * @returns A string with one line per route leg.
+     */
+    std::string to_string() const;
+
+private:
+
+    mutable std::mutex _mutex;
+    std::vector<std::shared_ptr<RouteMetrics> > _routes;
+    std::vector<TypeRegistrySnapshot> _type_registries;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_METRICS_HPP_
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_METRICSEXPORTER_HPP_
+#define _IS_CORE_RUNTIME_METRICSEXPORTER_HPP_
+
+#include <is/core/runtime/Metrics.hpp>
+#include <is/core/export.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class MetricsExporter
+ *        Minimal HTTP server that exposes the contents of a MetricsRegistry
+ *        using the *Prometheus* text exposition format, so that the route metrics
+ *        of a running *Integration Service* instance can be scraped.
+ *
+ *        Requests are served, one at a time, from a dedicated thread.
+ *        Only `GET /metrics` (or `GET /`) is answered; any other path gets a 404 reply.
+ */
+class IS_CORE_API MetricsExporter
+{
+public:
+
+    /**
+     * @brief Function giving the metrics to be served on each scrape.
+     */
+    using Source = std::function<std::vector<RouteMetricsSnapshot>()>;
+
+    /**
+     * @brief Constructor. The exporter does not listen until `start()` is called.
+     *
+     * @param[in] registry The registry whose metrics will be served.
+     *            It must outlive this exporter.
+     */
+    MetricsExporter(
+            const MetricsRegistry& registry);
+
+    /**
+     * @brief Constructor. The exporter does not listen until `start()` is called.
+     *
+     * @param[in] source The function giving the metrics to be served.
+     *            It is called from the serving thread.
+     */
+    MetricsExporter(
+            Source source);
+
+    /**
+     * @brief Destructor. Stops the exporter, if it is running.
+     */
+    ~MetricsExporter();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    MetricsExporter(
+            const MetricsExporter& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    MetricsExporter& operator = (
+            const MetricsExporter& other) = delete;
+
+    /**
+     * @brief Binds the listening socket and starts serving scrapes.
+     *
+     * @param[in] address IPv4 address to listen on.
+     *
+     * @param[in] port TCP port to listen on. If zero, an ephemeral port is chosen,
+     *            which can be retrieved afterwards with `port()`.
+     *
+     * @returns `true` if the exporter is listening, `false` otherwise.
+     */
+    bool start(
+            const std::string& address,
+            uint16_t port);
+
+    /**
+     * @brief Stops serving scrapes and closes the listening socket.
+     */
+    void stop();
+
+    /**
+     * @brief Gets the port where the exporter is listening.
+     *
+     * @returns The bound TCP port, or zero if the exporter is not running.
+     */
+    uint16_t port() const;
+
+    /**
+     * @brief Formats a set of route metrics using the *Prometheus* text exposition format.
+     *
+     * @details Every sample is labelled with the route name, the topic or service name,
+     *          and the source and destination middleware aliases.
+     *
+     * @param[in] routes The route metrics to be formatted.
+     *
+     * @returns The formatted metrics.
+     */
+    static std::string format(
+            const std::vector<RouteMetricsSnapshot>& routes);
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the MetricsExporter class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of MetricsExporter.
+     *
+     *        Methods named equal to some MetricsExporter method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_METRICSEXPORTER_HPP_
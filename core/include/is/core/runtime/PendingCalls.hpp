@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_PENDINGCALLS_HPP_
+#define _IS_CORE_RUNTIME_PENDINGCALLS_HPP_
+
+#include <is/systemhandle/SystemHandle.hpp>
+#include <is/core/export.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class PendingCalls
+ *        Table of the service calls that were forwarded to a server and are still
+ *        waiting for their reply, so that their number can be bounded and the calls
+ *        that take too long can be abandoned.
+ *
+ *        Each call is identified by the token returned by PendingCalls::add, which
+ *        is the handle given to the ServiceProvider instead of the one of the client.
+ *        When a call times out, it is removed from the table and its ServiceClient
+ *        gets notified through ServiceClient::receive_cancellation, from the expiry
+ *        thread of the table. A reply arriving afterwards is discarded.
+ */
+class IS_CORE_API PendingCalls
+{
+public:
+
+    /**
+     * @brief A pending call.
+     */
+    struct Call
+    {
+        /**
+         * The client proxy that made the call.
+         */
+        ServiceClient* client;
+
+        /**
+         * The handle given to the call by the client proxy.
+         */
+        std::shared_ptr<void> handle;
+
+        /**
+         * The moment when the call was made.
+         */
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @brief Signature of the function called for each call abandoned after its timeout.
+     */
+    using TimeoutCallback = std::function<void (const Call& call)>;
+
+    /**
+     * @brief Constructor. Starts the expiry thread of the table, if there is a timeout.
+     *
+     * @param[in] name Name used to identify this table in the log messages.
+     *
+     * @param[in] timeout Time after which a pending call is abandoned. Zero means no timeout.
+     *
+     * @param[in] max_in_flight Maximum number of pending calls. Zero means no limit.
+     *
+     * @param[in] on_timeout Function called after abandoning each call, if given.
+     */
+    PendingCalls(
+            const std::string& name,
+            std::chrono::nanoseconds timeout,
+            std::size_t max_in_flight,
+            TimeoutCallback on_timeout = nullptr);
+
+    /**
+     * @brief Destructor. Stops the expiry thread, discarding the calls still pending
+     *        without notifying their clients.
+     */
+    ~PendingCalls();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    PendingCalls(
+            const PendingCalls& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    PendingCalls& operator = (
+            const PendingCalls& other) = delete;
+
+    /**
+     * @brief Registers a new pending call.
+     *
+     * @param[in] client The client proxy that made the call.
+     *
+     * @param[in] call_handle The handle given to the call by the client proxy.
+     *
+     * @returns The token that identifies the call, or `nullptr` if the maximum
+     *          number of pending calls was reached, in which case the call must be rejected.
+     */
+    std::shared_ptr<void> add(
+            ServiceClient& client,
+            std::shared_ptr<void> call_handle);
+
+    /**
+     * @brief Removes a call from the table, once its reply has arrived.
+     *
+     * @param[in] token The token returned by `add()` for this call.
+     *
+     * @param[out] call The removed call.
+     *
+     * @returns `true` if the call was still pending, `false` if it had already been abandoned.
+     */
+    bool take(
+            const std::shared_ptr<void>& token,
+            Call& call);
+
+    /**
+     * @brief Gets the number of calls currently pending.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the total number of calls abandoned after their timeout.
+     */
+    uint64_t timeouts() const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the PendingCalls class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of PendingCalls.
+     *
+     *        Methods named equal to some PendingCalls method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_PENDINGCALLS_HPP_
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_PRIORITYDISPATCHER_HPP_
+#define _IS_CORE_RUNTIME_PRIORITYDISPATCHER_HPP_
+
+#include <is/core/runtime/DispatchQueue.hpp>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class PriorityDispatcher
+ *        Set of bounded queues, or lanes, served by a single worker thread that always
+ *        delivers the message of the highest priority lane with messages waiting.
+ *
+ *        All the prioritized topics routed to the same destination middleware share one
+ *        dispatcher, so that latency-critical messages are published before any bulk
+ *        message still queued. A publication in progress is never interrupted; preemption
+ *        happens between messages. Lanes with the same priority are served in turns,
+ *        and each lane keeps the order of its own messages and applies its own
+ *        DispatchQueue::Policy when it is full.
+ */
+class IS_CORE_API PriorityDispatcher
+{
+public:
+
+    using Consumer = DispatchQueue::Consumer;
+
+    using PushResult = DispatchQueue::PushResult;
+
+    /**
+     * @brief Constructor. Starts the worker thread of the dispatcher.
+     *
+     * @param[in] name Name used to identify this dispatcher in the log messages.
+     */
+    PriorityDispatcher(
+            const std::string& name);
+
+    /**
+     * @brief Destructor. Stops the worker thread, discarding any message still queued.
+     */
+    ~PriorityDispatcher();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    PriorityDispatcher(
+            const PriorityDispatcher& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    PriorityDispatcher& operator = (
+            const PriorityDispatcher& other) = delete;
+
+    /**
+     * @brief Adds a lane to the dispatcher.
+     *
+     * @param[in] priority The priority of the lane. Higher values are served first.
+     *
+     * @param[in] depth Maximum number of messages that the lane can hold. Must be greater than zero.
+     *
+     * @param[in] policy What to do when a message is pushed while the lane is full.
+     *
+     * @param[in] consumer Function called from the worker thread for each message of the lane.
+     *
+     * @returns The identifier of the new lane, to be used in `push()`.
+     */
+    std::size_t add_lane(
+            int priority,
+            std::size_t depth,
+            DispatchQueue::Policy policy,
+            Consumer consumer);
+
+    /**
+     * @brief Removes a lane from the dispatcher, discarding its queued messages.
+     *        Messages pushed into it from then on are dropped. If the worker thread
+     *        is delivering a message of the lane, it finishes doing so.
+     *
+     * @param[in] lane The identifier given by `add_lane()`. It is not given to any other lane.
+     */
+    void remove_lane(
+            std::size_t lane);
+
+    /**
+     * @brief Pushes a message into a lane, applying the lane policy if it is full.
+     *
+     * @param[in] lane The identifier given by `add_lane()`.
+     *
+     * @param[in] message The message to be dispatched.
+     *
+     * @returns Whether the message was queued, and if the oldest queued one was discarded for it.
+     */
+    PushResult push(
+            std::size_t lane,
+            std::shared_ptr<const xtypes::DynamicData> message);
+
+    /**
+     * @brief Gets the number of messages currently waiting in all the lanes.
+     *
+     * @returns The number of queued messages.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the number of messages currently waiting in a lane.
+     *
+     * @param[in] lane The identifier given by `add_lane()`.
+     *
+     * @returns The number of messages queued in the lane.
+     */
+    std::size_t lane_size(
+            std::size_t lane) const;
+
+    /**
+     * @brief Gets the memory held by the messages currently waiting in a lane.
+     *
+     * @param[in] lane The identifier given by `add_lane()`.
+     *
+     * @returns The estimated size of the messages queued in the lane, in bytes.
+     */
+    std::size_t lane_bytes(
+            std::size_t lane) const;
+
+    /**
+     * @brief Gets the total number of messages dropped by the lanes of this dispatcher.
+     *
+     * @returns The number of dropped messages.
+     */
+    uint64_t dropped() const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the PriorityDispatcher class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of PriorityDispatcher.
+     *
+     *        Methods named equal to some PriorityDispatcher method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_PRIORITYDISPATCHER_HPP_
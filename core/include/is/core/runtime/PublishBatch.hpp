@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_PUBLISHBATCH_HPP_
+#define _IS_CORE_RUNTIME_PUBLISHBATCH_HPP_
+
+#include <is/systemhandle/SystemHandle.hpp>
+#include <is/core/runtime/Metrics.hpp>
+#include <is/core/export.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class PublishBatch
+ *        Accumulates, on the current thread, the messages routed to publishers that
+ *        prefer batches, so that each of them gets a single `TopicPublisher::publish_batch()`
+ *        call with the whole burst, instead of one `publish()` call per message.
+ *
+ *        A batch is opened by constructing a PublishBatch, for example around the
+ *        `spin_once()` call of a SystemHandle, and the accumulated messages are published
+ *        when it is destroyed. Batches do not nest: while one is open on a thread,
+ *        opening another one has no effect.
+ */
+class IS_CORE_API PublishBatch
+{
+public:
+
+    /**
+     * @brief Maximum number of messages accumulated for a publisher before publishing them,
+     *        even if the batch is still open.
+     */
+    static constexpr std::size_t MAX_SIZE = 256;
+
+    /**
+     * @brief Constructor. Opens a batch on the current thread, if there was none.
+     */
+    PublishBatch();
+
+    /**
+     * @brief Destructor. Publishes the accumulated messages.
+     */
+    ~PublishBatch();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    PublishBatch(
+            const PublishBatch& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    PublishBatch& operator = (
+            const PublishBatch& other) = delete;
+
+    /**
+     * @brief Publishes the messages accumulated so far.
+     */
+    void flush();
+
+    /**
+     * @brief Adds a message to the batch open on the current thread, if any.
+     *
+     * @param[in] publisher The publisher the message is routed to.
+     *
+     * @param[in] message The message to be published.
+     *
+     * @param[in] metrics The metrics of the route leg, updated once the message is published.
+     *
+     * @returns `true` if the message was added, `false` if there is no batch open
+     *          on this thread, in which case it must be published right away.
+     */
+    static bool add(
+            const std::shared_ptr<TopicPublisher>& publisher,
+            std::shared_ptr<const xtypes::DynamicData> message,
+            const std::shared_ptr<RouteMetrics>& metrics);
+
+private:
+
+    struct Pending
+    {
+        std::shared_ptr<TopicPublisher> publisher;
+        std::shared_ptr<RouteMetrics> metrics;
+        std::vector<std::shared_ptr<const xtypes::DynamicData> > messages;
+    };
+
+    static void publish(
+            Pending& pending);
+
+    bool _open;
+    std::vector<Pending> _pending;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_PUBLISHBATCH_HPP_
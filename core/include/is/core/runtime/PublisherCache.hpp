@@ -0,0 +1,230 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_PUBLISHERCACHE_HPP_
+#define _IS_CORE_RUNTIME_PUBLISHERCACHE_HPP_
+
+#include <is/systemhandle/SystemHandle.hpp>
+#include <is/core/export.hpp>
+#include <is/core/runtime/StringTemplate.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class PublisherCache
+ *        Bounded cache of the publishers advertised for topic names computed at runtime,
+ *        for example, by a StringTemplate.
+ *
+ *        A publisher is advertised the first time its topic name is requested, and kept
+ *        until the cache is full and it is the least recently used one, so that dynamic
+ *        topics neither advertise again on every message nor grow without bounds.
+ *        Evicted publishers are released, and advertised again if their name comes back.
+ *
+ *        Requests for cached names only share the lock of the cache. Names are advertised
+ *        without holding it, so a slow advertisement only delays the requests for that name.
+ */
+class IS_CORE_API PublisherCache
+{
+public:
+
+    /**
+     * @brief Signature of the function that advertises the publisher of a topic name.
+     *        It may return `nullptr` if the topic cannot be advertised.
+     */
+    using Advertiser = std::function<std::shared_ptr<TopicPublisher>(const std::string& topic_name)>;
+
+    /**
+     * @struct Stats
+     * @brief Counters of the usage of a PublisherCache.
+     */
+    struct IS_CORE_API Stats
+    {
+        uint64_t hits = 0;          ///< Requests served by an already advertised publisher.
+        uint64_t misses = 0;        ///< Requests that had to advertise a publisher.
+        uint64_t evictions = 0;     ///< Publishers released to make room for new ones.
+        uint64_t failures = 0;      ///< Advertisements that did not produce a publisher.
+        std::size_t size = 0;       ///< Publishers currently cached.
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] name Name used to identify this cache in the log messages.
+     *
+     * @param[in] capacity Maximum number of cached publishers. Must be greater than zero.
+     *
+     * @param[in] advertiser Function called to advertise the publisher of each new topic name.
+     */
+    PublisherCache(
+            const std::string& name,
+            std::size_t capacity,
+            Advertiser advertiser);
+
+    /**
+     * @brief Destructor. Releases every cached publisher.
+     */
+    ~PublisherCache();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    PublisherCache(
+            const PublisherCache& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    PublisherCache& operator = (
+            const PublisherCache& other) = delete;
+
+    /**
+     * @brief Gets the publisher of a topic name, advertising it if it is not cached.
+     *        Concurrent requests for a new name advertise it only once.
+     *
+     * @param[in] topic_name The topic name.
+     *
+     * @returns The publisher, or `nullptr` if it could not be advertised.
+     *          Failed advertisements are not cached, so they are retried on the next request.
+     */
+    std::shared_ptr<TopicPublisher> get(
+            const std::string& topic_name);
+
+    /**
+     * @brief Gets the usage counters of this cache.
+     *
+     * @returns A copy of the current counters.
+     */
+    Stats stats() const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the PublisherCache class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of PublisherCache.
+     *
+     *        Methods named equal to some PublisherCache method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+/**
+ * @class DynamicTopicPublisher
+ *        TopicPublisher whose topic name is computed from each message by a StringTemplate,
+ *        such as `dynamic/{message.data}`, and which publishes it through the publisher
+ *        that a PublisherCache keeps for that name.
+ *
+ *        Integration Service publishes through it the topics whose destination name is
+ *        a template, advertising each computed name through the `advertise()` method of the
+ *        destination SystemHandle.
+ */
+class IS_CORE_API DynamicTopicPublisher : public TopicPublisher
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] topic_template The template of the topic names.
+     *
+     * @param[in] message_type The type of the published messages, to which the template is bound.
+     *            It must outlive this publisher.
+     *
+     * @param[in] capacity Maximum number of topic names with an advertised publisher.
+     *
+     * @param[in] advertiser Function called to advertise the publisher of each new topic name.
+     *
+     * @throws UnavailableMessageField if any field of the template is not a member of `message_type`.
+     */
+    DynamicTopicPublisher(
+            const std::string& topic_template,
+            const xtypes::DynamicType& message_type,
+            std::size_t capacity,
+            PublisherCache::Advertiser advertiser);
+
+    /**
+     * @brief Destructor.
+     */
+    ~DynamicTopicPublisher() override;
+
+    /**
+     * @brief Computes the topic name of the message, and publishes it there.
+     *
+     * @param[in] message DynamicData that is being published.
+     *
+     * @returns `true` if the data was correctly published, `false` if the topic name could
+     *          not be computed, its publisher could not be advertised, or publishing failed.
+     */
+    bool publish(
+            const xtypes::DynamicData& message) override;
+
+    /**
+     * @brief Computes the topic name of the message, and publishes it there,
+     *        handing the shared message to the publisher of that name.
+     *
+     * @param[in] message Shared DynamicData that is being published.
+     *
+     * @returns `true` if the data was correctly published, `false` otherwise.
+     */
+    bool publish_shared(
+            const std::shared_ptr<const xtypes::DynamicData>& message) override;
+
+    /**
+     * @brief Documentation inherited from TopicPublisher.
+     *        Shared messages are always accepted, since the publishers of each name
+     *        are only known once the message arrives.
+     */
+    bool prefers_shared_messages() const override;
+
+    /**
+     * @brief Gets the cache of the publishers of each topic name.
+     *
+     * @returns A reference to the cache.
+     */
+    const PublisherCache& cache() const;
+
+private:
+
+    std::shared_ptr<TopicPublisher> publisher_for(
+            const xtypes::DynamicData& message);
+
+    StringTemplate _topic_template;
+    PublisherCache _cache;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_PUBLISHERCACHE_HPP_
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_RATELIMITER_HPP_
+#define _IS_CORE_RUNTIME_RATELIMITER_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+#include <is/core/runtime/TaskScheduler.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class RateLimiter
+ *        Token bucket that limits the rate at which messages reach one of the
+ *        destinations of a route.
+ *
+ *        The bucket holds up to `burst` tokens, and gets `max_rate` new tokens per second.
+ *        Each delivered message takes one token. If there are no tokens left when a
+ *        message is offered, the message is discarded or, in *latest only* mode, kept
+ *        aside, replacing any other message kept before, and delivered by a task run
+ *        through the scheduler as soon as the next token arrives. This way, a destination
+ *        always gets the freshest sample available at the configured rate.
+ *
+ *        A limiter can be shared by the sources of a route, so that their messages share
+ *        the rate of the destination. Each message is delivered to the consumer given
+ *        along with it, such as the queue of the route leg it came from.
+ */
+class IS_CORE_API RateLimiter
+{
+public:
+
+    /**
+     * @brief Signature of the function that consumes each delivered message.
+     */
+    using Consumer = std::function<void (const std::shared_ptr<const xtypes::DynamicData>& message)>;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] name Name used to identify this limiter in the log messages.
+     *
+     * @param[in] max_rate Maximum sustained number of messages per second. Must be greater than zero.
+     *
+     * @param[in] burst Maximum number of messages delivered at once after an idle period.
+     *
+     * @param[in] latest_only Whether the latest message exceeding the rate is kept and
+     *            delivered later on, instead of being discarded.
+     *
+     * @param[in] scheduler Runs the task delivering the message kept aside once the next token
+     *            arrives. If empty, the message kept aside is delivered when a message is offered
+     *            after that.
+     */
+    RateLimiter(
+            const std::string& name,
+            double max_rate,
+            std::size_t burst,
+            bool latest_only,
+            TaskScheduler scheduler = nullptr);
+
+    /**
+     * @brief Destructor. Discards the message kept aside, if any.
+     */
+    ~RateLimiter();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    RateLimiter(
+            const RateLimiter& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    RateLimiter& operator = (
+            const RateLimiter& other) = delete;
+
+    /**
+     * @brief Offers a message to the limiter, which delivers it right away if
+     *        the rate allows it.
+     *
+     * @param[in] message The message to be delivered.
+     *
+     * @param[in] consumer Function called when the message is delivered, either from
+     *            the thread offering it or from the one running the scheduled task.
+     *
+     * @returns `false` if some message, either the provided one or the one kept
+     *          aside before, was discarded; `true` otherwise.
+     */
+    bool offer(
+            std::shared_ptr<const xtypes::DynamicData> message,
+            const Consumer& consumer);
+
+    /**
+     * @brief Gets the number of messages kept aside, waiting for the rate to allow them.
+     *
+     * @returns Either zero or one, since only the latest message is kept.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the memory held by the message kept aside.
+     *
+     * @returns The estimated size of the message, in bytes, or zero if none is kept.
+     */
+    std::size_t bytes() const;
+
+    /**
+     * @brief Gets the total number of messages discarded by this limiter.
+     *
+     * @returns The number of discarded messages.
+     */
+    uint64_t dropped() const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the RateLimiter class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of RateLimiter.
+     *
+     *        Methods named equal to some RateLimiter method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::shared_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_RATELIMITER_HPP_
@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_REQUESTCOALESCER_HPP_
+#define _IS_CORE_RUNTIME_REQUESTCOALESCER_HPP_
+
+#include <is/systemhandle/SystemHandle.hpp>
+#include <is/core/export.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class RequestCoalescer
+ *        Sits between the clients of an idempotent service and its ServiceProvider,
+ *        so that identical requests made while a previous one is still waiting for its
+ *        reply do not reach the server again: they wait for that reply instead, which
+ *        is given back to every client that made the request.
+ *
+ *        Optionally, replies are kept for a short time, and identical requests arriving
+ *        meanwhile are answered straight away, from the thread that makes the request.
+ *
+ *        Requests are identified by a hash of their contents, and compared for equality
+ *        before being coalesced. A call takes identical requests until it gets its reply,
+ *        it is older than the maximum age, or it has the maximum number of waiting clients;
+ *        identical requests are then sent to the server again.
+ *
+ *        It acts as the ServiceProvider for the clients of the service, and as the
+ *        ServiceClient of the actual provider.
+ */
+class IS_CORE_API RequestCoalescer : public ServiceProvider, public ServiceClient
+{
+public:
+
+    /**
+     * @brief Default number of clients that may wait for the reply of the same call.
+     */
+    static constexpr std::size_t DEFAULT_MAX_WAITERS = 64;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] provider The provider of the service.
+     *
+     * @param[in] reply_ttl Time during which the replies are used for identical requests.
+     *            Zero disables the reply cache.
+     *
+     * @param[in] max_age Time after which a request waiting for its reply no longer
+     *            takes identical requests, which are then sent to the server again.
+     *            Zero means that requests are coalesced until their reply arrives.
+     *
+     * @param[in] max_waiters Number of clients, including the first one, after which a request
+     *            waiting for its reply no longer takes identical requests, so that a reply that
+     *            never arrives does not hold an unbounded number of them. It must be positive.
+     */
+    RequestCoalescer(
+            std::shared_ptr<ServiceProvider> provider,
+            std::chrono::nanoseconds reply_ttl,
+            std::chrono::nanoseconds max_age = std::chrono::nanoseconds::zero(),
+            std::size_t max_waiters = DEFAULT_MAX_WAITERS);
+
+    /**
+     * @brief Destructor.
+     */
+    ~RequestCoalescer() override;
+
+    /**
+     * @brief Calls the service, unless an identical request is waiting for its reply,
+     *        or was recently replied.
+     *
+     * @param[in] request Request message for the service.
+     *
+     * @param[in,out] client The client that will receive the reply.
+     *
+     * @param[in] call_handle The handle given to the call by the client.
+     */
+    void call_service(
+            const xtypes::DynamicData& request,
+            ServiceClient& client,
+            std::shared_ptr<void> call_handle) override;
+
+    void receive_response(
+            std::shared_ptr<void> call_handle,
+            const xtypes::DynamicData& response) override;
+
+    void receive_cancellation(
+            std::shared_ptr<void> call_handle) override;
+
+    /**
+     * @brief Gets the number of requests sent to the server.
+     */
+    uint64_t calls() const;
+
+    /**
+     * @brief Gets the number of requests that were answered without calling the server.
+     */
+    uint64_t coalesced() const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the RequestCoalescer class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of RequestCoalescer.
+     *
+     *        Methods named equal to some RequestCoalescer method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_REQUESTCOALESCER_HPP_
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef _IS_CORE_RUNTIME_SAMPLEAGGREGATOR_HPP_
+#define _IS_CORE_RUNTIME_SAMPLEAGGREGATOR_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class SampleAggregator
+ *        Collects the messages sent to one of the destinations of a route into batch
+ *        frames, so that links with a high latency, such as a WAN tunnel between two
+ *        *Integration Service* instances, carry one frame per window instead of one
+ *        message per sample.
+ *
+ *        A window opens with its first sample, and its frame is delivered once it holds
+ *        `max_samples` samples or `max_bytes` encoded bytes, or `max_delay` seconds after
+ *        it was opened, whatever happens first. Frames are messages of `frame_type()`:
+ *
+ *        - `samples`: the number of samples in the frame.
+ *        - `compression`: the `Compression` of the payload.
+ *        - `size`: the size of the payload before compression.
+ *        - `payload`: each sample, as given by `TrafficRecorder::encode()`,
+ *          preceded by its 32 bits size, and compressed as a whole.
+ *
+ *        A frame is sent uncompressed when compressing it does not make it smaller.
+ *        Sizes are stored with the byte order of the host, so both instances must share it.
+ *        The receiving instance gets the samples back with `unpack()`.
+ */
+class IS_CORE_API SampleAggregator
+{
+public:
+
+    /**
+     * @brief Compression algorithms for the payload of the frames.
+     *        The ones not found when *Integration Service* was built are not available.
+     */
+    enum class Compression : uint8_t
+    {
+        NONE = 0,
+        LZ4 = 1,
+        ZSTD = 2
+    };
+
+    /**
+     * @brief Signature of the function that consumes each delivered frame.
+     */
+    using Consumer = std::function<void (const std::shared_ptr<const xtypes::DynamicData>& frame)>;
+
+    /**
+     * @brief Signature of the function that consumes each sample unpacked from a frame.
+     */
+    using SampleConsumer = std::function<void (const xtypes::DynamicData& sample)>;
+
+    /**
+     * @brief Constructor. Starts the worker thread that delivers the frames of expired windows.
+     *
+     * @param[in] name Name used to identify this aggregator in the log messages.
+     *
+     * @param[in] max_samples Maximum number of samples in a frame. Must be greater than zero.
+     *
+     * @param[in] max_bytes Size of the encoded samples from which a frame is delivered.
+     *            Zero means that the size is not limited.
+     *
+     * @param[in] max_delay Maximum time, in seconds, a sample waits for its frame to be delivered.
+     *
+     * @param[in] compression The compression applied to the payload of the frames.
+     *            It must be available.
+     *
+     * @param[in] consumer Function called for each frame, either from the thread offering
+     *            the sample that completes it or from the worker thread. Frames are
+     *            delivered one at a time, in order.
+     */
+    SampleAggregator(
+            const std::string& name,
+            std::size_t max_samples,
+            std::size_t max_bytes,
+            double max_delay,
+            Compression compression,
+            Consumer consumer);
+
+    /**
+     * @brief Destructor. Stops the worker thread, discarding the samples of the open window.
+     */
+    ~SampleAggregator();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    SampleAggregator(
+            const SampleAggregator& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    SampleAggregator& operator = (
+            const SampleAggregator& other) = delete;
+
+    /**
+     * @brief Adds a sample to the open window. It may be called from several threads at once.
+     *
+     * @param[in] sample The message to be aggregated.
+     *
+     * @returns `false` if the type of the sample cannot be encoded, `true` otherwise.
+     */
+    bool offer(
+            const xtypes::ReadableDynamicDataRef& sample);
+
+    /**
+     * @brief Delivers the frame of the open window right away, if it holds any sample.
+     */
+    void flush();
+
+    /**
+     * @brief Gets the number of samples in the open window.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the size of the encoded samples in the open window, in bytes.
+     */
+    std::size_t bytes() const;
+
+    /**
+     * @brief Gets the memory reserved by the buffers of the aggregator beyond the
+     *        encoded samples of the open window, which is kept to encode the next frames.
+     */
+    std::size_t retained() const;
+
+    /**
+     * @brief Gets the total number of delivered frames.
+     */
+    uint64_t frames() const;
+
+    /**
+     * @brief Gets the type of the frames, which both ends of the aggregated route must use.
+     */
+    static const xtypes::StructType& frame_type();
+
+    /**
+     * @brief Tells whether a compression algorithm was available when building *Integration Service*.
+     */
+    static bool available(
+            Compression compression);
+
+    /**
+     * @brief Gets the samples of a frame back.
+     *
+     * @param[in] frame The frame, of `frame_type()`.
+     *
+     * @param[in,out] sample The instance, of the type of the aggregated messages,
+     *                where each sample is decoded before calling `consumer`.
+     *
+     * @param[in] consumer Function called for each sample, in order.
+     *
+     * @returns `true` if the whole frame was valid. Otherwise, the samples found before
+     *          the invalid one are still given.
+     */
+    static bool unpack(
+            const xtypes::ReadableDynamicDataRef& frame,
+            xtypes::DynamicData& sample,
+            const SampleConsumer& consumer);
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the SampleAggregator class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of SampleAggregator.
+     *
+     *        Methods named equal to some SampleAggregator method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_SAMPLEAGGREGATOR_HPP_
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_SAMPLEDEDUPLICATOR_HPP_
+#define _IS_CORE_RUNTIME_SAMPLEDEDUPLICATOR_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class SampleDeduplicator
+ *        Discards the copies of a sample received more than once within a time window,
+ *        such as those of a topic routed from several redundant `from` systems.
+ *
+ *        Samples are identified by the DataHash of a key field, such as a sequence number,
+ *        or of the whole message if no key is given. Hashes are remembered for `window`
+ *        seconds, up to `capacity` of them; when full, the oldest hash is forgotten first.
+ *        Equal hashes are considered equal samples without comparing them, since the
+ *        copies usually come from middlewares with different, although compatible, types.
+ *        A deduplicator can be shared by the subscriptions of all the sources of a route.
+ */
+class IS_CORE_API SampleDeduplicator
+{
+public:
+
+    /**
+     * @brief The key field of a message type, resolved into the indexes of the
+     *        members followed to reach it from the message root.
+     *        An empty key stands for the whole message.
+     */
+    using Key = std::vector<std::size_t>;
+
+    /**
+     * @brief Resolves the path of a key field, such as `header.seq`, for a message type.
+     *
+     * @param[in] type The message type.
+     *
+     * @param[in] path Dot separated names of the structure members leading to the key field.
+     *            An empty path stands for the whole message.
+     *
+     * @param[out] key The resolved key.
+     *
+     * @param[out] error The reason why the path is not valid, if so.
+     *
+     * @returns `true` if the path names a field of the type, `false` otherwise.
+     */
+    static bool resolve(
+            const xtypes::DynamicType& type,
+            const std::string& path,
+            Key& key,
+            std::string& error);
+
+    /**
+     * @brief Hashes the key field of a message.
+     *
+     * @param[in] data The message. Its type must be the one the key was resolved for.
+     *
+     * @param[in] key The key, resolved for the type of the message.
+     *
+     * @returns The DataHash of the key field.
+     */
+    static std::size_t hash(
+            const xtypes::ReadableDynamicDataRef& data,
+            const Key& key);
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] name Name used to identify this deduplicator in the log messages.
+     *
+     * @param[in] window Time, in seconds, during which the copies of a sample are discarded.
+     *
+     * @param[in] capacity Maximum number of samples remembered at once.
+     */
+    SampleDeduplicator(
+            const std::string& name,
+            double window,
+            std::size_t capacity);
+
+    /**
+     * @brief Destructor.
+     */
+    ~SampleDeduplicator();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    SampleDeduplicator(
+            const SampleDeduplicator& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    SampleDeduplicator& operator = (
+            const SampleDeduplicator& other) = delete;
+
+    /**
+     * @brief Offers a sample to the deduplicator, which remembers it if it is new.
+     *
+     * @param[in] hash The hash of the key of the sample, given by SampleDeduplicator::hash.
+     *
+     * @returns `true` if the sample must be routed, or `false` if it is a copy
+     *          of a sample offered less than `window` seconds ago.
+     */
+    bool offer(
+            std::size_t hash);
+
+    /**
+     * @brief Gets the number of samples currently remembered.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the memory held by the samples currently remembered.
+     *
+     * @returns The estimated size of the remembered hashes, in bytes.
+     */
+    std::size_t bytes() const;
+
+    /**
+     * @brief Gets the total number of copies discarded by this deduplicator.
+     */
+    uint64_t suppressed() const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the SampleDeduplicator class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of SampleDeduplicator.
+     *
+     *        Methods named equal to some SampleDeduplicator method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_SAMPLEDEDUPLICATOR_HPP_
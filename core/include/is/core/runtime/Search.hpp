@@ -170,6 +170,16 @@ public:
     static void set_config_file_directory(
             const std::string& path);
 
+    /**
+     * @brief Forgets the contents of the directories probed so far.
+     *
+     * @details The contents of each directory where files are looked for are listed
+     *          only once, and shared by all the Search instances, so that later searches
+     *          do not hit the filesystem again. This must be called if files are installed
+     *          into, or removed from, any of the search prefixes while the process is running.
+     */
+    static void invalidate_cache();
+
 
     /**
      * @brief Adds priority to the specified path. The paths given here will be used as
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef _IS_CORE_RUNTIME_SERVICECALL_HPP_
+#define _IS_CORE_RUNTIME_SERVICECALL_HPP_
+
+#include <is/systemhandle/SystemHandle.hpp>
+#include <is/core/export.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class ServiceCall
+ *        A service call forwarded to a ServiceProvider, which can be completed once,
+ *        from any thread, either with its reply or with its cancellation.
+ *
+ *        Every call handle that *Integration Service* gives to `ServiceProvider::call_service()`
+ *        is a ServiceCall, so that SystemHandles can keep it, by means of `ServiceCall::from()`,
+ *        instead of keeping the client and the handle of the call in a table of their own.
+ *        Completing a call only takes an atomic operation in the usual case, so calls of the
+ *        same service can be completed concurrently. Calling `client.receive_response()`
+ *        with the handle is still supported, and is equivalent to `reply()`.
+ *
+ *        Other components waiting for a call can block on it, with `wait()`,
+ *        or get a continuation called when it is completed, with `then()`.
+ */
+class IS_CORE_API ServiceCall
+{
+public:
+
+    /**
+     * @brief The state of a service call.
+     */
+    enum class Status
+    {
+        PENDING,
+        REPLIED,
+        CANCELLED
+    };
+
+    /**
+     * @brief Signature of the function called once a call is completed.
+     */
+    using Continuation = std::function<void (Status status)>;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] client The client that will receive the reply of the call.
+     *
+     * @param[in] call_handle The handle given to the call by the client.
+     */
+    ServiceCall(
+            ServiceClient& client,
+            std::shared_ptr<void> call_handle);
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~ServiceCall() = default;
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    ServiceCall(
+            const ServiceCall& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    ServiceCall& operator = (
+            const ServiceCall& other) = delete;
+
+    /**
+     * @brief Gets the ServiceCall of a call handle given by *Integration Service*
+     *        to `ServiceProvider::call_service()`.
+     *
+     * @param[in] call_handle The handle of the call.
+     *
+     * @returns The ServiceCall, which shares the ownership of the handle.
+     */
+    static std::shared_ptr<ServiceCall> from(
+            const std::shared_ptr<void>& call_handle);
+
+    /**
+     * @brief Completes the call with its reply, which is handed to the client.
+     *
+     * @param[in] response The reply of the call.
+     *
+     * @returns `true` if the call was pending, `false` if it had already been completed,
+     *          in which case the reply is discarded.
+     */
+    bool reply(
+            const xtypes::DynamicData& response);
+
+    /**
+     * @brief Completes the call without a reply, notifying the client through
+     *        `ServiceClient::receive_cancellation()`.
+     *
+     * @returns `true` if the call was pending, `false` if it had already been completed.
+     */
+    bool cancel();
+
+    /**
+     * @brief Gets the state of the call.
+     */
+    Status status() const
+    {
+        return _status.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Blocks until the call is completed.
+     *
+     * @returns How the call was completed.
+     */
+    Status wait() const;
+
+    /**
+     * @brief Blocks until the call is completed, or until some time elapses.
+     *
+     * @param[in] timeout The maximum time to wait.
+     *
+     * @returns How the call was completed, or Status::PENDING if the time elapsed before.
+     */
+    Status wait_for(
+            std::chrono::nanoseconds timeout) const;
+
+    /**
+     * @brief Sets the function called once the call is completed, from the thread completing it,
+     *        after the client got the reply. If the call was already completed,
+     *        it is called straight away. Only one continuation can be set.
+     *
+     * @param[in] continuation The function to call.
+     */
+    void then(
+            Continuation continuation);
+
+    /**
+     * @brief Gets the client that will receive the reply of the call.
+     */
+    ServiceClient& client() const
+    {
+        return *_client;
+    }
+
+    /**
+     * @brief Gets the handle given to the call by the client.
+     */
+    const std::shared_ptr<void>& handle() const
+    {
+        return _handle;
+    }
+
+    /**
+     * @brief Gets the moment when the call was made.
+     */
+    std::chrono::steady_clock::time_point start() const
+    {
+        return _start;
+    }
+
+protected:
+
+    /**
+     * @brief Hands the reply to the client. Called once, by the thread completing the call.
+     *        By default, it calls `client().receive_response()`.
+     *
+     * @param[in] response The reply of the call.
+     */
+    virtual void deliver(
+            const xtypes::DynamicData& response);
+
+    /**
+     * @brief Notifies the cancellation to the client. Called once, by the thread completing the call.
+     *        By default, it calls `client().receive_cancellation()`.
+     */
+    virtual void deliver_cancellation();
+
+private:
+
+    bool claim(
+            Status status);
+
+    void finished();
+
+    /**
+     * Class members.
+     */
+
+    ServiceClient* _client;
+    std::shared_ptr<void> _handle;
+    const std::chrono::steady_clock::time_point _start;
+
+    std::atomic<Status> _status;
+    std::atomic_bool _done;
+
+    /**
+     * Only used once some thread waits for the call, or a continuation is set.
+     */
+    mutable std::atomic_bool _waited;
+    mutable std::mutex _mutex;
+    mutable std::condition_variable _completed;
+    Continuation _continuation;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_SERVICECALL_HPP_
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef _IS_CORE_RUNTIME_SHARDSUPERVISOR_HPP_
+#define _IS_CORE_RUNTIME_SHARDSUPERVISOR_HPP_
+
+#include <is/core/runtime/Metrics.hpp>
+#include <is/core/export.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class ShardSupervisor
+ *        Runs the routes of a configuration in several worker processes, so that
+ *        the routing throughput scales with the available cores.
+ *
+ *        Each worker is the same executable, started with the same command line
+ *        arguments plus `--shard <index>/<count>`, so that it only runs its share
+ *        of the topics and services.
+ *
+ *        Workers report their route metrics to the supervisor through a pipe, every second.
+ *        The supervisor serves the metrics of all of them through a single *Prometheus*
+ *        exporter, with the settings of the `metrics` section of the configuration.
+ *
+ *        A worker that exits while the supervisor is running is started again,
+ *        unless it fails right after being started, in which case all the workers are
+ *        stopped. `SIGINT` and `SIGTERM` are forwarded to the workers as `SIGINT`,
+ *        and the supervisor returns once all of them have finished. `SIGHUP` is
+ *        forwarded as is, so that every worker reloads its configuration.
+ *
+ *        Workers are started with `fork()`, so sharding is only supported on POSIX
+ *        systems. Elsewhere, ShardSupervisor::run() logs an error and fails.
+ */
+class IS_CORE_API ShardSupervisor
+{
+public:
+
+    /**
+     * @struct Report
+     * @brief Route metrics reported by a worker process.
+     *
+     * @var Report::exporter_address
+     *      @brief Address where the *Prometheus* exporter of the supervisor must listen.
+     *
+     * @var Report::exporter_port
+     *      @brief Port where the *Prometheus* exporter of the supervisor must listen.
+     *             Zero disables the exporter.
+     *
+     * @var Report::routes
+     *      @brief The metrics of the route legs run by the worker.
+     */
+    struct Report
+    {
+        std::string exporter_address;
+        uint16_t exporter_port = 0;
+        std::vector<RouteMetricsSnapshot> routes;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] argc The number of command line arguments of the executable.
+     *
+     * @param[in] argv The command line arguments of the executable. The `--shards` option
+     *            is taken out of them, and the rest are given to each worker process.
+     */
+    ShardSupervisor(
+            int argc,
+            char* argv[]);
+
+    /**
+     * @brief Destructor.
+     */
+    ~ShardSupervisor();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    ShardSupervisor(
+            const ShardSupervisor& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    ShardSupervisor& operator = (
+            const ShardSupervisor& other) = delete;
+
+    /**
+     * @brief Gets the number of worker processes requested with `--shards`.
+     *
+     * @returns The number of shards, or zero if no valid `--shards` option was given.
+     */
+    std::size_t shards() const;
+
+    /**
+     * @brief Starts the worker processes, and supervises them until all of them finish.
+     *
+     * @returns The highest exit code of the workers, or `1` if they could not be started.
+     */
+    int run();
+
+    /**
+     * @brief Writes a report into the pipe of a worker process.
+     *
+     * @param[in] fd The write end of the pipe.
+     *
+     * @param[in] report The report to be written.
+     *
+     * @returns `true` if the whole report was written, `false` otherwise.
+     */
+    static bool send(
+            int fd,
+            const Report& report);
+
+    /**
+     * @brief Encodes a report into the text form written into the pipes.
+     *
+     * @param[in] report The report to be encoded.
+     *
+     * @returns The encoded report.
+     */
+    static std::string encode(
+            const Report& report);
+
+    /**
+     * @brief Takes the first complete report out of the data read from a pipe.
+     *
+     * @param[in,out] buffer The data read so far. The decoded report is removed from it.
+     *
+     * @param[out] report The decoded report. Malformed route lines are skipped.
+     *
+     * @returns `true` if a complete report was decoded, `false` if more data is needed.
+     */
+    static bool decode(
+            std::string& buffer,
+            Report& report);
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the ShardSupervisor class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of ShardSupervisor.
+     *
+     *        Methods named equal to some ShardSupervisor method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_SHARDSUPERVISOR_HPP_
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_SPINEXECUTOR_HPP_
+#define _IS_CORE_RUNTIME_SPINEXECUTOR_HPP_
+
+#include <is/core/export.hpp>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+
+class SystemHandle;
+
+namespace core {
+
+/**
+ * @class SpinExecutor
+ *        Shared executor for the SystemHandles that accept a wake-up callback.
+ *
+ *        Handles are queued when they notify some pending work, and each one of them
+ *        is spun by, at most, one executor thread at a time. If a handle notifies
+ *        while it is being spun, it gets queued again once `done()` is called.
+ *
+ *        Routes can also post tasks, such as subscribing the sources of a lazy topic,
+ *        or releasing a message kept aside by a rate limiter once some delay has passed,
+ *        which are run by the executor threads before spinning the queued handles.
+ */
+class IS_CORE_API SpinExecutor
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief A SystemHandle served by the executor. Its scheduling state
+     *        is only accessed by the executor.
+     */
+    struct Entry
+    {
+        Entry(
+                const std::string& name_,
+                SystemHandle* handle_)
+            : name(name_)
+            , handle(handle_)
+        {
+        }
+
+        const std::string name;
+        SystemHandle* const handle;
+        bool queued = false;
+        bool running = false;
+        bool notified = false;
+        bool removed = false;
+    };
+
+    /**
+     * @brief Constructor.
+     */
+    SpinExecutor();
+
+    /**
+     * @brief Destructor.
+     */
+    ~SpinExecutor();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    SpinExecutor(
+            const SpinExecutor& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    SpinExecutor& operator = (
+            const SpinExecutor& other) = delete;
+
+    /**
+     * @brief Adds a SystemHandle to the executor.
+     *
+     * @param[in] name The name of the middleware, for the log messages.
+     *
+     * @param[in] handle The SystemHandle.
+     *
+     * @returns The entry of the handle. Wake-up callbacks should only keep a weak reference
+     *          to it, so that notifying it once removed is harmless.
+     */
+    std::shared_ptr<Entry> add(
+            const std::string& name,
+            SystemHandle* handle);
+
+    /**
+     * @brief Removes a SystemHandle from the executor. Later notifications of its entry are ignored.
+     *
+     * @param[in] entry The entry given by `add()`.
+     */
+    void remove(
+            const std::shared_ptr<Entry>& entry);
+
+    /**
+     * @brief Gets the number of SystemHandles in the executor.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Queues a SystemHandle that has some pending work, unless it is already queued.
+     *        If it is being spun, it is queued again once it is done.
+     *
+     * @param[in] entry The entry given by `add()`.
+     */
+    void notify(
+            const std::shared_ptr<Entry>& entry);
+
+    /**
+     * @brief Takes the next queued SystemHandle, which is considered to be running until `done()`.
+     *
+     * @param[in] timeout Maximum time to wait for some handle to be queued. The wait also ends
+     *            when some posted task is due, or once `wake_all()` is called.
+     *
+     * @returns The entry of the handle, or `nullptr` if none was queued.
+     */
+    std::shared_ptr<Entry> next(
+            std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Tells that a SystemHandle given by `next()` has been spun.
+     *
+     * @param[in] entry The entry of the handle.
+     */
+    void done(
+            const std::shared_ptr<Entry>& entry);
+
+    /**
+     * @brief Makes every call to `next()` return without waiting from now on,
+     *        so that the executor threads can finish.
+     */
+    void wake_all();
+
+    /**
+     * @brief Posts a task to be run by the executor threads. Satisfies TaskScheduler.
+     *
+     * @param[in] task The task.
+     *
+     * @param[in] delay Time to wait before running the task.
+     */
+    void post(
+            std::function<void ()> task,
+            Clock::duration delay);
+
+    /**
+     * @brief Takes the earliest task whose delay has passed.
+     *
+     * @returns The task, or an empty function if none is due.
+     */
+    std::function<void ()> next_task();
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the SpinExecutor class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of SpinExecutor.
+     *
+     *        Methods named equal to some SpinExecutor method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_SPINEXECUTOR_HPP_
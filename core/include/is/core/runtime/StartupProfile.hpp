@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_STARTUPPROFILE_HPP_
+#define _IS_CORE_RUNTIME_STARTUPPROFILE_HPP_
+
+#include <is/core/export.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class StartupProfile
+ *        Process-wide record of the wall time spent in each step of the startup of
+ *        *Integration Service*: configuration parsing, type parsing, the loading and
+ *        configuration of each middleware, and the setup of each topic and service route.
+ *
+ *        Recording is disabled by default, and enabled with the `--profile-startup`
+ *        command line flag. While disabled, scopes do not even read the clock.
+ */
+class IS_CORE_API StartupProfile
+{
+public:
+
+    /**
+     * @struct Record
+     * @brief Wall time spent in a single startup step.
+     */
+    struct IS_CORE_API Record
+    {
+        std::string category;               ///< The kind of step, such as `phase`, `middleware` or `topic`.
+        std::string name;                   ///< The name of the step within its category.
+        std::chrono::nanoseconds duration;  ///< The wall time spent in the step.
+    };
+
+    /**
+     * @class Scope
+     *        Measures the wall time from its construction to its destruction,
+     *        and records it in the global StartupProfile, if enabled.
+     */
+    class IS_CORE_API Scope
+    {
+    public:
+
+        /**
+         * @brief Constructor. Starts measuring.
+         *
+         * @param[in] category The kind of step being measured.
+         *
+         * @param[in] name The name of the step being measured.
+         */
+        Scope(
+                const std::string& category,
+                const std::string& name);
+
+        /**
+         * @brief Destructor. Records the measured step.
+         */
+        ~Scope();
+
+        /**
+         * @brief Deleted copy constructor.
+         */
+        Scope(
+                const Scope& other) = delete;
+
+        /**
+         * @brief Deleted copy assignment operator.
+         */
+        Scope& operator = (
+                const Scope& other) = delete;
+
+    private:
+
+        const bool _enabled;
+        std::string _category;
+        std::string _name;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    /**
+     * @brief Gets the profile shared by the whole process.
+     *
+     * @returns A reference to the global profile.
+     */
+    static StartupProfile& global();
+
+    /**
+     * @brief Enables or disables recording.
+     *
+     * @param[in] enabled Whether the following steps must be recorded.
+     */
+    void enable(
+            bool enabled = true);
+
+    /**
+     * @brief Tells whether recording is enabled.
+     */
+    bool enabled() const;
+
+    /**
+     * @brief Records a step, if recording is enabled.
+     *
+     * @param[in] category The kind of step.
+     *
+     * @param[in] name The name of the step.
+     *
+     * @param[in] duration The wall time spent in the step.
+     */
+    void add(
+            const std::string& category,
+            const std::string& name,
+            std::chrono::nanoseconds duration);
+
+    /**
+     * @brief Gets the recorded steps, in the order they finished.
+     *
+     * @returns A copy of the records.
+     */
+    std::vector<Record> records() const;
+
+    /**
+     * @brief Formats the recorded steps as a human readable breakdown, grouped by
+     *        category and sorted from the slowest to the fastest step in each one.
+     *
+     * @returns The formatted report.
+     */
+    std::string report() const;
+
+    /**
+     * @brief Writes the recorded steps to a CSV file, with the `category`, `name`
+     *        and `seconds` columns.
+     *
+     * @param[in] path The path of the file. It is overwritten if it exists.
+     *
+     * @returns `true` if the file was written, `false` otherwise.
+     */
+    bool export_csv(
+            const std::string& path) const;
+
+private:
+
+    std::atomic<bool> _enabled{false};
+
+    mutable std::mutex _mutex;
+
+    std::vector<Record> _records;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_STARTUPPROFILE_HPP_
@@ -58,6 +58,23 @@ public:
             const std::string& template_string,
             const std::string& usage_details);
 
+    /**
+     * @brief Constructor that also binds the template to the type of the messages
+     *        it will be computed for. See `bind()`.
+     *
+     * @param[in] template_string A string that describes the desired template.
+     *
+     * @param[in] usage_details A string that describes how this StringTemplate is being used.
+     *
+     * @param[in] type The type of the messages that will be passed to `compute_string()`.
+     *
+     * @throws UnavailableMessageField if any field of the template is not a member of `type`.
+     */
+    StringTemplate(
+            const std::string& template_string,
+            const std::string& usage_details,
+            const eprosima::xtypes::DynamicType& type);
+
     /**
      * @brief Copy constructor.
      *
@@ -79,6 +96,24 @@ public:
      */
     ~StringTemplate();
 
+    /**
+     * @brief Binds the template to a type, resolving once the members accessed by each
+     *        `{message.<field>}` variable, so that computing the string for messages of
+     *        that type only takes indexed reads.
+     *        Nested fields can be requested with dotted paths, such as `{message.header.frame_id}`.
+     *
+     *        Messages of any other type are still accepted by `compute_string()`,
+     *        which resolves their members on the first message of each type.
+     *        This method must not be called concurrently with `compute_string()`.
+     *
+     * @param[in] type The type of the messages that will be passed to `compute_string()`.
+     *            It must outlive this StringTemplate.
+     *
+     * @throws UnavailableMessageField if any field of the template is not a member of `type`.
+     */
+    void bind(
+            const eprosima::xtypes::DynamicType& type);
+
     /**
      * @brief Computes the desired output string, given the input message.
      *
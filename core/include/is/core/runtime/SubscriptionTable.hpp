@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_SUBSCRIPTIONTABLE_HPP_
+#define _IS_CORE_RUNTIME_SUBSCRIPTIONTABLE_HPP_
+
+#include <is/core/export.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+
+class SystemHandle;
+
+namespace core {
+
+/**
+ * @class SubscriptionTable
+ *        Keeps track of the routes holding a subscription to each topic of each SystemHandle.
+ *
+ *        `TopicSubscriberSystem::unsubscribe()` only takes the topic name, so it cancels
+ *        the subscriptions of every route subscribed to that topic in that SystemHandle.
+ *        Routes release their subscriptions through this table instead, which only
+ *        unsubscribes the topic once no other route holds it. Meanwhile, the callback of
+ *        the released route stays registered, and the route must discard its messages.
+ *        If that route subscribes again, its callback is not registered a second time.
+ *
+ *        Routes are identified by the callback they gave to the SystemHandle.
+ *        SystemHandles are only referenced weakly, and the topics of the destroyed
+ *        ones are forgotten.
+ *
+ *        The subscribe and unsubscribe functions are called while the table is locked,
+ *        so they must not use the table themselves.
+ */
+class IS_CORE_API SubscriptionTable
+{
+public:
+
+    /**
+     * @brief Signature of the functions that subscribe and unsubscribe the topic.
+     *        They return `true` on success.
+     */
+    using Action = std::function<bool ()>;
+
+    /**
+     * @brief Makes a route hold the subscription to a topic of a SystemHandle.
+     *
+     * @param[in] system The SystemHandle.
+     *
+     * @param[in] topic The name of the topic in the SystemHandle.
+     *
+     * @param[in] callback The callback given by the route to the SystemHandle.
+     *
+     * @param[in] subscribe Function that subscribes the callback to the topic. It is not
+     *            called if the callback is still registered in the SystemHandle.
+     *
+     * @returns `true` if the route holds the subscription, `false` if it failed.
+     */
+    static bool subscribe(
+            const std::weak_ptr<SystemHandle>& system,
+            const std::string& topic,
+            const void* callback,
+            const Action& subscribe);
+
+    /**
+     * @brief Makes a route release the subscription to a topic of a SystemHandle.
+     *
+     * @param[in] system The SystemHandle.
+     *
+     * @param[in] topic The name of the topic in the SystemHandle.
+     *
+     * @param[in] callback The callback given by the route to the SystemHandle.
+     *
+     * @param[in] unsubscribe Function that unsubscribes the topic. It is only called
+     *            when no other route holds the subscription. It may return `false`
+     *            if the SystemHandle does not support it.
+     *
+     * @returns `true` if the route released the subscription, or `false` if the topic had
+     *          to be unsubscribed and that failed, in which case the route still holds it.
+     */
+    static bool unsubscribe(
+            const std::weak_ptr<SystemHandle>& system,
+            const std::string& topic,
+            const void* callback,
+            const Action& unsubscribe);
+
+    /**
+     * @brief Gets the number of routes holding the subscription to a topic of a SystemHandle.
+     */
+    static std::size_t holders(
+            const std::weak_ptr<SystemHandle>& system,
+            const std::string& topic);
+
+    /**
+     * @brief Tells whether a callback is still registered in a SystemHandle, for any of its topics,
+     *        either because its route holds the subscription or because other routes do.
+     */
+    static bool registered(
+            const std::weak_ptr<SystemHandle>& system,
+            const void* callback);
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_SUBSCRIPTIONTABLE_HPP_
@@ -0,0 +1,182 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef _IS_CORE_RUNTIME_SYSTEMHANDLEREGISTRY_HPP_
+#define _IS_CORE_RUNTIME_SYSTEMHANDLEREGISTRY_HPP_
+
+#include <is/systemhandle/RegisterSystem.hpp>
+#include <is/core/export.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class SystemHandleRegistry
+ *        Process-wide registry of the SystemHandles shared by several *Integration Service*
+ *        instances, so that instances embedded in the same process that configure the same
+ *        middleware in the same way create a single node or participant for it.
+ *
+ *        Shared SystemHandles are identified by a key made of their middleware type and
+ *        their configuration. Each instance gets a SystemHandleInfo whose handle keeps the
+ *        shared SystemHandle alive; it is destroyed once the last instance using it releases it.
+ *
+ *        Shared SystemHandles are spun by a thread of the registry, instead of by the
+ *        instances using them.
+ */
+class IS_CORE_API SystemHandleRegistry
+{
+public:
+
+    /**
+     * @brief Function that loads and configures a new SystemHandle.
+     */
+    using Loader = std::function<is::internal::SystemHandleInfo()>;
+
+    /**
+     * @brief Gets the registry shared by the whole process.
+     *
+     * @returns A reference to the global registry.
+     */
+    static SystemHandleRegistry& global();
+
+    /**
+     * @brief Constructor.
+     */
+    SystemHandleRegistry();
+
+    /**
+     * @brief Destructor.
+     */
+    ~SystemHandleRegistry();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    SystemHandleRegistry(
+            const SystemHandleRegistry& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    SystemHandleRegistry& operator = (
+            const SystemHandleRegistry& other) = delete;
+
+    /**
+     * @brief Gets a shared SystemHandle, loading it if there is none suitable yet.
+     *
+     * @details A SystemHandle shared under the same key is only reused if it was
+     *          configured with all the required types. Otherwise, a new one is loaded,
+     *          and shared under the same key as well.
+     *
+     *          `load` is called without holding the registry lock, so SystemHandles of different
+     *          keys are loaded in parallel. Concurrent callers for a key that is being loaded
+     *          wait for that load to finish, and reuse its SystemHandle if it is suitable.
+     *
+     * @param[in] key The key identifying the SystemHandle, as given by `key()`.
+     *
+     * @param[in] required_types The names of the types the SystemHandle must have been configured with.
+     *
+     * @param[in] load The function that loads and configures a new SystemHandle.
+     *
+     * @returns The information of the shared SystemHandle, which evaluates
+     *          to `false` if it could not be loaded.
+     */
+    is::internal::SystemHandleInfo acquire(
+            const std::string& key,
+            const std::set<std::string>& required_types,
+            const Loader& load);
+
+    /**
+     * @brief Detaches an instance from the shared SystemHandles it uses, before it is destroyed.
+     *
+     * @details `detach` is called while none of the shared SystemHandles of `info_map` is being spun,
+     *          so that it can safely unsubscribe and disable the callbacks given to them by the instance.
+     *          If `in_use` tells that the SystemHandles may still call some of those callbacks, they are
+     *          kept alive, by means of `callbacks`, until it no longer does or the SystemHandles are
+     *          destroyed. It is checked again whenever another instance is released.
+     *
+     * @param[in] info_map The SystemHandles used by the instance.
+     *
+     * @param[in] detach The function unsubscribing and disabling the callbacks of the instance.
+     *
+     * @param[in] callbacks The object owning the callbacks of the instance.
+     *
+     * @param[in] in_use The function telling whether the SystemHandles may still call the callbacks.
+     */
+    void release(
+            const is::internal::SystemHandleInfoMap& info_map,
+            const std::function<void()>& detach,
+            const std::shared_ptr<void>& callbacks,
+            const std::function<bool()>& in_use);
+
+    /**
+     * @brief Gets the number of shared SystemHandles that are alive.
+     *
+     * @returns The number of shared SystemHandles.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Computes the key that identifies a shared SystemHandle.
+     *
+     * @param[in] type The middleware type.
+     *
+     * @param[in] config The configuration of the middleware.
+     *
+     * @returns The key of the SystemHandle.
+     */
+    static std::string key(
+            const std::string& type,
+            const YAML::Node& config);
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the SystemHandleRegistry class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of SystemHandleRegistry.
+     *
+     *        Methods named equal to some SystemHandleRegistry method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_SYSTEMHANDLEREGISTRY_HPP_
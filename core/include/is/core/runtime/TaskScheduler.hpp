@@ -0,0 +1,43 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_TASKSCHEDULER_HPP_
+#define _IS_CORE_RUNTIME_TASKSCHEDULER_HPP_
+
+#include <chrono>
+#include <functional>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @brief Signature of the functions that run the tasks of the routes, such as subscribing
+ *        the sources of a lazy topic or releasing a message held by a rate limiter, on
+ *        the threads of the *Integration Service* instead of on the threads that trigger them.
+ *
+ *        The task must be run once `delay` has elapsed. It may be run later, but never before.
+ */
+using TaskScheduler = std::function<void (
+                    std::function<void ()> task,
+                    std::chrono::steady_clock::duration delay)>;
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_TASKSCHEDULER_HPP_
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_TRACER_HPP_
+#define _IS_CORE_RUNTIME_TRACER_HPP_
+
+#include <is/core/export.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class Tracer
+ *        Samples one out of every `N` messages received by the topic routes and records
+ *        how long each stage of their routing took: the conversion into each published
+ *        type and the publication, or queueing, for each destination.
+ *
+ *        Deciding whether a message is sampled only takes an atomic increment, so that
+ *        unsampled messages pay almost nothing. The traces of the sampled messages are
+ *        written by a pluggable Tracer::Sink once their routing is done.
+ */
+class IS_CORE_API Tracer
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief A stage of the routing of a message.
+     */
+    struct Span
+    {
+        std::string name;
+        Clock::time_point start;
+        Clock::time_point end;
+        bool success;
+    };
+
+    /**
+     * @brief The stages of the routing of a sampled message, since it was received
+     *        by the subscription callback of a route.
+     */
+    struct Trace
+    {
+        std::string topic;
+        std::string source;
+        Clock::time_point received;
+        Clock::time_point finished;
+        std::vector<Span> spans;
+
+        /**
+         * @brief Adds a stage that started at `start` and ends now.
+         */
+        void add(
+                std::string name,
+                Clock::time_point start,
+                bool success = true)
+        {
+            spans.push_back(Span{std::move(name), start, Clock::now(), success});
+        }
+
+    };
+
+    /**
+     * @class Sink
+     *        Destination of the traces of the sampled messages. Implementations
+     *        may be called from several threads at once.
+     */
+    class Sink
+    {
+    public:
+
+        virtual ~Sink() = default;
+
+        /**
+         * @brief Writes a finished trace.
+         */
+        virtual void write(
+                const Trace& trace) = 0;
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] sample_every One out of every `sample_every` messages is traced.
+     *            It must be greater than zero.
+     *
+     * @param[in] sink The sink where the traces are written.
+     */
+    Tracer(
+            std::size_t sample_every,
+            std::shared_ptr<Sink> sink);
+
+    /**
+     * @brief Starts the trace of a message received by a route, if it is sampled.
+     *
+     * @param[in] topic The name of the topic.
+     *
+     * @param[in] source The system the message comes from.
+     *
+     * @returns The trace of the message, or `nullptr` if it is not sampled.
+     */
+    std::unique_ptr<Trace> start(
+            const std::string& topic,
+            const std::string& source)
+    {
+        if (_received.fetch_add(1, std::memory_order_relaxed) % _sample_every != 0)
+        {
+            return nullptr;
+        }
+
+        return begin(topic, source);
+    }
+
+    /**
+     * @brief Finishes a trace, and writes it into the sink.
+     *
+     * @param[in] trace The trace given by `start()`.
+     */
+    void finish(
+            std::unique_ptr<Trace> trace);
+
+    /**
+     * @brief Gets the total number of traces written.
+     */
+    uint64_t traced() const;
+
+    /**
+     * @brief Creates a sink that appends the traces to a file, one per line.
+     *
+     * @param[in] format Either `text`, for human readable lines, or `otlp`, for the
+     *            *OpenTelemetry* protocol JSON encoding of an `ExportTraceServiceRequest`,
+     *            as read by the `otlpjsonfile` receiver of the *OpenTelemetry Collector*.
+     *            In the latter, each trace has a root span covering the whole routing
+     *            of the message, and a child span for each stage.
+     *
+     * @param[in] path The file where the traces are written.
+     *
+     * @returns The sink, or `nullptr` if the format is unknown or the file cannot be opened.
+     */
+    static std::shared_ptr<Sink> file_sink(
+            const std::string& format,
+            const std::string& path);
+
+private:
+
+    std::unique_ptr<Trace> begin(
+            const std::string& topic,
+            const std::string& source) const;
+
+    /**
+     * Class members.
+     */
+
+    const uint64_t _sample_every;
+    const std::shared_ptr<Sink> _sink;
+    std::atomic<uint64_t> _received;
+    std::atomic<uint64_t> _traced;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_TRACER_HPP_
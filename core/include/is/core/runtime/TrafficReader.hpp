@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef _IS_CORE_RUNTIME_TRAFFICREADER_HPP_
+#define _IS_CORE_RUNTIME_TRAFFICREADER_HPP_
+
+#include <is/core/runtime/TrafficRecorder.hpp>
+
+#include <chrono>
+#include <string_view>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class TrafficReader
+ *        Reads back, in order, the samples of a capture file written by a TrafficRecorder.
+ *        The file is memory mapped, so the samples point straight into it.
+ */
+class IS_CORE_API TrafficReader
+{
+public:
+
+    /**
+     * @brief A recorded sample, valid as long as the reader is.
+     */
+    struct Sample
+    {
+        TrafficRecorder::Kind kind;
+        std::chrono::nanoseconds timestamp;
+        std::string_view name;
+        std::string_view type;
+        const uint8_t* payload;
+        std::size_t size;
+    };
+
+    /**
+     * @brief Opens a capture file.
+     *
+     * @param[in] path The path of the capture file.
+     *
+     * @returns The reader, or `nullptr` if the file cannot be mapped or is not a capture file.
+     */
+    static std::unique_ptr<TrafficReader> open(
+            const std::string& path);
+
+    /**
+     * @brief Destructor.
+     */
+    ~TrafficReader();
+
+    TrafficReader(
+            const TrafficReader&) = delete;
+
+    TrafficReader& operator =(
+            const TrafficReader&) = delete;
+
+    /**
+     * @brief Reads the next sample.
+     *
+     * @param[out] sample The sample.
+     *
+     * @returns `false` once every sample has been read, or if the rest of the file is corrupt.
+     */
+    bool next(
+            Sample& sample);
+
+    /**
+     * @brief Goes back to the first sample.
+     */
+    void rewind();
+
+private:
+
+    TrafficReader(
+            const uint8_t* map,
+            std::size_t mapped,
+            std::size_t end);
+
+    const uint8_t* const _map;
+    const std::size_t _mapped;
+    const std::size_t _end;
+    std::size_t _offset;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_TRAFFICREADER_HPP_
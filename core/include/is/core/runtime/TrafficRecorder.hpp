@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#ifndef _IS_CORE_RUNTIME_TRAFFICRECORDER_HPP_
+#define _IS_CORE_RUNTIME_TRAFFICRECORDER_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class TrafficRecorder
+ *        Appends the messages and requests routed by *Integration Service* into
+ *        a capture file, so that the same traffic can be replayed later on.
+ *
+ *        The capture file is memory mapped, and grown by whole segments whenever
+ *        the samples do not fit anymore, so that appending a sample is just a copy.
+ *        It starts with a header, made of the `magic` tag and the offset where
+ *        the samples end, followed by the samples, each of them being:
+ *
+ *        - A 32 bits size of the rest of the sample.
+ *        - An 8 bits `Kind`.
+ *        - A 64 bits timestamp, in nanoseconds since the epoch.
+ *        - The topic or service name, and the name of the type, each one preceded by its 16 bits size.
+ *        - The message, as given by `encode()`.
+ *
+ *        Integers are stored with the byte order of the host.
+ *        Messages whose type cannot be encoded are not recorded.
+ */
+class IS_CORE_API TrafficRecorder
+{
+public:
+
+    /**
+     * @brief The tag found at the beginning of every capture file.
+     */
+    static constexpr char magic[8] = {'I', 'S', 'C', 'A', 'P', '0', '0', '1'};
+
+    /**
+     * @brief Size of the header of a capture file.
+     */
+    static constexpr std::size_t header_size = sizeof(magic) + sizeof(uint64_t);
+
+    /**
+     * @brief What a sample was routed as.
+     */
+    enum class Kind : uint8_t
+    {
+        MESSAGE = 0,
+        REQUEST = 1
+    };
+
+    /**
+     * @brief Creates a new capture file, replacing any previous file with the same path.
+     *
+     * @param[in] path The path of the capture file.
+     *
+     * @param[in] segment_size The number of bytes the file grows by, each time it is full.
+     *
+     * @returns The recorder, or `nullptr` if the file cannot be created or mapped.
+     */
+    static std::shared_ptr<TrafficRecorder> create(
+            const std::string& path,
+            std::size_t segment_size);
+
+    /**
+     * @brief Destructor. Truncates the capture file to the recorded samples.
+     */
+    ~TrafficRecorder();
+
+    TrafficRecorder(
+            const TrafficRecorder&) = delete;
+
+    TrafficRecorder& operator =(
+            const TrafficRecorder&) = delete;
+
+    /**
+     * @brief Appends a sample to the capture file. It may be called from several threads at once.
+     *
+     * @param[in] kind Whether the sample is a message or a service request.
+     *
+     * @param[in] name The name of the topic or service.
+     *
+     * @param[in] data The routed message or request.
+     */
+    void record(
+            Kind kind,
+            const std::string& name,
+            const xtypes::ReadableDynamicDataRef& data);
+
+    /**
+     * @brief Gets the total number of recorded samples.
+     */
+    uint64_t recorded() const;
+
+    /**
+     * @brief Encodes a message in the compact binary form of the capture files.
+     *
+     *        Structures, sequences, arrays, strings, wide strings and primitive types
+     *        are supported, as well as aliases of them.
+     *
+     * @param[in] data The message.
+     *
+     * @param[out] output The string where the encoded message is appended.
+     *
+     * @returns `true` if the type of the message is supported, `false` otherwise.
+     */
+    static bool encode(
+            const xtypes::ReadableDynamicDataRef& data,
+            std::string& output);
+
+    /**
+     * @brief Decodes a message encoded by `encode()`.
+     *
+     * @param[in] input The beginning of the encoded message.
+     *
+     * @param[in] size The size of the encoded message.
+     *
+     * @param[out] data The message, of the same type as the encoded one.
+     *
+     * @returns `true` if the whole input was a valid message of that type, `false` otherwise.
+     */
+    static bool decode(
+            const uint8_t* input,
+            std::size_t size,
+            xtypes::WritableDynamicDataRef data);
+
+private:
+
+    TrafficRecorder(
+            int fd,
+            uint8_t* map,
+            std::size_t segment_size);
+
+    bool reserve(
+            std::size_t size);
+
+    const int _fd;
+    uint8_t* _map;
+    std::size_t _mapped;
+    const std::size_t _segment_size;
+    std::size_t _end;
+    uint64_t _recorded;
+    std::set<std::string> _unsupported;
+    mutable std::mutex _mutex;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_TRAFFICRECORDER_HPP_
@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_TYPETABLE_HPP_
+#define _IS_CORE_RUNTIME_TYPETABLE_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+#include <is/systemhandle/SystemHandle.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class TypeTable
+ *        Process-wide table of interned types. Every distinct type is stored once and
+ *        given an identifier, so that the type registries of all the *Integration Service*
+ *        instances and SystemHandles share the same type objects and can compare types by
+ *        identifier instead of structurally.
+ *
+ *        Two types are considered the same one if they have the same name and are equal,
+ *        as given by `xtypes::DynamicType::is_compatible()`.
+ *
+ *        Interning a type gives a lease on it, and the type stays interned while some copy
+ *        of any of its leases is alive. This way, the types of the configurations replaced
+ *        by a reload are removed from the table once no configuration uses them, and the
+ *        table does not grow with every reload. The type objects themselves live as long as
+ *        any registry refers to them.
+ */
+class IS_CORE_API TypeTable
+{
+public:
+
+    /**
+     * @brief Identifier of an interned type. It does not change while the type is interned,
+     *        but it may be given to another type once it is removed from the table.
+     */
+    using TypeId = std::size_t;
+
+    /**
+     * @brief Keeps an interned type in the table while it, or some copy of it, is alive.
+     */
+    using Lease = std::shared_ptr<const void>;
+
+    /**
+     * @brief Identifier returned for types that are not interned.
+     */
+    static constexpr TypeId INVALID_ID = std::numeric_limits<TypeId>::max();
+
+    /**
+     * @brief Gets the table shared by the whole process.
+     *
+     * @returns A reference to the global table.
+     */
+    static TypeTable& global();
+
+    /**
+     * @brief Interns a type, if an equal one is not interned yet.
+     *
+     * @param[in] type The type to be interned.
+     *
+     * @param[out] lease The lease that keeps the type interned.
+     *
+     * @returns The interned type, which is the given one if no equal type was interned.
+     */
+    xtypes::DynamicType::Ptr intern(
+            const xtypes::DynamicType::Ptr& type,
+            Lease& lease);
+
+    /**
+     * @brief Gets the identifier of an interned type.
+     *
+     * @param[in] type The type, as returned by `intern()`.
+     *
+     * @returns The identifier of the type, or `INVALID_ID` if that type object is not interned.
+     */
+    TypeId id(
+            const xtypes::DynamicType& type) const;
+
+    /**
+     * @brief Gets an interned type from its identifier.
+     *
+     * @param[in] id The identifier of the type.
+     *
+     * @returns The type, or `nullptr` if there is no type with such identifier.
+     *          It is only valid while some lease on the type is alive.
+     */
+    const xtypes::DynamicType* type(
+            TypeId id) const;
+
+    /**
+     * @brief Gets the number of distinct types currently interned.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the name under which a type is stored in the registries of the
+     *        *Integration Service*, that is, without its leading `::`, if any.
+     *
+     * @param[in] name The name of the type.
+     *
+     * @returns The name without its leading `::`.
+     */
+    static std::string unscoped(
+            const std::string& name);
+
+    /**
+     * @brief Finds a type in a registry, accepting its name with or without the leading `::`.
+     *
+     * @param[in] types The registry, whose types are stored by their `unscoped()` name.
+     *
+     * @param[in] name The name of the type.
+     *
+     * @returns An iterator to the type, or `types.end()` if it is not found.
+     */
+    static TypeRegistry::const_iterator find_type(
+            const TypeRegistry& types,
+            const std::string& name);
+
+    /**
+     * @brief Gets a type from a registry, accepting its name with or without the leading `::`.
+     *
+     * @param[in] types The registry, whose types are stored by their `unscoped()` name.
+     *
+     * @param[in] name The name of the type.
+     *
+     * @returns The type.
+     *
+     * @throws std::out_of_range If the type is not found.
+     */
+    static const xtypes::DynamicType::Ptr& type_at(
+            const TypeRegistry& types,
+            const std::string& name);
+
+private:
+
+    /**
+     * @brief Removes a type from the table, once its last lease is released.
+     */
+    void release(
+            TypeId id);
+
+    struct Slot
+    {
+        xtypes::DynamicType::Ptr type;
+        std::size_t leases = 0;
+    };
+
+    mutable std::mutex _mutex;
+
+    /**
+     * Interned types, indexed by their identifier, and the identifiers of the empty slots.
+     */
+    std::vector<Slot> _slots;
+    std::vector<TypeId> _free_ids;
+
+    std::unordered_map<std::string, std::vector<TypeId> > _ids_by_name;
+
+    std::unordered_map<const xtypes::DynamicType*, TypeId> _ids_by_address;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_TYPETABLE_HPP_
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_RUNTIME_TYPESCACHE_HPP_
+#define _IS_CORE_RUNTIME_TYPESCACHE_HPP_
+
+#include <is/core/Message.hpp>
+#include <is/core/export.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+/**
+ * @class TypesCache
+ *        On-disk cache of the types resulting from parsing an IDL specification,
+ *        so that they can be restored in later runs without parsing the IDL again.
+ *
+ *        Each IDL is stored in its own file, named after a hash of the IDL text and
+ *        of the include paths used to parse it. The contents of the included files
+ *        are not part of the hash, so the cache directory must be cleared if they change.
+ *
+ *        Types are stored in a compact binary form. Structures, enumerations, aliases,
+ *        strings, sequences, arrays, maps and primitive types are supported; IDLs using
+ *        unions, bitsets, structure inheritance or optional members are not cached.
+ */
+class IS_CORE_API TypesCache
+{
+public:
+
+    /**
+     * @brief Scoped name to type map, as given by `xtypes::idl::Context::get_all_scoped_types()`.
+     */
+    using Types = std::map<std::string, xtypes::DynamicType::Ptr>;
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] directory The directory where the cache files are kept.
+     *            It is created when the first IDL is stored.
+     */
+    TypesCache(
+            const std::string& directory);
+
+    /**
+     * @brief Restores the types of an IDL, if they were stored before.
+     *
+     * @param[in] idl The IDL text.
+     *
+     * @param[in] include_paths The include paths used to parse the IDL.
+     *
+     * @param[out] types The restored types.
+     *
+     * @returns `true` if the types were found and restored, `false` otherwise.
+     */
+    bool load(
+            const std::string& idl,
+            const std::vector<std::string>& include_paths,
+            Types& types) const;
+
+    /**
+     * @brief Stores the types of a parsed IDL.
+     *
+     * @param[in] idl The IDL text.
+     *
+     * @param[in] include_paths The include paths used to parse the IDL.
+     *
+     * @param[in] types The types resulting from parsing the IDL.
+     *
+     * @returns `true` if the types were stored, `false` if they are not supported
+     *          or the cache file could not be written.
+     */
+    bool store(
+            const std::string& idl,
+            const std::vector<std::string>& include_paths,
+            const Types& types) const;
+
+    /**
+     * @brief Serializes a set of types.
+     *
+     * @param[in] types The types to be serialized.
+     *
+     * @param[out] output The serialized types.
+     *
+     * @returns `true` if all the types could be serialized, `false` otherwise.
+     */
+    static bool serialize(
+            const Types& types,
+            std::string& output);
+
+    /**
+     * @brief Restores a set of types serialized by `serialize()`.
+     *
+     * @param[in] input The serialized types.
+     *
+     * @param[out] types The restored types.
+     *
+     * @returns `true` if the input was valid, `false` otherwise.
+     */
+    static bool deserialize(
+            const std::string& input,
+            Types& types);
+
+private:
+
+    std::string file_path(
+            const std::string& idl,
+            const std::vector<std::string>& include_paths) const;
+
+    const std::string _directory;
+};
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_RUNTIME_TYPESCACHE_HPP_
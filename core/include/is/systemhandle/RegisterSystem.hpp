@@ -55,7 +55,7 @@ public:
      * @param[in] input The SystemHandle instance which we want to obtain information from.
      */
     SystemHandleInfo(
-            std::unique_ptr<SystemHandle> input);
+            std::shared_ptr<SystemHandle> input);
 
     /**
      * @brief SystemHandleInfo shall not be copy constructible.
@@ -86,7 +86,7 @@ public:
      * Class members.
      */
 
-    std::unique_ptr<SystemHandle> handle;
+    std::shared_ptr<SystemHandle> handle;
 
     TopicPublisherSystem* topic_publisher;
 
@@ -97,6 +97,18 @@ public:
     ServiceProviderSystem* service_provider;
 
     TypeRegistry types;
+
+    /**
+     * Whether the handle is shared with other instances through the SystemHandleRegistry,
+     * in which case it is spun by the registry instead of by the instance.
+     */
+    bool shared = false;
+
+    /**
+     * The origin tag accepted by the handle, or zero if it does not tag the origin of its messages,
+     * in which case its internal messages are recognized through `is_internal_message()`.
+     */
+    uint64_t origin_tag = 0;
 };
 
 //==============================================================================
@@ -142,17 +154,31 @@ public:
     static SystemHandleInfo get(
             const std::string& middleware);
 
+    /**
+     * @brief Tells whether the SystemHandle of a given middleware is already registered,
+     *        either because it is linked into the executable or because its library
+     *        was loaded before.
+     *
+     * @param[in] middleware The middleware's name.
+     *
+     * @returns `true` if the middleware is registered, `false` otherwise.
+     */
+    static bool contains(
+            const std::string& middleware);
+
 private:
 
     using FactoryMap = std::map<std::string, detail::SystemHandleFactoryBuilder>;
 
     /**
-     * Class members.
+     * @brief Gets the factory map, along with the mutex guarding it.
+     *
+     *        Both are constructed on first use, since SystemHandles linked statically
+     *        into the executable register themselves during static initialization,
+     *        possibly before the static members of this translation unit are constructed.
      */
-
-    static FactoryMap _info_map;
-
-    static std::mutex _mutex;
+    static FactoryMap& info_map(
+            std::mutex*& mutex);
 };
 
 } //  namespace internal
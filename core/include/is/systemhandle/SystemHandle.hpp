@@ -24,10 +24,13 @@
 
 #include <yaml-cpp/yaml.h>
 
+#include <cstdint>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
 #include <functional>
+#include <memory>
 
 namespace eprosima {
 namespace is {
@@ -56,9 +59,41 @@ struct RequiredTypes
 
 /**
  * @brief Map used to store the DynamicType name mapped to its representation.
+ *        The types given by the *Integration Service* are interned in the
+ *        core::TypeTable, so the registries of all the SystemHandles share them.
  */
 using TypeRegistry = std::map<std::string, xtypes::DynamicType::Ptr>;
 
+/**
+ * @struct MessageOrigin
+ * @brief Filter handle given to the subscription callbacks by the SystemHandles that accept
+ *        an origin tag through `OriginTaggingSystem::accept_origin_tag()`.
+ *
+ * @var MessageOrigin::tag
+ *      @brief The origin tag found in the received message, or zero if it has none.
+ */
+struct MessageOrigin
+{
+    uint64_t tag = 0;
+
+    /**
+     * @brief Checks whether a message was published by the SystemHandle instance owning a tag.
+     *
+     * @param[in] filter_handle The filter handle given to the subscription callback,
+     *            which points to a MessageOrigin, or is `nullptr` if the origin is unknown.
+     *
+     * @param[in] tag The origin tag accepted by the SystemHandle instance.
+     *
+     * @returns `true` if the message carries the given tag, `false` otherwise.
+     */
+    static bool matches(
+            const void* filter_handle,
+            uint64_t tag)
+    {
+        return filter_handle != nullptr && static_cast<const MessageOrigin*>(filter_handle)->tag == tag;
+    }
+};
+
 /**
  * @brief Call this macro in a .cpp file of your middleware's plugin library,
  *        so that the *Integration Service* can find your eprosima::is::SystemHandle implementation
@@ -178,6 +213,35 @@ public:
      * @returns `true` if the SystemHandle is still working; `false` otherwise.
      */
     virtual bool spin_once() = 0;
+
+    /**
+     * @brief Signature of the callback that a SystemHandle invokes to notify
+     *        that it has pending work, which will be processed by calling `spin_once()`.
+     */
+    using WakeUpCallback = std::function<void ()>;
+
+    /**
+     * @brief Opts this SystemHandle into event-driven scheduling.
+     *
+     *        By default, the *Integration Service* dedicates one thread to each SystemHandle,
+     *        which calls `spin_once()` continuously. A SystemHandle that accepts the wake-up
+     *        callback is instead served by a shared executor, that only calls `spin_once()`
+     *        after the callback has been invoked. Such SystemHandles must invoke the callback,
+     *        from any thread, every time new work becomes available, and should return
+     *        from `spin_once()` without blocking once that work has been processed.
+     *
+     * @param[in] callback The callback to be invoked when there is pending work.
+     *
+     * @returns `true` if the SystemHandle will notify its pending work through `callback`,
+     *          `false` if it must keep being spun continuously. Default implementation
+     *          returns `false`.
+     */
+    virtual bool set_wake_up_callback(
+            WakeUpCallback callback)
+    {
+        (void)callback;
+        return false;
+    }
 };
 
 /**
@@ -193,6 +257,15 @@ public:
      */
     using SubscriptionCallback = std::function<void (const xtypes::DynamicData& message, void* filter_handle)>;
 
+    /**
+     * @brief Signature of the callback that gets triggered when a raw subscriber receives some data,
+     *        still serialized in the wire format given by `raw_encoding()`.
+     */
+    using RawSubscriptionCallback = std::function<void (
+                        const uint8_t* payload,
+                        std::size_t size,
+                        void* filter_handle)>;
+
     /**
      * @brief Constructor.
      */
@@ -231,6 +304,8 @@ public:
      *        and protocol intricacies and particularities. Some protocols might not need this at all.
      *        This method is called, during the SubscriptionCallback function, to avoid sending
      *        messages indefinitely, thus creating an infinite loop.
+     *        It is not called for the SystemHandles that accept an origin tag,
+     *        as given by `OriginTaggingSystem::accept_origin_tag()`.
      *
      * @param[in] filter_handle Opaque pointer to entity containing the information used to perform
      *        the filtering; this is usually meta-information regarding the just received message
@@ -238,6 +313,105 @@ public:
      */
     virtual bool is_internal_message(
             void* filter_handle) = 0;
+
+    /**
+     * @brief Gives the name of the wire format of the payloads provided by `subscribe_raw()`,
+     *        for example, `"cdr"`.
+     *
+     *        Topics whose destinations all publish raw payloads of this same encoding, with
+     *        a type equal to the subscribed one, are forwarded as byte buffers, without
+     *        deserializing each sample into `xtypes::DynamicData`.
+     *        This is only queried when the route is configured.
+     *
+     * @returns The encoding name, or an empty string if raw subscriptions are not supported.
+     *          Default implementation returns an empty string.
+     */
+    virtual std::string raw_encoding() const
+    {
+        return std::string();
+    }
+
+    /**
+     * @brief Has this SystemHandle instance subscribed to a topic, receiving
+     *        its messages still serialized.
+     *
+     * @param[in] topic_name Name of the topic to get subscribed to.
+     *
+     * @param[in] message_type Message type that this topic should expect to receive.
+     *
+     * @param[in] callback The callback which should be triggered when a message comes in.
+     *
+     * @param[in] configuration A *YAML* node containing any middleware-specific
+     *            configuration information for this subscription. This may be an empty node.
+     *
+     * @returns `true` if subscription was successfully established, `false` otherwise,
+     *          in which case *Integration Service* falls back to `subscribe()`.
+     *          Default implementation returns `false`.
+     */
+    virtual bool subscribe_raw(
+            const std::string& /*topic_name*/,
+            const xtypes::DynamicType& /*message_type*/,
+            RawSubscriptionCallback* /*callback*/,
+            const YAML::Node& /*configuration*/)
+    {
+        return false;
+    }
+
+    /**
+     * @brief Cancels the subscription of this SystemHandle instance to a topic,
+     *        so that its callback is no longer triggered.
+     *
+     *        This is used by topics configured as `lazy`, which are subscribed again
+     *        through `subscribe()`, with the same callback, once some remote endpoint
+     *        listens to any of their destinations.
+     *
+     * @param[in] topic_name Name of the topic to get unsubscribed from.
+     *
+     * @returns `true` if the subscription was cancelled, `false` otherwise.
+     *          Default implementation returns `false`.
+     */
+    virtual bool unsubscribe(
+            const std::string& /*topic_name*/)
+    {
+        return false;
+    }
+
+};
+
+/**
+ * @class OriginTaggingSystem
+ *        Optional interface of the TopicSubscriberSystem implementations that tag the origin
+ *        of their messages, so that the *Integration Service* can filter their internal messages
+ *        without calling `is_internal_message()` for each one. SystemHandles opt into it by
+ *        also inheriting from this class, which leaves the other interfaces unchanged.
+ */
+class OriginTaggingSystem : public virtual SystemHandle
+{
+public:
+
+    /**
+     * @brief Offers the SystemHandle an origin tag.
+     *
+     *        A SystemHandle accepting the tag must attach it to every message published by the
+     *        publishers it gives to the *Integration Service*, in whatever way its protocol allows,
+     *        and give a pointer to a MessageOrigin, holding the tag found in each received message,
+     *        as the `filter_handle` of its subscription callbacks. Comparing both tags is then enough
+     *        to recognize the internal messages, which are discarded by the routing callbacks.
+     *
+     *        Tags are nonzero and distinct for every SystemHandle instance of a process. Those of
+     *        different processes start from a random 64-bit base, so they are only unlikely to
+     *        collide: a collision would make messages coming from another bridge be discarded.
+     *
+     *        This method is called once, right after `configure()` and before any topic is
+     *        advertised or subscribed to.
+     *
+     * @param[in] tag The origin tag of this SystemHandle instance.
+     *
+     * @returns `true` if the SystemHandle tags the origin of its messages, `false` if
+     *          `is_internal_message()` must be called instead.
+     */
+    virtual bool accept_origin_tag(
+            uint64_t tag) = 0;
 };
 
 /**
@@ -257,6 +431,12 @@ class TopicPublisher
 {
 public:
 
+    /**
+     * @brief Signature of the callback that reports the number of remote endpoints
+     *        matched with a publisher.
+     */
+    using MatchCallback = std::function<void (std::size_t matched)>;
+
     /**
      * @brief Constructor.
      */
@@ -277,6 +457,131 @@ public:
     virtual bool publish(
             const xtypes::DynamicData& message) = 0;
 
+    /**
+     * @brief Publishes to a topic a reference-counted, immutable message.
+     *
+     *        The same message instance may be handed to several publishers, so implementations
+     *        that need to keep the data beyond this call, for example, to queue it for an
+     *        asynchronous writer, should retain the shared pointer instead of deep-copying it.
+     *
+     *        Default implementation forwards to `publish(const xtypes::DynamicData&)`.
+     *
+     * @param[in] message Shared DynamicData that is being published.
+     *
+     * @returns `true` if the data was correctly published, `false` otherwise.
+     */
+    virtual bool publish_shared(
+            const std::shared_ptr<const xtypes::DynamicData>& message)
+    {
+        return publish(*message);
+    }
+
+    /**
+     * @brief Tells whether this publisher takes advantage of `publish_shared()`.
+     *
+     *        The *Integration Service* only materializes a shared message, once per sample,
+     *        when some of the publishers it is routed to return `true` here.
+     *        This is only queried when the route is configured.
+     *
+     * @returns `true` if shared messages should be provided, `false` otherwise.
+     *          Default implementation returns `false`.
+     */
+    virtual bool prefers_shared_messages() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Publishes to a topic several messages at once, in order.
+     *
+     *        When the subscription callbacks of a route are called from within the `spin_once()`
+     *        of the source SystemHandle, the messages routed to publishers that return `true`
+     *        in `prefers_batches()` are accumulated, and handed here once `spin_once()`
+     *        returns, so that implementations able to do vectored writes can take advantage of it.
+     *
+     *        Default implementation calls `publish_shared()` for each message.
+     *
+     * @param[in] messages Shared DynamicData instances being published.
+     *
+     * @returns `true` if all the messages were correctly published, `false` otherwise.
+     */
+    virtual bool publish_batch(
+            const std::vector<std::shared_ptr<const xtypes::DynamicData> >& messages)
+    {
+        bool published = true;
+        for (const std::shared_ptr<const xtypes::DynamicData>& message : messages)
+        {
+            published &= publish_shared(message);
+        }
+        return published;
+    }
+
+    /**
+     * @brief Tells whether this publisher takes advantage of `publish_batch()`.
+     *
+     *        This is only queried when the route is configured.
+     *
+     * @returns `true` if messages should be batched, `false` otherwise.
+     *          Default implementation returns `false`.
+     */
+    virtual bool prefers_batches() const
+    {
+        return false;
+    }
+
+    /**
+     * @brief Gives the name of the wire format accepted by `publish_raw()`.
+     *
+     *        This is only queried when the route is configured.
+     *
+     * @returns The encoding name, or an empty string if raw payloads are not supported.
+     *          Default implementation returns an empty string.
+     */
+    virtual std::string raw_encoding() const
+    {
+        return std::string();
+    }
+
+    /**
+     * @brief Publishes to a topic a message already serialized in the wire format
+     *        given by `raw_encoding()`.
+     *
+     * @param[in] payload The serialized message. It is only valid during this call.
+     *
+     * @param[in] size The size of the payload, in bytes.
+     *
+     * @returns `true` if the data was correctly published, `false` otherwise.
+     *          Default implementation returns `false`.
+     */
+    virtual bool publish_raw(
+            const uint8_t* /*payload*/,
+            std::size_t /*size*/)
+    {
+        return false;
+    }
+
+    /**
+     * @brief Registers the callback that must be called whenever the number of remote
+     *        endpoints matched with this publisher, that is, listening to the data it publishes,
+     *        changes. If some of them are already matched, it may be called right away.
+     *
+     *        Topics configured as `lazy` only keep their subscriptions while some of their
+     *        publishers are matched. The callback must not be called from within a
+     *        `subscribe()` or `unsubscribe()` call of any SystemHandle.
+     *        This is only called when the route is configured.
+     *
+     * @param[in] callback The callback reporting the number of matched remote endpoints.
+     *
+     * @returns `true` if the matched endpoints will be reported, `false` otherwise,
+     *          in which case the publisher is considered to be always listened to.
+     *          Default implementation returns `false`.
+     */
+    virtual bool set_match_callback(
+            MatchCallback /*callback*/)
+    {
+        return false;
+    }
+
 };
 
 /**
@@ -389,6 +694,25 @@ public:
     virtual void receive_response(
             std::shared_ptr<void> call_handle,
             const xtypes::DynamicData& response) = 0;
+
+    /**
+     * @brief Notifies that a service request will not get any response, because the
+     *        *Integration Service* abandoned it, either because it waited for the reply
+     *        longer than the `timeout` of its route, or because the route already had
+     *        `max_in_flight` calls pending.
+     *
+     *        Implementations may override this to release the resources held for the call,
+     *        or to report an error to the *user client application*. By default, it does nothing.
+     *
+     * @attention As `receive_response`, this function may be called by multiple threads at once.
+     *
+     * @param[in] call_handle The handle that was given to the call by this ServiceClient.
+     */
+    virtual void receive_cancellation(
+            std::shared_ptr<void> call_handle)
+    {
+        (void)call_handle;
+    }
 };
 
 /**
@@ -526,6 +850,9 @@ public:
      *            The ServiceProvider should not attempt to cast or modify it in any way;
      *            it should only be passed back to the ServiceClient later on,
      *            when `receive_response()` is called.
+     *            Alternatively, since the handles given by *Integration Service* are
+     *            `is::core::ServiceCall` objects, it can be kept as one, by means of
+     *            `ServiceCall::from()`, to complete the call later on from any thread.
      *
      */
     virtual void call_service(
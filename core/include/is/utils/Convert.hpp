@@ -22,6 +22,7 @@
 #include <is/core/Message.hpp>
 
 #include <algorithm>
+#include <cstring>
 #include <mutex>
 #include <type_traits>
 #include <vector>
@@ -208,6 +209,84 @@ struct MessageConvert
 
 };
 
+//==============================================================================
+/**
+ * @brief A helper for the container Convert<> specializations, which moves
+ *        whole blocks of primitive elements at once between a native container
+ *        and a DynamicData sequence or array.
+ *
+ * @details xTypes stores the elements of primitive sequences and arrays
+ *          contiguously, with the same layout as a native array, so arithmetic
+ *          element types can be copied with a single `memcpy` instead of one
+ *          Convert<>::from_xtype_field() or Convert<>::to_xtype_field() call
+ *          per element. `bool` and `char` are excluded: the former because of
+ *          `std::vector<bool>`, the latter because of CharConvert.
+ *          If the element type of the DynamicData does not match the native one, or its
+ *          elements are not laid out contiguously, the container converters fall back to
+ *          converting element by element.
+ */
+template<typename ElementType>
+struct BulkCopy
+{
+    /**
+     * @brief Const expression to check if containers of ElementType can be bulk copied.
+     */
+    static constexpr bool enabled =
+            std::is_arithmetic<ElementType>::value
+            && !std::is_same<bool, ElementType>::value
+            && !std::is_same<char, ElementType>::value;
+
+    /**
+     * @brief Checks whether the elements of a DynamicData collection have the native layout.
+     *
+     * @param[in] collection A non-empty DynamicData sequence or array.
+     *
+     * @param[in] N The number of elements to be copied, which the collection must hold.
+     *
+     * @returns `true` if the elements have the native type and are stored contiguously,
+     *          so that they can be bulk copied.
+     */
+    static bool matches(
+            const xtypes::ReadableDynamicDataRef& collection,
+            std::size_t N)
+    {
+        if (collection[0].type().kind() != xtypes::primitive_type<ElementType>().kind())
+        {
+            return false;
+        }
+
+        return N < 2 || &collection[1].value<ElementType>() == &collection[0].value<ElementType>() + 1;
+    }
+
+    /**
+     * @brief Copies the first `N` elements of a DynamicData collection into a native array.
+     */
+    static void from_xtype(
+            const xtypes::ReadableDynamicDataRef& from,
+            ElementType* to,
+            std::size_t N)
+    {
+        std::memcpy(to, &from[0].value<ElementType>(), N * sizeof(ElementType));
+    }
+
+    /**
+     * @brief Copies `N` native elements into the first elements of a DynamicData collection,
+     *        which must already hold at least `N` elements.
+     */
+    static void to_xtype(
+            const ElementType* from,
+            xtypes::WritableDynamicDataRef& to,
+            std::size_t N)
+    {
+        /**
+         * The reference obtained through the readable interface points to
+         * the storage owned by the writable DynamicData.
+         */
+        std::memcpy(const_cast<ElementType*>(&to[0].value<ElementType>()), from, N * sizeof(ElementType));
+    }
+
+};
+
 //==============================================================================
 /**
  * @brief A class that helps create a Convert<> specialization for
@@ -284,6 +363,15 @@ struct ResizableUnboundedContainerConvert
     {
         std::size_t N = std::min(from.size(), UpperBound);
         to.resize(N);
+        if constexpr (BulkCopy<ElementType>::enabled)
+        {
+            if (N > 0 && BulkCopy<ElementType>::matches(from, N))
+            {
+                BulkCopy<ElementType>::from_xtype(from, &to[0], N);
+                return;
+            }
+        }
+
         for (std::size_t i = 0; i < N; ++i)
         {
             from_xtype(from[i], to[i]);
@@ -299,6 +387,15 @@ struct ResizableUnboundedContainerConvert
     {
         const std::size_t N = std::min(from.size(), UpperBound);
         to.resize(N);
+        if constexpr (BulkCopy<ElementType>::enabled)
+        {
+            if (N > 0 && BulkCopy<ElementType>::matches(to, N))
+            {
+                BulkCopy<ElementType>::to_xtype(&from[0], to, N);
+                return;
+            }
+        }
+
         for (std::size_t i = 0; i < N; ++i)
         {
             Convert<ElementType>::to_xtype_field(from[i], to[i]);
@@ -372,6 +469,15 @@ struct ResizableBoundedContainerConvert
     {
         std::size_t N = std::min(from.size(), UpperBound);
         to.resize(N);
+        if constexpr (BulkCopy<ElementType>::enabled)
+        {
+            if (N > 0 && BulkCopy<ElementType>::matches(from, N))
+            {
+                BulkCopy<ElementType>::from_xtype(from, &to[0], N);
+                return;
+            }
+        }
+
         for (std::size_t i = 0; i < N; ++i)
         {
             from_xtype(from[i], to[i]);
@@ -387,6 +493,15 @@ struct ResizableBoundedContainerConvert
     {
         const std::size_t N = std::min(from.size(), UpperBound);
         to.resize(N);
+        if constexpr (BulkCopy<ElementType>::enabled)
+        {
+            if (N > 0 && BulkCopy<ElementType>::matches(to, N))
+            {
+                BulkCopy<ElementType>::to_xtype(&from[0], to, N);
+                return;
+            }
+        }
+
         for (std::size_t i = 0; i < N; ++i)
         {
             Convert<ElementType>::to_xtype_field(from[i], to[i]);
@@ -461,6 +576,15 @@ struct NonResizableContainerConvert
             native_type& to)
     {
         std::size_t N = std::min(from.size(), UpperBound);
+        if constexpr (BulkCopy<ElementType>::enabled)
+        {
+            if (N > 0 && BulkCopy<ElementType>::matches(from, N))
+            {
+                BulkCopy<ElementType>::from_xtype(from, &to[0], N);
+                return;
+            }
+        }
+
         for (std::size_t i = 0; i < N; ++i)
         {
             from_xtype(from[i], to[i]);
@@ -475,6 +599,15 @@ struct NonResizableContainerConvert
             xtypes::WritableDynamicDataRef to)
     {
         const std::size_t N = std::min(from.size(), UpperBound);
+        if constexpr (BulkCopy<ElementType>::enabled)
+        {
+            if (N > 0 && BulkCopy<ElementType>::matches(to, N))
+            {
+                BulkCopy<ElementType>::to_xtype(&from[0], to, N);
+                return;
+            }
+        }
+
         for (std::size_t i = 0; i < N; ++i)
         {
             Convert<ElementType>::to_xtype_field(from[i], to[i]);
@@ -22,6 +22,24 @@
 #include <iostream>
 #include <is/core/export.hpp>
 
+/**
+ * @brief Most verbose logging level compiled into the binaries, as the numeric value of
+ *        its eprosima::is::utils::Logger::Level: messages logged with a higher level through
+ *        the `IS_LOG` macro are removed at compile time. Set by the `IS_LOG_MAX_LEVEL` CMake option.
+ */
+#ifndef IS_LOG_MAX_LEVEL
+#define IS_LOG_MAX_LEVEL 3
+#endif //  IS_LOG_MAX_LEVEL
+
+/**
+ * @brief Streams a message into `logger` only if `level` is enabled, so that the
+ *        rest of the streamed values are neither evaluated nor formatted otherwise.
+ *
+ *        Usage: `IS_LOG(logger, utils::Logger::Level::DEBUG) << "value: " << value << std::endl;`
+ */
+#define IS_LOG(logger, level) \
+    if (!(logger).enabled(level)) {} else (logger) << (level)
+
 namespace eprosima {
 namespace is {
 namespace utils {
@@ -116,6 +134,48 @@ public:
      */
     const Level& get_level() const;
 
+    /**
+     * @brief Checks whether messages of a certain level would be displayed by this Logger.
+     *        Both the compile time `IS_LOG_MAX_LEVEL` and the maximum level of this
+     *        instance are taken into account.
+     *
+     * @param[in] level The logging Level to check.
+     *
+     * @returns `true` if messages with the given level are displayed, `false` otherwise.
+     */
+    bool enabled(
+            Level level) const
+    {
+        return static_cast<int>(level) <= IS_LOG_MAX_LEVEL && level <= _max_level;
+    }
+
+    /**
+     * @brief Selects how the finished messages of every Logger are written to stdout.
+     *
+     * @details In synchronous mode, each message is written from the thread that logged it.
+     *          In asynchronous mode, messages are left in a lock-free ring buffer and written
+     *          by a background thread; if the ring buffer is full, the message is written
+     *          synchronously, so that it is never lost.
+     *          In both modes, each message is written at once, so that the messages
+     *          logged by different threads are never interleaved.
+     *
+     *          The default mode is chosen by the `IS_LOG_ASYNC` CMake option.
+     *
+     * @param[in] asynchronous Whether the asynchronous mode must be used.
+     *
+     * @param[in] capacity Number of messages that the ring buffer can hold. Rounded up
+     *            to a power of two. Only applies when this call switches the asynchronous
+     *            mode on; it is ignored if the asynchronous mode is already enabled.
+     */
+    static void set_asynchronous(
+            bool asynchronous,
+            std::size_t capacity = 8192);
+
+    /**
+     * @brief Blocks until every message left for the background thread has been written.
+     */
+    static void flush();
+
     /**
      * @brief Operator << overload for a certain logging Level.
      *        Sets the logging level for the char/string messages
@@ -159,7 +219,8 @@ public:
     Logger& operator <<(
             const T& value)
     {
-        switch (_status)
+        Record& current = record();
+        switch (status(current))
         {
             case CurrentLevelStatus::NON_SPECIFIED:
             {
@@ -170,7 +231,7 @@ public:
             }
             case CurrentLevelStatus::SPECIFIED:
             {
-                std::cout << value;
+                stream(current) << value;
                 break;
             }
             case CurrentLevelStatus::SPECIFIED_BUT_HIDDEN:
@@ -198,6 +259,30 @@ public:
 
 private:
 
+    /**
+     * @brief Message being composed by a thread, formatted in memory until std::endl
+     *        is received and written to stdout at once.
+     *        Each thread keeps its own records, which are reused from message to message.
+     */
+    struct Record;
+
+    /**
+     * @brief Gets the record of the message being composed by the calling thread with this Logger.
+     */
+    Record& record() const;
+
+    /**
+     * @brief Gets the status of the message being composed in a record.
+     */
+    static CurrentLevelStatus& status(
+            Record& record);
+
+    /**
+     * @brief Gets the stream that formats the values into a record.
+     */
+    static std::ostream& stream(
+            Record& record);
+
     /**
      * Operations for setting on/off ostream bold characters and colors.
      */
@@ -223,7 +308,6 @@ private:
 
     const std::string _header;
     Level _max_level;
-    CurrentLevelStatus _status;
 };
 
 } //  namespace utils
@@ -40,11 +40,13 @@ set(IS_IDL_PKG_MIX_CONFIG_TEMPLATE "${IS_TEMPLATE_DIR}/is-idl-pkg-mix-config.cma
 set(IS_IDL_MIDDLEWARE_MIX_EXTENSION_TEMPLATE "${IS_TEMPLATE_DIR}/is-idl-middleware-mix-extension.cmake.in")
 set(IS_GTEST_CMAKE_MODULE_DIR "${CMAKE_CURRENT_LIST_DIR}/cmake/common")
 set(IS_DOXYGEN_CONFIG_FILE "${CMAKE_CURRENT_LIST_DIR}/../../doxygen-config.in")
+set(IS_MAIN_SOURCE "${CMAKE_CURRENT_LIST_DIR}/src/integration-service.cpp")
 
 include("${CMAKE_CURRENT_LIST_DIR}/cmake/is_generate_export_header.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/cmake/is_install_middleware_plugin.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/cmake/is_mix_generator.cmake")
 include("${CMAKE_CURRENT_LIST_DIR}/cmake/is_mix_install_extension.cmake")
+include("${CMAKE_CURRENT_LIST_DIR}/cmake/is_add_static_bundle.cmake")
 
 include(CMakeFindDependencyMacro)
 find_dependency(yaml-cpp)
@@ -17,9 +17,38 @@
  */
 
 #include <is/core/Config.hpp>
+#include <is/core/runtime/ConversionPlan.hpp>
+#include <is/core/runtime/DynamicDataPool.hpp>
+#include <is/core/runtime/LazySubscription.hpp>
+#include <is/core/runtime/MessageFilter.hpp>
+#include <is/core/runtime/PendingCalls.hpp>
+#include <is/core/runtime/ServiceCall.hpp>
+#include <is/core/runtime/PriorityDispatcher.hpp>
+#include <is/core/runtime/PublishBatch.hpp>
+#include <is/core/runtime/PublisherCache.hpp>
+#include <is/core/runtime/RateLimiter.hpp>
+#include <is/core/runtime/RequestCoalescer.hpp>
+#include <is/core/runtime/SampleAggregator.hpp>
+#include <is/core/runtime/SampleDeduplicator.hpp>
+#include <is/core/runtime/StartupProfile.hpp>
+#include <is/core/runtime/SubscriptionTable.hpp>
+#include <is/core/runtime/SystemHandleRegistry.hpp>
+#include <is/core/runtime/TypeTable.hpp>
+#include <is/core/runtime/TypesCache.hpp>
 #include <is/systemhandle/SystemHandle.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
 #include <iostream>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+
+#ifdef __linux__
+#include <sched.h>
+#endif //  __linux__
 
 namespace eprosima {
 namespace is {
@@ -27,6 +56,108 @@ namespace core {
 namespace internal {
 namespace {
 
+/**
+ * Depth of the priority lanes of the topics whose route does not set a dispatch queue depth.
+ */
+constexpr std::size_t default_priority_lane_depth = 64;
+
+/**
+ * Number of topic names with an advertised publisher that each destination
+ * with a computed topic name keeps, before releasing the least recently used one.
+ */
+constexpr std::size_t dynamic_topic_publishers = 64;
+
+/**
+ * Number of CPUs that can be given in a 'cpu_affinity' entry. The thread settings
+ * are only applied on Linux, but the entries are validated on every platform.
+ */
+#ifdef __linux__
+constexpr int cpu_set_size = CPU_SETSIZE;
+#else
+constexpr int cpu_set_size = 1024;
+#endif //  __linux__
+
+//==============================================================================
+bool parse_thread_config(
+        const std::string& mw_name,
+        const YAML::Node& node,
+        ThreadConfig& thread)
+{
+    const YAML::Node& cpu_affinity = node["cpu_affinity"];
+    if (cpu_affinity)
+    {
+        std::vector<YAML::Node> cpus;
+        if (cpu_affinity.IsSequence())
+        {
+            for (const YAML::Node& cpu : cpu_affinity)
+            {
+                cpus.push_back(cpu);
+            }
+        }
+        else
+        {
+            cpus.push_back(cpu_affinity);
+        }
+
+        for (const YAML::Node& cpu : cpus)
+        {
+            if (!cpu.IsScalar())
+            {
+                Config::logger << utils::Logger::Level::ERROR
+                               << "config-file 'cpu_affinity' entry in system '" << mw_name
+                               << "' must be a CPU index or a list of CPU indexes" << std::endl;
+                return false;
+            }
+
+            if (cpu.as<int>() < 0 || cpu.as<int>() >= cpu_set_size)
+            {
+                Config::logger << utils::Logger::Level::ERROR
+                               << "config-file 'cpu_affinity' entry in system '" << mw_name
+                               << "' has the CPU index " << cpu.as<int>() << ", which must be in the range [0, "
+                               << cpu_set_size << ")" << std::endl;
+                return false;
+            }
+            thread.cpu_affinity.push_back(cpu.as<int>());
+        }
+    }
+
+    const YAML::Node& sched_policy = node["sched_policy"];
+    if (sched_policy)
+    {
+        static const std::set<std::string> policies = {"other", "batch", "idle", "fifo", "rr"};
+        thread.sched_policy = sched_policy.as<std::string>();
+        if (policies.count(thread.sched_policy) == 0)
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'sched_policy' entry in system '" << mw_name
+                           << "' has an unknown policy '" << thread.sched_policy
+                           << "'. Valid values are 'other', 'batch', 'idle', 'fifo' and 'rr'" << std::endl;
+            return false;
+        }
+    }
+
+    const YAML::Node& priority = node["priority"];
+    if (priority)
+    {
+        if (thread.sched_policy != "fifo" && thread.sched_policy != "rr")
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'priority' entry in system '" << mw_name
+                           << "' requires the 'fifo' or 'rr' sched_policy" << std::endl;
+            return false;
+        }
+        thread.priority = priority.as<int>();
+    }
+
+    const YAML::Node& poll_mode = node["poll_mode"];
+    if (poll_mode)
+    {
+        thread.poll_mode = poll_mode.as<bool>();
+    }
+
+    return true;
+}
+
 //==============================================================================
 bool scalar_or_list_node_to_set(
         const YAML::Node& node,
@@ -65,1376 +196,3448 @@ bool scalar_or_list_node_to_set(
 }
 
 //==============================================================================
-std::unique_ptr<TopicRoute> parse_topic_route(
-        const YAML::Node& node)
+bool parse_dispatch_config(
+        const YAML::Node& node,
+        DispatchConfig& dispatch)
 {
-    auto route = std::make_unique<TopicRoute>();
-    bool valid = true;
-
-    valid &= scalar_or_list_node_to_set(
-        node["from"], route->from, "from", "topic");
-
-    valid &= scalar_or_list_node_to_set(
-        node["to"], route->to, "to", "topic");
-
-    std::ostringstream from_list;
-    if (node["from"].IsSequence())
-    {
-        from_list << "[ ";
-
-        for (const auto& from : node["from"])
-        {
-            from_list << from.as<std::string>() << " ";
-        }
-
-        from_list << "]";
-    }
-    else
+    if (!node.IsMap())
     {
-        from_list << node["from"].as<std::string>();
+        Config::logger << utils::Logger::Level::ERROR
+                       << "config-file 'dispatch' entry in topic route must be a dictionary "
+                       << "with the 'queue_depth' and, optionally, 'policy' fields" << std::endl;
+        return false;
     }
 
-    std::ostringstream to_list;
-    if (node["to"].IsSequence())
-    {
-        to_list << "[ ";
-
-        for (const auto& to : node["to"])
-        {
-            to_list << to.as<std::string>() << " ";
-        }
-
-        to_list << "]";
-    }
-    else
+    const YAML::Node& queue_depth = node["queue_depth"];
+    if (!queue_depth || queue_depth.as<int64_t>() <= 0)
     {
-        to_list << node["to"].as<std::string>();
+        Config::logger << utils::Logger::Level::ERROR
+                       << "config-file 'dispatch' entry in topic route must provide "
+                       << "a positive 'queue_depth'" << std::endl;
+        return false;
     }
+    dispatch.queue_depth = queue_depth.as<std::size_t>();
 
-    if (!valid)
+    const YAML::Node& policy = node["policy"];
+    if (policy && !DispatchQueue::parse_policy(policy.as<std::string>(), dispatch.policy))
     {
         Config::logger << utils::Logger::Level::ERROR
-                       << "Topic route { from: '" << from_list.str()
-                       << "', to: '" << to_list.str()
-                       << "' } is invalid." << std::endl;
-        return nullptr;
+                       << "config-file 'dispatch' entry in topic route has an unknown policy '"
+                       << policy.as<std::string>() << "'. Valid policies are "
+                       << "'drop_oldest', 'drop_newest' and 'block'" << std::endl;
+        return false;
     }
 
-    Config::logger << utils::Logger::Level::DEBUG
-                   << "Topic route { from: '" << from_list.str()
-                   << "', to: '" << to_list.str()
-                   << "' } is correct." << std::endl;
-
-    return route;
+    return true;
 }
 
 //==============================================================================
-std::unique_ptr<ServiceRoute> parse_service_route(
-        const YAML::Node& node)
+bool parse_rate_config(
+        const YAML::Node& node,
+        RateConfig& rate)
 {
-    bool valid = true;
-    auto route = std::make_unique<ServiceRoute>();
-
-    const YAML::Node& server = node["server"];
-    if (!server)
+    if (!node.IsMap())
     {
         Config::logger << utils::Logger::Level::ERROR
-                       << "Config-file service route must contain a 'server' entry!"
-                       << std::endl;
-        valid = false;
+                       << "config-file 'rate' entry in topic route must be a dictionary "
+                       << "with the 'max_rate' and, optionally, 'burst' and 'latest_only' fields" << std::endl;
+        return false;
     }
 
-    if (!server.IsScalar() || server.as<std::string>().empty())
+    const YAML::Node& max_rate = node["max_rate"];
+    if (!max_rate || max_rate.as<double>() <= 0.0)
     {
         Config::logger << utils::Logger::Level::ERROR
-                       << "Config-file service route 'server' entry must be a scalar "
-                       << "string! Only one middleware can be the server on a route!"
-                       << std::endl;
-        valid = false;
-    }
-    else
-    {
-        route->server = server.as<std::string>();
+                       << "config-file 'rate' entry in topic route must provide "
+                       << "a positive 'max_rate'" << std::endl;
+        return false;
     }
+    rate.max_rate = max_rate.as<double>();
 
-    valid &= scalar_or_list_node_to_set(
-        node["clients"], route->clients, "clients", "service");
-
-    std::ostringstream client_list;
-    if (node["clients"].IsSequence())
+    const YAML::Node& burst = node["burst"];
+    if (burst)
     {
-        client_list << "[ ";
-
-        for (const auto& client : node["clients"])
+        if (burst.as<int64_t>() <= 0)
         {
-            client_list << client.as<std::string>() << " ";
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'rate' entry in topic route must provide "
+                           << "a positive 'burst'" << std::endl;
+            return false;
         }
-
-        client_list << "]";
-    }
-    else
-    {
-        client_list << node["clients"].as<std::string>();
+        rate.burst = burst.as<std::size_t>();
     }
 
-    if (!valid)
+    const YAML::Node& latest_only = node["latest_only"];
+    if (latest_only)
     {
-        Config::logger << utils::Logger::Level::ERROR
-                       << "Service route { server: '" << node["server"].as<std::string>()
-                       << "', clients: '" << client_list.str() << "' is invalid." << std::endl;
-
-        return nullptr;
+        rate.latest_only = latest_only.as<bool>();
     }
 
-    Config::logger << utils::Logger::Level::DEBUG
-                   << "Service route { server: '" << node["server"].as<std::string>()
-                   << "', clients: '" << client_list.str() << "' is correct." << std::endl;
-
-    return route;
+    return true;
 }
 
 //==============================================================================
-bool add_types(
+bool parse_aggregate_config(
         const YAML::Node& node,
-        const std::string& filename,
-        std::map<std::string, eprosima::xtypes::DynamicType::Ptr>& types)
+        AggregateConfig& aggregate)
 {
-    if (!node["types"])
-    {
-        return true;
-    }
-
-    if (!node["types"]["idls"])
+    if (!node.IsMap())
     {
         Config::logger << utils::Logger::Level::ERROR
-                       << "The config file '" << filename
-                       << "' has a 'types' entry which doesn't contains an 'idls' entry."
+                       << "config-file 'aggregate' entry in topic route must be a dictionary with, "
+                       << "optionally, the 'max_samples', 'max_bytes', 'max_delay' and 'compression' fields"
                        << std::endl;
         return false;
     }
 
-    if (!node["types"]["idls"].IsSequence())
+    aggregate.max_samples = 64;
+
+    const YAML::Node& max_samples = node["max_samples"];
+    if (max_samples)
     {
-        Config::logger << utils::Logger::Level::ERROR
-                       << "The config file '" << filename << "' has an 'idls' entry but "
-                       << "it's not a YAML sequence." << std::endl;
-        return false;
+        if (max_samples.as<int64_t>() <= 0)
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'aggregate' entry in topic route must provide "
+                           << "a positive 'max_samples'" << std::endl;
+            return false;
+        }
+        aggregate.max_samples = max_samples.as<std::size_t>();
     }
 
-    std::vector<std::string> include_paths;
-    if (node["types"]["paths"])
+    const YAML::Node& max_bytes = node["max_bytes"];
+    if (max_bytes)
     {
-        for (auto& path : node["types"]["paths"])
+        if (max_bytes.as<int64_t>() < 0)
         {
-            Config::logger << utils::Logger::Level::DEBUG
-                           << "Adding path '" << path.as<std::string>()
-                           << "' to the IDL file database." << std::endl;
-
-            include_paths.push_back(path.as<std::string>());
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'aggregate' entry in topic route must provide "
+                           << "a non negative 'max_bytes'" << std::endl;
+            return false;
         }
+        aggregate.max_bytes = max_bytes.as<std::size_t>();
     }
 
-    uint16_t idl_index = 1;
-    for (auto& entry: node["types"]["idls"])
+    const YAML::Node& max_delay = node["max_delay"];
+    if (max_delay)
     {
-        eprosima::xtypes::idl::Context context;
-        context.allow_keyword_identifiers = true;
-        if (!include_paths.empty())
+        aggregate.max_delay = max_delay.as<double>();
+        if (aggregate.max_delay <= 0.0)
         {
-            context.include_paths = include_paths;
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'aggregate' entry in topic route must provide "
+                           << "a positive 'max_delay'" << std::endl;
+            return false;
         }
-        eprosima::xtypes::idl::parse(entry.as<std::string>(), context);
+    }
 
-        if (context.success)
+    const YAML::Node& compression = node["compression"];
+    if (compression)
+    {
+        const std::string name = compression.as<std::string>();
+        if (name == "none")
         {
-            for (auto& type: context.get_all_scoped_types())
-            {
-                types.insert(type);
-                // Some SHs expect the types without the initial "::", and others with it,
-                // so we must add both of them.
-                if (type.first.find("::") == 0)
-                {
-                    types.emplace(std::make_pair(type.first.substr(2), type.second));
-                }
-                else
-                {
-                    types.emplace(std::make_pair("::" + type.first, type.second));
-                }
-            }
-            if (types.empty())
-            {
-                Config::logger << utils::Logger::Level::WARN
-                               << "Parsing the IDL number '" << idl_index
-                               << "' placed in the YAML config. "
-                               << "The parsing was successful but no types were found."
-                               << std::endl;
-            }
-            else
-            {
-                Config::logger << utils::Logger::Level::DEBUG
-                               << "Parsing the IDL number '" << idl_index
-                               << "' placed in the YAML config. "
-                               << "The parsing was successful."
-                               << std::endl;
-            }
+            aggregate.compression = SampleAggregator::Compression::NONE;
+        }
+        else if (name == "lz4")
+        {
+            aggregate.compression = SampleAggregator::Compression::LZ4;
+        }
+        else if (name == "zstd")
+        {
+            aggregate.compression = SampleAggregator::Compression::ZSTD;
         }
         else
         {
             Config::logger << utils::Logger::Level::ERROR
-                           << "Error parsing the IDL number '" << idl_index
-                           << "' placed in the YAML config. "
-                           << "Please, review and fix your IDL specification syntax."
-                           << std::endl;
+                           << "config-file 'aggregate' entry in topic route has an unknown compression '"
+                           << name << "'. Valid values are 'none', 'lz4' and 'zstd'" << std::endl;
+            return false;
+        }
+
+        if (!SampleAggregator::available(aggregate.compression))
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'aggregate' entry in topic route requests the '" << name
+                           << "' compression, but Integration Service was built without it" << std::endl;
             return false;
         }
-        idl_index++;
     }
 
     return true;
 }
 
 //==============================================================================
-bool add_named_route(
-        const std::string& name,
+bool parse_dedup_config(
         const YAML::Node& node,
-        std::map<std::string, TopicRoute>& topic_routes,
-        std::map<std::string, ServiceRoute>& service_routes)
+        DedupConfig& dedup)
 {
-    bool inserted = false;
-    if (node["from"] && node["to"])
+    if (!node.IsMap())
     {
-        const auto route = parse_topic_route(node);
-        if (!route)
+        Config::logger << utils::Logger::Level::ERROR
+                       << "config-file 'dedup' entry in topic route must be a dictionary with "
+                       << "the 'window' and, optionally, 'key' and 'capacity' fields" << std::endl;
+        return false;
+    }
+
+    const YAML::Node& window = node["window"];
+    if (!window || window.as<double>() <= 0.0)
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "config-file 'dedup' entry in topic route must provide "
+                       << "a positive 'window'" << std::endl;
+        return false;
+    }
+    dedup.window = window.as<double>();
+
+    const YAML::Node& key = node["key"];
+    if (key)
+    {
+        dedup.key = key.as<std::string>();
+    }
+
+    const YAML::Node& capacity = node["capacity"];
+    if (capacity)
+    {
+        if (capacity.as<int64_t>() <= 0)
         {
             Config::logger << utils::Logger::Level::ERROR
-                           << "Failed to parse the route named '"
-                           << name << "'" << std::endl;
+                           << "config-file 'dedup' entry in topic route must provide "
+                           << "a positive 'capacity'" << std::endl;
             return false;
         }
+        dedup.capacity = capacity.as<std::size_t>();
+    }
 
-        Config::logger << utils::Logger::Level::DEBUG
-                       << "Add topic route '" << name << "'." << std::endl;
+    return true;
+}
 
-        inserted = topic_routes.insert(std::make_pair(name, *route)).second;
+//==============================================================================
+bool parse_calls_config(
+        const YAML::Node& node,
+        CallsConfig& calls)
+{
+    if (!node.IsMap())
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "config-file 'calls' entry in service route must be a dictionary "
+                       << "with the 'timeout' and/or 'max_in_flight' fields" << std::endl;
+        return false;
     }
-    else if (node["server"] && node["clients"])
+
+    const YAML::Node& timeout = node["timeout"];
+    if (timeout)
     {
-        const auto route = parse_service_route(node);
-        if (!route)
+        calls.timeout = timeout.as<double>();
+        if (calls.timeout < 0.0)
         {
             Config::logger << utils::Logger::Level::ERROR
-                           << "Failed to parse the route named '"
-                           << name << "'" << std::endl;
+                           << "config-file 'calls' entry in service route must provide "
+                           << "a non negative 'timeout'" << std::endl;
+            return false;
+        }
+    }
 
+    const YAML::Node& max_in_flight = node["max_in_flight"];
+    if (max_in_flight)
+    {
+        if (max_in_flight.as<int64_t>() < 0)
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'calls' entry in service route must provide "
+                           << "a non negative 'max_in_flight'" << std::endl;
             return false;
         }
+        calls.max_in_flight = max_in_flight.as<std::size_t>();
+    }
 
-        Config::logger << utils::Logger::Level::DEBUG
-                       << "Add service route '" << name << "'." << std::endl;
+    return true;
+}
 
-        inserted = service_routes.insert(std::make_pair(name, *route)).second;
+//==============================================================================
+bool parse_coalesce_config(
+        const YAML::Node& node,
+        CoalesceConfig& coalesce)
+{
+    if (node.IsScalar())
+    {
+        coalesce.enabled = node.as<bool>();
+        return true;
     }
-    else
+
+    if (!node.IsMap())
     {
         Config::logger << utils::Logger::Level::ERROR
-                       << "Cannot recognize route named '" << name << "' because it "
-                       << "does not match a topic route scheme {from: X, to: Y} "
-                       << "or a service route scheme {server: X, clients: Y}" << std::endl;
+                       << "config-file 'coalesce' entry in service must be a boolean, or a "
+                       << "dictionary with, optionally, the 'reply_ttl' and 'max_waiters' fields" << std::endl;
         return false;
     }
 
-    if (!inserted)
+    coalesce.enabled = true;
+
+    const YAML::Node& reply_ttl = node["reply_ttl"];
+    if (reply_ttl)
     {
-        Config::logger << utils::Logger::Level::WARN
-                       << "Duplicate route named '" << name
-                       << "'!" << std::endl;
+        coalesce.reply_ttl = reply_ttl.as<double>();
+        if (coalesce.reply_ttl < 0.0)
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'coalesce' entry in service must provide "
+                           << "a non negative 'reply_ttl'" << std::endl;
+            return false;
+        }
     }
 
-    return inserted;
+    const YAML::Node& max_waiters = node["max_waiters"];
+    if (max_waiters)
+    {
+        if (max_waiters.as<int64_t>() <= 0)
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'coalesce' entry in service must provide "
+                           << "a positive 'max_waiters'" << std::endl;
+            return false;
+        }
+        coalesce.max_waiters = max_waiters.as<std::size_t>();
+    }
+
+    return true;
 }
 
 //==============================================================================
-void set_middleware_config(
-        std::map<std::string, YAML::Node>& middleware_configs,
-        const TopicRoute& route,
-        const YAML::Node& node)
+bool parse_metrics_config(
+        const YAML::Node& node,
+        MetricsConfig& metrics)
 {
-    for (const std::string& from : route.from)
+    if (!node.IsMap())
     {
-        if (node[from])
-        {
-            middleware_configs[from] = node[from];
-        }
-        else
+        Config::logger << utils::Logger::Level::ERROR
+                       << "config-file 'metrics' entry must be a dictionary" << std::endl;
+        return false;
+    }
+
+    const YAML::Node& dump_period = node["dump_period"];
+    if (dump_period)
+    {
+        metrics.dump_period = dump_period.as<double>();
+        if (metrics.dump_period < 0.0)
         {
-            middleware_configs[from] = node;
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'metrics' entry must provide a non negative "
+                           << "'dump_period'" << std::endl;
+            return false;
         }
     }
-    for (const std::string& to : route.to)
+
+    const YAML::Node& exporter = node["exporter"];
+    if (exporter)
     {
-        if (node[to])
+        const YAML::Node& port = exporter["port"];
+        if (!exporter.IsMap() || !port || port.as<int>() <= 0 || port.as<int>() > 65535)
         {
-            middleware_configs[to] = node[to];
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'exporter' entry in 'metrics' must be a dictionary "
+                           << "with a valid 'port' and, optionally, an 'address' field" << std::endl;
+            return false;
         }
-        else
+        metrics.exporter_port = static_cast<uint16_t>(port.as<int>());
+
+        const YAML::Node& address = exporter["address"];
+        if (address)
         {
-            middleware_configs[to] = node;
+            metrics.exporter_address = address.as<std::string>();
         }
     }
+
+    return true;
 }
 
 //==============================================================================
-void set_middleware_config(
-        std::map<std::string, YAML::Node>& middleware_configs,
-        const ServiceRoute& route,
-        const YAML::Node& node)
+bool parse_tracing_config(
+        const YAML::Node& node,
+        TracingConfig& tracing)
 {
-    // TODO (@jamoralp): types, route, and remap should be ignored here?
-    middleware_configs[route.server] = node;
+    const YAML::Node& sample_every = node["sample_every"];
+    if (!node.IsMap() || !sample_every || sample_every.as<int>() <= 0)
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "config-file 'tracing' entry must be a dictionary with a positive "
+                       << "'sample_every' and, optionally, 'format' and 'file' fields" << std::endl;
+        return false;
+    }
+    tracing.sample_every = sample_every.as<std::size_t>();
 
-    for (const std::string& client : route.clients)
+    const YAML::Node& format = node["format"];
+    if (format)
     {
-        middleware_configs[client] = node;
+        tracing.format = format.as<std::string>();
+        if (tracing.format != "text" && tracing.format != "otlp")
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'tracing' entry has an unknown format '" << tracing.format
+                           << "'. Valid values are 'text' and 'otlp'" << std::endl;
+            return false;
+        }
+    }
+
+    const YAML::Node& file = node["file"];
+    if (file)
+    {
+        tracing.file = file.as<std::string>();
     }
+
+    return true;
 }
 
 //==============================================================================
-template<typename ConfigType, typename RouteType>
-bool add_topic_or_service_config(
-        const std::string& channel_type,
-        const std::string& name,
+bool parse_recording_config(
         const YAML::Node& node,
-        const std::map<std::string, RouteType>& predefined_routes,
-        std::map<std::string, ConfigType>& config_map,
-        std::function<void(ConfigType&, std::string &&)> set_type,
-        std::function<void(ConfigType&, std::string &&)> set_reply_type,
-        std::function<void(ConfigType&, const RouteType&)> set_route,
-        std::function<std::unique_ptr<RouteType>(const YAML::Node&)> parse_route)
+        RecordingConfig& recording)
 {
-    bool valid = true;
-    ConfigType config;
-
-    const YAML::Node& type = node["type"];
-    if (!type)
+    const YAML::Node& file = node["file"];
+    if (!node.IsMap() || !file || file.as<std::string>().empty())
     {
-        if (channel_type == "service")
-        {
-            const YAML::Node& request_type = node["request_type"];
-            const YAML::Node& reply_type = node["reply_type"];
+        Config::logger << utils::Logger::Level::ERROR
+                       << "config-file 'recording' entry must be a dictionary with a non-empty "
+                       << "'file' and, optionally, a 'segment_size' field" << std::endl;
+        return false;
+    }
+    recording.file = file.as<std::string>();
 
-            if (!request_type && !reply_type)
-            {
-                Config::logger << utils::Logger::Level::ERROR
-                               << "The " << channel_type << " configuration '" << name
-                               << "' is missing its 'type', or 'request_type' "
-                               << " and 'reply_type' fields!" << std::endl;
-                valid = false;
-            }
-            else
-            {
-                std::string request_type_str = request_type.as<std::string>();
-                set_type(config, std::move(request_type_str));
-                std::string reply_type_str = reply_type.as<std::string>();
-                set_reply_type(config, std::move(reply_type_str));
-            }
-        }
-        else
+    const YAML::Node& segment_size = node["segment_size"];
+    if (segment_size)
+    {
+        if (segment_size.as<long long>() <= 0)
         {
             Config::logger << utils::Logger::Level::ERROR
-                           << "The " << channel_type << " configuration '" << name
-                           << "' is missing its 'type' field!" << std::endl;
-            valid = false;
+                           << "config-file 'recording' entry must have a positive 'segment_size'"
+                           << std::endl;
+            return false;
         }
-    }
-    else
-    {
-        std::string type_str = type.as<std::string>();
-        set_type(config, std::move(type_str));
+        recording.segment_size = segment_size.as<std::size_t>();
     }
 
-    const YAML::Node& route = node["route"];
-    if (!route)
+    return true;
+}
+
+//==============================================================================
+std::unique_ptr<TopicRoute> parse_topic_route(
+        const YAML::Node& node)
+{
+    auto route = std::make_unique<TopicRoute>();
+    bool valid = true;
+
+    valid &= scalar_or_list_node_to_set(
+        node["from"], route->from, "from", "topic");
+
+    valid &= scalar_or_list_node_to_set(
+        node["to"], route->to, "to", "topic");
+
+    if (node["dispatch"])
     {
-        Config::logger << utils::Logger::Level::ERROR
-                       << "The " << channel_type << " configuration '" << name
-                       << "' is missing its 'route' field!" << std::endl;
-        valid = false;
+        valid &= parse_dispatch_config(node["dispatch"], route->dispatch);
     }
-    else
+
+    if (node["rate"])
     {
-        if (route.IsScalar())
-        {
-            const std::string& route_name = route.as<std::string>();
-            const auto it = predefined_routes.find(route_name);
-            if (it == predefined_routes.end())
-            {
-                Config::logger << utils::Logger::Level::ERROR
-                               << "The " << channel_type << " configuration '" << name
-                               << "' requested a route named '" << route_name << "' but a "
-                               << "route with that name was never defined in the 'routes' "
-                               << "dictionary!" << std::endl;
-                valid = false;
-            }
-            else
-            {
-                set_route(config, it->second);
-            }
-        }
-        else if (route.IsMap())
-        {
-            const auto route_config = parse_route(route);
-            if (!route_config)
-            {
-                Config::logger << utils::Logger::Level::ERROR
-                               << "Failed to parse the route configuration for the "
-                               << channel_type << " '" << name << "'!" << std::endl;
-                valid = false;
-            }
-            else
-            {
-                set_route(config, *route_config);
-            }
-        }
+        valid &= parse_rate_config(node["rate"], route->rate);
     }
 
-    const YAML::Node& remap = node["remap"];
-    if (remap)
+    if (node["aggregate"])
     {
-        if (!remap.IsMap())
+        valid &= parse_aggregate_config(node["aggregate"], route->aggregate);
+        if (route->rate.max_rate > 0.0)
         {
             Config::logger << utils::Logger::Level::ERROR
-                           << "A 'remap' field was given for the " << channel_type
-                           << " configuration '" << name
-                           << "', but it is not a dictionary!" << std::endl;
+                           << "config-file topic route cannot limit the 'rate' of aggregated destinations"
+                           << std::endl;
             valid = false;
         }
-        else
-        {
-            for (YAML::const_iterator it = remap.begin(); it != remap.end(); ++it)
-            {
-                TopicInfo& remap_info = config.remap[it->first.as<std::string>()];
-                if (it->second["topic"])
-                {
-                    remap_info.name = it->second["topic"].as<std::string>();
-                }
-                if (it->second["type"])
-                {
-                    remap_info.type = it->second["type"].as<std::string>();
-                }
-                if (it->second["request_type"])
-                {
-                    remap_info.type = it->second["request_type"].as<std::string>();
-                }
-                if (it->second["reply_type"])
-                {
-                    remap_info.reply_type = it->second["reply_type"].as<std::string>();
-                }
-            }
-        }
     }
 
-    /**
-     *  TODO(@jamoralp): Come up with a yaml scene for specifying middleware
-     * configurations per topic/service and then fill in the middleware_configs map here.
-     */
-    // Proposal
-    if (valid)
+    if (node["deaggregate"])
     {
-        set_middleware_config(config.middleware_configs, config.route, node);
+        route->deaggregate = node["deaggregate"].as<bool>();
     }
-    // End of proposal
 
-    if (valid)
+    if (node["dedup"])
     {
-        if (!config_map.insert(std::make_pair(name, config)).second)
+        valid &= parse_dedup_config(node["dedup"], route->dedup);
+    }
+
+    std::ostringstream from_list;
+    if (node["from"].IsSequence())
+    {
+        from_list << "[ ";
+
+        for (const auto& from : node["from"])
         {
-            // If configuration specified twice, we will stick with the first one
-            Config::logger << utils::Logger::Level::WARN
-                           << channel_type << " configuration '" << name
-                           << "' was specified twice!" << std::endl;
+            from_list << from.as<std::string>() << " ";
         }
+
+        from_list << "]";
+    }
+    else
+    {
+        from_list << node["from"].as<std::string>();
     }
 
-    return valid;
+    std::ostringstream to_list;
+    if (node["to"].IsSequence())
+    {
+        to_list << "[ ";
+
+        for (const auto& to : node["to"])
+        {
+            to_list << to.as<std::string>() << " ";
+        }
+
+        to_list << "]";
+    }
+    else
+    {
+        to_list << node["to"].as<std::string>();
+    }
+
+    if (!valid)
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "Topic route { from: '" << from_list.str()
+                       << "', to: '" << to_list.str()
+                       << "' } is invalid." << std::endl;
+        return nullptr;
+    }
+
+    Config::logger << utils::Logger::Level::DEBUG
+                   << "Topic route { from: '" << from_list.str()
+                   << "', to: '" << to_list.str()
+                   << "' } is correct." << std::endl;
+
+    return route;
 }
 
 //==============================================================================
-bool add_topic_config(
-        const std::string& name,
-        const YAML::Node& node,
-        const std::map<std::string, TopicRoute>& topic_routes,
-        std::map<std::string, TopicConfig>& topic_configs)
+std::unique_ptr<ServiceRoute> parse_service_route(
+        const YAML::Node& node)
 {
-    return add_topic_or_service_config<TopicConfig, TopicRoute>(
-        "topic", name, node, topic_routes, topic_configs,
-        [=](TopicConfig& config, std::string&& type)
-        {
-            Config::logger << utils::Logger::Level::DEBUG
-                           << "Set type '" << type << "' for topic '"
-                           << name << "'." << std::endl;
+    bool valid = true;
+    auto route = std::make_unique<ServiceRoute>();
 
-            config.message_type = std::move(type);
-        },
-        [=](TopicConfig&, std::string&&)
-        {
-        },
-        [=](TopicConfig& config, const TopicRoute& route)
-        {
-            Config::logger << utils::Logger::Level::DEBUG;
-            Config::logger << "Set route '{ from: ";
+    const YAML::Node& server = node["server"];
+    if (!server)
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "Config-file service route must contain a 'server' entry!"
+                       << std::endl;
+        valid = false;
+    }
 
-            for (const auto& _from : route.from)
-            {
-                Config::logger << _from << " ";
-            }
+    if (!server.IsScalar() || server.as<std::string>().empty())
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "Config-file service route 'server' entry must be a scalar "
+                       << "string! Only one middleware can be the server on a route!"
+                       << std::endl;
+        valid = false;
+    }
+    else
+    {
+        route->server = server.as<std::string>();
+    }
 
-            Config::logger << ", to: ";
-            for (const auto& _to : route.to)
-            {
-                Config::logger << _to << " ";
-            }
+    valid &= scalar_or_list_node_to_set(
+        node["clients"], route->clients, "clients", "service");
 
-            Config::logger << "}' for topic '" << name << "'." << std::endl;
+    if (node["calls"])
+    {
+        valid &= parse_calls_config(node["calls"], route->calls);
+    }
 
-            config.route = route;
-        },
-        [](const YAML::Node& route)
+    std::ostringstream client_list;
+    if (node["clients"].IsSequence())
+    {
+        client_list << "[ ";
+
+        for (const auto& client : node["clients"])
         {
-            return parse_topic_route(route);
-        });
+            client_list << client.as<std::string>() << " ";
+        }
+
+        client_list << "]";
+    }
+    else
+    {
+        client_list << node["clients"].as<std::string>();
+    }
+
+    if (!valid)
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "Service route { server: '" << node["server"].as<std::string>()
+                       << "', clients: '" << client_list.str() << "' is invalid." << std::endl;
+
+        return nullptr;
+    }
+
+    Config::logger << utils::Logger::Level::DEBUG
+                   << "Service route { server: '" << node["server"].as<std::string>()
+                   << "', clients: '" << client_list.str() << "' is correct." << std::endl;
+
+    return route;
 }
 
 //==============================================================================
-bool add_service_config(
-        const std::string& name,
+bool add_types(
         const YAML::Node& node,
-        const std::map<std::string, ServiceRoute>& service_routes,
-        std::map<std::string, ServiceConfig>& service_configs)
+        const std::string& filename,
+        TypeRegistry& types,
+        std::vector<TypeTable::Lease>& leases)
 {
-    return add_topic_or_service_config<ServiceConfig, ServiceRoute>(
-        "service", name, node, service_routes, service_configs,
-        [=](ServiceConfig& config, std::string&& type)
+    if (!node["types"])
+    {
+        return true;
+    }
+
+    if (!node["types"]["idls"])
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "The config file '" << filename
+                       << "' has a 'types' entry which doesn't contains an 'idls' entry."
+                       << std::endl;
+        return false;
+    }
+
+    if (!node["types"]["idls"].IsSequence())
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "The config file '" << filename << "' has an 'idls' entry but "
+                       << "it's not a YAML sequence." << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> include_paths;
+    if (node["types"]["paths"])
+    {
+        for (auto& path : node["types"]["paths"])
         {
             Config::logger << utils::Logger::Level::DEBUG
-                           << "Set request type '" << type
-                           << "' for service '" << name
-                           << "'." << std::endl;
+                           << "Adding path '" << path.as<std::string>()
+                           << "' to the IDL file database." << std::endl;
 
-            config.request_type = std::move(type);
-        },
-        [=](ServiceConfig& config, std::string&& type)
+            include_paths.push_back(path.as<std::string>());
+        }
+    }
+
+    /**
+     * When a cache directory is given, the types of each IDL are restored from it
+     * if they were stored in a previous run, so that the IDL does not need to be parsed.
+     */
+    std::unique_ptr<TypesCache> cache;
+    if (node["types"]["cache"])
+    {
+        cache.reset(new TypesCache(node["types"]["cache"].as<std::string>()));
+    }
+
+    uint16_t idl_index = 1;
+    for (auto& entry: node["types"]["idls"])
+    {
+        const std::string idl = entry.as<std::string>();
+
+        TypesCache::Types scoped_types;
+        bool success = cache && cache->load(idl, include_paths, scoped_types);
+        if (success)
         {
             Config::logger << utils::Logger::Level::DEBUG
-                           << "Set reply type '" << type
-                           << "' for service '" << name
-                           << "'." << std::endl;
-
-            config.reply_type = std::move(type);
-        },
-        [=](ServiceConfig& config, const ServiceRoute& route)
+                           << "The types of the IDL number '" << idl_index
+                           << "' placed in the YAML config were restored from the cache."
+                           << std::endl;
+        }
+        else
         {
-            Config::logger << utils::Logger::Level::DEBUG;
-            Config::logger << "Set route '{ server: " << route.server;
-
-            Config::logger << ", clients: ";
-            for (const auto& _client : route.clients)
+            eprosima::xtypes::idl::Context context;
+            context.allow_keyword_identifiers = true;
+            if (!include_paths.empty())
             {
-                Config::logger << _client << " ";
+                context.include_paths = include_paths;
             }
+            eprosima::xtypes::idl::parse(idl, context);
 
-            Config::logger << "}' for service '" << name << "'." << std::endl;
+            success = context.success;
+            if (success)
+            {
+                scoped_types = context.get_all_scoped_types();
+                if (cache && !cache->store(idl, include_paths, scoped_types))
+                {
+                    Config::logger << utils::Logger::Level::DEBUG
+                                   << "The types of the IDL number '" << idl_index
+                                   << "' placed in the YAML config could not be cached."
+                                   << std::endl;
+                }
+            }
+        }
 
-            config.route = route;
-        },
-        [](const YAML::Node& route)
+        if (success)
         {
-            return parse_service_route(route);
-        });
-}
-
-//==============================================================================
-using ReadDictEntry =
-        std::function<bool (const std::string& key, const YAML::Node& value)>;
-
-bool read_dictionary(
-        const YAML::Node& config_node,
-        const std::string& field_name,
-        const std::string& filename,
-        const ReadDictEntry& read_fcn)
-{
-    const YAML::Node& field = config_node[field_name];
-    if (field)
+            for (auto& type: scoped_types)
+            {
+                // Some SHs expect the types without the initial "::", and others with it.
+                // They are stored once, without it, and TypeTable::find_type() accepts both spellings.
+                // Equal types given by several IDLs or instances share the interned type,
+                // which stays interned while some configuration holds its lease.
+                TypeTable::Lease lease;
+                types.emplace(TypeTable::unscoped(type.first), TypeTable::global().intern(type.second, lease));
+                leases.push_back(std::move(lease));
+            }
+            if (types.empty())
+            {
+                Config::logger << utils::Logger::Level::WARN
+                               << "Parsing the IDL number '" << idl_index
+                               << "' placed in the YAML config. "
+                               << "The parsing was successful but no types were found."
+                               << std::endl;
+            }
+            else
+            {
+                Config::logger << utils::Logger::Level::DEBUG
+                               << "Parsing the IDL number '" << idl_index
+                               << "' placed in the YAML config. "
+                               << "The parsing was successful."
+                               << std::endl;
+            }
+        }
+        else
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "Error parsing the IDL number '" << idl_index
+                           << "' placed in the YAML config. "
+                           << "Please, review and fix your IDL specification syntax."
+                           << std::endl;
+            return false;
+        }
+        idl_index++;
+    }
+
+    return true;
+}
+
+//==============================================================================
+bool add_named_route(
+        const std::string& name,
+        const YAML::Node& node,
+        std::map<std::string, TopicRoute>& topic_routes,
+        std::map<std::string, ServiceRoute>& service_routes)
+{
+    bool inserted = false;
+    if (node["from"] && node["to"])
+    {
+        const auto route = parse_topic_route(node);
+        if (!route)
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "Failed to parse the route named '"
+                           << name << "'" << std::endl;
+            return false;
+        }
+
+        Config::logger << utils::Logger::Level::DEBUG
+                       << "Add topic route '" << name << "'." << std::endl;
+
+        inserted = topic_routes.insert(std::make_pair(name, *route)).second;
+    }
+    else if (node["server"] && node["clients"])
+    {
+        const auto route = parse_service_route(node);
+        if (!route)
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "Failed to parse the route named '"
+                           << name << "'" << std::endl;
+
+            return false;
+        }
+
+        Config::logger << utils::Logger::Level::DEBUG
+                       << "Add service route '" << name << "'." << std::endl;
+
+        inserted = service_routes.insert(std::make_pair(name, *route)).second;
+    }
+    else
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "Cannot recognize route named '" << name << "' because it "
+                       << "does not match a topic route scheme {from: X, to: Y} "
+                       << "or a service route scheme {server: X, clients: Y}" << std::endl;
+        return false;
+    }
+
+    if (!inserted)
+    {
+        Config::logger << utils::Logger::Level::WARN
+                       << "Duplicate route named '" << name
+                       << "'!" << std::endl;
+    }
+
+    return inserted;
+}
+
+//==============================================================================
+void set_middleware_config(
+        std::map<std::string, YAML::Node>& middleware_configs,
+        const TopicRoute& route,
+        const YAML::Node& node)
+{
+    for (const std::string& from : route.from)
+    {
+        if (node[from])
+        {
+            middleware_configs[from] = node[from];
+        }
+        else
+        {
+            middleware_configs[from] = node;
+        }
+    }
+    for (const std::string& to : route.to)
+    {
+        if (node[to])
+        {
+            middleware_configs[to] = node[to];
+        }
+        else
+        {
+            middleware_configs[to] = node;
+        }
+    }
+}
+
+//==============================================================================
+void set_middleware_config(
+        std::map<std::string, YAML::Node>& middleware_configs,
+        const ServiceRoute& route,
+        const YAML::Node& node)
+{
+    // TODO (@jamoralp): types, route, and remap should be ignored here?
+    middleware_configs[route.server] = node;
+
+    for (const std::string& client : route.clients)
+    {
+        middleware_configs[client] = node;
+    }
+}
+
+//==============================================================================
+template<typename ConfigType, typename RouteType>
+bool add_topic_or_service_config(
+        const std::string& channel_type,
+        const std::string& name,
+        const YAML::Node& node,
+        const std::map<std::string, RouteType>& predefined_routes,
+        std::map<std::string, ConfigType>& config_map,
+        std::function<void(ConfigType&, std::string &&)> set_type,
+        std::function<void(ConfigType&, std::string &&)> set_reply_type,
+        std::function<void(ConfigType&, const RouteType&)> set_route,
+        std::function<std::unique_ptr<RouteType>(const YAML::Node&)> parse_route)
+{
+    bool valid = true;
+    ConfigType config;
+
+    const YAML::Node& type = node["type"];
+    if (!type)
+    {
+        if (channel_type == "service")
+        {
+            const YAML::Node& request_type = node["request_type"];
+            const YAML::Node& reply_type = node["reply_type"];
+
+            if (!request_type && !reply_type)
+            {
+                Config::logger << utils::Logger::Level::ERROR
+                               << "The " << channel_type << " configuration '" << name
+                               << "' is missing its 'type', or 'request_type' "
+                               << " and 'reply_type' fields!" << std::endl;
+                valid = false;
+            }
+            else
+            {
+                std::string request_type_str = request_type.as<std::string>();
+                set_type(config, std::move(request_type_str));
+                std::string reply_type_str = reply_type.as<std::string>();
+                set_reply_type(config, std::move(reply_type_str));
+            }
+        }
+        else
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "The " << channel_type << " configuration '" << name
+                           << "' is missing its 'type' field!" << std::endl;
+            valid = false;
+        }
+    }
+    else
+    {
+        std::string type_str = type.as<std::string>();
+        set_type(config, std::move(type_str));
+    }
+
+    const YAML::Node& route = node["route"];
+    if (!route)
+    {
+        Config::logger << utils::Logger::Level::ERROR
+                       << "The " << channel_type << " configuration '" << name
+                       << "' is missing its 'route' field!" << std::endl;
+        valid = false;
+    }
+    else
+    {
+        if (route.IsScalar())
+        {
+            const std::string& route_name = route.as<std::string>();
+            const auto it = predefined_routes.find(route_name);
+            if (it == predefined_routes.end())
+            {
+                Config::logger << utils::Logger::Level::ERROR
+                               << "The " << channel_type << " configuration '" << name
+                               << "' requested a route named '" << route_name << "' but a "
+                               << "route with that name was never defined in the 'routes' "
+                               << "dictionary!" << std::endl;
+                valid = false;
+            }
+            else
+            {
+                set_route(config, it->second);
+                config.route_name = route_name;
+            }
+        }
+        else if (route.IsMap())
+        {
+            const auto route_config = parse_route(route);
+            if (!route_config)
+            {
+                Config::logger << utils::Logger::Level::ERROR
+                               << "Failed to parse the route configuration for the "
+                               << channel_type << " '" << name << "'!" << std::endl;
+                valid = false;
+            }
+            else
+            {
+                set_route(config, *route_config);
+                config.route_name = name;
+            }
+        }
+    }
+
+    const YAML::Node& remap = node["remap"];
+    if (remap)
+    {
+        if (!remap.IsMap())
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "A 'remap' field was given for the " << channel_type
+                           << " configuration '" << name
+                           << "', but it is not a dictionary!" << std::endl;
+            valid = false;
+        }
+        else
+        {
+            for (YAML::const_iterator it = remap.begin(); it != remap.end(); ++it)
+            {
+                TopicInfo& remap_info = config.remap[it->first.as<std::string>()];
+                if (it->second["topic"])
+                {
+                    remap_info.name = it->second["topic"].as<std::string>();
+                }
+                if (it->second["type"])
+                {
+                    remap_info.type = it->second["type"].as<std::string>();
+                }
+                if (it->second["request_type"])
+                {
+                    remap_info.type = it->second["request_type"].as<std::string>();
+                }
+                if (it->second["reply_type"])
+                {
+                    remap_info.reply_type = it->second["reply_type"].as<std::string>();
+                }
+
+                const YAML::Node& project = it->second["project"];
+                if (project)
+                {
+                    if (channel_type != "topic" || !project.IsSequence() || project.size() == 0
+                            || !it->second["type"])
+                    {
+                        Config::logger << utils::Logger::Level::ERROR
+                                       << "The 'project' remap of the " << channel_type << " configuration '"
+                                       << name << "' must be a non-empty list of members, given along with "
+                                       << "the 'type' they are projected into, and only for topics." << std::endl;
+                        valid = false;
+                        continue;
+                    }
+
+                    for (const YAML::Node& member : project)
+                    {
+                        remap_info.project.push_back(member.as<std::string>());
+                    }
+                }
+            }
+        }
+    }
+
+    /**
+     *  TODO(@jamoralp): Come up with a yaml scene for specifying middleware
+     * configurations per topic/service and then fill in the middleware_configs map here.
+     */
+    // Proposal
+    if (valid)
+    {
+        set_middleware_config(config.middleware_configs, config.route, node);
+    }
+    // End of proposal
+
+    if (valid)
+    {
+        if (!config_map.insert(std::make_pair(name, config)).second)
+        {
+            // If configuration specified twice, we will stick with the first one
+            Config::logger << utils::Logger::Level::WARN
+                           << channel_type << " configuration '" << name
+                           << "' was specified twice!" << std::endl;
+        }
+    }
+
+    return valid;
+}
+
+//==============================================================================
+bool add_topic_config(
+        const std::string& name,
+        const YAML::Node& node,
+        const std::map<std::string, TopicRoute>& topic_routes,
+        std::map<std::string, TopicConfig>& topic_configs)
+{
+    int priority = -1;
+    if (node["priority"])
+    {
+        if (!node["priority"].IsScalar() || node["priority"].as<int>() < 0)
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'priority' entry in topic '" << name
+                           << "' must be a non-negative integer." << std::endl;
+
+            return false;
+        }
+        priority = node["priority"].as<int>();
+    }
+
+    bool lazy = false;
+    if (node["lazy"])
+    {
+        if (!node["lazy"].IsScalar())
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'lazy' entry in topic '" << name
+                           << "' must be a boolean." << std::endl;
+
+            return false;
+        }
+        lazy = node["lazy"].as<bool>();
+    }
+
+    std::string filter;
+    if (node["filter"])
+    {
+        if (!node["filter"].IsScalar() || node["filter"].as<std::string>().empty())
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "config-file 'filter' entry in topic '" << name
+                           << "' must be a non-empty expression." << std::endl;
+
+            return false;
+        }
+        filter = node["filter"].as<std::string>();
+    }
+
+    const bool first_definition = topic_configs.count(name) == 0;
+
+    const bool valid = add_topic_or_service_config<TopicConfig, TopicRoute>(
+        "topic", name, node, topic_routes, topic_configs,
+        [=](TopicConfig& config, std::string&& type)
+        {
+            Config::logger << utils::Logger::Level::DEBUG
+                           << "Set type '" << type << "' for topic '"
+                           << name << "'." << std::endl;
+
+            config.message_type = std::move(type);
+        },
+        [=](TopicConfig&, std::string&&)
+        {
+        },
+        [=](TopicConfig& config, const TopicRoute& route)
+        {
+            Config::logger << utils::Logger::Level::DEBUG;
+            Config::logger << "Set route '{ from: ";
+
+            for (const auto& _from : route.from)
+            {
+                Config::logger << _from << " ";
+            }
+
+            Config::logger << ", to: ";
+            for (const auto& _to : route.to)
+            {
+                Config::logger << _to << " ";
+            }
+
+            Config::logger << "}' for topic '" << name << "'." << std::endl;
+
+            config.route = route;
+        },
+        [](const YAML::Node& route)
+        {
+            return parse_topic_route(route);
+        });
+
+    if (valid && first_definition)
+    {
+        topic_configs.at(name).filter = filter;
+        topic_configs.at(name).lazy = lazy;
+        topic_configs.at(name).priority = priority;
+    }
+
+    return valid;
+}
+
+//==============================================================================
+bool add_service_config(
+        const std::string& name,
+        const YAML::Node& node,
+        const std::map<std::string, ServiceRoute>& service_routes,
+        std::map<std::string, ServiceConfig>& service_configs)
+{
+    CoalesceConfig coalesce;
+    if (node["coalesce"] && !parse_coalesce_config(node["coalesce"], coalesce))
+    {
+        return false;
+    }
+
+    const bool first_definition = service_configs.count(name) == 0;
+
+    const bool valid = add_topic_or_service_config<ServiceConfig, ServiceRoute>(
+        "service", name, node, service_routes, service_configs,
+        [=](ServiceConfig& config, std::string&& type)
+        {
+            Config::logger << utils::Logger::Level::DEBUG
+                           << "Set request type '" << type
+                           << "' for service '" << name
+                           << "'." << std::endl;
+
+            config.request_type = std::move(type);
+        },
+        [=](ServiceConfig& config, std::string&& type)
+        {
+            Config::logger << utils::Logger::Level::DEBUG
+                           << "Set reply type '" << type
+                           << "' for service '" << name
+                           << "'." << std::endl;
+
+            config.reply_type = std::move(type);
+        },
+        [=](ServiceConfig& config, const ServiceRoute& route)
+        {
+            Config::logger << utils::Logger::Level::DEBUG;
+            Config::logger << "Set route '{ server: " << route.server;
+
+            Config::logger << ", clients: ";
+            for (const auto& _client : route.clients)
+            {
+                Config::logger << _client << " ";
+            }
+
+            Config::logger << "}' for service '" << name << "'." << std::endl;
+
+            config.route = route;
+        },
+        [](const YAML::Node& route)
+        {
+            return parse_service_route(route);
+        });
+
+    if (valid && first_definition)
+    {
+        service_configs.at(name).coalesce = coalesce;
+    }
+    else if (valid && node["coalesce"])
+    {
+        Config::logger << utils::Logger::Level::WARN
+                       << "config-file 'coalesce' entry of service '" << name
+                       << "' is ignored, since only its first definition is used." << std::endl;
+    }
+
+    return valid;
+}
+
+//==============================================================================
+using ReadDictEntry =
+        std::function<bool (const std::string& key, const YAML::Node& value)>;
+
+bool read_dictionary(
+        const YAML::Node& config_node,
+        const std::string& field_name,
+        const std::string& filename,
+        const ReadDictEntry& read_fcn)
+{
+    const YAML::Node& field = config_node[field_name];
+    if (field)
+    {
+        if (!field.IsMap())
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "The config file '" << filename << "' has a '"
+                           << field_name
+                           << "' field, but it is not pointing to a dictionary of "
+                // We use this to make the field name singular
+                           << field_name.substr(0, field_name.size() - 1)
+                           << "configurations!" << std::endl;
+            return false;
+        }
+
+        bool configs_okay = true;
+        for (YAML::const_iterator it = field.begin(); it != field.end(); ++it)
+        {
+            configs_okay &= read_fcn(it->first.as<std::string>(), it->second);
+        }
+
+        if (!configs_okay)
+        {
+            Config::logger << utils::Logger::Level::ERROR
+                           << "Error found in an entry of the '" << field_name
+                           << "' dictionary of the config-file '" << filename << "'"
+                           << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+YAML::Node config_or_empty_node(
+        const std::string& key,
+        const std::map<std::string, YAML::Node>& map)
+{
+    const auto it = map.find(key);
+    if (it == map.end())
+    {
+        return YAML::Node();
+    }
+
+    return it->second;
+}
+
+//==============================================================================
+TopicInfo remap_if_needed(
+        const std::string& middleware,
+        const std::map<std::string, TopicInfo>& remap,
+        const TopicInfo& original)
+{
+    const auto it = remap.find(middleware);
+    if (it == remap.end())
+    {
+        return original;
+    }
+
+    TopicInfo config = original;
+    if (!it->second.name.empty())
+    {
+        config.name = it->second.name;
+    }
+    if (!it->second.type.empty())
+    {
+        config.type = it->second.type;
+    }
+    if (!it->second.reply_type.empty())
+    {
+        config.reply_type = it->second.reply_type;
+    }
+    return config;
+}
+
+/**
+ * @class MeasuredServiceClient
+ *        ServiceClient placed between a service provider and the actual client proxy
+ *        that made the request, so that the outcome and round-trip time of every call
+ *        can be recorded in the route metrics once it completes, before handing the reply back.
+ *
+ *        If the route bounds its pending calls, they are also kept in a PendingCalls
+ *        table, which abandons the calls that time out.
+ */
+class MeasuredServiceClient : public ServiceClient
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] metrics The metrics of the service route.
+     *
+     * @param[in] reply_type The reply type of the client, if replies must be converted
+     *            into it, or `nullptr` if they are handed back as they are.
+     *
+     * @param[in] reply_plan The plan converting the replies into `reply_type`, if any.
+     *            Otherwise, the generic *xtypes* conversion is used.
+     */
+    MeasuredServiceClient(
+            std::shared_ptr<RouteMetrics> metrics,
+            const eprosima::xtypes::DynamicType* reply_type = nullptr,
+            std::shared_ptr<const ConversionPlan> reply_plan = nullptr)
+        : _metrics(std::move(metrics))
+        , _reply_type(reply_type)
+        , _reply_plan(std::move(reply_plan))
+    {
+    }
+
+    /**
+     * @brief Makes the calls of this client pending calls, bounded by the given settings.
+     *
+     * @param[in] name Name of the route leg, for the log messages.
+     *
+     * @param[in] calls The settings of the pending calls.
+     */
+    void bound_calls(
+            const std::string& name,
+            const CallsConfig& calls)
+    {
+        std::shared_ptr<RouteMetrics> metrics = _metrics;
+        _pending_calls = std::make_unique<PendingCalls>(
+            name,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::duration<double>(calls.timeout)),
+            calls.max_in_flight,
+            [metrics](const PendingCalls::Call&)
+            {
+                metrics->dropped();
+            });
+    }
+
+    /**
+     * @brief Wraps the call handle given by the client proxy into the ServiceCall
+     *        handed to the provider, which also remembers the client and the time
+     *        this call was made.
+     *
+     * @returns The ServiceCall, or `nullptr` if the call must be rejected
+     *          because too many calls are pending.
+     */
+    std::shared_ptr<ServiceCall> track(
+            ServiceClient& client,
+            const std::shared_ptr<void>& call_handle) const
+    {
+        std::shared_ptr<void> token;
+        if (_pending_calls)
+        {
+            token = _pending_calls->add(client, call_handle);
+            if (!token)
+            {
+                return nullptr;
+            }
+        }
+
+        return std::make_shared<MeasuredCall>(*this, client, call_handle, std::move(token));
+    }
+
+    void receive_response(
+            std::shared_ptr<void> call_handle,
+            const eprosima::xtypes::DynamicData& response) override
+    {
+        ServiceCall::from(call_handle)->reply(response);
+    }
+
+    void receive_cancellation(
+            std::shared_ptr<void> call_handle) override
+    {
+        ServiceCall::from(call_handle)->cancel();
+    }
+
+private:
+
+    /**
+     * @class MeasuredCall
+     *        ServiceCall whose reply is measured and converted by its route before
+     *        reaching the client.
+     */
+    class MeasuredCall : public ServiceCall
+    {
+    public:
+
+        MeasuredCall(
+                const MeasuredServiceClient& route,
+                ServiceClient& client,
+                std::shared_ptr<void> call_handle,
+                std::shared_ptr<void> token)
+            : ServiceCall(client, std::move(call_handle))
+            , _route(route)
+            , _token(std::move(token))
+        {
+        }
+
+    protected:
+
+        void deliver(
+                const eprosima::xtypes::DynamicData& response) override
+        {
+            _route.deliver(*this, _token, response);
+        }
+
+        void deliver_cancellation() override
+        {
+            _route.deliver_cancellation(*this, _token);
+        }
+
+    private:
+
+        const MeasuredServiceClient& _route;
+        const std::shared_ptr<void> _token;
+    };
+
+    bool still_pending(
+            const std::shared_ptr<void>& token) const
+    {
+        PendingCalls::Call call;
+
+        // Otherwise, the call was already abandoned, and its client notified.
+        return !_pending_calls || _pending_calls->take(token, call);
+    }
+
+    void deliver(
+            ServiceCall& call,
+            const std::shared_ptr<void>& token,
+            const eprosima::xtypes::DynamicData& response) const
+    {
+        if (!still_pending(token))
+        {
+            return;
+        }
+
+        const auto elapsed = std::chrono::steady_clock::now() - call.start();
+        _metrics->sent(true, elapsed);
+        _metrics->replied(elapsed);
+
+        if (!_reply_type)
+        {
+            call.client().receive_response(call.handle(), response);
+        }
+        else if (_reply_plan)
+        {
+            call.client().receive_response(call.handle(), _reply_plan->convert(response));
+        }
+        else
+        {
+            call.client().receive_response(
+                call.handle(), eprosima::xtypes::DynamicData(response, *_reply_type));
+        }
+    }
+
+    void deliver_cancellation(
+            ServiceCall& call,
+            const std::shared_ptr<void>& token) const
+    {
+        if (still_pending(token))
+        {
+            _metrics->sent(false, std::chrono::steady_clock::now() - call.start());
+            call.client().receive_cancellation(call.handle());
+        }
+    }
+
+    std::unique_ptr<PendingCalls> _pending_calls;
+    std::shared_ptr<RouteMetrics> _metrics;
+    const eprosima::xtypes::DynamicType* _reply_type;
+    std::shared_ptr<const ConversionPlan> _reply_plan;
+};
+
+//==============================================================================
+bool same_nodes(
+        const std::map<std::string, YAML::Node>& a,
+        const std::map<std::string, YAML::Node>& b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+                   [](const auto& x, const auto& y)
+                   {
+                       return x.first == y.first && YAML::Dump(x.second) == YAML::Dump(y.second);
+                   });
+}
+
+//==============================================================================
+bool same_remaps(
+        const std::map<std::string, TopicInfo>& a,
+        const std::map<std::string, TopicInfo>& b)
+{
+    return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(),
+                   [](const auto& x, const auto& y)
+                   {
+                       return x.first == y.first && x.second.name == y.second.name
+                       && x.second.type == y.second.type && x.second.reply_type == y.second.reply_type
+                       && x.second.project == y.second.project;
+                   });
+}
+
+//==============================================================================
+bool same_topic(
+        const TopicConfig& a,
+        const TopicConfig& b)
+{
+    return a.message_type == b.message_type
+           && a.route.from == b.route.from && a.route.to == b.route.to
+           && a.route.dispatch.queue_depth == b.route.dispatch.queue_depth
+           && a.route.dispatch.policy == b.route.dispatch.policy
+           && a.route.rate.max_rate == b.route.rate.max_rate
+           && a.route.rate.burst == b.route.rate.burst
+           && a.route.rate.latest_only == b.route.rate.latest_only
+           && a.route.aggregate.max_samples == b.route.aggregate.max_samples
+           && a.route.aggregate.max_bytes == b.route.aggregate.max_bytes
+           && a.route.aggregate.max_delay == b.route.aggregate.max_delay
+           && a.route.aggregate.compression == b.route.aggregate.compression
+           && a.route.deaggregate == b.route.deaggregate
+           && a.route.dedup.key == b.route.dedup.key
+           && a.route.dedup.window == b.route.dedup.window
+           && a.route.dedup.capacity == b.route.dedup.capacity
+           && a.route_name == b.route_name && a.filter == b.filter
+           && a.lazy == b.lazy && a.priority == b.priority
+           && same_remaps(a.remap, b.remap) && same_nodes(a.middleware_configs, b.middleware_configs);
+}
+
+//==============================================================================
+bool same_service(
+        const ServiceConfig& a,
+        const ServiceConfig& b)
+{
+    return a.request_type == b.request_type && a.reply_type == b.reply_type
+           && a.route.clients == b.route.clients && a.route.server == b.route.server
+           && a.route.calls.timeout == b.route.calls.timeout
+           && a.route.calls.max_in_flight == b.route.calls.max_in_flight
+           && a.route_name == b.route_name
+           && a.coalesce.enabled == b.coalesce.enabled && a.coalesce.reply_ttl == b.coalesce.reply_ttl
+           && a.coalesce.max_waiters == b.coalesce.max_waiters
+           && same_remaps(a.remap, b.remap) && same_nodes(a.middleware_configs, b.middleware_configs);
+}
+
+/**
+ * @class ResourcesTracker
+ *        Records, when destroyed, the callbacks stored for a topic or service
+ *        since it was created, as the resources of that topic or service.
+ */
+class ResourcesTracker
+{
+public:
+
+    ResourcesTracker(
+            RouteResources* resources,
+            Config::SubscriptionCallbacks* subscriptions,
+            Config::RawSubscriptionCallbacks* raw_subscriptions,
+            Config::RequestCallbacks* requests)
+        : _resources(resources)
+        , _subscriptions(subscriptions)
+        , _raw_subscriptions(raw_subscriptions)
+        , _requests(requests)
+        , _first_subscription(subscriptions ? subscriptions->size() : 0)
+        , _first_raw_subscription(raw_subscriptions ? raw_subscriptions->size() : 0)
+        , _first_request(requests ? requests->size() : 0)
+    {
+    }
+
+    ~ResourcesTracker()
+    {
+        if (!_resources)
+        {
+            return;
+        }
+
+        for (std::size_t i = _first_subscription; _subscriptions && i < _subscriptions->size(); ++i)
+        {
+            _resources->subscriptions.push_back((*_subscriptions)[i].get());
+        }
+        for (std::size_t i = _first_raw_subscription; _raw_subscriptions && i < _raw_subscriptions->size(); ++i)
+        {
+            _resources->raw_subscriptions.push_back((*_raw_subscriptions)[i].get());
+        }
+        for (std::size_t i = _first_request; _requests && i < _requests->size(); ++i)
+        {
+            _resources->requests.push_back((*_requests)[i].get());
+        }
+    }
+
+private:
+
+    RouteResources* _resources;
+    Config::SubscriptionCallbacks* _subscriptions;
+    Config::RawSubscriptionCallbacks* _raw_subscriptions;
+    Config::RequestCallbacks* _requests;
+    const std::size_t _first_subscription;
+    const std::size_t _first_raw_subscription;
+    const std::size_t _first_request;
+};
+
+//==============================================================================
+uint64_t next_origin_tag()
+{
+    /**
+     * A random base keeps the tags of different processes apart, with high probability only,
+     * since internal messages might come back through other bridges; the counter keeps
+     * apart those of this process.
+     * Consecutive tags are spread by an odd constant, so the sequence never repeats.
+     */
+    static const uint64_t base = []()
+            {
+                std::random_device device;
+                return (uint64_t(device()) << 32) ^ uint64_t(device());
+            }();
+    static std::atomic<uint64_t> counter(0);
+
+    const uint64_t tag = base + (counter.fetch_add(1) + 1) * 0x9E3779B97F4A7C15ull;
+    return tag != 0 ? tag : next_origin_tag();
+}
+
+} //  anonymous namespace
+
+//==============================================================================
+utils::Logger Config::logger("is::core::Config");
+
+//==============================================================================
+Config::Config(
+        const YAML::Node& node,
+        const std::string& filename)
+{
+    if (node && !node.IsNull())
+    {
+        parse(node, filename);
+    }
+}
+
+//==============================================================================
+Config Config::from_file(
+        const std::string& file)
+{
+    YAML::Node config_node;
+    try
+    {
+        config_node = YAML::LoadFile(file);
+    }
+    catch (const std::exception& e)
+    {
+        logger << utils::Logger::Level::ERROR
+               << "Could not parse the config-file named '" << file
+               << "': " << e.what() << std::endl;
+        return Config();
+    }
+
+    if (!config_node)
+    {
+        logger << utils::Logger::Level::ERROR
+               << "Could not parse the config-file '" << file
+               << "'" << std::endl;
+        return Config();
+    }
+
+    return Config(config_node, file);
+}
+
+//==============================================================================
+bool Config::parse(
+        const YAML::Node& config_node,
+        const std::string& file)
+{
+    _okay = false;
+
+    /**
+     * YAML formatting checks for Integration Service configuration.
+     */
+    if (!config_node.IsMap())
+    {
+        logger << utils::Logger::Level::ERROR
+               << "The config-file '" << file << "' needs to be a map "
+               << "containing 'systems', and possibly 'routes', 'topics', "
+               << "and/or 'services'!" << std::endl;
+        return false;
+    }
+
+    const YAML::Node& systems = config_node["systems"];
+    if (!systems || !systems.IsMap())
+    {
+        logger << utils::Logger::Level::ERROR
+               << "The config-file '" << file << "' is missing a "
+               << "dictionary for 'systems'! You must specify at least two "
+               << "systems in your config-file." << std::endl;
+        return false;
+    }
+
+    /**
+     * Iterates through systems and retrieves their 'type' (ros2, ros1, dds, websocket...)
+     * and the `types-from` attribute, if applicable.
+     */
+    for (YAML::const_iterator it = systems.begin(); it != systems.end(); ++it)
+    {
+        const std::string middleware_alias = it->first.as<std::string>();
+
+        const YAML::Node& config = it->second;
+
+        const YAML::Node& type_node = config["type"];
+        const std::string middleware = type_node ?
+                type_node.as<std::string>() : middleware_alias;
+
+        const YAML::Node& types_from_node = config["types-from"];
+        std::vector<std::string> types_from;
+
+        if (types_from_node)
+        {
+            if (types_from_node.IsSequence())
+            {
+                for (const YAML::Node& types : types_from_node)
+                {
+                    types_from.push_back(types.as<std::string>());
+                }
+            }
+            else
+            {
+                types_from.push_back(types_from_node.as<std::string>());
+            }
+        }
+
+        ThreadConfig thread;
+        if (!parse_thread_config(middleware_alias, config, thread))
+        {
+            return false;
+        }
+
+        const YAML::Node& shared_node = config["shared"];
+        const bool shared = shared_node && shared_node.as<bool>();
+
+        _m_middlewares.insert(
+            std::make_pair(
+                middleware_alias, MiddlewareConfig{middleware, types_from, config, thread, shared}));
+    }
+
+    if (_m_middlewares.size() < 2)
+    {
+        logger << utils::Logger::Level::ERROR
+               << "The config-file '" << file << "' does not specify enough "
+               << "middlewares '" << _m_middlewares.size() << "'! The "
+               << "minimum is 2." << std::endl;
+        return false;
+    }
+
+    /**
+     * Retrieves the route metrics settings from the optional `metrics` section.
+     */
+    const YAML::Node& metrics_node = config_node["metrics"];
+    if (metrics_node && !parse_metrics_config(metrics_node, _m_metrics_config))
+    {
+        return false;
+    }
+
+    /**
+     * Retrieves the message tracing settings from the optional `tracing` section.
+     */
+    const YAML::Node& tracing_node = config_node["tracing"];
+    if (tracing_node && !parse_tracing_config(tracing_node, _m_tracing_config))
+    {
+        return false;
+    }
+
+    /**
+     * Retrieves the traffic recording settings from the optional `recording` section.
+     */
+    const YAML::Node& recording_node = config_node["recording"];
+    if (recording_node && !parse_recording_config(recording_node, _m_recording_config))
+    {
+        return false;
+    }
+
+    /**
+     * Retrieves types from the `types` section and adds them to the _m_types database.
+     */
+    {
+        StartupProfile::Scope profile("phase", "parse types");
+        if (!add_types(config_node, file, _m_types, _m_type_leases))
+        {
+            return false;
+        }
+    }
+
+    /**
+     * Retrieves routes from the `routes` section and adds them to the _m_topic_routes
+     * or the _m_service_routes database accordingly.
+     */
+    auto read_route =
+            [&](const std::string& key, const YAML::Node& node) -> bool
+            {
+                return add_named_route(key, node, _m_topic_routes, _m_service_routes);
+            };
+
+    if (!read_dictionary(config_node, "routes", file, read_route))
+    {
+        return false;
+    }
+
+    /**
+     * Retrieves topics from the `topics` section and adds them to the _m_topic_configs database.
+     */
+    auto read_topic =
+            [&](const std::string& key, const YAML::Node& node) -> bool
+            {
+                return add_topic_config(key, node, _m_topic_routes, _m_topic_configs);
+            };
+
+    if (!read_dictionary(config_node, "topics", file, read_topic))
+    {
+        return false;
+    }
+
+    /**
+     * Retrieves services from the `services` section and adds them to the _m_service_configs database.
+     */
+    auto read_service =
+            [&](const std::string& key, const YAML::Node& node) -> bool
+            {
+                return add_service_config(key, node, _m_service_routes, _m_service_configs);
+            };
+
+    if (!read_dictionary(config_node, "services", file, read_service))
+    {
+        return false;
+    }
+
+    /**
+     * Checks topics configuration.
+     */
+    for (const auto& [topic_name, topic_config] : _m_topic_configs)
+    {
+        /**
+         * Checks that the route associated to the topic is correct, in terms of
+         * the middlewares it connects being present in the `systems` section.
+         *
+         * The type will be added to the RequiredTypes map only if no remapping
+         * attributes are being set for this middleware.
+         */
+        const std::set<std::string>& middlewares = topic_config.route.all();
+
+        for (const std::string& mw : middlewares)
+        {
+            if (_m_middlewares.find(mw) == _m_middlewares.end())
+            {
+                logger << utils::Logger::Level::ERROR
+                       << "Unrecognized system '" << mw << "' requested for topic '"
+                       << topic_name << "'." << std::endl;
+                return false;
+            }
+
+            auto it_mw_remap = topic_config.remap.find(mw);
+            if (it_mw_remap == topic_config.remap.end() || it_mw_remap->second.type.empty())
+            {
+                _m_required_types[mw].messages.insert(topic_config.message_type);
+            }
+        }
+
+        /**
+         * Also, checks that the remapping attributes are correctly defined, that is,
+         * remapping can only be done to one of the systems specified in the route.
+         */
+        for (auto&& [mw_name, topic_info] : topic_config.remap)
+        {
+            if (_m_middlewares.find(mw_name) == _m_middlewares.end())
+            {
+                logger << utils::Logger::Level::ERROR
+                       << "Unrecognized system '" << mw_name
+                       << "' requested for remapping topic "
+                       << "'" << topic_name << "'" << std::endl;
+                return false;
+            }
+
+            if (!topic_info.type.empty())
+            {
+                _m_required_types[mw_name].messages.insert(topic_info.type);
+            }
+        }
+    }
+
+    /**
+     * Check services configuration.
+     */
+    for (const auto& [service_name, service_config] : _m_service_configs)
+    {
+        /**
+         * Checks that the route associated to the service is correct, in terms of
+         * the middlewares it connects being present in the `systems` section.
+         *
+         * The type will be added to the RequiredTypes map only if no remapping
+         * attributes are being set for this middleware.
+         */
+        const std::set<std::string>& middlewares = service_config.route.all();
+        for (const std::string& mw : middlewares)
+        {
+            if (_m_middlewares.find(mw) == _m_middlewares.end())
+            {
+                logger << utils::Logger::Level::ERROR
+                       << "Unrecognized system '" << mw << "' requested for service "
+                       << "'" << service_name << "'" << std::endl;
+                return false;
+            }
+
+            auto it_mw_remap = service_config.remap.find(mw);
+            if ((it_mw_remap == service_config.remap.end() || it_mw_remap->second.type == "") &&
+                    service_config.request_type != "")
+            {
+                _m_required_types[mw].services.insert(service_config.request_type);
+            }
+            if ((it_mw_remap == service_config.remap.end() || it_mw_remap->second.reply_type == "") &&
+                    service_config.reply_type != "")
+            {
+                _m_required_types[mw].services.insert(service_config.reply_type);
+            }
+        }
+
+        /**
+         * Also, checks that the remapping attributes are correctly defined, that is,
+         * remapping can only be done to one of the systems specified in the route.
+         */
+        for (auto&& [mw_name, service_info] : service_config.remap)
+        {
+            if (_m_middlewares.find(mw_name) == _m_middlewares.end())
+            {
+                logger << utils::Logger::Level::ERROR
+                       << "Unrecognized system '" << mw_name << "' requested for remapping service "
+                       << "'" << service_name << "'" << std::endl;
+                return false;
+            }
+            _m_required_types[mw_name].services.insert(service_info.type);
+            if (!service_info.reply_type.empty())
+            {
+                _m_required_types[mw_name].services.insert(service_info.reply_type);
+            }
+        }
+    }
+
+    /**
+     * Checks for defined but unused middlewares. Also, checks that at least two are being used.
+     */
+    std::size_t active_mw_count = 0;
+    for (const auto& [mw_name, mw_config] : _m_middlewares)
+    {
+        const auto it = _m_required_types.find(mw_name);
+        if (it == _m_required_types.end())
+        {
+            logger << utils::Logger::Level::WARN
+                   << "The middleware '" << mw_name << "' of type '"
+                   << mw_config.type << "' is not being used in any topics "
+                   << "or services" << std::endl;
+        }
+        else
+        {
+            ++active_mw_count;
+        }
+    }
+
+    if (active_mw_count < 2)
+    {
+        logger << utils::Logger::Level::ERROR
+               << "Fewer than 2 middlewares (" << active_mw_count << ") are "
+               << "being used in this current configuration! This means that "
+               << "running Integration Service will not be useful." << std::endl;
+        return false;
+    }
+
+    _okay = true;
+    return true;
+}
+
+//==============================================================================
+bool Config::okay() const
+{
+    return _okay;
+}
+
+//==============================================================================
+Config::operator bool() const
+{
+    return _okay;
+}
+
+//==============================================================================
+bool Config::load_middlewares(
+        is::internal::SystemHandleInfoMap& info_map) const
+{
+    /**
+     * Builds the dependency graph given by the `types-from` tags: a middleware
+     * must be configured after every middleware it takes types from.
+     * Kahn's algorithm gives a valid loading order, and detects dependency cycles.
+     */
+    std::map<std::string, std::size_t> pending_dependencies;
+    std::map<std::string, std::vector<std::string> > dependents;
+
+    for (const auto& [mw_name, mw_config] : _m_middlewares)
+    {
+        pending_dependencies.emplace(mw_name, 0);
+        for (const std::string& mw_from : mw_config.types_from)
+        {
+            if (_m_middlewares.count(mw_from) == 0)
+            {
+                logger << utils::Logger::Level::ERROR
+                       << "'types-from' of middleware '" << mw_name
+                       << "' references to a non-existent middleware: '"
+                       << mw_from << "'." << std::endl;
+
+                return false;
+            }
+
+            ++pending_dependencies[mw_name];
+            dependents[mw_from].push_back(mw_name);
+        }
+    }
+
+    std::vector<std::string> order;
+    for (const auto& [mw_name, count] : pending_dependencies)
     {
-        if (!field.IsMap())
+        if (count == 0)
         {
-            Config::logger << utils::Logger::Level::ERROR
-                           << "The config file '" << filename << "' has a '"
-                           << field_name
-                           << "' field, but it is not pointing to a dictionary of "
-                // We use this to make the field name singular
-                           << field_name.substr(0, field_name.size() - 1)
-                           << "configurations!" << std::endl;
-            return false;
+            order.push_back(mw_name);
         }
+    }
 
-        bool configs_okay = true;
-        for (YAML::const_iterator it = field.begin(); it != field.end(); ++it)
+    for (std::size_t i = 0; i < order.size(); ++i)
+    {
+        for (const std::string& dependent : dependents[order[i]])
         {
-            configs_okay &= read_fcn(it->first.as<std::string>(), it->second);
+            if (--pending_dependencies[dependent] == 0)
+            {
+                order.push_back(dependent);
+            }
         }
+    }
 
-        if (!configs_okay)
+    if (order.size() != _m_middlewares.size())
+    {
+        logger << utils::Logger::Level::ERROR
+               << "The 'types-from' tags of the following middlewares form a dependency cycle:";
+        for (const auto& [mw_name, count] : pending_dependencies)
         {
-            Config::logger << utils::Logger::Level::ERROR
-                           << "Error found in an entry of the '" << field_name
-                           << "' dictionary of the config-file '" << filename << "'"
-                           << std::endl;
-            return false;
+            if (count > 0)
+            {
+                logger << " '" << mw_name << "'";
+            }
         }
-    }
+        logger << std::endl;
 
-    return true;
-}
+        return false;
+    }
 
-//==============================================================================
-YAML::Node config_or_empty_node(
-        const std::string& key,
-        const std::map<std::string, YAML::Node>& map)
-{
-    const auto it = map.find(key);
-    if (it == map.end())
+    /**
+     * Every middleware is loaded in its own thread, as soon as the middlewares it takes
+     * types from are ready, so that independent SystemHandles are created and configured
+     * concurrently. SystemHandles of the same middleware type are never created or
+     * configured at the same time, since their libraries might share some global state.
+     */
+    std::map<std::string, std::unique_ptr<is::internal::SystemHandleInfo> > loaded;
+    std::map<std::string, std::mutex> type_mutexes;
+    for (const auto& [mw_name, mw_config] : _m_middlewares)
     {
-        return YAML::Node();
+        loaded[mw_name];
+        type_mutexes[mw_config.type];
     }
 
-    return it->second;
-}
-
-//==============================================================================
-TopicInfo remap_if_needed(
-        const std::string& middleware,
-        const std::map<std::string, TopicInfo>& remap,
-        const TopicInfo& original)
-{
-    const auto it = remap.find(middleware);
-    if (it == remap.end())
+    std::map<std::string, std::shared_future<bool> > ready;
+    for (const std::string& mw_name : order)
     {
-        return original;
+        std::vector<std::shared_future<bool> > dependency_futures;
+        for (const std::string& mw_from : _m_middlewares.at(mw_name).types_from)
+        {
+            dependency_futures.push_back(ready.at(mw_from));
+        }
+
+        ready[mw_name] = std::async(std::launch::async,
+                        [this, &loaded, &type_mutexes, dependency_futures, mw_name]() -> bool
+                        {
+                            const MiddlewareConfig& mw_config = _m_middlewares.at(mw_name);
+
+                            bool dependencies_ready = true;
+                            for (const std::shared_future<bool>& dependency : dependency_futures)
+                            {
+                                dependencies_ready &= dependency.get();
+                            }
+
+                            if (!dependencies_ready)
+                            {
+                                logger << utils::Logger::Level::ERROR
+                                       << "The middleware '" << mw_name << "' cannot be loaded, "
+                                       << "because some of its 'types-from' middlewares failed."
+                                       << std::endl;
+
+                                return false;
+                            }
+
+                            std::map<std::string, const is::internal::SystemHandleInfo*> dependencies;
+                            for (const std::string& mw_from : mw_config.types_from)
+                            {
+                                dependencies[mw_from] = loaded.at(mw_from).get();
+                            }
+
+                            auto load = [&]()
+                                    {
+                                        return load_middleware(
+                                            mw_name, mw_config, dependencies, type_mutexes.at(mw_config.type));
+                                    };
+
+                            /**
+                             * Shared middlewares reuse the SystemHandle of another instance in this
+                             * process, if it was configured in the same way and with the required types.
+                             */
+                            std::set<std::string> required_types;
+                            const auto requirements = _m_required_types.find(mw_name);
+                            if (requirements != _m_required_types.end())
+                            {
+                                required_types.insert(
+                                    requirements->second.messages.begin(), requirements->second.messages.end());
+                                required_types.insert(
+                                    requirements->second.services.begin(), requirements->second.services.end());
+                            }
+
+                            is::internal::SystemHandleInfo info = mw_config.shared
+                                    ? SystemHandleRegistry::global().acquire(
+                                SystemHandleRegistry::key(mw_config.type, mw_config.config_node),
+                                required_types, load)
+                                    : load();
+
+                            if (!info)
+                            {
+                                return false;
+                            }
+
+                            loaded.at(mw_name).reset(new is::internal::SystemHandleInfo(std::move(info)));
+                            return true;
+                        }).share();
     }
 
-    TopicInfo config = original;
-    if (!it->second.name.empty())
+    /**
+     * Waits for every middleware, even after a failure, since their threads use local state.
+     */
+    bool success = true;
+    for (const std::string& mw_name : order)
     {
-        config.name = it->second.name;
+        success &= ready.at(mw_name).get();
     }
-    if (!it->second.type.empty())
+
+    if (!success)
     {
-        config.type = it->second.type;
+        return false;
     }
-    if (!it->second.reply_type.empty())
+
+    /**
+     * If every middleware was correctly configured, they are inserted within the info_map.
+     */
+    for (auto& [mw_name, info] : loaded)
     {
-        config.reply_type = it->second.reply_type;
+        info_map.insert(std::make_pair(mw_name, std::move(*info)));
     }
-    return config;
-}
-
-} //  anonymous namespace
 
-//==============================================================================
-utils::Logger Config::logger("is::core::Config");
+    return true;
+}
 
 //==============================================================================
-Config::Config(
-        const YAML::Node& node,
-        const std::string& filename)
+is::internal::SystemHandleInfo Config::load_middleware(
+        const std::string& mw_name,
+        const MiddlewareConfig& mw_config,
+        const std::map<std::string, const is::internal::SystemHandleInfo*>& dependencies,
+        std::mutex& type_mutex) const
 {
-    if (node && !node.IsNull())
+    const std::string& middleware_type = mw_config.type;
+
+    logger << utils::Logger::Level::DEBUG
+           << "Config::load_middlewares: looking for middleware '" << mw_name
+           << "' with type '" << middleware_type << "'" << std::endl;
+
+    /**
+     * SystemHandles linked into the executable, such as those of a static bundle, are
+     * registered before main() runs, so neither their .mix file nor their library are needed.
+     */
+    const bool linked = is::internal::Register::contains(middleware_type);
+    if (linked)
     {
-        parse(node, filename);
+        logger << utils::Logger::Level::DEBUG
+               << "Config::load_middlewares: the SystemHandle of middleware '" << middleware_type
+               << "' is already registered, skipping the search of its .mix file" << std::endl;
     }
-}
 
-//==============================================================================
-Config Config::from_file(
-        const std::string& file)
-{
-    YAML::Node config_node;
-    try
+    /**
+     * Otherwise, looks for the middleware's SystemHandle dynamic library.
+     */
+    std::vector<std::string> checked_paths;
+    std::string path;
+    if (!linked)
     {
-        config_node = YAML::LoadFile(file);
+        StartupProfile::Scope profile("middleware", mw_name + " (search .mix)");
+        const Search search(mw_config.type);
+        path = search.find_middleware_mix(&checked_paths);
     }
-    catch (const std::exception& e)
+
+    if (!linked && path.empty())
     {
         logger << utils::Logger::Level::ERROR
-               << "Could not parse the config-file named '" << file
-               << "': " << e.what() << std::endl;
-        return Config();
+               << "Unable to find .mix file for middleware '" << middleware_type << "'. "
+               << "The following locations were checked unsuccessfully: \n";
+
+        for (const std::string& checked_path : checked_paths)
+        {
+            logger << "\n\t- " << checked_path;
+        }
+
+        logger << "\nTry adding your middleware's install path to IS_PREFIX_PATH "
+               << "or IS_" << Search::to_env_format(middleware_type) << "_PREFIX_PATH "
+               << "environment variables." << std::endl;
+
+        return is::internal::SystemHandleInfo(nullptr);
     }
 
-    if (!config_node)
+    bool loaded = true;
+    if (!linked)
     {
-        logger << utils::Logger::Level::ERROR
-               << "Could not parse the config-file '" << file
-               << "'" << std::endl;
-        return Config();
+        StartupProfile::Scope profile("middleware", mw_name + " (load libraries)");
+        loaded = Mix::from_file(path).load();
     }
 
-    return Config(config_node, file);
-}
+    if (!loaded)
+    {
+        logger << utils::Logger::Level::ERROR
+               << "Unable to load the dynamic libraries present in the .mix file '"
+               << path << "'." << std::endl;
 
-//==============================================================================
-bool Config::parse(
-        const YAML::Node& config_node,
-        const std::string& file)
-{
-    _okay = false;
+        return is::internal::SystemHandleInfo(nullptr);
+    }
 
     /**
-     * YAML formatting checks for Integration Service configuration.
+     * After loading the mix file, the middleware's SystemHandle library should be
+     * loaded, and it should be possible to find the middleware info in the
+     * internal Register.
      */
-    if (!config_node.IsMap())
-    {
-        logger << utils::Logger::Level::ERROR
-               << "The config-file '" << file << "' needs to be a map "
-               << "containing 'systems', and possibly 'routes', 'topics', "
-               << "and/or 'services'!" << std::endl;
-        return false;
-    }
+    std::unique_lock<std::mutex> lock(type_mutex);
+    is::internal::SystemHandleInfo info = is::internal::Register::get(middleware_type);
 
-    const YAML::Node& systems = config_node["systems"];
-    if (!systems || !systems.IsMap())
+    if (!info)
     {
-        logger << utils::Logger::Level::ERROR
-               << "The config-file '" << file << "' is missing a "
-               << "dictionary for 'systems'! You must specify at least two "
-               << "systems in your config-file." << std::endl;
-        return false;
+        return is::internal::SystemHandleInfo(nullptr);
     }
 
+    bool configured = true;
+
     /**
-     * Iterates through systems and retrieves their 'type' (ros2, ros1, dds, websocket...)
-     * and the `types-from` attribute, if applicable.
+     * Now, it iterates the middleware required types map.
+     * For each middleware, it checks which types it needs, and places them into
+     * the SystemHandleInfo structure.
      */
-    for (YAML::const_iterator it = systems.begin(); it != systems.end(); ++it)
+    const auto requirements = _m_required_types.find(mw_name);
+
+    if (requirements != _m_required_types.end())
     {
-        const std::string middleware_alias = it->first.as<std::string>();
+        /**
+         * Adds topics message types into the type registry, avoiding to insert duplicates.
+         */
+        for (const std::string& required_type : requirements->second.messages)
+        {
+            auto type_it = TypeTable::find_type(_m_types, required_type);
 
-        const YAML::Node& config = it->second;
+            if (type_it != _m_types.end())
+            {
+                info.types.emplace(required_type, type_it->second);
+            }
+        }
 
-        const YAML::Node& type_node = config["type"];
-        const std::string middleware = type_node ?
-                type_node.as<std::string>() : middleware_alias;
+        /**
+         * Adds service types into the type registry, avoiding to insert duplicates.
+         */
+        for (const std::string& required_type : requirements->second.services)
+        {
+            auto type_it = TypeTable::find_type(_m_types, required_type);
 
-        const YAML::Node& types_from_node = config["types-from"];
-        std::vector<std::string> types_from;
+            if (type_it != _m_types.end())
+            {
+                info.types.emplace(required_type, type_it->second);
+            }
+        }
 
-        if (types_from_node)
+        /**
+         * Checks here the `types-from` attribute for this middleware.
+         * If it exists, it will contain a list of the middlewares it wants to
+         * import the types from.
+         *
+         * Check that this middleware already exists in the
+         * is::internal::SystemHandleInfoMap, and iterate over its types to copy them into the
+         * target middleware, that is, `mw_name`.
+         */
+        if (!mw_config.types_from.empty())
         {
-            if (types_from_node.IsSequence())
+            for (const std::string& mw_from : mw_config.types_from)
             {
-                for (const YAML::Node& types : types_from_node)
+                const auto it = dependencies.find(mw_from);
+                if (it == dependencies.end())
                 {
-                    types_from.push_back(types.as<std::string>());
+                    logger << utils::Logger::Level::ERROR
+                           << "'types-from' references to a non-existent middleware: '"
+                           << mw_from << "'. Maybe it has not been registered yet?"
+                           << std::endl;
+
+                    return is::internal::SystemHandleInfo(nullptr);
+                }
+
+                for (auto&& it_type : it->second->types)
+                {
+                    info.types.emplace(it_type.second->name(), it_type.second);
                 }
             }
-            else
+
+            /**
+             * Now that we have added types from the `types-from` tag, the
+             * SystemHandleInfo struct for this middleware (mw_name) should be complete.
+             *
+             * Therefore, iterating through its required_types and checking that every
+             * type exists in the SystemHandleInfo::TypeRegistry should be ok. Otherwise,
+             * it warns and returns false.
+             */
+            for (const std::string& required_type : requirements->second.messages)
             {
-                types_from.push_back(types_from_node.as<std::string>());
+                if (!info.types.count(required_type))
+                {
+                    logger << utils::Logger::Level::ERROR
+                           << "The middleware '" << mw_name
+                           << "' must satisfy the required topic type '"
+                           << required_type << "', but it does not seem to be "
+                           << "available neither in its type registry or inherited "
+                           << "from its 'types-from' reference middlewares" << std::endl;
+
+                    return is::internal::SystemHandleInfo(nullptr);
+                }
+            }
+
+            for (const std::string& required_type : requirements->second.services)
+            {
+                if (!info.types.count(required_type))
+                {
+                    logger << utils::Logger::Level::ERROR
+                           << "The middleware '" << mw_name
+                           << "' must satisfy the required service type '"
+                           << required_type << "', but it does not seem to be "
+                           << "available neither in its type registry or inherited "
+                           << "from its 'types-from' reference middlewares" << std::endl;
+
+                    return is::internal::SystemHandleInfo(nullptr);
+                }
             }
         }
 
-        _m_middlewares.insert(
-            std::make_pair(
-                middleware_alias, MiddlewareConfig{middleware, types_from, config}));
+        /**
+         * Finally, now that the SystemHandleInfo struct is filled with all its types, it
+         * calls to the SystemHandle::configure override function for the selected middleware.
+         */
+        StartupProfile::Scope profile("middleware", mw_name + " (configure)");
+        configured = info.handle->configure(
+            requirements->second, mw_config.config_node, info.types);
     }
 
-    if (_m_middlewares.size() < 2)
+    if (!configured)
     {
-        logger << utils::Logger::Level::ERROR
-               << "The config-file '" << file << "' does not specify enough "
-               << "middlewares '" << _m_middlewares.size() << "'! The "
-               << "minimum is 2." << std::endl;
-        return false;
+        return is::internal::SystemHandleInfo(nullptr);
     }
 
     /**
-     * Retrieves types from the `types` section and adds them to the _m_types database.
+     * SystemHandles that tag the origin of their messages let the routing callbacks
+     * recognize their internal messages by comparing tags.
      */
-    if (!add_types(config_node, file, _m_types))
+    OriginTaggingSystem* origin_tagging = dynamic_cast<OriginTaggingSystem*>(info.handle.get());
+    if (info.topic_subscriber && origin_tagging)
     {
-        return false;
+        const uint64_t tag = next_origin_tag();
+        if (origin_tagging->accept_origin_tag(tag))
+        {
+            info.origin_tag = tag;
+
+            logger << utils::Logger::Level::DEBUG
+                   << "The middleware '" << mw_name << "' tags the origin of its messages." << std::endl;
+        }
     }
 
-    /**
-     * Retrieves routes from the `routes` section and adds them to the _m_topic_routes
-     * or the _m_service_routes database accordingly.
-     */
-    auto read_route =
-            [&](const std::string& key, const YAML::Node& node) -> bool
-            {
-                return add_named_route(key, node, _m_topic_routes, _m_service_routes);
-            };
+    return info;
+}
 
-    if (!read_dictionary(config_node, "routes", file, read_route))
+//==============================================================================
+void Config::select_shard(
+        std::size_t index,
+        std::size_t count,
+        int metrics_fd)
+{
+    _m_shard_config.index = index;
+    _m_shard_config.count = count;
+    _m_shard_config.metrics_fd = metrics_fd;
+
+    std::size_t position = 0;
+    for (auto it = _m_topic_configs.begin(); it != _m_topic_configs.end(); ++position)
     {
-        return false;
+        it = position % count == index ? std::next(it) : _m_topic_configs.erase(it);
     }
 
-    /**
-     * Retrieves topics from the `topics` section and adds them to the _m_topic_configs database.
-     */
-    auto read_topic =
-            [&](const std::string& key, const YAML::Node& node) -> bool
-            {
-                return add_topic_config(key, node, _m_topic_routes, _m_topic_configs);
-            };
+    for (auto it = _m_service_configs.begin(); it != _m_service_configs.end(); ++position)
+    {
+        it = position % count == index ? std::next(it) : _m_service_configs.erase(it);
+    }
 
-    if (!read_dictionary(config_node, "topics", file, read_topic))
+    if (!_m_recording_config.file.empty())
     {
-        return false;
+        _m_recording_config.file += "." + std::to_string(index);
     }
 
+    logger << utils::Logger::Level::INFO
+           << "Running shard " << index << " of " << count << ": " << _m_topic_configs.size()
+           << " topics and " << _m_service_configs.size() << " services." << std::endl;
+}
+
+//==============================================================================
+bool Config::changes_from(
+        const Config& running,
+        const is::internal::SystemHandleInfoMap& info_map,
+        RouteChanges& changes) const
+{
     /**
-     * Retrieves services from the `services` section and adds them to the _m_service_configs database.
+     * The SystemHandles are kept, so the middlewares must be configured exactly as before.
      */
-    auto read_service =
-            [&](const std::string& key, const YAML::Node& node) -> bool
-            {
-                return add_service_config(key, node, _m_service_routes, _m_service_configs);
-            };
+    bool same_middlewares = _m_middlewares.size() == running._m_middlewares.size();
+    for (const auto& [mw_name, mw_config] : _m_middlewares)
+    {
+        const auto it = running._m_middlewares.find(mw_name);
+        same_middlewares = same_middlewares && it != running._m_middlewares.end()
+                && it->second.type == mw_config.type
+                && it->second.types_from == mw_config.types_from
+                && it->second.shared == mw_config.shared
+                && YAML::Dump(it->second.config_node) == YAML::Dump(mw_config.config_node);
+    }
 
-    if (!read_dictionary(config_node, "services", file, read_service))
+    if (!same_middlewares)
     {
+        logger << utils::Logger::Level::ERROR
+               << "The 'systems' section changed, the configuration cannot be reloaded "
+               << "without restarting." << std::endl;
+
         return false;
     }
 
     /**
-     * Checks topics configuration.
+     * The SystemHandles must already know every type required by the new routes.
      */
-    for (const auto& [topic_name, topic_config] : _m_topic_configs)
+    for (const auto& [mw_name, required_types] : _m_required_types)
     {
-        /**
-         * Checks that the route associated to the topic is correct, in terms of
-         * the middlewares it connects being present in the `systems` section.
-         *
-         * The type will be added to the RequiredTypes map only if no remapping
-         * attributes are being set for this middleware.
-         */
-        const std::set<std::string>& middlewares = topic_config.route.all();
+        const TypeRegistry& known_types = info_map.at(mw_name).types;
 
-        for (const std::string& mw : middlewares)
+        std::set<std::string> type_names = required_types.messages;
+        type_names.insert(required_types.services.begin(), required_types.services.end());
+        for (const std::string& type_name : type_names)
         {
-            if (_m_middlewares.find(mw) == _m_middlewares.end())
-            {
-                logger << utils::Logger::Level::ERROR
-                       << "Unrecognized system '" << mw << "' requested for topic '"
-                       << topic_name << "'." << std::endl;
-                return false;
-            }
-
-            auto it_mw_remap = topic_config.remap.find(mw);
-            if (it_mw_remap == topic_config.remap.end() || it_mw_remap->second.type.empty())
+            /**
+             * The registries of the middlewares keep the names as required, maybe with
+             * a leading `::`, while the configured types are stored without it.
+             */
+            auto known = known_types.find(type_name);
+            if (known == known_types.end())
             {
-                _m_required_types[mw].messages.insert(topic_config.message_type);
+                known = TypeTable::find_type(known_types, type_name);
             }
-        }
-
-        /**
-         * Also, checks that the remapping attributes are correctly defined, that is,
-         * remapping can only be done to one of the systems specified in the route.
-         */
-        for (auto&& [mw_name, topic_info] : topic_config.remap)
-        {
-            if (_m_middlewares.find(mw_name) == _m_middlewares.end())
+            if (known == known_types.end())
             {
                 logger << utils::Logger::Level::ERROR
-                       << "Unrecognized system '" << mw_name
-                       << "' requested for remapping topic "
-                       << "'" << topic_name << "'" << std::endl;
+                       << "The type '" << type_name << "' is not known by the middleware '"
+                       << mw_name << "', the configuration cannot be reloaded without restarting."
+                       << std::endl;
+
                 return false;
             }
 
-            if (!topic_info.type.empty())
+            const auto defined = TypeTable::find_type(_m_types, type_name);
+            if (defined != _m_types.end()
+                    && defined->second->is_compatible(*known->second) != xtypes::TypeConsistency::EQUALS)
             {
-                _m_required_types[mw_name].messages.insert(topic_info.type);
+                logger << utils::Logger::Level::ERROR
+                       << "The definition of the type '" << type_name << "' changed, the "
+                       << "configuration cannot be reloaded without restarting." << std::endl;
+
+                return false;
             }
         }
     }
 
-    /**
-     * Check services configuration.
-     */
-    for (const auto& [service_name, service_config] : _m_service_configs)
+    for (const auto& [topic_name, topic_config] : running._m_topic_configs)
     {
-        /**
-         * Checks that the route associated to the service is correct, in terms of
-         * the middlewares it connects being present in the `systems` section.
-         *
-         * The type will be added to the RequiredTypes map only if no remapping
-         * attributes are being set for this middleware.
-         */
-        const std::set<std::string>& middlewares = service_config.route.all();
-        for (const std::string& mw : middlewares)
+        const auto it = _m_topic_configs.find(topic_name);
+        if (it == _m_topic_configs.end() || !same_topic(topic_config, it->second))
         {
-            if (_m_middlewares.find(mw) == _m_middlewares.end())
-            {
-                logger << utils::Logger::Level::ERROR
-                       << "Unrecognized system '" << mw << "' requested for service "
-                       << "'" << service_name << "'" << std::endl;
-                return false;
-            }
-
-            auto it_mw_remap = service_config.remap.find(mw);
-            if ((it_mw_remap == service_config.remap.end() || it_mw_remap->second.type == "") &&
-                    service_config.request_type != "")
-            {
-                _m_required_types[mw].services.insert(service_config.request_type);
-            }
-            if ((it_mw_remap == service_config.remap.end() || it_mw_remap->second.reply_type == "") &&
-                    service_config.reply_type != "")
-            {
-                _m_required_types[mw].services.insert(service_config.reply_type);
-            }
+            changes.removed_topics.insert(topic_name);
         }
+    }
 
-        /**
-         * Also, checks that the remapping attributes are correctly defined, that is,
-         * remapping can only be done to one of the systems specified in the route.
-         */
-        for (auto&& [mw_name, service_info] : service_config.remap)
+    for (const auto& [topic_name, topic_config] : _m_topic_configs)
+    {
+        const auto it = running._m_topic_configs.find(topic_name);
+        if (it == running._m_topic_configs.end() || !same_topic(topic_config, it->second))
         {
-            if (_m_middlewares.find(mw_name) == _m_middlewares.end())
-            {
-                logger << utils::Logger::Level::ERROR
-                       << "Unrecognized system '" << mw_name << "' requested for remapping service "
-                       << "'" << service_name << "'" << std::endl;
-                return false;
-            }
-            _m_required_types[mw_name].services.insert(service_info.type);
-            if (!service_info.reply_type.empty())
-            {
-                _m_required_types[mw_name].services.insert(service_info.reply_type);
-            }
+            changes.added_topics.insert(topic_name);
         }
     }
 
-    /**
-     * Checks for defined but unused middlewares. Also, checks that at least two are being used.
-     */
-    std::size_t active_mw_count = 0;
-    for (const auto& [mw_name, mw_config] : _m_middlewares)
+    for (const auto& [service_name, service_config] : running._m_service_configs)
     {
-        const auto it = _m_required_types.find(mw_name);
-        if (it == _m_required_types.end())
+        const auto it = _m_service_configs.find(service_name);
+        if (it == _m_service_configs.end() || !same_service(service_config, it->second))
         {
-            logger << utils::Logger::Level::WARN
-                   << "The middleware '" << mw_name << "' of type '"
-                   << mw_config.type << "' is not being used in any topics "
-                   << "or services" << std::endl;
-        }
-        else
-        {
-            ++active_mw_count;
+            changes.removed_services.insert(service_name);
         }
     }
 
-    if (active_mw_count < 2)
+    for (const auto& [service_name, service_config] : _m_service_configs)
     {
-        logger << utils::Logger::Level::ERROR
-               << "Fewer than 2 middlewares (" << active_mw_count << ") are "
-               << "being used in this current configuration! This means that "
-               << "running Integration Service will not be useful." << std::endl;
-        return false;
+        const auto it = running._m_service_configs.find(service_name);
+        if (it == running._m_service_configs.end() || !same_service(service_config, it->second))
+        {
+            changes.added_services.insert(service_name);
+        }
     }
 
-    _okay = true;
     return true;
 }
 
 //==============================================================================
-bool Config::okay() const
+void Config::keep_routes(
+        const std::set<std::string>& topics,
+        const std::set<std::string>& services)
 {
-    return _okay;
+    for (auto it = _m_topic_configs.begin(); it != _m_topic_configs.end();)
+    {
+        it = topics.count(it->first) ? std::next(it) : _m_topic_configs.erase(it);
+    }
+
+    for (auto it = _m_service_configs.begin(); it != _m_service_configs.end();)
+    {
+        it = services.count(it->first) ? std::next(it) : _m_service_configs.erase(it);
+    }
 }
 
 //==============================================================================
-Config::operator bool() const
+const ThreadConfig& Config::thread_config(
+        const std::string& mw_name) const
 {
-    return _okay;
+    static const ThreadConfig default_config;
+
+    const auto it = _m_middlewares.find(mw_name);
+    return it == _m_middlewares.end() ? default_config : it->second.thread;
 }
 
 //==============================================================================
-bool Config::load_middlewares(
-        is::internal::SystemHandleInfoMap& info_map) const
+bool Config::configure_topics(
+        const is::internal::SystemHandleInfoMap& info_map,
+        SubscriptionCallbacks& subscription_callbacks,
+        RawSubscriptionCallbacks& raw_subscription_callbacks,
+        MetricsRegistry& metrics,
+        const std::shared_ptr<Tracer>& tracer,
+        const std::shared_ptr<TrafficRecorder>& recorder,
+        std::map<std::string, RouteResources>* resources,
+        const TaskScheduler& scheduler,
+        PriorityDispatchers* dispatchers) const
 {
+    bool valid = true;
+
+    /**
+     * The compatibility of every pair of types routed by the topics is computed beforehand,
+     * in parallel, so that the checks performed for each topic are plain lookups.
+     * Generated configurations tend to route many topics with a few types.
+     */
+    {
+        StartupProfile::Scope profile("phase", "check topic compatibility");
+
+        std::vector<ConversionCache::Key> pairs;
+        for (const auto& [topic_name, topic_config] : _m_topic_configs)
+        {
+            const TopicInfo topic_info(topic_name, topic_config.message_type);
+            for (const std::string& from : topic_config.route.from)
+            {
+                const auto it_from = info_map.find(from);
+                if (it_from == info_map.end())
+                {
+                    continue;
+                }
+
+                const eprosima::xtypes::DynamicType* from_type = resolve_type(
+                    it_from->second.types, remap_if_needed(from, topic_config.remap, topic_info).type);
+
+                for (const std::string& to : topic_config.route.to)
+                {
+                    const auto it_to = info_map.find(to);
+                    if (it_to == info_map.end())
+                    {
+                        continue;
+                    }
+
+                    const TopicInfo topic_info_to = remap_if_needed(to, topic_config.remap, topic_info);
+                    if (!topic_info_to.project.empty())
+                    {
+                        continue;
+                    }
+
+                    /**
+                     * The compatibility check looks up the source type against the destination one,
+                     * while the conversion from the source into the destination, `get(from, to)`,
+                     * looks up the destination type against the source one.
+                     */
+                    const eprosima::xtypes::DynamicType* to_type =
+                            resolve_type(it_to->second.types, topic_info_to.type);
+                    pairs.emplace_back(from_type, to_type);
+                    pairs.emplace_back(to_type, from_type);
+                }
+            }
+        }
+
+        _m_conversion_cache->precompute(pairs);
+    }
+
+    /**
+     * Priority dispatchers of the destination middlewares, created for the first
+     * prioritized topic routed to each of them.
+     */
+    PriorityDispatchers local_dispatchers;
+    PriorityDispatchers& middleware_dispatchers = dispatchers ? *dispatchers : local_dispatchers;
+
     /**
-     * Sorts middlewares according to their dependencies in the `types-from` department.
-     * Middlewares specified in a `types-from` tag must be configured first.
+     * Iterates through the topics section of the provided configuration.
      */
-    using Entry = std::map<std::string, MiddlewareConfig>::value_type;
+    for (const auto& [topic_name, topic_config] : _m_topic_configs)
+    {
+        StartupProfile::Scope profile("topic", topic_name);
 
-    std::list<Entry> middlewares(_m_middlewares.begin(), _m_middlewares.end());
+        RouteResources* route_resources = resources ? &(*resources)[topic_name] : nullptr;
+        const ResourcesTracker tracker(
+            route_resources, &subscription_callbacks, &raw_subscription_callbacks, nullptr);
+        const std::shared_ptr<std::atomic_bool> retired = route_resources
+                ? route_resources->retired
+                : std::make_shared<std::atomic_bool>(false);
 
-    middlewares.sort(
-        [](const Entry& a, const Entry& b) -> bool
+        /**
+         * First, it checks topic compatibility in terms of the registered types
+         * in the source and destination endpoints.
+         */
+        if (!check_topic_compatibility(info_map, topic_name, topic_config))
         {
-            auto& from = b.second.types_from;
-            return std::find(from.begin(), from.end(), a.first) != from.end();
-        });
+            valid = false;
+            continue;
+        }
+
+        /**
+         * Helper struct to store an Integration Service publisher,
+         * the middleware that produced it and its published DynamicType.
+         */
+        struct PublisherData
+        {
+            PublisherData(
+                    const std::string& m_middleware,
+                    std::shared_ptr<TopicPublisher> m_publisher,
+                    const eprosima::xtypes::DynamicType& m_type,
+                    const std::vector<std::string>& m_project)
+                : middleware(m_middleware)
+                , publisher(m_publisher)
+                , type(m_type)
+                , project(m_project)
+            {
+            }
+
+            std::string middleware;
+            std::shared_ptr<TopicPublisher> publisher;
+            const eprosima::xtypes::DynamicType& type;
+            std::vector<std::string> project;
+        };
+
+        std::vector<PublisherData> publishers;
+        publishers.reserve(topic_config.route.to.size());
+
+        for (const std::string& to : topic_config.route.to)
+        {
+            /**
+             * The `to` endpoint within the route tells the related system that
+             * its SystemHandle must produce a publisher, so that the final application
+             * can subscribe to it and receive the information as described in the route
+             * data flow. Therefore, this middleware must have publishing capabilities,
+             * that is, its SystemHandleInfo::TopicPublisherSystem pointer must not be NULL.
+             */
+            const auto it_to = info_map.find(to);
+            if (it_to == info_map.end() || !it_to->second.topic_publisher)
+            {
+                logger << utils::Logger::Level::ERROR
+                       << "Could not find topic publishing capabilities for system "
+                       << "named '" << to << "', requested for topic '"
+                       << topic_name << "'." << std::endl;
+
+                valid = false;
+                continue;
+            }
+
+            /**
+             * Does remapping and type resolution, if applicable.
+             */
+            TopicInfo topic_info = remap_if_needed(
+                to, topic_config.remap, TopicInfo(topic_name, topic_config.message_type));
+
+            const eprosima::xtypes::DynamicType* pub_type = resolve_type(
+                it_to->second.types, topic_info.type);
+
+            /**
+             * Advertises the TopicPublisher using the TopicPublisherSystem provided
+             * by the "to" middleware's SystemHandle. Aggregated routes publish
+             * frames of samples instead of the samples themselves.
+             */
+            const bool aggregated = topic_config.route.aggregate.max_samples > 0;
+            const eprosima::xtypes::DynamicType& advertised_type =
+                    aggregated
+                    ? SampleAggregator::frame_type()
+                    : topic_info.type.find(".") == std::string::npos
+                    ? *pub_type
+                    : *TypeTable::type_at(_m_types, topic_info.type.substr(0, topic_info.type.find(".")));
+
+            std::shared_ptr<TopicPublisher> publisher;
+
+            /**
+             * Topic names computed from the messages, such as `dynamic/{message.data}`, are
+             * published through a DynamicTopicPublisher, which advertises each computed name
+             * once and keeps a bounded number of them.
+             */
+            if (!aggregated && topic_info.name.find("{message.") != std::string::npos)
+            {
+                TopicPublisherSystem* publisher_system = it_to->second.topic_publisher;
+                const YAML::Node publisher_config = config_or_empty_node(to, topic_config.middleware_configs);
+                try
+                {
+                    publisher = std::make_shared<DynamicTopicPublisher>(
+                        topic_info.name, advertised_type, dynamic_topic_publishers,
+                        [publisher_system, &advertised_type, publisher_config](const std::string& name)
+                        {
+                            return publisher_system->advertise(name, advertised_type, publisher_config);
+                        });
+                }
+                catch (const UnavailableMessageField& e)
+                {
+                    logger << utils::Logger::Level::ERROR
+                           << "The topic name '" << topic_info.name << "' of the system '" << to
+                           << "' does not fit the message type '" << topic_config.message_type
+                           << "': " << e.what() << std::endl;
+                }
+            }
+            else
+            {
+                publisher = it_to->second.topic_publisher->advertise(
+                    topic_info.name, advertised_type, config_or_empty_node(to, topic_config.middleware_configs));
+            }
 
-    /**
-     * Iterates through the sorted middlewares list, to load them in the appropriate order.
-     */
-    for (const auto& [mw_name, mw_config] : middlewares)
-    {
-        const std::string& middleware_type = mw_config.type;
+            if (!publisher)
+            {
+                logger << utils::Logger::Level::ERROR
+                       << "The system '" << to << "' failed to produce a publisher "
+                       << "for the topic '" << topic_name << "' and message type '"
+                       << topic_config.message_type << "'." << std::endl;
 
-        logger << utils::Logger::Level::DEBUG
-               << "Config::load_middlewares: looking for middleware '" << mw_name
-               << "' with type '" << middleware_type << "'" << std::endl;
+                valid = false;
+            }
+            else
+            {
+                logger << utils::Logger::Level::INFO
+                       << "[" << to << " SystemHandle] Produced a publisher "
+                       << "for the topic '" << topic_name << "', with message type '"
+                       << topic_config.message_type << "'." << std::endl;
 
-        const Search search(mw_config.type);
+                publishers.emplace_back(PublisherData(to, publisher, *pub_type, topic_info.project));
+            }
+        }
 
         /**
-         * Looks for the middleware's SystemHandle dynamic library.
+         * Lazy topics only keep their subscriptions while some remote endpoint is listening
+         * to any of their publishers. Publishers that do not report their matched endpoints
+         * are considered to be always listened to.
          */
-        std::vector<std::string> checked_paths;
-        const std::string path = search.find_middleware_mix(&checked_paths);
-
-        if (path.empty())
+        std::shared_ptr<LazySubscription> lazy;
+        if (topic_config.lazy)
         {
-            logger << utils::Logger::Level::ERROR
-                   << "Unable to find .mix file for middleware '" << middleware_type << "'. "
-                   << "The following locations were checked unsuccessfully: \n";
-
-            for (const std::string& checked_path : checked_paths)
+            lazy = std::make_shared<LazySubscription>(topic_name, scheduler);
+            for (const PublisherData& pub : publishers)
             {
-                logger << "\n\t- " << checked_path;
-            }
-
-            logger << "\nTry adding your middleware's install path to IS_PREFIX_PATH "
-                   << "or IS_" << Search::to_env_format(middleware_type) << "_PREFIX_PATH "
-                   << "environment variables." << std::endl;
-
-            return false;
-        }
+                LazySubscription::MatchCallback match = lazy->watch();
+                if (!pub.publisher->set_match_callback(match))
+                {
+                    logger << utils::Logger::Level::WARN
+                           << "[" << pub.middleware << " SystemHandle] The publisher of the lazy topic '"
+                           << topic_name << "' does not report its matched endpoints, so it is "
+                           << "considered to be always listened to." << std::endl;
 
-        if (!Mix::from_file(path).load())
-        {
-            logger << utils::Logger::Level::ERROR
-                   << "Unable to load the dynamic libraries present in the .mix file '"
-                   << path << "'." << std::endl;
+                    match(1);
+                }
+            }
 
-            return false;
+            if (route_resources)
+            {
+                route_resources->unsubscribe.push_back(
+                    [lazy]()
+                    {
+                        return lazy->cancel();
+                    });
+            }
         }
 
         /**
-         * After loading the mix file, the middleware's SystemHandle library should be
-         * loaded, and it should be possible to find the middleware info in the
-         * internal Register.
+         * Deduplicated routes share one deduplicator among the subscriptions of all
+         * their sources, so that each sample is routed once, whichever source delivers
+         * it first, and the copies delivered by the other sources are discarded.
          */
-        is::internal::SystemHandleInfo info = is::internal::Register::get(middleware_type);
-
-        if (!info)
+        std::shared_ptr<SampleDeduplicator> deduplicator;
+        if (topic_config.route.dedup.window > 0.0)
         {
-            return false;
+            deduplicator = std::make_shared<SampleDeduplicator>(
+                topic_name, topic_config.route.dedup.window, topic_config.route.dedup.capacity);
         }
 
-        bool configured = true;
-
         /**
-         * Now, it iterates the middleware required types map.
-         * For each middleware, it checks which types it needs, and places them into
-         * the SystemHandleInfo structure.
+         * Rate limited routes share the token bucket of each destination among the
+         * subscriptions of all their sources, so that the destination never gets more
+         * than the maximum rate, however many sources the route has.
          */
-        const auto requirements = _m_required_types.find(mw_name);
+        std::map<std::string, std::shared_ptr<RateLimiter> > limiters;
 
-        if (requirements != _m_required_types.end())
+        /**
+         * For each `from` attribute in the route, the corresponding SystemHandle
+         * must produce a subscriber that fetches the data from the user's source
+         * application and convert it to the common language representation, that is,
+         * `eprosima::xtypes::DynamicData`.
+         * Then, this subscriber callback will take care of publishing the data
+         * in each one of the TopicPublishers defined in the `to` middleware list.
+         */
+        for (const std::string& from : topic_config.route.from)
         {
             /**
-             * Adds topics message types into the type registry, avoiding to insert duplicates.
+             * First, it checks the subscribing capabilities of the middleware's SystemHandle.
              */
-            for (const std::string& required_type : requirements->second.messages)
+            const auto it_from = info_map.find(from);
+            if (it_from == info_map.end() || !it_from->second.topic_subscriber)
             {
-                auto type_it = _m_types.find(required_type);
+                logger << utils::Logger::Level::ERROR
+                       << "Could not find topic subscribing capabilities for system "
+                       << "named '" << from << "', requested for topic '"
+                       << topic_name << "'." << std::endl;
+                valid = false;
+                continue;
+            }
+
+            /**
+             * Does remapping and type resolution, if applicable.
+             */
+            TopicInfo topic_info = remap_if_needed(
+                from, topic_config.remap, TopicInfo(topic_name, topic_config.message_type));
+
+            const eprosima::xtypes::DynamicType* sub_type = resolve_type(
+                it_from->second.types, topic_info.type);
 
-                if (type_it != _m_types.end())
+            /**
+             * The content filter of the topic, if any, is compiled once against the type
+             * received from this middleware, and discards messages before any conversion.
+             */
+            std::shared_ptr<const MessageFilter> filter;
+            if (!topic_config.filter.empty())
+            {
+                filter = MessageFilter::compile(topic_config.filter, *sub_type);
+                if (!filter)
                 {
-                    info.types.emplace(*type_it);
+                    logger << utils::Logger::Level::ERROR
+                           << "The filter of the topic '" << topic_name << "' is not valid "
+                           << "for the type '" << sub_type->name() << "' received from '"
+                           << from << "'." << std::endl;
+
+                    valid = false;
+                    continue;
                 }
             }
 
             /**
-             * Adds service types into the type registry, avoiding to insert duplicates.
+             * The key identifying the samples of a deduplicated route is resolved against
+             * the type received from each middleware, since their members may be laid out
+             * differently. Its DataHash does not depend on the type, so the copies match.
              */
-            for (const std::string& required_type : requirements->second.services)
+            SampleDeduplicator::Key dedup_key;
+            if (deduplicator)
             {
-                auto type_it = _m_types.find(required_type);
-
-                if (type_it != _m_types.end())
+                std::string error;
+                if (!SampleDeduplicator::resolve(*sub_type, topic_config.route.dedup.key, dedup_key, error))
                 {
-                    info.types.emplace(*type_it);
+                    logger << utils::Logger::Level::ERROR
+                           << "The deduplication key '" << topic_config.route.dedup.key << "' of the topic '"
+                           << topic_name << "' is not valid for the type '" << sub_type->name()
+                           << "' received from '" << from << "': " << error << "." << std::endl;
+
+                    valid = false;
+                    continue;
                 }
             }
 
             /**
-             * Checks here the `types-from` attribute for this middleware.
-             * If it exists, it will contain a list of the middlewares it wants to
-             * import the types from.
-             *
-             * Check that this middleware already exists in the
-             * is::internal::SystemHandleInfoMap, and iterate over its types to copy them into the
-             * target middleware, that is, `mw_name`.
+             * Helper struct to store the Integration Service publishers that share
+             * the same published DynamicType. It includes the type consistency parameter
+             * between that publisher type and the current subscriber type and, if they
+             * are not equal, the precompiled plan used to convert each message from the
+             * subscriber type into the publisher one. This way, each sample is converted
+             * once per distinct published type, no matter how many destinations it has.
              */
-            if (!mw_config.types_from.empty())
+            struct Publication
             {
-                for (const std::string& mw_from : mw_config.types_from)
+                struct Destination
                 {
-                    const auto it = info_map.find(mw_from);
-                    if (it == info_map.end())
-                    {
-                        logger << utils::Logger::Level::ERROR
-                               << "'types-from' references to a non-existent middleware: '"
-                               << mw_from << "'. Maybe it has not been registered yet?"
-                               << std::endl;
+                    std::shared_ptr<TopicPublisher> publisher;
+                    bool shared;
+                    bool batched;
+                    std::shared_ptr<DispatchQueue> queue;
+                    std::shared_ptr<PriorityDispatcher> dispatcher;
+                    std::size_t lane;
+                    std::shared_ptr<RateLimiter> limiter;
+                    RateLimiter::Consumer forward;
+                    std::shared_ptr<SampleAggregator> aggregator;
+                    std::shared_ptr<RouteMetrics> metrics;
+                };
 
-                        return false;
-                    }
+                Publication(
+                        const PublisherData& publisher_data,
+                        const ConversionCache::Entry& conversion,
+                        std::shared_ptr<DispatchQueue> queue,
+                        std::shared_ptr<PriorityDispatcher> dispatcher,
+                        std::size_t lane,
+                        std::shared_ptr<RateLimiter> limiter,
+                        RateLimiter::Consumer forward,
+                        std::shared_ptr<SampleAggregator> aggregator,
+                        std::shared_ptr<RouteMetrics> metrics)
+                    : type(publisher_data.type)
+                    , consistency(conversion.consistency)
+                    , plan(conversion.plan)
+                    , project(publisher_data.project)
+                    , pool(std::make_shared<DynamicDataPool>(publisher_data.type))
+                    , shared(false)
+                {
+                    /**
+                     * The idle instances of the pool are accounted to the first destination,
+                     * since every destination with the same type shares them.
+                     */
+                    metrics->add_memory_probe([weak_pool = std::weak_ptr<DynamicDataPool>(pool)](
+                                RouteMetricsSnapshot& snapshot)
+                            {
+                                if (std::shared_ptr<DynamicDataPool> data_pool = weak_pool.lock())
+                                {
+                                    snapshot.retained_bytes += data_pool->idle() * data_pool->type().memory_size();
+                                }
+                            });
 
-                    for (auto&& it_type : info_map.at(mw_from).types)
-                    {
-                        info.types.emplace(it_type.second->name(), it_type.second);
-                    }
+                    add(publisher_data.publisher, std::move(queue), std::move(dispatcher), lane,
+                            std::move(limiter), std::move(forward), std::move(aggregator), std::move(metrics));
+                }
+
+                /**
+                 * Aggregated destinations encode each message into their frame,
+                 * so they never need the shared message.
+                 */
+                void add(
+                        const std::shared_ptr<TopicPublisher>& publisher,
+                        std::shared_ptr<DispatchQueue> queue,
+                        std::shared_ptr<PriorityDispatcher> dispatcher,
+                        std::size_t lane,
+                        std::shared_ptr<RateLimiter> limiter,
+                        RateLimiter::Consumer forward,
+                        std::shared_ptr<SampleAggregator> aggregator,
+                        std::shared_ptr<RouteMetrics> metrics)
+                {
+                    const bool batched = !queue && !dispatcher && !limiter && !aggregator
+                            && publisher->prefers_batches();
+                    const bool prefers_shared = !aggregator && (publisher->prefers_shared_messages()
+                            || queue || dispatcher || limiter || batched);
+                    destinations.push_back(
+                        Destination{publisher, prefers_shared, batched, std::move(queue),
+                                    std::move(dispatcher), lane, std::move(limiter), std::move(forward),
+                                    std::move(aggregator), std::move(metrics)});
+                    shared |= prefers_shared;
                 }
 
                 /**
-                 * Now that we have added types from the `types-from` tag, the
-                 * SystemHandleInfo struct for this middleware (mw_name) should be complete.
-                 *
-                 * Therefore, iterating through its required_types and checking that every
-                 * type exists in the SystemHandleInfo::TypeRegistry should be ok. Otherwise,
-                 * it warns and returns false.
+                 * Publishes the message over every destination, or offers it to the rate
+                 * limiter of the destination, or queues it for the destinations with
+                 * asynchronous or prioritized dispatching, or adds it to the batch open on this thread
+                 * for the destinations that prefer batches. The shared message is only
+                 * materialized, once, if some destination needs it. If the message is
+                 * traced, the time taken by each destination is added to its trace.
                  */
-                for (const std::string& required_type : requirements->second.messages)
+                void publish(
+                        const eprosima::xtypes::DynamicData& message,
+                        std::shared_ptr<const eprosima::xtypes::DynamicData>& shared_message,
+                        Tracer::Trace* trace) const
                 {
-                    if (!info.types.count(required_type))
+                    /**
+                     * The message was converted once for every destination, so, like the idle
+                     * instances of the pool, the conversion is accounted to the first one.
+                     */
+                    if (consistency != eprosima::xtypes::TypeConsistency::EQUALS && !destinations.empty())
                     {
-                        logger << utils::Logger::Level::ERROR
-                               << "The middleware '" << mw_name
-                               << "' must satisfy the required topic type '"
-                               << required_type << "', but it does not seem to be "
-                               << "available neither in its type registry or inherited "
-                               << "from its 'types-from' reference middlewares" << std::endl;
+                        destinations.front().metrics->converted();
+                    }
+
+                    for (const Destination& destination : destinations)
+                    {
+                        const Tracer::Clock::time_point start =
+                                trace ? Tracer::Clock::now() : Tracer::Clock::time_point();
+                        auto traced = [&](const char* stage, bool success)
+                                {
+                                    if (trace)
+                                    {
+                                        trace->add(std::string(stage) + " " + destination.metrics->destination(),
+                                                start, success);
+                                    }
+                                };
+
+                        destination.metrics->received();
+
+                        if (destination.shared && !shared_message)
+                        {
+                            std::shared_ptr<eprosima::xtypes::DynamicData> pooled = pool->acquire();
+                            *pooled = message;
+                            shared_message = std::move(pooled);
+                        }
+
+                        if (destination.aggregator)
+                        {
+                            const bool aggregated = destination.aggregator->offer(message);
+                            if (!aggregated)
+                            {
+                                destination.metrics->dropped();
+                            }
+                            traced("aggregate", aggregated);
+                            continue;
+                        }
+
+                        if (destination.limiter)
+                        {
+                            const bool offered = destination.limiter->offer(shared_message, destination.forward);
+                            if (!offered)
+                            {
+                                destination.metrics->dropped();
+                            }
+                            traced("rate limit", offered);
+                            continue;
+                        }
+
+                        if (destination.queue)
+                        {
+                            /**
+                             * A message evicted to make room for this one is dropped all the same.
+                             */
+                            const DispatchQueue::PushResult pushed = destination.queue->push(shared_message);
+                            if (pushed != DispatchQueue::PushResult::QUEUED)
+                            {
+                                destination.metrics->dropped();
+                            }
+                            traced("queue", pushed != DispatchQueue::PushResult::DROPPED);
+                            continue;
+                        }
+
+                        if (destination.dispatcher)
+                        {
+                            const DispatchQueue::PushResult pushed =
+                                    destination.dispatcher->push(destination.lane, shared_message);
+                            if (pushed != DispatchQueue::PushResult::QUEUED)
+                            {
+                                destination.metrics->dropped();
+                            }
+                            traced("priority lane", pushed != DispatchQueue::PushResult::DROPPED);
+                            continue;
+                        }
 
-                        return false;
+                        if (destination.batched
+                                && PublishBatch::add(destination.publisher, shared_message, destination.metrics))
+                        {
+                            traced("batch", true);
+                            continue;
+                        }
+
+                        const auto publish_start = std::chrono::steady_clock::now();
+                        const bool published = destination.shared
+                                ? destination.publisher->publish_shared(shared_message)
+                                : destination.publisher->publish(message);
+                        destination.metrics->sent(published, std::chrono::steady_clock::now() - publish_start);
+                        traced("publish", published);
                     }
                 }
 
-                for (const std::string& required_type : requirements->second.services)
+                const eprosima::xtypes::DynamicType& type;
+                eprosima::xtypes::TypeConsistency consistency;
+                std::shared_ptr<const ConversionPlan> plan;
+                std::vector<std::string> project;
+                std::shared_ptr<DynamicDataPool> pool;
+                std::vector<Destination> destinations;
+                bool shared;
+            };
+
+            std::vector<Publication> publications;
+            publications.reserve(publishers.size());
+
+            for (const auto& pub : publishers)
+            {
+                std::shared_ptr<RouteMetrics> route_metrics = metrics.add(
+                    "topic", topic_name, topic_config.route_name, from, pub.middleware);
+
+                if (std::shared_ptr<DynamicTopicPublisher> dynamic_publisher =
+                        std::dynamic_pointer_cast<DynamicTopicPublisher>(pub.publisher))
+                {
+                    route_metrics->add_memory_probe(
+                        [weak_publisher = std::weak_ptr<DynamicTopicPublisher>(dynamic_publisher)](
+                            RouteMetricsSnapshot& snapshot)
+                        {
+                            if (std::shared_ptr<DynamicTopicPublisher> publisher = weak_publisher.lock())
+                            {
+                                const PublisherCache::Stats stats = publisher->cache().stats();
+                                snapshot.dynamic_publishers += stats.size;
+                                snapshot.publisher_evictions += stats.evictions;
+                            }
+                        });
+                }
+
+                /**
+                 * If the route asks for asynchronous dispatching, each destination
+                 * gets its own bounded queue and worker, so that a slow destination
+                 * does not stall the rest of them.
+                 */
+                std::shared_ptr<TopicPublisher> publisher = pub.publisher;
+                auto publish = [publisher, route_metrics](
+                    const std::shared_ptr<const eprosima::xtypes::DynamicData>& message)
+                        {
+                            const auto start = std::chrono::steady_clock::now();
+                            const bool published = publisher->publish_shared(message);
+                            route_metrics->sent(published, std::chrono::steady_clock::now() - start);
+                        };
+
+                std::shared_ptr<DispatchQueue> queue;
+                if (topic_config.route.dispatch.queue_depth > 0 && topic_config.priority < 0)
+                {
+                    queue = std::make_shared<DispatchQueue>(
+                        from + " -> " + pub.middleware + " (" + topic_name + ")",
+                        topic_config.route.dispatch.queue_depth,
+                        topic_config.route.dispatch.policy,
+                        publish);
+                }
+
+                /**
+                 * Prioritized topics get a lane in the dispatcher of their destination middleware,
+                 * shared by every prioritized topic routed to it, instead of a queue of their own.
+                 * This way, messages of latency-critical topics never wait behind bulk ones.
+                 */
+                std::shared_ptr<PriorityDispatcher> dispatcher;
+                std::size_t lane = 0;
+                if (topic_config.priority >= 0)
                 {
-                    if (!info.types.count(required_type))
+                    std::shared_ptr<PriorityDispatcher>& middleware_dispatcher =
+                            middleware_dispatchers[pub.middleware];
+                    if (!middleware_dispatcher)
                     {
-                        logger << utils::Logger::Level::ERROR
-                               << "The middleware '" << mw_name
-                               << "' must satisfy the required service type '"
-                               << required_type << "', but it does not seem to be "
-                               << "available neither in its type registry or inherited "
-                               << "from its 'types-from' reference middlewares" << std::endl;
+                        middleware_dispatcher = std::make_shared<PriorityDispatcher>(pub.middleware);
+                    }
 
-                        return false;
+                    dispatcher = middleware_dispatcher;
+                    lane = dispatcher->add_lane(
+                        topic_config.priority,
+                        topic_config.route.dispatch.queue_depth > 0
+                        ? topic_config.route.dispatch.queue_depth
+                        : default_priority_lane_depth,
+                        topic_config.route.dispatch.policy,
+                        publish);
+
+                    // The dispatcher outlives the route, which releases its lane when taken down.
+                    if (route_resources)
+                    {
+                        route_resources->release.push_back(
+                            [dispatcher, lane]()
+                            {
+                                dispatcher->remove_lane(lane);
+                            });
                     }
                 }
-            }
-
-            /**
-             * Finally, now that the SystemHandleInfo struct is filled with all its types, it
-             * calls to the SystemHandle::configure override function for the selected middleware.
-             */
-            configured = info.handle->configure(
-                requirements->second, mw_config.config_node, info.types);
-        }
 
-        /**
-         * If the middleware was correctly configured, it inserts it within the info_map.
-         */
-        if (configured)
-        {
-            info_map.insert(std::make_pair(mw_name, std::move(info)));
-        }
-        else
-        {
-            return false;
-        }
-    }
+                /**
+                 * Publishes a message taken from the rate limiter or the sample aggregator
+                 * of the destination, through its queue or priority lane, if any.
+                 */
+                auto forward = [publish, queue, dispatcher, lane, route_metrics](
+                    const std::shared_ptr<const eprosima::xtypes::DynamicData>& message)
+                        {
+                            if (queue || dispatcher)
+                            {
+                                const DispatchQueue::PushResult pushed =
+                                        queue ? queue->push(message) : dispatcher->push(lane, message);
+                                if (pushed != DispatchQueue::PushResult::QUEUED)
+                                {
+                                    route_metrics->dropped();
+                                }
+                                return;
+                            }
 
-    return true;
-}
+                            publish(message);
+                        };
 
-//==============================================================================
-bool Config::configure_topics(
-        const is::internal::SystemHandleInfoMap& info_map,
-        SubscriptionCallbacks& subscription_callbacks) const
-{
-    bool valid = true;
+                /**
+                 * If the route limits the rate of its destinations, each destination gets a
+                 * token bucket shared by all the sources, placed before its queue, if any,
+                 * so that the excess samples are shed by the bridge instead of filling the
+                 * queues of the middlewares. Each source offers its samples along with its
+                 * own way of forwarding them. The messages kept aside in *latest only* mode
+                 * are released by the tasks of the scheduler.
+                 */
+                std::shared_ptr<RateLimiter> limiter;
+                bool new_limiter = false;
+                if (topic_config.route.rate.max_rate > 0.0)
+                {
+                    std::shared_ptr<RateLimiter>& destination_limiter = limiters[pub.middleware];
+                    if (!destination_limiter)
+                    {
+                        destination_limiter = std::make_shared<RateLimiter>(
+                            topic_name + " -> " + pub.middleware,
+                            topic_config.route.rate.max_rate,
+                            topic_config.route.rate.burst,
+                            topic_config.route.rate.latest_only,
+                            scheduler);
+                        new_limiter = true;
+                    }
+                    limiter = destination_limiter;
+                }
 
-    /**
-     * Iterates through the topics section of the provided configuration.
-     */
-    for (const auto& [topic_name, topic_config] : _m_topic_configs)
-    {
-        /**
-         * First, it checks topic compatibility in terms of the registered types
-         * in the source and destination endpoints.
-         */
-        if (!check_topic_compatibility(info_map, topic_name, topic_config))
-        {
-            valid = false;
-            continue;
-        }
+                /**
+                 * Aggregated routes collect the samples of each destination into frames,
+                 * which are published instead of the samples, through the queue or
+                 * priority lane of the destination, if any. Its metrics count the
+                 * received samples, and the published frames.
+                 */
+                std::shared_ptr<SampleAggregator> aggregator;
+                if (topic_config.route.aggregate.max_samples > 0)
+                {
+                    aggregator = std::make_shared<SampleAggregator>(
+                        from + " -> " + pub.middleware + " (" + topic_name + ")",
+                        topic_config.route.aggregate.max_samples,
+                        topic_config.route.aggregate.max_bytes,
+                        topic_config.route.aggregate.max_delay,
+                        topic_config.route.aggregate.compression,
+                        forward);
+                }
 
-        /**
-         * Helper struct to store an Integration Service publisher
-         * and its published DynamicType.
-         */
-        struct PublisherData
-        {
-            PublisherData(
-                    std::shared_ptr<TopicPublisher> m_publisher,
-                    const eprosima::xtypes::DynamicType& m_type)
-                : publisher(m_publisher)
-                , type(m_type)
-            {
-            }
+                /**
+                 * The messages waiting in the queue, lane, limiter or aggregator of the destination
+                 * are measured when its metrics are taken. The probe does not keep them alive,
+                 * since the metrics outlive the route when it is removed by a reload.
+                 * The limiter shared by the sources is only measured by the first one.
+                 */
+                route_metrics->add_memory_probe(
+                    [weak_queue = std::weak_ptr<DispatchQueue>(queue),
+                    weak_dispatcher = std::weak_ptr<PriorityDispatcher>(dispatcher), lane,
+                    weak_limiter = new_limiter ? std::weak_ptr<RateLimiter>(limiter) : std::weak_ptr<RateLimiter>(),
+                    weak_aggregator = std::weak_ptr<SampleAggregator>(aggregator)](
+                        RouteMetricsSnapshot& snapshot)
+                    {
+                        if (std::shared_ptr<DispatchQueue> dispatch_queue = weak_queue.lock())
+                        {
+                            snapshot.queued_messages += dispatch_queue->size();
+                            snapshot.queued_bytes += dispatch_queue->bytes();
+                        }
+                        if (std::shared_ptr<PriorityDispatcher> priority_dispatcher = weak_dispatcher.lock())
+                        {
+                            snapshot.queued_messages += priority_dispatcher->lane_size(lane);
+                            snapshot.queued_bytes += priority_dispatcher->lane_bytes(lane);
+                        }
+                        if (std::shared_ptr<RateLimiter> rate_limiter = weak_limiter.lock())
+                        {
+                            snapshot.queued_messages += rate_limiter->size();
+                            snapshot.queued_bytes += rate_limiter->bytes();
+                        }
+                        if (std::shared_ptr<SampleAggregator> sample_aggregator = weak_aggregator.lock())
+                        {
+                            snapshot.queued_messages += sample_aggregator->size();
+                            snapshot.queued_bytes += sample_aggregator->bytes();
+                            snapshot.retained_bytes += sample_aggregator->retained();
+                        }
+                    });
+
+                auto same_type = std::find_if(publications.begin(), publications.end(),
+                                [&](const Publication& publication)
+                                {
+                                    return publication.project == pub.project
+                                    && (&publication.type == &pub.type
+                                    || _m_conversion_cache->consistency(publication.type, pub.type)
+                                    == eprosima::xtypes::TypeConsistency::EQUALS);
+                                });
 
-            std::shared_ptr<TopicPublisher> publisher;
-            const eprosima::xtypes::DynamicType& type;
-        };
+                if (same_type != publications.end())
+                {
+                    same_type->add(pub.publisher, std::move(queue), std::move(dispatcher), lane,
+                            std::move(limiter), forward, std::move(aggregator), std::move(route_metrics));
+                    continue;
+                }
 
-        std::vector<PublisherData> publishers;
-        publishers.reserve(topic_config.route.to.size());
+                /**
+                 * Projected destinations get a plan that only extracts the listed members,
+                 * instead of the plan converting the whole message, shared through the cache.
+                 * Its validity was already checked by `check_topic_compatibility`.
+                 */
+                ConversionCache::Entry conversion;
+                if (pub.project.empty())
+                {
+                    conversion = _m_conversion_cache->get(*sub_type, pub.type);
+                }
+                else
+                {
+                    std::string error;
+                    conversion.plan = ConversionPlan::project(*sub_type, pub.type, pub.project, error);
+                    if (!conversion.plan)
+                    {
+                        logger << utils::Logger::Level::ERROR
+                               << "The projection of topic '" << topic_name << "' into '"
+                               << pub.middleware << "' is not valid: " << error << std::endl;
 
-        for (const std::string& to : topic_config.route.to)
-        {
-            /**
-             * The `to` endpoint within the route tells the related system that
-             * its SystemHandle must produce a publisher, so that the final application
-             * can subscribe to it and receive the information as described in the route
-             * data flow. Therefore, this middleware must have publishing capabilities,
-             * that is, its SystemHandleInfo::TopicPublisherSystem pointer must not be NULL.
-             */
-            const auto it_to = info_map.find(to);
-            if (it_to == info_map.end() || !it_to->second.topic_publisher)
-            {
-                logger << utils::Logger::Level::ERROR
-                       << "Could not find topic publishing capabilities for system "
-                       << "named '" << to << "', requested for topic '"
-                       << topic_name << "'." << std::endl;
+                        valid = false;
+                        continue;
+                    }
+                    conversion.consistency = conversion.plan->consistency();
+                }
 
-                valid = false;
-                continue;
-            }
+                publications.emplace_back(
+                    Publication(pub, conversion,
+                    std::move(queue), std::move(dispatcher), lane, std::move(limiter), forward,
+                    std::move(aggregator), std::move(route_metrics)));
 
-            /**
-             * Does remapping and type resolution, if applicable.
-             */
-            TopicInfo topic_info = remap_if_needed(
-                to, topic_config.remap, TopicInfo(topic_name, topic_config.message_type));
+                if (publications.back().consistency != eprosima::xtypes::TypeConsistency::EQUALS
+                        && !publications.back().plan)
+                {
+                    logger << utils::Logger::Level::DEBUG
+                           << "No conversion plan could be compiled from type '" << sub_type->name()
+                           << "' to type '" << pub.type.name() << "' for topic '" << topic_name
+                           << "'. The generic conversion will be used for each message." << std::endl;
+                }
+            }
 
-            const eprosima::xtypes::DynamicType* pub_type = resolve_type(
-                it_to->second.types, topic_info.type);
+            TopicSubscriberSystem* topic_subscriber_system = it_from->second.topic_subscriber;
+            const uint64_t origin_tag = it_from->second.origin_tag;
 
             /**
-             * Advertises the TopicPublisher using the TopicPublisherSystem provided
-             * by the "to" middleware's SystemHandle.
+             * If the source middleware and every destination exchange the same wire format,
+             * and the published types are equal to the subscribed one, the route forwards
+             * the serialized payloads as they are, without any DynamicData in between,
+             * unless some setting of the topic needs the DynamicData, as told by
+             * TopicConfig::needs_decoded_data(). Neither are they while recording,
+             * since the recorded samples are DynamicData.
              */
-            std::shared_ptr<TopicPublisher> publisher =
-                    it_to->second.topic_publisher->advertise(topic_info.name,
-                            (topic_info.type.find(".") == std::string::npos
-                            ? *pub_type
-                            : *_m_types.at(topic_info.type.substr(0, topic_info.type.find(".")))),
-                            config_or_empty_node(to, topic_config.middleware_configs));
+            const std::string raw_encoding = topic_subscriber_system->raw_encoding();
+            bool raw = !raw_encoding.empty() && !publications.empty() && !recorder
+                    && !topic_config.needs_decoded_data();
 
-            if (!publisher)
+            for (const Publication& publication : publications)
             {
-                logger << utils::Logger::Level::ERROR
-                       << "The system '" << to << "' failed to produce a publisher "
-                       << "for the topic '" << topic_name << "' and message type '"
-                       << topic_config.message_type << "'." << std::endl;
-
-                valid = false;
+                raw &= publication.consistency == eprosima::xtypes::TypeConsistency::EQUALS;
+                for (const Publication::Destination& destination : publication.destinations)
+                {
+                    raw &= destination.publisher->raw_encoding() == raw_encoding;
+                }
             }
-            else
+
+            if (raw)
             {
-                logger << utils::Logger::Level::INFO
-                       << "[" << to << " SystemHandle] Produced a publisher "
-                       << "for the topic '" << topic_name << "', with message type '"
-                       << topic_config.message_type << "'." << std::endl;
+                std::vector<Publication::Destination> raw_destinations;
+                for (const Publication& publication : publications)
+                {
+                    raw_destinations.insert(raw_destinations.end(),
+                            publication.destinations.begin(), publication.destinations.end());
+                }
 
-                publishers.emplace_back(PublisherData(publisher, *pub_type));
-            }
-        }
+                const std::string raw_topic = topic_name;
 
-        /**
-         * For each `from` attribute in the route, the corresponding SystemHandle
-         * must produce a subscriber that fetches the data from the user's source
-         * application and convert it to the common language representation, that is,
-         * `eprosima::xtypes::DynamicData`.
-         * Then, this subscriber callback will take care of publishing the data
-         * in each one of the TopicPublishers defined in the `to` middleware list.
-         */
-        for (const std::string& from : topic_config.route.from)
-        {
-            /**
-             * First, it checks the subscribing capabilities of the middleware's SystemHandle.
-             */
-            const auto it_from = info_map.find(from);
-            if (it_from == info_map.end() || !it_from->second.topic_subscriber)
-            {
-                logger << utils::Logger::Level::ERROR
-                       << "Could not find topic subscribing capabilities for system "
-                       << "named '" << from << "', requested for topic '"
-                       << topic_name << "'." << std::endl;
-                valid = false;
-                continue;
-            }
+                std::unique_ptr<TopicSubscriberSystem::RawSubscriptionCallback> raw_callback(
+                    new TopicSubscriberSystem::RawSubscriptionCallback(
+                        [=](const uint8_t* payload,
+                        std::size_t size,
+                        void* filter_handle)
+                        {
+                            if (retired->load(std::memory_order_acquire))
+                            {
+                                return;
+                            }
 
-            /**
-             * Does remapping and type resolution, if applicable.
-             */
-            TopicInfo topic_info = remap_if_needed(
-                from, topic_config.remap, TopicInfo(topic_name, topic_config.message_type));
+                            if (origin_tag != 0
+                                    ? MessageOrigin::matches(filter_handle, origin_tag)
+                                    : topic_subscriber_system->is_internal_message(filter_handle))
+                            {
+                                return;
+                            }
 
-            const eprosima::xtypes::DynamicType* sub_type = resolve_type(
-                it_from->second.types, topic_info.type);
+                            std::unique_ptr<Tracer::Trace> trace =
+                                    tracer ? tracer->start(raw_topic, from) : nullptr;
 
-            /**
-             * Helper struct to store an Integration Service publisher
-             * and its published DynamicType. It is very similar to PublisherData,
-             * but includes the type consistency parameter between a certain publisher type
-             * and the current subscriber type.
-             */
-            struct Publication
-            {
-                Publication(
-                        const PublisherData& publisher_data,
-                        const eprosima::xtypes::DynamicType& sub_type)
-                    : publisher(publisher_data.publisher)
-                    , type(publisher_data.type)
-                    , consistency(publisher_data.type.is_compatible(sub_type))
-                {
-                }
+                            for (const Publication::Destination& destination : raw_destinations)
+                            {
+                                destination.metrics->received();
 
-                std::shared_ptr<TopicPublisher> publisher;
-                const eprosima::xtypes::DynamicType& type;
-                eprosima::xtypes::TypeConsistency consistency;
-            };
+                                const auto start = std::chrono::steady_clock::now();
+                                const bool published = destination.publisher->publish_raw(payload, size);
+                                destination.metrics->sent(published, std::chrono::steady_clock::now() - start);
 
-            std::vector<Publication> publications;
-            publications.reserve(publishers.size());
+                                if (trace)
+                                {
+                                    trace->add("publish raw " + destination.metrics->destination(), start, published);
+                                }
+                            }
 
-            for (const auto& pub : publishers)
-            {
-                publications.emplace_back(Publication(pub, *sub_type));
+                            if (trace)
+                            {
+                                tracer->finish(std::move(trace));
+                            }
+                        }));
+
+                const bool subscribed_raw = SubscriptionTable::subscribe(
+                    it_from->second.handle, topic_info.name, raw_callback.get(),
+                    [&]()
+                    {
+                        return topic_subscriber_system->subscribe_raw(
+                            topic_info.name,
+                            (topic_info.type.find(".") == std::string::npos
+                            ? *sub_type
+                            : *TypeTable::type_at(_m_types, topic_info.type.substr(0, topic_info.type.find(".")))),
+                            raw_callback.get(),
+                            config_or_empty_node(from, topic_config.middleware_configs));
+                    });
+
+                if (subscribed_raw)
+                {
+                    if (route_resources)
+                    {
+                        const std::weak_ptr<SystemHandle> system = it_from->second.handle;
+                        const std::string name = topic_info.name;
+                        const void* callback = raw_callback.get();
+                        route_resources->unsubscribe.push_back(
+                            [system, topic_subscriber_system, name, callback]()
+                            {
+                                return SubscriptionTable::unsubscribe(system, name, callback, [&]()
+                                {
+                                    return topic_subscriber_system->unsubscribe(name);
+                                });
+                            });
+                    }
+                    raw_subscription_callbacks.emplace_back(std::move(raw_callback));
+
+                    logger << utils::Logger::Level::INFO
+                           << "[" << from << " SystemHandle] Subscribed "
+                           << "to topic '" << topic_name << "', with message type '"
+                           << topic_config.message_type << "', forwarding its '"
+                           << raw_encoding << "' payloads as they are." << std::endl;
+                    continue;
+                }
+
+                logger << utils::Logger::Level::DEBUG
+                       << "[" << from << " SystemHandle] Could not subscribe to the raw payloads "
+                       << "of topic '" << topic_name << "'. Its messages will be deserialized."
+                       << std::endl;
             }
 
             /**
@@ -1445,22 +3648,96 @@ bool Config::configure_topics(
              */
 
             std::unique_ptr<TopicSubscriberSystem::SubscriptionCallback> unique_callback = nullptr;
-            TopicSubscriberSystem* topic_subscriber_system = it_from->second.topic_subscriber;
+
+            const std::string traced_topic = topic_name;
 
             unique_callback.reset(new TopicSubscriberSystem::SubscriptionCallback(
                         [=](const eprosima::xtypes::DynamicData& message,
                         void* filter_handle)
                         {
-                            if (topic_subscriber_system->is_internal_message(filter_handle))
+                            if (retired->load(std::memory_order_acquire))
+                            {
+                                return;
+                            }
+
+                            if (origin_tag != 0
+                                    ? MessageOrigin::matches(filter_handle, origin_tag)
+                                    : topic_subscriber_system->is_internal_message(filter_handle))
+                            {
+                                return;
+                            }
+
+                            /**
+                             * Only a sampled message gets a trace, which is discarded
+                             * if the message is not routed at all.
+                             */
+                            std::unique_ptr<Tracer::Trace> trace =
+                                    tracer ? tracer->start(traced_topic, from) : nullptr;
+
+                            if (lazy && !lazy->active())
+                            {
+                                return;
+                            }
+
+                            if (filter && !filter->matches(message))
+                            {
+                                return;
+                            }
+
+                            if (deduplicator
+                                    && !deduplicator->offer(SampleDeduplicator::hash(message, dedup_key)))
                             {
                                 return;
                             }
 
+                            if (recorder)
+                            {
+                                recorder->record(TrafficRecorder::Kind::MESSAGE, traced_topic, message);
+                            }
+
+                            /**
+                             * Shared copy of the received message, materialized at most once
+                             * and only if some destination prefers shared messages.
+                             */
+                            std::shared_ptr<const eprosima::xtypes::DynamicData> shared_message;
+
                             for (const Publication& publication : publications)
                             {
+                                const Tracer::Clock::time_point converting =
+                                        trace ? Tracer::Clock::now() : Tracer::Clock::time_point();
+
                                 if (publication.consistency == eprosima::xtypes::TypeConsistency::EQUALS)
                                 {
-                                    publication.publisher->publish(message);
+                                    publication.publish(message, shared_message, trace.get());
+                                }
+                                else if (publication.plan)
+                                {
+                                    /**
+                                     * Precompiled conversions are written into an instance
+                                     * borrowed from the pool of the published type.
+                                     */
+                                    std::shared_ptr<eprosima::xtypes::DynamicData> pooled =
+                                            publication.pool->acquire();
+                                    publication.plan->apply(message, *pooled);
+
+                                    std::shared_ptr<const eprosima::xtypes::DynamicData> compatible_message =
+                                            std::move(pooled);
+                                    if (trace)
+                                    {
+                                        trace->add("convert " + publication.type.name(), converting);
+                                    }
+                                    publication.publish(*compatible_message, compatible_message, trace.get());
+                                }
+                                else if (publication.shared)
+                                {
+                                    std::shared_ptr<const eprosima::xtypes::DynamicData> compatible_message =
+                                            std::make_shared<const eprosima::xtypes::DynamicData>(
+                                        message, publication.type);
+                                    if (trace)
+                                    {
+                                        trace->add("convert " + publication.type.name(), converting);
+                                    }
+                                    publication.publish(*compatible_message, compatible_message, trace.get());
                                 }
                                 else
                                 {
@@ -1468,20 +3745,129 @@ bool Config::configure_topics(
                                      * Previously ensured that TypeConsistency is not NONE,
                                      * thanks to `check_topic_compatibility`.
                                      */
+                                    std::shared_ptr<const eprosima::xtypes::DynamicData> unused;
                                     eprosima::xtypes::DynamicData compatible_message(
                                         message, publication.type);
-                                    publication.publisher->publish(compatible_message);
+                                    if (trace)
+                                    {
+                                        trace->add("convert " + publication.type.name(), converting);
+                                    }
+                                    publication.publish(compatible_message, unused, trace.get());
                                 }
                             }
+
+                            if (trace)
+                            {
+                                tracer->finish(std::move(trace));
+                            }
                         }));
 
-            bool subscribed = it_from->second.topic_subscriber->subscribe(
-                topic_info.name,
-                (topic_info.type.find(".") == std::string::npos
-                ? *sub_type
-                : *_m_types.at(topic_info.type.substr(0, topic_info.type.find(".")))),
-                unique_callback.get(),
-                config_or_empty_node(from, topic_config.middleware_configs));
+            const eprosima::xtypes::DynamicType& topic_type =
+                    (topic_info.type.find(".") == std::string::npos
+                    ? *sub_type
+                    : *TypeTable::type_at(_m_types, topic_info.type.substr(0, topic_info.type.find("."))));
+
+            /**
+             * Deaggregated routes subscribe to the frames sent by an aggregated route of
+             * another instance, and route each of their samples as if it was received alone.
+             */
+            if (topic_config.route.deaggregate)
+            {
+                std::shared_ptr<TopicSubscriberSystem::SubscriptionCallback> route_sample(
+                    std::move(unique_callback));
+                const eprosima::xtypes::DynamicType* sample_type = &topic_type;
+
+                unique_callback.reset(new TopicSubscriberSystem::SubscriptionCallback(
+                            [route_sample, sample_type, traced_topic, from](
+                                const eprosima::xtypes::DynamicData& frame,
+                                void* filter_handle)
+                            {
+                                eprosima::xtypes::DynamicData sample(*sample_type);
+                                const bool unpacked = SampleAggregator::unpack(frame, sample,
+                                [&](const eprosima::xtypes::DynamicData& unpacked_sample)
+                                {
+                                    (*route_sample)(unpacked_sample, filter_handle);
+                                });
+
+                                if (!unpacked)
+                                {
+                                    logger << utils::Logger::Level::WARN
+                                           << "[" << from << " SystemHandle] Received an invalid frame for "
+                                           << "the aggregated topic '" << traced_topic << "'. Its remaining "
+                                           << "samples were discarded." << std::endl;
+                                }
+                            }));
+            }
+
+            const eprosima::xtypes::DynamicType& subscribed_type = topic_config.route.deaggregate
+                    ? SampleAggregator::frame_type()
+                    : topic_type;
+
+            if (lazy)
+            {
+                TopicSubscriberSystem::SubscriptionCallback* callback = unique_callback.get();
+                const eprosima::xtypes::DynamicType* type = &subscribed_type;
+                const std::string name = topic_info.name;
+                const YAML::Node configuration = config_or_empty_node(from, topic_config.middleware_configs);
+
+                const std::weak_ptr<SystemHandle> system = it_from->second.handle;
+
+                /**
+                 * Other routes may be subscribed to the same topic of the source, so it is
+                 * only unsubscribed once none of them holds it.
+                 */
+                lazy->add_source(from,
+                        [system, topic_subscriber_system, name, type, callback, configuration]()
+                        {
+                            return SubscriptionTable::subscribe(system, name, callback, [&]()
+                            {
+                                return topic_subscriber_system->subscribe(
+                                    name, *type, callback, configuration);
+                            });
+                        },
+                        [system, topic_subscriber_system, name, callback]()
+                        {
+                            return SubscriptionTable::unsubscribe(system, name, callback, [&]()
+                            {
+                                return topic_subscriber_system->unsubscribe(name);
+                            });
+                        });
+
+                subscription_callbacks.emplace_back(std::move(unique_callback));
+
+                logger << utils::Logger::Level::INFO
+                       << "[" << from << " SystemHandle] The subscription to the lazy topic '"
+                       << topic_name << "', with message type '" << topic_config.message_type
+                       << "', is kept only while a remote endpoint listens to it." << std::endl;
+                continue;
+            }
+
+            bool subscribed = SubscriptionTable::subscribe(
+                it_from->second.handle, topic_info.name, unique_callback.get(),
+                [&]()
+                {
+                    return it_from->second.topic_subscriber->subscribe(
+                        topic_info.name,
+                        subscribed_type,
+                        unique_callback.get(),
+                        config_or_empty_node(from, topic_config.middleware_configs));
+                });
+
+            if (subscribed && route_resources)
+            {
+                TopicSubscriberSystem* subscriber = it_from->second.topic_subscriber;
+                const std::weak_ptr<SystemHandle> system = it_from->second.handle;
+                const std::string name = topic_info.name;
+                const void* callback = unique_callback.get();
+                route_resources->unsubscribe.push_back(
+                    [system, subscriber, name, callback]()
+                    {
+                        return SubscriptionTable::unsubscribe(system, name, callback, [&]()
+                        {
+                            return subscriber->unsubscribe(name);
+                        });
+                    });
+            }
 
             subscription_callbacks.emplace_back(std::move(unique_callback));
 
@@ -1510,15 +3896,80 @@ bool Config::configure_topics(
 //==============================================================================
 bool Config::configure_services(
         const is::internal::SystemHandleInfoMap& info_map,
-        RequestCallbacks& request_callbacks) const
+        RequestCallbacks& request_callbacks,
+        MetricsRegistry& metrics,
+        const std::shared_ptr<TrafficRecorder>& recorder,
+        std::map<std::string, RouteResources>* resources) const
 {
     bool valid = true;
 
+    /**
+     * As for topics, the compatibility of the request and reply types of every
+     * client and server pair is computed beforehand, in parallel.
+     */
+    {
+        StartupProfile::Scope profile("phase", "check service compatibility");
+
+        std::vector<ConversionCache::Key> pairs;
+        for (const auto& [service_name, service_config] : _m_service_configs)
+        {
+            const ServiceInfo service_info(service_name, service_config.request_type, service_config.reply_type);
+
+            const auto it_server = info_map.find(service_config.route.server);
+            if (it_server == info_map.end())
+            {
+                continue;
+            }
+
+            const ServiceInfo server_info = remap_if_needed(
+                service_config.route.server, service_config.remap, service_info);
+
+            for (const std::string& client : service_config.route.clients)
+            {
+                const auto it_client = info_map.find(client);
+                if (it_client == info_map.end())
+                {
+                    continue;
+                }
+
+                /**
+                 * Requests are checked against the server type, and converted into it,
+                 * which checks the server type against the client one.
+                 * Replies are converted from the server reply type into the client one.
+                 */
+                const ServiceInfo client_info = remap_if_needed(client, service_config.remap, service_info);
+                const eprosima::xtypes::DynamicType* client_type =
+                        resolve_type(it_client->second.types, client_info.type);
+                const eprosima::xtypes::DynamicType* server_type =
+                        resolve_type(it_server->second.types, server_info.type);
+                pairs.emplace_back(client_type, server_type);
+                pairs.emplace_back(server_type, client_type);
+
+                if (!client_info.reply_type.empty() && !server_info.reply_type.empty())
+                {
+                    pairs.emplace_back(
+                        resolve_type(it_client->second.types, client_info.reply_type),
+                        resolve_type(it_server->second.types, server_info.reply_type));
+                }
+            }
+        }
+
+        _m_conversion_cache->precompute(pairs);
+    }
+
     /**
      * Iterates through the services section of the provided configuration.
      */
     for (const auto& [service_name, service_config] : _m_service_configs)
     {
+        StartupProfile::Scope profile("service", service_name);
+
+        RouteResources* route_resources = resources ? &(*resources)[service_name] : nullptr;
+        const ResourcesTracker tracker(route_resources, nullptr, nullptr, &request_callbacks);
+        const std::shared_ptr<std::atomic_bool> retired = route_resources
+                ? route_resources->retired
+                : std::make_shared<std::atomic_bool>(false);
+
         /**
          * First, it checks service compatibility in terms of the registered types
          * in the source and destination endpoints, both for request and reply types.
@@ -1568,10 +4019,10 @@ bool Config::configure_services(
                 server_info.name,
                 (server_info.type.find(".") == std::string::npos
                 ? *server_type
-                : *_m_types.at(server_info.type.substr(0, server_info.type.find(".")))),
+                : *TypeTable::type_at(_m_types, server_info.type.substr(0, server_info.type.find(".")))),
                 (server_info.reply_type.find(".") == std::string::npos
                 ? *server_reply_type
-                : *_m_types.at(server_info.reply_type.substr(0, server_info.reply_type.find(".")))),
+                : *TypeTable::type_at(_m_types, server_info.reply_type.substr(0, server_info.reply_type.find(".")))),
                 config_or_empty_node(server, service_config.middleware_configs));
         }
         else
@@ -1585,7 +4036,7 @@ bool Config::configure_services(
                 server_info.name,
                 (server_info.type.find(".") == std::string::npos
                 ? *server_type
-                : *_m_types.at(server_info.type.substr(0, server_info.type.find(".")))),
+                : *TypeTable::type_at(_m_types, server_info.type.substr(0, server_info.type.find(".")))),
                 config_or_empty_node(server, service_config.middleware_configs));
         }
 
@@ -1618,6 +4069,27 @@ bool Config::configure_services(
             logger << "." << std::endl;
         }
 
+        /**
+         * Idempotent services may coalesce identical requests: a RequestCoalescer, shared by
+         * all the clients of the service, is then placed in front of the actual provider.
+         * Requests stop being coalesced once they are older than the route timeout, if any,
+         * or once they have the maximum number of waiting clients.
+         */
+        if (service_config.coalesce.enabled)
+        {
+            provider = std::make_shared<RequestCoalescer>(
+                provider,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::duration<double>(service_config.coalesce.reply_ttl)),
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::duration<double>(service_config.route.calls.timeout)),
+                service_config.coalesce.max_waiters);
+
+            logger << utils::Logger::Level::DEBUG
+                   << "Identical requests of the service '" << service_name
+                   << "' will be coalesced." << std::endl;
+        }
+
         /**
          * Defines the Integration Service RequestCallback lambda that will
          * be called each time the user client application makes a request.
@@ -1660,10 +4132,52 @@ bool Config::configure_services(
             const eprosima::xtypes::DynamicType* client_type = resolve_type(
                 it_client->second.types, client_info.type);
 
+            /**
+             * Gets the precompiled conversions of the request, from the client type into the
+             * server one, and of the reply, from the server reply type into the client one.
+             */
+            const ConversionCache::Entry request_conversion =
+                    _m_conversion_cache->get(*client_type, *server_type);
+
+            const eprosima::xtypes::DynamicType* client_reply_type = nullptr;
+            ConversionCache::Entry reply_conversion{eprosima::xtypes::TypeConsistency::EQUALS, nullptr};
+            if (!client_info.reply_type.empty() && !server_info.reply_type.empty())
+            {
+                client_reply_type = resolve_type(it_client->second.types, client_info.reply_type);
+                reply_conversion = _m_conversion_cache->get(
+                    *resolve_type(it_server->second.types, server_info.reply_type), *client_reply_type);
+            }
+
+            /**
+             * Replies are routed through a MeasuredServiceClient, so that the outcome
+             * of the call and its round-trip time get recorded once it completes,
+             * and they get converted if needed, before reaching the client proxy.
+             */
+            std::shared_ptr<RouteMetrics> route_metrics = metrics.add(
+                "service", service_name, service_config.route_name, client, server);
+            std::shared_ptr<MeasuredServiceClient> measured_client =
+                    std::make_shared<MeasuredServiceClient>(
+                route_metrics,
+                reply_conversion.consistency == eprosima::xtypes::TypeConsistency::EQUALS
+                ? nullptr : client_reply_type,
+                reply_conversion.plan);
+
+            if (service_config.route.calls.timeout > 0.0 || service_config.route.calls.max_in_flight > 0)
+            {
+                measured_client->bound_calls(
+                    client + " -> " + server + " (" + service_name + ")", service_config.route.calls);
+            }
+
             /**
              * Defines the RequestCallback that will perform the corresponding call to the service.
+             * Whether requests are forwarded as they are depends on the consistency of the client
+             * type with respect to the server one, as checked by `check_service_compatibility`.
              */
-            eprosima::xtypes::TypeConsistency consistency = client_type->is_compatible(*server_type);
+            const eprosima::xtypes::TypeConsistency consistency =
+                    _m_conversion_cache->consistency(*client_type, *server_type);
+            const std::shared_ptr<const ConversionPlan> request_plan = request_conversion.plan;
+
+            const std::string recorded_service = service_name;
 
             std::unique_ptr<ServiceClientSystem::RequestCallback> unique_callback = nullptr;
             unique_callback.reset(new ServiceClientSystem::RequestCallback(
@@ -1672,14 +4186,42 @@ bool Config::configure_services(
                             ServiceClient& service_client,
                             const std::shared_ptr<void>& call_handle)
                         {
+                            if (retired->load(std::memory_order_acquire))
+                            {
+                                return;
+                            }
+
+                            route_metrics->received();
+
+                            if (recorder)
+                            {
+                                recorder->record(TrafficRecorder::Kind::REQUEST, recorded_service, request);
+                            }
+
+                            const std::shared_ptr<void> measured_handle =
+                                    measured_client->track(service_client, call_handle);
+                            if (!measured_handle)
+                            {
+                                route_metrics->dropped();
+                                service_client.receive_cancellation(call_handle);
+                                return;
+                            }
+
                             if (consistency == eprosima::xtypes::TypeConsistency::EQUALS)
                             {
-                                provider->call_service(request, service_client, call_handle);
+                                provider->call_service(request, *measured_client, measured_handle);
                             }
-                            else //previously ensured that TypeConsistency is not NONE
+                            else if (request_plan) //previously ensured that TypeConsistency is not NONE
                             {
+                                route_metrics->converted();
+                                provider->call_service(
+                                    request_plan->convert(request), *measured_client, measured_handle);
+                            }
+                            else
+                            {
+                                route_metrics->converted();
                                 eprosima::xtypes::DynamicData compatible_request(request, *server_type);
-                                provider->call_service(compatible_request, service_client, call_handle);
+                                provider->call_service(compatible_request, *measured_client, measured_handle);
                             }
                         }));
 
@@ -1700,24 +4242,27 @@ bool Config::configure_services(
                     //*client_type,
                     (client_info.type.find(".") == std::string::npos
                     ? *client_type
-                    : *_m_types.at(client_info.type.substr(0, client_info.type.find(".")))),
+                    : *TypeTable::type_at(_m_types, client_info.type.substr(0, client_info.type.find(".")))),
                     unique_callback.get(),
                     config_or_empty_node(client, service_config.middleware_configs));
             }
             else
             {
-                const eprosima::xtypes::DynamicType* client_reply_type = resolve_type(
-                    it_client->second.types, client_info.reply_type);
+                if (!client_reply_type)
+                {
+                    client_reply_type = resolve_type(it_client->second.types, client_info.reply_type);
+                }
 
                 created_client_proxy = it_client->second.service_client->create_client_proxy(
                     client_info.name,
                     //*client_type,
                     (client_info.type.find(".") == std::string::npos
                     ? *client_type
-                    : *_m_types.at(client_info.type.substr(0, client_info.type.find(".")))),
+                    : *TypeTable::type_at(_m_types, client_info.type.substr(0, client_info.type.find(".")))),
                     (client_info.reply_type.find(".") == std::string::npos
                     ? *client_reply_type
-                    : *_m_types.at(client_info.reply_type.substr(0, client_info.reply_type.find(".")))),
+                    : *TypeTable::type_at(_m_types,
+                    client_info.reply_type.substr(0, client_info.reply_type.find(".")))),
                     unique_callback.get(),
                     config_or_empty_node(client, service_config.middleware_configs));
             }
@@ -1778,7 +4323,26 @@ bool Config::check_topic_compatibility(
             const auto it_to = info_map.find(to);
 
             TopicInfo topic_info_to = remap_if_needed(to, config.remap, TopicInfo(topic_name, config.message_type));
-            const eprosima::xtypes::DynamicType* to_type = resolve_type(it_from->second.types, topic_info_from.type);
+            const eprosima::xtypes::DynamicType* to_type = resolve_type(it_to->second.types, topic_info_to.type);
+
+            /**
+             * Projections only take some members of the source type, so they are
+             * checked by compiling them, instead of by comparing the whole types.
+             */
+            if (!topic_info_to.project.empty())
+            {
+                std::string error;
+                if (!ConversionPlan::project(*from_type, *to_type, topic_info_to.project, error))
+                {
+                    logger << utils::Logger::Level::ERROR
+                           << "Remapping error: the projection of topic type '" << topic_info_from.type
+                           << "' from '" << it_from->first << "' into '" << topic_info_to.type
+                           << "' in '" << it_to->first << "' is not valid: " << error << std::endl;
+
+                    valid = false;
+                }
+                continue;
+            }
 
             /**
              * Checks type compatibility between `from` and `to` defined types using eprosima::xtypes::TypeConsistency.
@@ -1788,7 +4352,7 @@ bool Config::check_topic_compatibility(
              * TODO (@jamoralp): users might want to specifically enable or disable these policies through the YAML
              * configuration file.
              */
-            eprosima::xtypes::TypeConsistency consistency = from_type->is_compatible(*to_type);
+            eprosima::xtypes::TypeConsistency consistency = _m_conversion_cache->consistency(*from_type, *to_type);
 
             if (consistency == eprosima::xtypes::TypeConsistency::NONE)
             {
@@ -1871,7 +4435,7 @@ bool Config::check_service_compatibility(
          * TODO (@jamoralp): users might want to specifically enable or disable this policies through the YAML
          * configuration file.
          */
-        auto request_consistency = client_type->is_compatible(*server_type);
+        auto request_consistency = _m_conversion_cache->consistency(*client_type, *server_type);
 
         if (request_consistency == eprosima::xtypes::TypeConsistency::NONE)
         {
@@ -1915,7 +4479,25 @@ bool Config::check_service_compatibility(
         }
 
         /**
-         * Now, does the same for reply type.
+         * Requests which are not forwarded as they are get converted into the server type,
+         * which requires the server type to be compatible with the client one too.
+         */
+        if (request_consistency != eprosima::xtypes::TypeConsistency::EQUALS
+                && _m_conversion_cache->get(*client_type, *server_type).consistency
+                == eprosima::xtypes::TypeConsistency::NONE)
+        {
+            logger << utils::Logger::Level::ERROR
+                   << "Remapping error: service request type '" << client_info.type
+                   << "' from '" << it_client->first << "' cannot be converted into '"
+                   << server_info.type << "' in '" << it_server->first << "'." << std::endl;
+
+            valid = false;
+            continue;
+        }
+
+        /**
+         * Now, does the same for reply type, which is converted in the opposite direction,
+         * from the server reply type into the client one.
          */
         if (!client_info.reply_type.empty() && !server_info.reply_type.empty())
         {
@@ -1925,24 +4507,24 @@ bool Config::check_service_compatibility(
             const eprosima::xtypes::DynamicType* server_reply =
                     resolve_type(it_server->second.types, server_info.reply_type);
 
-            auto reply_consistency = client_reply->is_compatible(*server_reply);
+            auto reply_consistency = _m_conversion_cache->get(*server_reply, *client_reply).consistency;
 
             if (reply_consistency == xtypes::TypeConsistency::NONE)
             {
                 logger << utils::Logger::Level::ERROR
-                       << "Remapping error: service reply type '" << client_info.reply_type
-                       << "' from '" << it_client->first << "' is not compatible with '"
-                       << server_info.reply_type << "' in '"
-                       << it_server->first << "'." << std::endl;
+                       << "Remapping error: service reply type '" << server_info.reply_type
+                       << "' from '" << it_server->first << "' cannot be converted into '"
+                       << client_info.reply_type << "' in '"
+                       << it_client->first << "'." << std::endl;
 
                 valid = false;
             }
             else if (reply_consistency != eprosima::xtypes::TypeConsistency::EQUALS)
             {
                 logger << utils::Logger::Level::WARN
-                       << "The conversion between reply '" << client_info.reply_type << "' from '"
-                       << it_client->first << "' and '" << server_info.reply_type << "' in '"
-                       << it_server->first << "' has been allowed by adding the following QoS policies: ";
+                       << "The conversion of reply '" << server_info.reply_type << "' from '"
+                       << it_server->first << "' into '" << client_info.reply_type << "' in '"
+                       << it_client->first << "' has been allowed by adding the following QoS policies: ";
 
                 auto policy_name =
                         [&](eprosima::xtypes::TypeConsistency to_check, const std::string& name) -> std::string
@@ -1986,7 +4568,7 @@ const xtypes::DynamicType* Config::resolve_type(
     const xtypes::DynamicType* type_ptr;
     std::string type = path_aux.substr(0, path_aux.find("."));
     std::string member;
-    type_ptr = _m_types.at(type).get();
+    type_ptr = TypeTable::type_at(_m_types, type).get();
     while (path_aux.find(".") != std::string::npos)
     {
         path_aux = path_aux.substr(path_aux.find(".") + 1);
@@ -16,18 +16,39 @@
  *
  */
 #include <is/core/Instance.hpp>
+#include <is/core/runtime/MemoryUsage.hpp>
+#include <is/core/runtime/MetricsExporter.hpp>
+#include <is/core/runtime/PublishBatch.hpp>
+#include <is/core/runtime/ShardSupervisor.hpp>
+#include <is/core/runtime/SpinExecutor.hpp>
+#include <is/core/runtime/StartupProfile.hpp>
+#include <is/core/runtime/SubscriptionTable.hpp>
+#include <is/core/runtime/SystemHandleRegistry.hpp>
+#include <is/core/runtime/TaskScheduler.hpp>
 
 #include <yaml-cpp/yaml.h>
 
 #include <boost/program_options.hpp> // TODO (@jamoralp): get rid of this dependency.
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <experimental/filesystem>
+#include <functional>
 #include <iostream>
+#include <list>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
 #include <thread>
 
 #include <csignal>
+#include <cstring>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif //  __linux__
 
 namespace eprosima {
 namespace is {
@@ -53,6 +74,69 @@ struct ArgumentStack
     std::map<std::string, std::vector<std::string> > values;
 };
 
+//==============================================================================
+/**
+ * @brief Applies the thread settings of a middleware to the calling thread.
+ *        Failures, usually due to missing privileges, are logged, and the thread
+ *        keeps running with its current settings. CPU affinity and scheduling
+ *        policies are only supported on Linux.
+ */
+static void configure_thread(
+        const std::string& mw_name,
+        const internal::ThreadConfig& config,
+        utils::Logger& logger)
+{
+#ifdef __linux__
+    if (!config.cpu_affinity.empty())
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for (const int cpu : config.cpu_affinity)
+        {
+            CPU_SET(cpu, &cpus);
+        }
+
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if (error != 0)
+        {
+            logger << utils::Logger::Level::WARN
+                   << "Could not pin the thread of middleware named '" << mw_name
+                   << "' to the configured CPUs: " << std::strerror(error) << std::endl;
+        }
+    }
+
+    if (!config.sched_policy.empty())
+    {
+        static const std::map<std::string, int> policies = {
+            {"other", SCHED_OTHER},
+            {"batch", SCHED_BATCH},
+            {"idle", SCHED_IDLE},
+            {"fifo", SCHED_FIFO},
+            {"rr", SCHED_RR}
+        };
+
+        sched_param param{};
+        param.sched_priority = config.priority;
+
+        const int error = pthread_setschedparam(pthread_self(), policies.at(config.sched_policy), &param);
+        if (error != 0)
+        {
+            logger << utils::Logger::Level::WARN
+                   << "Could not set the '" << config.sched_policy << "' scheduling policy, with priority "
+                   << config.priority << ", to the thread of middleware named '" << mw_name
+                   << "': " << std::strerror(error) << std::endl;
+        }
+    }
+#else
+    if (!config.cpu_affinity.empty() || !config.sched_policy.empty())
+    {
+        logger << utils::Logger::Level::WARN
+               << "The CPU affinity and the scheduling policy of the thread of middleware named '"
+               << mw_name << "' are only supported on Linux, they are ignored" << std::endl;
+    }
+#endif //  __linux__
+}
+
 //==============================================================================
 class InstanceHandle::Implementation
 {
@@ -88,29 +172,193 @@ public:
     {
     }
 
-    ~Implementation() = default;
+    ~Implementation()
+    {
+        /**
+         * Shared SystemHandles outlive this instance, while they are used by other ones,
+         * so the callbacks given to them are disabled and handed over to the registry.
+         */
+        const bool uses_shared = std::any_of(_info_map.begin(), _info_map.end(),
+                        [](const auto& entry)
+                        {
+                            return entry.second.shared;
+                        });
+
+        if (!uses_shared)
+        {
+            return;
+        }
+
+        struct Callbacks
+        {
+            internal::Config::SubscriptionCallbacks subscriptions;
+            internal::Config::RawSubscriptionCallbacks raw_subscriptions;
+            internal::Config::RequestCallbacks requests;
+        };
+
+        auto callbacks = std::make_shared<Callbacks>();
+        callbacks->subscriptions = std::move(subscription_callbacks_);
+        callbacks->raw_subscriptions = std::move(raw_subscription_callbacks_);
+        callbacks->requests = std::move(request_callbacks_);
+
+        std::vector<std::weak_ptr<SystemHandle> > shared_systems;
+        for (const auto& [mw_name, info] : _info_map)
+        {
+            if (info.shared)
+            {
+                shared_systems.push_back(info.handle);
+            }
+        }
+
+        /**
+         * The subscriptions are cancelled, and the callbacks retired instead of replaced,
+         * since the shared SystemHandles may be calling them from their own threads.
+         */
+        auto detach = [this]()
+                {
+                    for (auto& [topic_name, route] : _topic_resources)
+                    {
+                        for (const auto& unsubscribe : route.unsubscribe)
+                        {
+                            if (!unsubscribe())
+                            {
+                                _logger << utils::Logger::Level::WARN
+                                        << "Could not unsubscribe from the topic '" << topic_name
+                                        << "', its messages will be discarded." << std::endl;
+                            }
+                        }
+                        route.retired->store(true, std::memory_order_release);
+                    }
+
+                    for (auto& [service_name, route] : _service_resources)
+                    {
+                        route.retired->store(true, std::memory_order_release);
+                    }
+                };
+
+        /**
+         * Clients cannot be removed from their middlewares, so request callbacks are always kept.
+         * Subscription callbacks are kept while other routes hold their topics in a shared SystemHandle.
+         */
+        std::weak_ptr<Callbacks> weak_callbacks = callbacks;
+        auto in_use = [weak_callbacks, shared_systems]()
+                {
+                    const std::shared_ptr<Callbacks> parked = weak_callbacks.lock();
+                    if (!parked)
+                    {
+                        return false;
+                    }
+
+                    if (!parked->requests.empty())
+                    {
+                        return true;
+                    }
+
+                    for (const std::weak_ptr<SystemHandle>& system : shared_systems)
+                    {
+                        for (const auto& callback : parked->subscriptions)
+                        {
+                            if (SubscriptionTable::registered(system, callback.get()))
+                            {
+                                return true;
+                            }
+                        }
+
+                        for (const auto& callback : parked->raw_subscriptions)
+                        {
+                            if (SubscriptionTable::registered(system, callback.get()))
+                            {
+                                return true;
+                            }
+                        }
+                    }
+                    return false;
+                };
+
+        SystemHandleRegistry::global().release(_info_map, detach, callbacks, in_use);
+    }
 
     bool configure_integration_service()
     {
-        if (!_configuration.load_middlewares(_info_map))
         {
-            _logger << utils::Logger::Level::ERROR
-                    << "Failed to load middlewares!" << std::endl;
-            return false;
+            StartupProfile::Scope profile("phase", "load middlewares");
+            if (!_configuration.load_middlewares(_info_map))
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "Failed to load middlewares!" << std::endl;
+                return false;
+            }
         }
 
-        if (!_configuration.configure_topics(_info_map, subscription_callbacks_))
+        /**
+         * The type registries do not change once the middlewares are loaded,
+         * so their memory is only measured once.
+         */
+        for (const auto& [mw_name, info] : _info_map)
         {
-            _logger << utils::Logger::Level::ERROR
-                    << "Failed to configure topics!" << std::endl;
-            return false;
+            _metrics.set_type_registry(mw_name, info.types.size(), MemoryUsage::of(info.types));
         }
 
-        if (!_configuration.configure_services(_info_map, request_callbacks_))
+        /**
+         * If requested, one out of every few messages routed by the topics is traced.
+         */
+        const internal::TracingConfig& tracing = _configuration.tracing_config();
+        if (tracing.sample_every > 0)
         {
-            _logger << utils::Logger::Level::ERROR
-                    << "Failed to configure services!" << std::endl;
-            return false;
+            std::shared_ptr<Tracer::Sink> sink = Tracer::file_sink(tracing.format, tracing.file);
+            if (!sink)
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "Could not open the traces file '" << tracing.file << "'!" << std::endl;
+                return false;
+            }
+
+            _tracer = std::make_shared<Tracer>(tracing.sample_every, std::move(sink));
+
+            _logger << utils::Logger::Level::INFO
+                    << "Tracing one out of every " << tracing.sample_every << " messages into '"
+                    << tracing.file << "'." << std::endl;
+        }
+
+        /**
+         * If requested, the routed messages and requests are recorded into a capture file.
+         */
+        const internal::RecordingConfig& recording = _configuration.recording_config();
+        if (!recording.file.empty())
+        {
+            _recorder = TrafficRecorder::create(recording.file, recording.segment_size);
+            if (!_recorder)
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "Could not create the capture file '" << recording.file << "'!" << std::endl;
+                return false;
+            }
+
+            _logger << utils::Logger::Level::INFO
+                    << "Recording the routed traffic into '" << recording.file << "'." << std::endl;
+        }
+
+        {
+            StartupProfile::Scope profile("phase", "configure topics");
+            if (!_configuration.configure_topics(
+                        _info_map, subscription_callbacks_, raw_subscription_callbacks_, _metrics, _tracer, _recorder,
+                        &_topic_resources, _route_task_scheduler(), &_dispatchers))
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "Failed to configure topics!" << std::endl;
+                return false;
+            }
+        }
+
+        {
+            StartupProfile::Scope profile("phase", "configure services");
+            if (!_configuration.configure_services(
+                        _info_map, request_callbacks_, _metrics, _recorder, &_service_resources))
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "Failed to configure services!" << std::endl;
+                return false;
+            }
         }
 
         _logger << utils::Logger::Level::DEBUG
@@ -151,48 +399,288 @@ public:
             ++interruptable_instances;
         }
 
-        _work_threads.reserve(_info_map.size());
+        /**
+         * SystemHandles accepting a wake-up callback are served by the shared executor,
+         * while the rest of them get a dedicated thread that spins them continuously.
+         * Those with thread settings get a thread of their own in any case: in poll mode,
+         * it spins them continuously, ignoring their wake-up callback; otherwise, it is
+         * the only thread of an executor reserved for them.
+         */
+        struct DedicatedHandle
+        {
+            std::string mw_name;
+            SystemHandle* handle;
+            const internal::ThreadConfig* thread;
+        };
+
+        std::vector<DedicatedHandle> dedicated_handles;
+        std::vector<std::pair<SpinExecutor*, const DedicatedHandle> > reserved_executors;
 
+        std::size_t shared_handles = 0;
         for (const auto& [mw_name, systemhandle_info] : _info_map)
+        {
+            if (systemhandle_info.shared)
+            {
+                _logger << utils::Logger::Level::DEBUG
+                        << "SystemHandle of middleware named '" << mw_name
+                        << "' is shared, so it will be spun by the SystemHandleRegistry." << std::endl;
+
+                ++shared_handles;
+                continue;
+            }
+
+            const internal::ThreadConfig& thread_config = _configuration.thread_config(mw_name);
+            const DedicatedHandle dedicated{mw_name, systemhandle_info.handle.get(), &thread_config};
+
+            if (thread_config.poll_mode)
+            {
+                _logger << utils::Logger::Level::DEBUG
+                        << "SystemHandle of middleware named '" << mw_name
+                        << "' will be busy-polled by a dedicated thread." << std::endl;
+
+                dedicated_handles.push_back(dedicated);
+                continue;
+            }
+
+            SpinExecutor& executor = thread_config.dedicated() ? _reserved_executors.emplace_back() : _executor;
+            const std::shared_ptr<SpinExecutor::Entry> entry = executor.add(mw_name, systemhandle_info.handle.get());
+
+            /**
+             * The entry is removed if the handle declines the callback, which could
+             * nonetheless have been kept, so the callback only references it weakly.
+             */
+            const bool event_driven = systemhandle_info.handle->set_wake_up_callback(
+                [&executor, weak_entry = std::weak_ptr<SpinExecutor::Entry>(entry)]()
+                {
+                    if (const std::shared_ptr<SpinExecutor::Entry> notified = weak_entry.lock())
+                    {
+                        executor.notify(notified);
+                    }
+                });
+
+            if (event_driven)
+            {
+                _logger << utils::Logger::Level::DEBUG
+                        << "SystemHandle of middleware named '" << mw_name << "' will be spun on demand by "
+                        << (&executor == &_executor ? "the shared executor." : "a dedicated thread.")
+                        << std::endl;
+
+                // Any work received before setting the callback must be processed as well.
+                executor.notify(entry);
+
+                if (&executor != &_executor)
+                {
+                    reserved_executors.emplace_back(&executor, dedicated);
+                }
+            }
+            else
+            {
+                executor.remove(entry);
+                dedicated_handles.push_back(dedicated);
+            }
+        }
+
+        /**
+         * The shared executor always gets a thread, since it also runs the tasks posted by the routes.
+         */
+        const std::size_t executor_threads = std::max<std::size_t>(1, std::min<std::size_t>(
+                    _executor.size(), std::max(1u, std::thread::hardware_concurrency())));
+
+        const std::size_t runners = dedicated_handles.size() + reserved_executors.size() + executor_threads
+                + (shared_handles > 0 ? 1 : 0);
+        _active_middlewares = static_cast<int64_t>(runners);
+        _work_threads.reserve(runners);
+
+        /**
+         * Shared SystemHandles are spun by the registry, so this runner
+         * only keeps the instance running until it is interrupted.
+         */
+        if (shared_handles > 0)
+        {
+            _work_threads.emplace_back(
+                [this]()
+                {
+                    while (!interrupted && !_quit)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                    }
+
+                    _runner_finished();
+                });
+        }
+
+        for (const DedicatedHandle& dedicated : dedicated_handles)
         {
             /**
              * For each systemhandle, creates a working thread that will check that the
              * SystemHandle instance is alive and calls spin_once() to execute pending work.
              */
-            auto runner = [&]()
+            auto runner = [this, dedicated]()
                     {
-                        ++_active_middlewares;
+                        const std::string& mw_name = dedicated.mw_name;
+                        SystemHandle* handle = dedicated.handle;
+                        configure_thread(mw_name, *dedicated.thread, _logger);
 
                         while (!interrupted && !_quit)
                         {
-                            const bool okay = systemhandle_info.handle->spin_once();
+                            const std::shared_lock<std::shared_mutex> routes_lock = _lock_routes();
 
-                            if (!okay)
+                            // Messages routed during the spin are published in batches when it returns.
+                            PublishBatch batch;
+                            if (!handle->spin_once())
                             {
-                                _quit = true;
-                                _return_code = 1;
-                                _logger << utils::Logger::Level::ERROR
-                                        << "Runtime Error: SystemHandle of middleware named '"
-                                        << mw_name
-                                        << "' has experienced a failure! We will now quit."
-                                        << std::endl;
+                                _spin_failure(mw_name);
                             }
                         }
 
-                        --_active_middlewares;
-                        if (_active_middlewares == 0)
+                        _runner_finished();
+                    };
+
+            _work_threads.emplace_back(runner);
+        }
+
+        /**
+         * Each executor thread spins, one at a time, the SystemHandles that
+         * notified some pending work. The timeout allows to periodically check
+         * whether the instance has been interrupted.
+         */
+        auto executor_runner = [this](
+            SpinExecutor& executor)
+                {
+                    while (!interrupted && !_quit)
+                    {
+                        if (std::function<void ()> task = executor.next_task())
+                        {
+                            const std::shared_lock<std::shared_mutex> routes_lock = _lock_routes();
+                            task();
+                            continue;
+                        }
+
+                        const std::shared_ptr<SpinExecutor::Entry> entry =
+                                executor.next(std::chrono::milliseconds(100));
+                        if (nullptr == entry)
+                        {
+                            continue;
+                        }
+
+                        bool okay;
+                        {
+                            const std::shared_lock<std::shared_mutex> routes_lock = _lock_routes();
+                            PublishBatch batch;
+                            okay = entry->handle->spin_once();
+                        }
+                        executor.done(entry);
+
+                        if (!okay)
                         {
-                            _finished();
+                            _spin_failure(entry->name);
+                        }
+                    }
+
+                    _runner_finished();
+                };
+
+        for (std::size_t i = 0; i < executor_threads; ++i)
+        {
+            _work_threads.emplace_back(executor_runner, std::ref(_executor));
+        }
+
+        for (const auto& [executor, dedicated] : reserved_executors)
+        {
+            _work_threads.emplace_back(
+                [this, executor_runner, executor = executor, dedicated = dedicated]()
+                {
+                    configure_thread(dedicated.mw_name, *dedicated.thread, _logger);
+                    executor_runner(*executor);
+                });
+        }
+
+        /**
+         * If requested, the route metrics are periodically written to the log.
+         */
+        const double dump_period = _configuration.metrics_config().dump_period;
+        if (dump_period > 0.0)
+        {
+            auto dumper = [this, dump_period]()
+                    {
+                        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double>(dump_period));
+                        auto next_dump = std::chrono::steady_clock::now() + period;
+
+                        while (!interrupted && !_quit)
+                        {
+                            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+                            if (std::chrono::steady_clock::now() >= next_dump)
+                            {
+                                _logger << utils::Logger::Level::INFO
+                                        << "Route metrics:\n" << _metrics.to_string() << std::endl;
+                                next_dump += period;
+                            }
                         }
                     };
 
-            _work_threads.emplace_back(runner);
+            _work_threads.emplace_back(dumper);
+        }
+
+        /**
+         * If requested, the route metrics are served to Prometheus scrapers.
+         */
+        const internal::MetricsConfig& metrics_config = _configuration.metrics_config();
+        const internal::ShardConfig& shard_config = _configuration.shard_config();
+        if (metrics_config.exporter_port > 0 && shard_config.count == 1)
+        {
+            _exporter = std::make_unique<MetricsExporter>(_metrics);
+            if (!_exporter->start(metrics_config.exporter_address, metrics_config.exporter_port))
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "Failed to start the metrics exporter on " << metrics_config.exporter_address
+                        << ":" << metrics_config.exporter_port << ", the metrics will not be served"
+                        << std::endl;
+                _exporter.reset();
+            }
+        }
+
+        /**
+         * Worker processes of a ShardSupervisor report their route metrics to it instead,
+         * so that the supervisor serves the metrics of all of them together.
+         */
+        if (shard_config.metrics_fd >= 0)
+        {
+            auto reporter = [this, fd = shard_config.metrics_fd, metrics_config]()
+                    {
+                        ShardSupervisor::Report report;
+                        report.exporter_address = metrics_config.exporter_address;
+                        report.exporter_port = metrics_config.exporter_port;
+
+                        auto next_report = std::chrono::steady_clock::now();
+                        while (!interrupted && !_quit)
+                        {
+                            if (std::chrono::steady_clock::now() >= next_report)
+                            {
+                                report.routes = _metrics.snapshot();
+                                if (!ShardSupervisor::send(fd, report))
+                                {
+                                    _logger << utils::Logger::Level::WARN
+                                            << "Could not report the route metrics to the shard supervisor."
+                                            << std::endl;
+                                    return;
+                                }
+                                next_report += std::chrono::seconds(1);
+                            }
+
+                            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                        }
+                    };
+
+            _work_threads.emplace_back(reporter);
         }
     }
 
     void quit()
     {
         _quit = true;
+        _wake_all();
     }
 
     int return_code() const
@@ -231,6 +719,140 @@ public:
         return &_info_map.at(middleware_name).types;
     }
 
+    std::vector<RouteMetricsSnapshot> metrics() const
+    {
+        return _metrics.snapshot();
+    }
+
+    std::vector<TypeRegistrySnapshot> type_registries() const
+    {
+        return _metrics.type_registries();
+    }
+
+    bool reload(
+            const YAML::Node& config_node)
+    {
+        std::unique_lock<std::mutex> reload_lock(_reload_mutex);
+
+        const bool uses_shared = std::any_of(_info_map.begin(), _info_map.end(),
+                        [](const auto& entry)
+                        {
+                            return entry.second.shared;
+                        });
+
+        if (_quit || uses_shared)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "The configuration cannot be reloaded: the instance "
+                    << (_quit ? "is not running." : "uses shared SystemHandles.") << std::endl;
+
+            return false;
+        }
+
+        internal::Config configuration(config_node, _config_file);
+        if (!configuration)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "The new configuration is not valid, so it was not reloaded." << std::endl;
+
+            return false;
+        }
+
+        const internal::ShardConfig& shard_config = _configuration.shard_config();
+        if (shard_config.count > 1)
+        {
+            configuration.select_shard(shard_config.index, shard_config.count, shard_config.metrics_fd);
+        }
+
+        internal::RouteChanges changes;
+        if (!configuration.changes_from(_configuration, _info_map, changes))
+        {
+            return false;
+        }
+
+        if (changes.empty())
+        {
+            _logger << utils::Logger::Level::INFO
+                    << "The configuration was reloaded, with no changes in its routes." << std::endl;
+
+            _configuration = std::move(configuration);
+            return true;
+        }
+
+        /**
+         * The configuration of the added routes is kept, along with their callbacks.
+         */
+        internal::Config& added = _reloaded_configurations.emplace_back(configuration);
+        added.keep_routes(changes.added_topics, changes.added_services);
+
+        bool okay;
+        {
+            /**
+             * No SystemHandle is spun while the routes change. SystemHandles calling their
+             * callbacks from their own threads may still run the ones of removed routes,
+             * which are only retired, so they return right away from then on.
+             */
+            std::unique_lock<std::mutex> gate(_reload_gate);
+            std::unique_lock<std::shared_mutex> routes_lock(_routes_mutex);
+            gate.unlock();
+
+            _take_down(changes);
+
+            okay = added.configure_topics(
+                _info_map, subscription_callbacks_, raw_subscription_callbacks_, _metrics, _tracer, _recorder,
+                &_topic_resources, _route_task_scheduler(), &_dispatchers)
+                    && added.configure_services(
+                _info_map, request_callbacks_, _metrics, _recorder, &_service_resources);
+        }
+
+        _configuration = std::move(configuration);
+
+        if (!okay)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Some of the routes of the new configuration could not be configured." << std::endl;
+
+            return false;
+        }
+
+        _logger << utils::Logger::Level::INFO
+                << "The configuration was reloaded: "
+                << changes.removed_topics.size() << " topics and "
+                << changes.removed_services.size() << " services were taken down, "
+                << changes.added_topics.size() << " topics and "
+                << changes.added_services.size() << " services were configured." << std::endl;
+
+        return true;
+    }
+
+    bool reload()
+    {
+        if (!std::experimental::filesystem::exists(_config_file))
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "The configuration cannot be reloaded, since it was not read from a file."
+                    << std::endl;
+
+            return false;
+        }
+
+        YAML::Node config_node;
+        try
+        {
+            config_node = YAML::LoadFile(_config_file);
+        }
+        catch (const YAML::Exception& e)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "The configuration file '" << _config_file << "' could not be read: "
+                    << e.what() << std::endl;
+
+            return false;
+        }
+
+        return reload(config_node);
+    }
+
     std::condition_variable m_finished;
     std::atomic_bool m_running;
 
@@ -238,6 +860,114 @@ private:
 
     friend class Instance::Implementation;
 
+    void _spin_failure(
+            const std::string& mw_name)
+    {
+        _quit = true;
+        _return_code = 1;
+        _wake_all();
+        _logger << utils::Logger::Level::ERROR
+                << "Runtime Error: SystemHandle of middleware named '"
+                << mw_name
+                << "' has experienced a failure! We will now quit."
+                << std::endl;
+    }
+
+    /**
+     * Called by the threads that spin the SystemHandles. A reload waiting
+     * to change the routes keeps new spins from starting, so that it does not starve.
+     */
+    std::shared_lock<std::shared_mutex> _lock_routes()
+    {
+        std::unique_lock<std::mutex> gate(_reload_gate);
+        return std::shared_lock<std::shared_mutex>(_routes_mutex);
+    }
+
+    void _take_down(
+            const internal::RouteChanges& changes)
+    {
+        /**
+         * The SystemHandles keep pointing to the callbacks of the removed routes, and may be
+         * calling them from their own threads, so these are kept alive and retired: they are
+         * never written, and do nothing once their route is flagged as retired.
+         */
+        for (const std::string& topic_name : changes.removed_topics)
+        {
+            const auto it = _topic_resources.find(topic_name);
+            if (it == _topic_resources.end())
+            {
+                continue;
+            }
+
+            for (const auto& unsubscribe : it->second.unsubscribe)
+            {
+                if (!unsubscribe())
+                {
+                    _logger << utils::Logger::Level::WARN
+                            << "Could not unsubscribe from the topic '" << topic_name
+                            << "', its messages will be discarded." << std::endl;
+                }
+            }
+
+            it->second.retired->store(true, std::memory_order_release);
+
+            for (const auto& release : it->second.release)
+            {
+                release();
+            }
+
+            _topic_resources.erase(it);
+            _metrics.remove("topic", topic_name);
+        }
+
+        for (const std::string& service_name : changes.removed_services)
+        {
+            const auto it = _service_resources.find(service_name);
+            if (it == _service_resources.end())
+            {
+                continue;
+            }
+
+            it->second.retired->store(true, std::memory_order_release);
+
+            _logger << utils::Logger::Level::WARN
+                    << "The clients of the service '" << service_name << "' cannot be removed "
+                    << "from their middlewares, its requests will be discarded." << std::endl;
+
+            _service_resources.erase(it);
+            _metrics.remove("service", service_name);
+        }
+    }
+
+    /**
+     * Routes post their tasks to the shared executor, so that they are run by its threads
+     * instead of by the threads of the SystemHandles that trigger them.
+     */
+    TaskScheduler _route_task_scheduler()
+    {
+        return [this](std::function<void ()> task, std::chrono::steady_clock::duration delay)
+               {
+                   _executor.post(std::move(task), delay);
+               };
+    }
+
+    void _wake_all()
+    {
+        _executor.wake_all();
+        for (SpinExecutor& executor : _reserved_executors)
+        {
+            executor.wake_all();
+        }
+    }
+
+    void _runner_finished()
+    {
+        if (--_active_middlewares == 0)
+        {
+            _finished();
+        }
+    }
+
     void _finished()
     {
         {
@@ -265,10 +995,50 @@ private:
 
     internal::Config _configuration;
 
+    std::string _config_file;
+
+    /**
+     * Configurations of the routes added by reloads, which must outlive their callbacks.
+     */
+    std::list<internal::Config> _reloaded_configurations;
+
+    std::map<std::string, internal::RouteResources> _topic_resources;
+
+    std::map<std::string, internal::RouteResources> _service_resources;
+
+    /**
+     * Priority dispatchers of the destination middlewares, shared by the topics
+     * configured on start and by the ones added by reloads.
+     */
+    internal::PriorityDispatchers _dispatchers;
+
+    std::mutex _reload_mutex;
+
+    std::mutex _reload_gate;
+
+    std::shared_mutex _routes_mutex;
+
+    SpinExecutor _executor;
+
+    /**
+     * Executors of the event-driven SystemHandles with thread settings, one for each of them.
+     */
+    std::list<SpinExecutor> _reserved_executors;
+
+    MetricsRegistry _metrics;
+
+    std::unique_ptr<MetricsExporter> _exporter;
+
+    std::shared_ptr<Tracer> _tracer;
+
+    std::shared_ptr<TrafficRecorder> _recorder;
+
     is::internal::SystemHandleInfoMap _info_map;
 
     internal::Config::SubscriptionCallbacks subscription_callbacks_;
 
+    internal::Config::RawSubscriptionCallbacks raw_subscription_callbacks_;
+
     internal::Config::RequestCallbacks request_callbacks_;
 
     std::atomic_bool _quit;
@@ -288,7 +1058,8 @@ public:
     Implementation(
             int argc,
             char* argv[])
-        : _early_return_code(1) // Assumes that an early return should be coded as 1
+        : _startup(std::chrono::steady_clock::now())
+        , _early_return_code(1) // Assumes that an early return should be coded as 1
         , _logger("is::core::Instance")
     {
         _run_instance = parse_arguments(argc, argv);
@@ -296,6 +1067,11 @@ public:
         {
             _run_instance = parse_configuration(YAML::LoadFile(_config_file));
         }
+
+        if (_run_instance && _shard_count > 1)
+        {
+            _configuration.select_shard(_shard_index, _shard_count, _shard_metrics_fd);
+        }
     }
 
     Implementation(
@@ -303,6 +1079,7 @@ public:
             const std::vector<std::string>& is_prefixes,
             const MiddlewarePrefixPathMap& middleware_prefixes,
             const std::string& config_file = "")
+        : _startup(std::chrono::steady_clock::now())
     {
         register_prefixes(is_prefixes, middleware_prefixes);
         _run_instance = parse_configuration(config_node);
@@ -361,6 +1138,24 @@ public:
                 "middleware prefix paths to use when searching for .mix files. The"
                 "environment variable IS_*_PREFIX_PATH can be set to a "
                 "colon-separated list instead of using this flag.")
+
+            ("profile-startup", boost::program_options::value<std::string>()->implicit_value(""),
+                "measure the wall time spent in each startup phase, middleware and route, "
+                "and log a breakdown once the instance is configured. If a file path is "
+                "given, the measurements are also written there in CSV format.")
+
+            ("shards", boost::program_options::value<std::size_t>(),
+                "split the topics and services among this number of worker processes, "
+                "supervised by the integration-service executable, so that the routing "
+                "throughput scales with the available cores.")
+
+            ("shard", boost::program_options::value<std::string>(),
+                "only run the share <index>/<count> of the topics and services. "
+                "Given by the supervisor to its worker processes.")
+
+            ("shard-metrics-fd", boost::program_options::value<int>()->default_value(-1),
+                "file descriptor where the route metrics are reported to the supervisor. "
+                "Given by the supervisor to its worker processes.")
         ;
 
         boost::program_options::positional_options_description p;
@@ -424,6 +1219,36 @@ public:
             return false;
         }
 
+        if (vm.count("shard"))
+        {
+            const std::string shard = vm["shard"].as<std::string>();
+            const std::size_t separator = shard.find('/');
+            try
+            {
+                _shard_index = std::stoul(shard.substr(0, separator));
+                _shard_count = separator == std::string::npos ? 0 : std::stoul(shard.substr(separator + 1));
+            }
+            catch (const std::exception&)
+            {
+                _shard_count = 0;
+            }
+
+            if (_shard_count == 0 || _shard_index >= _shard_count)
+            {
+                std::cerr << "The --shard argument must be given as <index>/<count>, "
+                          << "with an index lower than the count: " << shard << std::endl;
+                return false;
+            }
+
+            _shard_metrics_fd = vm["shard-metrics-fd"].as<int>();
+        }
+
+        if (vm.count("profile-startup"))
+        {
+            StartupProfile::global().enable();
+            _profile_file = vm["profile-startup"].as<std::string>();
+        }
+
         std::vector<std::string> is_prefixes;
         if (vm.count("is-prefix-path"))
         {
@@ -501,10 +1326,35 @@ public:
     bool parse_configuration(
             const YAML::Node& config_node)
     {
+        StartupProfile::Scope profile("phase", "parse configuration");
         _configuration = internal::Config(config_node, _config_file);
         return _configuration;
     }
 
+    /**
+     * Logs the startup profile, and exports it if a file was requested.
+     */
+    void report_startup_profile()
+    {
+        StartupProfile& profile = StartupProfile::global();
+        if (!profile.enabled())
+        {
+            return;
+        }
+
+        profile.add("phase", "total", std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - _startup));
+        profile.enable(false);
+
+        _logger << utils::Logger::Level::INFO << profile.report() << std::endl;
+
+        if (!_profile_file.empty() && !profile.export_csv(_profile_file))
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Could not write the startup profile to '" << _profile_file << "'." << std::endl;
+        }
+    }
+
     InstanceHandle run()
     {
         if (!_run_instance)
@@ -526,6 +1376,8 @@ public:
 
         std::shared_ptr<InstanceHandle::Implementation> handle
             = std::make_shared<InstanceHandle::Implementation>(_configuration);
+        handle->_config_file = _config_file;
+        report_startup_profile();
         handle->run();
 
         // Save a weak reference to this handle so that we can keep track of whether
@@ -540,6 +1392,13 @@ private:
     std::string _config_file;
     internal::Config _configuration;
 
+    std::chrono::steady_clock::time_point _startup;
+    std::string _profile_file;
+
+    std::size_t _shard_index = 0;
+    std::size_t _shard_count = 1;
+    int _shard_metrics_fd = -1;
+
     std::atomic_bool _run_instance;
     std::atomic_int _early_return_code;
 
@@ -614,6 +1473,31 @@ const TypeRegistry* InstanceHandle::type_registry(
     return _pimpl->type_registry(middleware_name);
 }
 
+//==============================================================================
+std::vector<RouteMetricsSnapshot> InstanceHandle::metrics() const
+{
+    return _pimpl->metrics();
+}
+
+//==============================================================================
+std::vector<TypeRegistrySnapshot> InstanceHandle::type_registries() const
+{
+    return _pimpl->type_registries();
+}
+
+//==============================================================================
+bool InstanceHandle::reload(
+        const YAML::Node& config_node)
+{
+    return _pimpl->reload(config_node);
+}
+
+//==============================================================================
+bool InstanceHandle::reload()
+{
+    return _pimpl->reload();
+}
+
 //==============================================================================
 InstanceHandle::InstanceHandle(
         std::shared_ptr<Implementation> impl)
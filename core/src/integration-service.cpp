@@ -17,15 +17,62 @@
  */
 
 #include <is/core/Instance.hpp>
+#include <is/core/runtime/ShardSupervisor.hpp>
+
+#include <atomic>
+#include <chrono>
+
+#include <csignal>
+
+namespace {
+
+std::atomic_bool reload_requested(false);
+
+#ifndef WIN32
+extern "C" void reload_handler(
+        int /*signal*/)
+{
+    reload_requested = true;
+}
+#endif //  WIN32
+
+} //  anonymous namespace
 
 /**
  * This very simple translation unit lets us spawn an *Integration Service* instance
  * and return its exit code once it's finished. This provides the main function
  * for the canonical `integration-service` command line program.
+ *
+ * If `--shards` is given, this process only supervises that number of worker processes,
+ * each one running an *Integration Service* instance with its share of the routes.
+ *
+ * Sending `SIGHUP` to the process reloads the routes of the configuration file,
+ * except on Windows, which has no such signal.
  */
 int main(
         int argc,
         char* argv[])
 {
-    return eprosima::is::run_instance(argc, argv).wait();
+    eprosima::is::core::ShardSupervisor supervisor(argc, argv);
+    if (supervisor.shards() > 0)
+    {
+        return supervisor.run();
+    }
+
+#ifndef WIN32
+    signal(SIGHUP, reload_handler);
+#endif //  WIN32
+
+    eprosima::is::core::InstanceHandle handle = eprosima::is::run_instance(argc, argv);
+    while (handle.running())
+    {
+        handle.wait_for(std::chrono::milliseconds(100));
+
+        if (reload_requested.exchange(false) && handle.running())
+        {
+            handle.reload();
+        }
+    }
+
+    return handle.wait();
 }
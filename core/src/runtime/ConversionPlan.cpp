@@ -0,0 +1,678 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/ConversionPlan.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+using xtypes::TypeKind;
+
+/**
+ * @brief Signature of the functions that convert a primitive value
+ *        from one primitive kind into another.
+ */
+using PrimitiveConverter = void (*)(
+    const xtypes::ReadableDynamicDataRef& from,
+    xtypes::WritableDynamicDataRef&& to);
+
+//==============================================================================
+template<typename From, typename To>
+void convert_primitive(
+        const xtypes::ReadableDynamicDataRef& from,
+        xtypes::WritableDynamicDataRef&& to)
+{
+    to.value<To>(static_cast<To>(from.value<From>()));
+}
+
+//==============================================================================
+template<typename From>
+PrimitiveConverter select_primitive_converter(
+        TypeKind to)
+{
+    switch (to)
+    {
+        case TypeKind::BOOLEAN_TYPE: return &convert_primitive<From, bool>;
+        case TypeKind::BYTE_TYPE: return &convert_primitive<From, uint8_t>;
+        case TypeKind::UINT_8_TYPE: return &convert_primitive<From, uint8_t>;
+        case TypeKind::INT_8_TYPE: return &convert_primitive<From, int8_t>;
+        case TypeKind::INT_16_TYPE: return &convert_primitive<From, int16_t>;
+        case TypeKind::UINT_16_TYPE: return &convert_primitive<From, uint16_t>;
+        case TypeKind::INT_32_TYPE: return &convert_primitive<From, int32_t>;
+        case TypeKind::UINT_32_TYPE: return &convert_primitive<From, uint32_t>;
+        case TypeKind::INT_64_TYPE: return &convert_primitive<From, int64_t>;
+        case TypeKind::UINT_64_TYPE: return &convert_primitive<From, uint64_t>;
+        case TypeKind::FLOAT_32_TYPE: return &convert_primitive<From, float>;
+        case TypeKind::FLOAT_64_TYPE: return &convert_primitive<From, double>;
+        case TypeKind::FLOAT_128_TYPE: return &convert_primitive<From, long double>;
+        case TypeKind::CHAR_8_TYPE: return &convert_primitive<From, char>;
+        case TypeKind::CHAR_16_TYPE: return &convert_primitive<From, char16_t>;
+        case TypeKind::WIDE_CHAR_TYPE: return &convert_primitive<From, wchar_t>;
+        default: return nullptr;
+    }
+}
+
+//==============================================================================
+PrimitiveConverter select_primitive_converter(
+        TypeKind from,
+        TypeKind to)
+{
+    switch (from)
+    {
+        case TypeKind::BOOLEAN_TYPE: return select_primitive_converter<bool>(to);
+        case TypeKind::BYTE_TYPE: return select_primitive_converter<uint8_t>(to);
+        case TypeKind::UINT_8_TYPE: return select_primitive_converter<uint8_t>(to);
+        case TypeKind::INT_8_TYPE: return select_primitive_converter<int8_t>(to);
+        case TypeKind::INT_16_TYPE: return select_primitive_converter<int16_t>(to);
+        case TypeKind::UINT_16_TYPE: return select_primitive_converter<uint16_t>(to);
+        case TypeKind::INT_32_TYPE: return select_primitive_converter<int32_t>(to);
+        case TypeKind::UINT_32_TYPE: return select_primitive_converter<uint32_t>(to);
+        case TypeKind::INT_64_TYPE: return select_primitive_converter<int64_t>(to);
+        case TypeKind::UINT_64_TYPE: return select_primitive_converter<uint64_t>(to);
+        case TypeKind::FLOAT_32_TYPE: return select_primitive_converter<float>(to);
+        case TypeKind::FLOAT_64_TYPE: return select_primitive_converter<double>(to);
+        case TypeKind::FLOAT_128_TYPE: return select_primitive_converter<long double>(to);
+        case TypeKind::CHAR_8_TYPE: return select_primitive_converter<char>(to);
+        case TypeKind::CHAR_16_TYPE: return select_primitive_converter<char16_t>(to);
+        case TypeKind::WIDE_CHAR_TYPE: return select_primitive_converter<wchar_t>(to);
+        default: return nullptr;
+    }
+}
+
+/**
+ * @brief A single step of a conversion plan. Steps are nested following
+ *        the structure of the target type.
+ */
+struct Step
+{
+    enum class Kind
+    {
+        COPY,
+        PRIMITIVE,
+        STRING,
+        WSTRING,
+        STRUCTURE,
+        SEQUENCE,
+        ARRAY,
+        PROJECTION
+    };
+
+    struct MemberStep
+    {
+        size_t index;
+        std::unique_ptr<Step> step;
+
+        /**
+         * Used by PROJECTION steps: the indexes followed from the source data down to
+         * the projected member, which is converted into the target member `index`.
+         */
+        std::vector<size_t> path;
+    };
+
+    Kind kind = Kind::COPY;
+
+    /**
+     * Used by PRIMITIVE steps.
+     */
+    PrimitiveConverter primitive = nullptr;
+
+    /**
+     * Target bound for STRING, WSTRING and SEQUENCE steps (0 means unbounded),
+     * and number of elements to convert for ARRAY steps.
+     */
+    size_t bound = 0;
+
+    /**
+     * Element conversion used by SEQUENCE and ARRAY steps.
+     */
+    std::unique_ptr<Step> element;
+
+    /**
+     * Member conversions used by STRUCTURE and PROJECTION steps. Members of the source
+     * type that do not exist in the target type are simply not present here.
+     */
+    std::vector<MemberStep> members;
+};
+
+//==============================================================================
+void run_step(
+        const Step& step,
+        const xtypes::ReadableDynamicDataRef& from,
+        xtypes::WritableDynamicDataRef&& to)
+{
+    switch (step.kind)
+    {
+        case Step::Kind::COPY:
+        {
+            to = from;
+            break;
+        }
+        case Step::Kind::PRIMITIVE:
+        {
+            step.primitive(from, std::move(to));
+            break;
+        }
+        case Step::Kind::STRING:
+        {
+            const std::string& value = from.value<std::string>();
+            if (step.bound == 0 || value.size() <= step.bound)
+            {
+                to.value<std::string>(value);
+            }
+            else
+            {
+                to.value<std::string>(value.substr(0, step.bound));
+            }
+            break;
+        }
+        case Step::Kind::WSTRING:
+        {
+            const std::wstring& value = from.value<std::wstring>();
+            if (step.bound == 0 || value.size() <= step.bound)
+            {
+                to.value<std::wstring>(value);
+            }
+            else
+            {
+                to.value<std::wstring>(value.substr(0, step.bound));
+            }
+            break;
+        }
+        case Step::Kind::STRUCTURE:
+        {
+            for (const Step::MemberStep& member : step.members)
+            {
+                run_step(*member.step, from[member.index], to[member.index]);
+            }
+            break;
+        }
+        case Step::Kind::SEQUENCE:
+        {
+            size_t size = from.size();
+            if (step.bound != 0 && size > step.bound)
+            {
+                size = step.bound;
+            }
+
+            to.resize(size);
+            for (size_t i = 0; i < size; ++i)
+            {
+                run_step(*step.element, from[i], to[i]);
+            }
+            break;
+        }
+        case Step::Kind::ARRAY:
+        {
+            for (size_t i = 0; i < step.bound; ++i)
+            {
+                run_step(*step.element, from[i], to[i]);
+            }
+            break;
+        }
+        case Step::Kind::PROJECTION:
+        {
+            for (const Step::MemberStep& member : step.members)
+            {
+                xtypes::ReadableDynamicDataRef projected = from;
+                for (size_t index : member.path)
+                {
+                    projected = projected[index];
+                }
+                run_step(*member.step, projected, to[member.index]);
+            }
+            break;
+        }
+    }
+}
+
+//==============================================================================
+std::unique_ptr<Step> compile_step(
+        const xtypes::DynamicType& from,
+        const xtypes::DynamicType& to)
+{
+    const xtypes::TypeConsistency consistency = to.is_compatible(from);
+    if (consistency == xtypes::TypeConsistency::NONE)
+    {
+        return nullptr;
+    }
+
+    std::unique_ptr<Step> step(new Step());
+
+    if (consistency == xtypes::TypeConsistency::EQUALS)
+    {
+        step->kind = Step::Kind::COPY;
+        return step;
+    }
+
+    if (from.is_primitive_type() && to.is_primitive_type())
+    {
+        step->kind = Step::Kind::PRIMITIVE;
+        step->primitive = select_primitive_converter(from.kind(), to.kind());
+        return step->primitive ? std::move(step) : nullptr;
+    }
+
+    if (from.kind() != to.kind())
+    {
+        return nullptr;
+    }
+
+    switch (to.kind())
+    {
+        case TypeKind::STRING_TYPE:
+        case TypeKind::WSTRING_TYPE:
+        {
+            step->kind = TypeKind::STRING_TYPE == to.kind() ? Step::Kind::STRING : Step::Kind::WSTRING;
+            step->bound = static_cast<const xtypes::CollectionType&>(to).bounds();
+            return step;
+        }
+        case TypeKind::SEQUENCE_TYPE:
+        case TypeKind::ARRAY_TYPE:
+        {
+            const xtypes::CollectionType& from_collection = static_cast<const xtypes::CollectionType&>(from);
+            const xtypes::CollectionType& to_collection = static_cast<const xtypes::CollectionType&>(to);
+
+            step->element = compile_step(from_collection.content_type(), to_collection.content_type());
+            if (!step->element)
+            {
+                return nullptr;
+            }
+
+            if (TypeKind::SEQUENCE_TYPE == to.kind())
+            {
+                step->kind = Step::Kind::SEQUENCE;
+                step->bound = to_collection.bounds();
+            }
+            else
+            {
+                step->kind = Step::Kind::ARRAY;
+                step->bound = std::min(
+                    static_cast<const xtypes::ArrayType&>(from).dimension(),
+                    static_cast<const xtypes::ArrayType&>(to).dimension());
+            }
+            return step;
+        }
+        case TypeKind::STRUCTURE_TYPE:
+        {
+            /**
+             * Members are matched by position, as xtypes does when converting
+             * between compatible structures. Trailing members of the source type
+             * are dropped, and trailing members of the target type keep their defaults.
+             */
+            const xtypes::AggregationType& from_struct = static_cast<const xtypes::AggregationType&>(from);
+            const xtypes::AggregationType& to_struct = static_cast<const xtypes::AggregationType&>(to);
+            const size_t count = std::min(from_struct.members().size(), to_struct.members().size());
+
+            step->kind = Step::Kind::STRUCTURE;
+            step->members.reserve(count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                std::unique_ptr<Step> member_step = compile_step(
+                    from_struct.member(i).type(), to_struct.member(i).type());
+                if (!member_step)
+                {
+                    return nullptr;
+                }
+
+                step->members.push_back(Step::MemberStep{i, std::move(member_step), {}});
+            }
+            return step;
+        }
+        default:
+        {
+            // Unions, maps, aliases and enumerations are left to the generic conversion.
+            return nullptr;
+        }
+    }
+}
+
+//==============================================================================
+/**
+ * @brief Compiles the extraction of a list of members of the source type, given by their
+ *        dot separated paths, into the consecutive members of the target type.
+ */
+std::unique_ptr<Step> compile_projection(
+        const xtypes::DynamicType& from,
+        const xtypes::DynamicType& to,
+        const std::vector<std::string>& paths,
+        xtypes::TypeConsistency& consistency,
+        std::string& error)
+{
+    if (to.kind() != TypeKind::STRUCTURE_TYPE)
+    {
+        error = "the type '" + to.name() + "' is not a structure";
+        return nullptr;
+    }
+
+    const xtypes::AggregationType& to_struct = static_cast<const xtypes::AggregationType&>(to);
+    if (to_struct.members().size() != paths.size())
+    {
+        error = "the type '" + to.name() + "' has " + std::to_string(to_struct.members().size())
+                + " members, but " + std::to_string(paths.size()) + " members are projected";
+        return nullptr;
+    }
+
+    std::unique_ptr<Step> step(new Step());
+    step->kind = Step::Kind::PROJECTION;
+    consistency = xtypes::TypeConsistency::IGNORE_MEMBERS | xtypes::TypeConsistency::IGNORE_MEMBER_NAMES;
+
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        Step::MemberStep member{i, nullptr, {}};
+
+        const xtypes::DynamicType* projected = &from;
+        size_t begin = 0;
+        while (begin <= paths[i].size())
+        {
+            const size_t end = std::min(paths[i].find('.', begin), paths[i].size());
+            const std::string name = paths[i].substr(begin, end - begin);
+
+            size_t index = 0;
+            const std::vector<xtypes::Member>* members = nullptr;
+            if (projected->kind() == TypeKind::STRUCTURE_TYPE)
+            {
+                members = &static_cast<const xtypes::AggregationType*>(projected)->members();
+                while (index < members->size() && (*members)[index].name() != name)
+                {
+                    ++index;
+                }
+            }
+
+            if (!members || index == members->size())
+            {
+                error = "the member '" + paths[i] + "' does not exist in the type '" + from.name() + "'";
+                return nullptr;
+            }
+
+            member.path.push_back(index);
+            projected = &(*members)[index].type();
+            begin = end + 1;
+        }
+
+        const xtypes::DynamicType& target = to_struct.member(i).type();
+        member.step = compile_step(*projected, target);
+        if (!member.step)
+        {
+            error = "the member '" + paths[i] + "' cannot be converted into the member '"
+                    + to_struct.member(i).name() + "' of the type '" + to.name() + "'";
+            return nullptr;
+        }
+
+        consistency |= target.is_compatible(*projected);
+        step->members.push_back(std::move(member));
+    }
+
+    return step;
+}
+
+} //  anonymous namespace
+
+class ConversionPlan::Implementation
+{
+public:
+
+    Implementation(
+            const xtypes::DynamicType& source_type,
+            const xtypes::DynamicType& target_type,
+            xtypes::TypeConsistency consistency,
+            std::unique_ptr<Step> root)
+        : _source_type(source_type)
+        , _target_type(target_type)
+        , _consistency(consistency)
+        , _root(std::move(root))
+    {
+    }
+
+    ~Implementation() = default;
+
+    const xtypes::DynamicType& source_type() const
+    {
+        return _source_type;
+    }
+
+    const xtypes::DynamicType& target_type() const
+    {
+        return _target_type;
+    }
+
+    xtypes::TypeConsistency consistency() const
+    {
+        return _consistency;
+    }
+
+    xtypes::DynamicData convert(
+            const xtypes::ReadableDynamicDataRef& from) const
+    {
+        xtypes::DynamicData result(_target_type);
+        apply(from, result);
+        return result;
+    }
+
+    void apply(
+            const xtypes::ReadableDynamicDataRef& from,
+            xtypes::DynamicData& to) const
+    {
+        run_step(*_root, from, std::move(to));
+    }
+
+private:
+
+    const xtypes::DynamicType& _source_type;
+    const xtypes::DynamicType& _target_type;
+    const xtypes::TypeConsistency _consistency;
+    const std::unique_ptr<Step> _root;
+};
+
+//==============================================================================
+std::shared_ptr<const ConversionPlan> ConversionPlan::compile(
+        const xtypes::DynamicType& source_type,
+        const xtypes::DynamicType& target_type)
+{
+    std::unique_ptr<Step> root = compile_step(source_type, target_type);
+    if (!root)
+    {
+        return nullptr;
+    }
+
+    return std::shared_ptr<const ConversionPlan>(
+        new ConversionPlan(std::make_unique<Implementation>(
+            source_type, target_type, target_type.is_compatible(source_type), std::move(root))));
+}
+
+//==============================================================================
+std::shared_ptr<const ConversionPlan> ConversionPlan::project(
+        const xtypes::DynamicType& source_type,
+        const xtypes::DynamicType& target_type,
+        const std::vector<std::string>& members,
+        std::string& error)
+{
+    xtypes::TypeConsistency consistency;
+    std::unique_ptr<Step> root = compile_projection(source_type, target_type, members, consistency, error);
+    if (!root)
+    {
+        return nullptr;
+    }
+
+    return std::shared_ptr<const ConversionPlan>(
+        new ConversionPlan(std::make_unique<Implementation>(
+            source_type, target_type, consistency, std::move(root))));
+}
+
+//==============================================================================
+ConversionPlan::ConversionPlan(
+        std::unique_ptr<Implementation> pimpl)
+    : _pimpl(std::move(pimpl))
+{
+}
+
+//==============================================================================
+ConversionPlan::~ConversionPlan() = default;
+
+//==============================================================================
+const xtypes::DynamicType& ConversionPlan::source_type() const
+{
+    return _pimpl->source_type();
+}
+
+//==============================================================================
+const xtypes::DynamicType& ConversionPlan::target_type() const
+{
+    return _pimpl->target_type();
+}
+
+//==============================================================================
+xtypes::TypeConsistency ConversionPlan::consistency() const
+{
+    return _pimpl->consistency();
+}
+
+//==============================================================================
+xtypes::DynamicData ConversionPlan::convert(
+        const xtypes::ReadableDynamicDataRef& from) const
+{
+    return _pimpl->convert(from);
+}
+
+//==============================================================================
+void ConversionPlan::apply(
+        const xtypes::ReadableDynamicDataRef& from,
+        xtypes::DynamicData& to) const
+{
+    _pimpl->apply(from, to);
+}
+
+//==============================================================================
+ConversionCache::Entry ConversionCache::get(
+        const xtypes::DynamicType& source_type,
+        const xtypes::DynamicType& target_type)
+{
+    const Key key(&source_type, &target_type);
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto it = _entries.find(key);
+        if (it != _entries.end())
+        {
+            return it->second;
+        }
+    }
+
+    /**
+     * The plan is compiled without holding the lock; if another thread
+     * computed the same pair meanwhile, its entry is kept.
+     */
+    Entry entry;
+    entry.consistency = consistency(target_type, source_type);
+    if (entry.consistency != xtypes::TypeConsistency::EQUALS
+            && entry.consistency != xtypes::TypeConsistency::NONE)
+    {
+        entry.plan = ConversionPlan::compile(source_type, target_type);
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _entries.emplace(key, std::move(entry)).first->second;
+}
+
+//==============================================================================
+xtypes::TypeConsistency ConversionCache::consistency(
+        const xtypes::DynamicType& type,
+        const xtypes::DynamicType& other)
+{
+    const Key key(&type, &other);
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto it = _consistencies.find(key);
+        if (it != _consistencies.end())
+        {
+            return it->second;
+        }
+    }
+
+    const xtypes::TypeConsistency result = type.is_compatible(other);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _consistencies.emplace(key, result).first->second;
+}
+
+//==============================================================================
+void ConversionCache::precompute(
+        const std::vector<Key>& pairs,
+        std::size_t max_threads)
+{
+    std::vector<Key> pending;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        std::unordered_set<Key, KeyHash> seen;
+        for (const Key& key : pairs)
+        {
+            if (_consistencies.count(key) == 0 && seen.insert(key).second)
+            {
+                pending.push_back(key);
+            }
+        }
+    }
+
+    if (max_threads == 0)
+    {
+        max_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    /**
+     * Each worker takes the next unchecked pair until none is left,
+     * so that a few expensive pairs do not hold back the rest.
+     */
+    std::atomic<std::size_t> next(0);
+    auto worker = [&]()
+            {
+                for (std::size_t i = next++; i < pending.size(); i = next++)
+                {
+                    consistency(*pending[i].first, *pending[i].second);
+                }
+            };
+
+    std::vector<std::thread> workers;
+    const std::size_t threads = std::min(max_threads, pending.size());
+    for (std::size_t i = 1; i < threads; ++i)
+    {
+        workers.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread& thread : workers)
+    {
+        thread.join();
+    }
+}
+
+//==============================================================================
+std::size_t ConversionCache::size() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
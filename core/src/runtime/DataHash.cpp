@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/DataHash.hpp>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+//==============================================================================
+void mix_bytes(
+        std::size_t& hash,
+        const void* data,
+        std::size_t size)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+}
+
+//==============================================================================
+template<typename T>
+void mix_value(
+        std::size_t& hash,
+        const xtypes::ReadableDynamicDataRef& data)
+{
+    const T value = data.value<T>();
+    mix_bytes(hash, &value, sizeof(T));
+}
+
+} //  anonymous namespace
+
+//==============================================================================
+std::size_t DataHash::of(
+        const xtypes::ReadableDynamicDataRef& data)
+{
+    std::size_t hash = 14695981039346656037ull;
+
+    data.for_each([&](const xtypes::ReadableDynamicDataRef::ReadableNode& node)
+            {
+                using xtypes::TypeKind;
+
+                const TypeKind kind = node.type().kind();
+                mix_bytes(hash, &kind, sizeof(kind));
+
+                switch (kind)
+                {
+                    case TypeKind::BOOLEAN_TYPE: mix_value<bool>(hash, node.data()); break;
+                    case TypeKind::BYTE_TYPE: mix_value<uint8_t>(hash, node.data()); break;
+                    case TypeKind::UINT_8_TYPE: mix_value<uint8_t>(hash, node.data()); break;
+                    case TypeKind::INT_8_TYPE: mix_value<int8_t>(hash, node.data()); break;
+                    case TypeKind::INT_16_TYPE: mix_value<int16_t>(hash, node.data()); break;
+                    case TypeKind::UINT_16_TYPE: mix_value<uint16_t>(hash, node.data()); break;
+                    case TypeKind::INT_32_TYPE: mix_value<int32_t>(hash, node.data()); break;
+                    case TypeKind::UINT_32_TYPE: mix_value<uint32_t>(hash, node.data()); break;
+                    case TypeKind::INT_64_TYPE: mix_value<int64_t>(hash, node.data()); break;
+                    case TypeKind::UINT_64_TYPE: mix_value<uint64_t>(hash, node.data()); break;
+                    case TypeKind::FLOAT_32_TYPE: mix_value<float>(hash, node.data()); break;
+                    case TypeKind::FLOAT_64_TYPE: mix_value<double>(hash, node.data()); break;
+                    case TypeKind::CHAR_8_TYPE: mix_value<char>(hash, node.data()); break;
+                    case TypeKind::CHAR_16_TYPE: mix_value<char16_t>(hash, node.data()); break;
+                    case TypeKind::WIDE_CHAR_TYPE: mix_value<wchar_t>(hash, node.data()); break;
+                    case TypeKind::STRING_TYPE:
+                    {
+                        const std::string& value = node.data().value<std::string>();
+                        mix_bytes(hash, value.data(), value.size());
+                        break;
+                    }
+                    case TypeKind::WSTRING_TYPE:
+                    {
+                        const std::wstring& value = node.data().value<std::wstring>();
+                        mix_bytes(hash, value.data(), value.size() * sizeof(wchar_t));
+                        break;
+                    }
+                    case TypeKind::ARRAY_TYPE:
+                    case TypeKind::SEQUENCE_TYPE:
+                    case TypeKind::MAP_TYPE:
+                    {
+                        const std::size_t size = node.data().size();
+                        mix_bytes(hash, &size, sizeof(size));
+                        break;
+                    }
+                    default:
+                        break;
+                }
+            });
+
+    return hash;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/DispatchQueue.hpp>
+#include <is/core/runtime/MemoryUsage.hpp>
+#include <is/utils/Log.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+class DispatchQueue::Implementation
+{
+public:
+
+    Implementation(
+            const std::string& name,
+            std::size_t depth,
+            Policy policy,
+            Consumer consumer)
+        : _name(name)
+        , _depth(depth > 0 ? depth : 1)
+        , _policy(policy)
+        , _consumer(std::move(consumer))
+        , _stop(false)
+        , _bytes(0)
+        , _dropped(0)
+        , _logger("is::core::DispatchQueue")
+    {
+        _worker = std::thread(&Implementation::work, this);
+    }
+
+    ~Implementation()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+
+        _not_empty.notify_all();
+        _not_full.notify_all();
+
+        if (_worker.joinable())
+        {
+            _worker.join();
+        }
+    }
+
+    PushResult push(
+            std::shared_ptr<const xtypes::DynamicData> message)
+    {
+        bool evicted = false;
+        const std::size_t bytes = message ? MemoryUsage::of(*message) : 0;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_queue.size() >= _depth)
+            {
+                switch (_policy)
+                {
+                    case Policy::DROP_OLDEST:
+                    {
+                        _bytes -= _queue.front().bytes;
+                        _queue.pop_front();
+                        evicted = true;
+                        break;
+                    }
+                    case Policy::DROP_NEWEST:
+                    {
+                        ++_dropped;
+                        return PushResult::DROPPED;
+                    }
+                    case Policy::BLOCK:
+                    {
+                        _not_full.wait(lock, [this]()
+                                {
+                                    return _stop || _queue.size() < _depth;
+                                });
+
+                        if (_stop)
+                        {
+                            return PushResult::QUEUED;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            _queue.push_back({std::move(message), bytes});
+            _bytes += bytes;
+        }
+
+        _not_empty.notify_one();
+
+        if (evicted)
+        {
+            ++_dropped;
+            return PushResult::EVICTED;
+        }
+
+        return PushResult::QUEUED;
+    }
+
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _queue.size();
+    }
+
+    std::size_t bytes() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _bytes;
+    }
+
+    uint64_t dropped() const
+    {
+        return _dropped;
+    }
+
+private:
+
+    /**
+     * @brief A queued message, along with its estimated size.
+     */
+    struct Entry
+    {
+        std::shared_ptr<const xtypes::DynamicData> message;
+        std::size_t bytes;
+    };
+
+    void work()
+    {
+        while (true)
+        {
+            std::shared_ptr<const xtypes::DynamicData> message;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _not_empty.wait(lock, [this]()
+                        {
+                            return _stop || !_queue.empty();
+                        });
+
+                if (_stop)
+                {
+                    return;
+                }
+
+                message = std::move(_queue.front().message);
+                _bytes -= _queue.front().bytes;
+                _queue.pop_front();
+            }
+
+            _not_full.notify_one();
+
+            try
+            {
+                _consumer(message);
+            }
+            catch (const std::exception& e)
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "Dispatch queue '" << _name << "' failed to deliver a message: "
+                        << e.what() << std::endl;
+            }
+        }
+    }
+
+    const std::string _name;
+    const std::size_t _depth;
+    const Policy _policy;
+    const Consumer _consumer;
+
+    std::deque<Entry> _queue;
+    bool _stop;
+    std::size_t _bytes;
+    std::atomic<uint64_t> _dropped;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::condition_variable _not_full;
+    std::thread _worker;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+DispatchQueue::DispatchQueue(
+        const std::string& name,
+        std::size_t depth,
+        Policy policy,
+        Consumer consumer)
+    : _pimpl(new Implementation(name, depth, policy, std::move(consumer)))
+{
+}
+
+//==============================================================================
+DispatchQueue::~DispatchQueue() = default;
+
+//==============================================================================
+DispatchQueue::PushResult DispatchQueue::push(
+        std::shared_ptr<const xtypes::DynamicData> message)
+{
+    return _pimpl->push(std::move(message));
+}
+
+//==============================================================================
+std::size_t DispatchQueue::size() const
+{
+    return _pimpl->size();
+}
+
+//==============================================================================
+std::size_t DispatchQueue::bytes() const
+{
+    return _pimpl->bytes();
+}
+
+//==============================================================================
+uint64_t DispatchQueue::dropped() const
+{
+    return _pimpl->dropped();
+}
+
+//==============================================================================
+bool DispatchQueue::parse_policy(
+        const std::string& name,
+        Policy& policy)
+{
+    if (name == "drop_oldest")
+    {
+        policy = Policy::DROP_OLDEST;
+    }
+    else if (name == "drop_newest")
+    {
+        policy = Policy::DROP_NEWEST;
+    }
+    else if (name == "block")
+    {
+        policy = Policy::BLOCK;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
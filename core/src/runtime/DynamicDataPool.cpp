@@ -0,0 +1,325 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/DynamicDataPool.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+using xtypes::TypeKind;
+
+//==============================================================================
+/**
+ * @brief Tells whether the instances of a type may hold data that later writes
+ *        cannot fully overwrite, so that they must be reset before being reused.
+ */
+bool needs_reset(
+        const xtypes::DynamicType& type)
+{
+    switch (type.kind())
+    {
+        case TypeKind::SEQUENCE_TYPE:
+        case TypeKind::MAP_TYPE:
+        case TypeKind::UNION_TYPE:
+            return true;
+        case TypeKind::ALIAS_TYPE:
+            return needs_reset(static_cast<const xtypes::AliasType&>(type).rget());
+        case TypeKind::ARRAY_TYPE:
+            return needs_reset(static_cast<const xtypes::CollectionType&>(type).content_type());
+        case TypeKind::STRUCTURE_TYPE:
+        {
+            const xtypes::StructType& structure = static_cast<const xtypes::StructType&>(type);
+            for (const xtypes::Member& member : structure.members())
+            {
+                if (needs_reset(member.type()))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        default:
+            return false;
+    }
+}
+
+} //  anonymous namespace
+
+class DynamicDataPool::Implementation
+    : public std::enable_shared_from_this<DynamicDataPool::Implementation>
+{
+public:
+
+    Implementation(
+            const xtypes::DynamicType& type,
+            std::size_t capacity)
+        : _type(type)
+        , _capacity(capacity)
+        , _block_size(0)
+        , _created(0)
+    {
+        if (needs_reset(type))
+        {
+            _blank.reset(new xtypes::DynamicData(type));
+        }
+
+        // Neither list grows beyond the capacity, so recycling never allocates.
+        _idle.reserve(capacity);
+        _blocks.reserve(capacity);
+    }
+
+    ~Implementation()
+    {
+        for (void* block : _blocks)
+        {
+            ::operator delete(block);
+        }
+    }
+
+    std::shared_ptr<xtypes::DynamicData> acquire()
+    {
+        std::unique_ptr<xtypes::DynamicData> data;
+        void* block = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!_idle.empty())
+            {
+                data = std::move(_idle.back());
+                _idle.pop_back();
+            }
+            if (!_blocks.empty())
+            {
+                block = _blocks.back();
+                _blocks.pop_back();
+            }
+        }
+
+        if (!data)
+        {
+            data.reset(new xtypes::DynamicData(_type));
+            ++_created;
+        }
+
+        /**
+         * The control block of the returned pointer is allocated along with its Slot,
+         * in a block kept from a previously released instance, if any.
+         */
+        const std::shared_ptr<Slot> slot = std::allocate_shared<Slot>(
+            BlockAllocator<Slot>(shared_from_this(), block), *this, std::move(data));
+        return std::shared_ptr<xtypes::DynamicData>(slot, slot->data.get());
+    }
+
+    const xtypes::DynamicType& type() const
+    {
+        return _type;
+    }
+
+    std::size_t idle() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _idle.size();
+    }
+
+    uint64_t created() const
+    {
+        return _created;
+    }
+
+private:
+
+    /**
+     * A borrowed instance, which goes back to the pool when it is destroyed.
+     * The allocator stored in its control block keeps the pool alive meanwhile.
+     */
+    struct Slot
+    {
+        Slot(
+                Implementation& pool_,
+                std::unique_ptr<xtypes::DynamicData>&& data_)
+            : pool(pool_)
+            , data(std::move(data_))
+        {
+        }
+
+        ~Slot()
+        {
+            pool.recycle(std::move(data));
+        }
+
+        Implementation& pool;
+        std::unique_ptr<xtypes::DynamicData> data;
+    };
+
+    /**
+     * Allocates the control blocks of the borrowed instances, reusing a block given by the pool,
+     * and gives them back to the pool when they are deallocated.
+     */
+    template<typename T>
+    struct BlockAllocator
+    {
+        using value_type = T;
+
+        BlockAllocator(
+                std::shared_ptr<Implementation> pool_,
+                void* block_)
+            : pool(std::move(pool_))
+            , block(block_)
+        {
+        }
+
+        template<typename U>
+        BlockAllocator(
+                const BlockAllocator<U>& other)
+            : pool(other.pool)
+            , block(other.block)
+        {
+        }
+
+        T* allocate(
+                std::size_t n)
+        {
+            // Every control block of the pool has the same size, that of the given block.
+            if (block != nullptr)
+            {
+                return static_cast<T*>(std::exchange(block, nullptr));
+            }
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(
+                T* pointer,
+                std::size_t n)
+        {
+            pool->release_block(pointer, n * sizeof(T));
+        }
+
+        template<typename U>
+        bool operator ==(
+                const BlockAllocator<U>& other) const
+        {
+            return pool == other.pool;
+        }
+
+        template<typename U>
+        bool operator !=(
+                const BlockAllocator<U>& other) const
+        {
+            return pool != other.pool;
+        }
+
+        std::shared_ptr<Implementation> pool;
+        void* block;
+    };
+
+    void recycle(
+            std::unique_ptr<xtypes::DynamicData> data)
+    {
+        /**
+         * Assigning the blank instance reuses the storage of the instance itself,
+         * and only frees the elements of its sequences and maps.
+         */
+        if (_blank)
+        {
+            *data = *_blank;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_idle.size() < _capacity)
+        {
+            _idle.emplace_back(std::move(data));
+        }
+    }
+
+    void release_block(
+            void* block,
+            std::size_t size)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_block_size == 0)
+            {
+                _block_size = size;
+            }
+
+            if (size == _block_size && _blocks.size() < _capacity)
+            {
+                _blocks.push_back(block);
+                return;
+            }
+        }
+
+        ::operator delete(block);
+    }
+
+    const xtypes::DynamicType& _type;
+    const std::size_t _capacity;
+    std::unique_ptr<const xtypes::DynamicData> _blank;
+
+    std::vector<std::unique_ptr<xtypes::DynamicData> > _idle;
+    std::vector<void*> _blocks;
+    std::size_t _block_size;
+    std::atomic<uint64_t> _created;
+    mutable std::mutex _mutex;
+};
+
+//==============================================================================
+DynamicDataPool::DynamicDataPool(
+        const xtypes::DynamicType& type,
+        std::size_t capacity)
+    : _pimpl(std::make_shared<Implementation>(type, capacity))
+{
+}
+
+//==============================================================================
+DynamicDataPool::~DynamicDataPool() = default;
+
+//==============================================================================
+std::shared_ptr<xtypes::DynamicData> DynamicDataPool::acquire()
+{
+    return _pimpl->acquire();
+}
+
+//==============================================================================
+const xtypes::DynamicType& DynamicDataPool::type() const
+{
+    return _pimpl->type();
+}
+
+//==============================================================================
+std::size_t DynamicDataPool::idle() const
+{
+    return _pimpl->idle();
+}
+
+//==============================================================================
+uint64_t DynamicDataPool::created() const
+{
+    return _pimpl->created();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -18,13 +18,94 @@
 
 #include <is/core/runtime/FieldToString.hpp>
 
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <limits>
 #include <string>
-#include <unordered_map>
+#include <type_traits>
 
 namespace eprosima {
 namespace is {
 namespace core {
 
+namespace {
+
+using xtypes::TypeKind;
+
+//==============================================================================
+template<typename T>
+void append_integer(
+        T value,
+        std::string& output)
+{
+    char buffer[std::numeric_limits<T>::digits10 + 3];
+    const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    output.append(buffer, result.ptr);
+}
+
+/**
+ * Floating point values are written with six decimals, as `std::to_string()` does,
+ * so that the computed strings do not change with the formatting method.
+ */
+template<typename T>
+void append_floating_point(
+        T value,
+        std::string& output)
+{
+    char buffer[std::numeric_limits<T>::max_exponent10 + 16];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611
+    const std::to_chars_result result = std::to_chars(
+        buffer, buffer + sizeof(buffer), value, std::chars_format::fixed, 6);
+    output.append(buffer, result.ptr);
+#else
+    // Standard libraries without floating point std::to_chars, such as libstdc++ before GCC 11.
+    const int length = std::is_same<T, long double>::value
+            ? std::snprintf(buffer, sizeof(buffer), "%.6Lf", static_cast<long double>(value))
+            : std::snprintf(buffer, sizeof(buffer), "%.6f", static_cast<double>(value));
+    if (length > 0)
+    {
+        output.append(buffer, std::min<std::size_t>(static_cast<std::size_t>(length), sizeof(buffer) - 1));
+    }
+#endif //  __cpp_lib_to_chars
+}
+
+//==============================================================================
+template<typename T, typename As = T>
+void append_integer_field(
+        const xtypes::ReadableDynamicDataRef& field,
+        std::string& output)
+{
+    append_integer(static_cast<As>(field.value<T>()), output);
+}
+
+//==============================================================================
+template<typename T>
+void append_floating_point_field(
+        const xtypes::ReadableDynamicDataRef& field,
+        std::string& output)
+{
+    append_floating_point(field.value<T>(), output);
+}
+
+//==============================================================================
+void append_bool_field(
+        const xtypes::ReadableDynamicDataRef& field,
+        std::string& output)
+{
+    output += field.value<bool>() ? '1' : '0';
+}
+
+//==============================================================================
+void append_string_field(
+        const xtypes::ReadableDynamicDataRef& field,
+        std::string& output)
+{
+    output += field.value<std::string>();
+}
+
+} //  anonymous namespace
+
 class FieldToString::Implementation
 {
 public:
@@ -38,60 +119,61 @@ public:
         return instance;
     }
 
+    /**
+     * Characters are written as their numeric value, as `std::to_string()` does.
+     */
+    static Converter converter(
+            const xtypes::DynamicType& type)
+    {
+        switch (type.kind())
+        {
+            case TypeKind::STRING_TYPE: return &append_string_field;
+            case TypeKind::BOOLEAN_TYPE: return &append_bool_field;
+            case TypeKind::CHAR_8_TYPE: return &append_integer_field<char, int>;
+            case TypeKind::WIDE_CHAR_TYPE: return &append_integer_field<wchar_t, long>;
+            case TypeKind::BYTE_TYPE: return &append_integer_field<uint8_t, unsigned int>;
+            case TypeKind::INT_8_TYPE: return &append_integer_field<int8_t, int>;
+            case TypeKind::UINT_8_TYPE: return &append_integer_field<uint8_t, unsigned int>;
+            case TypeKind::INT_16_TYPE: return &append_integer_field<int16_t>;
+            case TypeKind::UINT_16_TYPE: return &append_integer_field<uint16_t>;
+            case TypeKind::INT_32_TYPE: return &append_integer_field<int32_t>;
+            case TypeKind::UINT_32_TYPE: return &append_integer_field<uint32_t>;
+            case TypeKind::INT_64_TYPE: return &append_integer_field<int64_t>;
+            case TypeKind::UINT_64_TYPE: return &append_integer_field<uint64_t>;
+            case TypeKind::FLOAT_32_TYPE: return &append_floating_point_field<float>;
+            case TypeKind::FLOAT_64_TYPE: return &append_floating_point_field<double>;
+            case TypeKind::FLOAT_128_TYPE: return &append_floating_point_field<long double>;
+            default: return nullptr;
+        }
+    }
+
     const std::string to_string(
             eprosima::xtypes::ReadableDynamicDataRef field,
             const std::string& field_name,
             const std::string& details)
     {
-        const std::string& type =
-                (field.type().name().find("std::string") != std::string::npos)
-                ? "std::string"
-                : field.type().name();
-
-        _logger << utils::Logger::Level::DEBUG << "Trying to convert type '" << type
-                << "' to string" << std::endl;
-        const auto it = _conversions.find(type);
+        IS_LOG(_logger, utils::Logger::Level::DEBUG) << "Trying to convert type '" << field.type().name()
+                                                     << "' to string" << std::endl;
 
-        if (it != _conversions.end())
+        const Converter convert = converter(field.type());
+        if (convert != nullptr)
         {
-            return it->second(field);
+            std::string result;
+            convert(field, result);
+            return result;
         }
 
-        _logger << utils::Logger::Level::ERROR << "Failed convert type '" << type
+        _logger << utils::Logger::Level::ERROR << "Failed convert type '" << field.type().name()
                 << "' to string" << std::endl;
 
-        throw UnknownFieldToStringCast(type, field_name, details);
+        throw UnknownFieldToStringCast(field.type().name(), field_name, details);
     }
 
 private:
 
-    using ConversionFunc = std::function<std::string (
-                        eprosima::xtypes::ReadableDynamicDataRef)>;
-    using ConversionMap = std::unordered_map<std::string, ConversionFunc>;
-
     Implementation()
         : _logger("is::core::FieldToString")
     {
-        _conversions["std::string"] =
-                [](xtypes::ReadableDynamicDataRef field) -> std::string
-                {
-                    return field;
-                };
-
-        add_primitive_conversion<bool>();
-        add_primitive_conversion<char>();
-        add_primitive_conversion<wchar_t>();
-        add_primitive_conversion<int8_t>();
-        add_primitive_conversion<uint8_t>();
-        add_primitive_conversion<int16_t>();
-        add_primitive_conversion<uint16_t>();
-        add_primitive_conversion<int32_t>();
-        add_primitive_conversion<uint32_t>();
-        add_primitive_conversion<int64_t>();
-        add_primitive_conversion<uint64_t>();
-        add_primitive_conversion<float>();
-        add_primitive_conversion<double>();
-        add_primitive_conversion<long double>();
     }
 
     Implementation(
@@ -102,25 +184,10 @@ private:
 
     ~Implementation() = default;
 
-    /**
-     * @brief Adds conversion functions for primitive types.
-     */
-    template<typename T>
-    void add_primitive_conversion()
-    {
-        _conversions[xtypes::primitive_type<T>().name()] =
-                [](xtypes::ReadableDynamicDataRef field) -> std::string
-                {
-                    T temp = field;
-                    return std::to_string(temp);
-                };
-    }
-
     /**
      * Class members.
      */
 
-    ConversionMap _conversions;
     utils::Logger _logger;
 };
 
@@ -156,6 +223,28 @@ const std::string FieldToString::to_string(
     return _pimpl.to_string(field, field_name, _details);
 }
 
+//==============================================================================
+bool FieldToString::append(
+        const eprosima::xtypes::ReadableDynamicDataRef& field,
+        std::string& output) const
+{
+    const Converter convert = Implementation::converter(field.type());
+    if (convert == nullptr)
+    {
+        return false;
+    }
+
+    convert(field, output);
+    return true;
+}
+
+//==============================================================================
+FieldToString::Converter FieldToString::converter(
+        const eprosima::xtypes::DynamicType& type)
+{
+    return Implementation::converter(type);
+}
+
 //==============================================================================
 const std::string& FieldToString::details() const
 {
@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/LazySubscription.hpp>
+#include <is/utils/Log.hpp>
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+class LazySubscription::Implementation
+    : public std::enable_shared_from_this<LazySubscription::Implementation>
+{
+public:
+
+    Implementation(
+            const std::string& name,
+            Scheduler scheduler)
+        : _name(name)
+        , _scheduler(std::move(scheduler))
+        , _listened(0)
+        , _active(false)
+        , _cancelled(false)
+        , _logger("is::core::LazySubscription")
+    {
+    }
+
+    MatchCallback watch()
+    {
+        std::size_t destination;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            destination = _matched.size();
+            _matched.push_back(0);
+        }
+
+        std::weak_ptr<Implementation> route = shared_from_this();
+        return [route, destination](std::size_t matched)
+               {
+                   if (std::shared_ptr<Implementation> alive = route.lock())
+                   {
+                       alive->matched(destination, matched);
+                   }
+               };
+    }
+
+    void add_source(
+            const std::string& source,
+            Action subscribe,
+            Action unsubscribe)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _sources.push_back(Source{source, std::move(subscribe), std::move(unsubscribe), false});
+        }
+
+        // Sources are added by the configuration thread, which can subscribe them right away.
+        apply();
+    }
+
+    bool active() const
+    {
+        return _active;
+    }
+
+    bool cancel()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cancelled = true;
+            _active = false;
+        }
+
+        return apply();
+    }
+
+private:
+
+    struct Source
+    {
+        std::string name;
+        Action subscribe;
+        Action unsubscribe;
+        bool subscribed;
+    };
+
+    void matched(
+            std::size_t destination,
+            std::size_t matched)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_cancelled)
+            {
+                return;
+            }
+
+            std::size_t& current = _matched[destination];
+            if ((current > 0) == (matched > 0))
+            {
+                current = matched;
+                return;
+            }
+
+            current = matched;
+            matched > 0 ? ++_listened : --_listened;
+
+            const bool active = _listened > 0;
+            if (active == _active)
+            {
+                return;
+            }
+
+            _logger << utils::Logger::Level::DEBUG
+                    << "The topic '" << _name << "' is " << (active ? "now" : "no longer")
+                    << " listened to by any remote endpoint." << std::endl;
+
+            _active = active;
+        }
+
+        /**
+         * The transition is applied outside of the lock, so that the sources are never
+         * subscribed or unsubscribed while a match callback is blocked on it.
+         */
+        if (_scheduler)
+        {
+            std::weak_ptr<Implementation> route = shared_from_this();
+            _scheduler([route]()
+                    {
+                        if (std::shared_ptr<Implementation> alive = route.lock())
+                        {
+                            alive->apply();
+                        }
+                    }, std::chrono::steady_clock::duration::zero());
+        }
+        else
+        {
+            apply();
+        }
+    }
+
+    /**
+     * Brings every source to the latest state of the route.
+     *
+     * @returns `true` if every source reached it.
+     */
+    bool apply()
+    {
+        std::unique_lock<std::mutex> apply_lock(_apply_mutex);
+
+        std::vector<Source*> sources;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            for (Source& source : _sources)
+            {
+                sources.push_back(&source);
+            }
+        }
+
+        bool updated = true;
+        for (Source* source : sources)
+        {
+            updated = update(*source, _active) && updated;
+        }
+        return updated;
+    }
+
+    bool update(
+            Source& source,
+            bool active)
+    {
+        if (active && !source.subscribed)
+        {
+            source.subscribed = source.subscribe();
+            if (source.subscribed)
+            {
+                _logger << utils::Logger::Level::INFO
+                        << "[" << source.name << " SystemHandle] Subscribed to topic '"
+                        << _name << "', since a remote endpoint is listening to it." << std::endl;
+            }
+            else
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "[" << source.name << " SystemHandle] Failed to subscribe "
+                        << "to topic '" << _name << "'." << std::endl;
+            }
+            return source.subscribed;
+        }
+        else if (!active && source.subscribed)
+        {
+            if (source.unsubscribe())
+            {
+                source.subscribed = false;
+
+                _logger << utils::Logger::Level::INFO
+                        << "[" << source.name << " SystemHandle] Unsubscribed from topic '"
+                        << _name << "', since no remote endpoint is listening to it." << std::endl;
+            }
+            else
+            {
+                _logger << utils::Logger::Level::DEBUG
+                        << "[" << source.name << " SystemHandle] Cannot unsubscribe from topic '"
+                        << _name << "'. Its messages will be discarded." << std::endl;
+            }
+            return !source.subscribed;
+        }
+
+        return true;
+    }
+
+    const std::string _name;
+    const Scheduler _scheduler;
+
+    std::vector<std::size_t> _matched;
+    std::size_t _listened;
+    std::atomic<bool> _active;
+    bool _cancelled;
+
+    /**
+     * Sources are only modified by apply(), which holds `_apply_mutex`, while `_mutex`
+     * only guards the list itself, so that the match callbacks never wait for them.
+     */
+    std::list<Source> _sources;
+    mutable std::mutex _mutex;
+    std::mutex _apply_mutex;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+LazySubscription::LazySubscription(
+        const std::string& name,
+        Scheduler scheduler)
+    : _pimpl(std::make_shared<Implementation>(name, std::move(scheduler)))
+{
+}
+
+//==============================================================================
+LazySubscription::~LazySubscription() = default;
+
+//==============================================================================
+LazySubscription::MatchCallback LazySubscription::watch()
+{
+    return _pimpl->watch();
+}
+
+//==============================================================================
+void LazySubscription::add_source(
+        const std::string& source,
+        Action subscribe,
+        Action unsubscribe)
+{
+    _pimpl->add_source(source, std::move(subscribe), std::move(unsubscribe));
+}
+
+//==============================================================================
+bool LazySubscription::active() const
+{
+    return _pimpl->active();
+}
+
+//==============================================================================
+bool LazySubscription::cancel()
+{
+    return _pimpl->cancel();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
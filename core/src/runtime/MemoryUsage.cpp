@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/MemoryUsage.hpp>
+
+#include <set>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+using xtypes::TypeKind;
+
+//==============================================================================
+const xtypes::DynamicType& resolve(
+        const xtypes::DynamicType& type)
+{
+    return type.kind() == TypeKind::ALIAS_TYPE
+           ? static_cast<const xtypes::AliasType&>(type).rget()
+           : type;
+}
+
+/**
+ * @brief Gets the heap storage of a value, which is not part of the `memory_size()` of its type.
+ */
+std::size_t heap_size(
+        const xtypes::DynamicType& alias,
+        const xtypes::ReadableDynamicDataRef& data)
+{
+    const xtypes::DynamicType& type = resolve(alias);
+    switch (type.kind())
+    {
+        case TypeKind::STRUCTURE_TYPE:
+        {
+            const auto& structure = static_cast<const xtypes::AggregationType&>(type);
+            std::size_t size = 0;
+            for (std::size_t i = 0; i < structure.members().size(); ++i)
+            {
+                size += heap_size(structure.members()[i].type(), data[i]);
+            }
+            return size;
+        }
+        case TypeKind::SEQUENCE_TYPE:
+        case TypeKind::ARRAY_TYPE:
+        {
+            const auto& collection = static_cast<const xtypes::CollectionType&>(type);
+            const xtypes::DynamicType& content = resolve(collection.content_type());
+            const std::size_t count = data.size();
+
+            // The elements of arrays are stored inline, those of sequences are not.
+            std::size_t size = type.kind() == TypeKind::SEQUENCE_TYPE ? count * content.memory_size() : 0;
+            if (!content.is_primitive_type() && !content.is_enumerated_type())
+            {
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    size += heap_size(content, data[i]);
+                }
+            }
+            return size;
+        }
+        case TypeKind::MAP_TYPE:
+        {
+            const auto& map = static_cast<const xtypes::CollectionType&>(type);
+            return data.size() * map.content_type().memory_size();
+        }
+        case TypeKind::STRING_TYPE:
+        {
+            return data.value<std::string>().capacity() + 1;
+        }
+        case TypeKind::WSTRING_TYPE:
+        {
+            return (data.value<std::wstring>().capacity() + 1) * sizeof(wchar_t);
+        }
+        default:
+            return 0;
+    }
+}
+
+//==============================================================================
+std::size_t type_size(
+        const xtypes::DynamicType& type,
+        std::set<const xtypes::DynamicType*>& visited)
+{
+    if (type.is_primitive_type() || !visited.insert(&type).second)
+    {
+        return 0;
+    }
+
+    std::size_t size = type.name().capacity();
+    switch (type.kind())
+    {
+        case TypeKind::STRUCTURE_TYPE:
+        {
+            const auto& structure = static_cast<const xtypes::AggregationType&>(type);
+            size += sizeof(xtypes::StructType);
+            for (const xtypes::Member& member : structure.members())
+            {
+                size += sizeof(xtypes::Member) + member.name().capacity() + type_size(member.type(), visited);
+            }
+            return size;
+        }
+        case TypeKind::SEQUENCE_TYPE:
+        case TypeKind::ARRAY_TYPE:
+        case TypeKind::MAP_TYPE:
+        {
+            const auto& collection = static_cast<const xtypes::CollectionType&>(type);
+            return size + sizeof(xtypes::SequenceType) + type_size(collection.content_type(), visited);
+        }
+        case TypeKind::ALIAS_TYPE:
+        {
+            const auto& alias = static_cast<const xtypes::AliasType&>(type);
+            return size + sizeof(xtypes::AliasType) + type_size(alias.get(), visited);
+        }
+        default:
+            return size + sizeof(xtypes::StringType);
+    }
+}
+
+} //  anonymous namespace
+
+//==============================================================================
+std::size_t MemoryUsage::of(
+        const xtypes::ReadableDynamicDataRef& data)
+{
+    return data.type().memory_size() + heap_size(data.type(), data);
+}
+
+//==============================================================================
+std::size_t MemoryUsage::of(
+        const TypeRegistry& types)
+{
+    std::set<const xtypes::DynamicType*> visited;
+    std::size_t size = types.bucket_count() * sizeof(void*);
+    for (const auto& [name, type] : types)
+    {
+        size += sizeof(TypeRegistry::value_type) + sizeof(void*) + name.capacity();
+        if (type)
+        {
+            size += type_size(*type, visited);
+        }
+    }
+    return size;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
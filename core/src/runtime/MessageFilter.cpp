@@ -0,0 +1,852 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/MessageFilter.hpp>
+#include <is/utils/Log.hpp>
+
+#include <atomic>
+#include <cctype>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+using xtypes::TypeKind;
+
+//==============================================================================
+/**
+ * @brief A numeric value, either read from a field or given as a literal.
+ *        Integers are kept exact; they are only compared as floating point
+ *        values against floating point fields or literals.
+ */
+struct Number
+{
+    bool integral;
+    int64_t integer;
+    double real;
+
+    static Number from_integer(
+            int64_t value)
+    {
+        return Number{true, value, static_cast<double>(value)};
+    }
+
+    static Number from_real(
+            double value)
+    {
+        return Number{false, 0, value};
+    }
+
+};
+
+//==============================================================================
+enum class Operator
+{
+    EQUAL,
+    NOT_EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL
+};
+
+//==============================================================================
+template<typename T>
+bool compare(
+        const T& left,
+        Operator op,
+        const T& right)
+{
+    switch (op)
+    {
+        case Operator::EQUAL: return left == right;
+        case Operator::NOT_EQUAL: return left != right;
+        case Operator::LESS: return left < right;
+        case Operator::LESS_EQUAL: return left <= right;
+        case Operator::GREATER: return left > right;
+        case Operator::GREATER_EQUAL: return left >= right;
+    }
+    return false;
+}
+
+//==============================================================================
+bool compare(
+        const Number& left,
+        Operator op,
+        const Number& right)
+{
+    return left.integral && right.integral
+           ? compare(left.integer, op, right.integer)
+           : compare(left.real, op, right.real);
+}
+
+//==============================================================================
+/**
+ * @brief A field of the message, resolved into the steps followed to reach it
+ *        from the message root: member indexes for structures, element indexes
+ *        for arrays and sequences.
+ */
+struct Field
+{
+    enum class Kind
+    {
+        INTEGER,
+        REAL,
+        STRING
+    };
+
+    struct Step
+    {
+        bool element;
+        std::size_t index;
+    };
+
+    std::string path;
+    std::vector<Step> steps;
+    Kind kind;
+    TypeKind type_kind;
+    std::size_t size;
+
+    /**
+     * @brief Reads the field from a message, and passes it to `use`.
+     *
+     * @returns `false` if the message does not have the field, because some
+     *          sequence is shorter than the requested element.
+     */
+    template<typename Use>
+    bool read(
+            const xtypes::ReadableDynamicDataRef& data,
+            std::size_t depth,
+            const Use& use) const
+    {
+        if (depth < steps.size())
+        {
+            const Step& step = steps[depth];
+            if (step.element && step.index >= data.size())
+            {
+                return false;
+            }
+            return read(data[step.index], depth + 1, use);
+        }
+
+        switch (type_kind)
+        {
+            case TypeKind::BOOLEAN_TYPE: use(Number::from_integer(data.value<bool>())); break;
+            case TypeKind::BYTE_TYPE: use(Number::from_integer(data.value<uint8_t>())); break;
+            case TypeKind::UINT_8_TYPE: use(Number::from_integer(data.value<uint8_t>())); break;
+            case TypeKind::INT_8_TYPE: use(Number::from_integer(data.value<int8_t>())); break;
+            case TypeKind::INT_16_TYPE: use(Number::from_integer(data.value<int16_t>())); break;
+            case TypeKind::UINT_16_TYPE: use(Number::from_integer(data.value<uint16_t>())); break;
+            case TypeKind::INT_32_TYPE: use(Number::from_integer(data.value<int32_t>())); break;
+            case TypeKind::UINT_32_TYPE: use(Number::from_integer(data.value<uint32_t>())); break;
+            case TypeKind::INT_64_TYPE: use(Number::from_integer(data.value<int64_t>())); break;
+            case TypeKind::UINT_64_TYPE:
+                use(Number::from_integer(static_cast<int64_t>(data.value<uint64_t>())));
+                break;
+            case TypeKind::CHAR_8_TYPE: use(Number::from_integer(data.value<char>())); break;
+            case TypeKind::CHAR_16_TYPE: use(Number::from_integer(data.value<char16_t>())); break;
+            case TypeKind::WIDE_CHAR_TYPE: use(Number::from_integer(data.value<wchar_t>())); break;
+            case TypeKind::FLOAT_32_TYPE: use(Number::from_real(data.value<float>())); break;
+            case TypeKind::FLOAT_64_TYPE: use(Number::from_real(data.value<double>())); break;
+            case TypeKind::FLOAT_128_TYPE:
+                use(Number::from_real(static_cast<double>(data.value<long double>())));
+                break;
+            case TypeKind::ENUMERATION_TYPE:
+            {
+                if (size == sizeof(uint8_t))
+                {
+                    use(Number::from_integer(data.value<uint8_t>()));
+                }
+                else if (size == sizeof(uint16_t))
+                {
+                    use(Number::from_integer(data.value<uint16_t>()));
+                }
+                else
+                {
+                    use(Number::from_integer(data.value<uint32_t>()));
+                }
+                break;
+            }
+            case TypeKind::STRING_TYPE: use(data.value<std::string>()); break;
+            default: return false;
+        }
+        return true;
+    }
+
+};
+
+//==============================================================================
+class Condition
+{
+public:
+
+    virtual ~Condition() = default;
+
+    virtual bool evaluate(
+            const xtypes::ReadableDynamicDataRef& message) const = 0;
+};
+
+using ConditionPtr = std::unique_ptr<Condition>;
+
+//==============================================================================
+class Logical : public Condition
+{
+public:
+
+    Logical(
+            bool conjunction,
+            ConditionPtr left,
+            ConditionPtr right)
+        : _conjunction(conjunction)
+        , _left(std::move(left))
+        , _right(std::move(right))
+    {
+    }
+
+    bool evaluate(
+            const xtypes::ReadableDynamicDataRef& message) const override
+    {
+        return _conjunction
+               ? _left->evaluate(message) && _right->evaluate(message)
+               : _left->evaluate(message) || _right->evaluate(message);
+    }
+
+private:
+
+    const bool _conjunction;
+    const ConditionPtr _left;
+    const ConditionPtr _right;
+};
+
+//==============================================================================
+class Negation : public Condition
+{
+public:
+
+    Negation(
+            ConditionPtr condition)
+        : _condition(std::move(condition))
+    {
+    }
+
+    bool evaluate(
+            const xtypes::ReadableDynamicDataRef& message) const override
+    {
+        return !_condition->evaluate(message);
+    }
+
+private:
+
+    const ConditionPtr _condition;
+};
+
+//==============================================================================
+class Sample : public Condition
+{
+public:
+
+    Sample(
+            uint64_t period)
+        : _period(period)
+        , _count(0)
+    {
+    }
+
+    bool evaluate(
+            const xtypes::ReadableDynamicDataRef&) const override
+    {
+        return _count.fetch_add(1, std::memory_order_relaxed) % _period == 0;
+    }
+
+private:
+
+    const uint64_t _period;
+    mutable std::atomic<uint64_t> _count;
+};
+
+//==============================================================================
+class NumberComparison : public Condition
+{
+public:
+
+    NumberComparison(
+            Field field,
+            int64_t modulo,
+            Operator op,
+            Number value)
+        : _field(std::move(field))
+        , _modulo(modulo)
+        , _op(op)
+        , _value(value)
+    {
+    }
+
+    bool evaluate(
+            const xtypes::ReadableDynamicDataRef& message) const override
+    {
+        bool result = false;
+        _field.read(message, 0, [&](const auto& read)
+                {
+                    if constexpr (std::is_same<std::decay_t<decltype(read)>, Number>::value)
+                    {
+                        result = compare(
+                            _modulo > 0 ? Number::from_integer(read.integer % _modulo) : read, _op, _value);
+                    }
+                });
+        return result;
+    }
+
+private:
+
+    const Field _field;
+    const int64_t _modulo;
+    const Operator _op;
+    const Number _value;
+};
+
+//==============================================================================
+class NumberRange : public Condition
+{
+public:
+
+    NumberRange(
+            Field field,
+            int64_t modulo,
+            Number low,
+            Number high)
+        : _field(std::move(field))
+        , _modulo(modulo)
+        , _low(low)
+        , _high(high)
+    {
+    }
+
+    bool evaluate(
+            const xtypes::ReadableDynamicDataRef& message) const override
+    {
+        bool result = false;
+        _field.read(message, 0, [&](const auto& read)
+                {
+                    if constexpr (std::is_same<std::decay_t<decltype(read)>, Number>::value)
+                    {
+                        const Number value = _modulo > 0 ? Number::from_integer(read.integer % _modulo) : read;
+                        result = compare(value, Operator::GREATER_EQUAL, _low)
+                        && compare(value, Operator::LESS_EQUAL, _high);
+                    }
+                });
+        return result;
+    }
+
+private:
+
+    const Field _field;
+    const int64_t _modulo;
+    const Number _low;
+    const Number _high;
+};
+
+//==============================================================================
+class StringComparison : public Condition
+{
+public:
+
+    StringComparison(
+            Field field,
+            Operator op,
+            std::string value)
+        : _field(std::move(field))
+        , _op(op)
+        , _value(std::move(value))
+    {
+    }
+
+    bool evaluate(
+            const xtypes::ReadableDynamicDataRef& message) const override
+    {
+        bool result = false;
+        _field.read(message, 0, [&](const auto& read)
+                {
+                    if constexpr (std::is_same<std::decay_t<decltype(read)>, std::string>::value)
+                    {
+                        result = compare(read, _op, _value);
+                    }
+                });
+        return result;
+    }
+
+private:
+
+    const Field _field;
+    const Operator _op;
+    const std::string _value;
+};
+
+//==============================================================================
+/**
+ * @brief Recursive descent parser of filter expressions, which resolves
+ *        every field against the message type while parsing.
+ *        Errors are reported by throwing std::invalid_argument.
+ */
+class Parser
+{
+public:
+
+    Parser(
+            const std::string& expression,
+            const xtypes::DynamicType& type)
+        : _text(expression)
+        , _type(type)
+        , _pos(0)
+    {
+    }
+
+    ConditionPtr parse()
+    {
+        ConditionPtr condition = disjunction();
+        skip_spaces();
+        if (_pos != _text.size())
+        {
+            fail("unexpected '" + _text.substr(_pos) + "'");
+        }
+        return condition;
+    }
+
+private:
+
+    ConditionPtr disjunction()
+    {
+        ConditionPtr condition = conjunction();
+        while (accept("||"))
+        {
+            condition = std::make_unique<Logical>(false, std::move(condition), conjunction());
+        }
+        return condition;
+    }
+
+    ConditionPtr conjunction()
+    {
+        ConditionPtr condition = negation();
+        while (accept("&&"))
+        {
+            condition = std::make_unique<Logical>(true, std::move(condition), negation());
+        }
+        return condition;
+    }
+
+    ConditionPtr negation()
+    {
+        skip_spaces();
+        if (_pos < _text.size() && _text[_pos] == '!'
+                && (_pos + 1 == _text.size() || _text[_pos + 1] != '='))
+        {
+            ++_pos;
+            return std::make_unique<Negation>(negation());
+        }
+        return primary();
+    }
+
+    ConditionPtr primary()
+    {
+        if (accept("("))
+        {
+            ConditionPtr condition = disjunction();
+            expect(")");
+            return condition;
+        }
+
+        const std::size_t start = _pos;
+        const std::string name = identifier();
+
+        if (name == "sample" && accept("("))
+        {
+            const Number period = number();
+            if (!period.integral || period.integer <= 0)
+            {
+                fail("'sample' needs a positive integer period");
+            }
+            expect(")");
+            return std::make_unique<Sample>(static_cast<uint64_t>(period.integer));
+        }
+
+        _pos = start;
+        Field field = resolve_field();
+
+        int64_t modulo = 0;
+        if (accept("%"))
+        {
+            const Number divisor = number();
+            if (field.kind != Field::Kind::INTEGER || !divisor.integral || divisor.integer <= 0)
+            {
+                fail("'%' needs an integer field and a positive integer divisor");
+            }
+            modulo = divisor.integer;
+        }
+
+        if (accept_word("in"))
+        {
+            if (field.kind == Field::Kind::STRING)
+            {
+                fail("the string field '" + field.path + "' cannot be compared with a range");
+            }
+            expect("[");
+            const Number low = number();
+            expect(",");
+            const Number high = number();
+            expect("]");
+            return std::make_unique<NumberRange>(std::move(field), modulo, low, high);
+        }
+
+        Operator op;
+        if (!comparison_operator(op))
+        {
+            if (field.type_kind != TypeKind::BOOLEAN_TYPE || modulo > 0)
+            {
+                fail("the field '" + field.path + "' must be compared with a value");
+            }
+            return std::make_unique<NumberComparison>(
+                std::move(field), 0, Operator::NOT_EQUAL, Number::from_integer(0));
+        }
+
+        skip_spaces();
+        if (field.kind == Field::Kind::STRING)
+        {
+            return std::make_unique<StringComparison>(std::move(field), op, string());
+        }
+        return std::make_unique<NumberComparison>(std::move(field), modulo, op, number_or_boolean());
+    }
+
+    Field resolve_field()
+    {
+        Field field;
+        const xtypes::DynamicType* current = &_type;
+        const std::size_t start = _pos;
+
+        std::string member = identifier();
+        while (true)
+        {
+            if (current->kind() != TypeKind::STRUCTURE_TYPE)
+            {
+                fail("'" + _text.substr(start, _pos - start) + "' is not a structure member");
+            }
+
+            const xtypes::AggregationType& aggregation = static_cast<const xtypes::AggregationType&>(*current);
+            if (!aggregation.has_member(member))
+            {
+                fail("the type '" + current->name() + "' has no member named '" + member + "'");
+            }
+
+            const auto& members = aggregation.members();
+            for (std::size_t index = 0; index < members.size(); ++index)
+            {
+                if (members[index].name() == member)
+                {
+                    field.steps.push_back(Field::Step{false, index});
+                    current = &members[index].type();
+                    break;
+                }
+            }
+
+            while (_pos < _text.size() && _text[_pos] == '[')
+            {
+                if (current->kind() != TypeKind::SEQUENCE_TYPE && current->kind() != TypeKind::ARRAY_TYPE)
+                {
+                    fail("'" + _text.substr(start, _pos - start) + "' is not an array or a sequence");
+                }
+                ++_pos;
+                const Number index = number();
+                if (!index.integral || index.integer < 0)
+                {
+                    fail("element indexes must be non negative integers");
+                }
+                expect("]");
+                field.steps.push_back(Field::Step{true, static_cast<std::size_t>(index.integer)});
+                current = &static_cast<const xtypes::CollectionType&>(*current).content_type();
+            }
+
+            if (_pos < _text.size() && _text[_pos] == '.')
+            {
+                ++_pos;
+                member = identifier();
+                continue;
+            }
+            break;
+        }
+
+        field.path = _text.substr(start, _pos - start);
+        field.type_kind = current->kind();
+        field.size = current->memory_size();
+
+        switch (field.type_kind)
+        {
+            case TypeKind::FLOAT_32_TYPE:
+            case TypeKind::FLOAT_64_TYPE:
+            case TypeKind::FLOAT_128_TYPE:
+                field.kind = Field::Kind::REAL;
+                break;
+            case TypeKind::STRING_TYPE:
+                field.kind = Field::Kind::STRING;
+                break;
+            case TypeKind::ENUMERATION_TYPE:
+                field.kind = Field::Kind::INTEGER;
+                break;
+            default:
+                if (!current->is_primitive_type())
+                {
+                    fail("the field '" + field.path + "' of type '" + current->name()
+                            + "' is not a primitive, enumerated or string field");
+                }
+                field.kind = Field::Kind::INTEGER;
+                break;
+        }
+
+        return field;
+    }
+
+    bool comparison_operator(
+            Operator& op)
+    {
+        static const std::vector<std::pair<std::string, Operator> > operators = {
+            {"==", Operator::EQUAL},
+            {"!=", Operator::NOT_EQUAL},
+            {"<=", Operator::LESS_EQUAL},
+            {">=", Operator::GREATER_EQUAL},
+            {"<", Operator::LESS},
+            {">", Operator::GREATER}
+        };
+
+        for (const auto& candidate : operators)
+        {
+            if (accept(candidate.first))
+            {
+                op = candidate.second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::string identifier()
+    {
+        skip_spaces();
+        const std::size_t start = _pos;
+        while (_pos < _text.size()
+                && (std::isalnum(static_cast<unsigned char>(_text[_pos])) || _text[_pos] == '_'))
+        {
+            ++_pos;
+        }
+
+        if (start == _pos || std::isdigit(static_cast<unsigned char>(_text[start])))
+        {
+            fail("expected a field name");
+        }
+        return _text.substr(start, _pos - start);
+    }
+
+    Number number()
+    {
+        skip_spaces();
+        const char* begin = _text.c_str() + _pos;
+        char* end = nullptr;
+
+        const long long integer = std::strtoll(begin, &end, 10);
+        if (end != begin && *end != '.' && *end != 'e' && *end != 'E')
+        {
+            _pos += static_cast<std::size_t>(end - begin);
+            return Number::from_integer(integer);
+        }
+
+        const double real = std::strtod(begin, &end);
+        if (end == begin)
+        {
+            fail("expected a number");
+        }
+        _pos += static_cast<std::size_t>(end - begin);
+        return Number::from_real(real);
+    }
+
+    Number number_or_boolean()
+    {
+        if (accept_word("true"))
+        {
+            return Number::from_integer(1);
+        }
+        if (accept_word("false"))
+        {
+            return Number::from_integer(0);
+        }
+        return number();
+    }
+
+    std::string string()
+    {
+        skip_spaces();
+        if (_pos == _text.size() || (_text[_pos] != '\'' && _text[_pos] != '"'))
+        {
+            fail("expected a quoted string");
+        }
+
+        const char quote = _text[_pos++];
+        const std::size_t end = _text.find(quote, _pos);
+        if (end == std::string::npos)
+        {
+            fail("unterminated string");
+        }
+
+        std::string value = _text.substr(_pos, end - _pos);
+        _pos = end + 1;
+        return value;
+    }
+
+    bool accept(
+            const std::string& token)
+    {
+        skip_spaces();
+        if (_text.compare(_pos, token.size(), token) == 0)
+        {
+            _pos += token.size();
+            return true;
+        }
+        return false;
+    }
+
+    bool accept_word(
+            const std::string& word)
+    {
+        skip_spaces();
+        const std::size_t end = _pos + word.size();
+        if (_text.compare(_pos, word.size(), word) == 0
+                && (end == _text.size()
+                || !(std::isalnum(static_cast<unsigned char>(_text[end])) || _text[end] == '_')))
+        {
+            _pos = end;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(
+            const std::string& token)
+    {
+        if (!accept(token))
+        {
+            fail("expected '" + token + "'");
+        }
+    }
+
+    void skip_spaces()
+    {
+        while (_pos < _text.size() && std::isspace(static_cast<unsigned char>(_text[_pos])))
+        {
+            ++_pos;
+        }
+    }
+
+    [[noreturn]] void fail(
+            const std::string& reason) const
+    {
+        throw std::invalid_argument(reason + " (at position " + std::to_string(_pos) + ")");
+    }
+
+    const std::string& _text;
+    const xtypes::DynamicType& _type;
+    std::size_t _pos;
+};
+
+} //  anonymous namespace
+
+class MessageFilter::Implementation
+{
+public:
+
+    Implementation(
+            const std::string& expression,
+            ConditionPtr root)
+        : _expression(expression)
+        , _root(std::move(root))
+    {
+    }
+
+    bool matches(
+            const xtypes::ReadableDynamicDataRef& message) const
+    {
+        return _root->evaluate(message);
+    }
+
+    const std::string& expression() const
+    {
+        return _expression;
+    }
+
+private:
+
+    const std::string _expression;
+    const ConditionPtr _root;
+};
+
+//==============================================================================
+std::shared_ptr<const MessageFilter> MessageFilter::compile(
+        const std::string& expression,
+        const xtypes::DynamicType& type)
+{
+    static utils::Logger logger("is::core::MessageFilter");
+
+    try
+    {
+        ConditionPtr root = Parser(expression, type).parse();
+        return std::shared_ptr<const MessageFilter>(
+            new MessageFilter(std::make_unique<Implementation>(expression, std::move(root))));
+    }
+    catch (const std::invalid_argument& e)
+    {
+        logger << utils::Logger::Level::ERROR
+               << "Invalid filter '" << expression << "' for the type '"
+               << type.name() << "': " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+//==============================================================================
+MessageFilter::MessageFilter(
+        std::unique_ptr<Implementation> pimpl)
+    : _pimpl(std::move(pimpl))
+{
+}
+
+//==============================================================================
+MessageFilter::~MessageFilter() = default;
+
+//==============================================================================
+bool MessageFilter::matches(
+        const xtypes::ReadableDynamicDataRef& message) const
+{
+    return _pimpl->matches(message);
+}
+
+//==============================================================================
+const std::string& MessageFilter::expression() const
+{
+    return _pimpl->expression();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
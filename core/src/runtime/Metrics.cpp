@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/Metrics.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+//==============================================================================
+/**
+ * @brief Gets the number of bits needed to represent a value, which is zero for zero.
+ */
+std::size_t bit_width(
+        uint64_t value)
+{
+    std::size_t width = 0;
+    for (std::size_t shift = 32; shift > 0; shift /= 2)
+    {
+        if (value >> shift)
+        {
+            value >>= shift;
+            width += shift;
+        }
+    }
+    return width + static_cast<std::size_t>(value);
+}
+
+} //  anonymous namespace
+
+//==============================================================================
+uint64_t LatencyHistogram::Snapshot::quantile_ns(
+        double quantile) const
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    const uint64_t target = static_cast<uint64_t>(quantile * static_cast<double>(count));
+    uint64_t accumulated = 0;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        accumulated += buckets[i];
+        if (accumulated > target || accumulated == count)
+        {
+            // The maximum is a tighter bound for the highest buckets.
+            return std::min(upper_bound_ns(i), max_ns);
+        }
+    }
+
+    return max_ns;
+}
+
+//==============================================================================
+uint64_t LatencyHistogram::Snapshot::mean_ns() const
+{
+    return count == 0 ? 0 : sum_ns / count;
+}
+
+//==============================================================================
+LatencyHistogram::LatencyHistogram()
+    : _count(0)
+    , _sum_ns(0)
+    , _max_ns(0)
+{
+    for (auto& bucket : _buckets)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+}
+
+//==============================================================================
+void LatencyHistogram::record(
+        std::chrono::nanoseconds duration)
+{
+    const uint64_t ns = duration.count() > 0 ? static_cast<uint64_t>(duration.count()) : 0;
+    const uint64_t us = ns / 1000;
+
+    std::size_t bucket = bit_width(us);
+    if (bucket >= BUCKETS)
+    {
+        bucket = BUCKETS - 1;
+    }
+
+    _buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _sum_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t max = _max_ns.load(std::memory_order_relaxed);
+    while (ns > max && !_max_ns.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+    {
+    }
+}
+
+//==============================================================================
+LatencyHistogram::Snapshot LatencyHistogram::snapshot() const
+{
+    Snapshot snapshot;
+    for (std::size_t i = 0; i < BUCKETS; ++i)
+    {
+        snapshot.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count = _count.load(std::memory_order_relaxed);
+    snapshot.sum_ns = _sum_ns.load(std::memory_order_relaxed);
+    snapshot.max_ns = _max_ns.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+//==============================================================================
+uint64_t LatencyHistogram::upper_bound_ns(
+        std::size_t bucket)
+{
+    if (bucket + 1 >= BUCKETS)
+    {
+        return std::numeric_limits<uint64_t>::max();
+    }
+
+    return (uint64_t(1) << bucket) * 1000;
+}
+
+//==============================================================================
+RouteMetrics::RouteMetrics(
+        const std::string& kind,
+        const std::string& name,
+        const std::string& route,
+        const std::string& source,
+        const std::string& destination)
+    : _kind(kind)
+    , _name(name)
+    , _route(route)
+    , _source(source)
+    , _destination(destination)
+    , _messages_in(0)
+    , _messages_out(0)
+    , _conversions(0)
+    , _drops(0)
+    , _failures(0)
+{
+}
+
+//==============================================================================
+RouteMetricsSnapshot RouteMetrics::snapshot() const
+{
+    RouteMetricsSnapshot snapshot;
+    snapshot.kind = _kind;
+    snapshot.name = _name;
+    snapshot.route = _route;
+    snapshot.source = _source;
+    snapshot.destination = _destination;
+    snapshot.messages_in = _messages_in.load(std::memory_order_relaxed);
+    snapshot.messages_out = _messages_out.load(std::memory_order_relaxed);
+    snapshot.conversions = _conversions.load(std::memory_order_relaxed);
+    snapshot.drops = _drops.load(std::memory_order_relaxed);
+    snapshot.failures = _failures.load(std::memory_order_relaxed);
+    snapshot.publish_time = _publish_time.snapshot();
+    snapshot.round_trip_time = _round_trip_time.snapshot();
+
+    std::unique_lock<std::mutex> lock(_probes_mutex);
+    for (const MemoryProbe& probe : _probes)
+    {
+        probe(snapshot);
+    }
+    return snapshot;
+}
+
+//==============================================================================
+void RouteMetrics::add_memory_probe(
+        MemoryProbe probe)
+{
+    std::unique_lock<std::mutex> lock(_probes_mutex);
+    _probes.push_back(std::move(probe));
+}
+
+//==============================================================================
+std::shared_ptr<RouteMetrics> MetricsRegistry::add(
+        const std::string& kind,
+        const std::string& name,
+        const std::string& route,
+        const std::string& source,
+        const std::string& destination)
+{
+    auto metrics = std::make_shared<RouteMetrics>(kind, name, route, source, destination);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _routes.push_back(metrics);
+    return metrics;
+}
+
+//==============================================================================
+void MetricsRegistry::remove(
+        const std::string& kind,
+        const std::string& name)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    _routes.erase(std::remove_if(_routes.begin(), _routes.end(),
+            [&](const std::shared_ptr<RouteMetrics>& route)
+            {
+                return route->kind() == kind && route->name() == name;
+            }), _routes.end());
+}
+
+//==============================================================================
+std::vector<RouteMetricsSnapshot> MetricsRegistry::snapshot() const
+{
+    std::vector<std::shared_ptr<RouteMetrics> > routes;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        routes = _routes;
+    }
+
+    std::vector<RouteMetricsSnapshot> snapshots;
+    snapshots.reserve(routes.size());
+    for (const auto& route : routes)
+    {
+        snapshots.push_back(route->snapshot());
+    }
+    return snapshots;
+}
+
+//==============================================================================
+void MetricsRegistry::set_type_registry(
+        const std::string& system,
+        std::size_t types,
+        uint64_t bytes)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto it = std::find_if(_type_registries.begin(), _type_registries.end(),
+                    [&](const TypeRegistrySnapshot& registry)
+                    {
+                        return registry.system == system;
+                    });
+
+    if (it == _type_registries.end())
+    {
+        it = _type_registries.insert(_type_registries.end(), TypeRegistrySnapshot());
+        it->system = system;
+    }
+
+    it->types = types;
+    it->bytes = bytes;
+}
+
+//==============================================================================
+std::vector<TypeRegistrySnapshot> MetricsRegistry::type_registries() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _type_registries;
+}
+
+//==============================================================================
+std::string MetricsRegistry::to_string() const
+{
+    std::ostringstream ss;
+    for (const RouteMetricsSnapshot& route : snapshot())
+    {
+        ss << route.kind << " '" << route.name << "' (route '" << route.route << "') ["
+           << route.source << " -> " << route.destination << "]: in=" << route.messages_in
+           << " out=" << route.messages_out
+           << " conversions=" << route.conversions
+           << " drops=" << route.drops
+           << " failures=" << route.failures
+           << " queued=" << route.queued_messages << " (" << route.queued_bytes << " bytes)"
+           << " retained=" << route.retained_bytes << " bytes";
+
+        if (route.dynamic_publishers > 0 || route.publisher_evictions > 0)
+        {
+            ss << " publishers=" << route.dynamic_publishers
+               << " (" << route.publisher_evictions << " evicted)";
+        }
+
+        ss << std::fixed << std::setprecision(1)
+           << " publish(us): mean=" << route.publish_time.mean_ns() / 1000.0
+           << " p50=" << route.publish_time.quantile_ns(0.5) / 1000.0
+           << " p99=" << route.publish_time.quantile_ns(0.99) / 1000.0;
+
+        if (route.round_trip_time.count > 0)
+        {
+            ss << " round-trip(us): mean=" << route.round_trip_time.mean_ns() / 1000.0
+               << " p50=" << route.round_trip_time.quantile_ns(0.5) / 1000.0
+               << " p99=" << route.round_trip_time.quantile_ns(0.99) / 1000.0;
+        }
+
+        ss << "\n";
+    }
+
+    for (const TypeRegistrySnapshot& registry : type_registries())
+    {
+        ss << "types of '" << registry.system << "': " << registry.types
+           << " types, " << registry.bytes << " bytes\n";
+    }
+    return ss.str();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
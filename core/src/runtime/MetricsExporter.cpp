@@ -0,0 +1,475 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/MetricsExporter.hpp>
+#include <is/utils/Log.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+#ifndef WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif //  WIN32
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif //  MSG_NOSIGNAL
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+//==============================================================================
+std::string escape_label(
+        const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char c : value)
+    {
+        switch (c)
+        {
+            case '\\':
+                escaped += "\\\\";
+                break;
+            case '"':
+                escaped += "\\\"";
+                break;
+            case '\n':
+                escaped += "\\n";
+                break;
+            default:
+                escaped += c;
+        }
+    }
+    return escaped;
+}
+
+//==============================================================================
+std::string labels_of(
+        const RouteMetricsSnapshot& route)
+{
+    std::ostringstream ss;
+    ss << "kind=\"" << escape_label(route.kind) << "\""
+       << ",route=\"" << escape_label(route.route) << "\""
+       << "," << (route.kind == "service" ? "service" : "topic")
+       << "=\"" << escape_label(route.name) << "\""
+       << ",source=\"" << escape_label(route.source) << "\""
+       << ",destination=\"" << escape_label(route.destination) << "\"";
+    return ss.str();
+}
+
+//==============================================================================
+void write_family_header(
+        std::ostream& out,
+        const std::string& name,
+        const std::string& type,
+        const std::string& help)
+{
+    out << "# HELP " << name << " " << help << "\n"
+        << "# TYPE " << name << " " << type << "\n";
+}
+
+//==============================================================================
+void write_counter(
+        std::ostream& out,
+        const std::string& name,
+        const std::string& help,
+        const std::vector<RouteMetricsSnapshot>& routes,
+        const std::vector<std::string>& labels,
+        uint64_t RouteMetricsSnapshot::* field)
+{
+    write_family_header(out, name, "counter", help);
+    for (std::size_t i = 0; i < routes.size(); ++i)
+    {
+        out << name << "{" << labels[i] << "} " << routes[i].*field << "\n";
+    }
+}
+
+//==============================================================================
+void write_gauge(
+        std::ostream& out,
+        const std::string& name,
+        const std::string& help,
+        const std::vector<RouteMetricsSnapshot>& routes,
+        const std::vector<std::string>& labels,
+        uint64_t RouteMetricsSnapshot::* field)
+{
+    write_family_header(out, name, "gauge", help);
+    for (std::size_t i = 0; i < routes.size(); ++i)
+    {
+        out << name << "{" << labels[i] << "} " << routes[i].*field << "\n";
+    }
+}
+
+//==============================================================================
+void write_histogram(
+        std::ostream& out,
+        const std::string& name,
+        const std::string& help,
+        const std::vector<RouteMetricsSnapshot>& routes,
+        const std::vector<std::string>& labels,
+        LatencyHistogram::Snapshot RouteMetricsSnapshot::* field,
+        bool services_only)
+{
+    write_family_header(out, name, "histogram", help);
+    for (std::size_t i = 0; i < routes.size(); ++i)
+    {
+        if (services_only && routes[i].kind != "service")
+        {
+            continue;
+        }
+
+        const LatencyHistogram::Snapshot& histogram = routes[i].*field;
+
+        uint64_t accumulated = 0;
+        for (std::size_t b = 0; b + 1 < LatencyHistogram::BUCKETS; ++b)
+        {
+            accumulated += histogram.buckets[b];
+            out << name << "_bucket{" << labels[i] << ",le=\""
+                << static_cast<double>(LatencyHistogram::upper_bound_ns(b)) / 1e9 << "\"} "
+                << accumulated << "\n";
+        }
+
+        out << name << "_bucket{" << labels[i] << ",le=\"+Inf\"} " << histogram.count << "\n"
+            << name << "_sum{" << labels[i] << "} "
+            << static_cast<double>(histogram.sum_ns) / 1e9 << "\n"
+            << name << "_count{" << labels[i] << "} " << histogram.count << "\n";
+    }
+}
+
+} //  anonymous namespace
+
+class MetricsExporter::Implementation
+{
+public:
+
+    Implementation(
+            Source source)
+        : _source(std::move(source))
+        , _socket(-1)
+        , _port(0)
+        , _stop(false)
+        , _logger("is::core::MetricsExporter")
+    {
+    }
+
+    ~Implementation()
+    {
+        stop();
+    }
+
+    bool start(
+            const std::string& address,
+            uint16_t port)
+    {
+#ifdef WIN32
+        (void)address;
+        (void)port;
+        _logger << utils::Logger::Level::ERROR
+                << "The metrics exporter is not supported on this platform" << std::endl;
+        return false;
+#else
+        if (_socket >= 0)
+        {
+            _logger << utils::Logger::Level::WARN
+                    << "The metrics exporter is already listening on port " << _port.load() << std::endl;
+            return true;
+        }
+
+        sockaddr_in endpoint;
+        std::memset(&endpoint, 0, sizeof(endpoint));
+        endpoint.sin_family = AF_INET;
+        endpoint.sin_port = htons(port);
+        if (inet_pton(AF_INET, address.c_str(), &endpoint.sin_addr) != 1)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Invalid metrics exporter address '" << address << "'" << std::endl;
+            return false;
+        }
+
+        _socket = ::socket(AF_INET, SOCK_STREAM, 0);
+        if (_socket < 0)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Failed to create the metrics exporter socket: "
+                    << std::strerror(errno) << std::endl;
+            return false;
+        }
+
+        const int reuse = 1;
+        setsockopt(_socket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+        if (::bind(_socket, reinterpret_cast<sockaddr*>(&endpoint), sizeof(endpoint)) < 0
+                || ::listen(_socket, 16) < 0)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Failed to listen on " << address << ":" << port
+                    << " for the metrics exporter: " << std::strerror(errno) << std::endl;
+            ::close(_socket);
+            _socket = -1;
+            return false;
+        }
+
+        socklen_t length = sizeof(endpoint);
+        getsockname(_socket, reinterpret_cast<sockaddr*>(&endpoint), &length);
+        _port = ntohs(endpoint.sin_port);
+
+        _stop = false;
+        _thread = std::thread(&Implementation::serve, this);
+
+        _logger << utils::Logger::Level::INFO
+                << "Serving route metrics on http://" << address << ":" << _port.load()
+                << "/metrics" << std::endl;
+        return true;
+#endif //  WIN32
+    }
+
+    void stop()
+    {
+        _stop = true;
+        if (_thread.joinable())
+        {
+            _thread.join();
+        }
+
+#ifndef WIN32
+        if (_socket >= 0)
+        {
+            ::close(_socket);
+            _socket = -1;
+        }
+#endif //  WIN32
+
+        _port = 0;
+    }
+
+    uint16_t port() const
+    {
+        return _port;
+    }
+
+private:
+
+#ifndef WIN32
+    void serve()
+    {
+        while (!_stop)
+        {
+            // The timeout allows to periodically check whether the exporter must stop.
+            pollfd listener{_socket, POLLIN, 0};
+            if (::poll(&listener, 1, 100) <= 0)
+            {
+                continue;
+            }
+
+            const int client = ::accept(_socket, nullptr, nullptr);
+            if (client < 0)
+            {
+                continue;
+            }
+
+            respond(client);
+            ::close(client);
+        }
+    }
+
+    void respond(
+            int client)
+    {
+        timeval timeout{1, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        std::string request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos && request.size() < 8192)
+        {
+            const ssize_t received = ::recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0)
+            {
+                break;
+            }
+            request.append(buffer, static_cast<std::size_t>(received));
+        }
+
+        std::istringstream request_line(request.substr(0, request.find("\r\n")));
+        std::string method;
+        std::string path;
+        request_line >> method >> path;
+        path = path.substr(0, path.find('?'));
+
+        std::string status = "200 OK";
+        std::string body;
+        if (method != "GET")
+        {
+            status = "405 Method Not Allowed";
+        }
+        else if (path != "/metrics" && path != "/")
+        {
+            status = "404 Not Found";
+        }
+        else
+        {
+            body = format(_source());
+        }
+
+        std::ostringstream response;
+        response << "HTTP/1.1 " << status << "\r\n"
+                 << "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                 << "Content-Length: " << body.size() << "\r\n"
+                 << "Connection: close\r\n\r\n"
+                 << body;
+
+        const std::string data = response.str();
+        std::size_t sent = 0;
+        while (sent < data.size())
+        {
+            const ssize_t written = ::send(client, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+            if (written <= 0)
+            {
+                _logger << utils::Logger::Level::DEBUG
+                        << "Failed to send the metrics to a scraper: " << std::strerror(errno) << std::endl;
+                return;
+            }
+            sent += static_cast<std::size_t>(written);
+        }
+    }
+
+#else
+    void serve()
+    {
+    }
+
+#endif //  WIN32
+
+    const Source _source;
+    int _socket;
+    std::atomic<uint16_t> _port;
+    std::atomic_bool _stop;
+    std::thread _thread;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+MetricsExporter::MetricsExporter(
+        const MetricsRegistry& registry)
+    : _pimpl(new Implementation([&registry]()
+            {
+                return registry.snapshot();
+            }))
+{
+}
+
+//==============================================================================
+MetricsExporter::MetricsExporter(
+        Source source)
+    : _pimpl(new Implementation(std::move(source)))
+{
+}
+
+//==============================================================================
+MetricsExporter::~MetricsExporter() = default;
+
+//==============================================================================
+bool MetricsExporter::start(
+        const std::string& address,
+        uint16_t port)
+{
+    return _pimpl->start(address, port);
+}
+
+//==============================================================================
+void MetricsExporter::stop()
+{
+    _pimpl->stop();
+}
+
+//==============================================================================
+uint16_t MetricsExporter::port() const
+{
+    return _pimpl->port();
+}
+
+//==============================================================================
+std::string MetricsExporter::format(
+        const std::vector<RouteMetricsSnapshot>& routes)
+{
+    std::vector<std::string> labels;
+    labels.reserve(routes.size());
+    for (const RouteMetricsSnapshot& route : routes)
+    {
+        labels.push_back(labels_of(route));
+    }
+
+    std::ostringstream out;
+    out << std::setprecision(9);
+
+    write_counter(out, "is_route_messages_received_total",
+            "Messages received from the source system.",
+            routes, labels, &RouteMetricsSnapshot::messages_in);
+    write_counter(out, "is_route_messages_sent_total",
+            "Messages accepted by the destination system.",
+            routes, labels, &RouteMetricsSnapshot::messages_out);
+    write_counter(out, "is_route_conversions_total",
+            "Messages converted between the source and destination types.",
+            routes, labels, &RouteMetricsSnapshot::conversions);
+    write_counter(out, "is_route_drops_total",
+            "Messages dropped before reaching the destination system.",
+            routes, labels, &RouteMetricsSnapshot::drops);
+    write_counter(out, "is_route_failures_total",
+            "Messages rejected by the destination system.",
+            routes, labels, &RouteMetricsSnapshot::failures);
+    write_gauge(out, "is_route_queued_messages",
+            "Messages waiting to be handed to the destination system.",
+            routes, labels, &RouteMetricsSnapshot::queued_messages);
+    write_gauge(out, "is_route_queued_bytes",
+            "Estimated memory held by the messages waiting to be handed to the destination system.",
+            routes, labels, &RouteMetricsSnapshot::queued_bytes);
+    write_gauge(out, "is_route_retained_bytes",
+            "Estimated memory kept by the route for reuse, such as pooled messages and buffers.",
+            routes, labels, &RouteMetricsSnapshot::retained_bytes);
+    write_gauge(out, "is_route_dynamic_publishers",
+            "Publishers kept for the topic names computed from the messages of the route.",
+            routes, labels, &RouteMetricsSnapshot::dynamic_publishers);
+    write_counter(out, "is_route_publisher_evictions_total",
+            "Publishers of computed topic names released to make room for new ones.",
+            routes, labels, &RouteMetricsSnapshot::publisher_evictions);
+    write_histogram(out, "is_route_publish_seconds",
+            "Time spent by the destination system to accept each message.",
+            routes, labels, &RouteMetricsSnapshot::publish_time, false);
+    write_histogram(out, "is_route_round_trip_seconds",
+            "Time elapsed since a service request was received until its reply was delivered.",
+            routes, labels, &RouteMetricsSnapshot::round_trip_time, true);
+
+    return out.str();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,250 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/PendingCalls.hpp>
+#include <is/utils/Log.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+class PendingCalls::Implementation
+{
+public:
+
+    Implementation(
+            const std::string& name,
+            std::chrono::nanoseconds timeout,
+            std::size_t max_in_flight,
+            TimeoutCallback on_timeout)
+        : _name(name)
+        , _timeout(timeout)
+        , _max_in_flight(max_in_flight)
+        , _on_timeout(std::move(on_timeout))
+        , _next_id(0)
+        , _stop(false)
+        , _timeouts(0)
+        , _logger("is::core::PendingCalls")
+    {
+        if (_timeout > std::chrono::nanoseconds::zero())
+        {
+            _worker = std::thread(&Implementation::expire, this);
+        }
+    }
+
+    ~Implementation()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+
+        _changed.notify_all();
+
+        if (_worker.joinable())
+        {
+            _worker.join();
+        }
+    }
+
+    std::shared_ptr<void> add(
+            ServiceClient& client,
+            std::shared_ptr<void> call_handle)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        if (_max_in_flight > 0 && _calls.size() >= _max_in_flight)
+        {
+            return nullptr;
+        }
+
+        const uint64_t id = _next_id++;
+        _calls.emplace(id, Call{&client, std::move(call_handle), std::chrono::steady_clock::now()});
+
+        /**
+         * Calls share the same timeout, so the earliest deadline only changes
+         * when a call is added into an empty table.
+         */
+        if (_calls.size() == 1)
+        {
+            lock.unlock();
+            _changed.notify_one();
+        }
+
+        return std::make_shared<Token>(Token{id});
+    }
+
+    bool take(
+            const std::shared_ptr<void>& token,
+            Call& call)
+    {
+        if (!token)
+        {
+            return false;
+        }
+
+        const uint64_t id = std::static_pointer_cast<Token>(token)->id;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        auto it = _calls.find(id);
+        if (it == _calls.end())
+        {
+            return false;
+        }
+
+        call = std::move(it->second);
+        _calls.erase(it);
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _calls.size();
+    }
+
+    uint64_t timeouts() const
+    {
+        return _timeouts;
+    }
+
+private:
+
+    struct Token
+    {
+        uint64_t id;
+    };
+
+    void expire()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (!_stop)
+        {
+            if (_calls.empty())
+            {
+                _changed.wait(lock);
+                continue;
+            }
+
+            // Identifiers are given in call order, so the first call is the oldest one.
+            const auto deadline = _calls.begin()->second.start + _timeout;
+            if (std::chrono::steady_clock::now() < deadline)
+            {
+                _changed.wait_until(lock, deadline);
+                continue;
+            }
+
+            Call call = std::move(_calls.begin()->second);
+            _calls.erase(_calls.begin());
+            ++_timeouts;
+
+            lock.unlock();
+            cancel(call);
+            lock.lock();
+        }
+    }
+
+    void cancel(
+            const Call& call)
+    {
+        _logger << utils::Logger::Level::DEBUG
+                << "A call of '" << _name << "' was abandoned after waiting for its reply for "
+                << std::chrono::duration_cast<std::chrono::milliseconds>(_timeout).count()
+                << " ms." << std::endl;
+
+        try
+        {
+            if (_on_timeout)
+            {
+                _on_timeout(call);
+            }
+            call.client->receive_cancellation(call.handle);
+        }
+        catch (const std::exception& e)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Failed to cancel a call of '" << _name << "': " << e.what() << std::endl;
+        }
+    }
+
+    const std::string _name;
+    const std::chrono::nanoseconds _timeout;
+    const std::size_t _max_in_flight;
+    const TimeoutCallback _on_timeout;
+
+    std::map<uint64_t, Call> _calls;
+    uint64_t _next_id;
+    bool _stop;
+    std::atomic<uint64_t> _timeouts;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _changed;
+    std::thread _worker;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+PendingCalls::PendingCalls(
+        const std::string& name,
+        std::chrono::nanoseconds timeout,
+        std::size_t max_in_flight,
+        TimeoutCallback on_timeout)
+    : _pimpl(new Implementation(name, timeout, max_in_flight, std::move(on_timeout)))
+{
+}
+
+//==============================================================================
+PendingCalls::~PendingCalls() = default;
+
+//==============================================================================
+std::shared_ptr<void> PendingCalls::add(
+        ServiceClient& client,
+        std::shared_ptr<void> call_handle)
+{
+    return _pimpl->add(client, std::move(call_handle));
+}
+
+//==============================================================================
+bool PendingCalls::take(
+        const std::shared_ptr<void>& token,
+        Call& call)
+{
+    return _pimpl->take(token, call);
+}
+
+//==============================================================================
+std::size_t PendingCalls::size() const
+{
+    return _pimpl->size();
+}
+
+//==============================================================================
+uint64_t PendingCalls::timeouts() const
+{
+    return _pimpl->timeouts();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,359 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/MemoryUsage.hpp>
+#include <is/core/runtime/PriorityDispatcher.hpp>
+#include <is/utils/Log.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+class PriorityDispatcher::Implementation
+{
+public:
+
+    Implementation(
+            const std::string& name)
+        : _name(name)
+        , _queued(0)
+        , _last(0)
+        , _stop(false)
+        , _dropped(0)
+        , _logger("is::core::PriorityDispatcher")
+    {
+        _worker = std::thread(&Implementation::work, this);
+    }
+
+    ~Implementation()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+
+        _not_empty.notify_all();
+        _not_full.notify_all();
+
+        if (_worker.joinable())
+        {
+            _worker.join();
+        }
+    }
+
+    std::size_t add_lane(
+            int priority,
+            std::size_t depth,
+            DispatchQueue::Policy policy,
+            Consumer consumer)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _lanes.push_back(Lane{priority, depth > 0 ? depth : 1, policy,
+                              std::make_shared<const Consumer>(std::move(consumer)), {}, 0});
+        return _lanes.size() - 1;
+    }
+
+    void remove_lane(
+            std::size_t lane_id)
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            Lane& lane = _lanes.at(lane_id);
+            _queued -= lane.queue.size();
+            lane.queue.clear();
+            lane.bytes = 0;
+            lane.consumer.reset();
+        }
+
+        _not_full.notify_all();
+    }
+
+    PushResult push(
+            std::size_t lane_id,
+            std::shared_ptr<const xtypes::DynamicData> message)
+    {
+        bool evicted = false;
+        const std::size_t bytes = message ? MemoryUsage::of(*message) : 0;
+
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            Lane& lane = _lanes.at(lane_id);
+            if (!lane.consumer)
+            {
+                ++_dropped;
+                return PushResult::DROPPED;
+            }
+
+            if (lane.queue.size() >= lane.depth)
+            {
+                switch (lane.policy)
+                {
+                    case DispatchQueue::Policy::DROP_OLDEST:
+                    {
+                        lane.bytes -= lane.queue.front().bytes;
+                        lane.queue.pop_front();
+                        --_queued;
+                        evicted = true;
+                        break;
+                    }
+                    case DispatchQueue::Policy::DROP_NEWEST:
+                    {
+                        ++_dropped;
+                        return PushResult::DROPPED;
+                    }
+                    case DispatchQueue::Policy::BLOCK:
+                    {
+                        _not_full.wait(lock, [this, &lane]()
+                                {
+                                    return _stop || !lane.consumer || lane.queue.size() < lane.depth;
+                                });
+
+                        if (_stop)
+                        {
+                            return PushResult::QUEUED;
+                        }
+                        if (!lane.consumer)
+                        {
+                            ++_dropped;
+                            return PushResult::DROPPED;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            lane.queue.push_back({std::move(message), bytes});
+            lane.bytes += bytes;
+            ++_queued;
+        }
+
+        _not_empty.notify_one();
+
+        if (evicted)
+        {
+            ++_dropped;
+            return PushResult::EVICTED;
+        }
+
+        return PushResult::QUEUED;
+    }
+
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _queued;
+    }
+
+    std::size_t lane_size(
+            std::size_t lane_id) const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _lanes.at(lane_id).queue.size();
+    }
+
+    std::size_t lane_bytes(
+            std::size_t lane_id) const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _lanes.at(lane_id).bytes;
+    }
+
+    uint64_t dropped() const
+    {
+        return _dropped;
+    }
+
+private:
+
+    /**
+     * @brief A queued message, along with its estimated size.
+     */
+    struct Entry
+    {
+        std::shared_ptr<const xtypes::DynamicData> message;
+        std::size_t bytes;
+    };
+
+    /**
+     * The consumer is shared with the worker while it delivers a message,
+     * so that the lane can be removed meanwhile. Removed lanes have none.
+     */
+    struct Lane
+    {
+        int priority;
+        std::size_t depth;
+        DispatchQueue::Policy policy;
+        std::shared_ptr<const Consumer> consumer;
+        std::deque<Entry> queue;
+        std::size_t bytes;
+    };
+
+    /**
+     * @brief Selects the highest priority lane with messages waiting. The search starts
+     *        right after the last lane served, so that lanes with the same priority take turns.
+     *        Must be called with the mutex locked and some message queued.
+     */
+    std::size_t select() const
+    {
+        const std::size_t count = _lanes.size();
+        std::size_t selected = count;
+        for (std::size_t i = 1; i <= count; ++i)
+        {
+            const std::size_t candidate = (_last + i) % count;
+            if (!_lanes[candidate].queue.empty()
+                    && (selected == count || _lanes[candidate].priority > _lanes[selected].priority))
+            {
+                selected = candidate;
+            }
+        }
+        return selected;
+    }
+
+    void work()
+    {
+        while (true)
+        {
+            std::shared_ptr<const xtypes::DynamicData> message;
+            std::shared_ptr<const Consumer> consumer;
+
+            {
+                std::unique_lock<std::mutex> lock(_mutex);
+                _not_empty.wait(lock, [this]()
+                        {
+                            return _stop || _queued > 0;
+                        });
+
+                if (_stop)
+                {
+                    return;
+                }
+
+                _last = select();
+                Lane& lane = _lanes[_last];
+                message = std::move(lane.queue.front().message);
+                lane.bytes -= lane.queue.front().bytes;
+                lane.queue.pop_front();
+                --_queued;
+                consumer = lane.consumer;
+            }
+
+            _not_full.notify_all();
+
+            try
+            {
+                (*consumer)(message);
+            }
+            catch (const std::exception& e)
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "Priority dispatcher '" << _name << "' failed to deliver a message: "
+                        << e.what() << std::endl;
+            }
+        }
+    }
+
+    const std::string _name;
+
+    /**
+     * Removed lanes are only emptied, so that the identifiers of the other lanes,
+     * and the ones kept by the probes of the removed routes, stay valid.
+     * A deque keeps the references to them valid while new lanes are added.
+     */
+    std::deque<Lane> _lanes;
+    std::size_t _queued;
+    std::size_t _last;
+    bool _stop;
+    std::atomic<uint64_t> _dropped;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _not_empty;
+    std::condition_variable _not_full;
+    std::thread _worker;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+PriorityDispatcher::PriorityDispatcher(
+        const std::string& name)
+    : _pimpl(new Implementation(name))
+{
+}
+
+//==============================================================================
+PriorityDispatcher::~PriorityDispatcher() = default;
+
+//==============================================================================
+std::size_t PriorityDispatcher::add_lane(
+        int priority,
+        std::size_t depth,
+        DispatchQueue::Policy policy,
+        Consumer consumer)
+{
+    return _pimpl->add_lane(priority, depth, policy, std::move(consumer));
+}
+
+//==============================================================================
+void PriorityDispatcher::remove_lane(
+        std::size_t lane)
+{
+    _pimpl->remove_lane(lane);
+}
+
+//==============================================================================
+PriorityDispatcher::PushResult PriorityDispatcher::push(
+        std::size_t lane,
+        std::shared_ptr<const xtypes::DynamicData> message)
+{
+    return _pimpl->push(lane, std::move(message));
+}
+
+//==============================================================================
+std::size_t PriorityDispatcher::size() const
+{
+    return _pimpl->size();
+}
+
+//==============================================================================
+std::size_t PriorityDispatcher::lane_size(
+        std::size_t lane) const
+{
+    return _pimpl->lane_size(lane);
+}
+
+//==============================================================================
+std::size_t PriorityDispatcher::lane_bytes(
+        std::size_t lane) const
+{
+    return _pimpl->lane_bytes(lane);
+}
+
+//==============================================================================
+uint64_t PriorityDispatcher::dropped() const
+{
+    return _pimpl->dropped();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/PublishBatch.hpp>
+
+#include <chrono>
+#include <iterator>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+/**
+ * The batch open on each thread, if any.
+ */
+thread_local PublishBatch* current_batch = nullptr;
+
+} //  anonymous namespace
+
+//==============================================================================
+PublishBatch::PublishBatch()
+    : _open(nullptr == current_batch)
+{
+    if (_open)
+    {
+        current_batch = this;
+    }
+}
+
+//==============================================================================
+PublishBatch::~PublishBatch()
+{
+    if (_open)
+    {
+        flush();
+        current_batch = nullptr;
+    }
+}
+
+//==============================================================================
+void PublishBatch::flush()
+{
+    /**
+     * Publishing may route new messages into this same batch, for example, if the
+     * destination SystemHandle delivers them synchronously, so they are taken
+     * out before publishing them, and published in a later iteration.
+     */
+    while (!_pending.empty())
+    {
+        std::vector<Pending> pending;
+        pending.swap(_pending);
+
+        for (Pending& entry : pending)
+        {
+            publish(entry);
+        }
+    }
+}
+
+//==============================================================================
+bool PublishBatch::add(
+        const std::shared_ptr<TopicPublisher>& publisher,
+        std::shared_ptr<const xtypes::DynamicData> message,
+        const std::shared_ptr<RouteMetrics>& metrics)
+{
+    PublishBatch* batch = current_batch;
+    if (nullptr == batch)
+    {
+        return false;
+    }
+
+    auto it = batch->_pending.begin();
+    while (it != batch->_pending.end() && (it->publisher != publisher || it->metrics != metrics))
+    {
+        ++it;
+    }
+
+    if (it == batch->_pending.end())
+    {
+        batch->_pending.push_back(Pending{publisher, metrics, {}});
+        it = std::prev(batch->_pending.end());
+    }
+
+    it->messages.push_back(std::move(message));
+
+    if (it->messages.size() >= MAX_SIZE)
+    {
+        Pending full{publisher, metrics, {}};
+        full.messages.swap(it->messages);
+        publish(full);
+    }
+
+    return true;
+}
+
+//==============================================================================
+void PublishBatch::publish(
+        Pending& pending)
+{
+    if (pending.messages.empty())
+    {
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool published = pending.publisher->publish_batch(pending.messages);
+    const auto duration = (std::chrono::steady_clock::now() - start) / pending.messages.size();
+
+    for (std::size_t i = 0; i < pending.messages.size(); ++i)
+    {
+        pending.metrics->sent(published, duration);
+    }
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
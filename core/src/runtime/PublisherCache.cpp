@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/PublisherCache.hpp>
+#include <is/utils/Log.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <unordered_map>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+class PublisherCache::Implementation
+{
+public:
+
+    Implementation(
+            const std::string& name,
+            std::size_t capacity,
+            Advertiser advertiser)
+        : _name(name)
+        , _capacity(capacity > 0 ? capacity : 1)
+        , _advertiser(std::move(advertiser))
+        , _logger("is::core::PublisherCache")
+    {
+        _entries.reserve(_capacity);
+    }
+
+    std::shared_ptr<TopicPublisher> get(
+            const std::string& topic_name)
+    {
+        /**
+         * Hits only take the lock shared, and record their use in the entry, so that
+         * publishing to already advertised names does not serialize the callers.
+         */
+        {
+            std::shared_lock<std::shared_mutex> lock(_mutex);
+            auto it = _entries.find(topic_name);
+            if (it != _entries.end())
+            {
+                return hit(it->second);
+            }
+        }
+
+        std::unique_lock<std::shared_mutex> lock(_mutex);
+
+        /**
+         * A name is advertised only once, by the first caller requesting it.
+         * The others wait for it, while names already cached are still served.
+         */
+        _advertised.wait(lock, [&]()
+                {
+                    return _advertising.count(topic_name) == 0;
+                });
+
+        auto it = _entries.find(topic_name);
+        if (it != _entries.end())
+        {
+            return hit(it->second);
+        }
+
+        ++_misses;
+        _advertising.insert(topic_name);
+        lock.unlock();
+
+        std::shared_ptr<TopicPublisher> publisher;
+        try
+        {
+            publisher = _advertiser(topic_name);
+        }
+        catch (...)
+        {
+            lock.lock();
+            _advertising.erase(topic_name);
+            _advertised.notify_all();
+            throw;
+        }
+
+        lock.lock();
+        _advertising.erase(topic_name);
+        _advertised.notify_all();
+
+        if (!publisher)
+        {
+            ++_failures;
+            _logger << utils::Logger::Level::WARN
+                    << "Publisher cache '" << _name << "' could not advertise the topic '"
+                    << topic_name << "'." << std::endl;
+
+            return nullptr;
+        }
+
+        /**
+         * The evicted publisher is released once the lock is given back.
+         */
+        std::shared_ptr<TopicPublisher> evicted;
+        if (_entries.size() >= _capacity)
+        {
+            auto lru = _entries.begin();
+            for (auto entry = _entries.begin(); entry != _entries.end(); ++entry)
+            {
+                if (entry->second.last_use < lru->second.last_use)
+                {
+                    lru = entry;
+                }
+            }
+
+            ++_evictions;
+            _logger << utils::Logger::Level::DEBUG
+                    << "Publisher cache '" << _name << "' is full, releasing the publisher "
+                    << "of the least recently used topic '" << lru->first << "'." << std::endl;
+
+            evicted = std::move(lru->second.publisher);
+            _entries.erase(lru);
+        }
+
+        Entry& entry = _entries[topic_name];
+        entry.publisher = publisher;
+        entry.last_use = ++_clock;
+
+        lock.unlock();
+        evicted.reset();
+        return publisher;
+    }
+
+    Stats stats() const
+    {
+        std::shared_lock<std::shared_mutex> lock(_mutex);
+        Stats stats;
+        stats.hits = _hits;
+        stats.misses = _misses;
+        stats.evictions = _evictions;
+        stats.failures = _failures;
+        stats.size = _entries.size();
+        return stats;
+    }
+
+private:
+
+    struct Entry
+    {
+        std::shared_ptr<TopicPublisher> publisher;
+        std::atomic<uint64_t> last_use{0};
+    };
+
+    std::shared_ptr<TopicPublisher> hit(
+            Entry& entry)
+    {
+        ++_hits;
+        entry.last_use.store(++_clock, std::memory_order_relaxed);
+        return entry.publisher;
+    }
+
+    const std::string _name;
+    const std::size_t _capacity;
+    const Advertiser _advertiser;
+
+    std::unordered_map<std::string, Entry> _entries;
+    std::set<std::string> _advertising;
+    std::atomic<uint64_t> _clock{0};
+    std::atomic<uint64_t> _hits{0};
+    uint64_t _misses = 0;
+    uint64_t _evictions = 0;
+    uint64_t _failures = 0;
+    mutable std::shared_mutex _mutex;
+    std::condition_variable_any _advertised;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+PublisherCache::PublisherCache(
+        const std::string& name,
+        std::size_t capacity,
+        Advertiser advertiser)
+    : _pimpl(new Implementation(name, capacity, std::move(advertiser)))
+{
+}
+
+//==============================================================================
+PublisherCache::~PublisherCache() = default;
+
+//==============================================================================
+std::shared_ptr<TopicPublisher> PublisherCache::get(
+        const std::string& topic_name)
+{
+    return _pimpl->get(topic_name);
+}
+
+//==============================================================================
+PublisherCache::Stats PublisherCache::stats() const
+{
+    return _pimpl->stats();
+}
+
+//==============================================================================
+DynamicTopicPublisher::DynamicTopicPublisher(
+        const std::string& topic_template,
+        const xtypes::DynamicType& message_type,
+        std::size_t capacity,
+        PublisherCache::Advertiser advertiser)
+    : _topic_template(topic_template, "dynamic topic name", message_type)
+    , _cache(topic_template, capacity, std::move(advertiser))
+{
+}
+
+//==============================================================================
+DynamicTopicPublisher::~DynamicTopicPublisher() = default;
+
+//==============================================================================
+bool DynamicTopicPublisher::publish(
+        const xtypes::DynamicData& message)
+{
+    std::shared_ptr<TopicPublisher> publisher = publisher_for(message);
+    return publisher && publisher->publish(message);
+}
+
+//==============================================================================
+bool DynamicTopicPublisher::publish_shared(
+        const std::shared_ptr<const xtypes::DynamicData>& message)
+{
+    std::shared_ptr<TopicPublisher> publisher = publisher_for(*message);
+    return publisher && publisher->publish_shared(message);
+}
+
+//==============================================================================
+bool DynamicTopicPublisher::prefers_shared_messages() const
+{
+    return true;
+}
+
+//==============================================================================
+const PublisherCache& DynamicTopicPublisher::cache() const
+{
+    return _cache;
+}
+
+//==============================================================================
+std::shared_ptr<TopicPublisher> DynamicTopicPublisher::publisher_for(
+        const xtypes::DynamicData& message)
+{
+    static utils::Logger logger("is::core::DynamicTopicPublisher");
+
+    try
+    {
+        return _cache.get(_topic_template.compute_string(message));
+    }
+    catch (const UnavailableMessageField& e)
+    {
+        logger << utils::Logger::Level::ERROR
+               << "Could not compute the topic name of a message: " << e.what() << std::endl;
+
+        return nullptr;
+    }
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/MemoryUsage.hpp>
+#include <is/core/runtime/RateLimiter.hpp>
+#include <is/utils/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+class RateLimiter::Implementation
+    : public std::enable_shared_from_this<RateLimiter::Implementation>
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    Implementation(
+            const std::string& name,
+            double max_rate,
+            std::size_t burst,
+            bool latest_only,
+            TaskScheduler scheduler)
+        : _name(name)
+        , _rate(max_rate > 0.0 ? max_rate : 1.0)
+        , _burst(static_cast<double>(std::max<std::size_t>(burst, 1)))
+        , _latest_only(latest_only)
+        , _scheduler(std::move(scheduler))
+        , _tokens(_burst)
+        , _last_refill(Clock::now())
+        , _holding(false)
+        , _scheduled(false)
+        , _dropped(0)
+        , _logger("is::core::RateLimiter")
+    {
+    }
+
+    bool offer(
+            std::shared_ptr<const xtypes::DynamicData> message,
+            const Consumer& consumer)
+    {
+        std::shared_ptr<const xtypes::DynamicData> held;
+        Consumer held_consumer;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            refill(Clock::now());
+
+            /**
+             * Without a scheduler, the message kept aside is released by the next offer.
+             */
+            if (_holding && !_scheduler && _tokens >= 1.0)
+            {
+                _tokens -= 1.0;
+                _holding = false;
+                held = std::move(_held);
+                held_consumer = std::move(_held_consumer);
+            }
+
+            /**
+             * A message kept aside goes first, so a new one cannot overtake it.
+             */
+            if (_holding || _tokens < 1.0)
+            {
+                if (!_latest_only)
+                {
+                    ++_dropped;
+                    lock.unlock();
+                    deliver(held, held_consumer);
+                    return false;
+                }
+
+                const bool replaced = _holding;
+                _held = std::move(message);
+                _held_consumer = consumer;
+                _holding = true;
+                schedule();
+                lock.unlock();
+
+                deliver(held, held_consumer);
+                if (replaced)
+                {
+                    ++_dropped;
+                }
+                return !replaced;
+            }
+
+            _tokens -= 1.0;
+        }
+
+        deliver(held, held_consumer);
+        deliver(message, consumer);
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _holding ? 1 : 0;
+    }
+
+    std::size_t bytes() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _holding && _held ? MemoryUsage::of(*_held) : 0;
+    }
+
+    uint64_t dropped() const
+    {
+        return _dropped;
+    }
+
+private:
+
+    void refill(
+            Clock::time_point now)
+    {
+        const double elapsed = std::chrono::duration<double>(now - _last_refill).count();
+        _tokens = std::min(_burst, _tokens + elapsed * _rate);
+        _last_refill = now;
+    }
+
+    /**
+     * Schedules the release of the message kept aside for when the next token arrives,
+     * unless it is already scheduled. Must be called with the mutex locked.
+     */
+    void schedule()
+    {
+        if (!_scheduler || _scheduled)
+        {
+            return;
+        }
+
+        _scheduled = true;
+        const auto delay = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(std::max(0.0, 1.0 - _tokens) / _rate));
+
+        std::weak_ptr<Implementation> limiter = shared_from_this();
+        _scheduler([limiter]()
+                {
+                    if (std::shared_ptr<Implementation> alive = limiter.lock())
+                    {
+                        alive->release();
+                    }
+                }, delay);
+    }
+
+    void release()
+    {
+        std::shared_ptr<const xtypes::DynamicData> message;
+        Consumer consumer;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _scheduled = false;
+            if (!_holding)
+            {
+                return;
+            }
+
+            refill(Clock::now());
+            if (_tokens < 1.0)
+            {
+                schedule();
+                return;
+            }
+
+            _tokens -= 1.0;
+            _holding = false;
+            message = std::move(_held);
+            consumer = std::move(_held_consumer);
+        }
+
+        deliver(message, consumer);
+    }
+
+    void deliver(
+            const std::shared_ptr<const xtypes::DynamicData>& message,
+            const Consumer& consumer)
+    {
+        if (!consumer)
+        {
+            return;
+        }
+
+        try
+        {
+            consumer(message);
+        }
+        catch (const std::exception& e)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Rate limiter '" << _name << "' failed to deliver a message: "
+                    << e.what() << std::endl;
+        }
+    }
+
+    const std::string _name;
+    const double _rate;
+    const double _burst;
+    const bool _latest_only;
+    const TaskScheduler _scheduler;
+
+    double _tokens;
+    Clock::time_point _last_refill;
+    std::shared_ptr<const xtypes::DynamicData> _held;
+    Consumer _held_consumer;
+    bool _holding;
+    bool _scheduled;
+    std::atomic<uint64_t> _dropped;
+
+    mutable std::mutex _mutex;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+RateLimiter::RateLimiter(
+        const std::string& name,
+        double max_rate,
+        std::size_t burst,
+        bool latest_only,
+        TaskScheduler scheduler)
+    : _pimpl(std::make_shared<Implementation>(name, max_rate, burst, latest_only, std::move(scheduler)))
+{
+}
+
+//==============================================================================
+RateLimiter::~RateLimiter() = default;
+
+//==============================================================================
+bool RateLimiter::offer(
+        std::shared_ptr<const xtypes::DynamicData> message,
+        const Consumer& consumer)
+{
+    return _pimpl->offer(std::move(message), consumer);
+}
+
+//==============================================================================
+std::size_t RateLimiter::size() const
+{
+    return _pimpl->size();
+}
+
+//==============================================================================
+std::size_t RateLimiter::bytes() const
+{
+    return _pimpl->bytes();
+}
+
+//==============================================================================
+uint64_t RateLimiter::dropped() const
+{
+    return _pimpl->dropped();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/DataHash.hpp>
+#include <is/core/runtime/RequestCoalescer.hpp>
+#include <is/core/runtime/ServiceCall.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+class RequestCoalescer::Implementation
+{
+public:
+
+    Implementation(
+            ServiceClient& owner,
+            std::shared_ptr<ServiceProvider> provider,
+            std::chrono::nanoseconds reply_ttl,
+            std::chrono::nanoseconds max_age,
+            std::size_t max_waiters)
+        : _owner(owner)
+        , _provider(std::move(provider))
+        , _reply_ttl(reply_ttl)
+        , _max_age(max_age)
+        , _max_waiters(std::max<std::size_t>(1, max_waiters))
+        , _sweep_size(64)
+        , _calls(0)
+        , _coalesced(0)
+    {
+    }
+
+    void call_service(
+            const xtypes::DynamicData& request,
+            ServiceClient& client,
+            std::shared_ptr<void> call_handle)
+    {
+        const std::size_t hash = DataHash::of(request);
+        const auto now = std::chrono::steady_clock::now();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        if (_reply_ttl > std::chrono::nanoseconds::zero())
+        {
+            auto range = _replies.equal_range(hash);
+            for (auto it = range.first; it != range.second;)
+            {
+                if (it->second.expiry <= now)
+                {
+                    it = _replies.erase(it);
+                }
+                else if (it->second.request == request)
+                {
+                    const xtypes::DynamicData response(it->second.response);
+                    lock.unlock();
+
+                    ++_coalesced;
+                    client.receive_response(call_handle, response);
+                    return;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+
+        auto range = _pending.equal_range(hash);
+        for (auto it = range.first; it != range.second;)
+        {
+            Pending& pending = *it->second;
+            if (_max_age > std::chrono::nanoseconds::zero() && now - pending.start() >= _max_age)
+            {
+                // The request still gets its reply, if it ever arrives, but takes no more waiters.
+                it = _pending.erase(it);
+            }
+            else if (pending.request == request)
+            {
+                pending.waiters.push_back(Waiter{&client, std::move(call_handle)});
+                if (pending.waiters.size() >= _max_waiters)
+                {
+                    // Full: the request still gets its reply, but the next identical one makes a new call.
+                    _pending.erase(it);
+                }
+                ++_coalesced;
+                return;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        std::shared_ptr<Pending> pending = std::make_shared<Pending>(*this, hash, request);
+        pending->waiters.push_back(Waiter{&client, std::move(call_handle)});
+        if (_max_waiters > 1)
+        {
+            _pending.emplace(hash, pending);
+        }
+        lock.unlock();
+
+        ++_calls;
+        const std::shared_ptr<ServiceCall> call = pending;
+        _provider->call_service(request, _owner, call);
+    }
+
+    void receive_response(
+            std::shared_ptr<void> call_handle,
+            const xtypes::DynamicData& response)
+    {
+        ServiceCall::from(call_handle)->reply(response);
+    }
+
+    void receive_cancellation(
+            std::shared_ptr<void> call_handle)
+    {
+        ServiceCall::from(call_handle)->cancel();
+    }
+
+    uint64_t calls() const
+    {
+        return _calls;
+    }
+
+    uint64_t coalesced() const
+    {
+        return _coalesced;
+    }
+
+private:
+
+    struct Waiter
+    {
+        ServiceClient* client;
+        std::shared_ptr<void> handle;
+    };
+
+    /**
+     * The call forwarded to the provider for a request, which hands its reply to all the waiters.
+     */
+    struct Pending : public ServiceCall
+    {
+        Pending(
+                Implementation& implementation,
+                std::size_t hash_,
+                const xtypes::DynamicData& request_)
+            : ServiceCall(implementation._owner, nullptr)
+            , coalescer(implementation)
+            , hash(hash_)
+            , request(request_)
+        {
+        }
+
+        void deliver(
+                const xtypes::DynamicData& response) override
+        {
+            coalescer.replied(*this, response);
+        }
+
+        void deliver_cancellation() override
+        {
+            coalescer.cancelled(*this);
+        }
+
+        Implementation& coalescer;
+        std::size_t hash;
+        xtypes::DynamicData request;
+        std::vector<Waiter> waiters;
+    };
+
+    struct Reply
+    {
+        xtypes::DynamicData request;
+        xtypes::DynamicData response;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    void replied(
+            Pending& pending,
+            const xtypes::DynamicData& response)
+    {
+        std::vector<Waiter> waiters;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            waiters = finish(pending);
+
+            if (_reply_ttl > std::chrono::nanoseconds::zero())
+            {
+                const auto now = std::chrono::steady_clock::now();
+                if (_replies.size() >= _sweep_size)
+                {
+                    sweep(now);
+                }
+                _replies.emplace(pending.hash, Reply{pending.request, response, now + _reply_ttl});
+            }
+        }
+
+        for (const Waiter& waiter : waiters)
+        {
+            waiter.client->receive_response(waiter.handle, response);
+        }
+    }
+
+    void cancelled(
+            Pending& pending)
+    {
+        std::vector<Waiter> waiters;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            waiters = finish(pending);
+        }
+
+        for (const Waiter& waiter : waiters)
+        {
+            waiter.client->receive_cancellation(waiter.handle);
+        }
+    }
+
+    /**
+     * Removes a request from the pending ones, if it is still there,
+     * and takes its waiters. Must be called with the mutex locked.
+     */
+    std::vector<Waiter> finish(
+            Pending& pending)
+    {
+        auto range = _pending.equal_range(pending.hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second.get() == &pending)
+            {
+                _pending.erase(it);
+                break;
+            }
+        }
+
+        return std::move(pending.waiters);
+    }
+
+    /**
+     * Removes the expired replies, so that the cache does not grow with requests
+     * that are never repeated. Must be called with the mutex locked.
+     */
+    void sweep(
+            std::chrono::steady_clock::time_point now)
+    {
+        for (auto it = _replies.begin(); it != _replies.end();)
+        {
+            it = it->second.expiry <= now ? _replies.erase(it) : std::next(it);
+        }
+        _sweep_size = std::max<std::size_t>(64, 2 * _replies.size());
+    }
+
+    ServiceClient& _owner;
+    const std::shared_ptr<ServiceProvider> _provider;
+    const std::chrono::nanoseconds _reply_ttl;
+    const std::chrono::nanoseconds _max_age;
+    const std::size_t _max_waiters;
+
+    std::unordered_multimap<std::size_t, std::shared_ptr<Pending> > _pending;
+    std::unordered_multimap<std::size_t, Reply> _replies;
+    std::size_t _sweep_size;
+
+    std::atomic<uint64_t> _calls;
+    std::atomic<uint64_t> _coalesced;
+
+    std::mutex _mutex;
+};
+
+//==============================================================================
+RequestCoalescer::RequestCoalescer(
+        std::shared_ptr<ServiceProvider> provider,
+        std::chrono::nanoseconds reply_ttl,
+        std::chrono::nanoseconds max_age,
+        std::size_t max_waiters)
+    : _pimpl(new Implementation(*this, std::move(provider), reply_ttl, max_age, max_waiters))
+{
+}
+
+//==============================================================================
+RequestCoalescer::~RequestCoalescer() = default;
+
+//==============================================================================
+void RequestCoalescer::call_service(
+        const xtypes::DynamicData& request,
+        ServiceClient& client,
+        std::shared_ptr<void> call_handle)
+{
+    _pimpl->call_service(request, client, std::move(call_handle));
+}
+
+//==============================================================================
+void RequestCoalescer::receive_response(
+        std::shared_ptr<void> call_handle,
+        const xtypes::DynamicData& response)
+{
+    _pimpl->receive_response(std::move(call_handle), response);
+}
+
+//==============================================================================
+void RequestCoalescer::receive_cancellation(
+        std::shared_ptr<void> call_handle)
+{
+    _pimpl->receive_cancellation(std::move(call_handle));
+}
+
+//==============================================================================
+uint64_t RequestCoalescer::calls() const
+{
+    return _pimpl->calls();
+}
+
+//==============================================================================
+uint64_t RequestCoalescer::coalesced() const
+{
+    return _pimpl->coalesced();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
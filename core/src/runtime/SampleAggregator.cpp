@@ -0,0 +1,529 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/SampleAggregator.hpp>
+#include <is/core/runtime/TrafficRecorder.hpp>
+#include <is/utils/Log.hpp>
+
+#ifdef IS_CORE_HAVE_LZ4
+#include <lz4.h>
+#endif //  IS_CORE_HAVE_LZ4
+
+#ifdef IS_CORE_HAVE_ZSTD
+#include <zstd.h>
+#endif //  IS_CORE_HAVE_ZSTD
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <thread>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+using Compression = SampleAggregator::Compression;
+
+/**
+ * Upper bounds of the ratio between the decompressed and the compressed size of a payload.
+ * LZ4 needs a byte for every 255 bytes of a match, and the largest ZSTD block, of 128 KiB,
+ * can be run length encoded in 4 bytes.
+ */
+constexpr std::size_t lz4_max_ratio = 255;
+constexpr std::size_t zstd_max_ratio = 32768;
+
+//==============================================================================
+bool compress(
+        Compression compression,
+        const std::string& input,
+        std::string& output)
+{
+    switch (compression)
+    {
+#ifdef IS_CORE_HAVE_LZ4
+        case Compression::LZ4:
+        {
+            output.resize(static_cast<std::size_t>(LZ4_compressBound(static_cast<int>(input.size()))));
+            const int size = LZ4_compress_default(
+                input.data(), &output[0], static_cast<int>(input.size()), static_cast<int>(output.size()));
+            if (size <= 0)
+            {
+                return false;
+            }
+            output.resize(static_cast<std::size_t>(size));
+            return true;
+        }
+#endif //  IS_CORE_HAVE_LZ4
+#ifdef IS_CORE_HAVE_ZSTD
+        case Compression::ZSTD:
+        {
+            output.resize(ZSTD_compressBound(input.size()));
+            const std::size_t size = ZSTD_compress(&output[0], output.size(), input.data(), input.size(), 1);
+            if (ZSTD_isError(size))
+            {
+                return false;
+            }
+            output.resize(size);
+            return true;
+        }
+#endif //  IS_CORE_HAVE_ZSTD
+        default:
+            (void)input;
+            (void)output;
+            return false;
+    }
+}
+
+//==============================================================================
+bool decompress(
+        Compression compression,
+        const uint8_t* input,
+        std::size_t size,
+        std::size_t raw_size,
+        std::string& output)
+{
+    /**
+     * The size stated by the frame is checked against the compressed size before
+     * allocating it, so that forged frames cannot make the buffer grow unbounded.
+     */
+    switch (compression)
+    {
+#ifdef IS_CORE_HAVE_LZ4
+        case Compression::LZ4:
+        {
+            if (raw_size > size * lz4_max_ratio)
+            {
+                return false;
+            }
+            output.resize(raw_size);
+            return LZ4_decompress_safe(reinterpret_cast<const char*>(input), &output[0],
+                       static_cast<int>(size), static_cast<int>(raw_size)) == static_cast<int>(raw_size);
+        }
+#endif //  IS_CORE_HAVE_LZ4
+#ifdef IS_CORE_HAVE_ZSTD
+        case Compression::ZSTD:
+        {
+            if (raw_size > size * zstd_max_ratio || ZSTD_getFrameContentSize(input, size) != raw_size)
+            {
+                return false;
+            }
+            output.resize(raw_size);
+            return ZSTD_decompress(&output[0], raw_size, input, size) == raw_size;
+        }
+#endif //  IS_CORE_HAVE_ZSTD
+        default:
+            (void)input;
+            (void)size;
+            (void)raw_size;
+            (void)output;
+            return false;
+    }
+}
+
+} //  anonymous namespace
+
+class SampleAggregator::Implementation
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    Implementation(
+            const std::string& name,
+            std::size_t max_samples,
+            std::size_t max_bytes,
+            double max_delay,
+            Compression compression,
+            Consumer consumer)
+        : _name(name)
+        , _max_samples(std::max<std::size_t>(max_samples, 1))
+        , _max_bytes(max_bytes)
+        , _max_delay(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(max_delay)))
+        , _compression(compression)
+        , _consumer(std::move(consumer))
+        , _samples(0)
+        , _window(0)
+        , _stop(false)
+        , _delivery_capacity(0)
+        , _frames(0)
+        , _logger("is::core::SampleAggregator")
+    {
+        _worker = std::thread(&Implementation::work, this);
+    }
+
+    ~Implementation()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+
+        _window_changed.notify_all();
+        _worker.join();
+    }
+
+    bool offer(
+            const xtypes::ReadableDynamicDataRef& sample)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        /**
+         * The sample is encoded right after a placeholder for its size, in the buffer of the window.
+         */
+        const std::size_t start = _buffer.size();
+        _buffer.append(sizeof(uint32_t), '\0');
+        if (!TrafficRecorder::encode(sample, _buffer))
+        {
+            _buffer.resize(start);
+            return false;
+        }
+
+        const uint32_t size = static_cast<uint32_t>(_buffer.size() - start - sizeof(uint32_t));
+        std::memcpy(&_buffer[start], &size, sizeof(size));
+
+        if (++_samples == 1)
+        {
+            _deadline = Clock::now() + _max_delay;
+            _window_changed.notify_one();
+        }
+
+        if (_samples >= _max_samples || (_max_bytes > 0 && _buffer.size() >= _max_bytes))
+        {
+            deliver(lock);
+        }
+
+        return true;
+    }
+
+    void flush()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_samples > 0)
+        {
+            deliver(lock);
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _samples;
+    }
+
+    std::size_t bytes() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _buffer.size();
+    }
+
+    std::size_t retained() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _buffer.capacity() - _buffer.size() + _delivery_capacity;
+    }
+
+    uint64_t frames() const
+    {
+        return _frames;
+    }
+
+private:
+
+    void work()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (true)
+        {
+            _window_changed.wait(lock, [this]()
+                    {
+                        return _stop || _samples > 0;
+                    });
+
+            if (_stop)
+            {
+                return;
+            }
+
+            const uint64_t window = _window;
+            const bool changed = _window_changed.wait_until(lock, _deadline, [this, window]()
+                            {
+                                return _stop || _window != window;
+                            });
+
+            if (!changed)
+            {
+                deliver(lock);
+                lock.lock();
+            }
+        }
+    }
+
+    /**
+     * @brief Closes the open window and delivers its frame. The delivery lock is taken
+     *        before releasing the window lock, so that frames are delivered in order.
+     *
+     * @param[in] lock The window lock, which must be held. It is released on return.
+     */
+    void deliver(
+            std::unique_lock<std::mutex>& lock)
+    {
+        std::unique_lock<std::mutex> delivering(_delivery_mutex);
+
+        const uint32_t samples = _samples;
+        _samples = 0;
+        ++_window;
+        _pending.swap(_buffer);
+        _buffer.clear();
+        lock.unlock();
+
+        try
+        {
+            std::shared_ptr<const xtypes::DynamicData> frame = make_frame(samples);
+            _delivery_capacity = _pending.capacity() + _compressed.capacity();
+            _consumer(frame);
+            ++_frames;
+        }
+        catch (const std::exception& e)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Sample aggregator '" << _name << "' failed to deliver a frame: "
+                    << e.what() << std::endl;
+        }
+    }
+
+    std::shared_ptr<const xtypes::DynamicData> make_frame(
+            uint32_t samples)
+    {
+        const std::string* payload = &_pending;
+        Compression compression = Compression::NONE;
+        if (_compression != Compression::NONE
+                && compress(_compression, _pending, _compressed)
+                && _compressed.size() < _pending.size())
+        {
+            payload = &_compressed;
+            compression = _compression;
+        }
+
+        std::shared_ptr<xtypes::DynamicData> frame = std::make_shared<xtypes::DynamicData>(frame_type());
+        (*frame)["samples"].value<uint32_t>(samples);
+        (*frame)["compression"].value<uint8_t>(static_cast<uint8_t>(compression));
+        (*frame)["size"].value<uint32_t>(static_cast<uint32_t>(_pending.size()));
+
+        xtypes::WritableDynamicDataRef data = (*frame)["payload"];
+        data.resize(payload->size());
+        if (!payload->empty())
+        {
+            /**
+             * The reference obtained through the readable interface points to
+             * the storage owned by the writable DynamicData.
+             */
+            std::memcpy(const_cast<uint8_t*>(&data[0].value<uint8_t>()), payload->data(), payload->size());
+        }
+
+        return frame;
+    }
+
+    const std::string _name;
+    const std::size_t _max_samples;
+    const std::size_t _max_bytes;
+    const Clock::duration _max_delay;
+    const Compression _compression;
+    const Consumer _consumer;
+
+    /**
+     * The open window, guarded by `_mutex`.
+     */
+    std::string _buffer;
+    uint32_t _samples;
+    uint64_t _window;
+    Clock::time_point _deadline;
+    bool _stop;
+
+    /**
+     * The window being delivered, guarded by `_delivery_mutex`. Both buffers are
+     * swapped on each delivery, so that their memory is reused.
+     */
+    std::string _pending;
+    std::string _compressed;
+
+    /**
+     * The memory reserved by the buffers of the window being delivered.
+     */
+    std::atomic<std::size_t> _delivery_capacity;
+    std::atomic<uint64_t> _frames;
+
+    mutable std::mutex _mutex;
+    std::mutex _delivery_mutex;
+    std::condition_variable _window_changed;
+    std::thread _worker;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+SampleAggregator::SampleAggregator(
+        const std::string& name,
+        std::size_t max_samples,
+        std::size_t max_bytes,
+        double max_delay,
+        Compression compression,
+        Consumer consumer)
+    : _pimpl(new Implementation(name, max_samples, max_bytes, max_delay, compression, std::move(consumer)))
+{
+}
+
+//==============================================================================
+SampleAggregator::~SampleAggregator() = default;
+
+//==============================================================================
+bool SampleAggregator::offer(
+        const xtypes::ReadableDynamicDataRef& sample)
+{
+    return _pimpl->offer(sample);
+}
+
+//==============================================================================
+void SampleAggregator::flush()
+{
+    _pimpl->flush();
+}
+
+//==============================================================================
+std::size_t SampleAggregator::size() const
+{
+    return _pimpl->size();
+}
+
+//==============================================================================
+std::size_t SampleAggregator::bytes() const
+{
+    return _pimpl->bytes();
+}
+
+//==============================================================================
+std::size_t SampleAggregator::retained() const
+{
+    return _pimpl->retained();
+}
+
+//==============================================================================
+uint64_t SampleAggregator::frames() const
+{
+    return _pimpl->frames();
+}
+
+//==============================================================================
+const xtypes::StructType& SampleAggregator::frame_type()
+{
+    static const xtypes::StructType type = []()
+            {
+                xtypes::StructType frame("is::AggregatedFrame");
+                frame.add_member("samples", xtypes::primitive_type<uint32_t>());
+                frame.add_member("compression", xtypes::primitive_type<uint8_t>());
+                frame.add_member("size", xtypes::primitive_type<uint32_t>());
+                frame.add_member("payload", xtypes::SequenceType(xtypes::primitive_type<uint8_t>()));
+                return frame;
+            } ();
+
+    return type;
+}
+
+//==============================================================================
+bool SampleAggregator::available(
+        Compression compression)
+{
+    switch (compression)
+    {
+        case Compression::NONE:
+            return true;
+#ifdef IS_CORE_HAVE_LZ4
+        case Compression::LZ4:
+            return true;
+#endif //  IS_CORE_HAVE_LZ4
+#ifdef IS_CORE_HAVE_ZSTD
+        case Compression::ZSTD:
+            return true;
+#endif //  IS_CORE_HAVE_ZSTD
+        default:
+            return false;
+    }
+}
+
+//==============================================================================
+bool SampleAggregator::unpack(
+        const xtypes::ReadableDynamicDataRef& frame,
+        xtypes::DynamicData& sample,
+        const SampleConsumer& consumer)
+{
+    const uint32_t samples = frame["samples"].value<uint32_t>();
+    const Compression compression = static_cast<Compression>(frame["compression"].value<uint8_t>());
+    const std::size_t raw_size = frame["size"].value<uint32_t>();
+
+    const xtypes::ReadableDynamicDataRef payload = frame["payload"];
+    std::size_t size = payload.size();
+    const uint8_t* input = size > 0 ? &payload[0].value<uint8_t>() : nullptr;
+
+    /**
+     * Each receiving thread keeps its decompression buffer, so that it is only allocated once.
+     */
+    thread_local std::string decompressed;
+    if (compression != Compression::NONE)
+    {
+        if (!decompress(compression, input, size, raw_size, decompressed))
+        {
+            return false;
+        }
+        input = reinterpret_cast<const uint8_t*>(decompressed.data());
+        size = raw_size;
+    }
+    else if (size != raw_size)
+    {
+        return false;
+    }
+
+    std::size_t offset = 0;
+    for (uint32_t i = 0; i < samples; ++i)
+    {
+        uint32_t sample_size;
+        if (size - offset < sizeof(sample_size))
+        {
+            return false;
+        }
+        std::memcpy(&sample_size, input + offset, sizeof(sample_size));
+        offset += sizeof(sample_size);
+
+        if (size - offset < sample_size || !TrafficRecorder::decode(input + offset, sample_size, sample))
+        {
+            return false;
+        }
+        offset += sample_size;
+
+        consumer(sample);
+    }
+
+    return offset == size;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
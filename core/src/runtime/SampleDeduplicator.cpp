@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/DataHash.hpp>
+#include <is/core/runtime/SampleDeduplicator.hpp>
+#include <is/utils/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+//==============================================================================
+std::size_t hash_member(
+        const xtypes::ReadableDynamicDataRef& data,
+        const SampleDeduplicator::Key& key,
+        std::size_t depth)
+{
+    return depth < key.size()
+           ? hash_member(data[key[depth]], key, depth + 1)
+           : DataHash::of(data);
+}
+
+} //  anonymous namespace
+
+class SampleDeduplicator::Implementation
+{
+public:
+
+    using Clock = std::chrono::steady_clock;
+
+    Implementation(
+            const std::string& name,
+            double window,
+            std::size_t capacity)
+        : _name(name)
+        , _window(std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(std::max(window, 0.0))))
+        , _capacity(std::max<std::size_t>(capacity, 1))
+        , _warned(false)
+        , _suppressed(0)
+        , _logger("is::core::SampleDeduplicator")
+    {
+    }
+
+    bool offer(
+            std::size_t hash)
+    {
+        const Clock::time_point now = Clock::now();
+
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (!_order.empty() && _order.front().expiry <= now)
+        {
+            forget_oldest();
+        }
+
+        if (_seen.count(hash) > 0)
+        {
+            ++_suppressed;
+            return false;
+        }
+
+        if (_order.size() >= _capacity)
+        {
+            if (!_warned)
+            {
+                _warned = true;
+                _logger << utils::Logger::Level::WARN
+                        << "[" << _name << "] More than " << _capacity << " samples were received "
+                        << "within the deduplication window. The oldest ones are forgotten early, "
+                        << "so some of their copies may be routed." << std::endl;
+            }
+            forget_oldest();
+        }
+
+        _order.push_back(Entry{hash, now + _window});
+        _seen.insert(hash);
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _order.size();
+    }
+
+    std::size_t bytes() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _order.size() * sizeof(Entry)
+               + _seen.size() * (sizeof(std::size_t) + 2 * sizeof(void*))
+               + _seen.bucket_count() * sizeof(void*);
+    }
+
+    uint64_t suppressed() const
+    {
+        return _suppressed;
+    }
+
+private:
+
+    struct Entry
+    {
+        std::size_t hash;
+        Clock::time_point expiry;
+    };
+
+    /**
+     * Forgets the oldest remembered sample. Each hash is remembered at most once,
+     * since copies are never remembered.
+     */
+    void forget_oldest()
+    {
+        _seen.erase(_order.front().hash);
+        _order.pop_front();
+    }
+
+    const std::string _name;
+    const Clock::duration _window;
+    const std::size_t _capacity;
+
+    std::deque<Entry> _order;
+    std::unordered_set<std::size_t> _seen;
+    bool _warned;
+    std::atomic<uint64_t> _suppressed;
+
+    mutable std::mutex _mutex;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+bool SampleDeduplicator::resolve(
+        const xtypes::DynamicType& type,
+        const std::string& path,
+        Key& key,
+        std::string& error)
+{
+    key.clear();
+
+    const xtypes::DynamicType* current = &type;
+    std::size_t start = 0;
+    while (!path.empty())
+    {
+        const std::size_t end = std::min(path.find('.', start), path.size());
+        const std::string member = path.substr(start, end - start);
+
+        if (current->kind() != xtypes::TypeKind::STRUCTURE_TYPE)
+        {
+            error = "'" + path.substr(0, start == 0 ? 0 : start - 1) + "' is not a structure";
+            return false;
+        }
+
+        const xtypes::AggregationType& aggregation = static_cast<const xtypes::AggregationType&>(*current);
+        if (member.empty() || !aggregation.has_member(member))
+        {
+            error = "the type '" + current->name() + "' has no member named '" + member + "'";
+            return false;
+        }
+
+        const auto& members = aggregation.members();
+        for (std::size_t index = 0; index < members.size(); ++index)
+        {
+            if (members[index].name() == member)
+            {
+                key.push_back(index);
+                current = &members[index].type();
+                break;
+            }
+        }
+
+        if (end == path.size())
+        {
+            break;
+        }
+        start = end + 1;
+    }
+
+    return true;
+}
+
+//==============================================================================
+std::size_t SampleDeduplicator::hash(
+        const xtypes::ReadableDynamicDataRef& data,
+        const Key& key)
+{
+    return hash_member(data, key, 0);
+}
+
+//==============================================================================
+SampleDeduplicator::SampleDeduplicator(
+        const std::string& name,
+        double window,
+        std::size_t capacity)
+    : _pimpl(new Implementation(name, window, capacity))
+{
+}
+
+//==============================================================================
+SampleDeduplicator::~SampleDeduplicator() = default;
+
+//==============================================================================
+bool SampleDeduplicator::offer(
+        std::size_t hash)
+{
+    return _pimpl->offer(hash);
+}
+
+//==============================================================================
+std::size_t SampleDeduplicator::size() const
+{
+    return _pimpl->size();
+}
+
+//==============================================================================
+std::size_t SampleDeduplicator::bytes() const
+{
+    return _pimpl->bytes();
+}
+
+//==============================================================================
+uint64_t SampleDeduplicator::suppressed() const
+{
+    return _pimpl->suppressed();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
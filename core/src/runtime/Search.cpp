@@ -24,6 +24,9 @@
 #include <iostream>
 #include <list>
 #include <map>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <cstdlib>
 
@@ -140,6 +143,11 @@ public:
         static_default_global_paths.config_file_prefix.add_path(path);
     }
 
+    static void invalidate_cache()
+    {
+        static_directory_index.clear();
+    }
+
     void add_priority_middleware_prefix(
             const std::string& path)
     {
@@ -166,7 +174,7 @@ public:
                 [&](const std::experimental::filesystem::path test) -> bool
                 {
                     checked_paths.push_back(test.string());
-                    return std::experimental::filesystem::exists(test);
+                    return static_directory_index.exists(test);
                 };
 
         for (const PathSet& middleware_prefixes :
@@ -265,7 +273,7 @@ public:
                 [&](const std::experimental::filesystem::path test) -> bool
                 {
                     checked_paths.push_back(test.string());
-                    return std::experimental::filesystem::exists(test);
+                    return static_directory_index.exists(test);
                 };
 
         for (const PathSet& middleware_prefixes :
@@ -513,6 +521,73 @@ private:
         std::list<std::string> _path_list;
     };
 
+    /**
+     * @class DirectoryIndex
+     *        Process-wide index of the contents of the directories probed by the searches,
+     *        so that every directory is listed once, instead of checking each candidate
+     *        file on its own, until the index is cleared.
+     */
+    class DirectoryIndex
+    {
+    public:
+
+        /**
+         * @brief Checks whether a file exists, listing its parent directory if it was not indexed yet.
+         *
+         * @param[in] path The path of the file.
+         *
+         * @returns `true` if the file exists, `false` otherwise.
+         */
+        bool exists(
+                const std::experimental::filesystem::path& path)
+        {
+            const std::string name = path.filename().string();
+            if (name.empty() || name == "." || name == "..")
+            {
+                return std::experimental::filesystem::exists(path);
+            }
+
+            const std::string directory = path.parent_path().string();
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            auto it = _directories.find(directory);
+            if (it == _directories.end())
+            {
+                it = _directories.emplace(directory, list(directory)).first;
+            }
+            return it->second.count(name) > 0;
+        }
+
+        /**
+         * @brief Forgets every indexed directory, so that they are listed again when needed.
+         */
+        void clear()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _directories.clear();
+        }
+
+    private:
+
+        static std::unordered_set<std::string> list(
+                const std::string& directory)
+        {
+            std::unordered_set<std::string> entries;
+
+            // Directories that do not exist, or cannot be read, are indexed as empty ones.
+            std::error_code error;
+            std::experimental::filesystem::directory_iterator it(directory, error);
+            for (; !error && it != std::experimental::filesystem::directory_iterator(); it.increment(error))
+            {
+                entries.insert(it->path().filename().string());
+            }
+            return entries;
+        }
+
+        std::mutex _mutex;
+        std::unordered_map<std::string, std::unordered_set<std::string> > _directories;
+    };
+
     /**
      * @class GlobalPathInitializer
      *        This class is used to initialize the global paths
@@ -697,6 +772,11 @@ private:
      */
     static GlobalPaths static_default_global_paths;
 
+    /**
+     * Index of the probed directories, shared by all the instances of Search.
+     */
+    static DirectoryIndex static_directory_index;
+
     /**
      * This is a local copy of the global paths, which can
      * be mutated by each Search instance.
@@ -736,6 +816,8 @@ Search::Implementation::GlobalPaths
 Search::Implementation::static_default_global_paths;
 Search::Implementation::GlobalPathInitializer
 Search::Implementation::static_global_path_initializer;
+Search::Implementation::DirectoryIndex
+Search::Implementation::static_directory_index;
 
 
 //==============================================================================
@@ -803,6 +885,12 @@ void Search::set_config_file_directory(
     Search::Implementation::set_config_file_directory(path);
 }
 
+//==============================================================================
+void Search::invalidate_cache()
+{
+    Search::Implementation::invalidate_cache();
+}
+
 //==============================================================================
 void Search::add_priority_middleware_prefix(
         const std::string& path)
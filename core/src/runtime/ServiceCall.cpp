@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/ServiceCall.hpp>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+//==============================================================================
+ServiceCall::ServiceCall(
+        ServiceClient& client,
+        std::shared_ptr<void> call_handle)
+    : _client(&client)
+    , _handle(std::move(call_handle))
+    , _start(std::chrono::steady_clock::now())
+    , _status(Status::PENDING)
+    , _done(false)
+    , _waited(false)
+{
+}
+
+//==============================================================================
+std::shared_ptr<ServiceCall> ServiceCall::from(
+        const std::shared_ptr<void>& call_handle)
+{
+    return std::static_pointer_cast<ServiceCall>(call_handle);
+}
+
+//==============================================================================
+bool ServiceCall::reply(
+        const xtypes::DynamicData& response)
+{
+    if (!claim(Status::REPLIED))
+    {
+        return false;
+    }
+
+    deliver(response);
+    finished();
+    return true;
+}
+
+//==============================================================================
+bool ServiceCall::cancel()
+{
+    if (!claim(Status::CANCELLED))
+    {
+        return false;
+    }
+
+    deliver_cancellation();
+    finished();
+    return true;
+}
+
+//==============================================================================
+ServiceCall::Status ServiceCall::wait() const
+{
+    _waited = true;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _completed.wait(lock, [this]()
+            {
+                return _done.load();
+            });
+
+    return status();
+}
+
+//==============================================================================
+ServiceCall::Status ServiceCall::wait_for(
+        std::chrono::nanoseconds timeout) const
+{
+    _waited = true;
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!_completed.wait_for(lock, timeout, [this]()
+            {
+                return _done.load();
+            }))
+    {
+        return Status::PENDING;
+    }
+
+    return status();
+}
+
+//==============================================================================
+void ServiceCall::then(
+        Continuation continuation)
+{
+    _waited = true;
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!_done)
+        {
+            _continuation = std::move(continuation);
+            return;
+        }
+    }
+
+    continuation(status());
+}
+
+//==============================================================================
+void ServiceCall::deliver(
+        const xtypes::DynamicData& response)
+{
+    _client->receive_response(_handle, response);
+}
+
+//==============================================================================
+void ServiceCall::deliver_cancellation()
+{
+    _client->receive_cancellation(_handle);
+}
+
+//==============================================================================
+bool ServiceCall::claim(
+        Status status)
+{
+    Status expected = Status::PENDING;
+    return _status.compare_exchange_strong(expected, status, std::memory_order_acq_rel);
+}
+
+//==============================================================================
+void ServiceCall::finished()
+{
+    /**
+     * Both flags are sequentially consistent, so either this thread sees that
+     * some thread waits for the call, or that thread sees that the call is done.
+     * The mutex is only taken in the first case.
+     */
+    _done = true;
+    if (!_waited)
+    {
+        return;
+    }
+
+    Continuation continuation;
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        continuation = std::move(_continuation);
+    }
+
+    _completed.notify_all();
+
+    if (continuation)
+    {
+        continuation(status());
+    }
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
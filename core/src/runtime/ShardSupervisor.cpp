@@ -0,0 +1,723 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/ShardSupervisor.hpp>
+#include <is/core/runtime/MetricsExporter.hpp>
+#include <is/utils/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#ifndef WIN32
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif //  WIN32
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif //  __linux__
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+/**
+ * Workers that exit sooner than this after being started are considered broken,
+ * instead of being started again.
+ */
+constexpr std::chrono::seconds minimum_uptime(5);
+
+/**
+ * Time after which a worker that stopped reporting its metrics is warned about.
+ */
+constexpr std::chrono::seconds report_timeout(10);
+
+#ifndef WIN32
+std::atomic_bool stop_requested(false);
+
+std::atomic_bool reload_requested(false);
+
+void stop_handler(
+        int /*signal*/)
+{
+    stop_requested = true;
+}
+
+void reload_handler(
+        int /*signal*/)
+{
+    reload_requested = true;
+}
+#endif //  WIN32
+
+/**
+ * Names are written with percent escapes for the characters separating the fields.
+ */
+std::string escape(
+        const std::string& text)
+{
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text)
+    {
+        switch (c)
+        {
+            case '%': escaped += "%25"; break;
+            case '\t': escaped += "%09"; break;
+            case '\n': escaped += "%0A"; break;
+            default: escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string unescape(
+        const std::string& text)
+{
+    std::string unescaped;
+    unescaped.reserve(text.size());
+    for (std::size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] == '%' && i + 2 < text.size())
+        {
+            unescaped += static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16));
+            i += 2;
+        }
+        else
+        {
+            unescaped += text[i];
+        }
+    }
+    return unescaped;
+}
+
+std::vector<std::string> split(
+        const std::string& line)
+{
+    std::vector<std::string> fields;
+    std::size_t begin = 0;
+    while (true)
+    {
+        const std::size_t end = line.find('\t', begin);
+        fields.push_back(line.substr(begin, end - begin));
+        if (end == std::string::npos)
+        {
+            return fields;
+        }
+        begin = end + 1;
+    }
+}
+
+void encode_histogram(
+        std::ostringstream& out,
+        const LatencyHistogram::Snapshot& histogram)
+{
+    out << '\t' << histogram.count << '\t' << histogram.sum_ns << '\t' << histogram.max_ns;
+    for (const uint64_t bucket : histogram.buckets)
+    {
+        out << '\t' << bucket;
+    }
+}
+
+void decode_histogram(
+        const std::vector<std::string>& fields,
+        std::size_t& field,
+        LatencyHistogram::Snapshot& histogram)
+{
+    histogram.count = std::stoull(fields[field++]);
+    histogram.sum_ns = std::stoull(fields[field++]);
+    histogram.max_ns = std::stoull(fields[field++]);
+    for (uint64_t& bucket : histogram.buckets)
+    {
+        bucket = std::stoull(fields[field++]);
+    }
+}
+
+constexpr std::size_t route_fields = 15 + 2 * (3 + LatencyHistogram::BUCKETS);
+
+} //  anonymous namespace
+
+class ShardSupervisor::Implementation
+{
+public:
+
+    Implementation(
+            int argc,
+            char* argv[])
+        : _shards(0)
+        , _logger("is::core::ShardSupervisor")
+    {
+        for (int i = 0; i < argc; ++i)
+        {
+            const std::string arg = argv[i];
+            std::string value;
+            if (arg == "--shards" && i + 1 < argc)
+            {
+                value = argv[++i];
+            }
+            else if (arg.compare(0, 9, "--shards=") == 0)
+            {
+                value = arg.substr(9);
+            }
+            else
+            {
+                _arguments.push_back(arg);
+                continue;
+            }
+
+            try
+            {
+                _shards = std::stoul(value);
+            }
+            catch (const std::exception&)
+            {
+                _shards = 0;
+            }
+        }
+
+        if (_shards < 2)
+        {
+            _shards = 0;
+        }
+    }
+
+    ~Implementation()
+    {
+#ifndef WIN32
+        for (Worker& worker : _workers)
+        {
+            if (worker.fd >= 0)
+            {
+                ::close(worker.fd);
+            }
+        }
+#endif //  WIN32
+    }
+
+    std::size_t shards() const
+    {
+        return _shards;
+    }
+
+    int run()
+    {
+        if (_shards == 0 || _arguments.empty())
+        {
+            return 1;
+        }
+
+#ifdef WIN32
+        _logger << utils::Logger::Level::ERROR
+                << "Running the routes in several worker processes with '--shards' "
+                << "is only supported on POSIX systems." << std::endl;
+        return 1;
+#else
+        struct sigaction action;
+        std::memset(&action, 0, sizeof(action));
+        action.sa_handler = stop_handler;
+        sigaction(SIGINT, &action, nullptr);
+        sigaction(SIGTERM, &action, nullptr);
+        action.sa_handler = reload_handler;
+        sigaction(SIGHUP, &action, nullptr);
+
+        _workers.resize(_shards);
+        for (std::size_t index = 0; index < _shards; ++index)
+        {
+            if (!start(index))
+            {
+                stop_requested = true;
+                _exit_code = 1;
+                break;
+            }
+        }
+
+        _logger << utils::Logger::Level::INFO
+                << "Supervising " << _shards << " worker processes." << std::endl;
+
+        bool forwarded = false;
+        while (true)
+        {
+            if (stop_requested && !forwarded)
+            {
+                for (const Worker& worker : _workers)
+                {
+                    if (worker.pid > 0)
+                    {
+                        ::kill(worker.pid, SIGINT);
+                    }
+                }
+                forwarded = true;
+            }
+
+            if (reload_requested.exchange(false) && !stop_requested)
+            {
+                for (const Worker& worker : _workers)
+                {
+                    if (worker.pid > 0)
+                    {
+                        ::kill(worker.pid, SIGHUP);
+                    }
+                }
+            }
+
+            read_reports();
+
+            if (!reap())
+            {
+                break;
+            }
+
+            check_health();
+        }
+
+        _exporter.reset();
+        return _exit_code;
+#endif //  WIN32
+    }
+
+private:
+
+#ifndef WIN32
+    struct Worker
+    {
+        pid_t pid = -1;
+        int fd = -1;
+        std::string buffer;
+        std::chrono::steady_clock::time_point started;
+        std::chrono::steady_clock::time_point last_report;
+        bool warned = false;
+        Report report;
+    };
+
+    bool start(
+            std::size_t index)
+    {
+        Worker& worker = _workers[index];
+
+        int fds[2];
+        if (::pipe(fds) != 0)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Could not create the metrics pipe of worker " << index << ": "
+                    << std::strerror(errno) << std::endl;
+            return false;
+        }
+        ::fcntl(fds[0], F_SETFD, FD_CLOEXEC);
+        ::fcntl(fds[0], F_SETFL, O_NONBLOCK);
+
+        std::vector<std::string> arguments = _arguments;
+        arguments.push_back("--shard");
+        arguments.push_back(std::to_string(index) + "/" + std::to_string(_shards));
+        arguments.push_back("--shard-metrics-fd");
+        arguments.push_back(std::to_string(fds[1]));
+
+        std::vector<char*> argv;
+        for (std::string& argument : arguments)
+        {
+            argv.push_back(&argument[0]);
+        }
+        argv.push_back(nullptr);
+
+        const pid_t pid = ::fork();
+        if (pid < 0)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Could not start worker " << index << ": " << std::strerror(errno) << std::endl;
+            ::close(fds[0]);
+            ::close(fds[1]);
+            return false;
+        }
+
+        if (pid == 0)
+        {
+#ifdef __linux__
+            ::prctl(PR_SET_PDEATHSIG, SIGINT);
+#endif //  __linux__
+            ::execvp(argv[0], argv.data());
+            ::_exit(127);
+        }
+
+        ::close(fds[1]);
+        if (worker.fd >= 0)
+        {
+            ::close(worker.fd);
+        }
+
+        worker.pid = pid;
+        worker.fd = fds[0];
+        worker.buffer.clear();
+        worker.started = std::chrono::steady_clock::now();
+        worker.last_report = worker.started;
+        worker.warned = false;
+        return true;
+    }
+
+    void read_reports()
+    {
+        std::vector<pollfd> fds;
+        for (const Worker& worker : _workers)
+        {
+            fds.push_back(pollfd{worker.fd, POLLIN, 0});
+        }
+
+        if (::poll(fds.data(), fds.size(), 100) <= 0)
+        {
+            return;
+        }
+
+        for (std::size_t i = 0; i < fds.size(); ++i)
+        {
+            if (!(fds[i].revents & POLLIN))
+            {
+                continue;
+            }
+
+            Worker& worker = _workers[i];
+            char data[4096];
+            ssize_t size;
+            while ((size = ::read(worker.fd, data, sizeof(data))) > 0)
+            {
+                worker.buffer.append(data, static_cast<std::size_t>(size));
+            }
+
+            Report report;
+            bool reported = false;
+            while (decode(worker.buffer, report))
+            {
+                reported = true;
+            }
+
+            if (!reported)
+            {
+                continue;
+            }
+
+            worker.last_report = std::chrono::steady_clock::now();
+            worker.warned = false;
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            worker.report = std::move(report);
+
+            if (!_exporter && worker.report.exporter_port > 0)
+            {
+                _exporter = std::make_unique<MetricsExporter>([this]()
+                                {
+                                    std::unique_lock<std::mutex> exporter_lock(_mutex);
+                                    std::vector<RouteMetricsSnapshot> routes;
+                                    for (const Worker& reporter : _workers)
+                                    {
+                                        routes.insert(routes.end(),
+                                        reporter.report.routes.begin(), reporter.report.routes.end());
+                                    }
+                                    return routes;
+                                });
+
+                if (!_exporter->start(worker.report.exporter_address, worker.report.exporter_port))
+                {
+                    _logger << utils::Logger::Level::ERROR
+                            << "Failed to start the metrics exporter on " << worker.report.exporter_address
+                            << ":" << worker.report.exporter_port << ", the metrics will not be served"
+                            << std::endl;
+                }
+            }
+        }
+    }
+
+    /**
+     * Collects the finished workers, starting them again if needed.
+     * Returns `false` once all of them have finished.
+     */
+    bool reap()
+    {
+        int status = 0;
+        pid_t pid;
+        while ((pid = ::waitpid(-1, &status, WNOHANG)) > 0)
+        {
+            for (std::size_t index = 0; index < _workers.size(); ++index)
+            {
+                Worker& worker = _workers[index];
+                if (worker.pid != pid)
+                {
+                    continue;
+                }
+
+                worker.pid = -1;
+                ::close(worker.fd);
+                worker.fd = -1;
+                const int exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+
+                if (stop_requested)
+                {
+                    _exit_code = std::max(_exit_code, exit_code);
+                }
+                else if (std::chrono::steady_clock::now() - worker.started < minimum_uptime)
+                {
+                    _logger << utils::Logger::Level::ERROR
+                            << "Worker " << index << " exited with code " << exit_code
+                            << " right after being started. Stopping all the workers." << std::endl;
+
+                    _exit_code = std::max(_exit_code, exit_code == 0 ? 1 : exit_code);
+                    stop_requested = true;
+                }
+                else
+                {
+                    _logger << utils::Logger::Level::WARN
+                            << "Worker " << index << " exited with code " << exit_code
+                            << ". Starting it again." << std::endl;
+
+                    if (!start(index))
+                    {
+                        _exit_code = 1;
+                        stop_requested = true;
+                    }
+                }
+            }
+        }
+
+        for (const Worker& worker : _workers)
+        {
+            if (worker.pid > 0)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void check_health()
+    {
+        const auto now = std::chrono::steady_clock::now();
+        for (std::size_t index = 0; index < _workers.size(); ++index)
+        {
+            Worker& worker = _workers[index];
+            if (worker.pid > 0 && !worker.warned && now - worker.last_report > report_timeout)
+            {
+                _logger << utils::Logger::Level::WARN
+                        << "Worker " << index << " has not reported its metrics for "
+                        << report_timeout.count() << " seconds." << std::endl;
+                worker.warned = true;
+            }
+        }
+    }
+
+#endif //  WIN32
+
+    /**
+     * Class members.
+     */
+
+    std::vector<std::string> _arguments;
+    std::size_t _shards;
+#ifndef WIN32
+    std::vector<Worker> _workers;
+    int _exit_code = 0;
+#endif //  WIN32
+
+    std::mutex _mutex;
+    std::unique_ptr<MetricsExporter> _exporter;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+ShardSupervisor::ShardSupervisor(
+        int argc,
+        char* argv[])
+    : _pimpl(new Implementation(argc, argv))
+{
+}
+
+//==============================================================================
+ShardSupervisor::~ShardSupervisor() = default;
+
+//==============================================================================
+std::size_t ShardSupervisor::shards() const
+{
+    return _pimpl->shards();
+}
+
+//==============================================================================
+int ShardSupervisor::run()
+{
+    return _pimpl->run();
+}
+
+//==============================================================================
+bool ShardSupervisor::send(
+        int fd,
+        const Report& report)
+{
+#ifdef WIN32
+    // Worker processes are never started on Windows, so there are no pipes to write into.
+    (void)fd;
+    (void)report;
+    return false;
+#else
+    const std::string data = encode(report);
+    std::size_t sent = 0;
+    while (sent < data.size())
+    {
+        const ssize_t written = ::write(fd, data.data() + sent, data.size() - sent);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            return false;
+        }
+        sent += static_cast<std::size_t>(written);
+    }
+    return true;
+#endif //  WIN32
+}
+
+//==============================================================================
+std::string ShardSupervisor::encode(
+        const Report& report)
+{
+    std::ostringstream out;
+    out << "report\t" << escape(report.exporter_address) << '\t' << report.exporter_port
+        << '\t' << report.routes.size() << '\n';
+
+    for (const RouteMetricsSnapshot& route : report.routes)
+    {
+        out << escape(route.kind) << '\t' << escape(route.name) << '\t' << escape(route.route)
+            << '\t' << escape(route.source) << '\t' << escape(route.destination)
+            << '\t' << route.messages_in << '\t' << route.messages_out << '\t' << route.conversions
+            << '\t' << route.drops << '\t' << route.failures
+            << '\t' << route.queued_messages << '\t' << route.queued_bytes << '\t' << route.retained_bytes
+            << '\t' << route.dynamic_publishers << '\t' << route.publisher_evictions;
+        encode_histogram(out, route.publish_time);
+        encode_histogram(out, route.round_trip_time);
+        out << '\n';
+    }
+
+    return out.str();
+}
+
+//==============================================================================
+bool ShardSupervisor::decode(
+        std::string& buffer,
+        Report& report)
+{
+    /**
+     * Anything before the first report header is garbage from a broken report.
+     */
+    const std::size_t begin = buffer.find("report\t");
+    if (begin == std::string::npos)
+    {
+        return false;
+    }
+
+    std::size_t end = buffer.find('\n', begin);
+    if (end == std::string::npos)
+    {
+        return false;
+    }
+
+    const std::vector<std::string> header = split(buffer.substr(begin, end - begin));
+    std::size_t count = 0;
+    Report decoded;
+    try
+    {
+        if (header.size() != 4)
+        {
+            throw std::invalid_argument("header");
+        }
+        decoded.exporter_address = unescape(header[1]);
+        decoded.exporter_port = static_cast<uint16_t>(std::stoul(header[2]));
+        count = std::stoul(header[3]);
+    }
+    catch (const std::exception&)
+    {
+        buffer.erase(0, end + 1);
+        return false;
+    }
+
+    std::vector<std::string> lines;
+    std::size_t position = end + 1;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        end = buffer.find('\n', position);
+        if (end == std::string::npos)
+        {
+            return false;
+        }
+        lines.push_back(buffer.substr(position, end - position));
+        position = end + 1;
+    }
+    buffer.erase(0, position);
+
+    for (const std::string& line : lines)
+    {
+        const std::vector<std::string> fields = split(line);
+        if (fields.size() != route_fields)
+        {
+            continue;
+        }
+
+        try
+        {
+            RouteMetricsSnapshot route;
+            route.kind = unescape(fields[0]);
+            route.name = unescape(fields[1]);
+            route.route = unescape(fields[2]);
+            route.source = unescape(fields[3]);
+            route.destination = unescape(fields[4]);
+            route.messages_in = std::stoull(fields[5]);
+            route.messages_out = std::stoull(fields[6]);
+            route.conversions = std::stoull(fields[7]);
+            route.drops = std::stoull(fields[8]);
+            route.failures = std::stoull(fields[9]);
+            route.queued_messages = std::stoull(fields[10]);
+            route.queued_bytes = std::stoull(fields[11]);
+            route.retained_bytes = std::stoull(fields[12]);
+            route.dynamic_publishers = std::stoull(fields[13]);
+            route.publisher_evictions = std::stoull(fields[14]);
+
+            std::size_t field = 15;
+            decode_histogram(fields, field, route.publish_time);
+            decode_histogram(fields, field, route.round_trip_time);
+            decoded.routes.push_back(std::move(route));
+        }
+        catch (const std::exception&)
+        {
+            continue;
+        }
+    }
+
+    report = std::move(decoded);
+    return true;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/SpinExecutor.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+class SpinExecutor::Implementation
+{
+public:
+
+    std::shared_ptr<Entry> add(
+            const std::string& name,
+            SystemHandle* handle)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _entries.push_back(std::make_shared<Entry>(name, handle));
+        return _entries.back();
+    }
+
+    void remove(
+            const std::shared_ptr<Entry>& entry)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        entry->removed = true;
+        entry->queued = false;
+        _ready.erase(std::remove(_ready.begin(), _ready.end(), entry), _ready.end());
+        _entries.remove(entry);
+    }
+
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _entries.size();
+    }
+
+    void notify(
+            const std::shared_ptr<Entry>& entry)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (entry->removed)
+        {
+            return;
+        }
+
+        if (entry->running)
+        {
+            entry->notified = true;
+        }
+        else if (!entry->queued)
+        {
+            entry->queued = true;
+            _ready.push_back(entry);
+            _ready_cv.notify_one();
+        }
+    }
+
+    std::shared_ptr<Entry> next(
+            std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        const Clock::time_point end = Clock::now() + timeout;
+        while (_ready.empty() && !_woken && !task_due(Clock::now()))
+        {
+            const Clock::time_point until = _tasks.empty() ? end : std::min(end, _tasks.begin()->first);
+            if (_ready_cv.wait_until(lock, until) == std::cv_status::timeout && until == end)
+            {
+                break;
+            }
+        }
+
+        if (_ready.empty())
+        {
+            return nullptr;
+        }
+
+        std::shared_ptr<Entry> entry = std::move(_ready.front());
+        _ready.pop_front();
+        entry->queued = false;
+        entry->running = true;
+        return entry;
+    }
+
+    void done(
+            const std::shared_ptr<Entry>& entry)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        entry->running = false;
+        if (entry->notified && !entry->removed)
+        {
+            entry->notified = false;
+            entry->queued = true;
+            _ready.push_back(entry);
+            _ready_cv.notify_one();
+        }
+    }
+
+    void wake_all()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _woken = true;
+        _ready_cv.notify_all();
+    }
+
+    void post(
+            std::function<void ()> task,
+            Clock::duration delay)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _tasks.emplace(Clock::now() + delay, std::move(task));
+        _ready_cv.notify_one();
+    }
+
+    std::function<void ()> next_task()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!task_due(Clock::now()))
+        {
+            return nullptr;
+        }
+
+        std::function<void ()> task = std::move(_tasks.begin()->second);
+        _tasks.erase(_tasks.begin());
+        return task;
+    }
+
+private:
+
+    bool task_due(
+            Clock::time_point now) const
+    {
+        return !_tasks.empty() && _tasks.begin()->first <= now;
+    }
+
+    std::list<std::shared_ptr<Entry> > _entries;
+    std::deque<std::shared_ptr<Entry> > _ready;
+    std::multimap<Clock::time_point, std::function<void ()> > _tasks;
+    bool _woken = false;
+    mutable std::mutex _mutex;
+    std::condition_variable _ready_cv;
+};
+
+//==============================================================================
+SpinExecutor::SpinExecutor()
+    : _pimpl(new Implementation())
+{
+}
+
+//==============================================================================
+SpinExecutor::~SpinExecutor() = default;
+
+//==============================================================================
+std::shared_ptr<SpinExecutor::Entry> SpinExecutor::add(
+        const std::string& name,
+        SystemHandle* handle)
+{
+    return _pimpl->add(name, handle);
+}
+
+//==============================================================================
+void SpinExecutor::remove(
+        const std::shared_ptr<Entry>& entry)
+{
+    _pimpl->remove(entry);
+}
+
+//==============================================================================
+std::size_t SpinExecutor::size() const
+{
+    return _pimpl->size();
+}
+
+//==============================================================================
+void SpinExecutor::notify(
+        const std::shared_ptr<Entry>& entry)
+{
+    _pimpl->notify(entry);
+}
+
+//==============================================================================
+std::shared_ptr<SpinExecutor::Entry> SpinExecutor::next(
+        std::chrono::milliseconds timeout)
+{
+    return _pimpl->next(timeout);
+}
+
+//==============================================================================
+void SpinExecutor::done(
+        const std::shared_ptr<Entry>& entry)
+{
+    _pimpl->done(entry);
+}
+
+//==============================================================================
+void SpinExecutor::wake_all()
+{
+    _pimpl->wake_all();
+}
+
+//==============================================================================
+void SpinExecutor::post(
+        std::function<void ()> task,
+        Clock::duration delay)
+{
+    _pimpl->post(std::move(task), delay);
+}
+
+//==============================================================================
+std::function<void ()> SpinExecutor::next_task()
+{
+    return _pimpl->next_task();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/StartupProfile.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+//==============================================================================
+StartupProfile::Scope::Scope(
+        const std::string& category,
+        const std::string& name)
+    : _enabled(StartupProfile::global().enabled())
+{
+    if (_enabled)
+    {
+        _category = category;
+        _name = name;
+        _start = std::chrono::steady_clock::now();
+    }
+}
+
+//==============================================================================
+StartupProfile::Scope::~Scope()
+{
+    if (_enabled)
+    {
+        StartupProfile::global().add(_category, _name,
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - _start));
+    }
+}
+
+//==============================================================================
+StartupProfile& StartupProfile::global()
+{
+    static StartupProfile profile;
+    return profile;
+}
+
+//==============================================================================
+void StartupProfile::enable(
+        bool enabled)
+{
+    _enabled = enabled;
+}
+
+//==============================================================================
+bool StartupProfile::enabled() const
+{
+    return _enabled;
+}
+
+//==============================================================================
+void StartupProfile::add(
+        const std::string& category,
+        const std::string& name,
+        std::chrono::nanoseconds duration)
+{
+    if (!_enabled)
+    {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _records.push_back(Record{category, name, duration});
+}
+
+//==============================================================================
+std::vector<StartupProfile::Record> StartupProfile::records() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _records;
+}
+
+//==============================================================================
+std::string StartupProfile::report() const
+{
+    std::map<std::string, std::vector<Record> > categories;
+    for (Record& record : records())
+    {
+        categories[record.category].push_back(std::move(record));
+    }
+
+    std::ostringstream report;
+    report << "Startup profile:";
+
+    for (auto& [category, records] : categories)
+    {
+        std::stable_sort(records.begin(), records.end(),
+                [](const Record& a, const Record& b)
+                {
+                    return a.duration > b.duration;
+                });
+
+        std::size_t width = 0;
+        for (const Record& record : records)
+        {
+            width = std::max(width, record.name.size());
+        }
+
+        report << "\n  " << category << ":";
+        for (const Record& record : records)
+        {
+            report << "\n    " << std::left << std::setw(static_cast<int>(width)) << record.name
+                   << "  " << std::right << std::fixed << std::setprecision(3) << std::setw(10)
+                   << std::chrono::duration<double, std::milli>(record.duration).count() << " ms";
+        }
+    }
+
+    return report.str();
+}
+
+//==============================================================================
+bool StartupProfile::export_csv(
+        const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file)
+    {
+        return false;
+    }
+
+    const auto quoted = [](const std::string& field)
+            {
+                std::string result = "\"";
+                for (const char c : field)
+                {
+                    result += c == '"' ? std::string("\"\"") : std::string(1, c);
+                }
+                return result + "\"";
+            };
+
+    file << "category,name,seconds\n";
+    for (const Record& record : records())
+    {
+        file << quoted(record.category) << "," << quoted(record.name) << ","
+             << std::fixed << std::setprecision(9)
+             << std::chrono::duration<double>(record.duration).count() << "\n";
+    }
+
+    return static_cast<bool>(file);
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -17,12 +17,24 @@
 
 #include <is/core/runtime/StringTemplate.hpp>
 
+#include <map>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace eprosima {
 namespace is {
 namespace core {
 
+namespace {
+
+/**
+ * Maximum number of message types, other than the bound one, whose member paths are kept.
+ */
+constexpr std::size_t max_resolved_types = 16;
+
+} //  anonymous namespace
+
 class StringTemplate::Implementation
 {
 public:
@@ -31,6 +43,8 @@ public:
             const std::string& template_string,
             const std::string& usage_details)
         : _converter(usage_details)
+        , _bound_type(nullptr)
+        , _literals_size(0)
     {
         std::size_t last_end = 0;
         std::size_t start = template_string.find('{', last_end);
@@ -63,42 +77,72 @@ public:
         {
             _components.emplace_back(template_string.substr(last_end));
         }
+
+        for (const std::string& component : _components)
+        {
+            _literals_size += component.size();
+        }
     }
 
     Implementation(
-            const Implementation& /*other*/) = default;
+            const Implementation& other)
+        : _converter(other._converter)
+        , _components(other._components)
+        , _substitutions(other._substitutions)
+        , _bound_type(other._bound_type)
+        , _bound(other._bound)
+        , _literals_size(other._literals_size)
+    {
+    }
 
     Implementation(
-            Implementation&& /*other*/) = default;
+            Implementation&& other)
+        : _converter(std::move(other._converter))
+        , _components(std::move(other._components))
+        , _substitutions(std::move(other._substitutions))
+        , _bound_type(other._bound_type)
+        , _bound(std::move(other._bound))
+        , _literals_size(other._literals_size)
+    {
+    }
 
     ~Implementation() = default;
 
+    void bind(
+            const xtypes::DynamicType& type)
+    {
+        _bound_type = nullptr;
+        _bound = resolve(type);
+        _bound_type = &type;
+    }
+
     const std::string compute_string(
             const eprosima::xtypes::DynamicData& message) const
     {
+        // Fields of messages of the bound type are read by index, without looking up their names.
+        std::shared_ptr<const Resolutions> resolved;
+        if (&message.type() != _bound_type && !_substitutions.empty())
+        {
+            resolved = resolutions(message.type());
+        }
+        const Resolutions& fields = resolved ? *resolved : _bound;
+
         std::string result;
+        result.reserve(_literals_size + _substitutions.size() * 16);
         if (!_components.empty())
         {
             result = _components[0];
         }
 
         SubstitutionMap::const_iterator substitute_it = _substitutions.begin();
+        Resolutions::const_iterator field_it = fields.begin();
         for (std::size_t i = 1; i < _components.size(); ++i)
         {
             if (substitute_it != _substitutions.end() && substitute_it->first == i)
             {
-                const std::string& field_name = substitute_it->second;
-                const xtypes::AggregationType& type =
-                        static_cast<const xtypes::AggregationType&>(message.type());
-
-                if (!type.has_member(field_name))
-                {
-                    throw UnavailableMessageField(field_name, _converter.details());
-                }
-
-                xtypes::ReadableDynamicDataRef data = message[field_name];
-                result += _converter.to_string(data, field_name);
+                read(message, field_it->path, 0, field_it->converter, substitute_it->second, result);
                 ++substitute_it;
+                ++field_it;
                 continue;
             }
 
@@ -120,6 +164,146 @@ public:
 
 private:
 
+    /**
+     * @brief The member indexes that lead to the field of a "message.field" substitution
+     *        within some type, and the converter of the type of that field.
+     */
+    struct Resolution
+    {
+        std::vector<std::size_t> path;
+        FieldToString::Converter converter;
+    };
+
+    /**
+     * The resolutions of all the substitutions, in the order of the SubstitutionMap.
+     */
+    using Resolutions = std::vector<Resolution>;
+
+    /**
+     * @brief Resolves every substitution of the template within a type.
+     */
+    Resolutions resolve(
+            const xtypes::DynamicType& type) const
+    {
+        Resolutions fields;
+        fields.reserve(_substitutions.size());
+        for (const auto& substitution : _substitutions)
+        {
+            const xtypes::DynamicType* field_type = nullptr;
+            std::vector<std::size_t> path = resolve(type, substitution.second, &field_type);
+            fields.push_back(Resolution{std::move(path), FieldToString::converter(*field_type)});
+        }
+        return fields;
+    }
+
+    /**
+     * @brief Gets the resolutions for a type other than the bound one, resolving them
+     *        on the first message of that type. Types are told apart by their address,
+     *        and their name is checked in case some address was reused by another type.
+     */
+    std::shared_ptr<const Resolutions> resolutions(
+            const xtypes::DynamicType& type) const
+    {
+        std::unique_lock<std::mutex> lock(_resolved_mutex);
+        const auto it = _resolved.find(&type);
+        if (it != _resolved.end() && it->second.first == type.name())
+        {
+            return it->second.second;
+        }
+        lock.unlock();
+
+        auto fields = std::make_shared<const Resolutions>(resolve(type));
+
+        lock.lock();
+        if (_resolved.size() >= max_resolved_types)
+        {
+            _resolved.clear();
+        }
+        _resolved[&type] = std::make_pair(type.name(), fields);
+        return fields;
+    }
+
+    /**
+     * @brief Resolves a dotted field name, such as `header.frame_id`, into the
+     *        indexes of the members to be accessed at each level of the type.
+     */
+    std::vector<std::size_t> resolve(
+            const xtypes::DynamicType& type,
+            const std::string& field_name,
+            const xtypes::DynamicType** field_type = nullptr) const
+    {
+        std::vector<std::size_t> path;
+
+        const xtypes::DynamicType* current = &type;
+        std::size_t start = 0;
+        while (true)
+        {
+            const std::size_t end = field_name.find('.', start);
+            const std::string member_name = field_name.substr(start, end - start);
+
+            if (current->kind() != xtypes::TypeKind::STRUCTURE_TYPE)
+            {
+                throw UnavailableMessageField(field_name, _converter.details());
+            }
+
+            const xtypes::AggregationType& aggregation =
+                    static_cast<const xtypes::AggregationType&>(*current);
+            if (!aggregation.has_member(member_name))
+            {
+                throw UnavailableMessageField(field_name, _converter.details());
+            }
+
+            const auto& members = aggregation.members();
+            for (std::size_t index = 0; index < members.size(); ++index)
+            {
+                if (members[index].name() == member_name)
+                {
+                    path.push_back(index);
+                    current = &members[index].type();
+                    break;
+                }
+            }
+
+            if (end == std::string::npos)
+            {
+                if (field_type != nullptr)
+                {
+                    *field_type = current;
+                }
+                return path;
+            }
+            start = end + 1;
+        }
+    }
+
+    /**
+     * @brief Appends the field found at the end of a member path to the output.
+     *        Fields whose converter was not resolved by `bind()`, or whose type
+     *        cannot be converted, go through `FieldToString::to_string()`, which
+     *        reports the unsupported types.
+     */
+    void read(
+            xtypes::ReadableDynamicDataRef data,
+            const std::vector<std::size_t>& path,
+            std::size_t depth,
+            FieldToString::Converter converter,
+            const std::string& field_name,
+            std::string& output) const
+    {
+        if (depth < path.size())
+        {
+            read(data[path[depth]], path, depth + 1, converter, field_name, output);
+        }
+        else if (converter != nullptr)
+        {
+            converter(data, output);
+        }
+        else if (!_converter.append(data, output))
+        {
+            output += _converter.to_string(data, field_name);
+        }
+    }
+
     /**
      * Class members.
      */
@@ -138,12 +322,34 @@ private:
     using SubstitutionMap = std::map<std::size_t, std::string>;
 
     /**
-     * Right now this simply maps a component index to a xtypes::DynamicData field name.
+     * Right now this simply maps a component index to a xtypes::DynamicData field.
      * In the future, we can replace std::string with an abstract Substitution
      * class generated by the Factory based on the requested type of substitution.
      * For now we've only implemented "message.field" substitutions.
      */
     SubstitutionMap _substitutions;
+
+    /**
+     * The type whose member paths were resolved by `bind()`, if any.
+     */
+    const xtypes::DynamicType* _bound_type;
+
+    /**
+     * The resolutions for the bound type.
+     */
+    Resolutions _bound;
+
+    /**
+     * The resolutions for the other types of the computed messages, with the name of each type.
+     */
+    mutable std::map<const xtypes::DynamicType*,
+            std::pair<std::string, std::shared_ptr<const Resolutions>>> _resolved;
+    mutable std::mutex _resolved_mutex;
+
+    /**
+     * Sum of the sizes of the string literal components, to reserve the output string.
+     */
+    std::size_t _literals_size;
 };
 
 //==============================================================================
@@ -154,6 +360,16 @@ StringTemplate::StringTemplate(
 {
 }
 
+//==============================================================================
+StringTemplate::StringTemplate(
+        const std::string& template_string,
+        const std::string& usage_details,
+        const eprosima::xtypes::DynamicType& type)
+    : _pimpl(new Implementation(template_string, usage_details))
+{
+    _pimpl->bind(type);
+}
+
 //==============================================================================
 StringTemplate::StringTemplate(
         const StringTemplate& other)
@@ -174,6 +390,13 @@ StringTemplate::~StringTemplate()
     _pimpl.reset();
 }
 
+//==============================================================================
+void StringTemplate::bind(
+        const eprosima::xtypes::DynamicType& type)
+{
+    _pimpl->bind(type);
+}
+
 //==============================================================================
 const std::string StringTemplate::compute_string(
         const eprosima::xtypes::DynamicData& message) const
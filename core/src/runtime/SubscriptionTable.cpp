@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/SubscriptionTable.hpp>
+
+#include <map>
+#include <mutex>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+/**
+ * Topics of a SystemHandle, compared by the control block of the SystemHandle,
+ * which the weak reference keeps from being reused.
+ */
+struct TopicKey
+{
+    std::weak_ptr<SystemHandle> system;
+    std::string topic;
+
+    bool operator <(
+            const TopicKey& other) const
+    {
+        const std::owner_less<std::weak_ptr<SystemHandle> > less;
+        if (less(system, other.system))
+        {
+            return true;
+        }
+        if (less(other.system, system))
+        {
+            return false;
+        }
+        return topic < other.topic;
+    }
+};
+
+/**
+ * The callbacks registered in the SystemHandle for a topic, telling whether their
+ * route still holds the subscription.
+ */
+using Callbacks = std::map<const void*, bool>;
+
+//==============================================================================
+std::map<TopicKey, Callbacks>& table(
+        std::mutex*& mutex)
+{
+    static std::mutex table_mutex;
+    static std::map<TopicKey, Callbacks> topics;
+    mutex = &table_mutex;
+    return topics;
+}
+
+//==============================================================================
+bool held(
+        const Callbacks& callbacks)
+{
+    for (const auto& [callback, holds] : callbacks)
+    {
+        if (holds)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} //  anonymous namespace
+
+//==============================================================================
+bool SubscriptionTable::subscribe(
+        const std::weak_ptr<SystemHandle>& system,
+        const std::string& topic,
+        const void* callback,
+        const Action& subscribe)
+{
+    std::mutex* mutex;
+    std::map<TopicKey, Callbacks>& topics = table(mutex);
+    std::unique_lock<std::mutex> lock(*mutex);
+
+    for (auto it = topics.begin(); it != topics.end();)
+    {
+        it = it->first.system.expired() ? topics.erase(it) : std::next(it);
+    }
+
+    Callbacks& callbacks = topics[TopicKey{system, topic}];
+    const auto registered = callbacks.find(callback);
+    if (registered != callbacks.end())
+    {
+        registered->second = true;
+        return true;
+    }
+
+    if (!subscribe())
+    {
+        if (callbacks.empty())
+        {
+            topics.erase(TopicKey{system, topic});
+        }
+        return false;
+    }
+
+    callbacks.emplace(callback, true);
+    return true;
+}
+
+//==============================================================================
+bool SubscriptionTable::unsubscribe(
+        const std::weak_ptr<SystemHandle>& system,
+        const std::string& topic,
+        const void* callback,
+        const Action& unsubscribe)
+{
+    std::mutex* mutex;
+    std::map<TopicKey, Callbacks>& topics = table(mutex);
+    std::unique_lock<std::mutex> lock(*mutex);
+
+    const auto it = topics.find(TopicKey{system, topic});
+    if (it == topics.end())
+    {
+        return unsubscribe();
+    }
+
+    Callbacks& callbacks = it->second;
+    const auto registered = callbacks.find(callback);
+    if (registered == callbacks.end())
+    {
+        return true;
+    }
+
+    registered->second = false;
+    if (held(callbacks))
+    {
+        return true;
+    }
+
+    if (!unsubscribe())
+    {
+        registered->second = true;
+        return false;
+    }
+
+    topics.erase(it);
+    return true;
+}
+
+//==============================================================================
+std::size_t SubscriptionTable::holders(
+        const std::weak_ptr<SystemHandle>& system,
+        const std::string& topic)
+{
+    std::mutex* mutex;
+    std::map<TopicKey, Callbacks>& topics = table(mutex);
+    std::unique_lock<std::mutex> lock(*mutex);
+
+    const auto it = topics.find(TopicKey{system, topic});
+    if (it == topics.end())
+    {
+        return 0;
+    }
+
+    std::size_t count = 0;
+    for (const auto& [callback, holds] : it->second)
+    {
+        count += holds ? 1 : 0;
+    }
+    return count;
+}
+
+//==============================================================================
+bool SubscriptionTable::registered(
+        const std::weak_ptr<SystemHandle>& system,
+        const void* callback)
+{
+    std::mutex* mutex;
+    std::map<TopicKey, Callbacks>& topics = table(mutex);
+    std::unique_lock<std::mutex> lock(*mutex);
+
+    const std::owner_less<std::weak_ptr<SystemHandle> > less;
+    for (const auto& [key, callbacks] : topics)
+    {
+        if (!less(key.system, system) && !less(system, key.system) && callbacks.count(callback) > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
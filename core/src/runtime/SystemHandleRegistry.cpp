@@ -0,0 +1,409 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/SystemHandleRegistry.hpp>
+#include <is/core/runtime/PublishBatch.hpp>
+#include <is/utils/Log.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+class SystemHandleRegistry::Implementation
+{
+public:
+
+    Implementation()
+        : _logger("is::core::SystemHandleRegistry")
+    {
+    }
+
+    is::internal::SystemHandleInfo acquire(
+            const std::string& key,
+            const std::set<std::string>& required_types,
+            const Loader& load)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        while (true)
+        {
+            prune();
+
+            for (const std::weak_ptr<Shared>& weak : _shared)
+            {
+                const std::shared_ptr<Shared> shared = weak.lock();
+                if (!shared || shared->key != key)
+                {
+                    continue;
+                }
+
+                const bool suitable = std::all_of(required_types.begin(), required_types.end(),
+                                [&](const std::string& type)
+                                {
+                                    return shared->info.types.count(type) > 0;
+                                });
+
+                if (suitable)
+                {
+                    _logger << utils::Logger::Level::DEBUG
+                            << "Reusing the shared SystemHandle of key '" << key << "'." << std::endl;
+                    return share(shared);
+                }
+            }
+
+            /**
+             * Another caller is already loading a SystemHandle under the same key.
+             * Wait for it, and then check again whether it is suitable.
+             */
+            const auto loading = _loading.find(key);
+            if (loading == _loading.end())
+            {
+                break;
+            }
+
+            const std::shared_future<void> done = loading->second;
+            lock.unlock();
+            done.wait();
+            lock.lock();
+        }
+
+        /**
+         * The SystemHandle is configured without holding the registry lock,
+         * so that SystemHandles with different keys are loaded in parallel.
+         */
+        std::promise<void> loaded;
+        _loading.emplace(key, loaded.get_future().share());
+        lock.unlock();
+
+        std::shared_ptr<Shared> shared;
+        try
+        {
+            is::internal::SystemHandleInfo info = load();
+            if (info)
+            {
+                shared = std::make_shared<Shared>(key, std::move(info));
+                shared->start();
+            }
+        }
+        catch (...)
+        {
+            lock.lock();
+            _loading.erase(key);
+            loaded.set_value();
+            throw;
+        }
+
+        lock.lock();
+        _loading.erase(key);
+        loaded.set_value();
+
+        if (!shared)
+        {
+            return is::internal::SystemHandleInfo(nullptr);
+        }
+
+        _shared.push_back(shared);
+        return share(shared);
+    }
+
+    void release(
+            const is::internal::SystemHandleInfoMap& info_map,
+            const std::function<void()>& detach,
+            const std::shared_ptr<void>& callbacks,
+            const std::function<bool()>& in_use)
+    {
+        std::vector<std::shared_ptr<Shared> > used;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            for (const std::weak_ptr<Shared>& weak : _shared)
+            {
+                const std::shared_ptr<Shared> shared = weak.lock();
+                if (!shared)
+                {
+                    continue;
+                }
+
+                for (const auto& [mw_name, info] : info_map)
+                {
+                    if (info.shared && info.handle.get() == shared->info.handle.get())
+                    {
+                        used.push_back(shared);
+                        break;
+                    }
+                }
+            }
+        }
+
+        /**
+         * The spin locks are always taken in the same order, so that instances
+         * released concurrently do not deadlock.
+         */
+        std::sort(used.begin(), used.end());
+
+        std::vector<std::unique_lock<std::mutex> > spin_locks;
+        for (const std::shared_ptr<Shared>& shared : used)
+        {
+            spin_locks.emplace_back(shared->spin_mutex);
+        }
+
+        detach();
+
+        /**
+         * Callbacks are only parked while the SystemHandles may still call them. The ones parked
+         * by previous releases are dropped as well once nothing points to them anymore, which
+         * happens when the instances that shared their subscriptions release them too.
+         */
+        const bool parked = in_use();
+        for (const std::shared_ptr<Shared>& shared : used)
+        {
+            shared->parked.erase(std::remove_if(shared->parked.begin(), shared->parked.end(),
+                    [](const Parked& entry)
+                    {
+                        return !entry.in_use();
+                    }), shared->parked.end());
+
+            if (parked)
+            {
+                shared->parked.push_back(Parked{callbacks, in_use});
+            }
+        }
+    }
+
+    std::size_t size() const
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return static_cast<std::size_t>(std::count_if(_shared.begin(), _shared.end(),
+               [](const std::weak_ptr<Shared>& weak)
+               {
+                   return !weak.expired();
+               }));
+    }
+
+private:
+
+    /**
+     * Callbacks of a released instance, and the function telling whether the SystemHandles
+     * may still call them.
+     */
+    struct Parked
+    {
+        std::shared_ptr<void> callbacks;
+        std::function<bool()> in_use;
+    };
+
+    /**
+     * A shared SystemHandle, together with the thread that spins it.
+     */
+    struct Shared
+    {
+        Shared(
+                const std::string& key_,
+                is::internal::SystemHandleInfo&& info_)
+            : key(key_)
+            , info(std::move(info_))
+            , pending(true)
+            , stop(false)
+        {
+        }
+
+        ~Shared()
+        {
+            {
+                std::unique_lock<std::mutex> lock(wake_mutex);
+                stop = true;
+            }
+            wake.notify_all();
+
+            if (spinner.joinable())
+            {
+                spinner.join();
+            }
+
+            /**
+             * The SystemHandle might still use the parked callbacks while it is destroyed.
+             */
+            info.handle.reset();
+            parked.clear();
+        }
+
+        void start()
+        {
+            const bool event_driven = info.handle->set_wake_up_callback(
+                [this]()
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(wake_mutex);
+                        pending = true;
+                    }
+                    wake.notify_one();
+                });
+
+            spinner = std::thread([this, event_driven]()
+                            {
+                                while (!stop)
+                                {
+                                    if (event_driven)
+                                    {
+                                        std::unique_lock<std::mutex> lock(wake_mutex);
+                                        wake.wait_for(lock, std::chrono::milliseconds(100),
+                                        [this]()
+                                        {
+                                            return pending || stop;
+                                        });
+
+                                        if (!pending || stop)
+                                        {
+                                            continue;
+                                        }
+                                        pending = false;
+                                    }
+
+                                    std::unique_lock<std::mutex> spin_lock(spin_mutex);
+                                    PublishBatch batch;
+                                    if (!info.handle->spin_once())
+                                    {
+                                        utils::Logger logger("is::core::SystemHandleRegistry");
+                                        logger << utils::Logger::Level::ERROR
+                                               << "Runtime Error: the shared SystemHandle of key '" << key
+                                               << "' has experienced a failure! It will not be spun anymore."
+                                               << std::endl;
+                                        return;
+                                    }
+                                }
+                            });
+        }
+
+        const std::string key;
+        is::internal::SystemHandleInfo info;
+
+        /**
+         * Held while the SystemHandle is spun.
+         */
+        std::mutex spin_mutex;
+
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        bool pending;
+        std::atomic_bool stop;
+        std::thread spinner;
+
+        /**
+         * Callbacks of the released instances, which the SystemHandle might still point to.
+         */
+        std::vector<Parked> parked;
+    };
+
+    is::internal::SystemHandleInfo share(
+            const std::shared_ptr<Shared>& shared)
+    {
+        /**
+         * The handle given to each instance keeps the whole shared entry alive.
+         */
+        is::internal::SystemHandleInfo info(
+            std::shared_ptr<SystemHandle>(shared, shared->info.handle.get()));
+        info.types = shared->info.types;
+        info.shared = true;
+        info.origin_tag = shared->info.origin_tag;
+        return info;
+    }
+
+    void prune()
+    {
+        _shared.erase(std::remove_if(_shared.begin(), _shared.end(),
+                [](const std::weak_ptr<Shared>& weak)
+                {
+                    return weak.expired();
+                }), _shared.end());
+    }
+
+    /**
+     * Class members.
+     */
+
+    mutable std::mutex _mutex;
+    std::vector<std::weak_ptr<Shared> > _shared;
+
+    /**
+     * Keys whose SystemHandle is being loaded, and the future that is ready once it is loaded.
+     */
+    std::map<std::string, std::shared_future<void> > _loading;
+
+    utils::Logger _logger;
+};
+
+//==============================================================================
+SystemHandleRegistry& SystemHandleRegistry::global()
+{
+    static SystemHandleRegistry registry;
+    return registry;
+}
+
+//==============================================================================
+SystemHandleRegistry::SystemHandleRegistry()
+    : _pimpl(new Implementation())
+{
+}
+
+//==============================================================================
+SystemHandleRegistry::~SystemHandleRegistry() = default;
+
+//==============================================================================
+is::internal::SystemHandleInfo SystemHandleRegistry::acquire(
+        const std::string& key,
+        const std::set<std::string>& required_types,
+        const Loader& load)
+{
+    return _pimpl->acquire(key, required_types, load);
+}
+
+//==============================================================================
+void SystemHandleRegistry::release(
+        const is::internal::SystemHandleInfoMap& info_map,
+        const std::function<void()>& detach,
+        const std::shared_ptr<void>& callbacks,
+        const std::function<bool()>& in_use)
+{
+    _pimpl->release(info_map, detach, callbacks, in_use);
+}
+
+//==============================================================================
+std::size_t SystemHandleRegistry::size() const
+{
+    return _pimpl->size();
+}
+
+//==============================================================================
+std::string SystemHandleRegistry::key(
+        const std::string& type,
+        const YAML::Node& config)
+{
+    return type + "\n" + YAML::Dump(config);
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,318 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/Tracer.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <random>
+#include <sstream>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+//==============================================================================
+/**
+ * @class FileSink
+ *        Base of the sinks that append each trace to a file, as a single line.
+ */
+class FileSink : public Tracer::Sink
+{
+public:
+
+    FileSink(
+            const std::string& path)
+        : _file(path, std::ios::out | std::ios::app)
+        , _clock_offset(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()
+                    - Tracer::Clock::now().time_since_epoch()))
+    {
+    }
+
+    bool is_open() const
+    {
+        return _file.is_open();
+    }
+
+    void write(
+            const Tracer::Trace& trace) override
+    {
+        std::ostringstream line;
+        format(trace, line);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _file << line.str() << '\n';
+        _file.flush();
+    }
+
+protected:
+
+    virtual void format(
+            const Tracer::Trace& trace,
+            std::ostream& line) = 0;
+
+    /**
+     * @brief Translates a steady clock time point into nanoseconds since the Unix epoch.
+     */
+    uint64_t unix_nanoseconds(
+            Tracer::Clock::time_point time) const
+    {
+        return static_cast<uint64_t>((std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   time.time_since_epoch()) + _clock_offset).count());
+    }
+
+private:
+
+    std::ofstream _file;
+    const std::chrono::nanoseconds _clock_offset;
+    std::mutex _mutex;
+};
+
+//==============================================================================
+class TextSink : public FileSink
+{
+public:
+
+    using FileSink::FileSink;
+
+protected:
+
+    void format(
+            const Tracer::Trace& trace,
+            std::ostream& line) override
+    {
+        auto microseconds = [](Tracer::Clock::duration duration)
+                {
+                    return std::chrono::duration<double, std::micro>(duration).count();
+                };
+
+        line << std::fixed << std::setprecision(1)
+             << unix_nanoseconds(trace.received) << " topic '" << trace.topic << "' from '"
+             << trace.source << "': " << microseconds(trace.finished - trace.received) << " us";
+
+        for (const Tracer::Span& span : trace.spans)
+        {
+            line << " | " << span.name << " at +" << microseconds(span.start - trace.received)
+                 << " us took " << microseconds(span.end - span.start) << " us"
+                 << (span.success ? "" : " (failed)");
+        }
+    }
+
+};
+
+//==============================================================================
+class OtlpSink : public FileSink
+{
+public:
+
+    OtlpSink(
+            const std::string& path)
+        : FileSink(path)
+        , _random(std::random_device()())
+    {
+    }
+
+protected:
+
+    void format(
+            const Tracer::Trace& trace,
+            std::ostream& line) override
+    {
+        std::string trace_id;
+        std::string root_id;
+        {
+            std::unique_lock<std::mutex> lock(_random_mutex);
+            trace_id = identifier(2);
+            root_id = identifier(1);
+        }
+
+        line << R"({"resourceSpans":[{"resource":{"attributes":[)"
+             << R"({"key":"service.name","value":{"stringValue":"integration-service"}}]},)"
+             << R"("scopeSpans":[{"scope":{"name":"is::core::Tracer"},"spans":[)";
+
+        span(line, trace_id, root_id, std::string(), "route " + trace.topic,
+                trace.received, trace.finished, true, &trace);
+
+        for (const Tracer::Span& stage : trace.spans)
+        {
+            std::string span_id;
+            {
+                std::unique_lock<std::mutex> lock(_random_mutex);
+                span_id = identifier(1);
+            }
+
+            line << ',';
+            span(line, trace_id, span_id, root_id, stage.name, stage.start, stage.end, stage.success, nullptr);
+        }
+
+        line << "]}]}]}";
+    }
+
+private:
+
+    /**
+     * @brief Generates a random identifier of `words` 64 bit words, as a hexadecimal string.
+     */
+    std::string identifier(
+            std::size_t words)
+    {
+        std::ostringstream id;
+        id << std::hex << std::setfill('0');
+        for (std::size_t i = 0; i < words; ++i)
+        {
+            id << std::setw(16) << _random();
+        }
+        return id.str();
+    }
+
+    static std::string escape(
+            const std::string& text)
+    {
+        std::ostringstream escaped;
+        for (const char c : text)
+        {
+            switch (c)
+            {
+                case '"':
+                    escaped << "\\\"";
+                    break;
+                case '\\':
+                    escaped << "\\\\";
+                    break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20)
+                    {
+                        escaped << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                                << static_cast<int>(c) << std::dec;
+                    }
+                    else
+                    {
+                        escaped << c;
+                    }
+            }
+        }
+        return escaped.str();
+    }
+
+    void span(
+            std::ostream& line,
+            const std::string& trace_id,
+            const std::string& span_id,
+            const std::string& parent_id,
+            const std::string& name,
+            Tracer::Clock::time_point start,
+            Tracer::Clock::time_point end,
+            bool success,
+            const Tracer::Trace* root)
+    {
+        line << R"({"traceId":")" << trace_id << R"(","spanId":")" << span_id << '"';
+        if (!parent_id.empty())
+        {
+            line << R"(,"parentSpanId":")" << parent_id << '"';
+        }
+
+        line << R"(,"name":")" << escape(name) << R"(","kind":1)"
+             << R"(,"startTimeUnixNano":")" << unix_nanoseconds(start)
+             << R"(","endTimeUnixNano":")" << unix_nanoseconds(end) << '"';
+
+        if (root)
+        {
+            line << R"(,"attributes":[{"key":"is.topic","value":{"stringValue":")" << escape(root->topic)
+                 << R"("}},{"key":"is.source","value":{"stringValue":")" << escape(root->source) << R"("}}])";
+        }
+
+        // Status codes: 1 is OK, 2 is ERROR.
+        line << R"(,"status":{"code":)" << (success ? 1 : 2) << "}}";
+    }
+
+    std::mt19937_64 _random;
+    std::mutex _random_mutex;
+};
+
+} //  anonymous namespace
+
+//==============================================================================
+Tracer::Tracer(
+        std::size_t sample_every,
+        std::shared_ptr<Sink> sink)
+    : _sample_every(sample_every > 0 ? sample_every : 1)
+    , _sink(std::move(sink))
+    , _received(0)
+    , _traced(0)
+{
+}
+
+//==============================================================================
+std::unique_ptr<Tracer::Trace> Tracer::begin(
+        const std::string& topic,
+        const std::string& source) const
+{
+    std::unique_ptr<Trace> trace(new Trace());
+    trace->topic = topic;
+    trace->source = source;
+    trace->received = Clock::now();
+    return trace;
+}
+
+//==============================================================================
+void Tracer::finish(
+        std::unique_ptr<Trace> trace)
+{
+    trace->finished = Clock::now();
+    if (_sink)
+    {
+        _sink->write(*trace);
+    }
+    _traced.fetch_add(1, std::memory_order_relaxed);
+}
+
+//==============================================================================
+uint64_t Tracer::traced() const
+{
+    return _traced.load(std::memory_order_relaxed);
+}
+
+//==============================================================================
+std::shared_ptr<Tracer::Sink> Tracer::file_sink(
+        const std::string& format,
+        const std::string& path)
+{
+    std::shared_ptr<FileSink> sink;
+    if (format == "text")
+    {
+        sink = std::make_shared<TextSink>(path);
+    }
+    else if (format == "otlp")
+    {
+        sink = std::make_shared<OtlpSink>(path);
+    }
+
+    if (!sink || !sink->is_open())
+    {
+        return nullptr;
+    }
+
+    return sink;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/TrafficReader.hpp>
+
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#ifdef WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif //  NOMINMAX
+#include <io.h>
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif //  WIN32
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+//==============================================================================
+void unmap(
+        const uint8_t* map,
+        std::size_t size)
+{
+#ifdef WIN32
+    (void)size;
+    UnmapViewOfFile(map);
+#else
+    munmap(const_cast<uint8_t*>(map), size);
+#endif //  WIN32
+}
+
+} //  anonymous namespace
+
+//==============================================================================
+std::unique_ptr<TrafficReader> TrafficReader::open(
+        const std::string& path)
+{
+#ifdef WIN32
+    int fd = -1;
+    _sopen_s(&fd, path.c_str(), _O_RDONLY | _O_BINARY, _SH_DENYNO, _S_IREAD);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct _stat64 status;
+    if (_fstat64(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < TrafficRecorder::header_size)
+    {
+        _close(fd);
+        return nullptr;
+    }
+
+    const std::size_t mapped = static_cast<std::size_t>(status.st_size);
+    HANDLE mapping = CreateFileMappingA(
+        reinterpret_cast<HANDLE>(_get_osfhandle(fd)), nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* map = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, mapped) : nullptr;
+
+    // The view stays valid once the mapping and the file are closed.
+    if (mapping)
+    {
+        CloseHandle(mapping);
+    }
+    _close(fd);
+
+    if (!map)
+    {
+        return nullptr;
+    }
+#else
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || static_cast<std::size_t>(status.st_size) < TrafficRecorder::header_size)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const std::size_t mapped = static_cast<std::size_t>(status.st_size);
+    void* map = mmap(nullptr, mapped, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping stays valid once the file is closed.
+    ::close(fd);
+
+    if (map == MAP_FAILED)
+    {
+        return nullptr;
+    }
+#endif //  WIN32
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(map);
+    uint64_t end;
+    std::memcpy(&end, bytes + sizeof(TrafficRecorder::magic), sizeof(end));
+
+    if (std::memcmp(bytes, TrafficRecorder::magic, sizeof(TrafficRecorder::magic)) != 0
+            || end < TrafficRecorder::header_size || end > mapped)
+    {
+        unmap(bytes, mapped);
+        return nullptr;
+    }
+
+    return std::unique_ptr<TrafficReader>(new TrafficReader(bytes, mapped, static_cast<std::size_t>(end)));
+}
+
+//==============================================================================
+TrafficReader::TrafficReader(
+        const uint8_t* map,
+        std::size_t mapped,
+        std::size_t end)
+    : _map(map)
+    , _mapped(mapped)
+    , _end(end)
+    , _offset(TrafficRecorder::header_size)
+{
+}
+
+//==============================================================================
+TrafficReader::~TrafficReader()
+{
+    unmap(_map, _mapped);
+}
+
+//==============================================================================
+bool TrafficReader::next(
+        Sample& sample)
+{
+    /**
+     * Reads a field of the sample at `position`, failing if it exceeds the sample.
+     */
+    const auto read = [this](std::size_t& position, std::size_t limit, void* output, std::size_t size)
+            {
+                if (limit - position < size)
+                {
+                    return false;
+                }
+                std::memcpy(output, _map + position, size);
+                position += size;
+                return true;
+            };
+
+    std::size_t position = _offset;
+    uint32_t size;
+    if (!read(position, _end, &size, sizeof(size)) || _end - position < size)
+    {
+        return false;
+    }
+    const std::size_t limit = position + size;
+
+    uint8_t kind;
+    int64_t timestamp;
+    uint16_t name_size;
+    uint16_t type_size;
+
+    if (!read(position, limit, &kind, sizeof(kind))
+            || !read(position, limit, &timestamp, sizeof(timestamp))
+            || !read(position, limit, &name_size, sizeof(name_size))
+            || limit - position < name_size)
+    {
+        return false;
+    }
+    sample.name = std::string_view(reinterpret_cast<const char*>(_map + position), name_size);
+    position += name_size;
+
+    if (!read(position, limit, &type_size, sizeof(type_size)) || limit - position < type_size)
+    {
+        return false;
+    }
+    sample.type = std::string_view(reinterpret_cast<const char*>(_map + position), type_size);
+    position += type_size;
+
+    sample.kind = static_cast<TrafficRecorder::Kind>(kind);
+    sample.timestamp = std::chrono::nanoseconds(timestamp);
+    sample.payload = _map + position;
+    sample.size = limit - position;
+
+    _offset = limit;
+    return true;
+}
+
+//==============================================================================
+void TrafficReader::rewind()
+{
+    _offset = TrafficRecorder::header_size;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,570 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/TrafficRecorder.hpp>
+#include <is/utils/Log.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include <fcntl.h>
+
+#ifdef WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif //  NOMINMAX
+#include <io.h>
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif //  WIN32
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+//==============================================================================
+utils::Logger& logger()
+{
+    static utils::Logger logger("is::core::TrafficRecorder");
+    return logger;
+}
+
+//==============================================================================
+const xtypes::DynamicType& resolve(
+        const xtypes::DynamicType& type)
+{
+    return type.kind() == xtypes::TypeKind::ALIAS_TYPE
+           ? static_cast<const xtypes::AliasType&>(type).rget()
+           : type;
+}
+
+//==============================================================================
+template<typename T>
+void append(
+        std::string& output,
+        const T& value)
+{
+    output.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+//==============================================================================
+bool encode_value(
+        const xtypes::DynamicType& alias,
+        const xtypes::ReadableDynamicDataRef& data,
+        std::string& output)
+{
+    using xtypes::TypeKind;
+
+    const xtypes::DynamicType& type = resolve(alias);
+    switch (type.kind())
+    {
+        case TypeKind::STRUCTURE_TYPE:
+        {
+            const auto& structure = static_cast<const xtypes::AggregationType&>(type);
+            for (std::size_t i = 0; i < structure.members().size(); ++i)
+            {
+                if (!encode_value(structure.members()[i].type(), data[i], output))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case TypeKind::SEQUENCE_TYPE:
+        case TypeKind::ARRAY_TYPE:
+        {
+            const auto& collection = static_cast<const xtypes::CollectionType&>(type);
+            const uint32_t size = static_cast<uint32_t>(data.size());
+            if (type.kind() == TypeKind::SEQUENCE_TYPE)
+            {
+                append(output, size);
+            }
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                if (!encode_value(collection.content_type(), data[i], output))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case TypeKind::STRING_TYPE:
+        {
+            const std::string& value = data.value<std::string>();
+            append(output, static_cast<uint32_t>(value.size()));
+            output.append(value);
+            return true;
+        }
+        case TypeKind::WSTRING_TYPE:
+        {
+            const std::wstring& value = data.value<std::wstring>();
+            append(output, static_cast<uint32_t>(value.size()));
+            output.append(reinterpret_cast<const char*>(value.data()), value.size() * sizeof(wchar_t));
+            return true;
+        }
+        case TypeKind::BOOLEAN_TYPE: append(output, static_cast<uint8_t>(data.value<bool>())); return true;
+        case TypeKind::BYTE_TYPE: append(output, data.value<uint8_t>()); return true;
+        case TypeKind::UINT_8_TYPE: append(output, data.value<uint8_t>()); return true;
+        case TypeKind::INT_8_TYPE: append(output, data.value<int8_t>()); return true;
+        case TypeKind::CHAR_8_TYPE: append(output, data.value<char>()); return true;
+        case TypeKind::CHAR_16_TYPE: append(output, data.value<char16_t>()); return true;
+        case TypeKind::WIDE_CHAR_TYPE: append(output, data.value<wchar_t>()); return true;
+        case TypeKind::INT_16_TYPE: append(output, data.value<int16_t>()); return true;
+        case TypeKind::UINT_16_TYPE: append(output, data.value<uint16_t>()); return true;
+        case TypeKind::INT_32_TYPE: append(output, data.value<int32_t>()); return true;
+        case TypeKind::UINT_32_TYPE: append(output, data.value<uint32_t>()); return true;
+        case TypeKind::INT_64_TYPE: append(output, data.value<int64_t>()); return true;
+        case TypeKind::UINT_64_TYPE: append(output, data.value<uint64_t>()); return true;
+        case TypeKind::FLOAT_32_TYPE: append(output, data.value<float>()); return true;
+        case TypeKind::FLOAT_64_TYPE: append(output, data.value<double>()); return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @class Cursor
+ *        Bounds checked reading position within an encoded message.
+ */
+class Cursor
+{
+public:
+
+    Cursor(
+            const uint8_t* begin,
+            std::size_t size)
+        : _current(begin)
+        , _end(begin + size)
+    {
+    }
+
+    bool at_end() const
+    {
+        return _current == _end;
+    }
+
+    template<typename T>
+    bool read(
+            T& value)
+    {
+        return read_bytes(&value, sizeof(T));
+    }
+
+    bool read_bytes(
+            void* output,
+            std::size_t size)
+    {
+        if (static_cast<std::size_t>(_end - _current) < size)
+        {
+            return false;
+        }
+        std::memcpy(output, _current, size);
+        _current += size;
+        return true;
+    }
+
+    template<typename T>
+    bool read_into(
+            xtypes::WritableDynamicDataRef& data)
+    {
+        T value;
+        if (!read(value))
+        {
+            return false;
+        }
+        data.value<T>(value);
+        return true;
+    }
+
+private:
+
+    const uint8_t* _current;
+    const uint8_t* const _end;
+};
+
+//==============================================================================
+bool decode_value(
+        const xtypes::DynamicType& alias,
+        Cursor& cursor,
+        xtypes::WritableDynamicDataRef data)
+{
+    using xtypes::TypeKind;
+
+    const xtypes::DynamicType& type = resolve(alias);
+    switch (type.kind())
+    {
+        case TypeKind::STRUCTURE_TYPE:
+        {
+            const auto& structure = static_cast<const xtypes::AggregationType&>(type);
+            for (std::size_t i = 0; i < structure.members().size(); ++i)
+            {
+                if (!decode_value(structure.members()[i].type(), cursor, data[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case TypeKind::SEQUENCE_TYPE:
+        case TypeKind::ARRAY_TYPE:
+        {
+            const auto& collection = static_cast<const xtypes::CollectionType&>(type);
+            uint32_t size = static_cast<uint32_t>(data.size());
+            if (type.kind() == TypeKind::SEQUENCE_TYPE)
+            {
+                if (!cursor.read(size) || (collection.bounds() > 0 && size > collection.bounds()))
+                {
+                    return false;
+                }
+                data.resize(size);
+            }
+            for (uint32_t i = 0; i < size; ++i)
+            {
+                if (!decode_value(collection.content_type(), cursor, data[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case TypeKind::STRING_TYPE:
+        {
+            uint32_t size;
+            std::string value;
+            if (!cursor.read(size))
+            {
+                return false;
+            }
+            value.resize(size);
+            if (!cursor.read_bytes(&value[0], size))
+            {
+                return false;
+            }
+            data.value<std::string>(value);
+            return true;
+        }
+        case TypeKind::WSTRING_TYPE:
+        {
+            uint32_t size;
+            std::wstring value;
+            if (!cursor.read(size))
+            {
+                return false;
+            }
+            value.resize(size);
+            if (!cursor.read_bytes(&value[0], size * sizeof(wchar_t)))
+            {
+                return false;
+            }
+            data.value<std::wstring>(value);
+            return true;
+        }
+        case TypeKind::BOOLEAN_TYPE:
+        {
+            uint8_t value;
+            if (!cursor.read(value))
+            {
+                return false;
+            }
+            data.value<bool>(value != 0);
+            return true;
+        }
+        case TypeKind::BYTE_TYPE: return cursor.read_into<uint8_t>(data);
+        case TypeKind::UINT_8_TYPE: return cursor.read_into<uint8_t>(data);
+        case TypeKind::INT_8_TYPE: return cursor.read_into<int8_t>(data);
+        case TypeKind::CHAR_8_TYPE: return cursor.read_into<char>(data);
+        case TypeKind::CHAR_16_TYPE: return cursor.read_into<char16_t>(data);
+        case TypeKind::WIDE_CHAR_TYPE: return cursor.read_into<wchar_t>(data);
+        case TypeKind::INT_16_TYPE: return cursor.read_into<int16_t>(data);
+        case TypeKind::UINT_16_TYPE: return cursor.read_into<uint16_t>(data);
+        case TypeKind::INT_32_TYPE: return cursor.read_into<int32_t>(data);
+        case TypeKind::UINT_32_TYPE: return cursor.read_into<uint32_t>(data);
+        case TypeKind::INT_64_TYPE: return cursor.read_into<int64_t>(data);
+        case TypeKind::UINT_64_TYPE: return cursor.read_into<uint64_t>(data);
+        case TypeKind::FLOAT_32_TYPE: return cursor.read_into<float>(data);
+        case TypeKind::FLOAT_64_TYPE: return cursor.read_into<double>(data);
+        default:
+            return false;
+    }
+}
+
+//==============================================================================
+/**
+ * The capture file is kept open with a C runtime descriptor on every platform,
+ * and mapped with CreateFileMapping on Windows or with mmap elsewhere.
+ */
+int open_file(
+        const std::string& path)
+{
+#ifdef WIN32
+    int fd = -1;
+    _sopen_s(&fd, path.c_str(), _O_RDWR | _O_CREAT | _O_TRUNC | _O_BINARY, _SH_DENYWR, _S_IREAD | _S_IWRITE);
+    return fd;
+#else
+    return ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+#endif //  WIN32
+}
+
+//==============================================================================
+void close_file(
+        int fd)
+{
+#ifdef WIN32
+    _close(fd);
+#else
+    ::close(fd);
+#endif //  WIN32
+}
+
+//==============================================================================
+bool resize_file(
+        int fd,
+        std::size_t size)
+{
+#ifdef WIN32
+    return _chsize_s(fd, static_cast<__int64>(size)) == 0;
+#else
+    return ftruncate(fd, static_cast<off_t>(size)) == 0;
+#endif //  WIN32
+}
+
+//==============================================================================
+uint8_t* map_file(
+        int fd,
+        std::size_t size)
+{
+    if (!resize_file(fd, size))
+    {
+        return nullptr;
+    }
+
+#ifdef WIN32
+    const uint64_t size64 = size;
+    HANDLE mapping = CreateFileMappingA(
+        reinterpret_cast<HANDLE>(_get_osfhandle(fd)), nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64 & 0xFFFFFFFF), nullptr);
+    if (!mapping)
+    {
+        return nullptr;
+    }
+
+    // The view keeps the mapping alive once its handle is closed.
+    void* map = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, size);
+    CloseHandle(mapping);
+    return static_cast<uint8_t*>(map);
+#else
+    void* map = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    return map == MAP_FAILED ? nullptr : static_cast<uint8_t*>(map);
+#endif //  WIN32
+}
+
+//==============================================================================
+void unmap_file(
+        uint8_t* map,
+        std::size_t size)
+{
+#ifdef WIN32
+    (void)size;
+    UnmapViewOfFile(map);
+#else
+    munmap(map, size);
+#endif //  WIN32
+}
+
+} //  anonymous namespace
+
+constexpr char TrafficRecorder::magic[8];
+
+//==============================================================================
+std::shared_ptr<TrafficRecorder> TrafficRecorder::create(
+        const std::string& path,
+        std::size_t segment_size)
+{
+    segment_size = std::max(segment_size, header_size);
+
+    const int fd = open_file(path);
+    if (fd < 0)
+    {
+        return nullptr;
+    }
+
+    uint8_t* map = map_file(fd, segment_size);
+    if (!map)
+    {
+        close_file(fd);
+        return nullptr;
+    }
+
+    return std::shared_ptr<TrafficRecorder>(new TrafficRecorder(fd, map, segment_size));
+}
+
+//==============================================================================
+TrafficRecorder::TrafficRecorder(
+        int fd,
+        uint8_t* map,
+        std::size_t segment_size)
+    : _fd(fd)
+    , _map(map)
+    , _mapped(segment_size)
+    , _segment_size(segment_size)
+    , _end(header_size)
+    , _recorded(0)
+{
+    const uint64_t end = _end;
+    std::memcpy(_map, magic, sizeof(magic));
+    std::memcpy(_map + sizeof(magic), &end, sizeof(end));
+}
+
+//==============================================================================
+TrafficRecorder::~TrafficRecorder()
+{
+    if (_map)
+    {
+        unmap_file(_map, _mapped);
+    }
+
+    // Drops the unused part of the last segment.
+    if (!resize_file(_fd, _end))
+    {
+        logger() << utils::Logger::Level::WARN
+               << "Could not truncate the capture file to its " << _end << " recorded bytes." << std::endl;
+    }
+    close_file(_fd);
+}
+
+//==============================================================================
+void TrafficRecorder::record(
+        Kind kind,
+        const std::string& name,
+        const xtypes::ReadableDynamicDataRef& data)
+{
+    /**
+     * The sample is encoded beforehand, in a buffer reused by each thread,
+     * so that the lock is only held to copy it into the mapped file.
+     */
+    thread_local std::string sample;
+    sample.clear();
+
+    const std::string& type_name = data.type().name();
+    const int64_t timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+
+    append(sample, uint32_t(0));
+    append(sample, static_cast<uint8_t>(kind));
+    append(sample, timestamp);
+    append(sample, static_cast<uint16_t>(name.size()));
+    sample.append(name);
+    append(sample, static_cast<uint16_t>(type_name.size()));
+    sample.append(type_name);
+
+    const bool encoded = encode(data, sample);
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    if (!encoded)
+    {
+        if (_unsupported.insert(type_name).second)
+        {
+            logger() << utils::Logger::Level::WARN
+                   << "The messages of type '" << type_name << "' cannot be recorded, "
+                   << "since the capture files do not support some of its members." << std::endl;
+        }
+        return;
+    }
+
+    const uint32_t size = static_cast<uint32_t>(sample.size() - sizeof(uint32_t));
+    std::memcpy(&sample[0], &size, sizeof(size));
+
+    if (!reserve(sample.size()))
+    {
+        return;
+    }
+
+    std::memcpy(_map + _end, sample.data(), sample.size());
+    _end += sample.size();
+    ++_recorded;
+
+    const uint64_t end = _end;
+    std::memcpy(_map + sizeof(magic), &end, sizeof(end));
+}
+
+//==============================================================================
+uint64_t TrafficRecorder::recorded() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    return _recorded;
+}
+
+//==============================================================================
+bool TrafficRecorder::encode(
+        const xtypes::ReadableDynamicDataRef& data,
+        std::string& output)
+{
+    return encode_value(data.type(), data, output);
+}
+
+//==============================================================================
+bool TrafficRecorder::decode(
+        const uint8_t* input,
+        std::size_t size,
+        xtypes::WritableDynamicDataRef data)
+{
+    Cursor cursor(input, size);
+    const xtypes::DynamicType& type = data.type();
+    return decode_value(type, cursor, data) && cursor.at_end();
+}
+
+//==============================================================================
+bool TrafficRecorder::reserve(
+        std::size_t size)
+{
+    if (!_map)
+    {
+        return false;
+    }
+
+    if (_end + size <= _mapped)
+    {
+        return true;
+    }
+
+    const std::size_t segments = (_end + size - _mapped + _segment_size - 1) / _segment_size;
+    const std::size_t mapped = _mapped + segments * _segment_size;
+
+    unmap_file(_map, _mapped);
+    _map = map_file(_fd, mapped);
+    if (!_map)
+    {
+        logger() << utils::Logger::Level::ERROR
+               << "Could not grow the capture file to " << mapped << " bytes. "
+               << "No more samples will be recorded." << std::endl;
+        return false;
+    }
+
+    _mapped = mapped;
+    return true;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/TypeTable.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+//==============================================================================
+TypeTable& TypeTable::global()
+{
+    /**
+     * The table is never destroyed, so that the leases held by static objects
+     * can still be released while the process exits.
+     */
+    static TypeTable* table = new TypeTable();
+    return *table;
+}
+
+//==============================================================================
+xtypes::DynamicType::Ptr TypeTable::intern(
+        const xtypes::DynamicType::Ptr& type,
+        Lease& lease)
+{
+    if (!type)
+    {
+        lease.reset();
+        return type;
+    }
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    TypeId id = INVALID_ID;
+    auto address = _ids_by_address.find(type.get());
+    if (address != _ids_by_address.end())
+    {
+        id = address->second;
+    }
+    else
+    {
+        std::vector<TypeId>& candidates = _ids_by_name[type->name()];
+        for (TypeId candidate : candidates)
+        {
+            if (_slots[candidate].type->is_compatible(*type) == xtypes::TypeConsistency::EQUALS)
+            {
+                id = candidate;
+                break;
+            }
+        }
+
+        if (id == INVALID_ID)
+        {
+            if (_free_ids.empty())
+            {
+                id = _slots.size();
+                _slots.emplace_back();
+            }
+            else
+            {
+                id = _free_ids.back();
+                _free_ids.pop_back();
+            }
+
+            _slots[id].type = type;
+            candidates.push_back(id);
+            _ids_by_address.emplace(_slots[id].type.get(), id);
+        }
+    }
+
+    ++_slots[id].leases;
+    lease = Lease(nullptr, [this, id](const void*)
+                    {
+                        release(id);
+                    });
+    return _slots[id].type;
+}
+
+//==============================================================================
+void TypeTable::release(
+        TypeId id)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    Slot& slot = _slots[id];
+    if (--slot.leases > 0)
+    {
+        return;
+    }
+
+    std::vector<TypeId>& candidates = _ids_by_name[slot.type->name()];
+    candidates.erase(std::remove(candidates.begin(), candidates.end(), id), candidates.end());
+    if (candidates.empty())
+    {
+        _ids_by_name.erase(slot.type->name());
+    }
+    _ids_by_address.erase(slot.type.get());
+
+    slot.type = xtypes::DynamicType::Ptr();
+    _free_ids.push_back(id);
+}
+
+//==============================================================================
+TypeTable::TypeId TypeTable::id(
+        const xtypes::DynamicType& type) const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    auto it = _ids_by_address.find(&type);
+    return it == _ids_by_address.end() ? INVALID_ID : it->second;
+}
+
+//==============================================================================
+const xtypes::DynamicType* TypeTable::type(
+        TypeId id) const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    return id < _slots.size() ? _slots[id].type.get() : nullptr;
+}
+
+//==============================================================================
+std::size_t TypeTable::size() const
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    return _slots.size() - _free_ids.size();
+}
+
+//==============================================================================
+std::string TypeTable::unscoped(
+        const std::string& name)
+{
+    return name.compare(0, 2, "::") == 0 ? name.substr(2) : name;
+}
+
+//==============================================================================
+TypeRegistry::const_iterator TypeTable::find_type(
+        const TypeRegistry& types,
+        const std::string& name)
+{
+    return types.find(unscoped(name));
+}
+
+//==============================================================================
+const xtypes::DynamicType::Ptr& TypeTable::type_at(
+        const TypeRegistry& types,
+        const std::string& name)
+{
+    auto it = find_type(types, name);
+    if (it == types.end())
+    {
+        throw std::out_of_range("The type '" + name + "' is not registered.");
+    }
+    return it->second;
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,660 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/TypesCache.hpp>
+
+#include <cstdio>
+#include <cstring>
+#include <experimental/filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+
+namespace eprosima {
+namespace is {
+namespace core {
+
+namespace {
+
+/**
+ * First bytes of every cache file. The last one is the format version,
+ * which must be increased whenever the encoding below changes.
+ */
+const char cache_magic[] = {'I', 'S', 'T', 'C', 1};
+
+/**
+ * @class Encoder
+ *        Writes a table of types, where every type is written after the ones it depends on,
+ *        and refers to them by their position in the table. Equal entries are written once.
+ */
+class Encoder
+{
+public:
+
+    bool encode(
+            const xtypes::DynamicType& type,
+            uint32_t& index)
+    {
+        std::string entry;
+        put_u32(entry, static_cast<uint32_t>(type.kind()));
+
+        switch (type.kind())
+        {
+            case xtypes::TypeKind::BOOLEAN_TYPE:
+            case xtypes::TypeKind::CHAR_8_TYPE:
+            case xtypes::TypeKind::CHAR_16_TYPE:
+            case xtypes::TypeKind::WIDE_CHAR_TYPE:
+            case xtypes::TypeKind::INT_8_TYPE:
+            case xtypes::TypeKind::UINT_8_TYPE:
+            case xtypes::TypeKind::INT_16_TYPE:
+            case xtypes::TypeKind::UINT_16_TYPE:
+            case xtypes::TypeKind::INT_32_TYPE:
+            case xtypes::TypeKind::UINT_32_TYPE:
+            case xtypes::TypeKind::INT_64_TYPE:
+            case xtypes::TypeKind::UINT_64_TYPE:
+            case xtypes::TypeKind::FLOAT_32_TYPE:
+            case xtypes::TypeKind::FLOAT_64_TYPE:
+            case xtypes::TypeKind::FLOAT_128_TYPE:
+                break;
+            case xtypes::TypeKind::STRING_TYPE:
+            case xtypes::TypeKind::WSTRING_TYPE:
+            {
+                put_u32(entry, static_cast<const xtypes::CollectionType&>(type).bounds());
+                break;
+            }
+            case xtypes::TypeKind::SEQUENCE_TYPE:
+            {
+                const auto& sequence = static_cast<const xtypes::SequenceType&>(type);
+                uint32_t content;
+                if (!encode(sequence.content_type(), content))
+                {
+                    return false;
+                }
+                put_u32(entry, content);
+                put_u32(entry, sequence.bounds());
+                break;
+            }
+            case xtypes::TypeKind::ARRAY_TYPE:
+            {
+                const auto& array = static_cast<const xtypes::ArrayType&>(type);
+                uint32_t content;
+                if (!encode(array.content_type(), content))
+                {
+                    return false;
+                }
+                put_u32(entry, content);
+                put_u32(entry, array.dimension());
+                break;
+            }
+            case xtypes::TypeKind::MAP_TYPE:
+            {
+                const auto& map = static_cast<const xtypes::MapType&>(type);
+                uint32_t key;
+                uint32_t value;
+                if (!encode(map.key_type(), key) || !encode(map.value_type(), value))
+                {
+                    return false;
+                }
+                put_u32(entry, key);
+                put_u32(entry, value);
+                put_u32(entry, map.bounds());
+                break;
+            }
+            case xtypes::TypeKind::ALIAS_TYPE:
+            {
+                const auto& alias = static_cast<const xtypes::AliasType&>(type);
+                uint32_t aliased;
+                if (!encode(alias.get(), aliased))
+                {
+                    return false;
+                }
+                put_string(entry, alias.name());
+                put_u32(entry, aliased);
+                break;
+            }
+            case xtypes::TypeKind::ENUMERATION_TYPE:
+            {
+                const auto& enumeration = static_cast<const xtypes::EnumerationType<uint32_t>&>(type);
+                put_string(entry, enumeration.name());
+                put_u32(entry, static_cast<uint32_t>(enumeration.enumerators().size()));
+                for (const auto& [name, value] : enumeration.enumerators())
+                {
+                    put_string(entry, name);
+                    put_u32(entry, value);
+                }
+                break;
+            }
+            case xtypes::TypeKind::STRUCTURE_TYPE:
+            {
+                const auto& structure = static_cast<const xtypes::StructType&>(type);
+                if (structure.has_parent())
+                {
+                    return false;
+                }
+
+                put_string(entry, structure.name());
+                put_u32(entry, static_cast<uint32_t>(structure.members().size()));
+                for (const xtypes::Member& member : structure.members())
+                {
+                    uint32_t member_type;
+                    if (member.is_optional() || !encode(member.type(), member_type))
+                    {
+                        return false;
+                    }
+                    put_string(entry, member.name());
+                    put_u32(entry, member_type);
+                    entry += static_cast<char>(member.is_key() ? 1 : 0);
+                }
+                break;
+            }
+            default:
+                return false;
+        }
+
+        const auto it = _entries.find(entry);
+        if (it != _entries.end())
+        {
+            index = it->second;
+            return true;
+        }
+
+        index = static_cast<uint32_t>(_entries.size());
+        _entries.emplace(entry, index);
+        _table += entry;
+        return true;
+    }
+
+    std::size_t size() const
+    {
+        return _entries.size();
+    }
+
+    const std::string& table() const
+    {
+        return _table;
+    }
+
+    static void put_u32(
+            std::string& output,
+            uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            output += static_cast<char>((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    static void put_string(
+            std::string& output,
+            const std::string& value)
+    {
+        put_u32(output, static_cast<uint32_t>(value.size()));
+        output += value;
+    }
+
+private:
+
+    std::map<std::string, uint32_t> _entries;
+    std::string _table;
+};
+
+/**
+ * @class Decoder
+ *        Reads the table written by Encoder. Every read is bounds checked,
+ *        so that truncated or corrupted files are rejected.
+ */
+class Decoder
+{
+public:
+
+    Decoder(
+            const std::string& input)
+        : _input(input)
+        , _position(0)
+    {
+    }
+
+    bool check_magic()
+    {
+        if (_input.size() < sizeof(cache_magic)
+                || std::memcmp(_input.data(), cache_magic, sizeof(cache_magic)) != 0)
+        {
+            return false;
+        }
+        _position = sizeof(cache_magic);
+        return true;
+    }
+
+    bool get_u32(
+            uint32_t& value)
+    {
+        if (_input.size() - _position < 4)
+        {
+            return false;
+        }
+
+        value = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            value |= static_cast<uint32_t>(static_cast<unsigned char>(_input[_position++])) << (8 * i);
+        }
+        return true;
+    }
+
+    bool get_string(
+            std::string& value)
+    {
+        uint32_t size;
+        if (!get_u32(size) || _input.size() - _position < size)
+        {
+            return false;
+        }
+
+        value.assign(_input, _position, size);
+        _position += size;
+        return true;
+    }
+
+    bool get_flag(
+            bool& value)
+    {
+        if (_position >= _input.size())
+        {
+            return false;
+        }
+        value = _input[_position++] != 0;
+        return true;
+    }
+
+    bool get_reference(
+            const std::vector<xtypes::DynamicType::Ptr>& table,
+            const xtypes::DynamicType*& type)
+    {
+        uint32_t index;
+        if (!get_u32(index) || index >= table.size())
+        {
+            return false;
+        }
+        type = table[index].get();
+        return true;
+    }
+
+    bool decode(
+            const std::vector<xtypes::DynamicType::Ptr>& table,
+            xtypes::DynamicType::Ptr& type)
+    {
+        uint32_t raw_kind;
+        if (!get_u32(raw_kind))
+        {
+            return false;
+        }
+
+        switch (static_cast<xtypes::TypeKind>(raw_kind))
+        {
+            case xtypes::TypeKind::BOOLEAN_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<bool>());
+                return true;
+            case xtypes::TypeKind::CHAR_8_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<char>());
+                return true;
+            case xtypes::TypeKind::CHAR_16_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<char16_t>());
+                return true;
+            case xtypes::TypeKind::WIDE_CHAR_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<wchar_t>());
+                return true;
+            case xtypes::TypeKind::INT_8_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<int8_t>());
+                return true;
+            case xtypes::TypeKind::UINT_8_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<uint8_t>());
+                return true;
+            case xtypes::TypeKind::INT_16_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<int16_t>());
+                return true;
+            case xtypes::TypeKind::UINT_16_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<uint16_t>());
+                return true;
+            case xtypes::TypeKind::INT_32_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<int32_t>());
+                return true;
+            case xtypes::TypeKind::UINT_32_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<uint32_t>());
+                return true;
+            case xtypes::TypeKind::INT_64_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<int64_t>());
+                return true;
+            case xtypes::TypeKind::UINT_64_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<uint64_t>());
+                return true;
+            case xtypes::TypeKind::FLOAT_32_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<float>());
+                return true;
+            case xtypes::TypeKind::FLOAT_64_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<double>());
+                return true;
+            case xtypes::TypeKind::FLOAT_128_TYPE:
+                type = xtypes::DynamicType::Ptr(xtypes::primitive_type<long double>());
+                return true;
+            case xtypes::TypeKind::STRING_TYPE:
+            case xtypes::TypeKind::WSTRING_TYPE:
+            {
+                uint32_t bounds;
+                if (!get_u32(bounds))
+                {
+                    return false;
+                }
+
+                if (static_cast<xtypes::TypeKind>(raw_kind) == xtypes::TypeKind::STRING_TYPE)
+                {
+                    type = xtypes::DynamicType::Ptr(xtypes::StringType(static_cast<int>(bounds)));
+                }
+                else
+                {
+                    type = xtypes::DynamicType::Ptr(xtypes::WStringType(static_cast<int>(bounds)));
+                }
+                return true;
+            }
+            case xtypes::TypeKind::SEQUENCE_TYPE:
+            {
+                const xtypes::DynamicType* content;
+                uint32_t bounds;
+                if (!get_reference(table, content) || !get_u32(bounds))
+                {
+                    return false;
+                }
+                type = xtypes::DynamicType::Ptr(xtypes::SequenceType(*content, bounds));
+                return true;
+            }
+            case xtypes::TypeKind::ARRAY_TYPE:
+            {
+                const xtypes::DynamicType* content;
+                uint32_t dimension;
+                if (!get_reference(table, content) || !get_u32(dimension))
+                {
+                    return false;
+                }
+                type = xtypes::DynamicType::Ptr(xtypes::ArrayType(*content, dimension));
+                return true;
+            }
+            case xtypes::TypeKind::MAP_TYPE:
+            {
+                const xtypes::DynamicType* key;
+                const xtypes::DynamicType* value;
+                uint32_t bounds;
+                if (!get_reference(table, key) || !get_reference(table, value) || !get_u32(bounds))
+                {
+                    return false;
+                }
+                type = xtypes::DynamicType::Ptr(xtypes::MapType(*key, *value, bounds));
+                return true;
+            }
+            case xtypes::TypeKind::ALIAS_TYPE:
+            {
+                std::string name;
+                const xtypes::DynamicType* aliased;
+                if (!get_string(name) || !get_reference(table, aliased))
+                {
+                    return false;
+                }
+                type = xtypes::DynamicType::Ptr(xtypes::AliasType(*aliased, name));
+                return true;
+            }
+            case xtypes::TypeKind::ENUMERATION_TYPE:
+            {
+                std::string name;
+                uint32_t count;
+                if (!get_string(name) || !get_u32(count))
+                {
+                    return false;
+                }
+
+                xtypes::EnumerationType<uint32_t> enumeration(name);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    std::string identifier;
+                    uint32_t value;
+                    if (!get_string(identifier) || !get_u32(value))
+                    {
+                        return false;
+                    }
+                    enumeration.add_enumerator(identifier, value);
+                }
+                type = xtypes::DynamicType::Ptr(enumeration);
+                return true;
+            }
+            case xtypes::TypeKind::STRUCTURE_TYPE:
+            {
+                std::string name;
+                uint32_t count;
+                if (!get_string(name) || !get_u32(count))
+                {
+                    return false;
+                }
+
+                xtypes::StructType structure(name);
+                for (uint32_t i = 0; i < count; ++i)
+                {
+                    std::string member_name;
+                    const xtypes::DynamicType* member_type;
+                    bool key;
+                    if (!get_string(member_name) || !get_reference(table, member_type) || !get_flag(key))
+                    {
+                        return false;
+                    }
+                    structure.add_member(xtypes::Member(member_name, *member_type).key(key));
+                }
+                type = xtypes::DynamicType::Ptr(structure);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool finished() const
+    {
+        return _position == _input.size();
+    }
+
+private:
+
+    const std::string& _input;
+    std::size_t _position;
+};
+
+//==============================================================================
+uint64_t fnv1a(
+        uint64_t hash,
+        const char* data,
+        std::size_t size)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+} //  anonymous namespace
+
+//==============================================================================
+TypesCache::TypesCache(
+        const std::string& directory)
+    : _directory(directory)
+{
+}
+
+//==============================================================================
+bool TypesCache::load(
+        const std::string& idl,
+        const std::vector<std::string>& include_paths,
+        Types& types) const
+{
+    std::ifstream file(file_path(idl, include_paths), std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+
+    const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return deserialize(contents, types);
+}
+
+//==============================================================================
+bool TypesCache::store(
+        const std::string& idl,
+        const std::vector<std::string>& include_paths,
+        const Types& types) const
+{
+    std::string contents;
+    if (!serialize(types, contents))
+    {
+        return false;
+    }
+
+    std::error_code error;
+    std::experimental::filesystem::create_directories(_directory, error);
+    if (error)
+    {
+        return false;
+    }
+
+    // The file is written aside and then renamed, so that concurrent instances
+    // sharing the cache never read a partially written file.
+    const std::string path = file_path(idl, include_paths);
+    const std::string temporary_path = path + "." + std::to_string(std::random_device()()) + ".tmp";
+    {
+        std::ofstream file(temporary_path, std::ios::binary | std::ios::trunc);
+        if (!file || !file.write(contents.data(), static_cast<std::streamsize>(contents.size())))
+        {
+            std::remove(temporary_path.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(temporary_path.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporary_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+//==============================================================================
+bool TypesCache::serialize(
+        const Types& types,
+        std::string& output)
+{
+    Encoder encoder;
+    std::string names;
+    for (const auto& [name, type] : types)
+    {
+        uint32_t index;
+        if (!encoder.encode(*type, index))
+        {
+            return false;
+        }
+        Encoder::put_string(names, name);
+        Encoder::put_u32(names, index);
+    }
+
+    output.assign(cache_magic, sizeof(cache_magic));
+    Encoder::put_u32(output, static_cast<uint32_t>(encoder.size()));
+    output += encoder.table();
+    Encoder::put_u32(output, static_cast<uint32_t>(types.size()));
+    output += names;
+    return true;
+}
+
+//==============================================================================
+bool TypesCache::deserialize(
+        const std::string& input,
+        Types& types)
+{
+    Decoder decoder(input);
+    uint32_t table_size;
+    if (!decoder.check_magic() || !decoder.get_u32(table_size))
+    {
+        return false;
+    }
+
+    std::vector<xtypes::DynamicType::Ptr> table;
+    for (uint32_t i = 0; i < table_size; ++i)
+    {
+        xtypes::DynamicType::Ptr type;
+        if (!decoder.decode(table, type))
+        {
+            return false;
+        }
+        table.push_back(std::move(type));
+    }
+
+    uint32_t count;
+    if (!decoder.get_u32(count))
+    {
+        return false;
+    }
+
+    Types restored;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        std::string name;
+        uint32_t index;
+        if (!decoder.get_string(name) || !decoder.get_u32(index) || index >= table.size())
+        {
+            return false;
+        }
+        restored.emplace(name, table[index]);
+    }
+
+    if (!decoder.finished())
+    {
+        return false;
+    }
+
+    types = std::move(restored);
+    return true;
+}
+
+//==============================================================================
+std::string TypesCache::file_path(
+        const std::string& idl,
+        const std::vector<std::string>& include_paths) const
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    hash = fnv1a(hash, cache_magic, sizeof(cache_magic));
+    hash = fnv1a(hash, idl.data(), idl.size() + 1);
+    for (const std::string& path : include_paths)
+    {
+        hash = fnv1a(hash, path.data(), path.size() + 1);
+    }
+
+    std::ostringstream name;
+    name << std::hex;
+    name.width(16);
+    name.fill('0');
+    name << hash;
+
+    return (std::experimental::filesystem::path(_directory) / (name.str() + ".types")).string();
+}
+
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
@@ -26,7 +26,7 @@ namespace internal {
 
 //==============================================================================
 SystemHandleInfo::SystemHandleInfo(
-        std::unique_ptr<SystemHandle> input)
+        std::shared_ptr<SystemHandle> input)
     : handle(std::move(input))
     , topic_publisher(dynamic_cast<TopicPublisherSystem*>(handle.get()))
     , topic_subscriber(dynamic_cast<TopicSubscriberSystem*>(handle.get()))
@@ -44,6 +44,8 @@ SystemHandleInfo::SystemHandleInfo(
     , service_client(std::move(other.service_client))
     , service_provider(std::move(other.service_provider))
     , types(std::move(other.types))
+    , shared(other.shared)
+    , origin_tag(other.origin_tag)
 {
 }
 
@@ -53,11 +55,16 @@ SystemHandleInfo::operator bool () const
     return static_cast<bool>(handle);
 }
 
-/**
- * Initializes Register of static members.
- */
-Register::FactoryMap Register::_info_map;
-std::mutex Register::_mutex;
+//==============================================================================
+Register::FactoryMap& Register::info_map(
+        std::mutex*& mutex)
+{
+    static std::mutex map_mutex;
+    static FactoryMap map;
+
+    mutex = &map_mutex;
+    return map;
+}
 
 //==============================================================================
 void Register::insert(
@@ -69,9 +76,11 @@ void Register::insert(
     FactoryMap::value_type entry(
         std::move(middleware), std::move(handle_factory));
 
-    std::unique_lock<std::mutex> lock(_mutex);
+    std::mutex* mutex;
+    FactoryMap& factories = info_map(mutex);
+    std::unique_lock<std::mutex> lock(*mutex);
 
-    auto res = _info_map.insert(std::move(entry));
+    auto res = factories.insert(std::move(entry));
 
     if (res.second)
     {
@@ -94,9 +103,23 @@ SystemHandleInfo Register::get(
 {
     utils::Logger logger("is::core::systemhandle::RegisterSystem");
 
-    const FactoryMap::const_iterator it_mw = _info_map.find(middleware);
+    /**
+     * Middlewares can be loaded concurrently, so the factory is copied while holding the lock,
+     * and the SystemHandle is created once it has been released.
+     */
+    detail::SystemHandleFactoryBuilder factory;
+    {
+        std::mutex* mutex;
+        const FactoryMap& factories = info_map(mutex);
+        std::unique_lock<std::mutex> lock(*mutex);
+        const FactoryMap::const_iterator it_mw = factories.find(middleware);
+        if (it_mw != factories.end())
+        {
+            factory = it_mw->second;
+        }
+    }
 
-    if (it_mw == _info_map.end())
+    if (!factory)
     {
         logger << utils::Logger::Level::ERROR
                << "Could not find SystemHandle library for middleware '"
@@ -113,7 +136,17 @@ SystemHandleInfo Register::get(
                << std::endl;
     }
 
-    return SystemHandleInfo(_info_map.at(middleware)());
+    return SystemHandleInfo(factory());
+}
+
+//==============================================================================
+bool Register::contains(
+        const std::string& middleware)
+{
+    std::mutex* mutex;
+    const FactoryMap& factories = info_map(mutex);
+    std::unique_lock<std::mutex> lock(*mutex);
+    return factories.find(middleware) != factories.end();
 }
 
 } //  namespace internal
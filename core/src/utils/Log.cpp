@@ -19,10 +19,410 @@
 
 #include <is/config.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+#include <vector>
+
 namespace eprosima {
 namespace is {
 namespace utils {
 
+namespace {
+
+class AsyncWriter;
+
+/**
+ * State shared by every Logger. It is created on first use and never destroyed,
+ * so that it is alive for the Loggers used during static initialization or destruction.
+ */
+struct Output
+{
+    /**
+     * Serializes the writes to stdout, so that messages are never interleaved.
+     */
+    std::mutex mutex;
+
+    /**
+     * The asynchronous writer exists while the asynchronous mode is enabled. It is
+     * replaced under the mutex, but loaded atomically by the loggers, which keep it
+     * alive until their message is pushed even if it is released meanwhile.
+     */
+    std::mutex asynchronous_mutex;
+    std::shared_ptr<AsyncWriter> asynchronous_writer;
+};
+
+//==============================================================================
+Output& output()
+{
+    static Output* const instance = new Output();
+    return *instance;
+}
+
+//==============================================================================
+void write_to_stdout(
+        const std::string& text)
+{
+    std::unique_lock<std::mutex> lock(output().mutex);
+    std::cout.write(text.data(), static_cast<std::streamsize>(text.size()));
+    std::cout.flush();
+}
+
+/**
+ * @class AsyncWriter
+ *        Bounded lock-free multi-producer ring buffer of finished messages,
+ *        drained by a background thread that writes them to stdout in batches.
+ *
+ *        Producers swap their message string with the empty one held by the slot,
+ *        so the buffers allocated by both sides are reused over and over.
+ */
+class AsyncWriter
+{
+public:
+
+    AsyncWriter(
+            std::size_t capacity)
+        : _mask(round_up(capacity) - 1)
+        , _slots(new Slot[_mask + 1])
+        , _enqueue_position(0)
+        , _dequeue_position(0)
+        , _sleeping(false)
+        , _stop(false)
+    {
+        for (std::size_t i = 0; i <= _mask; ++i)
+        {
+            _slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        _thread = std::thread(&AsyncWriter::work, this);
+    }
+
+    ~AsyncWriter()
+    {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stop = true;
+        }
+        _wake_up.notify_one();
+        _thread.join();
+    }
+
+    bool push(
+            std::string& text)
+    {
+        std::size_t position = _enqueue_position.load(std::memory_order_relaxed);
+        Slot* slot = nullptr;
+
+        while (true)
+        {
+            slot = &_slots[position & _mask];
+            const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            const std::ptrdiff_t difference =
+                    static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0)
+            {
+                if (_enqueue_position.compare_exchange_weak(
+                            position, position + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = _enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->text.swap(text);
+        slot->sequence.store(position + 1, std::memory_order_release);
+
+        if (_sleeping.load(std::memory_order_acquire))
+        {
+            _wake_up.notify_one();
+        }
+
+        return true;
+    }
+
+    void flush()
+    {
+        const std::size_t target = _enqueue_position.load(std::memory_order_acquire);
+        while (_written.load(std::memory_order_acquire) < target)
+        {
+            _wake_up.notify_one();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+private:
+
+    struct Slot
+    {
+        std::atomic<std::size_t> sequence;
+        std::string text;
+    };
+
+    static std::size_t round_up(
+            std::size_t capacity)
+    {
+        std::size_t size = 2;
+        while (size < capacity)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
+    bool drain(
+            std::string& batch)
+    {
+        bool drained = false;
+        while (true)
+        {
+            Slot& slot = _slots[_dequeue_position & _mask];
+            if (slot.sequence.load(std::memory_order_acquire) != _dequeue_position + 1)
+            {
+                break;
+            }
+
+            batch.append(slot.text);
+            slot.text.clear();
+            slot.sequence.store(_dequeue_position + _mask + 1, std::memory_order_release);
+            ++_dequeue_position;
+            drained = true;
+        }
+        return drained;
+    }
+
+    void work()
+    {
+        std::string batch;
+        while (true)
+        {
+            if (drain(batch))
+            {
+                write_to_stdout(batch);
+                batch.clear();
+                _written.store(_dequeue_position, std::memory_order_release);
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (_stop)
+            {
+                break;
+            }
+
+            // The timeout bounds the latency of a wake-up lost between the checks.
+            _sleeping.store(true, std::memory_order_release);
+            _wake_up.wait_for(lock, std::chrono::milliseconds(10));
+            _sleeping.store(false, std::memory_order_release);
+        }
+
+        if (drain(batch))
+        {
+            write_to_stdout(batch);
+            _written.store(_dequeue_position, std::memory_order_release);
+        }
+    }
+
+    const std::size_t _mask;
+    std::unique_ptr<Slot[]> _slots;
+    std::atomic<std::size_t> _enqueue_position;
+    std::size_t _dequeue_position;
+    std::atomic<std::size_t> _written{0};
+    std::atomic_bool _sleeping;
+    bool _stop;
+    std::mutex _mutex;
+    std::condition_variable _wake_up;
+    std::thread _thread;
+};
+
+/**
+ * Disables the asynchronous mode at exit, so that the pending messages are written.
+ */
+struct AsyncWriterGuard
+{
+    ~AsyncWriterGuard()
+    {
+        Logger::set_asynchronous(false);
+    }
+
+} asynchronous_writer_guard;
+
+/**
+ * @class RecordBuffer
+ *        Stream buffer that appends everything written into it to a string.
+ */
+class RecordBuffer : public std::streambuf
+{
+public:
+
+    RecordBuffer(
+            std::string& text)
+        : _text(text)
+    {
+    }
+
+protected:
+
+    int_type overflow(
+            int_type c) override
+    {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+        {
+            _text.push_back(traits_type::to_char_type(c));
+        }
+        return traits_type::not_eof(c);
+    }
+
+    std::streamsize xsputn(
+            const char* data,
+            std::streamsize size) override
+    {
+        _text.append(data, static_cast<std::size_t>(size));
+        return size;
+    }
+
+private:
+
+    std::string& _text;
+};
+
+} //  anonymous namespace
+
+//==============================================================================
+struct Logger::Record
+{
+    Record()
+        : owner(nullptr)
+        , status(CurrentLevelStatus::NON_SPECIFIED)
+        , buffer(text)
+        , stream(&buffer)
+    {
+    }
+
+    void finish()
+    {
+        const std::shared_ptr<AsyncWriter> writer = std::atomic_load(&output().asynchronous_writer);
+        if (writer && writer->push(text))
+        {
+            // The ring buffer gave back an empty string in exchange.
+            text.clear();
+            return;
+        }
+
+        write_to_stdout(text);
+        text.clear();
+    }
+
+    const Logger* owner;
+    CurrentLevelStatus status;
+    std::string text;
+    RecordBuffer buffer;
+    std::ostream stream;
+};
+
+//==============================================================================
+Logger::Record& Logger::record() const
+{
+    thread_local std::vector<std::unique_ptr<Record> > records;
+
+    Record* idle = nullptr;
+    for (const auto& record : records)
+    {
+        if (record->status == CurrentLevelStatus::NON_SPECIFIED)
+        {
+            if (nullptr == idle)
+            {
+                idle = record.get();
+            }
+        }
+        else if (record->owner == this)
+        {
+            return *record;
+        }
+    }
+
+    // Finished records can be reused by any Logger.
+    if (nullptr == idle)
+    {
+        records.emplace_back(new Record());
+        idle = records.back().get();
+    }
+
+    idle->owner = this;
+    return *idle;
+}
+
+//==============================================================================
+Logger::CurrentLevelStatus& Logger::status(
+        Record& record)
+{
+    return record.status;
+}
+
+//==============================================================================
+std::ostream& Logger::stream(
+        Record& record)
+{
+    return record.stream;
+}
+
+//==============================================================================
+void Logger::set_asynchronous(
+        bool asynchronous,
+        std::size_t capacity)
+{
+    Output& shared = output();
+    std::unique_lock<std::mutex> lock(shared.asynchronous_mutex);
+    if (asynchronous && !shared.asynchronous_writer)
+    {
+        std::atomic_store(&shared.asynchronous_writer, std::make_shared<AsyncWriter>(capacity));
+    }
+    else if (!asynchronous && shared.asynchronous_writer)
+    {
+        /**
+         * The messages pushed by loggers still holding the writer are written
+         * when the last of them releases it, since it drains them before stopping.
+         */
+        const std::shared_ptr<AsyncWriter> writer = shared.asynchronous_writer;
+        std::atomic_store(&shared.asynchronous_writer, std::shared_ptr<AsyncWriter>());
+        writer->flush();
+    }
+}
+
+//==============================================================================
+void Logger::flush()
+{
+    Output& shared = output();
+    std::unique_lock<std::mutex> lock(shared.asynchronous_mutex);
+    if (shared.asynchronous_writer)
+    {
+        shared.asynchronous_writer->flush();
+    }
+}
+
+#ifdef IS_LOG_ASYNC
+namespace {
+
+/**
+ * Enables the asynchronous mode by default, as requested by the `IS_LOG_ASYNC` CMake option.
+ */
+const bool asynchronous_by_default = (Logger::set_asynchronous(true), true);
+
+} //  anonymous namespace
+#endif //  IS_LOG_ASYNC
+
 //==============================================================================
 Logger::Logger(
         const std::string& header)
@@ -32,7 +432,6 @@ Logger::Logger(
 #else
     , _max_level(Level::INFO)     // TODO (@jamoralp): make this configurable by the user and by CMAKE_BUILD_TYPE flag
 #endif //  IS_COMPILE_DEBUG
-    , _status(CurrentLevelStatus::NON_SPECIFIED)
 {
 }
 
@@ -45,54 +444,57 @@ const Logger::Level& Logger::get_level() const
 Logger& Logger::operator <<(
         const Logger::Level& level)
 {
-    if (_max_level >= level)
+    Record& current = record();
+
+    if (enabled(level))
     {
+        std::ostream& out = current.stream;
         switch (level)
         {
             case Level::ERROR:
             {
-                std::cout << bold_on
-                          << red
-                          << "[Integration Service][ERROR] "
-                          << reset;
+                out << bold_on
+                    << red
+                    << "[Integration Service][ERROR] "
+                    << reset;
                 break;
             }
             case Level::WARN:
             {
-                std::cout << bold_on
-                          << yellow
-                          << "[Integration Service][WARN] "
-                          << reset;
+                out << bold_on
+                    << yellow
+                    << "[Integration Service][WARN] "
+                    << reset;
                 break;
             }
             case Level::INFO:
             {
-                std::cout << bold_on
-                          << "[Integration Service][INFO] "
-                          << reset;
+                out << bold_on
+                    << "[Integration Service][INFO] "
+                    << reset;
                 break;
             }
             case Level::DEBUG:
             {
-                std::cout << bold_on
-                          << green
-                          << "[Integration Service][DEBUG] "
-                          << reset;
+                out << bold_on
+                    << green
+                    << "[Integration Service][DEBUG] "
+                    << reset;
                 break;
             }
         }
 
         if (!_header.empty())
         {
-            std::cout << bold_on << "[" << _header << "]" << reset;
+            out << bold_on << "[" << _header << "]" << reset;
         }
 
-        std::cout << " ";
-        _status = CurrentLevelStatus::SPECIFIED;
+        out << " ";
+        current.status = CurrentLevelStatus::SPECIFIED;
     }
     else
     {
-        _status = CurrentLevelStatus::SPECIFIED_BUT_HIDDEN;
+        current.status = CurrentLevelStatus::SPECIFIED_BUT_HIDDEN;
     }
 
     return *this;
@@ -102,7 +504,8 @@ Logger& Logger::operator <<(
 Logger& Logger::operator <<(
         const char* message)
 {
-    switch (_status)
+    Record& current = record();
+    switch (current.status)
     {
         case CurrentLevelStatus::NON_SPECIFIED:
         {
@@ -113,7 +516,7 @@ Logger& Logger::operator <<(
         }
         case CurrentLevelStatus::SPECIFIED:
         {
-            std::cout << message;
+            current.stream << message;
             break;
         }
         case CurrentLevelStatus::SPECIFIED_BUT_HIDDEN:
@@ -139,7 +542,8 @@ Logger& Logger::operator <<(
         (*func)(
             std::basic_ostream<char, std::char_traits<char> >&))
 {
-    switch (_status)
+    Record& current = record();
+    switch (current.status)
     {
         case CurrentLevelStatus::NON_SPECIFIED:
         {
@@ -148,13 +552,14 @@ Logger& Logger::operator <<(
         }
         case CurrentLevelStatus::SPECIFIED:
         {
-            std::cout << reset;
-            std::cout << func;
+            current.stream << reset;
+            current.stream << func;
+            current.finish();
             [[fallthrough]];
         }
         case CurrentLevelStatus::SPECIFIED_BUT_HIDDEN:
         {
-            _status = CurrentLevelStatus::NON_SPECIFIED;
+            current.status = CurrentLevelStatus::NON_SPECIFIED;
             break;
         }
     }
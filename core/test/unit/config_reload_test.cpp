@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/Config.hpp>
+
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+
+namespace xtypes = eprosima::xtypes;
+namespace is = eprosima::is;
+using is::core::internal::Config;
+using is::core::internal::RouteChanges;
+using is::core::test::hello_type;
+using is::core::test::make_config;
+using is::core::test::make_info_map;
+
+TEST(ConfigReload, Unchanged_configurations_have_no_changes)
+{
+    const std::string topics =
+            "    chatter: { type: Hello, route: a_to_b }\n";
+    const Config running = make_config(topics);
+    const Config reloaded = make_config(topics);
+    ASSERT_TRUE(running);
+    ASSERT_TRUE(reloaded);
+
+    RouteChanges changes;
+    ASSERT_TRUE(reloaded.changes_from(running, make_info_map(hello_type(), "Hello"), changes));
+    ASSERT_TRUE(changes.empty());
+}
+
+TEST(ConfigReload, Added_removed_and_modified_topics_are_detected)
+{
+    const Config running = make_config(
+        "    kept: { type: Hello, route: a_to_b }\n"
+        "    removed: { type: Hello, route: a_to_b }\n"
+        "    modified: { type: Hello, route: a_to_b }\n");
+
+    const Config reloaded = make_config(
+        "    kept: { type: Hello, route: a_to_b }\n"
+        "    modified: { type: Hello, route: b_to_a }\n"
+        "    added: { type: Hello, route: b_to_a }\n");
+
+    ASSERT_TRUE(running);
+    ASSERT_TRUE(reloaded);
+
+    RouteChanges changes;
+    ASSERT_TRUE(reloaded.changes_from(running, make_info_map(hello_type(), "Hello"), changes));
+
+    /**
+     * Modified topics are taken down and configured again.
+     */
+    ASSERT_EQ(changes.removed_topics, std::set<std::string>({"removed", "modified"}));
+    ASSERT_EQ(changes.added_topics, std::set<std::string>({"added", "modified"}));
+    ASSERT_TRUE(changes.removed_services.empty());
+    ASSERT_TRUE(changes.added_services.empty());
+}
+
+TEST(ConfigReload, Types_named_with_a_leading_scope_are_found)
+{
+    const std::string topics =
+            "    chatter: { type: \"::Hello\", route: a_to_b }\n";
+    const Config running = make_config(topics);
+    const Config reloaded = make_config(topics);
+    ASSERT_TRUE(running);
+    ASSERT_TRUE(reloaded);
+
+    RouteChanges changes;
+    ASSERT_TRUE(reloaded.changes_from(running, make_info_map(hello_type(), "::Hello"), changes));
+    ASSERT_TRUE(changes.empty());
+
+    /**
+     * The definition given by the new configuration is compared with the known one,
+     * even though the topic names its type with the leading `::`.
+     */
+    xtypes::StructType changed("Hello");
+    changed.add_member("data", xtypes::primitive_type<uint32_t>());
+
+    RouteChanges rejected;
+    ASSERT_FALSE(reloaded.changes_from(running, make_info_map(changed, "::Hello"), rejected));
+}
+
+TEST(ConfigReload, Changed_systems_cannot_be_reloaded)
+{
+    const std::string topics =
+            "    chatter: { type: Hello, route: a_to_b }\n";
+    const Config running = make_config(topics);
+    const Config reloaded = make_config(topics, "    c: { type: mock }\n");
+
+    ASSERT_TRUE(running);
+
+    RouteChanges changes;
+    ASSERT_FALSE(reloaded.changes_from(running, make_info_map(hello_type(), "Hello"), changes));
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/ConversionPlan.hpp>
+
+#include <gtest/gtest.h>
+
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::core::ConversionCache;
+using eprosima::is::core::ConversionPlan;
+
+TEST(ConversionPlan, Equal_types_are_copied)
+{
+    xtypes::StructType type("Message");
+    type.add_member("value", xtypes::primitive_type<int32_t>());
+    type.add_member("text", xtypes::StringType());
+
+    auto plan = ConversionPlan::compile(type, type);
+    ASSERT_TRUE(plan);
+    ASSERT_EQ(plan->consistency(), xtypes::TypeConsistency::EQUALS);
+
+    xtypes::DynamicData message(type);
+    message["value"] = int32_t(42);
+    message["text"] = std::string("Hello");
+
+    xtypes::DynamicData result = plan->convert(message);
+    ASSERT_EQ(result["value"].value<int32_t>(), 42);
+    ASSERT_EQ(result["text"].value<std::string>(), "Hello");
+}
+
+TEST(ConversionPlan, Widening_truncation_and_dropped_members)
+{
+    xtypes::StructType source("Source");
+    source.add_member("value", xtypes::primitive_type<int16_t>());
+    source.add_member("text", xtypes::StringType());
+    source.add_member("numbers", xtypes::SequenceType(xtypes::primitive_type<uint8_t>()));
+    source.add_member("dropped", xtypes::primitive_type<double>());
+
+    xtypes::StructType target("Target");
+    target.add_member("value", xtypes::primitive_type<int64_t>());
+    target.add_member("text", xtypes::StringType(3));
+    target.add_member("numbers", xtypes::SequenceType(xtypes::primitive_type<uint32_t>(), 2));
+
+    auto plan = ConversionPlan::compile(source, target);
+    ASSERT_TRUE(plan);
+
+    xtypes::DynamicData message(source);
+    message["value"] = int16_t(-7);
+    message["text"] = std::string("Hello");
+    message["numbers"].push(uint8_t(1));
+    message["numbers"].push(uint8_t(2));
+    message["numbers"].push(uint8_t(3));
+    message["dropped"] = 3.14;
+
+    xtypes::DynamicData result = plan->convert(message);
+    ASSERT_EQ(result["value"].value<int64_t>(), -7);
+    ASSERT_EQ(result["text"].value<std::string>(), "Hel");
+    ASSERT_EQ(result["numbers"].size(), 2u);
+    ASSERT_EQ(result["numbers"][0].value<uint32_t>(), 1u);
+    ASSERT_EQ(result["numbers"][1].value<uint32_t>(), 2u);
+}
+
+TEST(ConversionPlan, Incompatible_types_produce_no_plan)
+{
+    xtypes::StructType source("Source");
+    source.add_member("text", xtypes::StringType());
+
+    xtypes::StructType target("Target");
+    target.add_member("value", xtypes::primitive_type<int32_t>());
+
+    ASSERT_FALSE(ConversionPlan::compile(source, target));
+}
+
+TEST(ConversionPlan, Projections_extract_the_listed_members)
+{
+    xtypes::StructType pose("Pose");
+    pose.add_member("x", xtypes::primitive_type<double>());
+    pose.add_member("y", xtypes::primitive_type<double>());
+
+    xtypes::StructType source("Source");
+    source.add_member("pose", pose);
+    source.add_member("payload", xtypes::SequenceType(xtypes::primitive_type<uint8_t>()));
+    source.add_member("id", xtypes::primitive_type<int16_t>());
+
+    xtypes::StructType target("Target");
+    target.add_member("id", xtypes::primitive_type<int32_t>());
+    target.add_member("x", xtypes::primitive_type<double>());
+
+    std::string error;
+    auto plan = ConversionPlan::project(source, target, {"id", "pose.x"}, error);
+    ASSERT_TRUE(plan) << error;
+
+    xtypes::DynamicData message(source);
+    message["pose"]["x"] = 1.5;
+    message["pose"]["y"] = 2.5;
+    message["payload"].push(uint8_t(1));
+    message["id"] = int16_t(7);
+
+    xtypes::DynamicData result = plan->convert(message);
+    ASSERT_EQ(result["id"].value<int32_t>(), 7);
+    ASSERT_EQ(result["x"].value<double>(), 1.5);
+
+    ASSERT_FALSE(ConversionPlan::project(source, target, {"id", "pose.z"}, error));
+    ASSERT_FALSE(error.empty());
+    ASSERT_FALSE(ConversionPlan::project(source, target, {"id"}, error));
+    ASSERT_FALSE(ConversionPlan::project(source, target, {"pose", "id"}, error));
+}
+
+TEST(ConversionCache, Pairs_of_types_are_checked_once)
+{
+    xtypes::StructType source("Source");
+    source.add_member("value", xtypes::primitive_type<int16_t>());
+
+    xtypes::StructType target("Target");
+    target.add_member("value", xtypes::primitive_type<int32_t>());
+
+    ConversionCache cache;
+
+    const ConversionCache::Entry equal = cache.get(source, source);
+    ASSERT_EQ(equal.consistency, xtypes::TypeConsistency::EQUALS);
+    ASSERT_FALSE(equal.plan);
+
+    const ConversionCache::Entry first = cache.get(source, target);
+    ASSERT_NE(first.consistency, xtypes::TypeConsistency::EQUALS);
+    ASSERT_TRUE(first.plan);
+
+    const ConversionCache::Entry second = cache.get(source, target);
+    ASSERT_EQ(first.plan, second.plan);
+    ASSERT_EQ(cache.size(), 2u);
+}
+
+TEST(ConversionCache, Conversions_check_the_target_against_the_source)
+{
+    xtypes::StructType request("Request");
+    request.add_member("value", xtypes::primitive_type<int32_t>());
+    request.add_member("extra", xtypes::StringType());
+
+    xtypes::StructType server_request("ServerRequest");
+    server_request.add_member("value", xtypes::primitive_type<int64_t>());
+
+    ConversionCache cache;
+
+    /**
+     * Converting a client request into the server type is checked as
+     * `server_type.is_compatible(client_type)`, which is the pair looked up
+     * by `consistency(server_type, client_type)`.
+     */
+    const ConversionCache::Entry conversion = cache.get(request, server_request);
+    ASSERT_EQ(conversion.consistency, server_request.is_compatible(request));
+    ASSERT_EQ(conversion.consistency, cache.consistency(server_request, request));
+    ASSERT_EQ(cache.consistency(request, server_request), request.is_compatible(server_request));
+}
+
+TEST(ConversionCache, Consistencies_are_precomputed_in_parallel)
+{
+    xtypes::StructType source("Source");
+    source.add_member("value", xtypes::primitive_type<int16_t>());
+
+    xtypes::StructType target("Target");
+    target.add_member("value", xtypes::primitive_type<int32_t>());
+
+    ConversionCache cache;
+
+    std::vector<ConversionCache::Key> pairs;
+    for (int i = 0; i < 100; ++i)
+    {
+        pairs.emplace_back(&source, &target);
+        pairs.emplace_back(&target, &source);
+        pairs.emplace_back(&source, &source);
+    }
+
+    cache.precompute(pairs, 4);
+
+    ASSERT_EQ(cache.consistency(source, target), source.is_compatible(target));
+    ASSERT_EQ(cache.consistency(target, source), target.is_compatible(source));
+    ASSERT_EQ(cache.consistency(source, source), xtypes::TypeConsistency::EQUALS);
+
+    // Only compiled conversions are counted.
+    ASSERT_EQ(cache.size(), 0u);
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/utils/Convert.hpp>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <vector>
+
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::utils::Convert;
+
+namespace {
+
+template<typename Type>
+class ContainerConvert : public testing::Test
+{
+};
+
+using Primitives = testing::Types<
+    bool, char, int8_t, uint8_t, int16_t, uint16_t, int32_t, uint32_t,
+    int64_t, uint64_t, float, double>;
+
+/**
+ * Values that differ from one element to the next, for every primitive type.
+ */
+template<typename Type>
+Type element(
+        std::size_t i)
+{
+    return static_cast<Type>(i * 3 + 1);
+}
+
+} //  anonymous namespace
+
+TYPED_TEST_SUITE(ContainerConvert, Primitives);
+
+TYPED_TEST(ContainerConvert, Sequences_round_trip)
+{
+    const xtypes::SequenceType type(xtypes::primitive_type<TypeParam>());
+
+    std::vector<TypeParam> native;
+    for (std::size_t i = 0; i < 5; ++i)
+    {
+        native.push_back(element<TypeParam>(i));
+    }
+
+    xtypes::DynamicData data(type);
+    Convert<std::vector<TypeParam> >::to_xtype_field(native, data);
+    ASSERT_EQ(data.size(), native.size());
+    for (std::size_t i = 0; i < native.size(); ++i)
+    {
+        ASSERT_EQ(data[i].value<TypeParam>(), element<TypeParam>(i));
+    }
+
+    std::vector<TypeParam> converted;
+    Convert<std::vector<TypeParam> >::from_xtype_field(data, converted);
+    ASSERT_EQ(converted, native);
+}
+
+TYPED_TEST(ContainerConvert, Empty_sequences_round_trip)
+{
+    const xtypes::SequenceType type(xtypes::primitive_type<TypeParam>());
+
+    xtypes::DynamicData data(type);
+    Convert<std::vector<TypeParam> >::to_xtype_field(std::vector<TypeParam>(), data);
+    ASSERT_EQ(data.size(), 0u);
+
+    std::vector<TypeParam> converted(3, element<TypeParam>(0));
+    Convert<std::vector<TypeParam> >::from_xtype_field(data, converted);
+    ASSERT_TRUE(converted.empty());
+}
+
+TYPED_TEST(ContainerConvert, Arrays_round_trip)
+{
+    const xtypes::ArrayType type(xtypes::primitive_type<TypeParam>(), 4);
+
+    std::array<TypeParam, 4> native;
+    for (std::size_t i = 0; i < native.size(); ++i)
+    {
+        native[i] = element<TypeParam>(i);
+    }
+
+    xtypes::DynamicData data(type);
+    Convert<std::array<TypeParam, 4> >::to_xtype_field(native, data);
+    for (std::size_t i = 0; i < native.size(); ++i)
+    {
+        ASSERT_EQ(data[i].value<TypeParam>(), element<TypeParam>(i));
+    }
+
+    std::array<TypeParam, 4> converted{};
+    Convert<std::array<TypeParam, 4> >::from_xtype_field(data, converted);
+    ASSERT_EQ(converted, native);
+}
+
+TEST(BulkCopy, Only_collections_of_the_native_element_type_match)
+{
+    /**
+     * The layouts differ, so the containers of int32_t convert the elements one by one.
+     */
+    xtypes::DynamicData data(xtypes::SequenceType(xtypes::primitive_type<int64_t>()));
+    data.push(int64_t(-1));
+    data.push(int64_t(2));
+
+    ASSERT_FALSE(eprosima::is::utils::BulkCopy<int32_t>::matches(data, data.size()));
+    ASSERT_TRUE(eprosima::is::utils::BulkCopy<int64_t>::matches(data, data.size()));
+}
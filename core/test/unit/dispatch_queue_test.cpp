@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/DispatchQueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::core::DispatchQueue;
+using PushResult = DispatchQueue::PushResult;
+
+namespace {
+
+using Message = std::shared_ptr<const xtypes::DynamicData>;
+
+/**
+ * Consumer that holds the worker thread of the queue until it is released,
+ * and keeps the delivered messages.
+ */
+struct Gate
+{
+    DispatchQueue::Consumer consumer()
+    {
+        return [this](const Message& message)
+               {
+                   std::unique_lock<std::mutex> lock(mutex);
+                   changed.wait(lock, [this]()
+                   {
+                       return released;
+                   });
+                   delivered.push_back(message);
+                   changed.notify_all();
+               };
+    }
+
+    void release()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        released = true;
+        changed.notify_all();
+    }
+
+    std::vector<Message> wait_for(
+            std::size_t count)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this, count]()
+                {
+                    return delivered.size() >= count;
+                });
+        return delivered;
+    }
+
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool released = false;
+    std::vector<Message> delivered;
+};
+
+std::vector<Message> make_messages(
+        std::size_t count)
+{
+    xtypes::StructType type("Message");
+    type.add_member("index", xtypes::primitive_type<uint32_t>());
+
+    std::vector<Message> messages;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto message = std::make_shared<xtypes::DynamicData>(type);
+        (*message)["index"] = static_cast<uint32_t>(i);
+        messages.push_back(std::move(message));
+    }
+    return messages;
+}
+
+/**
+ * Pushes a message that the worker thread takes and holds at the gate,
+ * so that the following ones stay queued.
+ */
+void occupy(
+        DispatchQueue& queue,
+        const Message& message)
+{
+    ASSERT_EQ(queue.push(message), PushResult::QUEUED);
+    while (queue.size() > 0)
+    {
+        std::this_thread::yield();
+    }
+}
+
+} //  anonymous namespace
+
+TEST(DispatchQueue, Messages_are_delivered_in_order)
+{
+    Gate gate;
+    DispatchQueue queue("test", 10, DispatchQueue::Policy::DROP_OLDEST, gate.consumer());
+
+    const std::vector<Message> messages = make_messages(5);
+    occupy(queue, messages[0]);
+    for (std::size_t i = 1; i < messages.size(); ++i)
+    {
+        ASSERT_EQ(queue.push(messages[i]), PushResult::QUEUED);
+    }
+    ASSERT_EQ(queue.size(), 4u);
+    ASSERT_GT(queue.bytes(), 0u);
+
+    gate.release();
+    ASSERT_EQ(gate.wait_for(messages.size()), messages);
+    ASSERT_EQ(queue.dropped(), 0u);
+}
+
+TEST(DispatchQueue, Full_queues_drop_the_oldest_message)
+{
+    Gate gate;
+    DispatchQueue queue("test", 2, DispatchQueue::Policy::DROP_OLDEST, gate.consumer());
+
+    const std::vector<Message> messages = make_messages(4);
+    occupy(queue, messages[0]);
+    ASSERT_EQ(queue.push(messages[1]), PushResult::QUEUED);
+    ASSERT_EQ(queue.push(messages[2]), PushResult::QUEUED);
+    ASSERT_EQ(queue.push(messages[3]), PushResult::EVICTED);
+    ASSERT_EQ(queue.size(), 2u);
+    ASSERT_EQ(queue.dropped(), 1u);
+
+    gate.release();
+    ASSERT_EQ(gate.wait_for(3), (std::vector<Message>{messages[0], messages[2], messages[3]}));
+}
+
+TEST(DispatchQueue, Full_queues_drop_the_newest_message)
+{
+    Gate gate;
+    DispatchQueue queue("test", 2, DispatchQueue::Policy::DROP_NEWEST, gate.consumer());
+
+    const std::vector<Message> messages = make_messages(4);
+    occupy(queue, messages[0]);
+    ASSERT_EQ(queue.push(messages[1]), PushResult::QUEUED);
+    ASSERT_EQ(queue.push(messages[2]), PushResult::QUEUED);
+    ASSERT_EQ(queue.push(messages[3]), PushResult::DROPPED);
+    ASSERT_EQ(queue.dropped(), 1u);
+
+    gate.release();
+    ASSERT_EQ(gate.wait_for(3), (std::vector<Message>{messages[0], messages[1], messages[2]}));
+}
+
+TEST(DispatchQueue, Full_queues_block_until_there_is_room)
+{
+    Gate gate;
+    DispatchQueue queue("test", 1, DispatchQueue::Policy::BLOCK, gate.consumer());
+
+    const std::vector<Message> messages = make_messages(3);
+    occupy(queue, messages[0]);
+    ASSERT_EQ(queue.push(messages[1]), PushResult::QUEUED);
+
+    PushResult pushed = PushResult::DROPPED;
+    std::thread pusher([&]()
+            {
+                pushed = queue.push(messages[2]);
+            });
+
+    gate.release();
+    pusher.join();
+    ASSERT_EQ(pushed, PushResult::QUEUED);
+    ASSERT_EQ(gate.wait_for(3), messages);
+    ASSERT_EQ(queue.dropped(), 0u);
+}
+
+TEST(DispatchQueue, Failed_deliveries_do_not_stop_the_worker)
+{
+    Gate gate;
+    const DispatchQueue::Consumer deliver = gate.consumer();
+    DispatchQueue queue("test", 10, DispatchQueue::Policy::DROP_OLDEST,
+            [&deliver](const Message& message)
+            {
+                if (!message)
+                {
+                    throw std::runtime_error("no message");
+                }
+                deliver(message);
+            });
+
+    const std::vector<Message> messages = make_messages(1);
+    gate.release();
+    ASSERT_EQ(queue.push(nullptr), PushResult::QUEUED);
+    ASSERT_EQ(queue.push(messages[0]), PushResult::QUEUED);
+    ASSERT_EQ(gate.wait_for(1), messages);
+}
+
+TEST(DispatchQueue, Policy_names_are_parsed)
+{
+    DispatchQueue::Policy policy = DispatchQueue::Policy::BLOCK;
+    ASSERT_TRUE(DispatchQueue::parse_policy("drop_oldest", policy));
+    ASSERT_EQ(policy, DispatchQueue::Policy::DROP_OLDEST);
+    ASSERT_TRUE(DispatchQueue::parse_policy("drop_newest", policy));
+    ASSERT_EQ(policy, DispatchQueue::Policy::DROP_NEWEST);
+    ASSERT_TRUE(DispatchQueue::parse_policy("block", policy));
+    ASSERT_EQ(policy, DispatchQueue::Policy::BLOCK);
+    ASSERT_FALSE(DispatchQueue::parse_policy("drop", policy));
+    ASSERT_EQ(policy, DispatchQueue::Policy::BLOCK);
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/DynamicDataPool.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::core::DynamicDataPool;
+
+namespace {
+
+std::atomic<uint64_t> allocations(0);
+
+} //  anonymous namespace
+
+/**
+ * Counts the allocations of the test program, to check those made while borrowing instances.
+ */
+void* operator new(
+        std::size_t size)
+{
+    ++allocations;
+    if (void* memory = std::malloc(size != 0 ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(
+        void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(
+        void* memory,
+        std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+TEST(DynamicDataPool, Released_instances_are_reused)
+{
+    xtypes::StructType type("Message");
+    type.add_member("value", xtypes::primitive_type<int32_t>());
+
+    DynamicDataPool pool(type, 1);
+    const xtypes::DynamicData* first = nullptr;
+    {
+        std::shared_ptr<xtypes::DynamicData> data = pool.acquire();
+        (*data)["value"] = int32_t(7);
+        first = data.get();
+
+        std::shared_ptr<xtypes::DynamicData> other = pool.acquire();
+        ASSERT_NE(other.get(), first);
+    }
+
+    ASSERT_EQ(pool.created(), 2u);
+    ASSERT_EQ(pool.idle(), 1u);
+
+    std::shared_ptr<xtypes::DynamicData> data = pool.acquire();
+    ASSERT_EQ(pool.created(), 2u);
+    ASSERT_EQ(pool.idle(), 0u);
+}
+
+TEST(DynamicDataPool, Sequences_are_reset_when_released)
+{
+    xtypes::StructType type("Message");
+    type.add_member("values", xtypes::SequenceType(xtypes::primitive_type<int32_t>()));
+
+    DynamicDataPool pool(type);
+    {
+        std::shared_ptr<xtypes::DynamicData> data = pool.acquire();
+        (*data)["values"].push(int32_t(1));
+        (*data)["values"].push(int32_t(2));
+    }
+
+    std::shared_ptr<xtypes::DynamicData> data = pool.acquire();
+    ASSERT_EQ(pool.created(), 1u);
+    ASSERT_EQ((*data)["values"].size(), 0u);
+}
+
+TEST(DynamicDataPool, Instances_outlive_their_pool)
+{
+    xtypes::StructType type("Message");
+    type.add_member("value", xtypes::primitive_type<int32_t>());
+
+    std::shared_ptr<xtypes::DynamicData> data;
+    {
+        DynamicDataPool pool(type);
+        data = pool.acquire();
+    }
+
+    (*data)["value"] = int32_t(3);
+    ASSERT_EQ((*data)["value"].value<int32_t>(), 3);
+}
+
+TEST(DynamicDataPool, Borrowing_reused_instances_does_not_allocate)
+{
+    xtypes::StructType type("Message");
+    type.add_member("value", xtypes::primitive_type<int32_t>());
+
+    DynamicDataPool pool(type, 2);
+    {
+        std::shared_ptr<xtypes::DynamicData> first = pool.acquire();
+        std::shared_ptr<xtypes::DynamicData> second = pool.acquire();
+    }
+
+    const uint64_t before = allocations;
+    for (int32_t i = 0; i < 100; ++i)
+    {
+        std::shared_ptr<xtypes::DynamicData> first = pool.acquire();
+        std::shared_ptr<xtypes::DynamicData> second = first;
+        (*second)["value"] = i;
+    }
+
+    ASSERT_EQ(allocations - before, 0u);
+    ASSERT_EQ(pool.created(), 2u);
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/FieldToString.hpp>
+#include <is/core/runtime/StringTemplate.hpp>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::core::FieldToString;
+using eprosima::is::core::StringTemplate;
+using eprosima::is::core::UnknownFieldToStringCast;
+
+TEST(FieldToString, Numbers_are_formatted_as_with_to_string)
+{
+    xtypes::StructType type("Message");
+    type.add_member("flag", xtypes::primitive_type<bool>());
+    type.add_member("letter", xtypes::primitive_type<char>());
+    type.add_member("small", xtypes::primitive_type<int8_t>());
+    type.add_member("big", xtypes::primitive_type<int64_t>());
+    type.add_member("unsigned", xtypes::primitive_type<uint64_t>());
+    type.add_member("single", xtypes::primitive_type<float>());
+    type.add_member("double", xtypes::primitive_type<double>());
+
+    xtypes::DynamicData message(type);
+    message["flag"] = true;
+    message["letter"] = 'a';
+    message["small"] = int8_t(-7);
+    message["big"] = std::numeric_limits<int64_t>::min();
+    message["unsigned"] = std::numeric_limits<uint64_t>::max();
+    message["single"] = 0.1f;
+    message["double"] = -std::numeric_limits<double>::max();
+
+    const FieldToString converter("test");
+    ASSERT_EQ(converter.to_string(message["flag"], "flag"), std::to_string(true));
+    ASSERT_EQ(converter.to_string(message["letter"], "letter"), std::to_string('a'));
+    ASSERT_EQ(converter.to_string(message["small"], "small"), std::to_string(int8_t(-7)));
+    ASSERT_EQ(converter.to_string(message["big"], "big"), std::to_string(std::numeric_limits<int64_t>::min()));
+    ASSERT_EQ(converter.to_string(message["unsigned"], "unsigned"),
+            std::to_string(std::numeric_limits<uint64_t>::max()));
+    ASSERT_EQ(converter.to_string(message["single"], "single"), std::to_string(0.1f));
+    ASSERT_EQ(converter.to_string(message["double"], "double"), std::to_string(-std::numeric_limits<double>::max()));
+}
+
+TEST(FieldToString, Append_reports_unsupported_types_without_throwing)
+{
+    xtypes::StructType type("Message");
+    type.add_member("text", xtypes::StringType());
+    type.add_member("numbers", xtypes::SequenceType(xtypes::primitive_type<int32_t>()));
+
+    xtypes::DynamicData message(type);
+    message["text"] = std::string("hello");
+
+    const FieldToString converter("test");
+    std::string output = "say ";
+    ASSERT_TRUE(converter.append(message["text"], output));
+    ASSERT_EQ(output, "say hello");
+
+    ASSERT_FALSE(converter.append(message["numbers"], output));
+    ASSERT_EQ(output, "say hello");
+    ASSERT_EQ(FieldToString::converter(type.member("numbers").type()), nullptr);
+    ASSERT_NE(FieldToString::converter(type.member("text").type()), nullptr);
+
+    ASSERT_THROW(converter.to_string(message["numbers"], "numbers"), UnknownFieldToStringCast);
+}
+
+TEST(FieldToString, Bound_and_unbound_templates_give_the_same_string)
+{
+    xtypes::StructType header("Header");
+    header.add_member("frame_id", xtypes::StringType());
+    header.add_member("stamp", xtypes::primitive_type<uint32_t>());
+
+    xtypes::StructType type("Message");
+    type.add_member("header", header);
+    type.add_member("value", xtypes::primitive_type<double>());
+    type.add_member("numbers", xtypes::SequenceType(xtypes::primitive_type<int32_t>()));
+
+    xtypes::DynamicData message(type);
+    message["header"]["frame_id"] = std::string("base");
+    message["header"]["stamp"] = uint32_t(12);
+    message["value"] = 2.5;
+
+    const StringTemplate unbound("{message.header.frame_id}/{message.header.stamp}/{message.value}", "test");
+    const StringTemplate bound("{message.header.frame_id}/{message.header.stamp}/{message.value}", "test", type);
+    ASSERT_EQ(unbound.compute_string(message), "base/12/2.500000");
+    ASSERT_EQ(bound.compute_string(message), "base/12/2.500000");
+
+    const StringTemplate unsupported("values/{message.numbers}", "test", type);
+    ASSERT_THROW(unsupported.compute_string(message), UnknownFieldToStringCast);
+}
+
+TEST(FieldToString, Unbound_templates_resolve_each_message_type)
+{
+    xtypes::StructType first("First");
+    first.add_member("name", xtypes::StringType());
+    first.add_member("id", xtypes::primitive_type<uint32_t>());
+
+    xtypes::StructType second("Second");
+    second.add_member("id", xtypes::primitive_type<uint32_t>());
+    second.add_member("name", xtypes::StringType());
+
+    xtypes::StructType other("Other");
+    other.add_member("name", xtypes::StringType());
+
+    xtypes::DynamicData first_message(first);
+    first_message["name"] = std::string("a");
+    first_message["id"] = uint32_t(1);
+
+    xtypes::DynamicData second_message(second);
+    second_message["id"] = uint32_t(2);
+    second_message["name"] = std::string("b");
+
+    /**
+     * The members are found in their own position for each type, as well as
+     * for the bound one, and types lacking them are still rejected.
+     */
+    const StringTemplate unbound("{message.name}_{message.id}", "test");
+    const StringTemplate bound("{message.name}_{message.id}", "test", first);
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        ASSERT_EQ(unbound.compute_string(first_message), "a_1");
+        ASSERT_EQ(unbound.compute_string(second_message), "b_2");
+        ASSERT_EQ(bound.compute_string(second_message), "b_2");
+        ASSERT_THROW(unbound.compute_string(xtypes::DynamicData(other)),
+            eprosima::is::core::UnavailableMessageField);
+    }
+
+    const StringTemplate copy(unbound);
+    ASSERT_EQ(copy.compute_string(second_message), "b_2");
+}
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/LazySubscription.hpp>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <vector>
+
+using eprosima::is::core::LazySubscription;
+
+TEST(LazySubscription, Sources_follow_the_listened_destinations)
+{
+    int subscribed = 0;
+    int unsubscribed = 0;
+
+    LazySubscription lazy("test");
+    LazySubscription::MatchCallback first = lazy.watch();
+    LazySubscription::MatchCallback second = lazy.watch();
+
+    lazy.add_source("source",
+            [&]()
+            {
+                ++subscribed;
+                return true;
+            },
+            [&]()
+            {
+                ++unsubscribed;
+                return true;
+            });
+
+    ASSERT_FALSE(lazy.active());
+    ASSERT_EQ(subscribed, 0);
+
+    first(1);
+    second(2);
+    first(3);
+    ASSERT_TRUE(lazy.active());
+    ASSERT_EQ(subscribed, 1);
+
+    first(0);
+    ASSERT_TRUE(lazy.active());
+    ASSERT_EQ(unsubscribed, 0);
+
+    second(0);
+    ASSERT_FALSE(lazy.active());
+    ASSERT_EQ(unsubscribed, 1);
+
+    second(1);
+    ASSERT_EQ(subscribed, 2);
+}
+
+TEST(LazySubscription, Late_sources_and_unsupported_unsubscriptions)
+{
+    int subscribed = 0;
+
+    LazySubscription::MatchCallback match;
+    {
+        LazySubscription lazy("test");
+        match = lazy.watch();
+        match(1);
+
+        lazy.add_source("source",
+                [&]()
+                {
+                    ++subscribed;
+                    return true;
+                },
+                []()
+                {
+                    return false;
+                });
+
+        ASSERT_EQ(subscribed, 1);
+
+        match(0);
+        ASSERT_FALSE(lazy.active());
+
+        // The subscription was kept, so it is not made again.
+        match(1);
+        ASSERT_EQ(subscribed, 1);
+    }
+
+    // Callbacks outliving the route are ignored.
+    match(0);
+}
+
+TEST(LazySubscription, Transitions_are_applied_by_the_scheduler)
+{
+    int subscribed = 0;
+    int unsubscribed = 0;
+    std::vector<std::function<void ()> > tasks;
+
+    LazySubscription lazy("test", [&tasks](std::function<void ()> task, std::chrono::steady_clock::duration)
+            {
+                tasks.push_back(std::move(task));
+            });
+    LazySubscription::MatchCallback match = lazy.watch();
+
+    lazy.add_source("source",
+            [&]()
+            {
+                ++subscribed;
+                return true;
+            },
+            [&]()
+            {
+                ++unsubscribed;
+                return true;
+            });
+
+    match(1);
+    ASSERT_TRUE(lazy.active());
+    ASSERT_EQ(subscribed, 0);
+    ASSERT_EQ(tasks.size(), 1u);
+
+    // Each task brings the sources to the latest state, whatever transition scheduled it.
+    match(0);
+    ASSERT_EQ(tasks.size(), 2u);
+    tasks[0]();
+    tasks[1]();
+    ASSERT_EQ(subscribed, 0);
+    ASSERT_EQ(unsubscribed, 0);
+
+    match(1);
+    tasks[2]();
+    ASSERT_EQ(subscribed, 1);
+
+    /**
+     * Cancelled routes unsubscribe right away, and ignore the matches from then on.
+     */
+    ASSERT_TRUE(lazy.cancel());
+    ASSERT_FALSE(lazy.active());
+    ASSERT_EQ(unsubscribed, 1);
+
+    match(0);
+    match(1);
+    ASSERT_EQ(tasks.size(), 3u);
+    ASSERT_FALSE(lazy.active());
+}
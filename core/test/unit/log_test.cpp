@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/utils/Log.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using eprosima::is::utils::Logger;
+
+TEST(Logger, Asynchronous_writer_can_be_released_while_logging)
+{
+    constexpr std::size_t threads = 4;
+    constexpr std::size_t messages = 200;
+
+    Logger::set_asynchronous(true, 16);
+
+    std::atomic_bool logging(true);
+    std::vector<std::thread> loggers;
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        loggers.emplace_back([t, &logging]()
+                {
+                    Logger logger("is::core::test::Logger");
+                    for (std::size_t i = 0; i < messages; ++i)
+                    {
+                        logger << Logger::Level::INFO
+                               << "thread " << t << ", message " << i << std::endl;
+                    }
+                    logging = false;
+                });
+    }
+
+    /**
+     * Releasing the writer is what happens when the process exits, while
+     * other threads may still be logging.
+     */
+    while (logging)
+    {
+        Logger::set_asynchronous(false);
+        Logger::set_asynchronous(true, 16);
+    }
+
+    for (std::thread& logger : loggers)
+    {
+        logger.join();
+    }
+
+    Logger::set_asynchronous(false);
+    Logger::flush();
+}
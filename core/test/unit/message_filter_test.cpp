@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/MessageFilter.hpp>
+
+#include <gtest/gtest.h>
+
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::core::MessageFilter;
+
+namespace {
+
+xtypes::StructType message_type()
+{
+    xtypes::StructType sensor("Sensor");
+    sensor.add_member("temperature", xtypes::primitive_type<double>());
+    sensor.add_member("readings", xtypes::SequenceType(xtypes::primitive_type<int32_t>()));
+
+    xtypes::StructType type("Message");
+    type.add_member("index", xtypes::primitive_type<uint32_t>());
+    type.add_member("status", xtypes::StringType());
+    type.add_member("valid", xtypes::primitive_type<bool>());
+    type.add_member("sensor", sensor);
+    return type;
+}
+
+} //  anonymous namespace
+
+TEST(MessageFilter, Comparisons_and_ranges)
+{
+    xtypes::StructType type = message_type();
+    xtypes::DynamicData message(type);
+    message["index"] = uint32_t(20);
+    message["status"] = std::string("FAULT");
+    message["valid"] = true;
+    message["sensor"]["temperature"] = 41.0;
+
+    auto filter = MessageFilter::compile(
+        "sensor.temperature > 40.5 && status == 'FAULT' && index in [10, 30] && valid", type);
+    ASSERT_TRUE(filter);
+    ASSERT_TRUE(filter->matches(message));
+
+    message["sensor"]["temperature"] = 40.0;
+    ASSERT_FALSE(filter->matches(message));
+
+    filter = MessageFilter::compile("!(status != \"FAULT\") || index < 0", type);
+    ASSERT_TRUE(filter);
+    ASSERT_TRUE(filter->matches(message));
+}
+
+TEST(MessageFilter, Modulo_sampling_and_elements)
+{
+    xtypes::StructType type = message_type();
+    xtypes::DynamicData message(type);
+
+    auto filter = MessageFilter::compile("index % 4 == 1", type);
+    ASSERT_TRUE(filter);
+    std::size_t matched = 0;
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        message["index"] = i;
+        matched += filter->matches(message);
+    }
+    ASSERT_EQ(matched, 5u);
+
+    filter = MessageFilter::compile("sample(3)", type);
+    ASSERT_TRUE(filter);
+    matched = 0;
+    for (int i = 0; i < 9; ++i)
+    {
+        matched += filter->matches(message);
+    }
+    ASSERT_EQ(matched, 3u);
+
+    /**
+     * Elements beyond the end of a sequence never match.
+     */
+    filter = MessageFilter::compile("sensor.readings[1] >= 7", type);
+    ASSERT_TRUE(filter);
+    ASSERT_FALSE(filter->matches(message));
+    message["sensor"]["readings"].push(int32_t(3));
+    message["sensor"]["readings"].push(int32_t(7));
+    ASSERT_TRUE(filter->matches(message));
+}
+
+TEST(MessageFilter, Invalid_expressions_are_rejected)
+{
+    xtypes::StructType type = message_type();
+
+    ASSERT_FALSE(MessageFilter::compile("unknown == 1", type));
+    ASSERT_FALSE(MessageFilter::compile("sensor > 1", type));
+    ASSERT_FALSE(MessageFilter::compile("status in [1, 2]", type));
+    ASSERT_FALSE(MessageFilter::compile("status == 3", type));
+    ASSERT_FALSE(MessageFilter::compile("sensor.temperature % 2 == 0", type));
+    ASSERT_FALSE(MessageFilter::compile("index == 1 &&", type));
+    ASSERT_FALSE(MessageFilter::compile("(index == 1", type));
+}
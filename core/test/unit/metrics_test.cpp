@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/Metrics.hpp>
+#include <is/core/runtime/MetricsExporter.hpp>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+using eprosima::is::core::LatencyHistogram;
+using eprosima::is::core::MetricsExporter;
+using eprosima::is::core::MetricsRegistry;
+using eprosima::is::core::RouteMetricsSnapshot;
+
+TEST(Metrics, Histogram_quantiles)
+{
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i)
+    {
+        histogram.record(3us);
+    }
+    histogram.record(5ms);
+
+    const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+    ASSERT_EQ(snapshot.count, 100u);
+    ASSERT_EQ(snapshot.max_ns, 5000000u);
+    ASSERT_EQ(snapshot.quantile_ns(0.5), 4000u);
+    ASSERT_EQ(snapshot.quantile_ns(0.999), 5000000u);
+    ASSERT_EQ(snapshot.mean_ns(), (99u * 3000u + 5000000u) / 100u);
+}
+
+TEST(Metrics, Histogram_buckets)
+{
+    LatencyHistogram histogram;
+    histogram.record(0us);
+    histogram.record(999ns);
+    histogram.record(1us);
+    histogram.record(2us);
+    histogram.record(3us);
+    histogram.record(4us);
+    histogram.record(std::chrono::hours(24 * 365));
+
+    /**
+     * Bucket `i` holds the durations below 2^i microseconds.
+     */
+    const LatencyHistogram::Snapshot snapshot = histogram.snapshot();
+    ASSERT_EQ(snapshot.buckets[0], 2u);
+    ASSERT_EQ(snapshot.buckets[1], 1u);
+    ASSERT_EQ(snapshot.buckets[2], 2u);
+    ASSERT_EQ(snapshot.buckets[3], 1u);
+    ASSERT_EQ(snapshot.buckets[LatencyHistogram::BUCKETS - 1], 1u);
+    ASSERT_EQ(snapshot.count, 7u);
+}
+
+TEST(Metrics, Route_counters)
+{
+    MetricsRegistry registry;
+    auto route = registry.add("topic", "chatter", "ros2_to_dds", "ros2", "dds");
+
+    route->received();
+    route->received();
+    route->converted();
+    route->dropped();
+    route->sent(true, 10us);
+    route->sent(false, 10us);
+
+    const auto snapshots = registry.snapshot();
+    ASSERT_EQ(snapshots.size(), 1u);
+    ASSERT_EQ(snapshots[0].name, "chatter");
+    ASSERT_EQ(snapshots[0].messages_in, 2u);
+    ASSERT_EQ(snapshots[0].messages_out, 1u);
+    ASSERT_EQ(snapshots[0].conversions, 1u);
+    ASSERT_EQ(snapshots[0].drops, 1u);
+    ASSERT_EQ(snapshots[0].failures, 1u);
+    ASSERT_EQ(snapshots[0].publish_time.count, 2u);
+    ASSERT_EQ(snapshots[0].round_trip_time.count, 0u);
+}
+
+TEST(Metrics, Removed_routes)
+{
+    MetricsRegistry registry;
+    registry.add("topic", "chatter", "ros2_to_dds", "ros2", "dds");
+    registry.add("topic", "chatter", "ros2_to_dds", "ros2", "websocket");
+    registry.add("service", "chatter", "add_server", "ros2", "dds");
+    registry.add("topic", "status", "ros2_to_dds", "ros2", "dds");
+
+    registry.remove("topic", "chatter");
+
+    const auto snapshots = registry.snapshot();
+    ASSERT_EQ(snapshots.size(), 2u);
+    ASSERT_EQ(snapshots[0].kind, "service");
+    ASSERT_EQ(snapshots[1].name, "status");
+}
+
+TEST(Metrics, Memory_probes)
+{
+    MetricsRegistry registry;
+    auto topic = registry.add("topic", "chatter", "ros2_to_dds", "ros2", "dds");
+
+    std::size_t queued = 3;
+    topic->add_memory_probe([&queued](RouteMetricsSnapshot& snapshot)
+            {
+                snapshot.queued_messages += queued;
+                snapshot.queued_bytes += queued * 100;
+            });
+    topic->add_memory_probe([](RouteMetricsSnapshot& snapshot)
+            {
+                snapshot.queued_messages += 1;
+                snapshot.retained_bytes += 64;
+            });
+
+    auto snapshots = registry.snapshot();
+    ASSERT_EQ(snapshots[0].queued_messages, 4u);
+    ASSERT_EQ(snapshots[0].queued_bytes, 300u);
+    ASSERT_EQ(snapshots[0].retained_bytes, 64u);
+
+    // Probes are evaluated on every snapshot.
+    queued = 0;
+    snapshots = registry.snapshot();
+    ASSERT_EQ(snapshots[0].queued_messages, 1u);
+    ASSERT_EQ(snapshots[0].queued_bytes, 0u);
+
+    registry.set_type_registry("ros2", 2, 512);
+    registry.set_type_registry("dds", 1, 128);
+    registry.set_type_registry("ros2", 3, 768);
+
+    const auto registries = registry.type_registries();
+    ASSERT_EQ(registries.size(), 2u);
+    ASSERT_EQ(registries[0].system, "ros2");
+    ASSERT_EQ(registries[0].types, 3u);
+    ASSERT_EQ(registries[0].bytes, 768u);
+    ASSERT_EQ(registries[1].system, "dds");
+
+    const std::string text = MetricsExporter::format(snapshots);
+    ASSERT_NE(text.find("# TYPE is_route_queued_messages gauge\n"), std::string::npos);
+    ASSERT_NE(text.find("is_route_retained_bytes{kind=\"topic\",route=\"ros2_to_dds\","
+            "topic=\"chatter\",source=\"ros2\",destination=\"dds\"} 64\n"), std::string::npos);
+}
+
+TEST(Metrics, Prometheus_format)
+{
+    MetricsRegistry registry;
+    auto topic = registry.add("topic", "chatter", "ros2_to_dds", "ros2", "dds");
+    auto service = registry.add("service", "add_two_ints", "add_server", "ros2", "dds");
+
+    topic->received();
+    topic->sent(true, 3us);
+    service->replied(2ms);
+
+    const std::string text = MetricsExporter::format(registry.snapshot());
+
+    ASSERT_NE(text.find("# TYPE is_route_messages_received_total counter\n"), std::string::npos);
+    ASSERT_NE(text.find("is_route_messages_received_total{kind=\"topic\",route=\"ros2_to_dds\","
+            "topic=\"chatter\",source=\"ros2\",destination=\"dds\"} 1\n"), std::string::npos);
+    ASSERT_NE(text.find("is_route_publish_seconds_bucket{kind=\"topic\",route=\"ros2_to_dds\","
+            "topic=\"chatter\",source=\"ros2\",destination=\"dds\",le=\"+Inf\"} 1\n"), std::string::npos);
+    ASSERT_NE(text.find("is_route_round_trip_seconds_count{kind=\"service\",route=\"add_server\","
+            "service=\"add_two_ints\",source=\"ros2\",destination=\"dds\"} 1\n"), std::string::npos);
+    ASSERT_EQ(text.find("is_route_round_trip_seconds_count{kind=\"topic\""), std::string::npos);
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/PendingCalls.hpp>
+
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace std::chrono_literals;
+using eprosima::is::core::PendingCalls;
+using eprosima::is::core::test::CountingClient;
+
+TEST(PendingCalls, Replied_calls_are_taken_once)
+{
+    CountingClient client;
+    PendingCalls calls("test", 0ns, 0);
+
+    auto handle = std::make_shared<int>(7);
+    const std::shared_ptr<void> token = calls.add(client, handle);
+    ASSERT_TRUE(token);
+    ASSERT_EQ(calls.size(), 1u);
+
+    PendingCalls::Call call;
+    ASSERT_TRUE(calls.take(token, call));
+    ASSERT_EQ(call.client, &client);
+    ASSERT_EQ(call.handle, handle);
+
+    ASSERT_FALSE(calls.take(token, call));
+    ASSERT_EQ(calls.size(), 0u);
+}
+
+TEST(PendingCalls, Max_in_flight_rejects_calls)
+{
+    CountingClient client;
+    PendingCalls calls("test", 0ns, 2);
+
+    const std::shared_ptr<void> first = calls.add(client, nullptr);
+    ASSERT_TRUE(first);
+    ASSERT_TRUE(calls.add(client, nullptr));
+    ASSERT_FALSE(calls.add(client, nullptr));
+
+    PendingCalls::Call call;
+    ASSERT_TRUE(calls.take(first, call));
+    ASSERT_TRUE(calls.add(client, nullptr));
+}
+
+TEST(PendingCalls, Timed_out_calls_are_cancelled)
+{
+    CountingClient client;
+    std::atomic<int> timeouts{0};
+    PendingCalls calls("test", 20ms, 0, [&](const PendingCalls::Call&)
+            {
+                ++timeouts;
+            });
+
+    const std::shared_ptr<void> late = calls.add(client, nullptr);
+    calls.add(client, nullptr);
+
+    for (int i = 0; i < 100 && client.cancellations < 2; ++i)
+    {
+        std::this_thread::sleep_for(10ms);
+    }
+
+    ASSERT_EQ(client.cancellations, 2);
+    ASSERT_EQ(timeouts, 2);
+    ASSERT_EQ(calls.timeouts(), 2u);
+    ASSERT_EQ(calls.size(), 0u);
+
+    PendingCalls::Call call;
+    ASSERT_FALSE(calls.take(late, call));
+}
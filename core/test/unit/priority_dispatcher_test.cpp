@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/PriorityDispatcher.hpp>
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using eprosima::is::core::DispatchQueue;
+using eprosima::is::core::PriorityDispatcher;
+using PushResult = DispatchQueue::PushResult;
+
+TEST(PriorityDispatcher, Higher_priority_lanes_are_served_first)
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool released = false;
+    std::vector<int> delivered;
+
+    PriorityDispatcher dispatcher("test");
+
+    auto consumer = [&](int lane)
+            {
+                return [&, lane](const std::shared_ptr<const eprosima::xtypes::DynamicData>&)
+                       {
+                           std::unique_lock<std::mutex> lock(mutex);
+                           changed.wait(lock, [&]()
+                           {
+                               return released;
+                           });
+                           delivered.push_back(lane);
+                           changed.notify_all();
+                       };
+            };
+
+    const std::size_t bulk = dispatcher.add_lane(0, 10, DispatchQueue::Policy::DROP_OLDEST, consumer(0));
+    const std::size_t control = dispatcher.add_lane(10, 10, DispatchQueue::Policy::DROP_OLDEST, consumer(10));
+
+    // The first bulk message keeps the worker busy while the rest are queued.
+    ASSERT_EQ(dispatcher.push(bulk, nullptr), PushResult::QUEUED);
+    while (dispatcher.size() > 0)
+    {
+        std::this_thread::yield();
+    }
+
+    ASSERT_EQ(dispatcher.push(bulk, nullptr), PushResult::QUEUED);
+    ASSERT_EQ(dispatcher.push(bulk, nullptr), PushResult::QUEUED);
+    ASSERT_EQ(dispatcher.push(control, nullptr), PushResult::QUEUED);
+    ASSERT_EQ(dispatcher.push(control, nullptr), PushResult::QUEUED);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        released = true;
+        changed.notify_all();
+        changed.wait(lock, [&]()
+                {
+                    return delivered.size() == 5;
+                });
+    }
+
+    ASSERT_EQ(delivered, (std::vector<int>{0, 10, 10, 0, 0}));
+}
+
+TEST(PriorityDispatcher, Full_lanes_apply_their_policy)
+{
+    std::mutex mutex;
+    std::unique_lock<std::mutex> blocked(mutex);
+
+    PriorityDispatcher dispatcher("test");
+    const std::size_t lane = dispatcher.add_lane(1, 2, DispatchQueue::Policy::DROP_NEWEST,
+                    [&](const std::shared_ptr<const eprosima::xtypes::DynamicData>&)
+                    {
+                        std::unique_lock<std::mutex> lock(mutex);
+                    });
+
+    ASSERT_EQ(dispatcher.push(lane, nullptr), PushResult::QUEUED);
+    while (dispatcher.size() > 0)
+    {
+        std::this_thread::yield();
+    }
+
+    ASSERT_EQ(dispatcher.push(lane, nullptr), PushResult::QUEUED);
+    ASSERT_EQ(dispatcher.push(lane, nullptr), PushResult::QUEUED);
+    ASSERT_EQ(dispatcher.push(lane, nullptr), PushResult::DROPPED);
+    ASSERT_EQ(dispatcher.dropped(), 1u);
+
+    blocked.unlock();
+}
+
+TEST(PriorityDispatcher, Removed_lanes_discard_their_messages)
+{
+    std::mutex mutex;
+    std::condition_variable changed;
+    bool released = false;
+    std::vector<std::size_t> delivered;
+
+    PriorityDispatcher dispatcher("test");
+
+    auto consumer = [&](std::size_t lane)
+            {
+                return [&, lane](const std::shared_ptr<const eprosima::xtypes::DynamicData>&)
+                       {
+                           std::unique_lock<std::mutex> lock(mutex);
+                           changed.wait(lock, [&]()
+                           {
+                               return released;
+                           });
+                           delivered.push_back(lane);
+                           changed.notify_all();
+                       };
+            };
+
+    const std::size_t kept = dispatcher.add_lane(0, 10, DispatchQueue::Policy::DROP_OLDEST, consumer(0));
+    const std::size_t removed = dispatcher.add_lane(0, 10, DispatchQueue::Policy::DROP_OLDEST, consumer(1));
+
+    // The worker is kept busy delivering a message of the lane being removed.
+    ASSERT_EQ(dispatcher.push(removed, nullptr), PushResult::QUEUED);
+    while (dispatcher.size() > 0)
+    {
+        std::this_thread::yield();
+    }
+
+    ASSERT_EQ(dispatcher.push(removed, nullptr), PushResult::QUEUED);
+    ASSERT_EQ(dispatcher.push(kept, nullptr), PushResult::QUEUED);
+    dispatcher.remove_lane(removed);
+
+    ASSERT_EQ(dispatcher.size(), 1u);
+    ASSERT_EQ(dispatcher.lane_size(removed), 0u);
+    ASSERT_EQ(dispatcher.push(removed, nullptr), PushResult::DROPPED);
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        released = true;
+        changed.notify_all();
+        changed.wait(lock, [&]()
+                {
+                    return delivered.size() == 2;
+                });
+    }
+
+    // The message being delivered when the lane was removed still reaches its consumer.
+    ASSERT_EQ(delivered, (std::vector<std::size_t>{removed, kept}));
+
+    // New lanes get new identifiers.
+    ASSERT_NE(dispatcher.add_lane(0, 10, DispatchQueue::Policy::DROP_OLDEST, consumer(2)), removed);
+}
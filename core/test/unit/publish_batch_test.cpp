@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/PublishBatch.hpp>
+
+#include <gtest/gtest.h>
+
+using eprosima::is::core::PublishBatch;
+using eprosima::is::core::RouteMetrics;
+
+namespace {
+
+class BatchingPublisher : public eprosima::is::TopicPublisher
+{
+public:
+
+    bool publish(
+            const eprosima::xtypes::DynamicData&) override
+    {
+        return true;
+    }
+
+    bool publish_batch(
+            const std::vector<std::shared_ptr<const eprosima::xtypes::DynamicData> >& messages) override
+    {
+        batches.push_back(messages.size());
+        return true;
+    }
+
+    bool prefers_batches() const override
+    {
+        return true;
+    }
+
+    std::vector<std::size_t> batches;
+};
+
+} //  anonymous namespace
+
+TEST(PublishBatch, Messages_are_published_when_the_batch_closes)
+{
+    auto publisher = std::make_shared<BatchingPublisher>();
+    auto metrics = std::make_shared<RouteMetrics>("topic", "test", "route", "a", "b");
+
+    ASSERT_FALSE(PublishBatch::add(publisher, nullptr, metrics));
+
+    {
+        PublishBatch batch;
+        {
+            PublishBatch nested;
+            for (int i = 0; i < 3; ++i)
+            {
+                ASSERT_TRUE(PublishBatch::add(publisher, nullptr, metrics));
+            }
+        }
+        ASSERT_TRUE(publisher->batches.empty());
+    }
+
+    ASSERT_EQ(publisher->batches, std::vector<std::size_t>{3});
+    ASSERT_EQ(metrics->snapshot().messages_out, 3u);
+}
+
+TEST(PublishBatch, Full_batches_are_published_right_away)
+{
+    auto publisher = std::make_shared<BatchingPublisher>();
+    auto metrics = std::make_shared<RouteMetrics>("topic", "test", "route", "a", "b");
+
+    PublishBatch batch;
+    for (std::size_t i = 0; i < PublishBatch::MAX_SIZE + 1; ++i)
+    {
+        ASSERT_TRUE(PublishBatch::add(publisher, nullptr, metrics));
+    }
+    ASSERT_EQ(publisher->batches, std::vector<std::size_t>{PublishBatch::MAX_SIZE});
+
+    batch.flush();
+    ASSERT_EQ(publisher->batches, (std::vector<std::size_t>{PublishBatch::MAX_SIZE, 1}));
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/PublisherCache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using eprosima::is::TopicPublisher;
+using eprosima::is::core::PublisherCache;
+
+namespace {
+
+class NamedPublisher : public TopicPublisher
+{
+public:
+
+    NamedPublisher(
+            const std::string& topic_name)
+        : name(topic_name)
+    {
+    }
+
+    bool publish(
+            const eprosima::xtypes::DynamicData&) override
+    {
+        return true;
+    }
+
+    const std::string name;
+};
+
+} //  anonymous namespace
+
+TEST(PublisherCache, Least_recently_used_publishers_are_evicted)
+{
+    std::vector<std::string> advertised;
+    PublisherCache cache("test", 2,
+            [&](const std::string& topic_name)
+            {
+                advertised.push_back(topic_name);
+                return std::make_shared<NamedPublisher>(topic_name);
+            });
+
+    auto a = cache.get("a");
+    ASSERT_EQ(std::static_pointer_cast<NamedPublisher>(a)->name, "a");
+    ASSERT_EQ(cache.get("b"), cache.get("b"));
+    ASSERT_EQ(cache.get("a"), a);
+
+    /**
+     * "b" is the least recently used one.
+     */
+    cache.get("c");
+    cache.get("a");
+    cache.get("b");
+
+    ASSERT_EQ(advertised, (std::vector<std::string>{"a", "b", "c", "b"}));
+
+    const PublisherCache::Stats stats = cache.stats();
+    ASSERT_EQ(stats.hits, 3u);
+    ASSERT_EQ(stats.misses, 4u);
+    ASSERT_EQ(stats.evictions, 2u);
+    ASSERT_EQ(stats.size, 2u);
+}
+
+TEST(PublisherCache, Failed_advertisements_are_retried)
+{
+    int attempts = 0;
+    PublisherCache cache("test", 4,
+            [&](const std::string&) -> std::shared_ptr<TopicPublisher>
+            {
+                return ++attempts < 2 ? nullptr : std::make_shared<NamedPublisher>("a");
+            });
+
+    ASSERT_FALSE(cache.get("a"));
+    ASSERT_TRUE(cache.get("a"));
+    ASSERT_TRUE(cache.get("a"));
+
+    ASSERT_EQ(attempts, 2);
+    ASSERT_EQ(cache.stats().failures, 1u);
+}
+
+TEST(PublisherCache, Names_are_advertised_once_without_blocking_other_names)
+{
+    std::mutex mutex;
+    std::map<std::string, int> advertisements;
+    std::promise<void> slow_started;
+    std::promise<void> release_slow;
+    std::shared_future<void> released = release_slow.get_future().share();
+
+    PublisherCache cache("test", 4,
+            [&](const std::string& topic_name)
+            {
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    ++advertisements[topic_name];
+                }
+                if (topic_name == "slow")
+                {
+                    slow_started.set_value();
+                    released.wait();
+                }
+                return std::make_shared<NamedPublisher>(topic_name);
+            });
+
+    std::shared_ptr<TopicPublisher> first;
+    std::shared_ptr<TopicPublisher> second;
+    std::thread first_thread([&]()
+            {
+                first = cache.get("slow");
+            });
+    slow_started.get_future().wait();
+    std::thread second_thread([&]()
+            {
+                second = cache.get("slow");
+            });
+
+    /**
+     * Other names are advertised and served while "slow" is being advertised.
+     */
+    ASSERT_TRUE(cache.get("fast"));
+    ASSERT_TRUE(cache.get("fast"));
+
+    release_slow.set_value();
+    first_thread.join();
+    second_thread.join();
+
+    ASSERT_TRUE(first);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(advertisements["slow"], 1);
+    ASSERT_EQ(advertisements["fast"], 1);
+    ASSERT_EQ(cache.stats().misses, 2u);
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/RateLimiter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using eprosima::is::core::RateLimiter;
+
+namespace {
+
+using Message = std::shared_ptr<const eprosima::xtypes::DynamicData>;
+
+} //  anonymous namespace
+
+TEST(RateLimiter, Messages_exceeding_the_burst_are_dropped)
+{
+    int delivered = 0;
+    const RateLimiter::Consumer consumer = [&](const Message&)
+            {
+                ++delivered;
+            };
+
+    RateLimiter limiter("test", 1.0, 3, false);
+
+    int accepted = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        accepted += limiter.offer(nullptr, consumer);
+    }
+
+    ASSERT_EQ(accepted, 3);
+    ASSERT_EQ(delivered, 3);
+    ASSERT_EQ(limiter.dropped(), 7u);
+}
+
+TEST(RateLimiter, Latest_message_is_delivered_by_the_scheduled_task)
+{
+    int delivered = 0;
+    const RateLimiter::Consumer consumer = [&](const Message&)
+            {
+                ++delivered;
+            };
+
+    std::vector<std::pair<std::function<void ()>, std::chrono::steady_clock::duration> > tasks;
+    RateLimiter limiter("test", 50.0, 1, true,
+            [&tasks](std::function<void ()> task, std::chrono::steady_clock::duration delay)
+            {
+                tasks.emplace_back(std::move(task), delay);
+            });
+
+    ASSERT_TRUE(limiter.offer(nullptr, consumer));
+    ASSERT_EQ(delivered, 1);
+    ASSERT_TRUE(tasks.empty());
+
+    /**
+     * The second message is kept aside, and then replaced by the third one.
+     * Its release is only scheduled once.
+     */
+    ASSERT_TRUE(limiter.offer(nullptr, consumer));
+    ASSERT_FALSE(limiter.offer(nullptr, consumer));
+    ASSERT_EQ(limiter.dropped(), 1u);
+    ASSERT_EQ(limiter.size(), 1u);
+    ASSERT_EQ(tasks.size(), 1u);
+    ASSERT_GT(tasks[0].second, std::chrono::steady_clock::duration::zero());
+    ASSERT_LE(tasks[0].second, std::chrono::milliseconds(20));
+
+    std::this_thread::sleep_for(tasks[0].second);
+    tasks[0].first();
+    ASSERT_EQ(delivered, 2);
+    ASSERT_EQ(limiter.size(), 0u);
+}
+
+TEST(RateLimiter, Sources_sharing_a_limiter_share_its_rate)
+{
+    int first = 0;
+    int second = 0;
+    const RateLimiter::Consumer first_consumer = [&](const Message&)
+            {
+                ++first;
+            };
+    const RateLimiter::Consumer second_consumer = [&](const Message&)
+            {
+                ++second;
+            };
+
+    RateLimiter limiter("test", 1.0, 4, false);
+    for (int i = 0; i < 4; ++i)
+    {
+        limiter.offer(nullptr, first_consumer);
+        limiter.offer(nullptr, second_consumer);
+    }
+
+    // Each message went to the consumer of its source, within a single budget.
+    ASSERT_EQ(first, 2);
+    ASSERT_EQ(second, 2);
+    ASSERT_EQ(limiter.dropped(), 4u);
+}
+
+TEST(RateLimiter, Tasks_outliving_the_limiter_do_nothing)
+{
+    std::function<void ()> release;
+    {
+        RateLimiter limiter("test", 1.0, 1, true,
+                [&release](std::function<void ()> task, std::chrono::steady_clock::duration)
+                {
+                    release = std::move(task);
+                });
+
+        const RateLimiter::Consumer consumer = [](const Message&)
+                {
+                };
+        limiter.offer(nullptr, consumer);
+        limiter.offer(nullptr, consumer);
+    }
+
+    ASSERT_TRUE(static_cast<bool>(release));
+    release();
+}
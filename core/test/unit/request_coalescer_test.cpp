@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/RequestCoalescer.hpp>
+
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using eprosima::is::core::RequestCoalescer;
+using eprosima::is::core::test::CountingClient;
+namespace xtypes = eprosima::xtypes;
+
+namespace {
+
+/**
+ * Keeps the calls it gets, so that the tests complete them through the coalescer.
+ */
+class RecordingProvider : public eprosima::is::ServiceProvider
+{
+public:
+
+    void call_service(
+            const xtypes::DynamicData&,
+            eprosima::is::ServiceClient& client,
+            std::shared_ptr<void> call_handle) override
+    {
+        calls.push_back(Call{&client, std::move(call_handle)});
+    }
+
+    struct Call
+    {
+        eprosima::is::ServiceClient* client;
+        std::shared_ptr<void> handle;
+    };
+
+    std::vector<Call> calls;
+};
+
+xtypes::StructType value_type()
+{
+    xtypes::StructType type("Value");
+    type.add_member("value", xtypes::primitive_type<int32_t>());
+    return type;
+}
+
+xtypes::DynamicData make_value(
+        const xtypes::DynamicType& type,
+        int32_t value)
+{
+    xtypes::DynamicData data(type);
+    data["value"] = value;
+    return data;
+}
+
+} //  anonymous namespace
+
+TEST(RequestCoalescer, Identical_requests_in_flight_share_the_reply)
+{
+    const xtypes::StructType type = value_type();
+    const auto provider = std::make_shared<RecordingProvider>();
+    RequestCoalescer coalescer(provider, 0s);
+
+    CountingClient first;
+    CountingClient second;
+    CountingClient other;
+    coalescer.call_service(make_value(type, 1), first, nullptr);
+    coalescer.call_service(make_value(type, 1), second, nullptr);
+    coalescer.call_service(make_value(type, 2), other, nullptr);
+
+    ASSERT_EQ(provider->calls.size(), 2u);
+    ASSERT_EQ(coalescer.calls(), 2u);
+    ASSERT_EQ(coalescer.coalesced(), 1u);
+
+    provider->calls[0].client->receive_response(provider->calls[0].handle, make_value(type, 10));
+    ASSERT_EQ(first.responses, 1);
+    ASSERT_EQ(second.responses, 1);
+    ASSERT_EQ(first.last, 10);
+    ASSERT_EQ(second.last, 10);
+    ASSERT_EQ(other.responses, 0);
+
+    provider->calls[1].client->receive_cancellation(provider->calls[1].handle);
+    ASSERT_EQ(other.cancellations, 1);
+
+    // Without a reply cache, a request made after the reply calls the server again.
+    CountingClient late;
+    coalescer.call_service(make_value(type, 1), late, nullptr);
+    ASSERT_EQ(provider->calls.size(), 3u);
+    ASSERT_EQ(late.responses, 0);
+}
+
+TEST(RequestCoalescer, Cancellations_reach_every_waiting_client)
+{
+    const xtypes::StructType type = value_type();
+    const auto provider = std::make_shared<RecordingProvider>();
+    RequestCoalescer coalescer(provider, 0s);
+
+    CountingClient first;
+    CountingClient second;
+    coalescer.call_service(make_value(type, 1), first, nullptr);
+    coalescer.call_service(make_value(type, 1), second, nullptr);
+    ASSERT_EQ(provider->calls.size(), 1u);
+
+    provider->calls[0].client->receive_cancellation(provider->calls[0].handle);
+    ASSERT_EQ(first.cancellations, 1);
+    ASSERT_EQ(second.cancellations, 1);
+
+    // A late reply of the cancelled call is discarded.
+    provider->calls[0].client->receive_response(provider->calls[0].handle, make_value(type, 10));
+    ASSERT_EQ(first.responses, 0);
+    ASSERT_EQ(second.responses, 0);
+}
+
+TEST(RequestCoalescer, Waiting_clients_are_limited)
+{
+    const xtypes::StructType type = value_type();
+    const auto provider = std::make_shared<RecordingProvider>();
+    RequestCoalescer coalescer(provider, 0s, 0s, 2);
+
+    std::vector<CountingClient> clients(5);
+    for (CountingClient& client : clients)
+    {
+        coalescer.call_service(make_value(type, 1), client, nullptr);
+    }
+
+    // Each call takes two clients at most, even though its reply never arrives.
+    ASSERT_EQ(provider->calls.size(), 3u);
+    ASSERT_EQ(coalescer.coalesced(), 2u);
+
+    provider->calls[0].client->receive_response(provider->calls[0].handle, make_value(type, 10));
+    ASSERT_EQ(clients[0].responses, 1);
+    ASSERT_EQ(clients[1].responses, 1);
+    ASSERT_EQ(clients[2].responses, 0);
+}
+
+TEST(RequestCoalescer, Old_requests_take_no_more_waiters)
+{
+    const xtypes::StructType type = value_type();
+    const auto provider = std::make_shared<RecordingProvider>();
+    RequestCoalescer coalescer(provider, 0s, 1ms);
+
+    CountingClient first;
+    CountingClient second;
+    coalescer.call_service(make_value(type, 1), first, nullptr);
+    std::this_thread::sleep_for(5ms);
+    coalescer.call_service(make_value(type, 1), second, nullptr);
+    ASSERT_EQ(provider->calls.size(), 2u);
+
+    // The old request still gets its reply.
+    provider->calls[0].client->receive_response(provider->calls[0].handle, make_value(type, 10));
+    ASSERT_EQ(first.responses, 1);
+    ASSERT_EQ(second.responses, 0);
+}
+
+TEST(RequestCoalescer, Replies_are_reused_during_their_ttl)
+{
+    const xtypes::StructType type = value_type();
+    const auto provider = std::make_shared<RecordingProvider>();
+    RequestCoalescer coalescer(provider, 1h);
+
+    CountingClient first;
+    coalescer.call_service(make_value(type, 1), first, nullptr);
+    provider->calls[0].client->receive_response(provider->calls[0].handle, make_value(type, 10));
+    ASSERT_EQ(first.responses, 1);
+
+    CountingClient cached;
+    coalescer.call_service(make_value(type, 1), cached, nullptr);
+    ASSERT_EQ(provider->calls.size(), 1u);
+    ASSERT_EQ(cached.responses, 1);
+    ASSERT_EQ(cached.last, 10);
+
+    CountingClient other;
+    coalescer.call_service(make_value(type, 2), other, nullptr);
+    ASSERT_EQ(provider->calls.size(), 2u);
+    ASSERT_EQ(other.responses, 0);
+}
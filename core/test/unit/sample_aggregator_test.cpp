@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/SampleAggregator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::core::SampleAggregator;
+
+namespace {
+
+xtypes::StructType sample_type()
+{
+    xtypes::StructType type("Sample");
+    type.add_member("index", xtypes::primitive_type<uint32_t>());
+    type.add_member("text", xtypes::StringType());
+    return type;
+}
+
+/**
+ * Collects the frames delivered by an aggregator.
+ */
+struct Frames
+{
+    SampleAggregator::Consumer consumer()
+    {
+        return [this](const std::shared_ptr<const xtypes::DynamicData>& frame)
+               {
+                   std::unique_lock<std::mutex> lock(mutex);
+                   frames.push_back(frame);
+               };
+    }
+
+    std::size_t size()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        return frames.size();
+    }
+
+    std::vector<uint32_t> indexes(
+            const xtypes::StructType& type)
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        std::vector<uint32_t> result;
+        xtypes::DynamicData sample(type);
+        for (const auto& frame : frames)
+        {
+            EXPECT_TRUE(SampleAggregator::unpack(*frame, sample,
+                    [&](const xtypes::DynamicData& unpacked)
+                    {
+                        result.push_back(unpacked["index"].value<uint32_t>());
+                    }));
+        }
+        return result;
+    }
+
+    std::mutex mutex;
+    std::vector<std::shared_ptr<const xtypes::DynamicData> > frames;
+};
+
+} //  anonymous namespace
+
+TEST(SampleAggregator, Full_frames_are_delivered_in_order)
+{
+    const xtypes::StructType type = sample_type();
+    Frames frames;
+    SampleAggregator aggregator("test", 3, 0, 10.0, SampleAggregator::Compression::NONE, frames.consumer());
+
+    xtypes::DynamicData sample(type);
+    for (uint32_t i = 0; i < 7; ++i)
+    {
+        sample["index"] = i;
+        sample["text"] = std::string("sample ") + std::to_string(i);
+        ASSERT_TRUE(aggregator.offer(sample));
+    }
+    ASSERT_EQ(frames.size(), 2u);
+
+    aggregator.flush();
+    ASSERT_EQ(frames.size(), 3u);
+    ASSERT_EQ(aggregator.frames(), 3u);
+    ASSERT_EQ(frames.frames.back()->operator[]("samples").value<uint32_t>(), 1u);
+    ASSERT_EQ(frames.indexes(type), std::vector<uint32_t>({0, 1, 2, 3, 4, 5, 6}));
+}
+
+TEST(SampleAggregator, Open_windows_expire_after_max_delay)
+{
+    const xtypes::StructType type = sample_type();
+    Frames frames;
+    SampleAggregator aggregator("test", 100, 0, 0.02, SampleAggregator::Compression::NONE, frames.consumer());
+
+    xtypes::DynamicData sample(type);
+    sample["index"] = uint32_t(42);
+    ASSERT_TRUE(aggregator.offer(sample));
+    ASSERT_EQ(frames.size(), 0u);
+
+    for (int i = 0; i < 200 && frames.size() == 0; ++i)
+    {
+        std::this_thread::sleep_for(5ms);
+    }
+    ASSERT_EQ(frames.indexes(type), std::vector<uint32_t>({42}));
+}
+
+TEST(SampleAggregator, Frames_are_delivered_once_max_bytes_are_encoded)
+{
+    const xtypes::StructType type = sample_type();
+    Frames frames;
+    SampleAggregator aggregator("test", 100, 1000, 10.0, SampleAggregator::Compression::NONE, frames.consumer());
+
+    xtypes::DynamicData sample(type);
+    sample["text"] = std::string(600, 'x');
+    ASSERT_TRUE(aggregator.offer(sample));
+    ASSERT_EQ(frames.size(), 0u);
+    ASSERT_TRUE(aggregator.offer(sample));
+    ASSERT_EQ(frames.size(), 1u);
+}
+
+TEST(SampleAggregator, Compressed_frames_are_unpacked)
+{
+    for (const auto compression : {SampleAggregator::Compression::LZ4, SampleAggregator::Compression::ZSTD})
+    {
+        if (!SampleAggregator::available(compression))
+        {
+            continue;
+        }
+
+        const xtypes::StructType type = sample_type();
+        Frames frames;
+        SampleAggregator aggregator("test", 10, 0, 10.0, compression, frames.consumer());
+
+        xtypes::DynamicData sample(type);
+        for (uint32_t i = 0; i < 10; ++i)
+        {
+            sample["index"] = i;
+            sample["text"] = std::string(256, 'a');
+            ASSERT_TRUE(aggregator.offer(sample));
+        }
+
+        ASSERT_EQ(frames.size(), 1u);
+        const xtypes::DynamicData& frame = *frames.frames.front();
+        ASSERT_EQ(frame["compression"].value<uint8_t>(), static_cast<uint8_t>(compression));
+        ASSERT_LT(frame["payload"].size(), frame["size"].value<uint32_t>());
+        ASSERT_EQ(frames.indexes(type).size(), 10u);
+    }
+}
+
+TEST(SampleAggregator, Truncated_frames_are_rejected)
+{
+    const xtypes::StructType type = sample_type();
+    Frames frames;
+    SampleAggregator aggregator("test", 2, 0, 10.0, SampleAggregator::Compression::NONE, frames.consumer());
+
+    xtypes::DynamicData sample(type);
+    ASSERT_TRUE(aggregator.offer(sample));
+    ASSERT_TRUE(aggregator.offer(sample));
+    ASSERT_EQ(frames.size(), 1u);
+
+    const xtypes::DynamicData& frame = *frames.frames.front();
+    xtypes::DynamicData truncated(SampleAggregator::frame_type());
+    truncated["samples"] = frame["samples"].value<uint32_t>();
+    truncated["size"] = static_cast<uint32_t>(frame["payload"].size() / 2);
+    for (std::size_t i = 0; i < frame["payload"].size() / 2; ++i)
+    {
+        truncated["payload"].push(frame["payload"][i].value<uint8_t>());
+    }
+
+    int unpacked = 0;
+    ASSERT_FALSE(SampleAggregator::unpack(truncated, sample,
+            [&](const xtypes::DynamicData&)
+            {
+                ++unpacked;
+            }));
+    ASSERT_LT(unpacked, 2);
+}
+
+TEST(SampleAggregator, Compressed_frames_with_forged_sizes_are_rejected)
+{
+    for (const auto compression : {SampleAggregator::Compression::LZ4, SampleAggregator::Compression::ZSTD})
+    {
+        if (!SampleAggregator::available(compression))
+        {
+            continue;
+        }
+
+        const xtypes::StructType type = sample_type();
+        Frames frames;
+        SampleAggregator aggregator("test", 4, 0, 10.0, compression, frames.consumer());
+
+        xtypes::DynamicData sample(type);
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            sample["text"] = std::string(256, 'a');
+            ASSERT_TRUE(aggregator.offer(sample));
+        }
+        ASSERT_EQ(frames.size(), 1u);
+
+        /**
+         * Neither a size slightly off nor one far beyond what the payload
+         * could hold are trusted, the latter before allocating it.
+         */
+        const xtypes::DynamicData& frame = *frames.frames.front();
+        const uint32_t raw_size = frame["size"].value<uint32_t>();
+        for (const uint32_t forged : {raw_size + 1, raw_size - 1, std::numeric_limits<uint32_t>::max()})
+        {
+            xtypes::DynamicData forged_frame(frame);
+            forged_frame["size"] = forged;
+            ASSERT_FALSE(SampleAggregator::unpack(forged_frame, sample,
+                    [](const xtypes::DynamicData&)
+                    {
+                    }));
+        }
+    }
+}
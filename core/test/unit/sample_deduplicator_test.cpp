@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/SampleDeduplicator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace std::chrono_literals;
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::core::SampleDeduplicator;
+
+namespace {
+
+xtypes::StructType message_type(
+        const std::string& name)
+{
+    xtypes::StructType header(name + "Header");
+    header.add_member("seq", xtypes::primitive_type<uint32_t>());
+
+    xtypes::StructType type(name);
+    type.add_member("value", xtypes::primitive_type<double>());
+    type.add_member("header", header);
+    return type;
+}
+
+} //  anonymous namespace
+
+TEST(SampleDeduplicator, Copies_within_the_window_are_suppressed)
+{
+    SampleDeduplicator deduplicator("test", 0.05, 16);
+
+    ASSERT_TRUE(deduplicator.offer(1));
+    ASSERT_TRUE(deduplicator.offer(2));
+    ASSERT_FALSE(deduplicator.offer(1));
+    ASSERT_FALSE(deduplicator.offer(2));
+    ASSERT_EQ(deduplicator.size(), 2u);
+    ASSERT_EQ(deduplicator.suppressed(), 2u);
+
+    std::this_thread::sleep_for(80ms);
+    ASSERT_TRUE(deduplicator.offer(1));
+    ASSERT_EQ(deduplicator.size(), 1u);
+}
+
+TEST(SampleDeduplicator, Oldest_samples_are_forgotten_when_full)
+{
+    SampleDeduplicator deduplicator("test", 10.0, 2);
+
+    ASSERT_TRUE(deduplicator.offer(1));
+    ASSERT_TRUE(deduplicator.offer(2));
+    ASSERT_TRUE(deduplicator.offer(3));
+    ASSERT_EQ(deduplicator.size(), 2u);
+
+    ASSERT_TRUE(deduplicator.offer(1));
+    ASSERT_FALSE(deduplicator.offer(3));
+}
+
+TEST(SampleDeduplicator, Keys_match_across_types)
+{
+    xtypes::StructType first_type = message_type("First");
+
+    /**
+     * The second type places the key at a different member index.
+     */
+    xtypes::StructType header("SecondHeader");
+    header.add_member("seq", xtypes::primitive_type<uint32_t>());
+    xtypes::StructType second_type("Second");
+    second_type.add_member("header", header);
+    second_type.add_member("value", xtypes::primitive_type<double>());
+
+    SampleDeduplicator::Key first_key;
+    SampleDeduplicator::Key second_key;
+    std::string error;
+    ASSERT_TRUE(SampleDeduplicator::resolve(first_type, "header.seq", first_key, error));
+    ASSERT_TRUE(SampleDeduplicator::resolve(second_type, "header.seq", second_key, error));
+
+    xtypes::DynamicData first(first_type);
+    first["header"]["seq"] = uint32_t(7);
+    first["value"] = 1.0;
+
+    xtypes::DynamicData second(second_type);
+    second["header"]["seq"] = uint32_t(7);
+    second["value"] = 2.0;
+
+    ASSERT_EQ(SampleDeduplicator::hash(first, first_key), SampleDeduplicator::hash(second, second_key));
+
+    second["header"]["seq"] = uint32_t(8);
+    ASSERT_NE(SampleDeduplicator::hash(first, first_key), SampleDeduplicator::hash(second, second_key));
+
+    /**
+     * Without a key, the whole message is hashed.
+     */
+    SampleDeduplicator::Key whole;
+    ASSERT_TRUE(SampleDeduplicator::resolve(first_type, "", whole, error));
+    ASSERT_TRUE(whole.empty());
+
+    xtypes::DynamicData copy(first);
+    ASSERT_EQ(SampleDeduplicator::hash(first, whole), SampleDeduplicator::hash(copy, whole));
+    copy["value"] = 3.0;
+    ASSERT_NE(SampleDeduplicator::hash(first, whole), SampleDeduplicator::hash(copy, whole));
+}
+
+TEST(SampleDeduplicator, Invalid_keys_are_rejected)
+{
+    xtypes::StructType type = message_type("Message");
+    SampleDeduplicator::Key key;
+    std::string error;
+
+    ASSERT_FALSE(SampleDeduplicator::resolve(type, "header.stamp", key, error));
+    ASSERT_FALSE(error.empty());
+    ASSERT_FALSE(SampleDeduplicator::resolve(type, "value.seq", key, error));
+    ASSERT_FALSE(SampleDeduplicator::resolve(type, "header.", key, error));
+}
@@ -19,6 +19,8 @@
 
 #include <gtest/gtest.h>
 
+#include <experimental/filesystem>
+#include <fstream>
 #include <iostream>
 
 TEST(Search, Use_config_file_directory)
@@ -39,6 +41,30 @@ TEST(Search, Use_config_file_directory)
             SEARCH_TEST__MOCK_FILE_PATH);
 }
 
+TEST(Search, Invalidate_cache)
+{
+    namespace fs = std::experimental::filesystem;
+
+    const fs::path prefix = fs::temp_directory_path() / "is_search_test_invalidate_cache";
+    fs::remove_all(prefix);
+    fs::create_directories(prefix);
+
+    eprosima::is::core::Search search("mock");
+    search.add_priority_middleware_prefix(prefix.string());
+
+    ASSERT_TRUE(search.find_file("cached.txt").empty());
+
+    std::ofstream((prefix / "cached.txt").string()) << "cached";
+
+    // The contents of the prefix were indexed by the first search.
+    ASSERT_TRUE(search.find_file("cached.txt").empty());
+
+    eprosima::is::core::Search::invalidate_cache();
+    ASSERT_EQ(search.find_file("cached.txt"), (prefix / "cached.txt").string());
+
+    fs::remove_all(prefix);
+}
+
 int main(
         int argc,
         char** argv)
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/ServiceCall.hpp>
+
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using eprosima::is::core::ServiceCall;
+using eprosima::is::core::test::CountingClient;
+namespace xtypes = eprosima::xtypes;
+
+TEST(ServiceCall, Calls_are_completed_once)
+{
+    xtypes::StructType type("Reply");
+    type.add_member("value", xtypes::primitive_type<int32_t>());
+    xtypes::DynamicData response(type);
+    response["value"] = int32_t(7);
+
+    CountingClient client;
+    const std::shared_ptr<void> handle = std::make_shared<ServiceCall>(client, nullptr);
+    const std::shared_ptr<ServiceCall> call = ServiceCall::from(handle);
+
+    ASSERT_EQ(call->status(), ServiceCall::Status::PENDING);
+    ASSERT_TRUE(call->reply(response));
+    ASSERT_FALSE(call->reply(response));
+    ASSERT_FALSE(call->cancel());
+
+    ASSERT_EQ(call->status(), ServiceCall::Status::REPLIED);
+    ASSERT_EQ(client.last, 7);
+    ASSERT_EQ(client.responses, 1);
+    ASSERT_EQ(client.cancellations, 0);
+}
+
+TEST(ServiceCall, Concurrent_completions)
+{
+    CountingClient client;
+    std::vector<std::shared_ptr<ServiceCall> > calls;
+    for (int i = 0; i < 1000; ++i)
+    {
+        calls.push_back(std::make_shared<ServiceCall>(client, nullptr));
+    }
+
+    std::atomic<int> completed{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&]()
+                {
+                    for (const auto& call : calls)
+                    {
+                        completed += call->cancel() ? 1 : 0;
+                    }
+                });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(completed, 1000);
+    ASSERT_EQ(client.cancellations, 1000);
+}
+
+TEST(ServiceCall, Waiting_and_continuations)
+{
+    CountingClient client;
+    const auto call = std::make_shared<ServiceCall>(client, nullptr);
+
+    ASSERT_EQ(call->wait_for(1ms), ServiceCall::Status::PENDING);
+
+    std::atomic<int> continued{0};
+    call->then([&](ServiceCall::Status status)
+            {
+                ASSERT_EQ(status, ServiceCall::Status::CANCELLED);
+                ++continued;
+            });
+
+    std::thread completer([call]()
+            {
+                std::this_thread::sleep_for(10ms);
+                call->cancel();
+            });
+
+    ASSERT_EQ(call->wait(), ServiceCall::Status::CANCELLED);
+    completer.join();
+    ASSERT_EQ(continued, 1);
+
+    // Once completed, continuations are called straight away.
+    call->then([&](ServiceCall::Status)
+            {
+                ++continued;
+            });
+    ASSERT_EQ(continued, 2);
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/ShardSupervisor.hpp>
+
+#include <gtest/gtest.h>
+
+using eprosima::is::core::RouteMetricsSnapshot;
+using eprosima::is::core::ShardSupervisor;
+
+TEST(ShardSupervisor, Reports_are_decoded_back)
+{
+    ShardSupervisor::Report report;
+    report.exporter_address = "127.0.0.1";
+    report.exporter_port = 9100;
+
+    RouteMetricsSnapshot route;
+    route.kind = "topic";
+    route.name = "hello\tworld 100%";
+    route.route = "dds_to_ros2";
+    route.source = "dds";
+    route.destination = "ros2";
+    route.messages_in = 10;
+    route.messages_out = 9;
+    route.drops = 1;
+    route.dynamic_publishers = 3;
+    route.publisher_evictions = 5;
+    route.publish_time.count = 9;
+    route.publish_time.sum_ns = 900;
+    route.publish_time.buckets[3] = 9;
+    report.routes.push_back(route);
+
+    const std::string encoded = ShardSupervisor::encode(report);
+
+    /**
+     * Reports are only decoded once they have been completely read.
+     */
+    std::string buffer = encoded.substr(0, encoded.size() - 1);
+    ShardSupervisor::Report decoded;
+    ASSERT_FALSE(ShardSupervisor::decode(buffer, decoded));
+
+    buffer = encoded + encoded;
+    ASSERT_TRUE(ShardSupervisor::decode(buffer, decoded));
+    ASSERT_EQ(buffer, encoded);
+
+    ASSERT_EQ(decoded.exporter_address, "127.0.0.1");
+    ASSERT_EQ(decoded.exporter_port, 9100);
+    ASSERT_EQ(decoded.routes.size(), 1u);
+    ASSERT_EQ(decoded.routes[0].name, "hello\tworld 100%");
+    ASSERT_EQ(decoded.routes[0].destination, "ros2");
+    ASSERT_EQ(decoded.routes[0].messages_in, 10u);
+    ASSERT_EQ(decoded.routes[0].messages_out, 9u);
+    ASSERT_EQ(decoded.routes[0].drops, 1u);
+    ASSERT_EQ(decoded.routes[0].dynamic_publishers, 3u);
+    ASSERT_EQ(decoded.routes[0].publisher_evictions, 5u);
+    ASSERT_EQ(decoded.routes[0].publish_time.sum_ns, 900u);
+    ASSERT_EQ(decoded.routes[0].publish_time.buckets[3], 9u);
+}
+
+TEST(ShardSupervisor, Only_the_shards_option_is_taken_out)
+{
+    char program[] = "integration-service";
+    char config[] = "config.yaml";
+    char shards[] = "--shards=4";
+    char* argv[] = {program, config, shards};
+
+    ASSERT_EQ(ShardSupervisor(3, argv).shards(), 4u);
+    ASSERT_EQ(ShardSupervisor(2, argv).shards(), 0u);
+}
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/SpinExecutor.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+using eprosima::is::core::SpinExecutor;
+
+TEST(SpinExecutor, Notified_handles_are_queued_once_in_order)
+{
+    SpinExecutor executor;
+    const std::shared_ptr<SpinExecutor::Entry> first = executor.add("first", nullptr);
+    const std::shared_ptr<SpinExecutor::Entry> second = executor.add("second", nullptr);
+    ASSERT_EQ(executor.size(), 2u);
+
+    executor.notify(first);
+    executor.notify(second);
+    executor.notify(first);
+
+    const std::shared_ptr<SpinExecutor::Entry> spun = executor.next(0ms);
+    ASSERT_EQ(spun, first);
+    ASSERT_EQ(executor.next(0ms), second);
+    ASSERT_EQ(executor.next(0ms), nullptr);
+
+    executor.done(first);
+    executor.done(second);
+    ASSERT_EQ(executor.next(0ms), nullptr);
+}
+
+TEST(SpinExecutor, Handles_notified_while_running_are_queued_again_when_done)
+{
+    SpinExecutor executor;
+    const std::shared_ptr<SpinExecutor::Entry> entry = executor.add("handle", nullptr);
+
+    executor.notify(entry);
+    ASSERT_EQ(executor.next(0ms), entry);
+
+    /**
+     * Each handle is only spun by one thread at a time.
+     */
+    executor.notify(entry);
+    executor.notify(entry);
+    ASSERT_EQ(executor.next(0ms), nullptr);
+
+    executor.done(entry);
+    ASSERT_EQ(executor.next(0ms), entry);
+    executor.done(entry);
+    ASSERT_EQ(executor.next(0ms), nullptr);
+}
+
+TEST(SpinExecutor, Removed_handles_ignore_notifications)
+{
+    SpinExecutor executor;
+    const std::shared_ptr<SpinExecutor::Entry> removed = executor.add("removed", nullptr);
+    const std::shared_ptr<SpinExecutor::Entry> kept = executor.add("kept", nullptr);
+
+    executor.notify(removed);
+    executor.remove(removed);
+    ASSERT_EQ(executor.size(), 1u);
+    ASSERT_EQ(executor.next(0ms), nullptr);
+
+    /**
+     * A handle that declined the wake-up callback may still call it.
+     */
+    executor.notify(removed);
+    ASSERT_EQ(executor.next(0ms), nullptr);
+
+    executor.notify(kept);
+    ASSERT_EQ(executor.next(0ms), kept);
+
+    // Handles removed while running are not queued again.
+    executor.notify(kept);
+    executor.remove(kept);
+    executor.done(kept);
+    ASSERT_EQ(executor.next(0ms), nullptr);
+    ASSERT_EQ(executor.size(), 0u);
+}
+
+TEST(SpinExecutor, Posted_tasks_run_once_their_delay_has_passed)
+{
+    SpinExecutor executor;
+    std::vector<int> order;
+
+    executor.post([&order]()
+            {
+                order.push_back(2);
+            }, 100ms);
+    executor.post([&order]()
+            {
+                order.push_back(1);
+            }, 50ms);
+    ASSERT_FALSE(executor.next_task());
+
+    /**
+     * Waiting for handles ends as soon as a task is due.
+     */
+    const auto start = SpinExecutor::Clock::now();
+    ASSERT_EQ(executor.next(10s), nullptr);
+    ASSERT_GE(SpinExecutor::Clock::now() - start, 50ms);
+    ASSERT_LT(SpinExecutor::Clock::now() - start, 5s);
+
+    std::function<void ()> task = executor.next_task();
+    ASSERT_TRUE(task);
+    task();
+    ASSERT_FALSE(executor.next_task());
+
+    ASSERT_EQ(executor.next(10s), nullptr);
+    task = executor.next_task();
+    ASSERT_TRUE(task);
+    task();
+
+    ASSERT_EQ(order, (std::vector<int>{1, 2}));
+}
+
+TEST(SpinExecutor, Waiting_threads_are_woken_up)
+{
+    SpinExecutor executor;
+    const std::shared_ptr<SpinExecutor::Entry> entry = executor.add("handle", nullptr);
+
+    std::shared_ptr<SpinExecutor::Entry> notified;
+    std::thread waiter([&]()
+            {
+                notified = executor.next(10s);
+            });
+    executor.notify(entry);
+    waiter.join();
+    ASSERT_EQ(notified, entry);
+    executor.done(entry);
+
+    const auto start = SpinExecutor::Clock::now();
+    std::thread woken([&]()
+            {
+                notified = executor.next(10s);
+            });
+    executor.wake_all();
+    woken.join();
+    ASSERT_EQ(notified, nullptr);
+    ASSERT_LT(SpinExecutor::Clock::now() - start, 5s);
+}
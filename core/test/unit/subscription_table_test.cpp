@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/SubscriptionTable.hpp>
+
+#include <gtest/gtest.h>
+
+namespace is = eprosima::is;
+using is::core::SubscriptionTable;
+
+namespace {
+
+/**
+ * The table only references the SystemHandles, so any shared object can stand for them.
+ */
+std::shared_ptr<is::SystemHandle> make_system()
+{
+    return std::shared_ptr<is::SystemHandle>(
+        std::make_shared<int>(0), reinterpret_cast<is::SystemHandle*>(1));
+}
+
+} //  anonymous namespace
+
+TEST(SubscriptionTable, Topics_are_unsubscribed_once_no_route_holds_them)
+{
+    const std::shared_ptr<is::SystemHandle> system = make_system();
+    const int first = 0;
+    const int second = 0;
+    int subscribed = 0;
+    int unsubscribed = 0;
+
+    const SubscriptionTable::Action subscribe = [&subscribed]()
+            {
+                ++subscribed;
+                return true;
+            };
+    const SubscriptionTable::Action unsubscribe = [&unsubscribed]()
+            {
+                ++unsubscribed;
+                return true;
+            };
+
+    ASSERT_TRUE(SubscriptionTable::subscribe(system, "topic", &first, subscribe));
+    ASSERT_TRUE(SubscriptionTable::subscribe(system, "topic", &second, subscribe));
+    ASSERT_EQ(subscribed, 2);
+    ASSERT_EQ(SubscriptionTable::holders(system, "topic"), 2u);
+
+    // The second route keeps the topic subscribed.
+    ASSERT_TRUE(SubscriptionTable::unsubscribe(system, "topic", &first, unsubscribe));
+    ASSERT_EQ(unsubscribed, 0);
+    ASSERT_EQ(SubscriptionTable::holders(system, "topic"), 1u);
+    ASSERT_TRUE(SubscriptionTable::registered(system, &first));
+
+    // The callback of the first route is still registered, so it is not subscribed again.
+    ASSERT_TRUE(SubscriptionTable::subscribe(system, "topic", &first, subscribe));
+    ASSERT_EQ(subscribed, 2);
+
+    ASSERT_TRUE(SubscriptionTable::unsubscribe(system, "topic", &first, unsubscribe));
+    ASSERT_TRUE(SubscriptionTable::unsubscribe(system, "topic", &second, unsubscribe));
+    ASSERT_EQ(unsubscribed, 1);
+    ASSERT_EQ(SubscriptionTable::holders(system, "topic"), 0u);
+    ASSERT_FALSE(SubscriptionTable::registered(system, &first));
+    ASSERT_FALSE(SubscriptionTable::registered(system, &second));
+
+    // Once unsubscribed, the callbacks are registered again.
+    ASSERT_TRUE(SubscriptionTable::subscribe(system, "topic", &first, subscribe));
+    ASSERT_EQ(subscribed, 3);
+    ASSERT_TRUE(SubscriptionTable::unsubscribe(system, "topic", &first, unsubscribe));
+}
+
+TEST(SubscriptionTable, Failures_leave_the_subscription_held)
+{
+    const std::shared_ptr<is::SystemHandle> system = make_system();
+    const int route = 0;
+
+    ASSERT_FALSE(SubscriptionTable::subscribe(system, "topic", &route, []()
+            {
+                return false;
+            }));
+    ASSERT_EQ(SubscriptionTable::holders(system, "topic"), 0u);
+
+    ASSERT_TRUE(SubscriptionTable::subscribe(system, "topic", &route, []()
+            {
+                return true;
+            }));
+    ASSERT_FALSE(SubscriptionTable::unsubscribe(system, "topic", &route, []()
+            {
+                return false;
+            }));
+    ASSERT_EQ(SubscriptionTable::holders(system, "topic"), 1u);
+
+    /**
+     * Topics of different SystemHandles are independent.
+     */
+    const std::shared_ptr<is::SystemHandle> other = make_system();
+    ASSERT_EQ(SubscriptionTable::holders(other, "topic"), 0u);
+}
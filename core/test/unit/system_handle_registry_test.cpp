@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/SystemHandleRegistry.hpp>
+#include <is/systemhandle/RegisterSystem.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <thread>
+
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::core::SystemHandleRegistry;
+using eprosima::is::internal::Register;
+using eprosima::is::internal::SystemHandleInfo;
+
+namespace {
+
+class CountingSystem : public eprosima::is::SystemHandle
+{
+public:
+
+    bool configure(
+            const eprosima::is::core::RequiredTypes& /*types*/,
+            const YAML::Node& /*configuration*/,
+            eprosima::is::TypeRegistry& /*type_registry*/) override
+    {
+        return true;
+    }
+
+    bool okay() const override
+    {
+        return true;
+    }
+
+    bool spin_once() override
+    {
+        ++spins;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return true;
+    }
+
+    std::atomic<std::size_t> spins{0};
+};
+
+} //  anonymous namespace
+
+/**
+ * Registered during static initialization, as the SystemHandles of a static bundle are.
+ */
+IS_REGISTER_SYSTEM("registry_test_linked", CountingSystem)
+
+TEST(SystemHandleRegistry, Handles_are_shared_while_they_are_used)
+{
+    SystemHandleRegistry registry;
+
+    std::size_t loads = 0;
+    auto load = [&]()
+            {
+                ++loads;
+                SystemHandleInfo info(std::make_shared<CountingSystem>());
+                info.types.emplace("Message", xtypes::StructType("Message"));
+                return info;
+            };
+
+    const std::string key = SystemHandleRegistry::key("mock", YAML::Load("{ type: mock }"));
+
+    {
+        SystemHandleInfo first = registry.acquire(key, {"Message"}, load);
+        SystemHandleInfo second = registry.acquire(key, {"Message"}, load);
+        ASSERT_TRUE(first.shared);
+        ASSERT_EQ(first.handle.get(), second.handle.get());
+        ASSERT_EQ(loads, 1u);
+        ASSERT_EQ(registry.size(), 1u);
+
+        /**
+         * Handles lacking some required type, or configured differently, are not reused.
+         */
+        SystemHandleInfo other = registry.acquire(key, {"Message", "Other"}, load);
+        SystemHandleInfo different = registry.acquire(
+            SystemHandleRegistry::key("mock", YAML::Load("{ type: mock, domain: 1 }")), {}, load);
+        ASSERT_NE(other.handle.get(), first.handle.get());
+        ASSERT_NE(different.handle.get(), first.handle.get());
+        ASSERT_EQ(loads, 3u);
+
+        /**
+         * The registry spins the shared handles.
+         */
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        ASSERT_GT(static_cast<CountingSystem*>(first.handle.get())->spins.load(), 0u);
+
+        /**
+         * Callbacks are parked while the SystemHandle may still call them.
+         */
+        bool detached = false;
+        bool subscribed = true;
+        std::shared_ptr<int> callbacks = std::make_shared<int>(0);
+        const std::weak_ptr<int> parked = callbacks;
+        eprosima::is::internal::SystemHandleInfoMap info_map;
+        info_map.emplace("mock", std::move(first));
+        registry.release(info_map, [&]()
+                {
+                    detached = true;
+                }, callbacks, [&]()
+                {
+                    return subscribed;
+                });
+        ASSERT_TRUE(detached);
+
+        callbacks.reset();
+        info_map.clear();
+        ASSERT_EQ(registry.size(), 3u);
+        ASSERT_FALSE(parked.expired());
+
+        /**
+         * They are dropped by the next release, once nothing points to them anymore.
+         */
+        subscribed = false;
+        info_map.emplace("mock", std::move(second));
+        registry.release(info_map, []()
+                {
+                }, std::make_shared<int>(0), []()
+                {
+                    return false;
+                });
+        ASSERT_TRUE(parked.expired());
+
+        info_map.clear();
+    }
+
+    ASSERT_EQ(registry.size(), 0u);
+}
+
+TEST(SystemHandleRegistry, Handles_are_loaded_without_blocking_the_registry)
+{
+    SystemHandleRegistry registry;
+
+    std::promise<void> release_load;
+    std::shared_future<void> released = release_load.get_future().share();
+    std::atomic<std::size_t> loads{0};
+    auto slow_load = [&]()
+            {
+                ++loads;
+                released.wait();
+                return SystemHandleInfo(std::make_shared<CountingSystem>());
+            };
+    auto load = []()
+            {
+                return SystemHandleInfo(std::make_shared<CountingSystem>());
+            };
+
+    const std::string key = SystemHandleRegistry::key("mock", YAML::Load("{ type: mock }"));
+
+    std::shared_ptr<eprosima::is::SystemHandle> first_handle;
+    std::shared_ptr<eprosima::is::SystemHandle> second_handle;
+    std::thread first([&]()
+            {
+                first_handle = registry.acquire(key, {}, slow_load).handle;
+            });
+
+    while (loads == 0)
+    {
+        std::this_thread::yield();
+    }
+
+    std::thread second([&]()
+            {
+                second_handle = registry.acquire(key, {}, slow_load).handle;
+            });
+
+    /**
+     * Another key is loaded while the first one is still being configured.
+     */
+    SystemHandleInfo other = registry.acquire(
+        SystemHandleRegistry::key("mock", YAML::Load("{ type: mock, domain: 1 }")), {}, load);
+    ASSERT_TRUE(other);
+
+    release_load.set_value();
+    first.join();
+    second.join();
+
+    /**
+     * The concurrent caller for the same key waited for the first load, and reused it.
+     */
+    ASSERT_EQ(loads.load(), 1u);
+    ASSERT_TRUE(first_handle);
+    ASSERT_EQ(first_handle.get(), second_handle.get());
+}
+
+TEST(SystemHandleRegistry, Linked_handles_are_registered_before_main)
+{
+    ASSERT_TRUE(Register::contains("registry_test_linked"));
+    ASSERT_FALSE(Register::contains("registry_test_missing"));
+
+    SystemHandleInfo info = Register::get("registry_test_linked");
+    ASSERT_TRUE(info);
+    ASSERT_NE(dynamic_cast<CountingSystem*>(info.handle.get()), nullptr);
+}
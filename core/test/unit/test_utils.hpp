@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_CORE_TEST_UNIT_TEST_UTILS_HPP_
+#define _IS_CORE_TEST_UNIT_TEST_UTILS_HPP_
+
+#include <is/core/Config.hpp>
+#include <is/systemhandle/SystemHandle.hpp>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace core {
+namespace test {
+
+/**
+ * @class CountingClient
+ *        ServiceClient that counts the replies and cancellations it gets,
+ *        and keeps the first member of the last reply, which must be an `int32_t`.
+ */
+class CountingClient : public ServiceClient
+{
+public:
+
+    void receive_response(
+            std::shared_ptr<void> /*call_handle*/,
+            const eprosima::xtypes::DynamicData& response) override
+    {
+        last = response[0].value<int32_t>();
+        ++responses;
+    }
+
+    void receive_cancellation(
+            std::shared_ptr<void> /*call_handle*/) override
+    {
+        ++cancellations;
+    }
+
+    std::atomic<int32_t> last{0};
+    std::atomic<int> responses{0};
+    std::atomic<int> cancellations{0};
+};
+
+/**
+ * @brief Builds a configuration bridging the topics given in YAML between the mock systems
+ *        `a` and `b`, through the routes `a_to_b` and `b_to_a`, where the type `Hello` is
+ *        `struct Hello { string data; };`.
+ *
+ * @param[in] topics The YAML entries of the `topics` section.
+ *
+ * @param[in] other_systems The YAML entries of other systems to add to the `systems` section.
+ */
+inline internal::Config make_config(
+        const std::string& topics,
+        const std::string& other_systems = "")
+{
+    return internal::Config(YAML::Load(
+                       "types:\n"
+                       "    idls:\n"
+                       "        - >\n"
+                       "            struct Hello { string data; };\n"
+                       "systems:\n"
+                       "    a: { type: mock }\n"
+                       "    b: { type: mock }\n"
+                       + other_systems +
+                       "routes:\n"
+                       "    a_to_b: { from: a, to: b }\n"
+                       "    b_to_a: { from: b, to: a }\n"
+                       "topics:\n"
+                       + topics));
+}
+
+/**
+ * @brief Mimics the registries of the running SystemHandles `a` and `b`,
+ *        each one with its own definition of the type.
+ */
+inline is::internal::SystemHandleInfoMap make_info_map(
+        const eprosima::xtypes::DynamicType& a_type,
+        const eprosima::xtypes::DynamicType& b_type,
+        const std::string& type_name = "Hello")
+{
+    is::internal::SystemHandleInfoMap info_map;
+
+    is::internal::SystemHandleInfo a_info(nullptr);
+    a_info.types.emplace(type_name, eprosima::xtypes::DynamicType::Ptr(a_type));
+    info_map.emplace("a", std::move(a_info));
+
+    is::internal::SystemHandleInfo b_info(nullptr);
+    b_info.types.emplace(type_name, eprosima::xtypes::DynamicType::Ptr(b_type));
+    info_map.emplace("b", std::move(b_info));
+
+    return info_map;
+}
+
+/**
+ * @brief Mimics the registries of the running SystemHandles `a` and `b`, which learnt
+ *        the type with the name the topics required it.
+ */
+inline is::internal::SystemHandleInfoMap make_info_map(
+        const eprosima::xtypes::DynamicType& type,
+        const std::string& type_name)
+{
+    return make_info_map(type, type, type_name);
+}
+
+/**
+ * @brief Builds the type `Hello`, whose `data` member has the given type.
+ */
+inline eprosima::xtypes::StructType hello_type(
+        const eprosima::xtypes::DynamicType& data_type = eprosima::xtypes::StringType())
+{
+    eprosima::xtypes::StructType type("Hello");
+    type.add_member("data", data_type);
+    return type;
+}
+
+} //  namespace test
+} //  namespace core
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_CORE_TEST_UNIT_TEST_UTILS_HPP_
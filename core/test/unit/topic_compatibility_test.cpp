@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/Config.hpp>
+
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+
+namespace xtypes = eprosima::xtypes;
+namespace is = eprosima::is;
+using is::core::internal::Config;
+using is::core::internal::TopicConfig;
+using is::core::test::hello_type;
+using is::core::test::make_config;
+using is::core::test::make_info_map;
+
+namespace {
+
+TopicConfig make_topic()
+{
+    TopicConfig topic;
+    topic.message_type = "Hello";
+    topic.route.from = {"a"};
+    topic.route.to = {"b"};
+    return topic;
+}
+
+} //  anonymous namespace
+
+TEST(TopicCompatibility, Destination_types_are_taken_from_the_destination_system)
+{
+    const Config config = make_config("    chatter: { type: Hello, route: a_to_b }\n");
+    ASSERT_TRUE(config);
+
+    const xtypes::StructType text = hello_type(xtypes::StringType());
+    const xtypes::StructType number = hello_type(xtypes::primitive_type<uint32_t>());
+    const xtypes::StructType wide_number = hello_type(xtypes::primitive_type<uint64_t>());
+
+    ASSERT_TRUE(config.check_topic_compatibility(make_info_map(text, text), "chatter", make_topic()));
+
+    /**
+     * The type of the destination is the one known by the destination system,
+     * even though both systems name it alike.
+     */
+    ASSERT_FALSE(config.check_topic_compatibility(make_info_map(text, number), "chatter", make_topic()));
+
+    // Compatible types are still allowed, with the policies that make them so.
+    ASSERT_TRUE(config.check_topic_compatibility(make_info_map(number, wide_number), "chatter", make_topic()));
+}
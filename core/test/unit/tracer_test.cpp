@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/Tracer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+using eprosima::is::core::Tracer;
+
+namespace {
+
+class RecordingSink : public Tracer::Sink
+{
+public:
+
+    void write(
+            const Tracer::Trace& trace) override
+    {
+        traces.push_back(trace);
+    }
+
+    std::vector<Tracer::Trace> traces;
+};
+
+} //  anonymous namespace
+
+TEST(Tracer, One_out_of_every_n_messages_is_traced)
+{
+    auto sink = std::make_shared<RecordingSink>();
+    Tracer tracer(4, sink);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        std::unique_ptr<Tracer::Trace> trace = tracer.start("topic", "source");
+        if (trace)
+        {
+            trace->add("publish destination", trace->received, i != 8);
+            tracer.finish(std::move(trace));
+        }
+    }
+
+    ASSERT_EQ(tracer.traced(), 3u);
+    ASSERT_EQ(sink->traces.size(), 3u);
+    ASSERT_EQ(sink->traces[0].topic, "topic");
+    ASSERT_EQ(sink->traces[0].spans.size(), 1u);
+    ASSERT_TRUE(sink->traces[0].spans[0].success);
+    ASSERT_FALSE(sink->traces[2].spans[0].success);
+    ASSERT_LE(sink->traces[0].received, sink->traces[0].finished);
+}
+
+TEST(Tracer, File_sinks)
+{
+    ASSERT_FALSE(Tracer::file_sink("unknown", "traces.log"));
+
+    const std::string path = "tracer_test_traces.json";
+    std::remove(path.c_str());
+
+    {
+        Tracer tracer(1, Tracer::file_sink("otlp", path));
+        std::unique_ptr<Tracer::Trace> trace = tracer.start("hello \"world\"", "ros2");
+        trace->add("convert Message", trace->received);
+        tracer.finish(std::move(trace));
+    }
+
+    std::ifstream file(path);
+    std::string line;
+    ASSERT_TRUE(std::getline(file, line));
+    ASSERT_NE(line.find(R"("resourceSpans")"), std::string::npos);
+    ASSERT_NE(line.find(R"("name":"route hello \"world\"")"), std::string::npos);
+    ASSERT_NE(line.find(R"("parentSpanId")"), std::string::npos);
+    ASSERT_FALSE(std::getline(file, line));
+
+    std::remove(path.c_str());
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/TrafficReader.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+
+namespace xtypes = eprosima::xtypes;
+using eprosima::is::core::TrafficReader;
+using eprosima::is::core::TrafficRecorder;
+
+TEST(TrafficRecorder, Encoded_messages_are_decoded_back)
+{
+    xtypes::StructType inner("Inner");
+    inner.add_member("flag", xtypes::primitive_type<bool>());
+    inner.add_member("samples", xtypes::ArrayType(xtypes::primitive_type<float>(), 2));
+
+    xtypes::StructType type("Message");
+    type.add_member("value", xtypes::primitive_type<int32_t>());
+    type.add_member("text", xtypes::StringType());
+    type.add_member("numbers", xtypes::SequenceType(xtypes::primitive_type<uint16_t>()));
+    type.add_member("inner", inner);
+
+    xtypes::DynamicData message(type);
+    message["value"] = int32_t(-42);
+    message["text"] = std::string("Hello");
+    message["numbers"].push(uint16_t(1));
+    message["numbers"].push(uint16_t(2));
+    message["inner"]["flag"] = true;
+    message["inner"]["samples"][1] = 2.5f;
+
+    std::string encoded;
+    ASSERT_TRUE(TrafficRecorder::encode(message, encoded));
+
+    xtypes::DynamicData decoded(type);
+    ASSERT_TRUE(TrafficRecorder::decode(
+                reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size(), decoded));
+    ASSERT_EQ(message, decoded);
+
+    // Truncated inputs are rejected.
+    ASSERT_FALSE(TrafficRecorder::decode(
+                reinterpret_cast<const uint8_t*>(encoded.data()), encoded.size() - 1, decoded));
+}
+
+TEST(TrafficRecorder, Samples_are_read_back_across_segments)
+{
+    xtypes::StructType type("Message");
+    type.add_member("text", xtypes::StringType());
+
+    const std::string path = "traffic_recorder_test.iscap";
+    std::remove(path.c_str());
+
+    {
+        // Tiny segments, so that the file grows several times.
+        std::shared_ptr<TrafficRecorder> recorder = TrafficRecorder::create(path, 32);
+        ASSERT_TRUE(recorder);
+
+        xtypes::DynamicData message(type);
+        for (int i = 0; i < 10; ++i)
+        {
+            message["text"] = std::string("message ") + std::to_string(i);
+            recorder->record(TrafficRecorder::Kind::MESSAGE, "chatter", message);
+        }
+        recorder->record(TrafficRecorder::Kind::REQUEST, "service", message);
+        ASSERT_EQ(recorder->recorded(), 11u);
+    }
+
+    std::unique_ptr<TrafficReader> reader = TrafficReader::open(path);
+    ASSERT_TRUE(reader);
+
+    TrafficReader::Sample sample;
+    std::chrono::nanoseconds previous(0);
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(reader->next(sample));
+        ASSERT_EQ(sample.kind, TrafficRecorder::Kind::MESSAGE);
+        ASSERT_EQ(sample.name, "chatter");
+        ASSERT_EQ(sample.type, "Message");
+        ASSERT_GE(sample.timestamp, previous);
+        previous = sample.timestamp;
+
+        xtypes::DynamicData decoded(type);
+        ASSERT_TRUE(TrafficRecorder::decode(sample.payload, sample.size, decoded));
+        ASSERT_EQ(decoded["text"].value<std::string>(), std::string("message ") + std::to_string(i));
+    }
+
+    ASSERT_TRUE(reader->next(sample));
+    ASSERT_EQ(sample.kind, TrafficRecorder::Kind::REQUEST);
+    ASSERT_EQ(sample.name, "service");
+    ASSERT_FALSE(reader->next(sample));
+
+    reader->rewind();
+    ASSERT_TRUE(reader->next(sample));
+    ASSERT_EQ(sample.name, "chatter");
+
+    reader.reset();
+    std::remove(path.c_str());
+}
+
+TEST(TrafficRecorder, Unsupported_types_are_not_recorded)
+{
+    xtypes::StructType type("Message");
+    type.add_member("entries", xtypes::MapType(xtypes::StringType(), xtypes::primitive_type<int32_t>()));
+
+    std::string encoded;
+    ASSERT_FALSE(TrafficRecorder::encode(xtypes::DynamicData(type), encoded));
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/TypeTable.hpp>
+
+#include <gtest/gtest.h>
+
+namespace xtypes = eprosima::xtypes;
+namespace is = eprosima::is;
+using is::core::TypeTable;
+
+namespace {
+
+xtypes::DynamicType::Ptr hello_type(
+        const xtypes::DynamicType& data_type)
+{
+    xtypes::StructType type("Hello");
+    type.add_member("data", data_type);
+    return xtypes::DynamicType::Ptr(type);
+}
+
+} //  anonymous namespace
+
+TEST(TypeTable, Equal_types_are_interned_once)
+{
+    TypeTable table;
+
+    TypeTable::Lease first_lease;
+    const xtypes::DynamicType::Ptr first = table.intern(hello_type(xtypes::StringType()), first_lease);
+
+    TypeTable::Lease second_lease;
+    const xtypes::DynamicType::Ptr second = table.intern(hello_type(xtypes::StringType()), second_lease);
+
+    ASSERT_EQ(first.get(), second.get());
+    ASSERT_EQ(table.size(), 1u);
+    ASSERT_EQ(table.type(table.id(*first)), first.get());
+
+    // Types with the same name but a different definition are kept apart.
+    TypeTable::Lease other_lease;
+    const xtypes::DynamicType::Ptr other =
+            table.intern(hello_type(xtypes::primitive_type<uint32_t>()), other_lease);
+
+    ASSERT_NE(other.get(), first.get());
+    ASSERT_NE(table.id(*other), table.id(*first));
+    ASSERT_EQ(table.size(), 2u);
+}
+
+TEST(TypeTable, Types_are_removed_with_their_last_lease)
+{
+    TypeTable table;
+
+    TypeTable::Lease lease;
+    const xtypes::DynamicType::Ptr type = table.intern(hello_type(xtypes::StringType()), lease);
+    const TypeTable::TypeId id = table.id(*type);
+
+    TypeTable::Lease copy = lease;
+    lease.reset();
+    ASSERT_EQ(table.size(), 1u);
+
+    copy.reset();
+    ASSERT_EQ(table.size(), 0u);
+    ASSERT_EQ(table.id(*type), TypeTable::INVALID_ID);
+    ASSERT_EQ(table.type(id), nullptr);
+
+    /**
+     * Interning and releasing the types of every reload does not grow the table.
+     */
+    for (int reload = 0; reload < 10; ++reload)
+    {
+        TypeTable::Lease reload_lease;
+        table.intern(hello_type(xtypes::StringType()), reload_lease);
+        ASSERT_EQ(table.size(), 1u);
+    }
+    ASSERT_EQ(table.size(), 0u);
+}
+
+TEST(TypeTable, Leading_scopes_are_stripped)
+{
+    ASSERT_EQ(TypeTable::unscoped("::Hello"), "Hello");
+    ASSERT_EQ(TypeTable::unscoped("::pkg::Hello"), "pkg::Hello");
+    ASSERT_EQ(TypeTable::unscoped("pkg::Hello"), "pkg::Hello");
+    ASSERT_EQ(TypeTable::unscoped("Hello"), "Hello");
+}
+
+TEST(TypeTable, Types_are_found_with_and_without_leading_scope)
+{
+    is::TypeRegistry types;
+    types.emplace("pkg::Hello", hello_type(xtypes::StringType()));
+
+    const auto scoped = TypeTable::find_type(types, "::pkg::Hello");
+    const auto unscoped = TypeTable::find_type(types, "pkg::Hello");
+    ASSERT_NE(scoped, types.end());
+    ASSERT_EQ(scoped, unscoped);
+
+    ASSERT_EQ(TypeTable::find_type(types, "Hello"), types.end());
+    ASSERT_EQ(TypeTable::find_type(types, "::Hello"), types.end());
+
+    ASSERT_EQ(TypeTable::type_at(types, "::pkg::Hello").get(), scoped->second.get());
+    ASSERT_THROW(TypeTable::type_at(types, "::Hello"), std::out_of_range);
+}
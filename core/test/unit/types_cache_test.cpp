@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/runtime/TypesCache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <experimental/filesystem>
+#include <random>
+
+namespace xtypes = eprosima::xtypes;
+namespace fs = std::experimental::filesystem;
+using eprosima::is::core::TypesCache;
+
+namespace {
+
+/**
+ * Types using every kind supported by the cache, sharing some of them.
+ */
+TypesCache::Types supported_types()
+{
+    xtypes::EnumerationType<uint32_t> status("pkg::Status");
+    status.add_enumerator("OK", 0);
+    status.add_enumerator("FAILED", 7);
+
+    const xtypes::AliasType stamp(xtypes::primitive_type<uint64_t>(), "pkg::Stamp");
+
+    xtypes::StructType header("pkg::Header");
+    header.add_member(xtypes::Member("id", xtypes::primitive_type<uint32_t>()).key(true));
+    header.add_member("frame", xtypes::StringType(16));
+    header.add_member("stamp", stamp);
+
+    xtypes::StructType message("pkg::Message");
+    message.add_member("header", header);
+    message.add_member("status", status);
+    message.add_member("flags", xtypes::ArrayType(xtypes::primitive_type<bool>(), 4));
+    message.add_member("values", xtypes::SequenceType(xtypes::primitive_type<double>(), 10));
+    message.add_member("labels", xtypes::MapType(xtypes::StringType(), xtypes::WStringType(), 5));
+    message.add_member("history", xtypes::SequenceType(header));
+
+    TypesCache::Types types;
+    types.emplace("pkg::Status", xtypes::DynamicType::Ptr(status));
+    types.emplace("pkg::Stamp", xtypes::DynamicType::Ptr(stamp));
+    types.emplace("pkg::Header", xtypes::DynamicType::Ptr(header));
+    types.emplace("pkg::Message", xtypes::DynamicType::Ptr(message));
+    return types;
+}
+
+void expect_equal(
+        const TypesCache::Types& restored,
+        const TypesCache::Types& original)
+{
+    ASSERT_EQ(restored.size(), original.size());
+    for (const auto& [name, type] : original)
+    {
+        const auto it = restored.find(name);
+        ASSERT_NE(it, restored.end()) << name;
+        EXPECT_EQ(it->second->name(), type->name());
+        EXPECT_EQ(it->second->is_compatible(*type), xtypes::TypeConsistency::EQUALS) << name;
+    }
+}
+
+} //  anonymous namespace
+
+TEST(TypesCache, Serialized_types_are_restored)
+{
+    const TypesCache::Types types = supported_types();
+
+    std::string serialized;
+    ASSERT_TRUE(TypesCache::serialize(types, serialized));
+
+    TypesCache::Types restored;
+    ASSERT_TRUE(TypesCache::deserialize(serialized, restored));
+    expect_equal(restored, types);
+
+    const auto& message = static_cast<const xtypes::StructType&>(*restored.at("pkg::Message"));
+    ASSERT_TRUE(message.member("header").type().kind() == xtypes::TypeKind::STRUCTURE_TYPE);
+    ASSERT_TRUE(static_cast<const xtypes::StructType&>(message.member("header").type()).member("id").is_key());
+}
+
+TEST(TypesCache, Unsupported_types_are_not_serialized)
+{
+    xtypes::StructType base("Base");
+    base.add_member("id", xtypes::primitive_type<uint32_t>());
+    const xtypes::StructType derived("Derived", &base);
+
+    xtypes::StructType optional("Optional");
+    optional.add_member(xtypes::Member("value", xtypes::primitive_type<int32_t>()).optional(true));
+
+    for (const xtypes::StructType* type : {&derived, &optional})
+    {
+        TypesCache::Types types;
+        types.emplace(type->name(), xtypes::DynamicType::Ptr(*type));
+
+        std::string serialized;
+        ASSERT_FALSE(TypesCache::serialize(types, serialized)) << type->name();
+    }
+}
+
+TEST(TypesCache, Truncated_and_corrupted_inputs_are_rejected)
+{
+    const TypesCache::Types types = supported_types();
+
+    std::string serialized;
+    ASSERT_TRUE(TypesCache::serialize(types, serialized));
+
+    /**
+     * Failing inputs leave the output untouched.
+     */
+    TypesCache::Types restored;
+    for (std::size_t size = 0; size < serialized.size(); ++size)
+    {
+        ASSERT_FALSE(TypesCache::deserialize(serialized.substr(0, size), restored)) << size;
+        ASSERT_TRUE(restored.empty());
+    }
+    ASSERT_FALSE(TypesCache::deserialize(serialized + '\0', restored));
+
+    std::string other_version = serialized;
+    ++other_version[4];
+    ASSERT_FALSE(TypesCache::deserialize(other_version, restored));
+    ASSERT_TRUE(restored.empty());
+}
+
+TEST(TypesCache, Stored_types_are_loaded_for_the_same_idl_and_include_paths)
+{
+    const fs::path directory = fs::temp_directory_path()
+            / ("is_types_cache_test_" + std::to_string(std::random_device()()));
+    const TypesCache cache((directory / "nested").string());
+
+    const TypesCache::Types types = supported_types();
+    const std::string idl = "module pkg { struct Message { uint32 id; }; };";
+    const std::vector<std::string> include_paths = {"/opt/idl"};
+
+    TypesCache::Types restored;
+    ASSERT_FALSE(cache.load(idl, include_paths, restored));
+
+    ASSERT_TRUE(cache.store(idl, include_paths, types));
+    ASSERT_TRUE(cache.load(idl, include_paths, restored));
+    expect_equal(restored, types);
+
+    TypesCache::Types missing;
+    ASSERT_FALSE(cache.load(idl + " ", include_paths, missing));
+    ASSERT_FALSE(cache.load(idl, {}, missing));
+    ASSERT_FALSE(cache.load(idl, {"/opt/idl", "/opt/more"}, missing));
+
+    fs::remove_all(directory);
+}
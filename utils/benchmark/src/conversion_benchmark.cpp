@@ -0,0 +1,613 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/core/runtime/FieldToString.hpp>
+#include <is/core/runtime/StringTemplate.hpp>
+#include <is/json-xtypes/conversion.hpp>
+#include <is/utils/Convert.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * This translation unit provides the `is-conversion-benchmarks` command line program, which
+ * measures the time taken by each of the conversion kernels used along the routing path,
+ * for some representative message shapes, so that they can be compared between releases.
+ */
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+namespace xtypes = eprosima::xtypes;
+namespace json_xtypes = eprosima::is::json_xtypes;
+
+/**
+ * Results of the kernels are accumulated here, so that the compiler cannot discard them.
+ */
+volatile std::size_t sink = 0;
+
+/**
+ * @struct Options
+ * @brief Command line options of the benchmark.
+ */
+struct Options
+{
+    std::chrono::milliseconds time = std::chrono::milliseconds(200);
+    std::string format = "table";
+    std::vector<std::string> kernels;
+};
+
+/**
+ * @struct Result
+ * @brief The measurement of a kernel for a message shape.
+ */
+struct Result
+{
+    std::string kernel;
+    std::string shape;
+    std::size_t iterations;
+    double ns_per_op;
+};
+
+/**
+ * @struct Shape
+ * @brief A representative message shape, along with a compatible type with wider members,
+ *        used to measure the conversions between compatible types.
+ */
+struct Shape
+{
+    std::string name;
+    xtypes::StructType type;
+    xtypes::StructType wide_type;
+    std::string template_string;
+};
+
+/**
+ * Plain C++ counterpart of the `flat` shape, converted member by member through
+ * the `is::utils::Convert` kernels, as the generated code of a SystemHandle converts
+ * its middleware native types.
+ */
+struct NativeFlat
+{
+    int32_t id;
+    double value;
+    bool flag;
+    std::string name;
+    uint64_t stamp;
+};
+
+struct FlatConvert
+{
+    template<typename Type>
+    using Convert = eprosima::is::utils::Convert<Type>;
+
+    static void from_xtype_field(
+            const xtypes::ReadableDynamicDataRef& from,
+            NativeFlat& to)
+    {
+        Convert<int32_t>::from_xtype_field(from["id"], to.id);
+        Convert<double>::from_xtype_field(from["value"], to.value);
+        Convert<bool>::from_xtype_field(from["flag"], to.flag);
+        Convert<std::string>::from_xtype_field(from["name"], to.name);
+        Convert<uint64_t>::from_xtype_field(from["stamp"], to.stamp);
+    }
+
+    static void to_xtype_field(
+            const NativeFlat& from,
+            xtypes::WritableDynamicDataRef to)
+    {
+        Convert<int32_t>::to_xtype_field(from.id, to["id"]);
+        Convert<double>::to_xtype_field(from.value, to["value"]);
+        Convert<bool>::to_xtype_field(from.flag, to["flag"]);
+        Convert<std::string>::to_xtype_field(from.name, to["name"]);
+        Convert<uint64_t>::to_xtype_field(from.stamp, to["stamp"]);
+    }
+};
+
+//==============================================================================
+void print_usage()
+{
+    std::cout
+        << "Usage: is-conversion-benchmarks [options]\n\n"
+        << "Measures the conversion kernels of Integration Service for several message shapes.\n\n"
+        << "Options:\n"
+        << "  -t, --time <ms>         Time spent measuring each kernel and shape. Default: 200.\n"
+        << "  -f, --format <format>   Output format: table, csv or json. Default: table.\n"
+        << "  -k, --kernel <name>     Runs only the given kernel. It can be repeated.\n"
+        << "                          Kernels: xtypes_to_json, json_to_xtypes, json_codec_write,\n"
+        << "                          json_codec_parse, convert_to_native, convert_from_native,\n"
+        << "                          string_template, field_to_string, compatible_copy.\n"
+        << "  -h, --help              Shows this help.\n";
+}
+
+//==============================================================================
+bool parse_options(
+        int argc,
+        char* argv[],
+        Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help")
+        {
+            print_usage();
+            return false;
+        }
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for option '" << arg << "'" << std::endl;
+            return false;
+        }
+
+        const std::string value = argv[++i];
+        try
+        {
+            if (arg == "-t" || arg == "--time")
+            {
+                options.time = std::chrono::milliseconds(std::stoul(value));
+            }
+            else if (arg == "-f" || arg == "--format")
+            {
+                if (value != "table" && value != "csv" && value != "json")
+                {
+                    throw std::invalid_argument(value);
+                }
+                options.format = value;
+            }
+            else if (arg == "-k" || arg == "--kernel")
+            {
+                options.kernels.push_back(value);
+            }
+            else
+            {
+                std::cerr << "Unknown option '" << arg << "'" << std::endl;
+                return false;
+            }
+        }
+        catch (const std::exception&)
+        {
+            std::cerr << "Invalid value '" << value << "' for option '" << arg << "'" << std::endl;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//==============================================================================
+xtypes::StructType flat_type(
+        const std::string& name,
+        bool wide)
+{
+    xtypes::StructType type(name);
+    if (wide)
+    {
+        type.add_member("id", xtypes::primitive_type<int64_t>());
+    }
+    else
+    {
+        type.add_member("id", xtypes::primitive_type<int32_t>());
+    }
+    type.add_member("value", xtypes::primitive_type<double>());
+    type.add_member("flag", xtypes::primitive_type<bool>());
+    type.add_member("name", xtypes::StringType());
+    type.add_member("stamp", xtypes::primitive_type<uint64_t>());
+    return type;
+}
+
+//==============================================================================
+/**
+ * The shapes measured: a flat structure, nested structures, large primitive sequences and strings.
+ */
+std::vector<Shape> make_shapes()
+{
+    std::vector<Shape> shapes;
+
+    shapes.push_back(Shape{"flat", flat_type("Flat", false), flat_type("WideFlat", true),
+                           "flat/{message.id}/{message.name}"});
+
+    xtypes::StructType header("Header");
+    header.add_member("stamp", xtypes::primitive_type<uint64_t>());
+    header.add_member("frame_id", xtypes::StringType());
+    for (const bool wide : {false, true})
+    {
+        xtypes::StructType nested(wide ? "WideNested" : "Nested");
+        nested.add_member("header", header);
+        nested.add_member("first", flat_type("Flat", wide));
+        nested.add_member("second", flat_type("Flat", wide));
+        nested.add_member("items", xtypes::SequenceType(flat_type("Flat", wide)));
+        if (wide)
+        {
+            shapes.back().wide_type = nested;
+        }
+        else
+        {
+            shapes.push_back(Shape{"nested", nested, nested, "nested/{message.header.frame_id}/{message.first.id}"});
+        }
+    }
+
+    for (const bool wide : {false, true})
+    {
+        xtypes::StructType sequences(wide ? "WideSequences" : "Sequences");
+        sequences.add_member("count", wide ? xtypes::primitive_type<int64_t>() : xtypes::primitive_type<int32_t>());
+        sequences.add_member("samples", xtypes::SequenceType(xtypes::primitive_type<double>()));
+        sequences.add_member("indexes", xtypes::SequenceType(xtypes::primitive_type<int32_t>()));
+        if (wide)
+        {
+            shapes.back().wide_type = sequences;
+        }
+        else
+        {
+            shapes.push_back(Shape{"sequences", sequences, sequences, "sequences/{message.count}"});
+        }
+    }
+
+    for (const bool wide : {false, true})
+    {
+        xtypes::StructType strings(wide ? "WideStrings" : "Strings");
+        strings.add_member("count", wide ? xtypes::primitive_type<int64_t>() : xtypes::primitive_type<int32_t>());
+        strings.add_member("title", xtypes::StringType());
+        strings.add_member("body", xtypes::StringType());
+        strings.add_member("tags", xtypes::SequenceType(xtypes::StringType()));
+        if (wide)
+        {
+            shapes.back().wide_type = strings;
+        }
+        else
+        {
+            shapes.push_back(Shape{"strings", strings, strings, "strings/{message.title}/{message.count}"});
+        }
+    }
+
+    return shapes;
+}
+
+//==============================================================================
+void fill_flat(
+        xtypes::WritableDynamicDataRef data,
+        int32_t id)
+{
+    data["id"].value<int32_t>(id);
+    data["value"].value<double>(id * 0.5);
+    data["flag"].value<bool>(id % 2 == 0);
+    data["name"].value<std::string>("flat_message_" + std::to_string(id));
+    data["stamp"].value<uint64_t>(1600000000000000000ull + static_cast<uint64_t>(id));
+}
+
+//==============================================================================
+/**
+ * Builds a message of a shape, with representative contents.
+ */
+xtypes::DynamicData make_message(
+        const Shape& shape)
+{
+    xtypes::DynamicData data(shape.type);
+
+    if (shape.name == "flat")
+    {
+        fill_flat(data, 7);
+    }
+    else if (shape.name == "nested")
+    {
+        data["header"]["stamp"].value<uint64_t>(1600000000000000000ull);
+        data["header"]["frame_id"].value<std::string>("base_link");
+        fill_flat(data["first"], 1);
+        fill_flat(data["second"], 2);
+        data["items"].resize(16);
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            fill_flat(data["items"][i], static_cast<int32_t>(i));
+        }
+    }
+    else if (shape.name == "sequences")
+    {
+        data["count"].value<int32_t>(4096);
+        for (std::size_t i = 0; i < 4096; ++i)
+        {
+            data["samples"].push(static_cast<double>(i) * 0.25);
+            data["indexes"].push(static_cast<int32_t>(i));
+        }
+    }
+    else
+    {
+        data["count"].value<int32_t>(16);
+        data["title"].value<std::string>(std::string(64, 't'));
+        data["body"].value<std::string>(std::string(2048, 'b'));
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            data["tags"].push(std::string("tag_") + std::to_string(i));
+        }
+    }
+
+    return data;
+}
+
+/**
+ * @class Benchmark
+ *        Runs every kernel for every shape, each one for the configured time.
+ */
+class Benchmark
+{
+public:
+
+    Benchmark(
+            const Options& options)
+        : _options(options)
+    {
+    }
+
+    void run(
+            const Shape& shape)
+    {
+        const xtypes::DynamicData message = make_message(shape);
+
+        const json_xtypes::Json json = json_xtypes::convert(message);
+        measure("xtypes_to_json", shape, [&]()
+                {
+                    sink = sink + json_xtypes::convert(message).size();
+                });
+        measure("json_to_xtypes", shape, [&]()
+                {
+                    sink = sink + json_xtypes::convert(shape.type, json).size();
+                });
+
+        const json_xtypes::JsonCodec codec(shape.type);
+        const std::string text = codec.write(message);
+        measure("json_codec_write", shape, [&]()
+                {
+                    sink = sink + codec.write(message).size();
+                });
+        measure("json_codec_parse", shape, [&]()
+                {
+                    sink = sink + codec.parse(text).size();
+                });
+
+        measure_native(shape, message);
+
+        eprosima::is::core::StringTemplate string_template(shape.template_string, "benchmark", shape.type);
+        measure("string_template", shape, [&]()
+                {
+                    sink = sink + string_template.compute_string(message).size();
+                });
+
+        if (shape.name == "flat")
+        {
+            measure_field(shape, message["name"], "name");
+        }
+        else if (shape.name == "nested")
+        {
+            measure_field(shape, message["first"]["value"], "value");
+        }
+        else
+        {
+            measure_field(shape, message["count"], "count");
+        }
+
+        measure("compatible_copy", shape, [&]()
+                {
+                    sink = sink + xtypes::DynamicData(message, shape.wide_type).size();
+                });
+    }
+
+    const std::vector<Result>& results() const
+    {
+        return _results;
+    }
+
+private:
+
+    /**
+     * The `is::utils::Convert` kernels, with the native types a SystemHandle would use.
+     */
+    void measure_native(
+            const Shape& shape,
+            const xtypes::DynamicData& message)
+    {
+        if (shape.name == "flat")
+        {
+            NativeFlat native;
+            FlatConvert::from_xtype_field(message, native);
+            measure("convert_to_native", shape, [&]()
+                    {
+                        FlatConvert::from_xtype_field(message, native);
+                        sink = sink + native.name.size();
+                    });
+
+            xtypes::DynamicData data(shape.type);
+            measure("convert_from_native", shape, [&]()
+                    {
+                        FlatConvert::to_xtype_field(native, data);
+                        sink = sink + data.size();
+                    });
+        }
+        else if (shape.name == "sequences")
+        {
+            std::vector<double> samples;
+            measure("convert_to_native", shape, [&]()
+                    {
+                        eprosima::is::utils::Convert<std::vector<double> >::from_xtype_field(
+                            message["samples"], samples);
+                        sink = sink + samples.size();
+                    });
+
+            xtypes::DynamicData data(shape.type);
+            measure("convert_from_native", shape, [&]()
+                    {
+                        eprosima::is::utils::Convert<std::vector<double> >::to_xtype_field(
+                            samples, data["samples"]);
+                        sink = sink + data["samples"].size();
+                    });
+        }
+        else if (shape.name == "strings")
+        {
+            std::vector<std::string> tags;
+            measure("convert_to_native", shape, [&]()
+                    {
+                        eprosima::is::utils::Convert<std::vector<std::string> >::from_xtype_field(
+                            message["tags"], tags);
+                        sink = sink + tags.size();
+                    });
+
+            xtypes::DynamicData data(shape.type);
+            measure("convert_from_native", shape, [&]()
+                    {
+                        eprosima::is::utils::Convert<std::vector<std::string> >::to_xtype_field(
+                            tags, data["tags"]);
+                        sink = sink + data["tags"].size();
+                    });
+        }
+    }
+
+    void measure_field(
+            const Shape& shape,
+            xtypes::ReadableDynamicDataRef field,
+            const std::string& field_name)
+    {
+        const eprosima::is::core::FieldToString field_to_string("benchmark");
+        measure("field_to_string", shape, [&]()
+                {
+                    sink = sink + field_to_string.to_string(field, field_name).size();
+                });
+    }
+
+    /**
+     * Runs a kernel in batches, doubling their size, until the configured time is spent.
+     */
+    void measure(
+            const std::string& kernel,
+            const Shape& shape,
+            const std::function<void()>& body)
+    {
+        if (!_options.kernels.empty()
+                && std::find(_options.kernels.begin(), _options.kernels.end(), kernel) == _options.kernels.end())
+        {
+            return;
+        }
+
+        body(); // Warm up.
+
+        std::size_t iterations = 0;
+        std::size_t batch = 1;
+        const auto start = Clock::now();
+        Clock::duration elapsed = Clock::duration::zero();
+        while (elapsed < _options.time)
+        {
+            for (std::size_t i = 0; i < batch; ++i)
+            {
+                body();
+            }
+            iterations += batch;
+            batch *= 2;
+            elapsed = Clock::now() - start;
+        }
+
+        _results.push_back(Result{kernel, shape.name, iterations,
+                                  std::chrono::duration<double, std::nano>(elapsed).count()
+                                  / static_cast<double>(iterations)});
+    }
+
+    const Options& _options;
+    std::vector<Result> _results;
+};
+
+//==============================================================================
+void print_results(
+        const std::vector<Result>& results,
+        const std::string& format)
+{
+    if (format == "csv")
+    {
+        std::cout << "kernel,shape,iterations,ns_per_op" << std::endl;
+        for (const Result& result : results)
+        {
+            std::cout << result.kernel << "," << result.shape << "," << result.iterations << ","
+                      << std::fixed << std::setprecision(1) << result.ns_per_op << std::endl;
+        }
+    }
+    else if (format == "json")
+    {
+        std::cout << "[" << std::endl;
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result& result = results[i];
+            std::cout << "  {\"kernel\": \"" << result.kernel << "\", \"shape\": \"" << result.shape
+                      << "\", \"iterations\": " << result.iterations << ", \"ns_per_op\": "
+                      << std::fixed << std::setprecision(1) << result.ns_per_op << "}"
+                      << (i + 1 < results.size() ? "," : "") << std::endl;
+        }
+        std::cout << "]" << std::endl;
+    }
+    else
+    {
+        std::cout << std::left
+                  << std::setw(22) << "kernel"
+                  << std::setw(12) << "shape"
+                  << std::right
+                  << std::setw(14) << "ns/op"
+                  << std::setw(14) << "ops/s" << std::endl;
+
+        for (const Result& result : results)
+        {
+            std::cout << std::left
+                      << std::setw(22) << result.kernel
+                      << std::setw(12) << result.shape
+                      << std::right << std::fixed
+                      << std::setprecision(1)
+                      << std::setw(14) << result.ns_per_op
+                      << std::setprecision(0)
+                      << std::setw(14) << (result.ns_per_op > 0.0 ? 1e9 / result.ns_per_op : 0.0) << std::endl;
+        }
+    }
+}
+
+} //  anonymous namespace
+
+int main(
+        int argc,
+        char* argv[])
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        return 1;
+    }
+
+    Benchmark benchmark(options);
+    try
+    {
+        for (const Shape& shape : make_shapes())
+        {
+            benchmark.run(shape);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "The benchmark failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    print_results(benchmark.results(), options.format);
+    return 0;
+}
@@ -0,0 +1,525 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/Instance.hpp>
+#include <is/sh/mock/api.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * This translation unit provides the `is-benchmarks` command line program, which runs an
+ * *Integration Service* instance over several *mock* systems and measures the throughput
+ * and latency of the routing code for some representative kinds of routes.
+ */
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Every topic follows its own kind of route, so that all of them can be configured at once.
+ * Messages carry the time they were published at, to measure their latency when they arrive.
+ */
+const char* const configuration = R"(
+types:
+  idls:
+    - >
+        struct BenchMessage
+        {
+            uint64 stamp;
+            int32 value;
+            string data;
+        };
+
+        struct BenchWideMessage
+        {
+            uint64 stamp;
+            int64 value;
+            string data;
+        };
+
+systems:
+  source: { type: mock }
+  sink_1: { type: mock }
+  sink_2: { type: mock }
+  sink_3: { type: mock }
+
+routes:
+  direct: { from: source, to: sink_1 }
+  fanout: { from: source, to: [ sink_1, sink_2, sink_3 ] }
+  service: { server: sink_1, clients: source }
+
+topics:
+  bench_equals: { type: BenchMessage, route: direct }
+  bench_converted: { type: BenchMessage, route: direct, remap: { sink_1: { type: BenchWideMessage } } }
+  bench_fanout: { type: BenchMessage, route: fanout }
+
+services:
+  bench_service: { type: BenchMessage, route: service }
+)";
+
+//==============================================================================
+uint64_t now_ns()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @class Recorder
+ *        Collects the latency of every message received during a measurement,
+ *        and signals when all the expected ones have arrived.
+ *        Messages can be received from any thread.
+ */
+class Recorder
+{
+public:
+
+    void reset(
+            std::size_t expected)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _samples.assign(expected, 0);
+        _received = 0;
+        _finished = expected == 0;
+    }
+
+    void record(
+            uint64_t latency_ns)
+    {
+        const std::size_t index = _received.fetch_add(1);
+        if (index < _samples.size())
+        {
+            _samples[index] = latency_ns;
+        }
+
+        if (index + 1 == _samples.size())
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _finished = true;
+            _finished_cv.notify_all();
+        }
+    }
+
+    /**
+     * @brief Waits for all the expected messages.
+     *
+     * @returns The number of messages received, which is lower than
+     *          the expected one if there were drops.
+     */
+    std::size_t wait(
+            std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _finished_cv.wait_for(lock, timeout, [this]()
+                {
+                    return _finished;
+                });
+        return std::min(_received.load(), _samples.size());
+    }
+
+    /**
+     * @brief Gets a quantile of the recorded latencies. It must be called after `wait()`.
+     */
+    double quantile_us(
+            double quantile)
+    {
+        const std::size_t count = std::min(_received.load(), _samples.size());
+        if (count == 0)
+        {
+            return 0.0;
+        }
+
+        std::vector<uint64_t> sorted(_samples.begin(), _samples.begin() + static_cast<std::ptrdiff_t>(count));
+        const std::size_t position = std::min(count - 1, static_cast<std::size_t>(quantile * count));
+        std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(position), sorted.end());
+        return static_cast<double>(sorted[position]) / 1000.0;
+    }
+
+private:
+
+    std::vector<uint64_t> _samples;
+    std::atomic<std::size_t> _received{0};
+    bool _finished = true;
+    std::mutex _mutex;
+    std::condition_variable _finished_cv;
+};
+
+/**
+ * @struct Options
+ * @brief Command line options of the benchmark.
+ */
+struct Options
+{
+    std::size_t messages = 100000;
+    std::size_t warmup = 1000;
+    std::chrono::milliseconds timeout = std::chrono::seconds(10);
+    std::size_t threads = 1;
+    double rate = 0.0;
+    std::size_t in_flight = 1;
+    std::size_t min_payload = 0;
+    std::size_t max_payload = 0;
+    std::vector<std::string> scenarios;
+    std::vector<std::string> prefixes;
+};
+
+//==============================================================================
+void print_usage()
+{
+    std::cout
+        << "Usage: is-benchmarks [options]\n\n"
+        << "Measures the routing throughput and latency of Integration Service over mock systems.\n\n"
+        << "Options:\n"
+        << "  -n, --messages <count>  Messages published (or requests made) by each scenario. "
+        << "Default: 100000.\n"
+        << "  -w, --warmup <count>    Messages sent before measuring each scenario. Default: 1000.\n"
+        << "  -t, --timeout <ms>      Time to wait for the messages of each scenario. Default: 10000.\n"
+        << "  -j, --threads <count>   Threads publishing the messages (or making the requests). Default: 1.\n"
+        << "  -r, --rate <msg/s>      Messages (or requests) per second. Default: 0, as fast as possible.\n"
+        << "  -f, --in-flight <count> Requests waiting for their reply at once. Default: 1.\n"
+        << "  -b, --payload <min>[:<max>]\n"
+        << "                          Payload size of the messages, in bytes, uniformly distributed.\n"
+        << "  -s, --scenario <name>   Runs only the given scenario. It can be repeated.\n"
+        << "                          Scenarios: equals, converted, fanout, service.\n"
+        << "  -p, --prefix <path>     Adds a prefix path to look for the mock middleware plugin.\n"
+        << "  -h, --help              Shows this help.\n";
+}
+
+//==============================================================================
+bool parse_options(
+        int argc,
+        char* argv[],
+        Options& options)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help")
+        {
+            print_usage();
+            return false;
+        }
+
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for option '" << arg << "'" << std::endl;
+            return false;
+        }
+
+        const std::string value = argv[++i];
+        try
+        {
+            if (arg == "-n" || arg == "--messages")
+            {
+                options.messages = std::stoul(value);
+            }
+            else if (arg == "-w" || arg == "--warmup")
+            {
+                options.warmup = std::stoul(value);
+            }
+            else if (arg == "-t" || arg == "--timeout")
+            {
+                options.timeout = std::chrono::milliseconds(std::stoul(value));
+            }
+            else if (arg == "-j" || arg == "--threads")
+            {
+                options.threads = std::stoul(value);
+            }
+            else if (arg == "-r" || arg == "--rate")
+            {
+                options.rate = std::stod(value);
+            }
+            else if (arg == "-f" || arg == "--in-flight")
+            {
+                options.in_flight = std::stoul(value);
+            }
+            else if (arg == "-b" || arg == "--payload")
+            {
+                const std::size_t separator = value.find(':');
+                options.min_payload = std::stoul(value.substr(0, separator));
+                options.max_payload = separator == std::string::npos
+                        ? options.min_payload : std::stoul(value.substr(separator + 1));
+            }
+            else if (arg == "-s" || arg == "--scenario")
+            {
+                options.scenarios.push_back(value);
+            }
+            else if (arg == "-p" || arg == "--prefix")
+            {
+                options.prefixes.push_back(value);
+            }
+            else
+            {
+                std::cerr << "Unknown option '" << arg << "'" << std::endl;
+                return false;
+            }
+        }
+        catch (const std::exception&)
+        {
+            std::cerr << "Invalid value '" << value << "' for option '" << arg << "'" << std::endl;
+            return false;
+        }
+    }
+
+    if (options.scenarios.empty())
+    {
+        options.scenarios = {"equals", "converted", "fanout", "service"};
+    }
+
+    return true;
+}
+
+//==============================================================================
+void print_header()
+{
+    std::cout << std::left
+              << std::setw(12) << "scenario"
+              << std::right
+              << std::setw(12) << "sent"
+              << std::setw(12) << "received"
+              << std::setw(14) << "msg/s"
+              << std::setw(12) << "p50 (us)"
+              << std::setw(12) << "p99 (us)" << std::endl;
+}
+
+//==============================================================================
+void print_result(
+        const std::string& scenario,
+        std::size_t sent,
+        std::size_t received,
+        Clock::duration elapsed,
+        Recorder& recorder)
+{
+    const double seconds = std::chrono::duration<double>(elapsed).count();
+
+    std::cout << std::left
+              << std::setw(12) << scenario
+              << std::right << std::fixed
+              << std::setw(12) << sent
+              << std::setw(12) << received
+              << std::setprecision(0)
+              << std::setw(14) << (seconds > 0.0 ? static_cast<double>(received) / seconds : 0.0)
+              << std::setprecision(1)
+              << std::setw(12) << recorder.quantile_us(0.5)
+              << std::setw(12) << recorder.quantile_us(0.99) << std::endl;
+}
+
+/**
+ * @class Benchmark
+ *        Runs each scenario against the running *Integration Service* instance.
+ */
+class Benchmark
+{
+public:
+
+    Benchmark(
+            const Options& options,
+            const eprosima::is::TypeRegistry& types)
+        : _options(options)
+        , _message(*types.at("BenchMessage"))
+    {
+        _message["data"].value<std::string>("Integration Service benchmark payload");
+    }
+
+    bool subscribe()
+    {
+        const auto callback = [this](const eprosima::xtypes::DynamicData& message)
+                {
+                    _recorder.record(now_ns() - message["stamp"].value<uint64_t>());
+                };
+
+        // Messages of the three topics are counted alike: only one scenario runs at a time.
+        return eprosima::is::sh::mock::subscribe("bench_equals", callback)
+               && eprosima::is::sh::mock::subscribe("bench_converted", callback)
+               && eprosima::is::sh::mock::subscribe("bench_fanout", callback);
+    }
+
+    void serve()
+    {
+        eprosima::is::sh::mock::serve("bench_service", [](const eprosima::xtypes::DynamicData& request)
+                {
+                    return request;
+                });
+    }
+
+    bool run(
+            const std::string& scenario)
+    {
+        if (scenario == "equals")
+        {
+            run_topic(scenario, "bench_equals", 1);
+        }
+        else if (scenario == "converted")
+        {
+            run_topic(scenario, "bench_converted", 1);
+        }
+        else if (scenario == "fanout")
+        {
+            run_topic(scenario, "bench_fanout", 3);
+        }
+        else if (scenario == "service")
+        {
+            run_service(scenario);
+        }
+        else
+        {
+            std::cerr << "Unknown scenario '" << scenario << "'" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+private:
+
+    eprosima::is::sh::mock::LoadSettings load(
+            std::size_t count) const
+    {
+        eprosima::is::sh::mock::LoadSettings settings;
+        settings.count = count;
+        settings.rate = _options.rate;
+        settings.threads = _options.threads;
+        settings.stamp_member = "stamp";
+        settings.max_in_flight = _options.in_flight;
+        settings.timeout = _options.timeout;
+        if (_options.max_payload > 0)
+        {
+            settings.payload_member = "data";
+            settings.min_payload = _options.min_payload;
+            settings.max_payload = _options.max_payload;
+        }
+        return settings;
+    }
+
+    void publish(
+            const std::string& topic,
+            std::size_t count)
+    {
+        eprosima::is::sh::mock::publish_load(topic, _message, load(count));
+    }
+
+    void run_topic(
+            const std::string& scenario,
+            const std::string& topic,
+            std::size_t destinations)
+    {
+        _recorder.reset(_options.warmup * destinations);
+        publish(topic, _options.warmup);
+        _recorder.wait(_options.timeout);
+
+        const std::size_t expected = _options.messages * destinations;
+        _recorder.reset(expected);
+
+        const auto start = Clock::now();
+        publish(topic, _options.messages);
+        const std::size_t received = _recorder.wait(_options.timeout);
+        const auto elapsed = Clock::now() - start;
+
+        print_result(scenario, expected, received, elapsed, _recorder);
+    }
+
+    void call(
+            std::size_t count,
+            bool record)
+    {
+        eprosima::is::sh::mock::MockReplyCallback on_reply = nullptr;
+        if (record)
+        {
+            on_reply = [this](const eprosima::xtypes::DynamicData&, std::chrono::nanoseconds round_trip)
+                    {
+                        _recorder.record(static_cast<uint64_t>(round_trip.count()));
+                    };
+        }
+
+        eprosima::is::sh::mock::request_load("bench_service", _message, load(count), std::move(on_reply));
+    }
+
+    void run_service(
+            const std::string& scenario)
+    {
+        call(_options.warmup, false);
+
+        // By default, requests are made one after another, so each of them measures a full round trip.
+        _recorder.reset(_options.messages);
+        const auto start = Clock::now();
+        call(_options.messages, true);
+        const std::size_t received = _recorder.wait(std::chrono::milliseconds(0));
+        const auto elapsed = Clock::now() - start;
+
+        print_result(scenario, _options.messages, received, elapsed, _recorder);
+    }
+
+    const Options& _options;
+    eprosima::xtypes::DynamicData _message;
+    Recorder _recorder;
+};
+
+} //  anonymous namespace
+
+int main(
+        int argc,
+        char* argv[])
+{
+    Options options;
+    if (!parse_options(argc, argv, options))
+    {
+        return 1;
+    }
+
+    eprosima::is::core::InstanceHandle instance =
+            eprosima::is::run_instance(YAML::Load(configuration), options.prefixes);
+    if (!instance)
+    {
+        std::cerr << "Failed to start the Integration Service instance" << std::endl;
+        return 1;
+    }
+
+    const eprosima::is::TypeRegistry* types = instance.type_registry("source");
+    if (types == nullptr || types->find("BenchMessage") == types->end())
+    {
+        std::cerr << "The benchmark types were not registered in the 'source' system" << std::endl;
+        return 1;
+    }
+
+    Benchmark benchmark(options, *types);
+    benchmark.serve();
+    if (!benchmark.subscribe())
+    {
+        std::cerr << "Failed to subscribe to the benchmark topics" << std::endl;
+        return 1;
+    }
+
+    print_header();
+
+    int result = 0;
+    for (const std::string& scenario : options.scenarios)
+    {
+        if (!benchmark.run(scenario))
+        {
+            result = 1;
+        }
+    }
+
+    instance.quit().wait();
+    return result;
+}
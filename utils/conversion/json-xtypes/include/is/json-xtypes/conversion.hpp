@@ -23,6 +23,11 @@
 #include <is/json-xtypes/json.hpp>
 #include <is/core/Message.hpp>
 
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
 namespace xtypes = eprosima::xtypes;
 
 namespace eprosima {
@@ -91,6 +96,431 @@ xtypes::DynamicData IS_JSON_XTYPES_API convert(
         const Json& input,
         const std::string submember = "");
 
+/**
+ * @class JsonCodec
+ *        Converts between JSON text and xTypes DynamicData instances of a given type,
+ *        without building an intermediate Json representation.
+ *
+ *        The layout of the type, that is, the member names, their order and the
+ *        type of every member and element, is resolved once, when the codec is
+ *        constructed. Then, messages are parsed straight from the raw text into the
+ *        DynamicData, and written straight from the DynamicData into a text buffer.
+ *
+ *        The accepted and produced JSON is the same as for the `convert` functions,
+ *        including the `submember` handling, except for the written object members,
+ *        which follow the type member order instead of the alphabetical one.
+ *        Members not present in the type are ignored when parsing.
+ *
+ *        The DynamicType must outlive the codec. A codec can be used from several
+ *        threads at once.
+ */
+class IS_JSON_XTYPES_API JsonCodec
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] type The DynamicType of the messages handled by this codec.
+     *
+     * @param[in] submember The submember of the Json values where each field is stored.
+     *            Defaults to empty.
+     *
+     * @throws UnsupportedType If the type, or some of its members, cannot be converted.
+     */
+    JsonCodec(
+            const xtypes::DynamicType& type,
+            const std::string& submember = "");
+
+    /**
+     * @brief Destructor.
+     */
+    ~JsonCodec();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    JsonCodec(
+            const JsonCodec& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    JsonCodec& operator = (
+            const JsonCodec& other) = delete;
+
+    /**
+     * @brief Gets the DynamicType of the messages handled by this codec.
+     *
+     * @returns The DynamicType given on construction.
+     */
+    const xtypes::DynamicType& type() const;
+
+    /**
+     * @brief Parses a JSON text into a new DynamicData.
+     *
+     * @param[in] text The JSON text to be parsed.
+     *
+     * @returns The resulting DynamicData converted data instance.
+     *
+     * @throws Json::parse_error If the text is not valid JSON, or it nests more than
+     *         256 objects and arrays into each other.
+     *
+     * @throws Json::type_error If some value does not match its field type, or
+     *         some field, or submember, is missing.
+     */
+    xtypes::DynamicData parse(
+            std::string_view text) const;
+
+    /**
+     * @brief Writes a DynamicData as JSON text at the end of a buffer.
+     *
+     * @param[in] input The DynamicData to be written. Its type must be the codec type.
+     *
+     * @param[out] output The buffer where the text is appended. Reusing the same buffer
+     *             for several messages avoids any allocation once it is large enough.
+     */
+    void write(
+            const xtypes::ReadableDynamicDataRef& input,
+            std::string& output) const;
+
+    /**
+     * @brief Writes a DynamicData as JSON text.
+     *
+     * @param[in] input The DynamicData to be written. Its type must be the codec type.
+     *
+     * @returns The JSON text.
+     */
+    std::string write(
+            const xtypes::ReadableDynamicDataRef& input) const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the JsonCodec class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of JsonCodec.
+     *
+     *        Methods named equal to some JsonCodec method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+/**
+ * @class BinaryCodec
+ *        Converts between the *CBOR* or *MessagePack* binary encodings of JSON and
+ *        xTypes DynamicData instances of a given type, walking the type straight
+ *        from and into the binary buffer.
+ *
+ *        The encoded values follow the same layout as the JSON written by a JsonCodec,
+ *        including the `submember` handling, so that decoding them with `Json::from_cbor`
+ *        or `Json::from_msgpack` gives the same Json as `convert`. The only differences
+ *        are floating point values, which keep their native width and are never written
+ *        as strings, and object members, which follow the type member order.
+ *
+ *        The DynamicType must outlive the codec. A codec can be used from several
+ *        threads at once.
+ */
+class IS_JSON_XTYPES_API BinaryCodec
+{
+public:
+
+    /**
+     * @brief The binary encodings supported by the codec.
+     */
+    enum class Format
+    {
+        CBOR,
+        MSGPACK
+    };
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] type The DynamicType of the messages handled by this codec.
+     *
+     * @param[in] format The binary encoding.
+     *
+     * @param[in] submember The submember of the encoded values where each field is stored.
+     *            Defaults to empty.
+     *
+     * @throws UnsupportedType If the type, or some of its members, cannot be converted.
+     */
+    BinaryCodec(
+            const xtypes::DynamicType& type,
+            Format format,
+            const std::string& submember = "");
+
+    /**
+     * @brief Gets the DynamicType of the messages handled by this codec.
+     *
+     * @returns The DynamicType given on construction.
+     */
+    const xtypes::DynamicType& type() const;
+
+    /**
+     * @brief Gets the binary encoding of this codec.
+     *
+     * @returns The format given on construction.
+     */
+    Format format() const;
+
+    /**
+     * @brief Decodes a binary buffer into a new DynamicData.
+     *
+     * @param[in] data The beginning of the buffer.
+     *
+     * @param[in] size The size of the buffer.
+     *
+     * @returns The resulting DynamicData converted data instance.
+     *
+     * @throws Json::parse_error If the buffer is not a valid encoding, or has trailing bytes.
+     *
+     * @throws Json::type_error If some value does not match its field type, or
+     *         some field, or submember, is missing.
+     */
+    xtypes::DynamicData parse(
+            const uint8_t* data,
+            std::size_t size) const;
+
+    /**
+     * @brief Encodes a DynamicData at the end of a binary buffer.
+     *
+     * @param[in] input The DynamicData to be encoded. Its type must be the codec type.
+     *
+     * @param[out] output The buffer where the encoding is appended.
+     */
+    void write(
+            const xtypes::ReadableDynamicDataRef& input,
+            std::vector<uint8_t>& output) const;
+
+    /**
+     * @brief Encodes a DynamicData.
+     *
+     * @param[in] input The DynamicData to be encoded. Its type must be the codec type.
+     *
+     * @returns The binary encoding.
+     */
+    std::vector<uint8_t> write(
+            const xtypes::ReadableDynamicDataRef& input) const;
+
+private:
+
+    const xtypes::DynamicType& _type;
+    const Format _format;
+    const std::string _submember;
+};
+
+/**
+ * @class JsonDeltaEncoder
+ *        Converts the successive messages of some streams, such as the samples of a topic
+ *        sent to a destination, into Json values holding only the members that changed
+ *        since the previous message of the same stream.
+ *
+ *        Nested structures are compared member by member as well, whereas sequences,
+ *        arrays and primitive values are sent whole when they change. Every few messages,
+ *        and for the first message of each stream, a keyframe with all the members is
+ *        produced instead, so that receivers that missed some update or joined late catch up.
+ *
+ *        Receivers rebuild each message by means of `apply`. An encoder can be used
+ *        from several threads at once.
+ */
+class IS_JSON_XTYPES_API JsonDeltaEncoder
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] keyframe_interval A keyframe is produced once every `keyframe_interval`
+     *            messages of each stream. Zero means that only the first message is a keyframe.
+     *
+     * @param[in] submember The submember of the Json values where each field is stored,
+     *            as given to `convert`. Defaults to empty.
+     */
+    JsonDeltaEncoder(
+            std::size_t keyframe_interval = 100,
+            const std::string& submember = "");
+
+    /**
+     * @brief Destructor.
+     */
+    ~JsonDeltaEncoder();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    JsonDeltaEncoder(
+            const JsonDeltaEncoder& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    JsonDeltaEncoder& operator = (
+            const JsonDeltaEncoder& other) = delete;
+
+    /**
+     * @brief Converts a message into the changes since the previous message of its stream.
+     *
+     * @param[in] stream The name of the stream, for instance, the topic name.
+     *
+     * @param[in] message The message.
+     *
+     * @param[out] keyframe Whether the result holds the whole message.
+     *
+     * @returns The changed members, which is an empty object if nothing changed.
+     *
+     * @throws UnsupportedType If the message type cannot be converted.
+     */
+    Json encode(
+            const std::string& stream,
+            const xtypes::DynamicData& message,
+            bool& keyframe);
+
+    /**
+     * @brief Makes the next message of a stream be a keyframe, for instance,
+     *        because a new receiver has joined.
+     *
+     * @param[in] stream The name of the stream.
+     */
+    void reset(
+            const std::string& stream);
+
+    /**
+     * @brief Applies the changes given by `encode()` onto the previous message of a stream.
+     *
+     * @param[in] delta The changes, or a keyframe.
+     *
+     * @param[in,out] state The previous message, which is updated into the current one.
+     */
+    static void apply(
+            const Json& delta,
+            Json& state);
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the JsonDeltaEncoder class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of JsonDeltaEncoder.
+     *
+     *        Methods named equal to some JsonDeltaEncoder method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
+/**
+ * @class JsonTextCache
+ *        Keeps the JSON text of the latest messages, so that a message sent to
+ *        many destinations, such as the clients of a WebSocket server, is written
+ *        only once and then shared by all of them.
+ *
+ *        Messages are identified by their shared pointer, rather than by their address,
+ *        so that an instance reused for a newer message, as done by the DynamicData pools
+ *        of *Integration Service*, is never mistaken for the one it replaces.
+ *        Hence, cached messages must not be modified while the pointer is alive.
+ *
+ *        Texts are written by a JsonCodec whenever the message type supports it, and by
+ *        `convert` otherwise. Codecs are kept by the name of the type, along with their
+ *        own copy of it, so the types of the messages may be destroyed before the cache.
+ *        A cache can be used from several threads at once.
+ */
+class IS_JSON_XTYPES_API JsonTextCache
+{
+public:
+
+    /**
+     * @brief Constructor.
+     *
+     * @param[in] capacity The maximum number of texts kept at once.
+     *            The oldest one is dropped to make room for a new one.
+     */
+    JsonTextCache(
+            std::size_t capacity = 64);
+
+    /**
+     * @brief Destructor.
+     */
+    ~JsonTextCache();
+
+    /**
+     * @brief Deleted copy constructor.
+     */
+    JsonTextCache(
+            const JsonTextCache& other) = delete;
+
+    /**
+     * @brief Deleted copy assignment operator.
+     */
+    JsonTextCache& operator = (
+            const JsonTextCache& other) = delete;
+
+    /**
+     * @brief Gets the JSON text of a message, writing it only the first time it is requested.
+     *
+     * @param[in] message The message.
+     *
+     * @param[in] submember The submember of the Json value where each field is stored.
+     *            Each submember gets its own text. Defaults to empty.
+     *
+     * @returns The JSON text, shared with every other request for the same message and submember.
+     *
+     * @throws UnsupportedType If the message type cannot be converted.
+     */
+    std::shared_ptr<const std::string> text(
+            const std::shared_ptr<const xtypes::DynamicData>& message,
+            const std::string& submember = "");
+
+    /**
+     * @brief Gets the number of texts that were written, instead of being taken from the cache.
+     */
+    uint64_t written() const;
+
+private:
+
+    /**
+     * @class Implementation
+     *        Defines the actual implementation of the JsonTextCache class.
+     *
+     *        Allows to use the *pimpl* procedure to separate the implementation
+     *        from the interface of JsonTextCache.
+     *
+     *        Methods named equal to some JsonTextCache method will not be
+     *        documented again. Usually, the interface class will call
+     *        `_pimpl->method()`, but the functionality and parameters
+     *        are exactly the same.
+     */
+    class Implementation;
+
+    /**
+     * Class members.
+     */
+
+    std::unique_ptr<Implementation> _pimpl;
+};
+
 } //  namespace json_xtypes
 } //  namespace is
 } //  namespace eprosima
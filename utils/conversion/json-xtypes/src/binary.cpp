@@ -0,0 +1,1385 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/json-xtypes/conversion.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace eprosima {
+namespace is {
+namespace json_xtypes {
+
+namespace {
+
+/**
+ * @brief Maximum number of arrays and maps the decoded buffer can nest into each other,
+ *        so that a malicious or corrupted buffer fails to decode instead of exhausting the stack.
+ */
+constexpr std::size_t max_nesting_depth = 256;
+
+//==============================================================================
+const xtypes::DynamicType& resolve(
+        const xtypes::DynamicType& type)
+{
+    return type.kind() == xtypes::TypeKind::ALIAS_TYPE
+           ? static_cast<const xtypes::AliasType&>(type).rget()
+           : type;
+}
+
+//==============================================================================
+/**
+ * @brief Checks that every member and element of a type can be encoded.
+ *
+ * @throws UnsupportedType Otherwise.
+ */
+void check_type(
+        const xtypes::DynamicType& alias)
+{
+    const xtypes::DynamicType& type = resolve(alias);
+    switch (type.kind())
+    {
+        case xtypes::TypeKind::STRUCTURE_TYPE:
+            for (const xtypes::Member& member : static_cast<const xtypes::AggregationType&>(type).members())
+            {
+                check_type(member.type());
+            }
+            break;
+        case xtypes::TypeKind::ARRAY_TYPE:
+        case xtypes::TypeKind::SEQUENCE_TYPE:
+            check_type(static_cast<const xtypes::CollectionType&>(type).content_type());
+            break;
+        case xtypes::TypeKind::STRING_TYPE:
+        case xtypes::TypeKind::BOOLEAN_TYPE:
+        case xtypes::TypeKind::CHAR_8_TYPE:
+        case xtypes::TypeKind::INT_8_TYPE:
+        case xtypes::TypeKind::UINT_8_TYPE:
+        case xtypes::TypeKind::INT_16_TYPE:
+        case xtypes::TypeKind::UINT_16_TYPE:
+        case xtypes::TypeKind::INT_32_TYPE:
+        case xtypes::TypeKind::UINT_32_TYPE:
+        case xtypes::TypeKind::INT_64_TYPE:
+        case xtypes::TypeKind::UINT_64_TYPE:
+        case xtypes::TypeKind::FLOAT_32_TYPE:
+        case xtypes::TypeKind::FLOAT_64_TYPE:
+            break;
+        default:
+            throw UnsupportedType(type.name());
+    }
+}
+
+//==============================================================================
+void put_big_endian(
+        std::vector<uint8_t>& output,
+        uint64_t value,
+        std::size_t bytes)
+{
+    for (std::size_t i = bytes; i > 0; --i)
+    {
+        output.push_back(static_cast<uint8_t>(value >> ((i - 1) * 8)));
+    }
+}
+
+//==============================================================================
+uint32_t float_bits(
+        float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+//==============================================================================
+uint64_t double_bits(
+        double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+/**
+ * @class CborWriter
+ *        Appends CBOR items to a buffer, always in their shortest form.
+ */
+class CborWriter
+{
+public:
+
+    CborWriter(
+            std::vector<uint8_t>& output)
+        : _output(output)
+    {
+    }
+
+    void null()
+    {
+        _output.push_back(0xf6);
+    }
+
+    void boolean(
+            bool value)
+    {
+        _output.push_back(value ? 0xf5 : 0xf4);
+    }
+
+    void unsigned_integer(
+            uint64_t value)
+    {
+        head(0, value);
+    }
+
+    void signed_integer(
+            int64_t value)
+    {
+        if (value >= 0)
+        {
+            head(0, static_cast<uint64_t>(value));
+        }
+        else
+        {
+            head(1, static_cast<uint64_t>(-(value + 1)));
+        }
+    }
+
+    void single(
+            float value)
+    {
+        _output.push_back(0xfa);
+        put_big_endian(_output, float_bits(value), 4);
+    }
+
+    void real(
+            double value)
+    {
+        _output.push_back(0xfb);
+        put_big_endian(_output, double_bits(value), 8);
+    }
+
+    void string(
+            std::string_view value)
+    {
+        head(3, value.size());
+        _output.insert(_output.end(), value.begin(), value.end());
+    }
+
+    void array(
+            std::size_t size)
+    {
+        head(4, size);
+    }
+
+    void map(
+            std::size_t size)
+    {
+        head(5, size);
+    }
+
+private:
+
+    void head(
+            uint8_t major,
+            uint64_t value)
+    {
+        const uint8_t type = static_cast<uint8_t>(major << 5);
+        if (value < 24)
+        {
+            _output.push_back(static_cast<uint8_t>(type | value));
+        }
+        else if (value <= std::numeric_limits<uint8_t>::max())
+        {
+            _output.push_back(type | 24);
+            put_big_endian(_output, value, 1);
+        }
+        else if (value <= std::numeric_limits<uint16_t>::max())
+        {
+            _output.push_back(type | 25);
+            put_big_endian(_output, value, 2);
+        }
+        else if (value <= std::numeric_limits<uint32_t>::max())
+        {
+            _output.push_back(type | 26);
+            put_big_endian(_output, value, 4);
+        }
+        else
+        {
+            _output.push_back(type | 27);
+            put_big_endian(_output, value, 8);
+        }
+    }
+
+    std::vector<uint8_t>& _output;
+};
+
+/**
+ * @class MsgPackWriter
+ *        Appends MessagePack objects to a buffer, always in their shortest form.
+ */
+class MsgPackWriter
+{
+public:
+
+    MsgPackWriter(
+            std::vector<uint8_t>& output)
+        : _output(output)
+    {
+    }
+
+    void null()
+    {
+        _output.push_back(0xc0);
+    }
+
+    void boolean(
+            bool value)
+    {
+        _output.push_back(value ? 0xc3 : 0xc2);
+    }
+
+    void unsigned_integer(
+            uint64_t value)
+    {
+        if (value < 0x80)
+        {
+            _output.push_back(static_cast<uint8_t>(value));
+        }
+        else if (value <= std::numeric_limits<uint8_t>::max())
+        {
+            _output.push_back(0xcc);
+            put_big_endian(_output, value, 1);
+        }
+        else if (value <= std::numeric_limits<uint16_t>::max())
+        {
+            _output.push_back(0xcd);
+            put_big_endian(_output, value, 2);
+        }
+        else if (value <= std::numeric_limits<uint32_t>::max())
+        {
+            _output.push_back(0xce);
+            put_big_endian(_output, value, 4);
+        }
+        else
+        {
+            _output.push_back(0xcf);
+            put_big_endian(_output, value, 8);
+        }
+    }
+
+    void signed_integer(
+            int64_t value)
+    {
+        if (value >= 0)
+        {
+            unsigned_integer(static_cast<uint64_t>(value));
+        }
+        else if (value >= -32)
+        {
+            _output.push_back(static_cast<uint8_t>(value));
+        }
+        else if (value >= std::numeric_limits<int8_t>::min())
+        {
+            _output.push_back(0xd0);
+            put_big_endian(_output, static_cast<uint64_t>(value), 1);
+        }
+        else if (value >= std::numeric_limits<int16_t>::min())
+        {
+            _output.push_back(0xd1);
+            put_big_endian(_output, static_cast<uint64_t>(value), 2);
+        }
+        else if (value >= std::numeric_limits<int32_t>::min())
+        {
+            _output.push_back(0xd2);
+            put_big_endian(_output, static_cast<uint64_t>(value), 4);
+        }
+        else
+        {
+            _output.push_back(0xd3);
+            put_big_endian(_output, static_cast<uint64_t>(value), 8);
+        }
+    }
+
+    void single(
+            float value)
+    {
+        _output.push_back(0xca);
+        put_big_endian(_output, float_bits(value), 4);
+    }
+
+    void real(
+            double value)
+    {
+        _output.push_back(0xcb);
+        put_big_endian(_output, double_bits(value), 8);
+    }
+
+    void string(
+            std::string_view value)
+    {
+        sized(value.size(), 0xa0, 32, 0xd9, 0xda, 0xdb);
+        _output.insert(_output.end(), value.begin(), value.end());
+    }
+
+    void array(
+            std::size_t size)
+    {
+        sized(size, 0x90, 16, 0, 0xdc, 0xdd);
+    }
+
+    void map(
+            std::size_t size)
+    {
+        sized(size, 0x80, 16, 0, 0xde, 0xdf);
+    }
+
+private:
+
+    /**
+     * @brief Writes the header of a string, an array or a map, given the codes of its
+     *        fixed, 8 bits (if any), 16 bits and 32 bits forms.
+     */
+    void sized(
+            std::size_t size,
+            uint8_t fixed,
+            std::size_t fixed_limit,
+            uint8_t code_8,
+            uint8_t code_16,
+            uint8_t code_32)
+    {
+        if (size < fixed_limit)
+        {
+            _output.push_back(static_cast<uint8_t>(fixed | size));
+        }
+        else if (code_8 && size <= std::numeric_limits<uint8_t>::max())
+        {
+            _output.push_back(code_8);
+            put_big_endian(_output, size, 1);
+        }
+        else if (size <= std::numeric_limits<uint16_t>::max())
+        {
+            _output.push_back(code_16);
+            put_big_endian(_output, size, 2);
+        }
+        else
+        {
+            _output.push_back(code_32);
+            put_big_endian(_output, size, 4);
+        }
+    }
+
+    std::vector<uint8_t>& _output;
+};
+
+/**
+ * @brief The kinds of items found while decoding, common to both encodings.
+ */
+enum class Item
+{
+    NIL,
+    BOOLEAN,
+    UNSIGNED,
+    SIGNED,
+    FLOATING,
+    STRING,
+    ARRAY,
+    MAP,
+    OTHER
+};
+
+/**
+ * @struct Number
+ *        A decoded number, kept as it was encoded until its field type is known.
+ */
+struct Number
+{
+    Item kind;
+    uint64_t unsigned_value;
+    int64_t signed_value;
+    double floating_value;
+
+    template<typename T>
+    T as() const
+    {
+        switch (kind)
+        {
+            case Item::UNSIGNED:
+                return static_cast<T>(unsigned_value);
+            case Item::SIGNED:
+                return static_cast<T>(signed_value);
+            default:
+                return static_cast<T>(floating_value);
+        }
+    }
+
+};
+
+/**
+ * @class Cursor
+ *        Bounds checked reading position within a binary buffer.
+ */
+class Cursor
+{
+public:
+
+    /**
+     * @brief Accounts for an array or map of the buffer while it is being read.
+     */
+    class Nesting
+    {
+    public:
+
+        Nesting(
+                Cursor& cursor)
+            : _cursor(cursor)
+        {
+            if (_cursor._depth == max_nesting_depth)
+            {
+                _cursor.parse_error("maximum nesting depth of "
+                        + std::to_string(max_nesting_depth) + " exceeded");
+            }
+            ++_cursor._depth;
+        }
+
+        ~Nesting()
+        {
+            --_cursor._depth;
+        }
+
+    private:
+
+        Cursor& _cursor;
+    };
+
+    Cursor(
+            const uint8_t* data,
+            std::size_t size)
+        : _begin(data)
+        , _current(data)
+        , _end(data + size)
+    {
+    }
+
+    bool at_end() const
+    {
+        return _current == _end;
+    }
+
+    uint8_t peek_byte() const
+    {
+        require(1);
+        return *_current;
+    }
+
+    uint8_t byte()
+    {
+        require(1);
+        return *_current++;
+    }
+
+    uint64_t big_endian(
+            std::size_t bytes)
+    {
+        require(bytes);
+        uint64_t value = 0;
+        for (std::size_t i = 0; i < bytes; ++i)
+        {
+            value = (value << 8) | *_current++;
+        }
+        return value;
+    }
+
+    std::string_view bytes(
+            uint64_t size)
+    {
+        require(size);
+        const std::string_view value(reinterpret_cast<const char*>(_current), static_cast<std::size_t>(size));
+        _current += size;
+        return value;
+    }
+
+    [[noreturn]] void parse_error(
+            const std::string& what) const
+    {
+        throw Json::parse_error::create(110, static_cast<std::size_t>(_current - _begin) + 1, what);
+    }
+
+    /**
+     * @brief Checks the number of elements of an array or map against the rest of the buffer,
+     *        where each of them takes at least one byte, before anything is allocated for them.
+     */
+    std::size_t elements(
+            uint64_t count) const
+    {
+        require(count);
+        return static_cast<std::size_t>(count);
+    }
+
+private:
+
+    void require(
+            uint64_t size) const
+    {
+        if (static_cast<uint64_t>(_end - _current) < size)
+        {
+            parse_error("unexpected end of input");
+        }
+    }
+
+    const uint8_t* const _begin;
+    const uint8_t* _current;
+    const uint8_t* const _end;
+    std::size_t _depth = 0;
+};
+
+/**
+ * @class CborReader
+ *        Reads CBOR items of definite length.
+ */
+class CborReader : public Cursor
+{
+public:
+
+    using Cursor::Cursor;
+
+    Item peek() const
+    {
+        const uint8_t initial = peek_byte();
+        switch (initial >> 5)
+        {
+            case 0: return Item::UNSIGNED;
+            case 1: return Item::SIGNED;
+            case 3: return Item::STRING;
+            case 4: return Item::ARRAY;
+            case 5: return Item::MAP;
+            case 7:
+                switch (initial)
+                {
+                    case 0xf4:
+                    case 0xf5: return Item::BOOLEAN;
+                    case 0xf6:
+                    case 0xf7: return Item::NIL;
+                    case 0xf9:
+                    case 0xfa:
+                    case 0xfb: return Item::FLOATING;
+                    default: return Item::OTHER;
+                }
+            default:
+                return Item::OTHER;
+        }
+    }
+
+    void null()
+    {
+        byte();
+    }
+
+    bool boolean()
+    {
+        return byte() == 0xf5;
+    }
+
+    Number number()
+    {
+        Number number{peek(), 0, 0, 0.0};
+        switch (number.kind)
+        {
+            case Item::UNSIGNED:
+                number.unsigned_value = head();
+                break;
+            case Item::SIGNED:
+                number.signed_value = -1 - static_cast<int64_t>(head());
+                break;
+            default:
+                number.floating_value = floating();
+                break;
+        }
+        return number;
+    }
+
+    std::string_view string()
+    {
+        return bytes(head());
+    }
+
+    std::size_t array()
+    {
+        return elements(head());
+    }
+
+    std::size_t map()
+    {
+        return elements(head());
+    }
+
+    void skip()
+    {
+        const uint8_t initial = peek_byte();
+        switch (initial >> 5)
+        {
+            case 0:
+            case 1:
+                head();
+                break;
+            case 2:
+            case 3:
+                bytes(head());
+                break;
+            case 4:
+            {
+                const Nesting nesting(*this);
+                for (uint64_t size = head(); size > 0; --size)
+                {
+                    skip();
+                }
+                break;
+            }
+            case 5:
+            {
+                const Nesting nesting(*this);
+                for (uint64_t size = head(); size > 0; --size)
+                {
+                    skip();
+                    skip();
+                }
+                break;
+            }
+            case 6:
+            {
+                const Nesting nesting(*this);
+                head();
+                skip();
+                break;
+            }
+            default:
+                head();
+                break;
+        }
+    }
+
+private:
+
+    /**
+     * @brief Reads the argument of the initial byte of an item.
+     */
+    uint64_t head()
+    {
+        const uint8_t additional = byte() & 0x1f;
+        if (additional < 24)
+        {
+            return additional;
+        }
+        if (additional > 27)
+        {
+            parse_error("indefinite length CBOR items are not supported");
+        }
+        return big_endian(std::size_t(1) << (additional - 24));
+    }
+
+    double floating()
+    {
+        switch (byte())
+        {
+            case 0xf9:
+            {
+                // Half precision, as decoded in RFC 7049, appendix D.
+                const uint64_t half = big_endian(2);
+                const int exponent = static_cast<int>((half >> 10) & 0x1f);
+                const double mantissa = static_cast<double>(half & 0x3ff);
+                double value;
+                if (exponent == 0)
+                {
+                    value = std::ldexp(mantissa, -24);
+                }
+                else if (exponent != 31)
+                {
+                    value = std::ldexp(mantissa + 1024, exponent - 25);
+                }
+                else
+                {
+                    value = mantissa == 0
+                            ? std::numeric_limits<double>::infinity()
+                            : std::numeric_limits<double>::quiet_NaN();
+                }
+                return (half & 0x8000) ? -value : value;
+            }
+            case 0xfa:
+            {
+                const uint32_t bits = static_cast<uint32_t>(big_endian(4));
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+            default:
+            {
+                const uint64_t bits = big_endian(8);
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return value;
+            }
+        }
+    }
+
+};
+
+/**
+ * @class MsgPackReader
+ *        Reads MessagePack objects.
+ */
+class MsgPackReader : public Cursor
+{
+public:
+
+    using Cursor::Cursor;
+
+    Item peek() const
+    {
+        const uint8_t initial = peek_byte();
+        if (initial <= 0x7f || (initial >= 0xcc && initial <= 0xcf))
+        {
+            return Item::UNSIGNED;
+        }
+        if (initial >= 0xe0 || (initial >= 0xd0 && initial <= 0xd3))
+        {
+            return Item::SIGNED;
+        }
+        if (initial <= 0x8f || initial == 0xde || initial == 0xdf)
+        {
+            return Item::MAP;
+        }
+        if (initial <= 0x9f || initial == 0xdc || initial == 0xdd)
+        {
+            return Item::ARRAY;
+        }
+        if (initial <= 0xbf || (initial >= 0xd9 && initial <= 0xdb))
+        {
+            return Item::STRING;
+        }
+        switch (initial)
+        {
+            case 0xc0: return Item::NIL;
+            case 0xc2:
+            case 0xc3: return Item::BOOLEAN;
+            case 0xca:
+            case 0xcb: return Item::FLOATING;
+            default: return Item::OTHER;
+        }
+    }
+
+    void null()
+    {
+        byte();
+    }
+
+    bool boolean()
+    {
+        return byte() == 0xc3;
+    }
+
+    Number number()
+    {
+        Number number{peek(), 0, 0, 0.0};
+        const uint8_t initial = byte();
+        if (initial <= 0x7f)
+        {
+            number.unsigned_value = initial;
+        }
+        else if (initial >= 0xe0)
+        {
+            number.signed_value = static_cast<int8_t>(initial);
+        }
+        else if (initial >= 0xcc && initial <= 0xcf)
+        {
+            number.unsigned_value = big_endian(std::size_t(1) << (initial - 0xcc));
+        }
+        else if (initial >= 0xd0 && initial <= 0xd3)
+        {
+            const std::size_t bytes = std::size_t(1) << (initial - 0xd0);
+            const uint64_t bits = big_endian(bytes);
+            // Sign extension of the two's complement value.
+            const uint64_t sign = uint64_t(1) << (bytes * 8 - 1);
+            number.signed_value = static_cast<int64_t>((bits ^ sign) - sign);
+        }
+        else if (initial == 0xca)
+        {
+            const uint32_t bits = static_cast<uint32_t>(big_endian(4));
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            number.floating_value = value;
+        }
+        else
+        {
+            const uint64_t bits = big_endian(8);
+            std::memcpy(&number.floating_value, &bits, sizeof(bits));
+        }
+        return number;
+    }
+
+    std::string_view string()
+    {
+        const uint8_t initial = byte();
+        if (initial <= 0xbf)
+        {
+            return bytes(initial & 0x1f);
+        }
+        return bytes(big_endian(std::size_t(1) << (initial - 0xd9)));
+    }
+
+    std::size_t array()
+    {
+        const uint8_t initial = byte();
+        if (initial <= 0x9f)
+        {
+            return elements(initial & 0x0f);
+        }
+        return elements(big_endian(initial == 0xdc ? 2 : 4));
+    }
+
+    std::size_t map()
+    {
+        const uint8_t initial = byte();
+        if (initial <= 0x8f)
+        {
+            return elements(initial & 0x0f);
+        }
+        return elements(big_endian(initial == 0xde ? 2 : 4));
+    }
+
+    void skip()
+    {
+        switch (peek())
+        {
+            case Item::NIL:
+            case Item::BOOLEAN:
+                byte();
+                break;
+            case Item::UNSIGNED:
+            case Item::SIGNED:
+            case Item::FLOATING:
+                number();
+                break;
+            case Item::STRING:
+                string();
+                break;
+            case Item::ARRAY:
+            {
+                const Nesting nesting(*this);
+                for (std::size_t size = array(); size > 0; --size)
+                {
+                    skip();
+                }
+                break;
+            }
+            case Item::MAP:
+            {
+                const Nesting nesting(*this);
+                for (std::size_t size = map(); size > 0; --size)
+                {
+                    skip();
+                    skip();
+                }
+                break;
+            }
+            case Item::OTHER:
+                skip_other();
+                break;
+        }
+    }
+
+private:
+
+    /**
+     * @brief Skips binary and extension objects.
+     */
+    void skip_other()
+    {
+        const uint8_t initial = byte();
+        switch (initial)
+        {
+            case 0xc4:
+            case 0xc5:
+            case 0xc6:
+                bytes(big_endian(std::size_t(1) << (initial - 0xc4)));
+                break;
+            case 0xc7:
+            case 0xc8:
+            case 0xc9:
+            {
+                const uint64_t size = big_endian(std::size_t(1) << (initial - 0xc7));
+                bytes(size + 1);
+                break;
+            }
+            case 0xd4:
+            case 0xd5:
+            case 0xd6:
+            case 0xd7:
+            case 0xd8:
+                bytes((uint64_t(1) << (initial - 0xd4)) + 1);
+                break;
+            default:
+                parse_error("invalid MessagePack object");
+        }
+    }
+
+};
+
+/**
+ * @class Writer
+ *        Encodes a DynamicData, walking its type, by means of a CborWriter or a MsgPackWriter.
+ */
+template<typename Output>
+class Writer
+{
+public:
+
+    Writer(
+            std::vector<uint8_t>& output,
+            const std::string& submember)
+        : _output(output)
+        , _submember(submember)
+    {
+    }
+
+    void write_value(
+            const xtypes::DynamicType& alias,
+            const xtypes::ReadableDynamicDataRef& data)
+    {
+        using xtypes::TypeKind;
+
+        const xtypes::DynamicType& type = resolve(alias);
+        switch (type.kind())
+        {
+            case TypeKind::STRUCTURE_TYPE:
+            {
+                const auto& members = static_cast<const xtypes::AggregationType&>(type).members();
+
+                // Empty values are written as null, as with the Json conversion.
+                if (members.empty())
+                {
+                    _output.null();
+                    break;
+                }
+
+                _output.map(members.size());
+                for (std::size_t i = 0; i < members.size(); ++i)
+                {
+                    _output.string(members[i].name());
+                    write_field(members[i].type(), data[i]);
+                }
+                break;
+            }
+            case TypeKind::ARRAY_TYPE:
+            case TypeKind::SEQUENCE_TYPE:
+            {
+                const auto& content = static_cast<const xtypes::CollectionType&>(type).content_type();
+                const std::size_t size = data.size();
+                _output.array(size);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    write_field(content, data[i]);
+                }
+                break;
+            }
+            case TypeKind::STRING_TYPE:
+                _output.string(data.value<std::string>());
+                break;
+            case TypeKind::BOOLEAN_TYPE:
+                _output.boolean(data.value<bool>());
+                break;
+            case TypeKind::CHAR_8_TYPE:
+                _output.signed_integer(data.value<char>());
+                break;
+            case TypeKind::INT_8_TYPE:
+                _output.signed_integer(data.value<int8_t>());
+                break;
+            case TypeKind::UINT_8_TYPE:
+                _output.unsigned_integer(data.value<uint8_t>());
+                break;
+            case TypeKind::INT_16_TYPE:
+                _output.signed_integer(data.value<int16_t>());
+                break;
+            case TypeKind::UINT_16_TYPE:
+                _output.unsigned_integer(data.value<uint16_t>());
+                break;
+            case TypeKind::INT_32_TYPE:
+                _output.signed_integer(data.value<int32_t>());
+                break;
+            case TypeKind::UINT_32_TYPE:
+                _output.unsigned_integer(data.value<uint32_t>());
+                break;
+            case TypeKind::INT_64_TYPE:
+                _output.signed_integer(data.value<int64_t>());
+                break;
+            case TypeKind::UINT_64_TYPE:
+                _output.unsigned_integer(data.value<uint64_t>());
+                break;
+            case TypeKind::FLOAT_32_TYPE:
+                _output.single(data.value<float>());
+                break;
+            case TypeKind::FLOAT_64_TYPE:
+                _output.real(data.value<double>());
+                break;
+            default:
+                throw UnsupportedType(type.name());
+        }
+    }
+
+private:
+
+    /**
+     * @brief Writes the value of a member or element, which is wrapped into a map
+     *        when a submember is used.
+     */
+    void write_field(
+            const xtypes::DynamicType& type,
+            const xtypes::ReadableDynamicDataRef& data)
+    {
+        if (!_submember.empty())
+        {
+            _output.map(1);
+            _output.string(_submember);
+        }
+        write_value(type, data);
+    }
+
+    Output _output;
+    const std::string& _submember;
+};
+
+/**
+ * @class Parser
+ *        Decodes a DynamicData, walking its type, by means of a CborReader or a MsgPackReader.
+ */
+template<typename Input>
+class Parser
+{
+public:
+
+    Parser(
+            const uint8_t* data,
+            std::size_t size,
+            const std::string& submember)
+        : _input(data, size)
+        , _submember(submember)
+    {
+    }
+
+    void parse(
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        parse_value(data.type(), std::move(data));
+        if (!_input.at_end())
+        {
+            _input.parse_error("trailing bytes after the encoded value");
+        }
+    }
+
+private:
+
+    [[noreturn]] void missing_member(
+            const std::string& name) const
+    {
+        throw Json::type_error::create(0, "Cannot access member '" + name + "' because it does not exist");
+    }
+
+    [[noreturn]] void wrong_type(
+            const char* expected) const
+    {
+        throw Json::type_error::create(302, std::string("type must be ") + expected);
+    }
+
+    void parse_field(
+            const xtypes::DynamicType& type,
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        if (_submember.empty())
+        {
+            parse_value(type, std::move(data));
+            return;
+        }
+
+        if (_input.peek() != Item::MAP)
+        {
+            missing_member(_submember);
+        }
+
+        bool found = false;
+        for (std::size_t size = _input.map(); size > 0; --size)
+        {
+            if (_input.peek() == Item::STRING && _input.string() == _submember)
+            {
+                parse_value(type, std::move(data));
+                found = true;
+            }
+            else
+            {
+                _input.skip();
+            }
+        }
+
+        if (!found)
+        {
+            missing_member(_submember);
+        }
+    }
+
+    void parse_value(
+            const xtypes::DynamicType& alias,
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        using xtypes::TypeKind;
+
+        const xtypes::DynamicType& type = resolve(alias);
+        switch (type.kind())
+        {
+            case TypeKind::STRUCTURE_TYPE:
+                parse_structure(static_cast<const xtypes::AggregationType&>(type), std::move(data));
+                break;
+            case TypeKind::SEQUENCE_TYPE:
+            {
+                // A null value stands for an empty sequence, as with the Json conversion.
+                if (_input.peek() == Item::NIL)
+                {
+                    _input.null();
+                    break;
+                }
+                if (_input.peek() != Item::ARRAY)
+                {
+                    wrong_type("array");
+                }
+
+                const auto& content = static_cast<const xtypes::CollectionType&>(type).content_type();
+                const std::size_t size = _input.array();
+                data.resize(size);
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    parse_field(content, data[i]);
+                }
+                break;
+            }
+            case TypeKind::ARRAY_TYPE:
+            {
+                if (_input.peek() != Item::ARRAY)
+                {
+                    wrong_type("array");
+                }
+
+                const auto& array = static_cast<const xtypes::ArrayType&>(type);
+                const std::size_t size = _input.array();
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    if (i < array.dimension())
+                    {
+                        parse_field(array.content_type(), data[i]);
+                    }
+                    else
+                    {
+                        // Exceeding elements are ignored, as with the Json conversion.
+                        _input.skip();
+                    }
+                }
+
+                if (size < array.dimension())
+                {
+                    throw Json::type_error::create(0, "Cannot access element " + std::to_string(size)
+                                  + " of an array with " + std::to_string(array.dimension()) + " elements");
+                }
+                break;
+            }
+            case TypeKind::STRING_TYPE:
+                if (_input.peek() != Item::STRING)
+                {
+                    wrong_type("string");
+                }
+                data.value<std::string>(std::string(_input.string()));
+                break;
+            case TypeKind::BOOLEAN_TYPE:
+                if (_input.peek() != Item::BOOLEAN)
+                {
+                    wrong_type("boolean");
+                }
+                data.value<bool>(_input.boolean());
+                break;
+            case TypeKind::CHAR_8_TYPE: data.value<char>(number().template as<char>()); break;
+            case TypeKind::INT_8_TYPE: data.value<int8_t>(number().template as<int8_t>()); break;
+            case TypeKind::UINT_8_TYPE: data.value<uint8_t>(number().template as<uint8_t>()); break;
+            case TypeKind::INT_16_TYPE: data.value<int16_t>(number().template as<int16_t>()); break;
+            case TypeKind::UINT_16_TYPE: data.value<uint16_t>(number().template as<uint16_t>()); break;
+            case TypeKind::INT_32_TYPE: data.value<int32_t>(number().template as<int32_t>()); break;
+            case TypeKind::UINT_32_TYPE: data.value<uint32_t>(number().template as<uint32_t>()); break;
+            case TypeKind::INT_64_TYPE: data.value<int64_t>(number().template as<int64_t>()); break;
+            case TypeKind::UINT_64_TYPE: data.value<uint64_t>(number().template as<uint64_t>()); break;
+            case TypeKind::FLOAT_32_TYPE: data.value<float>(number().template as<float>()); break;
+            case TypeKind::FLOAT_64_TYPE: data.value<double>(number().template as<double>()); break;
+            default:
+                throw UnsupportedType(type.name());
+        }
+    }
+
+    void parse_structure(
+            const xtypes::AggregationType& type,
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        const std::vector<xtypes::Member>& members = type.members();
+
+        if (_input.peek() != Item::MAP)
+        {
+            if (members.empty() && _input.peek() == Item::NIL)
+            {
+                _input.null();
+                return;
+            }
+            missing_member(members.empty() ? _submember : members.front().name());
+        }
+
+        std::vector<bool> seen(members.size(), false);
+        std::size_t found = 0;
+        std::size_t expected = 0;
+
+        for (std::size_t size = _input.map(); size > 0; --size)
+        {
+            if (_input.peek() != Item::STRING)
+            {
+                _input.skip();
+                _input.skip();
+                continue;
+            }
+
+            /**
+             * Members are usually encoded in the type order, so the next one is tried
+             * first, before looking for the key among all of them.
+             */
+            const std::string_view key = _input.string();
+            std::size_t index = expected < members.size() && members[expected].name() == key
+                    ? expected
+                    : members.size();
+            for (std::size_t i = 0; index == members.size() && i < members.size(); ++i)
+            {
+                if (members[i].name() == key)
+                {
+                    index = i;
+                }
+            }
+
+            if (index == members.size())
+            {
+                _input.skip();
+                continue;
+            }
+
+            parse_field(members[index].type(), data[index]);
+            if (!seen[index])
+            {
+                seen[index] = true;
+                ++found;
+            }
+            expected = index + 1;
+        }
+
+        for (std::size_t i = 0; found != members.size() && i < members.size(); ++i)
+        {
+            if (!seen[i])
+            {
+                missing_member(members[i].name());
+            }
+        }
+    }
+
+    Number number()
+    {
+        const Item item = _input.peek();
+        if (item != Item::UNSIGNED && item != Item::SIGNED && item != Item::FLOATING)
+        {
+            wrong_type("number");
+        }
+        return _input.number();
+    }
+
+    Input _input;
+    const std::string& _submember;
+};
+
+} //  anonymous namespace
+
+//==============================================================================
+BinaryCodec::BinaryCodec(
+        const xtypes::DynamicType& type,
+        Format format,
+        const std::string& submember)
+    : _type(type)
+    , _format(format)
+    , _submember(submember)
+{
+    check_type(type);
+}
+
+//==============================================================================
+const xtypes::DynamicType& BinaryCodec::type() const
+{
+    return _type;
+}
+
+//==============================================================================
+BinaryCodec::Format BinaryCodec::format() const
+{
+    return _format;
+}
+
+//==============================================================================
+xtypes::DynamicData BinaryCodec::parse(
+        const uint8_t* data,
+        std::size_t size) const
+{
+    xtypes::DynamicData result(_type);
+    if (_format == Format::CBOR)
+    {
+        Parser<CborReader>(data, size, _submember).parse(result.ref());
+    }
+    else
+    {
+        Parser<MsgPackReader>(data, size, _submember).parse(result.ref());
+    }
+    return result;
+}
+
+//==============================================================================
+void BinaryCodec::write(
+        const xtypes::ReadableDynamicDataRef& input,
+        std::vector<uint8_t>& output) const
+{
+    if (_format == Format::CBOR)
+    {
+        Writer<CborWriter>(output, _submember).write_value(_type, input);
+    }
+    else
+    {
+        Writer<MsgPackWriter>(output, _submember).write_value(_type, input);
+    }
+}
+
+//==============================================================================
+std::vector<uint8_t> BinaryCodec::write(
+        const xtypes::ReadableDynamicDataRef& input) const
+{
+    std::vector<uint8_t> output;
+    write(input, output);
+    return output;
+}
+
+} //  namespace json_xtypes
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,1342 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/json-xtypes/conversion.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <limits>
+#include <map>
+
+namespace eprosima {
+namespace is {
+namespace json_xtypes {
+
+namespace {
+
+/**
+ * @brief Maximum number of objects and arrays the parsed text can nest into each other,
+ *        so that a malicious or corrupted message fails to parse instead of exhausting the stack.
+ */
+constexpr std::size_t max_nesting_depth = 256;
+
+/**
+ * @brief Precomputed layout of a DynamicType, shared by the reader and the writer.
+ */
+struct Node
+{
+    struct Member
+    {
+        std::string name;
+
+        /**
+         * The `"name":` text written before the member value.
+         */
+        std::string key;
+
+        const Node* node;
+    };
+
+    xtypes::TypeKind kind;
+    const xtypes::DynamicType* type;
+
+    /**
+     * Aggregation members, in type order, and their indexes sorted by name.
+     */
+    std::vector<Member> members;
+    std::vector<std::size_t> sorted_members;
+
+    /**
+     * Collection element layout and array dimension.
+     */
+    const Node* element = nullptr;
+    std::size_t dimension = 0;
+
+    /**
+     * @brief Finds a member by name, trying first the one expected after the previous member.
+     *
+     * @returns The member index, or `members.size()` if there is no such member.
+     */
+    std::size_t find_member(
+            std::string_view name,
+            std::size_t expected) const
+    {
+        if (expected < members.size() && members[expected].name == name)
+        {
+            return expected;
+        }
+
+        auto it = std::lower_bound(sorted_members.begin(), sorted_members.end(), name,
+                        [this](std::size_t index, std::string_view value)
+                        {
+                            return std::string_view(members[index].name) < value;
+                        });
+
+        if (it != sorted_members.end() && members[*it].name == name)
+        {
+            return *it;
+        }
+        return members.size();
+    }
+
+};
+
+//==============================================================================
+void append_escaped(
+        std::string& output,
+        std::string_view text)
+{
+    static const char* hex = "0123456789abcdef";
+
+    for (const char c : text)
+    {
+        switch (c)
+        {
+            case '"':
+                output += "\\\"";
+                break;
+            case '\\':
+                output += "\\\\";
+                break;
+            case '\b':
+                output += "\\b";
+                break;
+            case '\f':
+                output += "\\f";
+                break;
+            case '\n':
+                output += "\\n";
+                break;
+            case '\r':
+                output += "\\r";
+                break;
+            case '\t':
+                output += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    output += "\\u00";
+                    output += hex[(c >> 4) & 0x0F];
+                    output += hex[c & 0x0F];
+                }
+                else
+                {
+                    output += c;
+                }
+        }
+    }
+}
+
+/**
+ * @class Reader
+ *        Recursive descent JSON parser that writes every value straight into its
+ *        DynamicData field, following the precomputed layout of the type.
+ */
+class Reader
+{
+public:
+
+    Reader(
+            std::string_view text,
+            const std::string& submember)
+        : _begin(text.data())
+        , _current(text.data())
+        , _end(text.data() + text.size())
+        , _submember(submember)
+    {
+    }
+
+    void parse(
+            const Node& node,
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        parse_value(node, std::move(data));
+
+        skip_whitespace();
+        if (_current != _end)
+        {
+            parse_error("unexpected characters after the end of the message");
+        }
+    }
+
+private:
+
+    /**
+     * @brief Accounts for an object or array of the text while it is being read.
+     */
+    class Nesting
+    {
+    public:
+
+        Nesting(
+                Reader& reader)
+            : _reader(reader)
+        {
+            if (_reader._depth == max_nesting_depth)
+            {
+                _reader.parse_error("maximum nesting depth of "
+                        + std::to_string(max_nesting_depth) + " exceeded");
+            }
+            ++_reader._depth;
+        }
+
+        ~Nesting()
+        {
+            --_reader._depth;
+        }
+
+    private:
+
+        Reader& _reader;
+    };
+
+    /**
+     * @brief A number, as written in the text.
+     */
+    struct Number
+    {
+        enum class Kind
+        {
+            SIGNED,
+            UNSIGNED,
+            FLOATING
+        }
+        kind;
+
+        int64_t signed_value = 0;
+        uint64_t unsigned_value = 0;
+        double floating_value = 0.0;
+
+        template <typename T>
+        T as() const
+        {
+            switch (kind)
+            {
+                case Kind::SIGNED:
+                    return static_cast<T>(signed_value);
+                case Kind::UNSIGNED:
+                    return static_cast<T>(unsigned_value);
+                case Kind::FLOATING:
+                default:
+                    return static_cast<T>(floating_value);
+            }
+        }
+
+    };
+
+    [[noreturn]] void parse_error(
+            const std::string& what) const
+    {
+        throw Json::parse_error::create(101, static_cast<std::size_t>(_current - _begin) + 1, what);
+    }
+
+    [[noreturn]] void missing_member(
+            const std::string& name) const
+    {
+        throw Json::type_error::create(0, "Cannot access member '" + name + "' because it does not exist");
+    }
+
+    [[noreturn]] void wrong_type(
+            const char* expected) const
+    {
+        throw Json::type_error::create(302, std::string("type must be ") + expected
+                      + ", but is " + describe_next());
+    }
+
+    const char* describe_next() const
+    {
+        if (_current == _end)
+        {
+            return "missing";
+        }
+
+        switch (*_current)
+        {
+            case '{':
+                return "object";
+            case '[':
+                return "array";
+            case '"':
+                return "string";
+            case 't':
+            case 'f':
+                return "boolean";
+            case 'n':
+                return "null";
+            default:
+                return "number";
+        }
+    }
+
+    void skip_whitespace()
+    {
+        while (_current != _end
+                && (*_current == ' ' || *_current == '\t' || *_current == '\n' || *_current == '\r'))
+        {
+            ++_current;
+        }
+    }
+
+    char peek()
+    {
+        skip_whitespace();
+        if (_current == _end)
+        {
+            parse_error("unexpected end of input");
+        }
+        return *_current;
+    }
+
+    void expect(
+            char c)
+    {
+        if (peek() != c)
+        {
+            parse_error(std::string("expected '") + c + "'");
+        }
+        ++_current;
+    }
+
+    bool consume(
+            char c)
+    {
+        if (peek() == c)
+        {
+            ++_current;
+            return true;
+        }
+        return false;
+    }
+
+    bool consume_literal(
+            std::string_view literal)
+    {
+        skip_whitespace();
+        if (static_cast<std::size_t>(_end - _current) >= literal.size()
+                && std::string_view(_current, literal.size()) == literal)
+        {
+            _current += literal.size();
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Reads a string token. If it has no escape sequences, the returned view
+     *        points into the text; otherwise, it points into `scratch`.
+     */
+    std::string_view read_string(
+            std::string& scratch)
+    {
+        expect('"');
+
+        const char* start = _current;
+        while (_current != _end && *_current != '"' && *_current != '\\')
+        {
+            if (static_cast<unsigned char>(*_current) < 0x20)
+            {
+                parse_error("control character in string");
+            }
+            ++_current;
+        }
+
+        if (_current == _end)
+        {
+            parse_error("unterminated string");
+        }
+
+        if (*_current == '"')
+        {
+            std::string_view view(start, static_cast<std::size_t>(_current - start));
+            ++_current;
+            return view;
+        }
+
+        scratch.assign(start, static_cast<std::size_t>(_current - start));
+        while (true)
+        {
+            if (_current == _end)
+            {
+                parse_error("unterminated string");
+            }
+
+            const char c = *_current++;
+            if (c == '"')
+            {
+                return scratch;
+            }
+            else if (c != '\\')
+            {
+                if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    parse_error("control character in string");
+                }
+                scratch += c;
+                continue;
+            }
+
+            if (_current == _end)
+            {
+                parse_error("unterminated string");
+            }
+
+            switch (*_current++)
+            {
+                case '"':
+                    scratch += '"';
+                    break;
+                case '\\':
+                    scratch += '\\';
+                    break;
+                case '/':
+                    scratch += '/';
+                    break;
+                case 'b':
+                    scratch += '\b';
+                    break;
+                case 'f':
+                    scratch += '\f';
+                    break;
+                case 'n':
+                    scratch += '\n';
+                    break;
+                case 'r':
+                    scratch += '\r';
+                    break;
+                case 't':
+                    scratch += '\t';
+                    break;
+                case 'u':
+                    append_code_point(scratch);
+                    break;
+                default:
+                    parse_error("invalid escape sequence in string");
+            }
+        }
+    }
+
+    uint32_t read_hex4()
+    {
+        if (_end - _current < 4)
+        {
+            parse_error("invalid unicode escape sequence in string");
+        }
+
+        uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            const char c = *_current++;
+            value <<= 4;
+            if (c >= '0' && c <= '9')
+            {
+                value |= static_cast<uint32_t>(c - '0');
+            }
+            else if (c >= 'a' && c <= 'f')
+            {
+                value |= static_cast<uint32_t>(c - 'a' + 10);
+            }
+            else if (c >= 'A' && c <= 'F')
+            {
+                value |= static_cast<uint32_t>(c - 'A' + 10);
+            }
+            else
+            {
+                parse_error("invalid unicode escape sequence in string");
+            }
+        }
+        return value;
+    }
+
+    void append_code_point(
+            std::string& output)
+    {
+        uint32_t code_point = read_hex4();
+
+        if (code_point >= 0xD800 && code_point <= 0xDBFF)
+        {
+            if (_end - _current < 2 || _current[0] != '\\' || _current[1] != 'u')
+            {
+                parse_error("missing low surrogate in unicode escape sequence");
+            }
+            _current += 2;
+
+            const uint32_t low = read_hex4();
+            if (low < 0xDC00 || low > 0xDFFF)
+            {
+                parse_error("invalid low surrogate in unicode escape sequence");
+            }
+            code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+        }
+        else if (code_point >= 0xDC00 && code_point <= 0xDFFF)
+        {
+            parse_error("unexpected low surrogate in unicode escape sequence");
+        }
+
+        if (code_point < 0x80)
+        {
+            output += static_cast<char>(code_point);
+        }
+        else if (code_point < 0x800)
+        {
+            output += static_cast<char>(0xC0 | (code_point >> 6));
+            output += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else if (code_point < 0x10000)
+        {
+            output += static_cast<char>(0xE0 | (code_point >> 12));
+            output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+        else
+        {
+            output += static_cast<char>(0xF0 | (code_point >> 18));
+            output += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+            output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (code_point & 0x3F));
+        }
+    }
+
+    Number read_number()
+    {
+        skip_whitespace();
+
+        const char* start = _current;
+        bool floating = false;
+
+        if (_current != _end && *_current == '-')
+        {
+            ++_current;
+        }
+        while (_current != _end)
+        {
+            const char c = *_current;
+            if (c == '.' || c == 'e' || c == 'E' || c == '+' || (c == '-' && _current != start))
+            {
+                floating = true;
+            }
+            else if (c < '0' || c > '9')
+            {
+                break;
+            }
+            ++_current;
+        }
+
+        if (_current == start || (_current == start + 1 && *start == '-'))
+        {
+            parse_error("invalid number");
+        }
+
+        Number number;
+        if (!floating)
+        {
+            if (*start == '-')
+            {
+                number.kind = Number::Kind::SIGNED;
+                if (std::from_chars(start, _current, number.signed_value).ec == std::errc())
+                {
+                    return number;
+                }
+            }
+            else
+            {
+                number.kind = Number::Kind::UNSIGNED;
+                if (std::from_chars(start, _current, number.unsigned_value).ec == std::errc())
+                {
+                    return number;
+                }
+            }
+        }
+
+        // Numbers not fitting in a 64 bits integer are read as floating point ones, as nlohmann does.
+        number.kind = Number::Kind::FLOATING;
+        number.floating_value = to_double(start, _current);
+        return number;
+    }
+
+    double to_double(
+            const char* start,
+            const char* end)
+    {
+        char buffer[128];
+        const std::size_t length = static_cast<std::size_t>(end - start);
+        if (length >= sizeof(buffer))
+        {
+            parse_error("number too long");
+        }
+
+        std::copy(start, end, buffer);
+        buffer[length] = '\0';
+
+        // strtod depends on the locale, so the decimal point is adapted to it.
+        const char decimal_point = *std::localeconv()->decimal_point;
+        if (decimal_point != '.')
+        {
+            std::replace(buffer, buffer + length, '.', decimal_point);
+        }
+
+        char* parsed = nullptr;
+        const double value = std::strtod(buffer, &parsed);
+        if (parsed != buffer + length)
+        {
+            parse_error("invalid number");
+        }
+        return value;
+    }
+
+    /**
+     * @brief Reads a value that nlohmann would accept as an arithmetic type: a number or a boolean.
+     */
+    Number read_arithmetic()
+    {
+        const char c = peek();
+        if (c == 't' || c == 'f')
+        {
+            Number number;
+            number.kind = Number::Kind::UNSIGNED;
+            number.unsigned_value = read_boolean() ? 1 : 0;
+            return number;
+        }
+        if (c != '-' && (c < '0' || c > '9'))
+        {
+            wrong_type("number");
+        }
+        return read_number();
+    }
+
+    bool read_boolean()
+    {
+        if (consume_literal("true"))
+        {
+            return true;
+        }
+        if (consume_literal("false"))
+        {
+            return false;
+        }
+        wrong_type("boolean");
+    }
+
+    template <typename T>
+    T read_floating()
+    {
+        if (peek() != '"')
+        {
+            return read_arithmetic().as<T>();
+        }
+
+        const std::string_view text = read_string(_scratch);
+        if (text == "inf")
+        {
+            return std::numeric_limits<T>::infinity();
+        }
+        else if (text == "-inf")
+        {
+            return -std::numeric_limits<T>::infinity();
+        }
+        else if (text == "nan")
+        {
+            return std::numeric_limits<T>::quiet_NaN();
+        }
+        else if (text == "-nan")
+        {
+            return -std::numeric_limits<T>::quiet_NaN();
+        }
+
+        // Non normal values, such as zero, are written by `convert` as quoted numbers.
+        char buffer[128];
+        if (!text.empty() && text.size() < sizeof(buffer))
+        {
+            std::copy(text.begin(), text.end(), buffer);
+            buffer[text.size()] = '\0';
+            char* parsed = nullptr;
+            const double value = std::strtod(buffer, &parsed);
+            if (parsed == buffer + text.size())
+            {
+                return static_cast<T>(value);
+            }
+        }
+
+        throw UnsupportedType("Calling 'get_json_float' for a non-float value: '\"" + std::string(text) + "\"'");
+    }
+
+    void skip_value()
+    {
+        switch (peek())
+        {
+            case '{':
+            {
+                const Nesting nesting(*this);
+                ++_current;
+                if (consume('}'))
+                {
+                    return;
+                }
+                do
+                {
+                    read_string(_scratch);
+                    expect(':');
+                    skip_value();
+                } while (consume(','));
+                expect('}');
+                return;
+            }
+            case '[':
+            {
+                const Nesting nesting(*this);
+                ++_current;
+                if (consume(']'))
+                {
+                    return;
+                }
+                do
+                {
+                    skip_value();
+                } while (consume(','));
+                expect(']');
+                return;
+            }
+            case '"':
+            {
+                read_string(_scratch);
+                return;
+            }
+            default:
+            {
+                if (consume_literal("true") || consume_literal("false") || consume_literal("null"))
+                {
+                    return;
+                }
+                read_number();
+            }
+        }
+    }
+
+    /**
+     * @brief Counts the elements of the array starting at the current position, without consuming it.
+     */
+    std::size_t count_elements()
+    {
+        const char* start = _current;
+
+        expect('[');
+        std::size_t count = 0;
+        if (!consume(']'))
+        {
+            do
+            {
+                skip_value();
+                ++count;
+            } while (consume(','));
+            expect(']');
+        }
+
+        _current = start;
+        return count;
+    }
+
+    /**
+     * @brief Parses the value of a member or element, which is wrapped into an
+     *        object when a submember is used.
+     */
+    void parse_field(
+            const Node& node,
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        if (_submember.empty())
+        {
+            parse_value(node, std::move(data));
+            return;
+        }
+
+        if (peek() != '{')
+        {
+            missing_member(_submember);
+        }
+        const Nesting nesting(*this);
+        ++_current;
+
+        bool found = false;
+        if (!consume('}'))
+        {
+            do
+            {
+                const std::string_view key = read_string(_scratch);
+                expect(':');
+                if (key == _submember)
+                {
+                    parse_value(node, std::move(data));
+                    found = true;
+                }
+                else
+                {
+                    skip_value();
+                }
+            } while (consume(','));
+            expect('}');
+        }
+
+        if (!found)
+        {
+            missing_member(_submember);
+        }
+    }
+
+    void parse_value(
+            const Node& node,
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        switch (node.kind)
+        {
+            case xtypes::TypeKind::STRUCTURE_TYPE:
+                parse_structure(node, std::move(data));
+                break;
+            case xtypes::TypeKind::SEQUENCE_TYPE:
+                parse_sequence(node, std::move(data));
+                break;
+            case xtypes::TypeKind::ARRAY_TYPE:
+                parse_array(node, std::move(data));
+                break;
+            case xtypes::TypeKind::STRING_TYPE:
+            {
+                if (peek() != '"')
+                {
+                    wrong_type("string");
+                }
+                data.value<std::string>(std::string(read_string(_scratch)));
+                break;
+            }
+            case xtypes::TypeKind::BOOLEAN_TYPE:
+                data.value<bool>(read_boolean());
+                break;
+            case xtypes::TypeKind::CHAR_8_TYPE:
+                data.value<char>(read_arithmetic().as<char>());
+                break;
+            case xtypes::TypeKind::INT_8_TYPE:
+                data.value<int8_t>(read_arithmetic().as<int8_t>());
+                break;
+            case xtypes::TypeKind::UINT_8_TYPE:
+                data.value<uint8_t>(read_arithmetic().as<uint8_t>());
+                break;
+            case xtypes::TypeKind::INT_16_TYPE:
+                data.value<int16_t>(read_arithmetic().as<int16_t>());
+                break;
+            case xtypes::TypeKind::UINT_16_TYPE:
+                data.value<uint16_t>(read_arithmetic().as<uint16_t>());
+                break;
+            case xtypes::TypeKind::INT_32_TYPE:
+                data.value<int32_t>(read_arithmetic().as<int32_t>());
+                break;
+            case xtypes::TypeKind::UINT_32_TYPE:
+                data.value<uint32_t>(read_arithmetic().as<uint32_t>());
+                break;
+            case xtypes::TypeKind::INT_64_TYPE:
+                data.value<int64_t>(read_arithmetic().as<int64_t>());
+                break;
+            case xtypes::TypeKind::UINT_64_TYPE:
+                data.value<uint64_t>(read_arithmetic().as<uint64_t>());
+                break;
+            case xtypes::TypeKind::FLOAT_32_TYPE:
+                data.value<float>(read_floating<float>());
+                break;
+            case xtypes::TypeKind::FLOAT_64_TYPE:
+                data.value<double>(read_floating<double>());
+                break;
+            default:
+                throw UnsupportedType(node.type->name());
+        }
+    }
+
+    void parse_structure(
+            const Node& node,
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        if (peek() != '{')
+        {
+            if (node.members.empty() && consume_literal("null"))
+            {
+                return;
+            }
+            missing_member(node.members.empty() ? _submember : node.members.front().name);
+        }
+        const Nesting nesting(*this);
+        ++_current;
+
+        std::size_t found = 0;
+        std::size_t expected = 0;
+        std::vector<bool>& seen = _seen.emplace_back(node.members.size(), false);
+
+        if (!consume('}'))
+        {
+            do
+            {
+                const std::string_view key = read_string(_scratch);
+                expect(':');
+
+                const std::size_t index = node.find_member(key, expected);
+                if (index == node.members.size())
+                {
+                    skip_value();
+                    continue;
+                }
+
+                parse_field(*node.members[index].node, data[index]);
+                if (!seen[index])
+                {
+                    seen[index] = true;
+                    ++found;
+                }
+                expected = index + 1;
+            } while (consume(','));
+            expect('}');
+        }
+
+        if (found != node.members.size())
+        {
+            const auto missing = std::find(seen.begin(), seen.end(), false);
+            missing_member(node.members[static_cast<std::size_t>(missing - seen.begin())].name);
+        }
+
+        _seen.pop_back();
+    }
+
+    void parse_sequence(
+            const Node& node,
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        // A null value stands for an empty sequence, as with the Json conversion.
+        if (peek() == 'n' && consume_literal("null"))
+        {
+            return;
+        }
+        if (peek() != '[')
+        {
+            wrong_type("array");
+        }
+        const Nesting nesting(*this);
+
+        // Resizing once avoids growing the sequence element by element.
+        const std::size_t size = count_elements();
+        data.resize(size);
+
+        expect('[');
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            if (i > 0)
+            {
+                expect(',');
+            }
+            parse_field(*node.element, data[i]);
+        }
+        expect(']');
+    }
+
+    void parse_array(
+            const Node& node,
+            xtypes::WritableDynamicDataRef&& data)
+    {
+        if (peek() != '[')
+        {
+            wrong_type("array");
+        }
+        const Nesting nesting(*this);
+        ++_current;
+
+        std::size_t index = 0;
+        if (!consume(']'))
+        {
+            do
+            {
+                if (index < node.dimension)
+                {
+                    parse_field(*node.element, data[index]);
+                }
+                else
+                {
+                    // Exceeding elements are ignored, as with the Json conversion.
+                    skip_value();
+                }
+                ++index;
+            } while (consume(','));
+            expect(']');
+        }
+
+        if (index < node.dimension)
+        {
+            throw Json::type_error::create(0, "Cannot access element " + std::to_string(index)
+                          + " of an array with " + std::to_string(node.dimension) + " elements");
+        }
+    }
+
+    const char* const _begin;
+    const char* _current;
+    const char* const _end;
+    const std::string& _submember;
+
+    std::string _scratch;
+    std::deque<std::vector<bool> > _seen;
+    std::size_t _depth = 0;
+};
+
+/**
+ * @class Writer
+ *        Writes a DynamicData as JSON text, following the precomputed layout of its type.
+ */
+class Writer
+{
+public:
+
+    Writer(
+            std::string& output,
+            const std::string& submember_key)
+        : _output(output)
+        , _submember_key(submember_key)
+    {
+    }
+
+    void write_value(
+            const Node& node,
+            const xtypes::ReadableDynamicDataRef& data)
+    {
+        switch (node.kind)
+        {
+            case xtypes::TypeKind::STRUCTURE_TYPE:
+            {
+                // Empty values are written as null, as with the Json conversion.
+                if (node.members.empty())
+                {
+                    _output += "null";
+                    break;
+                }
+
+                _output += '{';
+                for (std::size_t i = 0; i < node.members.size(); ++i)
+                {
+                    if (i > 0)
+                    {
+                        _output += ',';
+                    }
+                    _output += node.members[i].key;
+                    write_field(*node.members[i].node, data[i]);
+                }
+                _output += '}';
+                break;
+            }
+            case xtypes::TypeKind::SEQUENCE_TYPE:
+            case xtypes::TypeKind::ARRAY_TYPE:
+            {
+                const std::size_t size = data.size();
+                if (size == 0)
+                {
+                    _output += "null";
+                    break;
+                }
+
+                _output += '[';
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    if (i > 0)
+                    {
+                        _output += ',';
+                    }
+                    write_field(*node.element, data[i]);
+                }
+                _output += ']';
+                break;
+            }
+            case xtypes::TypeKind::STRING_TYPE:
+            {
+                _output += '"';
+                append_escaped(_output, data.value<std::string>());
+                _output += '"';
+                break;
+            }
+            case xtypes::TypeKind::BOOLEAN_TYPE:
+                _output += data.value<bool>() ? "true" : "false";
+                break;
+            case xtypes::TypeKind::CHAR_8_TYPE:
+                write_integer(static_cast<int64_t>(data.value<char>()));
+                break;
+            case xtypes::TypeKind::INT_8_TYPE:
+                write_integer(data.value<int8_t>());
+                break;
+            case xtypes::TypeKind::UINT_8_TYPE:
+                write_integer(data.value<uint8_t>());
+                break;
+            case xtypes::TypeKind::INT_16_TYPE:
+                write_integer(data.value<int16_t>());
+                break;
+            case xtypes::TypeKind::UINT_16_TYPE:
+                write_integer(data.value<uint16_t>());
+                break;
+            case xtypes::TypeKind::INT_32_TYPE:
+                write_integer(data.value<int32_t>());
+                break;
+            case xtypes::TypeKind::UINT_32_TYPE:
+                write_integer(data.value<uint32_t>());
+                break;
+            case xtypes::TypeKind::INT_64_TYPE:
+                write_integer(data.value<int64_t>());
+                break;
+            case xtypes::TypeKind::UINT_64_TYPE:
+                write_integer(data.value<uint64_t>());
+                break;
+            case xtypes::TypeKind::FLOAT_32_TYPE:
+                write_floating(data.value<float>());
+                break;
+            case xtypes::TypeKind::FLOAT_64_TYPE:
+                write_floating(data.value<double>());
+                break;
+            default:
+                throw UnsupportedType(node.type->name());
+        }
+    }
+
+private:
+
+    void write_field(
+            const Node& node,
+            const xtypes::ReadableDynamicDataRef& data)
+    {
+        if (_submember_key.empty())
+        {
+            write_value(node, data);
+            return;
+        }
+
+        _output += '{';
+        _output += _submember_key;
+        write_value(node, data);
+        _output += '}';
+    }
+
+    template <typename T>
+    void write_integer(
+            T value)
+    {
+        char buffer[24];
+        const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        _output.append(buffer, static_cast<std::size_t>(result.ptr - buffer));
+    }
+
+    template <typename T>
+    void write_floating(
+            T value)
+    {
+        char buffer[64];
+        if (std::isnormal(value))
+        {
+            // Same shortest round-trip representation used by nlohmann.
+            const char* end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer),
+                            static_cast<double>(value));
+            _output.append(buffer, static_cast<std::size_t>(end - buffer));
+        }
+        else
+        {
+            // Same quoted text produced by the Json conversion, through std::to_string.
+            const int length = std::snprintf(buffer, sizeof(buffer), "%f", static_cast<double>(value));
+            _output += '"';
+            _output.append(buffer, static_cast<std::size_t>(std::max(length, 0)));
+            _output += '"';
+        }
+    }
+
+    std::string& _output;
+    const std::string& _submember_key;
+};
+
+} //  anonymous namespace
+
+class JsonCodec::Implementation
+{
+public:
+
+    Implementation(
+            const xtypes::DynamicType& type,
+            const std::string& submember)
+        : _type(type)
+        , _submember(submember)
+    {
+        if (!_submember.empty())
+        {
+            _submember_key = "\"";
+            append_escaped(_submember_key, _submember);
+            _submember_key += "\":";
+        }
+
+        std::map<const xtypes::DynamicType*, const Node*> compiled;
+        _root = compile(type, compiled);
+    }
+
+    const xtypes::DynamicType& type() const
+    {
+        return _type;
+    }
+
+    xtypes::DynamicData parse(
+            std::string_view text) const
+    {
+        xtypes::DynamicData message(_type);
+        Reader(text, _submember).parse(*_root, message.ref());
+        return message;
+    }
+
+    void write(
+            const xtypes::ReadableDynamicDataRef& input,
+            std::string& output) const
+    {
+        Writer(output, _submember_key).write_value(*_root, input);
+    }
+
+private:
+
+    const Node* compile(
+            const xtypes::DynamicType& type,
+            std::map<const xtypes::DynamicType*, const Node*>& compiled)
+    {
+        // Subtypes used several times share their layout.
+        auto it = compiled.find(&type);
+        if (it != compiled.end())
+        {
+            return it->second;
+        }
+
+        Node& node = _nodes.emplace_back();
+        node.kind = type.kind();
+        node.type = &type;
+
+        switch (type.kind())
+        {
+            case xtypes::TypeKind::STRUCTURE_TYPE:
+            {
+                const auto& aggregation = static_cast<const xtypes::AggregationType&>(type);
+                for (const xtypes::Member& member : aggregation.members())
+                {
+                    std::string key = "\"";
+                    append_escaped(key, member.name());
+                    key += "\":";
+                    node.members.push_back(Node::Member{member.name(), std::move(key),
+                                                        compile(member.type(), compiled)});
+                }
+
+                node.sorted_members.resize(node.members.size());
+                for (std::size_t i = 0; i < node.members.size(); ++i)
+                {
+                    node.sorted_members[i] = i;
+                }
+                std::sort(node.sorted_members.begin(), node.sorted_members.end(),
+                        [&node](std::size_t a, std::size_t b)
+                        {
+                            return node.members[a].name < node.members[b].name;
+                        });
+                break;
+            }
+            case xtypes::TypeKind::ARRAY_TYPE:
+            {
+                const auto& array = static_cast<const xtypes::ArrayType&>(type);
+                node.dimension = array.dimension();
+                node.element = compile(array.content_type(), compiled);
+                break;
+            }
+            case xtypes::TypeKind::SEQUENCE_TYPE:
+            {
+                const auto& sequence = static_cast<const xtypes::SequenceType&>(type);
+                node.element = compile(sequence.content_type(), compiled);
+                break;
+            }
+            case xtypes::TypeKind::STRING_TYPE:
+            case xtypes::TypeKind::BOOLEAN_TYPE:
+            case xtypes::TypeKind::CHAR_8_TYPE:
+            case xtypes::TypeKind::INT_8_TYPE:
+            case xtypes::TypeKind::UINT_8_TYPE:
+            case xtypes::TypeKind::INT_16_TYPE:
+            case xtypes::TypeKind::UINT_16_TYPE:
+            case xtypes::TypeKind::INT_32_TYPE:
+            case xtypes::TypeKind::UINT_32_TYPE:
+            case xtypes::TypeKind::INT_64_TYPE:
+            case xtypes::TypeKind::UINT_64_TYPE:
+            case xtypes::TypeKind::FLOAT_32_TYPE:
+            case xtypes::TypeKind::FLOAT_64_TYPE:
+                break;
+            default:
+                throw UnsupportedType(type.name());
+        }
+
+        compiled.emplace(&type, &node);
+        return &node;
+    }
+
+    const xtypes::DynamicType& _type;
+    const std::string _submember;
+    std::string _submember_key;
+
+    /**
+     * A deque keeps the addresses of the nodes stable while the layout is being compiled.
+     */
+    std::deque<Node> _nodes;
+    const Node* _root;
+};
+
+//==============================================================================
+JsonCodec::JsonCodec(
+        const xtypes::DynamicType& type,
+        const std::string& submember)
+    : _pimpl(new Implementation(type, submember))
+{
+}
+
+//==============================================================================
+JsonCodec::~JsonCodec() = default;
+
+//==============================================================================
+const xtypes::DynamicType& JsonCodec::type() const
+{
+    return _pimpl->type();
+}
+
+//==============================================================================
+xtypes::DynamicData JsonCodec::parse(
+        std::string_view text) const
+{
+    return _pimpl->parse(text);
+}
+
+//==============================================================================
+void JsonCodec::write(
+        const xtypes::ReadableDynamicDataRef& input,
+        std::string& output) const
+{
+    _pimpl->write(input, output);
+}
+
+//==============================================================================
+std::string JsonCodec::write(
+        const xtypes::ReadableDynamicDataRef& input) const
+{
+    std::string output;
+    _pimpl->write(input, output);
+    return output;
+}
+
+} //  namespace json_xtypes
+} //  namespace is
+} //  namespace eprosima
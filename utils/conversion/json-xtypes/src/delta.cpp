@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/json-xtypes/conversion.hpp>
+
+#include <map>
+#include <mutex>
+
+namespace eprosima {
+namespace is {
+namespace json_xtypes {
+
+namespace {
+
+//==============================================================================
+/**
+ * @brief Gets the members of `current` that differ from `previous`, recursing into
+ *        the objects found in both, which stand for nested structures.
+ */
+Json diff(
+        const Json& previous,
+        const Json& current)
+{
+    Json changes = Json::object();
+    for (auto it = current.begin(); it != current.end(); ++it)
+    {
+        const auto old = previous.find(it.key());
+        if (old == previous.end())
+        {
+            changes[it.key()] = it.value();
+        }
+        else if (old->is_object() && it->is_object())
+        {
+            Json nested = diff(*old, *it);
+            if (!nested.empty())
+            {
+                changes[it.key()] = std::move(nested);
+            }
+        }
+        else if (*old != *it)
+        {
+            changes[it.key()] = it.value();
+        }
+    }
+    return changes;
+}
+
+} //  anonymous namespace
+
+class JsonDeltaEncoder::Implementation
+{
+public:
+
+    Implementation(
+            std::size_t keyframe_interval,
+            const std::string& submember)
+        : _keyframe_interval(keyframe_interval)
+        , _submember(submember)
+    {
+    }
+
+    Json encode(
+            const std::string& stream,
+            const xtypes::DynamicData& message,
+            bool& keyframe)
+    {
+        Json current = convert(message, _submember);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        Stream& state = _streams[stream];
+        keyframe = state.count == 0 || !state.last.is_object() || !current.is_object()
+                || (_keyframe_interval > 0 && state.count % _keyframe_interval == 0);
+        ++state.count;
+
+        if (keyframe)
+        {
+            state.last = current;
+            return current;
+        }
+
+        Json changes = diff(state.last, current);
+        state.last = std::move(current);
+        return changes;
+    }
+
+    void reset(
+            const std::string& stream)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _streams.erase(stream);
+    }
+
+private:
+
+    /**
+     * @brief The last message of a stream, and how many messages it has had.
+     */
+    struct Stream
+    {
+        Json last;
+        std::size_t count = 0;
+    };
+
+    const std::size_t _keyframe_interval;
+    const std::string _submember;
+
+    std::map<std::string, Stream> _streams;
+    std::mutex _mutex;
+};
+
+//==============================================================================
+JsonDeltaEncoder::JsonDeltaEncoder(
+        std::size_t keyframe_interval,
+        const std::string& submember)
+    : _pimpl(new Implementation(keyframe_interval, submember))
+{
+}
+
+//==============================================================================
+JsonDeltaEncoder::~JsonDeltaEncoder() = default;
+
+//==============================================================================
+Json JsonDeltaEncoder::encode(
+        const std::string& stream,
+        const xtypes::DynamicData& message,
+        bool& keyframe)
+{
+    return _pimpl->encode(stream, message, keyframe);
+}
+
+//==============================================================================
+void JsonDeltaEncoder::reset(
+        const std::string& stream)
+{
+    _pimpl->reset(stream);
+}
+
+//==============================================================================
+void JsonDeltaEncoder::apply(
+        const Json& delta,
+        Json& state)
+{
+    /**
+     * Unlike a JSON merge patch, null values are kept, since they stand for
+     * empty structures and sequences rather than for removed members.
+     */
+    if (!delta.is_object() || !state.is_object())
+    {
+        state = delta;
+        return;
+    }
+
+    for (auto it = delta.begin(); it != delta.end(); ++it)
+    {
+        auto target = state.find(it.key());
+        if (target != state.end() && target->is_object() && it->is_object())
+        {
+            apply(*it, *target);
+        }
+        else
+        {
+            state[it.key()] = it.value();
+        }
+    }
+}
+
+} //  namespace json_xtypes
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/json-xtypes/conversion.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+
+namespace eprosima {
+namespace is {
+namespace json_xtypes {
+
+class JsonTextCache::Implementation
+{
+public:
+
+    Implementation(
+            std::size_t capacity)
+        : _capacity(std::max<std::size_t>(capacity, 1))
+        , _written(0)
+    {
+    }
+
+    std::shared_ptr<const std::string> text(
+            const std::shared_ptr<const xtypes::DynamicData>& message,
+            const std::string& submember)
+    {
+        Key key{message, submember};
+
+        std::shared_ptr<const JsonCodec> codec;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            const auto it = _texts.find(key);
+            if (it != _texts.end())
+            {
+                return it->second;
+            }
+
+            codec = codec_for(message->type(), submember);
+        }
+
+        /**
+         * The text is written without holding the lock, so that different messages
+         * are written concurrently. If the same message is requested meanwhile,
+         * it is written twice, and the first text to be cached is kept.
+         */
+        std::shared_ptr<const std::string> text = std::make_shared<const std::string>(
+            codec ? codec->write(*message) : convert(*message, submember).dump());
+        ++_written;
+
+        std::unique_lock<std::mutex> lock(_mutex);
+
+        const auto [it, inserted] = _texts.emplace(std::move(key), text);
+        if (!inserted)
+        {
+            return it->second;
+        }
+        _order.push_back(it);
+
+        /**
+         * Drops the texts whose messages are gone, wherever they are in the order,
+         * and then the oldest ones, to stay within the capacity.
+         */
+        for (auto order = _order.begin(); order != _order.end();)
+        {
+            if ((*order)->first.message.expired())
+            {
+                _texts.erase(*order);
+                order = _order.erase(order);
+            }
+            else
+            {
+                ++order;
+            }
+        }
+
+        while (_texts.size() > _capacity)
+        {
+            _texts.erase(_order.front());
+            _order.pop_front();
+        }
+
+        return text;
+    }
+
+    uint64_t written() const
+    {
+        return _written;
+    }
+
+private:
+
+    /**
+     * @brief A message, identified by the control block of its shared pointer, and a submember.
+     */
+    struct Key
+    {
+        std::weak_ptr<const xtypes::DynamicData> message;
+        std::string submember;
+    };
+
+    struct KeyLess
+    {
+        bool operator ()(
+                const Key& a,
+                const Key& b) const
+        {
+            if (a.message.owner_before(b.message))
+            {
+                return true;
+            }
+            if (b.message.owner_before(a.message))
+            {
+                return false;
+            }
+            return a.submember < b.submember;
+        }
+
+    };
+
+    using Texts = std::map<Key, std::shared_ptr<const std::string>, KeyLess>;
+
+    /**
+     * @brief A codec along with its own copy of the type it was compiled for,
+     *        so that it stays valid whatever happens to the types of the messages.
+     */
+    struct OwnedCodec
+    {
+        OwnedCodec(
+                const xtypes::DynamicType& message_type,
+                const std::string& submember)
+            : type(message_type)
+            , codec(*type, submember)
+        {
+        }
+
+        const xtypes::DynamicType::Ptr type;
+        const JsonCodec codec;
+    };
+
+    /**
+     * @brief A codec compiled for a type name and submember, or `nullptr` if the type
+     *        is not supported by codecs, along with the type it was compiled for.
+     */
+    struct CachedCodec
+    {
+        xtypes::DynamicType::Ptr type;
+        std::shared_ptr<const JsonCodec> codec;
+    };
+
+    /**
+     * @brief Gets the codec of a type and submember, or `nullptr` if the type is not supported by codecs.
+     *
+     *        Codecs are looked up by the name of the type, rather than by its address, which
+     *        may be reused by another type once the first one is destroyed. The cached type is
+     *        checked to be equal to the requested one, and the codec is compiled again if a
+     *        different type with the same name shows up.
+     */
+    std::shared_ptr<const JsonCodec> codec_for(
+            const xtypes::DynamicType& type,
+            const std::string& submember)
+    {
+        CachedCodec& cached = _codecs[std::make_pair(type.name(), submember)];
+        if (cached.type.get() != nullptr
+                && cached.type->is_compatible(type) == xtypes::TypeConsistency::EQUALS)
+        {
+            return cached.codec;
+        }
+
+        cached.type = xtypes::DynamicType::Ptr(type);
+        cached.codec.reset();
+        try
+        {
+            const auto owned = std::make_shared<const OwnedCodec>(type, submember);
+            cached.codec = std::shared_ptr<const JsonCodec>(owned, &owned->codec);
+        }
+        catch (const UnsupportedType&)
+        {
+            // Written by `convert` instead, from now on.
+        }
+        return cached.codec;
+    }
+
+    const std::size_t _capacity;
+    std::atomic<uint64_t> _written;
+
+    Texts _texts;
+    std::deque<Texts::iterator> _order;
+    std::map<std::pair<std::string, std::string>, CachedCodec> _codecs;
+    std::mutex _mutex;
+};
+
+//==============================================================================
+JsonTextCache::JsonTextCache(
+        std::size_t capacity)
+    : _pimpl(new Implementation(capacity))
+{
+}
+
+//==============================================================================
+JsonTextCache::~JsonTextCache() = default;
+
+//==============================================================================
+std::shared_ptr<const std::string> JsonTextCache::text(
+        const std::shared_ptr<const xtypes::DynamicData>& message,
+        const std::string& submember)
+{
+    return _pimpl->text(message, submember);
+}
+
+//==============================================================================
+uint64_t JsonTextCache::written() const
+{
+    return _pimpl->written();
+}
+
+} //  namespace json_xtypes
+} //  namespace is
+} //  namespace eprosima
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/json-xtypes/conversion.hpp>
+
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::is::json_xtypes;
+using eprosima::is::json_xtypes::test::inner_type;
+using eprosima::is::json_xtypes::test::outer_message;
+using eprosima::is::json_xtypes::test::outer_type;
+
+namespace {
+
+using Format = BinaryCodec::Format;
+
+Json decode(
+        Format format,
+        const std::vector<uint8_t>& buffer)
+{
+    return format == Format::CBOR ? Json::from_cbor(buffer) : Json::from_msgpack(buffer);
+}
+
+std::vector<uint8_t> encode(
+        Format format,
+        const Json& json)
+{
+    return format == Format::CBOR ? Json::to_cbor(json) : Json::to_msgpack(json);
+}
+
+/**
+ * Encodes an Inner value with an `other` member not present in the type, holding `depth`
+ * arrays nested into each other. Members are encoded in alphabetical order, so `other`
+ * comes last, and its null value is replaced by the nested arrays.
+ */
+std::vector<uint8_t> with_nested_arrays(
+        Format format,
+        std::size_t depth)
+{
+    std::vector<uint8_t> buffer = encode(format, Json{{"int", 3}, {"double", 0.5}, {"other", nullptr}});
+    buffer.pop_back();
+    buffer.insert(buffer.end(), depth, format == Format::CBOR ? 0x81 : 0x91);
+    buffer.push_back(format == Format::CBOR ? 0x80 : 0x90);
+    return buffer;
+}
+
+class BinaryCodecTest : public testing::TestWithParam<Format>
+{
+};
+
+} //  anonymous namespace
+
+TEST_P(BinaryCodecTest, Encodings_decode_to_the_Json_conversion)
+{
+    const xtypes::StructType type = outer_type();
+    const xtypes::DynamicData message = outer_message(type);
+    const BinaryCodec codec(type, GetParam());
+
+    ASSERT_EQ(decode(GetParam(), codec.write(message)), convert(message));
+}
+
+TEST_P(BinaryCodecTest, Encodings_round_trip)
+{
+    const xtypes::StructType type = outer_type();
+    const xtypes::DynamicData message = outer_message(type);
+    const BinaryCodec codec(type, GetParam());
+
+    const std::vector<uint8_t> written = codec.write(message);
+    ASSERT_EQ(codec.parse(written.data(), written.size()), message);
+
+    const std::vector<uint8_t> encoded = encode(GetParam(), convert(message));
+    ASSERT_EQ(codec.parse(encoded.data(), encoded.size()), message);
+}
+
+TEST_P(BinaryCodecTest, Submembers_round_trip)
+{
+    const xtypes::StructType type = inner_type();
+    xtypes::DynamicData message(type);
+    message["int"] = 3;
+    message["double"] = 0.5;
+
+    const BinaryCodec codec(type, GetParam(), "value");
+    const std::vector<uint8_t> encoded = codec.write(message);
+    ASSERT_EQ(decode(GetParam(), encoded), convert(message, "value"));
+    ASSERT_EQ(codec.parse(encoded.data(), encoded.size()), message);
+}
+
+TEST_P(BinaryCodecTest, Truncated_buffers_are_rejected)
+{
+    const xtypes::StructType type = outer_type();
+    const BinaryCodec codec(type, GetParam());
+    const std::vector<uint8_t> encoded = codec.write(outer_message(type));
+
+    for (std::size_t size = 0; size < encoded.size(); ++size)
+    {
+        ASSERT_THROW(codec.parse(encoded.data(), size), Json::parse_error) << "size " << size;
+    }
+
+    std::vector<uint8_t> trailing = encoded;
+    trailing.push_back(0);
+    ASSERT_THROW(codec.parse(trailing.data(), trailing.size()), Json::parse_error);
+}
+
+TEST_P(BinaryCodecTest, Mismatching_values_are_rejected)
+{
+    const xtypes::StructType type = inner_type();
+    const BinaryCodec codec(type, GetParam());
+
+    const std::vector<uint8_t> missing = encode(GetParam(), Json{{"int", 3}});
+    ASSERT_THROW(codec.parse(missing.data(), missing.size()), Json::type_error);
+
+    const std::vector<uint8_t> text = encode(GetParam(), Json{{"int", "3"}, {"double", 0.5}});
+    ASSERT_THROW(codec.parse(text.data(), text.size()), Json::type_error);
+
+    const std::vector<uint8_t> array = encode(GetParam(), Json::array({3, 0.5}));
+    ASSERT_THROW(codec.parse(array.data(), array.size()), Json::type_error);
+}
+
+TEST_P(BinaryCodecTest, Element_counts_are_checked_before_allocating)
+{
+    xtypes::StructType type("Values");
+    type.add_member("values", xtypes::SequenceType(xtypes::primitive_type<uint8_t>()));
+    const BinaryCodec codec(type, GetParam());
+
+    /**
+     * A map with the `values` member, declared to hold 2^32 - 1 elements, but holding none.
+     */
+    std::vector<uint8_t> buffer = encode(GetParam(), Json{{"values", nullptr}});
+    buffer.pop_back();
+    buffer.push_back(GetParam() == Format::CBOR ? 0x9a : 0xdd);
+    buffer.insert(buffer.end(), 4, 0xff);
+
+    ASSERT_THROW(codec.parse(buffer.data(), buffer.size()), Json::parse_error);
+}
+
+TEST_P(BinaryCodecTest, Nesting_depth_is_limited)
+{
+    const xtypes::StructType type = inner_type();
+    const BinaryCodec codec(type, GetParam());
+
+    /**
+     * Members not present in the type are skipped, whatever they contain,
+     * as long as they do not nest too deep.
+     */
+    const std::vector<uint8_t> shallow = with_nested_arrays(GetParam(), 200);
+    ASSERT_EQ(codec.parse(shallow.data(), shallow.size()), convert(type, decode(GetParam(), shallow)));
+
+    const std::vector<uint8_t> deep = with_nested_arrays(GetParam(), 100000);
+    ASSERT_THROW(codec.parse(deep.data(), deep.size()), Json::parse_error);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    BinaryCodec,
+    BinaryCodecTest,
+    testing::Values(Format::CBOR, Format::MSGPACK),
+    [](const testing::TestParamInfo<Format>& info)
+    {
+        return info.param == Format::CBOR ? "CBOR" : "MessagePack";
+    });
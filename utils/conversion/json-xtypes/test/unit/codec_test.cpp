@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/json-xtypes/conversion.hpp>
+
+#include "test_utils.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace eprosima::is::json_xtypes;
+using eprosima::is::json_xtypes::test::inner_type;
+using eprosima::is::json_xtypes::test::outer_message;
+using eprosima::is::json_xtypes::test::outer_type;
+
+namespace {
+
+/**
+ * Nests `depth` arrays into each other.
+ */
+std::string nested_arrays(
+        std::size_t depth)
+{
+    return std::string(depth, '[') + std::string(depth, ']');
+}
+
+} //  anonymous namespace
+
+TEST(JsonCodec, Written_text_matches_the_Json_conversion)
+{
+    const xtypes::StructType type = outer_type();
+    const xtypes::DynamicData message = outer_message(type);
+    const JsonCodec codec(type);
+
+    ASSERT_EQ(Json::parse(codec.write(message)), convert(message));
+}
+
+TEST(JsonCodec, Parsed_text_matches_the_Json_conversion)
+{
+    const xtypes::StructType type = outer_type();
+    const xtypes::DynamicData message = outer_message(type);
+    const JsonCodec codec(type);
+
+    const std::string text = convert(message).dump();
+    ASSERT_EQ(codec.parse(text), message);
+    ASSERT_EQ(codec.parse(text), convert(type, Json::parse(text)));
+
+    // Round trip through the codec alone.
+    ASSERT_EQ(codec.parse(codec.write(message)), message);
+}
+
+TEST(JsonCodec, Submembers_round_trip)
+{
+    const xtypes::StructType type = inner_type();
+    xtypes::DynamicData message(type);
+    message["int"] = 3;
+    message["double"] = 0.5;
+
+    const JsonCodec codec(type, "value");
+    const std::string text = codec.write(message);
+    ASSERT_EQ(Json::parse(text), convert(message, "value"));
+    ASSERT_EQ(codec.parse(text), message);
+}
+
+TEST(JsonCodec, Malformed_text_is_rejected)
+{
+    const xtypes::StructType type = inner_type();
+    const JsonCodec codec(type);
+
+    ASSERT_THROW(codec.parse(""), Json::parse_error);
+    ASSERT_THROW(codec.parse("{\"int\": 3, \"double\": 0.5"), Json::parse_error);
+    ASSERT_THROW(codec.parse("{\"int\": 3, \"double\": 0.5}}"), Json::parse_error);
+    ASSERT_THROW(codec.parse("{\"int\": 3 \"double\": 0.5}"), Json::parse_error);
+    ASSERT_THROW(codec.parse("{\"int\": 3, \"double\": 0.5, \"other\": tru}"), Json::parse_error);
+    ASSERT_THROW(codec.parse("{\"int\": 3, \"double\": 0.5, \"other\": \"unterminated}"), Json::parse_error);
+    ASSERT_THROW(codec.parse("{\"int\": 3, \"double\": 0.5, \"other\": [1, 2}"), Json::parse_error);
+}
+
+TEST(JsonCodec, Mismatching_values_are_rejected)
+{
+    const xtypes::StructType type = inner_type();
+    const JsonCodec codec(type);
+
+    ASSERT_THROW(codec.parse("{\"int\": 3}"), Json::type_error);
+    ASSERT_THROW(codec.parse("{\"int\": \"3\", \"double\": 0.5}"), Json::type_error);
+    ASSERT_THROW(codec.parse("[3, 0.5]"), Json::type_error);
+}
+
+TEST(JsonCodec, Nesting_depth_is_limited)
+{
+    const xtypes::StructType type = inner_type();
+    const JsonCodec codec(type);
+
+    /**
+     * Members not present in the type are skipped, whatever they contain,
+     * as long as they do not nest too deep.
+     */
+    const std::string shallow = "{\"int\": 3, \"double\": 0.5, \"other\": " + nested_arrays(200) + "}";
+    ASSERT_EQ(codec.parse(shallow), convert(type, Json::parse(shallow)));
+
+    const std::string deep = "{\"int\": 3, \"double\": 0.5, \"other\": " + nested_arrays(100000) + "}";
+    ASSERT_THROW(codec.parse(deep), Json::parse_error);
+
+    std::string deep_objects;
+    for (std::size_t i = 0; i < 100000; ++i)
+    {
+        deep_objects += "{\"other\": ";
+    }
+    ASSERT_THROW(codec.parse(deep_objects), Json::parse_error);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/json-xtypes/conversion.hpp>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace eprosima::is::json_xtypes;
+
+namespace {
+
+xtypes::StructType pose_type()
+{
+    xtypes::StructType position("Position");
+    position.add_member("x", xtypes::primitive_type<double>());
+    position.add_member("y", xtypes::primitive_type<double>());
+
+    xtypes::StructType type("Pose");
+    type.add_member("frame", xtypes::StringType());
+    type.add_member("position", position);
+    type.add_member("path", xtypes::SequenceType(xtypes::primitive_type<int32_t>()));
+    return type;
+}
+
+xtypes::DynamicData pose(
+        const xtypes::DynamicType& type,
+        const std::string& frame,
+        double x,
+        double y)
+{
+    xtypes::DynamicData message(type);
+    message["frame"] = frame;
+    message["position"]["x"] = x;
+    message["position"]["y"] = y;
+    return message;
+}
+
+} //  anonymous namespace
+
+TEST(JsonDeltaEncoder, Only_changed_members_are_encoded)
+{
+    const xtypes::StructType type = pose_type();
+    JsonDeltaEncoder encoder;
+    bool keyframe = false;
+
+    const xtypes::DynamicData first = pose(type, "map", 1.0, 2.0);
+    ASSERT_EQ(encoder.encode("pose", first, keyframe), convert(first));
+    ASSERT_TRUE(keyframe);
+
+    ASSERT_EQ(encoder.encode("pose", first, keyframe), Json::object());
+    ASSERT_FALSE(keyframe);
+
+    /**
+     * Nested structures only hold their changed members.
+     */
+    const xtypes::DynamicData moved = pose(type, "map", 1.0, 3.0);
+    Json changes = encoder.encode("pose", moved, keyframe);
+    ASSERT_FALSE(keyframe);
+    ASSERT_EQ(changes, Json::parse(R"({"position": {"y": 3.0}})"));
+
+    /**
+     * Sequences are sent whole.
+     */
+    xtypes::DynamicData extended = pose(type, "map", 1.0, 3.0);
+    extended["path"].push(int32_t(4));
+    extended["path"].push(int32_t(5));
+    changes = encoder.encode("pose", extended, keyframe);
+    ASSERT_FALSE(keyframe);
+    ASSERT_EQ(changes.size(), 1u);
+    ASSERT_EQ(changes["path"], convert(extended)["path"]);
+}
+
+TEST(JsonDeltaEncoder, Keyframes_follow_the_interval_of_each_stream)
+{
+    const xtypes::StructType type = pose_type();
+    JsonDeltaEncoder encoder(3);
+    bool keyframe = false;
+
+    const xtypes::DynamicData message = pose(type, "map", 1.0, 2.0);
+    std::vector<bool> keyframes;
+    for (std::size_t i = 0; i < 7; ++i)
+    {
+        encoder.encode("pose", message, keyframe);
+        keyframes.push_back(keyframe);
+    }
+    ASSERT_EQ(keyframes, std::vector<bool>({true, false, false, true, false, false, true}));
+
+    /**
+     * Streams are independent, and a reset makes the next message a keyframe.
+     */
+    encoder.encode("other", message, keyframe);
+    ASSERT_TRUE(keyframe);
+    encoder.encode("pose", message, keyframe);
+    ASSERT_FALSE(keyframe);
+
+    encoder.reset("pose");
+    ASSERT_EQ(encoder.encode("pose", message, keyframe), convert(message));
+    ASSERT_TRUE(keyframe);
+    encoder.encode("other", message, keyframe);
+    ASSERT_FALSE(keyframe);
+}
+
+TEST(JsonDeltaEncoder, A_zero_interval_only_sends_the_first_keyframe)
+{
+    const xtypes::StructType type = pose_type();
+    JsonDeltaEncoder encoder(0);
+    bool keyframe = false;
+
+    const xtypes::DynamicData message = pose(type, "map", 1.0, 2.0);
+    encoder.encode("pose", message, keyframe);
+    ASSERT_TRUE(keyframe);
+    for (std::size_t i = 0; i < 500; ++i)
+    {
+        encoder.encode("pose", message, keyframe);
+        ASSERT_FALSE(keyframe);
+    }
+}
+
+TEST(JsonDeltaEncoder, Applied_changes_rebuild_each_message)
+{
+    const xtypes::StructType type = pose_type();
+    JsonDeltaEncoder encoder(4, "msg");
+    bool keyframe = false;
+    Json state;
+
+    /**
+     * Keyframes come every four messages, whereas the path empties every three,
+     * so that some deltas shrink it.
+     */
+    for (std::size_t i = 0; i < 10; ++i)
+    {
+        xtypes::DynamicData message = pose(type, i % 3 == 0 ? "map" : "odom", 1.0, double(i / 2));
+        for (std::size_t j = 0; j < i % 3; ++j)
+        {
+            message["path"].push(int32_t(j));
+        }
+
+        JsonDeltaEncoder::apply(encoder.encode("pose", message, keyframe), state);
+        ASSERT_EQ(state, convert(message, "msg"));
+    }
+}
+
+TEST(JsonDeltaEncoder, Applied_nulls_are_kept_rather_than_removing_members)
+{
+    Json state = Json::parse(R"({"a": 1, "b": {"c": 2, "d": [1, 2]}, "e": {"f": 3}})");
+
+    JsonDeltaEncoder::apply(Json::parse(R"({"a": null, "b": {"d": null}})"), state);
+    ASSERT_EQ(state, Json::parse(R"({"a": null, "b": {"c": 2, "d": null}, "e": {"f": 3}})"));
+
+    /**
+     * Objects replace the null values found in the state, and members missing
+     * from the state are added.
+     */
+    JsonDeltaEncoder::apply(Json::parse(R"({"a": {"g": 4}, "h": 5})"), state);
+    ASSERT_EQ(state, Json::parse(R"({"a": {"g": 4}, "b": {"c": 2, "d": null}, "e": {"f": 3}, "h": 5})"));
+
+    /**
+     * Values other than objects replace the whole state.
+     */
+    JsonDeltaEncoder::apply(Json(7), state);
+    ASSERT_EQ(state, Json(7));
+    JsonDeltaEncoder::apply(Json::parse(R"({"a": 1})"), state);
+    ASSERT_EQ(state, Json::parse(R"({"a": 1})"));
+}
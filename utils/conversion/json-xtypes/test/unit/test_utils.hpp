@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef _IS_JSON_XTYPES_TEST_UNIT_TEST_UTILS_HPP_
+#define _IS_JSON_XTYPES_TEST_UNIT_TEST_UTILS_HPP_
+
+#include <is/json-xtypes/conversion.hpp>
+
+#include <string>
+
+namespace eprosima {
+namespace is {
+namespace json_xtypes {
+namespace test {
+
+/**
+ * @brief Builds the type `Inner`, made of an `int32_t` and a `double`.
+ */
+inline xtypes::StructType inner_type()
+{
+    xtypes::StructType inner("Inner");
+    inner.add_member("int", xtypes::primitive_type<int32_t>());
+    inner.add_member("double", xtypes::primitive_type<double>());
+    return inner;
+}
+
+/**
+ * @brief Builds the type `Outer`, which has a member of every kind the codecs handle.
+ */
+inline xtypes::StructType outer_type()
+{
+    xtypes::StructType outer("Outer");
+    outer.add_member("int", xtypes::primitive_type<int32_t>());
+    outer.add_member("small", xtypes::primitive_type<int8_t>());
+    outer.add_member("big", xtypes::primitive_type<uint64_t>());
+    outer.add_member("negative", xtypes::primitive_type<int64_t>());
+    outer.add_member("flag", xtypes::primitive_type<bool>());
+    outer.add_member("string", xtypes::StringType());
+    outer.add_member("array", xtypes::ArrayType(xtypes::primitive_type<uint16_t>(), 3));
+    outer.add_member("sequence", xtypes::SequenceType(xtypes::primitive_type<double>()));
+    outer.add_member("empty", xtypes::SequenceType(xtypes::primitive_type<int32_t>()));
+    outer.add_member("inner", inner_type());
+    outer.add_member("inners", xtypes::SequenceType(inner_type()));
+    return outer;
+}
+
+/**
+ * @brief Builds a message of the type `Outer`, whose values need escaping in text
+ *        and the wider encodings in binary.
+ */
+inline xtypes::DynamicData outer_message(
+        const xtypes::StructType& type)
+{
+    xtypes::DynamicData message(type);
+    message["int"] = -42;
+    message["small"] = int8_t(-100);
+    message["big"] = uint64_t(1) << 40;
+    message["negative"] = -(int64_t(1) << 40);
+    message["flag"] = true;
+    message["string"] = std::string("Hello \"json\"\n") + std::string(300, 'x');
+    for (size_t i = 0; i < message["array"].size(); ++i)
+    {
+        message["array"][i] = static_cast<uint16_t>(10 + 1000 * i);
+    }
+    message["sequence"].push(50.25);
+    message["sequence"].push(-100.5);
+    message["inner"]["int"] = 1042;
+    message["inner"]["double"] = 10.125;
+
+    xtypes::DynamicData inner(inner_type());
+    inner["int"] = 7;
+    inner["double"] = 5.5;
+    message["inners"].push(inner);
+    message["inners"].push(inner);
+    return message;
+}
+
+} //  namespace test
+} //  namespace json_xtypes
+} //  namespace is
+} //  namespace eprosima
+
+#endif //  _IS_JSON_XTYPES_TEST_UNIT_TEST_UTILS_HPP_
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/json-xtypes/conversion.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+using namespace eprosima::is::json_xtypes;
+
+namespace {
+
+xtypes::StructType text_type()
+{
+    xtypes::StructType type("Message");
+    type.add_member("data", xtypes::StringType());
+    return type;
+}
+
+xtypes::StructType number_type()
+{
+    xtypes::StructType type("Message");
+    type.add_member("count", xtypes::primitive_type<uint32_t>());
+    return type;
+}
+
+std::shared_ptr<const xtypes::DynamicData> text_message(
+        const xtypes::DynamicType& type,
+        const std::string& data)
+{
+    auto message = std::make_shared<xtypes::DynamicData>(type);
+    (*message)["data"] = data;
+    return message;
+}
+
+} //  anonymous namespace
+
+TEST(JsonTextCache, Texts_are_written_once_per_message_and_submember)
+{
+    const xtypes::StructType type = text_type();
+    JsonTextCache cache;
+
+    const auto message = text_message(type, "hello");
+    const auto text = cache.text(message);
+    ASSERT_EQ(Json::parse(*text), convert(*message));
+    ASSERT_EQ(cache.text(message), text);
+    ASSERT_EQ(cache.written(), 1u);
+
+    const auto submember_text = cache.text(message, "msg");
+    ASSERT_EQ(Json::parse(*submember_text), convert(*message, "msg"));
+    ASSERT_EQ(cache.written(), 2u);
+
+    /**
+     * An equal message in another instance is another message.
+     */
+    ASSERT_NE(cache.text(text_message(type, "hello")), text);
+    ASSERT_EQ(cache.written(), 3u);
+}
+
+TEST(JsonTextCache, Texts_of_released_messages_are_dropped)
+{
+    const xtypes::StructType type = text_type();
+    JsonTextCache cache(2);
+
+    const auto kept = text_message(type, "kept");
+    const auto kept_text = cache.text(kept);
+
+    /**
+     * The messages released right away never fill the cache, even though they are
+     * not the oldest entries, so the text of the kept message stays cached.
+     */
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+        cache.text(text_message(type, std::to_string(i)));
+    }
+    ASSERT_EQ(cache.text(kept), kept_text);
+    ASSERT_EQ(cache.written(), 9u);
+
+    /**
+     * Live messages beyond the capacity drop the oldest text.
+     */
+    const auto first = text_message(type, "first");
+    const auto second = text_message(type, "second");
+    cache.text(first);
+    cache.text(second);
+    ASSERT_NE(cache.text(kept), kept_text);
+    ASSERT_EQ(cache.written(), 12u);
+}
+
+TEST(JsonTextCache, Types_with_the_same_name_get_their_own_codec)
+{
+    JsonTextCache cache;
+
+    /**
+     * The first type is destroyed before the second one is created, so the second one
+     * may take its address.
+     */
+    {
+        const auto type = std::make_unique<xtypes::StructType>(text_type());
+        const auto message = text_message(*type, "text");
+        ASSERT_EQ(Json::parse(*cache.text(message)), convert(*message));
+    }
+
+    const auto type = std::make_unique<xtypes::StructType>(number_type());
+    auto message = std::make_shared<xtypes::DynamicData>(*type);
+    (*message)["count"] = uint32_t(7);
+    ASSERT_EQ(Json::parse(*cache.text(message)), convert(*message));
+    ASSERT_EQ(Json::parse(*cache.text(message))["count"], 7);
+}
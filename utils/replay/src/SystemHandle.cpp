@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+
+#include <is/systemhandle/SystemHandle.hpp>
+#include <is/core/runtime/TrafficReader.hpp>
+#include <is/utils/Log.hpp>
+
+#include <atomic>
+#include <map>
+#include <thread>
+
+namespace eprosima {
+namespace is {
+namespace sh {
+namespace replay {
+
+using core::TrafficReader;
+using core::TrafficRecorder;
+
+/**
+ * @class Client
+ *        Service client on behalf of which the recorded requests are sent.
+ *        Replies are only counted, since nobody waits for them in a replay.
+ */
+class Client : public virtual ServiceClient
+{
+public:
+
+    void receive_response(
+            std::shared_ptr<void> /*call_handle*/,
+            const eprosima::xtypes::DynamicData& /*response*/) override
+    {
+        ++replies;
+    }
+
+    std::atomic<uint64_t> replies{0};
+};
+
+/**
+ * @class SystemHandle
+ *        Streams back the messages and requests of a capture file written by the
+ *        `recording` section of *Integration Service*, as if they came from
+ *        the middlewares they were recorded from.
+ *
+ *        Its configuration takes the `file` to replay, and the `rate` it is replayed at:
+ *        either `original`, keeping the recorded pace, or `max`, as fast as the routes
+ *        can take it. With `loop: true`, the file is replayed over and over again.
+ *
+ *        Samples are delivered to the topics and services with the same name, as long
+ *        as they are routed with the recorded type, which must be given by the `types`
+ *        section or by the `types-from` tag of this system.
+ */
+class SystemHandle
+    : public virtual TopicSubscriberSystem
+    , public virtual ServiceClientSystem
+{
+public:
+
+    SystemHandle()
+        : _logger("is::sh::Replay")
+        , _max_rate(false)
+        , _loop(false)
+        , _stop(false)
+    {
+    }
+
+    ~SystemHandle() override
+    {
+        _stop = true;
+        if (_thread.joinable())
+        {
+            _thread.join();
+        }
+    }
+
+    bool configure(
+            const core::RequiredTypes& /*types*/,
+            const YAML::Node& configuration,
+            TypeRegistry& /*type_registry*/) override
+    {
+        const YAML::Node& file = configuration["file"];
+        if (!file)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "The 'file' to replay is missing from the configuration." << std::endl;
+            return false;
+        }
+
+        _reader = TrafficReader::open(file.as<std::string>());
+        if (!_reader)
+        {
+            _logger << utils::Logger::Level::ERROR
+                    << "Could not open the capture file '" << file.as<std::string>() << "'." << std::endl;
+            return false;
+        }
+
+        const YAML::Node& rate = configuration["rate"];
+        if (rate)
+        {
+            const std::string value = rate.as<std::string>();
+            if (value != "original" && value != "max")
+            {
+                _logger << utils::Logger::Level::ERROR
+                        << "Unknown replay rate '" << value << "'. "
+                        << "Valid values are 'original' and 'max'." << std::endl;
+                return false;
+            }
+            _max_rate = value == "max";
+        }
+
+        const YAML::Node& loop = configuration["loop"];
+        _loop = loop && loop.as<bool>();
+
+        return true;
+    }
+
+    bool okay() const override
+    {
+        return true;
+    }
+
+    bool spin_once() override
+    {
+        // The replay starts once every route has been configured.
+        if (!_thread.joinable())
+        {
+            _thread = std::thread(&SystemHandle::replay, this);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        return true;
+    }
+
+    bool subscribe(
+            const std::string& topic_name,
+            const eprosima::xtypes::DynamicType& message_type,
+            TopicSubscriberSystem::SubscriptionCallback* callback,
+            const YAML::Node& /*configuration*/) override
+    {
+        _topics.emplace(topic_name, Destination{&message_type, callback, nullptr, {}});
+        return true;
+    }
+
+    bool is_internal_message(
+            void* /*filter_handle*/) override
+    {
+        return false;
+    }
+
+    bool create_client_proxy(
+            const std::string& service_name,
+            const eprosima::xtypes::DynamicType& service_type,
+            RequestCallback* callback,
+            const YAML::Node& /*configuration*/) override
+    {
+        _services.emplace(service_name, Destination{&service_type, nullptr, callback, {}});
+        return true;
+    }
+
+private:
+
+    /**
+     * @brief A topic or service where the recorded samples are delivered.
+     */
+    struct Destination
+    {
+        const eprosima::xtypes::DynamicType* type;
+        TopicSubscriberSystem::SubscriptionCallback* subscription;
+        RequestCallback* request;
+        std::unique_ptr<eprosima::xtypes::DynamicData> data;
+    };
+
+    void replay()
+    {
+        uint64_t replayed = 0;
+        uint64_t skipped = 0;
+
+        do
+        {
+            _reader->rewind();
+
+            TrafficReader::Sample sample;
+            std::chrono::nanoseconds first(0);
+            const auto start = std::chrono::steady_clock::now();
+
+            for (bool is_first = true; !_stop && _reader->next(sample); is_first = false)
+            {
+                if (is_first)
+                {
+                    first = sample.timestamp;
+                }
+
+                if (!_max_rate)
+                {
+                    std::this_thread::sleep_until(start + (sample.timestamp - first));
+                }
+
+                if (deliver(sample))
+                {
+                    ++replayed;
+                }
+                else
+                {
+                    ++skipped;
+                }
+            }
+        } while (_loop && !_stop);
+
+        _logger << utils::Logger::Level::INFO
+                << "Replayed " << replayed << " samples, skipped " << skipped
+                << " samples without a matching route, and received " << _client.replies
+                << " replies." << std::endl;
+    }
+
+    bool deliver(
+            const TrafficReader::Sample& sample)
+    {
+        auto& destinations = sample.kind == TrafficRecorder::Kind::MESSAGE ? _topics : _services;
+        const auto it = destinations.find(std::string(sample.name));
+        if (it == destinations.end() || it->second.type->name() != sample.type)
+        {
+            return false;
+        }
+
+        /**
+         * Each destination decodes its samples into the same instance,
+         * which routes only borrow during the callback.
+         */
+        Destination& destination = it->second;
+        if (!destination.data)
+        {
+            destination.data.reset(new eprosima::xtypes::DynamicData(*destination.type));
+        }
+
+        if (!TrafficRecorder::decode(sample.payload, sample.size, *destination.data))
+        {
+            _logger << utils::Logger::Level::WARN
+                    << "Skipping a corrupt sample of '" << sample.name << "'." << std::endl;
+            return false;
+        }
+
+        if (destination.subscription)
+        {
+            (*destination.subscription)(*destination.data, nullptr);
+        }
+        else
+        {
+            (*destination.request)(*destination.data, _client, nullptr);
+        }
+
+        return true;
+    }
+
+    utils::Logger _logger;
+    std::unique_ptr<TrafficReader> _reader;
+    bool _max_rate;
+    bool _loop;
+
+    std::map<std::string, Destination> _topics;
+    std::map<std::string, Destination> _services;
+    Client _client;
+
+    std::atomic_bool _stop;
+    std::thread _thread;
+};
+
+} //  namespace replay
+} //  namespace sh
+} //  namespace is
+} //  namespace eprosima
+
+IS_REGISTER_SYSTEM("replay", eprosima::is::sh::replay::SystemHandle)
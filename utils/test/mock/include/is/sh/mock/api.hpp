@@ -23,9 +23,12 @@
 #include <is/mock/export.hpp> // TODO (@jamoralp): convert this into is/sh/mock
 
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <future>
 #include <string>
+#include <vector>
 
 namespace eprosima {
 namespace is {
@@ -36,6 +39,20 @@ bool IS_MOCK_API publish_message(
         const std::string& topic,
         const xtypes::DynamicData& msg);
 
+/// Publish a message as if the mock middleware had received it from a publisher
+/// tagged with origin_tag. Messages tagged with the tag of the mock system
+/// subscribed to the topic, as given by origin_tag(), are its own internal messages,
+/// which Integration Service must discard.
+bool IS_MOCK_API publish_message(
+        const std::string& topic,
+        const xtypes::DynamicData& msg,
+        uint64_t origin_tag);
+
+/// Get the origin tag accepted by the mock system subscribed to a topic, or
+/// zero if no mock system is subscribed to it.
+uint64_t IS_MOCK_API origin_tag(
+        const std::string& topic);
+
 
 using MockSubscriptionCallback = std::function<void (const xtypes::DynamicData&)>;
 
@@ -43,6 +60,23 @@ bool IS_MOCK_API subscribe(
         const std::string& topic,
         MockSubscriptionCallback callback);
 
+/// Publish a serialized payload as if the mock middleware had received it.
+/// It only reaches Integration Service if the topic was subscribed raw, which
+/// happens when its source and destination mock systems are configured with
+/// the same raw_encoding and none of the settings of the topic needs the
+/// deserialized messages.
+bool IS_MOCK_API publish_raw(
+        const std::string& topic,
+        const std::vector<uint8_t>& payload);
+
+using MockRawSubscriptionCallback = std::function<void (const std::vector<uint8_t>& payload)>;
+
+/// Subscribe to the serialized payloads that Integration Service forwards raw
+/// to a topic.
+bool IS_MOCK_API subscribe_raw(
+        const std::string& topic,
+        MockRawSubscriptionCallback callback);
+
 // TODO (@jamoralp): mock documentation
 
 /// Request a service
@@ -65,6 +99,74 @@ void IS_MOCK_API serve(
         MockServiceCallback callback,
         const std::string& type = "");
 
+/// Settings of a synthetic load, generated by publish_load() or request_load()
+/// to saturate the routing path of Integration Service in load tests.
+struct LoadSettings
+{
+    /// Number of messages published, or requests made.
+    std::size_t count = 1000;
+
+    /// Messages or requests per second, among all the threads. Zero sends them
+    /// as fast as possible.
+    double rate = 0.0;
+
+    /// Number of threads sending the messages or requests.
+    std::size_t threads = 1;
+
+    /// If not empty, the string member of the sample that gets a payload of a
+    /// size uniformly distributed between min_payload and max_payload.
+    std::string payload_member;
+    std::size_t min_payload = 0;
+    std::size_t max_payload = 0;
+
+    /// If not empty, the uint64 member of the sample that gets the time each
+    /// message or request is sent at, in nanoseconds of the steady clock.
+    std::string stamp_member;
+
+    /// Maximum number of requests waiting for their reply. Zero means no limit.
+    std::size_t max_in_flight = 0;
+
+    /// Time to wait for the replies, once all the requests were made.
+    std::chrono::nanoseconds timeout = std::chrono::seconds(10);
+};
+
+/// Outcome of a synthetic load.
+struct LoadResult
+{
+    /// Messages published, or requests made.
+    std::size_t sent = 0;
+
+    /// Messages accepted by Integration Service, or requests replied.
+    std::size_t completed = 0;
+
+    /// Requests cancelled by Integration Service.
+    std::size_t cancelled = 0;
+
+    /// Time since the first message or request was sent until the last one
+    /// was completed.
+    std::chrono::nanoseconds elapsed = std::chrono::nanoseconds::zero();
+};
+
+/// Publish a synthetic load of copies of a sample message. Messages are handed
+/// to Integration Service straight from the sending threads, without any lookup
+/// or allocation per message. It returns once all of them were published.
+LoadResult IS_MOCK_API publish_load(
+        const std::string& topic,
+        const xtypes::DynamicData& sample,
+        const LoadSettings& settings);
+
+using MockReplyCallback = std::function<void (const xtypes::DynamicData& reply,
+            std::chrono::nanoseconds round_trip)>;
+
+/// Make a synthetic load of copies of a sample request, from a pool of threads.
+/// Replies may be received from any thread, and are given to on_reply, if set.
+/// It returns once all the requests were completed, or the timeout elapsed.
+LoadResult IS_MOCK_API request_load(
+        const std::string& topic,
+        const xtypes::DynamicData& request_msg,
+        const LoadSettings& settings,
+        MockReplyCallback on_reply = nullptr);
+
 
 } //  namespace mock
 } //  namespace sh
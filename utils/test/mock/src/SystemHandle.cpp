@@ -20,7 +20,11 @@
 
 #include <is/systemhandle/SystemHandle.hpp>
 
+#include <algorithm>
+#include <condition_variable>
 #include <iostream>
+#include <random>
+#include <thread>
 
 // TODO(@jamoralp): Document doxygen
 // TODO(@jamoralp): Add logger
@@ -53,10 +57,20 @@ public:
     Channels services;
 
     std::map<std::string, TopicSubscriberSystem::SubscriptionCallback*> is_subscription_callbacks;
+    std::map<std::string, TopicSubscriberSystem::RawSubscriptionCallback*> is_raw_subscription_callbacks;
+    std::map<std::string, uint64_t> is_subscription_origin_tags;
 
     std::map<std::string, ServiceClientSystem::RequestCallback*> is_request_callbacks;
 
-    std::map<std::string, std::vector<MockSubscriptionCallback> > mock_subscriptions;
+    // The subscriptions of the tests to a topic are replaced as a whole when one is
+    // added, so that publishers can read them without locking.
+    struct Channel
+    {
+        std::shared_ptr<const std::vector<MockSubscriptionCallback> > callbacks;
+        std::shared_ptr<const std::vector<MockRawSubscriptionCallback> > raw_callbacks;
+    };
+
+    std::map<std::string, Channel> mock_subscriptions;
     std::map<std::string, MockServiceCallback> mock_services;
 
     // We deposit references to clients into this vector to guarantee that their
@@ -84,9 +98,15 @@ class Publisher : public virtual TopicPublisher
 {
 public:
 
+    // Publishers are only created when advertising a topic, so they can keep
+    // the channel of their topic instead of looking it up for every message.
     Publisher(
-            const std::string& topic)
+            const std::string& topic,
+            const Implementation::Channel& channel,
+            const std::string& raw_encoding)
         : _topic(topic)
+        , _channel(channel)
+        , _raw_encoding(raw_encoding)
     {
         // Does nothing
     }
@@ -94,25 +114,37 @@ public:
     bool publish(
             const eprosima::xtypes::DynamicData& message) override
     {
-        // Tests that we have advertised this topic
-        const auto pub_it = impl().publishers.find(_topic);
-        if (pub_it == impl().publishers.end() || pub_it->second.empty())
+        const auto callbacks = std::atomic_load(&_channel.callbacks);
+        if (!callbacks)
         {
-            // We'll go ahead and throw an exception here, because this situation
-            // should be considered a bug in Integration Service
-            throw std::runtime_error(
-                      "Integration Service attempted to publish to a topic/message pair "
-                      "that it didn't advertise");
+            return true;
+        }
+
+        for (const auto& callback : *callbacks)
+        {
+            callback(message);
         }
 
+        return true;
+    }
 
-        const auto it = impl().mock_subscriptions.find(_topic);
-        if (it == impl().mock_subscriptions.end())
+    std::string raw_encoding() const override
+    {
+        return _raw_encoding;
+    }
+
+    bool publish_raw(
+            const uint8_t* payload,
+            std::size_t size) override
+    {
+        const auto callbacks = std::atomic_load(&_channel.raw_callbacks);
+        if (!callbacks)
         {
             return true;
         }
 
-        for (const auto& callback : it->second)
+        const std::vector<uint8_t> message(payload, payload + size);
+        for (const auto& callback : *callbacks)
         {
             callback(message);
         }
@@ -121,6 +153,8 @@ public:
     }
 
     const std::string _topic;
+    const Implementation::Channel& _channel;
+    const std::string _raw_encoding;
 
 };
 
@@ -141,11 +175,11 @@ public:
             ServiceClient& client,
             std::shared_ptr<void> call_handle) override
     {
-        bool only_service = impl().mock_services.count(_service) > 0;
-        const auto it =
-                (only_service
-                ? impl().mock_services.find(_service)
-                : impl().mock_services.find(_service + "_" + request.type().name()));
+        auto it = impl().mock_services.find(_service);
+        if (it == impl().mock_services.end())
+        {
+            it = impl().mock_services.find(_service + "_" + request.type().name());
+        }
 
         if (it == impl().mock_services.end())
         {
@@ -162,15 +196,22 @@ public:
 };
 
 //==============================================================================
-class SystemHandle : public virtual FullSystem
+class SystemHandle
+    : public virtual FullSystem
+    , public virtual OriginTaggingSystem
 {
 public:
 
     bool configure(
             const core::RequiredTypes&,
-            const YAML::Node&,
+            const YAML::Node& configuration,
             TypeRegistry&) override
     {
+        // Raw payloads are only exchanged by the mock systems configured with an encoding.
+        if (configuration["raw_encoding"])
+        {
+            _raw_encoding = configuration["raw_encoding"].as<std::string>();
+        }
         return true;
     }
 
@@ -182,12 +223,26 @@ public:
 
     bool spin_once() override
     {
+        if (_event_driven)
+        {
+            // Messages and requests are delivered synchronously, so there is never
+            // pending work left for the executor to process.
+            return true;
+        }
+
         // We're always spinning. We'll put a sleep here so that this thread doesn't
         // do too heavy of a dead spin.
         std::this_thread::sleep_for(std::chrono::milliseconds(50));
         return true;
     }
 
+    bool set_wake_up_callback(
+            WakeUpCallback /*callback*/) override
+    {
+        _event_driven = true;
+        return true;
+    }
+
     bool subscribe(
             const std::string& topic_name,
             const eprosima::xtypes::DynamicType& message_type,
@@ -196,6 +251,29 @@ public:
     {
         impl().subscriptions[topic_name].insert(message_type.name());
         impl().is_subscription_callbacks[topic_name] = callback;
+        impl().is_subscription_origin_tags[topic_name] = _origin_tag;
+        return true;
+    }
+
+    std::string raw_encoding() const override
+    {
+        return _raw_encoding;
+    }
+
+    bool subscribe_raw(
+            const std::string& topic_name,
+            const eprosima::xtypes::DynamicType& message_type,
+            TopicSubscriberSystem::RawSubscriptionCallback* callback,
+            const YAML::Node& /*configuration*/) override
+    {
+        if (_raw_encoding.empty())
+        {
+            return false;
+        }
+
+        impl().subscriptions[topic_name].insert(message_type.name());
+        impl().is_raw_subscription_callbacks[topic_name] = callback;
+        impl().is_subscription_origin_tags[topic_name] = _origin_tag;
         return true;
     }
 
@@ -205,13 +283,21 @@ public:
         return false;
     }
 
+    bool accept_origin_tag(
+            uint64_t tag) override
+    {
+        // The messages given to Integration Service carry their tag in a MessageOrigin.
+        _origin_tag = tag;
+        return true;
+    }
+
     std::shared_ptr<TopicPublisher> advertise(
             const std::string& topic_name,
             const eprosima::xtypes::DynamicType& message_type,
             const YAML::Node& /*configuration*/) override
     {
         impl().publishers[topic_name].insert(message_type.name());
-        return std::make_shared<Publisher>(topic_name);
+        return std::make_shared<Publisher>(topic_name, impl().mock_subscriptions[topic_name], _raw_encoding);
     }
 
     bool create_client_proxy(
@@ -234,12 +320,28 @@ public:
         return std::make_shared<Server>(service_name);
     }
 
+private:
+
+    bool _event_driven = false;
+
+    uint64_t _origin_tag = 0;
+
+    std::string _raw_encoding;
 };
 
 //==============================================================================
 bool publish_message(
         const std::string& topic,
         const eprosima::xtypes::DynamicData& msg)
+{
+    return publish_message(topic, msg, 0);
+}
+
+//==============================================================================
+bool publish_message(
+        const std::string& topic,
+        const eprosima::xtypes::DynamicData& msg,
+        uint64_t origin_tag)
 {
     const auto it = impl().subscriptions.find(topic);
     if (it == impl().subscriptions.end() ||
@@ -254,11 +356,38 @@ bool publish_message(
         return false;
     }
 
-    (*cb->second)(msg, nullptr);
+    MessageOrigin origin;
+    origin.tag = origin_tag;
+    (*cb->second)(msg, &origin);
 
     return true;
 }
 
+//==============================================================================
+bool publish_raw(
+        const std::string& topic,
+        const std::vector<uint8_t>& payload)
+{
+    const auto cb = impl().is_raw_subscription_callbacks.find(topic);
+    if (cb == impl().is_raw_subscription_callbacks.end())
+    {
+        return false;
+    }
+
+    MessageOrigin origin;
+    (*cb->second)(payload.data(), payload.size(), &origin);
+
+    return true;
+}
+
+//==============================================================================
+uint64_t origin_tag(
+        const std::string& topic)
+{
+    const auto it = impl().is_subscription_origin_tags.find(topic);
+    return it != impl().is_subscription_origin_tags.end() ? it->second : 0;
+}
+
 //==============================================================================
 bool subscribe(
         const std::string& topic,
@@ -270,7 +399,40 @@ bool subscribe(
         return false;
     }
 
-    impl().mock_subscriptions[topic].emplace_back(std::move(callback));
+    Implementation::Channel& channel = impl().mock_subscriptions[topic];
+    const auto previous = std::atomic_load(&channel.callbacks);
+
+    auto callbacks = previous
+            ? std::make_shared<std::vector<MockSubscriptionCallback> >(*previous)
+            : std::make_shared<std::vector<MockSubscriptionCallback> >();
+    callbacks->emplace_back(std::move(callback));
+
+    std::atomic_store(&channel.callbacks,
+            std::shared_ptr<const std::vector<MockSubscriptionCallback> >(std::move(callbacks)));
+    return true;
+}
+
+//==============================================================================
+bool subscribe_raw(
+        const std::string& topic,
+        MockRawSubscriptionCallback callback)
+{
+    const auto it = impl().publishers.find(topic);
+    if (it == impl().publishers.end())
+    {
+        return false;
+    }
+
+    Implementation::Channel& channel = impl().mock_subscriptions[topic];
+    const auto previous = std::atomic_load(&channel.raw_callbacks);
+
+    auto callbacks = previous
+            ? std::make_shared<std::vector<MockRawSubscriptionCallback> >(*previous)
+            : std::make_shared<std::vector<MockRawSubscriptionCallback> >();
+    callbacks->emplace_back(std::move(callback));
+
+    std::atomic_store(&channel.raw_callbacks,
+            std::shared_ptr<const std::vector<MockRawSubscriptionCallback> >(std::move(callbacks)));
     return true;
 }
 
@@ -407,6 +569,273 @@ void serve(
     }
 }
 
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+//==============================================================================
+uint64_t now_ns()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+//==============================================================================
+/**
+ * Copies of a sample, with payloads of the sizes given by the settings, drawn beforehand
+ * so that sending a message needs no allocation. Each sending thread gets its own copies.
+ */
+std::vector<xtypes::DynamicData> make_variants(
+        const xtypes::DynamicData& sample,
+        const LoadSettings& settings,
+        std::size_t seed)
+{
+    std::vector<xtypes::DynamicData> variants;
+    if (settings.payload_member.empty())
+    {
+        variants.emplace_back(sample);
+        return variants;
+    }
+
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(seed));
+    std::uniform_int_distribution<std::size_t> sizes(
+        settings.min_payload, std::max(settings.min_payload, settings.max_payload));
+
+    const std::size_t count = settings.min_payload < settings.max_payload ? 64 : 1;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        variants.emplace_back(sample);
+        variants.back()[settings.payload_member].value<std::string>(std::string(sizes(generator), 'x'));
+    }
+
+    return variants;
+}
+
+//==============================================================================
+/**
+ * Spreads the messages of a load among its threads, each of them sending its own range
+ * of them at its share of the rate, and waits for all of them.
+ */
+template<typename Send>
+void run_load(
+        const LoadSettings& settings,
+        std::size_t threads,
+        Send send)
+{
+    const Clock::duration period = settings.rate > 0.0
+            ? std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(static_cast<double>(threads) / settings.rate))
+            : Clock::duration::zero();
+
+    std::vector<std::thread> senders;
+    std::size_t first = 0;
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        const std::size_t last = first + settings.count / threads + (t < settings.count % threads ? 1 : 0);
+        senders.emplace_back([&send, period, first, last, t]()
+                {
+                    Clock::time_point next = Clock::now();
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        if (period > Clock::duration::zero())
+                        {
+                            std::this_thread::sleep_until(next);
+                            next += period;
+                        }
+
+                        send(t, i);
+                    }
+                });
+        first = last;
+    }
+
+    for (std::thread& sender : senders)
+    {
+        sender.join();
+    }
+}
+
+//==============================================================================
+/**
+ * Client of the requests of a load. Call handles point into a table with the time each
+ * request was sent, sharing the ownership of the client, so that they need no allocation.
+ */
+class LoadClient
+    : public virtual ServiceClient,
+    public std::enable_shared_from_this<LoadClient>
+{
+public:
+
+    LoadClient(
+            std::size_t count,
+            MockReplyCallback on_reply)
+        : _sent_at(count)
+        , _on_reply(std::move(on_reply))
+        , _expected(count)
+    {
+    }
+
+    std::shared_ptr<void> handle(
+            std::size_t index)
+    {
+        _sent_at[index] = now_ns();
+        ++in_flight;
+        return std::shared_ptr<void>(shared_from_this(), &_sent_at[index]);
+    }
+
+    void receive_response(
+            std::shared_ptr<void> call_handle,
+            const eprosima::xtypes::DynamicData& response) override
+    {
+        if (_on_reply)
+        {
+            const uint64_t sent_at = *static_cast<const uint64_t*>(call_handle.get());
+            _on_reply(response, std::chrono::nanoseconds(now_ns() - sent_at));
+        }
+
+        ++completed;
+        finished();
+    }
+
+    void receive_cancellation(
+            std::shared_ptr<void> /*call_handle*/) override
+    {
+        ++cancelled;
+        finished();
+    }
+
+    bool wait_for(
+            std::chrono::nanoseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _done_cv.wait_for(lock, timeout, [this]()
+                       {
+                           return completed + cancelled >= _expected;
+                       });
+    }
+
+    std::atomic<std::size_t> in_flight{0};
+    std::atomic<std::size_t> completed{0};
+    std::atomic<std::size_t> cancelled{0};
+
+private:
+
+    void finished()
+    {
+        --in_flight;
+        if (completed + cancelled >= _expected)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _done_cv.notify_all();
+        }
+    }
+
+    std::vector<uint64_t> _sent_at;
+    const MockReplyCallback _on_reply;
+    const std::size_t _expected;
+    std::mutex _mutex;
+    std::condition_variable _done_cv;
+};
+
+} // anonymous namespace
+
+//==============================================================================
+LoadResult publish_load(
+        const std::string& topic,
+        const eprosima::xtypes::DynamicData& sample,
+        const LoadSettings& settings)
+{
+    const auto it = impl().subscriptions.find(topic);
+    const auto cb = impl().is_subscription_callbacks.find(topic);
+    if (it == impl().subscriptions.end() || it->second.count(sample.type().name()) == 0
+            || cb == impl().is_subscription_callbacks.end())
+    {
+        throw std::runtime_error(
+                  "you are attempting to publish a load to mock middleware "
+                  "that it is not subscribed to: " + topic);
+    }
+
+    TopicSubscriberSystem::SubscriptionCallback& callback = *cb->second;
+    const std::size_t threads = std::max<std::size_t>(1, settings.threads);
+
+    std::vector<std::vector<xtypes::DynamicData> > variants;
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        variants.push_back(make_variants(sample, settings, t));
+    }
+
+    const auto start = Clock::now();
+    run_load(settings, threads, [&](std::size_t thread, std::size_t index)
+            {
+                xtypes::DynamicData& message = variants[thread][index % variants[thread].size()];
+                if (!settings.stamp_member.empty())
+                {
+                    message[settings.stamp_member].value<uint64_t>(now_ns());
+                }
+
+                callback(message, nullptr);
+            });
+
+    LoadResult result;
+    result.sent = settings.count;
+    result.completed = settings.count;
+    result.elapsed = Clock::now() - start;
+    return result;
+}
+
+//==============================================================================
+LoadResult request_load(
+        const std::string& topic,
+        const eprosima::xtypes::DynamicData& request_msg,
+        const LoadSettings& settings,
+        MockReplyCallback on_reply)
+{
+    const auto it = impl().is_request_callbacks.find(topic);
+    if (it == impl().is_request_callbacks.end())
+    {
+        throw std::runtime_error(
+                  "a callback could not be found for the requested service: "
+                  + topic);
+    }
+
+    ServiceClientSystem::RequestCallback& callback = *it->second;
+    const std::size_t threads = std::max<std::size_t>(1, settings.threads);
+
+    std::vector<std::vector<xtypes::DynamicData> > variants;
+    for (std::size_t t = 0; t < threads; ++t)
+    {
+        variants.push_back(make_variants(request_msg, settings, t));
+    }
+
+    const auto client = std::make_shared<LoadClient>(settings.count, std::move(on_reply));
+
+    const auto start = Clock::now();
+    run_load(settings, threads, [&](std::size_t thread, std::size_t index)
+            {
+                while (settings.max_in_flight > 0 && client->in_flight >= settings.max_in_flight)
+                {
+                    std::this_thread::yield();
+                }
+
+                xtypes::DynamicData& request = variants[thread][index % variants[thread].size()];
+                if (!settings.stamp_member.empty())
+                {
+                    request[settings.stamp_member].value<uint64_t>(now_ns());
+                }
+
+                callback(request, *client, client->handle(index));
+            });
+
+    client->wait_for(settings.timeout);
+
+    LoadResult result;
+    result.sent = settings.count;
+    result.completed = client->completed;
+    result.cancelled = client->cancelled;
+    result.elapsed = Clock::now() - start;
+    return result;
+}
+
 } //  namespace mock
 } //  namespace sh
 } //  namespace is
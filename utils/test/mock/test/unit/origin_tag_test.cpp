@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/Instance.hpp>
+#include <is/sh/mock/api.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace is = eprosima::is;
+namespace xtypes = eprosima::xtypes;
+
+namespace {
+
+const std::string configuration = R"(
+types:
+  idls:
+    - >
+        struct Hello
+        {
+            string data;
+        };
+
+systems:
+  source: { type: mock }
+  sink: { type: mock }
+
+routes:
+  direct: { from: source, to: sink }
+
+topics:
+  chatter: { type: Hello, route: direct }
+)";
+
+} //  anonymous namespace
+
+TEST(OriginTag, Internal_messages_are_discarded_and_foreign_ones_forwarded)
+{
+    /**
+     * The test links the mock SystemHandle, which registers itself without its plugin being loaded.
+     */
+    is::core::InstanceHandle instance = is::run_instance(YAML::Load(configuration));
+    ASSERT_TRUE(instance);
+
+    const is::TypeRegistry* types = instance.type_registry("source");
+    ASSERT_NE(types, nullptr);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::string> received;
+    ASSERT_TRUE(is::sh::mock::subscribe("chatter", [&](const xtypes::DynamicData& message)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                received.push_back(message["data"].value<std::string>());
+                cv.notify_all();
+            }));
+
+    const uint64_t tag = is::sh::mock::origin_tag("chatter");
+    ASSERT_NE(tag, 0u);
+
+    xtypes::DynamicData internal(*types->at("Hello"));
+    internal["data"] = std::string("internal");
+    ASSERT_TRUE(is::sh::mock::publish_message("chatter", internal, tag));
+
+    xtypes::DynamicData foreign(*types->at("Hello"));
+    foreign["data"] = std::string("foreign");
+    ASSERT_TRUE(is::sh::mock::publish_message("chatter", foreign, tag + 1));
+
+    xtypes::DynamicData untagged(*types->at("Hello"));
+    untagged["data"] = std::string("untagged");
+    ASSERT_TRUE(is::sh::mock::publish_message("chatter", untagged));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&received]()
+                {
+                    return received.size() >= 2;
+                }));
+    }
+
+    /**
+     * Gives the internal message, if it was wrongly forwarded, the chance to arrive.
+     */
+    instance.wait_for(std::chrono::milliseconds(100));
+
+    std::unique_lock<std::mutex> lock(mutex);
+    std::sort(received.begin(), received.end());
+    ASSERT_EQ(received, std::vector<std::string>({"foreign", "untagged"}));
+    lock.unlock();
+
+    ASSERT_EQ(instance.quit().wait(), 0);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/Instance.hpp>
+#include <is/sh/mock/api.hpp>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace is = eprosima::is;
+namespace xtypes = eprosima::xtypes;
+
+namespace {
+
+const std::string raw_configuration = R"(
+types:
+  idls:
+    - >
+        struct Hello
+        {
+            string data;
+        };
+
+systems:
+  raw_source: { type: mock, raw_encoding: bytes }
+  raw_sink: { type: mock, raw_encoding: bytes }
+  other_sink: { type: mock, raw_encoding: other }
+
+routes:
+  same_encoding: { from: raw_source, to: raw_sink }
+  other_encoding: { from: raw_source, to: other_sink }
+
+topics:
+  raw_chatter: { type: Hello, route: same_encoding }
+  filtered_chatter: { type: Hello, route: same_encoding, filter: "data == 'a'" }
+  other_chatter: { type: Hello, route: other_encoding }
+)";
+
+} //  anonymous namespace
+
+TEST(RawPassthrough, Payloads_are_forwarded_as_they_are)
+{
+    is::core::InstanceHandle instance = is::run_instance(YAML::Load(raw_configuration));
+    ASSERT_TRUE(instance);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::vector<uint8_t> > received;
+    ASSERT_TRUE(is::sh::mock::subscribe_raw("raw_chatter", [&](const std::vector<uint8_t>& payload)
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                received.push_back(payload);
+                cv.notify_all();
+            }));
+
+    const std::vector<uint8_t> payload = {0x00, 0x01, 0xfe, 0xff};
+    ASSERT_TRUE(is::sh::mock::publish_raw("raw_chatter", payload));
+    ASSERT_TRUE(is::sh::mock::publish_raw("raw_chatter", {}));
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&received]()
+                {
+                    return received.size() >= 2;
+                }));
+        ASSERT_EQ(received[0], payload);
+        ASSERT_TRUE(received[1].empty());
+    }
+
+    /**
+     * Topics with settings that need the deserialized messages, or whose destination
+     * uses another encoding, are subscribed to their DynamicData instead.
+     */
+    ASSERT_FALSE(is::sh::mock::publish_raw("filtered_chatter", payload));
+    ASSERT_FALSE(is::sh::mock::publish_raw("other_chatter", payload));
+
+    const is::TypeRegistry* types = instance.type_registry("raw_source");
+    ASSERT_NE(types, nullptr);
+
+    xtypes::DynamicData message(*types->at("Hello"));
+    message["data"] = std::string("a");
+    ASSERT_TRUE(is::sh::mock::publish_message("filtered_chatter", message));
+    ASSERT_TRUE(is::sh::mock::publish_message("other_chatter", message));
+
+    ASSERT_EQ(instance.quit().wait(), 0);
+}
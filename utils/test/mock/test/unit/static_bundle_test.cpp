@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2021 - present Proyectos y Sistemas de Mantenimiento SL (eProsima).
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <is/core/Instance.hpp>
+#include <is/sh/mock/api.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+
+namespace is = eprosima::is;
+namespace xtypes = eprosima::xtypes;
+
+namespace {
+
+const std::string configuration = R"(
+types:
+  idls:
+    - >
+        struct Hello
+        {
+            string data;
+        };
+
+systems:
+  source: { type: mock }
+  sink: { type: mock }
+
+routes:
+  direct: { from: source, to: sink }
+
+topics:
+  chatter: { type: Hello, route: direct }
+)";
+
+} //  anonymous namespace
+
+TEST(StaticBundle, Linked_mock_routes_messages_without_its_plugin)
+{
+    /**
+     * No prefix paths are given, and the bundle links is-core-static alone,
+     * so the mock SystemHandle must be the one registered by the bundle itself.
+     */
+    is::core::InstanceHandle instance = is::run_instance(YAML::Load(configuration));
+    ASSERT_TRUE(instance);
+
+    const is::TypeRegistry* types = instance.type_registry("source");
+    ASSERT_NE(types, nullptr);
+    ASSERT_NE(types->find("Hello"), types->end());
+
+    std::promise<std::string> received;
+    std::atomic_bool first(true);
+    ASSERT_TRUE(is::sh::mock::subscribe("chatter", [&received, &first](const xtypes::DynamicData& message)
+            {
+                if (first.exchange(false))
+                {
+                    received.set_value(message["data"].value<std::string>());
+                }
+            }));
+
+    xtypes::DynamicData message(*types->at("Hello"));
+    message["data"] = std::string("bundled");
+    ASSERT_TRUE(is::sh::mock::publish_message("chatter", message));
+
+    std::future<std::string> data = received.get_future();
+    ASSERT_EQ(data.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    ASSERT_EQ(data.get(), "bundled");
+
+    ASSERT_EQ(instance.quit().wait(), 0);
+}
+
+int main(
+        int argc,
+        char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}